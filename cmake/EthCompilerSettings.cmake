@@ -243,6 +243,13 @@ if(COVERAGE)
 	add_compile_options(-g --coverage)
 endif()
 
+# Counters of the transformations performed by the optimizers, which are reported together
+# with the phases of the compilation in the profile output.
+option(OPTIMIZER_COUNTERS "Count the transformations performed by the optimizers" OFF)
+if(OPTIMIZER_COUNTERS)
+	add_definitions(-DSOL_OPTIMIZER_COUNTERS)
+endif()
+
 # SMT Solvers integration
 option(USE_Z3 "Allow compiling with Z3 SMT solver integration" ON)
 if(UNIX AND NOT APPLE)
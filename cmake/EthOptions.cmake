@@ -7,6 +7,7 @@ macro(configure_project)
 	# features
 	eth_default_option(COVERAGE OFF)
 	eth_default_option(OSSFUZZ OFF)
+	eth_default_option(OPTIMIZER_COUNTERS OFF)
 
 	# components
 	eth_default_option(TESTS ON)
@@ -32,6 +33,7 @@ macro(print_config NAME)
 	message("-- TARGET_PLATFORM  Target platform                          ${CMAKE_SYSTEM_NAME}")
 	message("--------------------------------------------------------------- features")
 	message("-- COVERAGE         Coverage support                         ${COVERAGE}")
+	message("-- OPTIMIZER_COUNTERS Optimizer transformation counters      ${OPTIMIZER_COUNTERS}")
 	message("------------------------------------------------------------- components")
 if (SUPPORT_TESTS)
 	message("-- TESTS            Build tests                              ${TESTS}")
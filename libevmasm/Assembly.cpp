@@ -25,6 +25,7 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/Superoptimiser.h>
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
@@ -34,6 +35,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -41,6 +45,7 @@
 
 #include <fstream>
 #include <limits>
+#include <optional>
 
 using namespace std;
 using namespace solidity;
@@ -59,6 +64,18 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 	return m_items.back();
 }
 
+bool Assembly::collectUnoptimisedAssemblies(set<Assembly const*>& _assemblies) const
+{
+	if (m_tagReplacements)
+		return true;
+	if (!_assemblies.insert(this).second)
+		return false;
+	for (AssemblyPointer const& sub: m_subs)
+		if (!sub->collectUnoptimisedAssemblies(_assemblies))
+			return false;
+	return true;
+}
+
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
@@ -225,14 +242,14 @@ string Assembly::assemblyString(
 Json::Value Assembly::createJsonValue(string _name, int _source, int _begin, int _end, string _value, string _jumpType)
 {
 	Json::Value value{Json::objectValue};
-	value["name"] = _name;
+	value["name"] = move(_name);
 	value["source"] = _source;
 	value["begin"] = _begin;
 	value["end"] = _end;
 	if (!_value.empty())
-		value["value"] = _value;
+		value["value"] = move(_value);
 	if (!_jumpType.empty())
-		value["jumpType"] = _jumpType;
+		value["jumpType"] = move(_jumpType);
 	return value;
 }
 
@@ -244,6 +261,12 @@ string Assembly::toStringInHex(u256 _value)
 }
 
 Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices) const
+{
+	SourceIndexTable sourceIndexTable;
+	return assemblyJSON(_sourceIndices, sourceIndexTable);
+}
+
+Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices, SourceIndexTable& _sourceIndexTable) const
 {
 	Json::Value root;
 	root[".code"] = Json::arrayValue;
@@ -252,11 +275,14 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 	for (AssemblyItem const& i: m_items)
 	{
 		int sourceIndex = -1;
-		if (i.location().sourceName)
+		if (string const* sourceName = i.location().sourceName)
 		{
-			auto iter = _sourceIndices.find(*i.location().sourceName);
-			if (iter != _sourceIndices.end())
-				sourceIndex = static_cast<int>(iter->second);
+			// Source names are interned, so consecutive items share the entry of their source.
+			auto [entry, inserted] = _sourceIndexTable.try_emplace(sourceName, -1);
+			if (inserted)
+				if (auto iter = _sourceIndices.find(*sourceName); iter != _sourceIndices.end())
+					entry->second = static_cast<int>(iter->second);
+			sourceIndex = entry->second;
 		}
 
 		switch (i.type())
@@ -352,7 +378,7 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 		{
 			std::stringstream hexStr;
 			hexStr << hex << i;
-			data[hexStr.str()] = m_subs[i]->assemblyJSON(_sourceIndices);
+			data[hexStr.str()] = m_subs[i]->assemblyJSON(_sourceIndices, _sourceIndexTable);
 		}
 	}
 
@@ -417,33 +443,45 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 }
 
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, size_t _parallelism)
 {
-	optimiseInternal(_settings, {});
+	util::Profiler::Timer timer("evmasmOptimizer");
+	optimiseInternal(_settings, {}, _parallelism);
 	return *this;
 }
 
 map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	size_t _parallelism
 )
 {
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
-	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> const& subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+	// Run optimisation for sub-assemblies. They can only be optimised in parallel if they do not
+	// share any assemblies that still have to be optimised, since those are optimised in place
+	// by the first one reaching them.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	set<Assembly const*> unoptimised;
+	bool const parallel = _parallelism > 1 && collectUnoptimisedAssemblies(unoptimised);
+	vector<map<u256, u256> const*> subTagReplacements(m_subs.size());
+	// The shared pool runs the sub-assemblies of nested sub-assemblies sequentially on the
+	// thread that optimises them, so the number of threads does not grow with the nesting depth.
+	auto const profiler = util::Profiler::current();
+	util::ThreadPool::shared().forEach(m_subs.size(), parallel ? _parallelism : 1, [&](size_t _subId) {
+		util::Profiler::Scope profilerScope(profiler.first, profiler.second);
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(
+			subSettings,
+			JumpdestRemover::referencedTags(m_items, _subId),
+			_parallelism
 		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+	});
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, *subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -457,7 +495,8 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				_settings.isCreation,
-				_settings.evmVersion
+				_settings.evmVersion,
+				_settings.runInlinerWithSideEffects
 			}.optimise();
 
 		if (_settings.runJumpdestRemover)
@@ -477,6 +516,13 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runSuperoptimiser)
+		{
+			Superoptimiser superoptimiser{m_items};
+			if (superoptimiser.optimise())
+				count++;
+		}
+
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
@@ -514,18 +560,26 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			optional<CommonSubexpressionEliminator> eliminator;
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				// The code following a conditional jump can only be reached from there, so the
+				// eliminator can continue with the knowledge it has after the jump.
+				bool continuesAfterJumpI =
+					_settings.runCSEAcrossBlocks &&
+					iter != m_items.begin() &&
+					*prev(iter) == Instruction::JUMPI &&
+					iter->type() != Tag;
+				if (!eliminator || !continuesAfterJumpI)
+					eliminator.emplace(KnownState{});
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+				iter = eliminator->feedItems(iter, m_items.end(), usesMSize, _settings.cseMaxBlockLength);
 				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
 				try
 				{
-					optimisedChunk = eliminator.getOptimizedItems();
+					optimisedChunk = eliminator->getOptimizedItems();
 					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
 				}
 				catch (StackTooDeepException const&)
@@ -560,7 +614,8 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
-			*this
+			*this,
+			_settings.constantOptimiserNegation
 		);
 
 	m_tagReplacements = move(tagReplacements);
@@ -617,7 +672,8 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	// Tag references are recorded in order of their position in the bytecode.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -655,7 +711,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -771,11 +827,9 @@ LinkerObject const& Assembly::assemble() const
 		ret.append(subAssemblyById(subIdPath)->assemble());
 	}
 
-	for (auto const& i: tagRef)
+	for (auto const& [tagRefPosition, tagRefTarget]: tagRef)
 	{
-		size_t subId;
-		size_t tagId;
-		tie(subId, tagId) = i.second;
+		auto const [subId, tagId] = tagRefTarget;
 		assertThrow(subId == numeric_limits<size_t>::max() || subId < m_subs.size(), AssemblyException, "Invalid sub id");
 		vector<size_t> const& tagPositions =
 			subId == numeric_limits<size_t>::max() ?
@@ -785,22 +839,23 @@ LinkerObject const& Assembly::assemble() const
 		size_t pos = tagPositions[tagId];
 		assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
 		assertThrow(numberEncodingSize(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
-		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
+		bytesRef r(ret.bytecode.data() + tagRefPosition, bytesPerTag);
 		toBigEndian(pos, r);
 	}
+
+	// Index of the first occurrence of each tag in the items, only needed for named tags.
+	map<size_t, size_t> tagIndices;
+	if (!m_namedTags.empty())
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == Tag)
+				tagIndices.emplace(static_cast<size_t>(item.data()), index);
 	for (auto const& [name, tagInfo]: m_namedTags)
 	{
 		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
-		optional<size_t> tagIndex;
-		for (auto&& [index, item]: m_items | ranges::views::enumerate)
-			if (item.type() == Tag && static_cast<size_t>(item.data()) == tagInfo.id)
-			{
-				tagIndex = index;
-				break;
-			}
+		auto tagIndex = tagIndices.find(tagInfo.id);
 		ret.functionDebugData[name] = {
 			position == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{position},
-			tagIndex,
+			tagIndex == tagIndices.end() ? nullopt : optional<size_t>{tagIndex->second},
 			tagInfo.sourceID,
 			tagInfo.params,
 			tagInfo.returns
@@ -39,6 +39,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <set>
 
 namespace solidity::evmasm
 {
@@ -119,20 +120,32 @@ public:
 	{
 		bool isCreation = false;
 		bool runInliner = false;
+		/// Also consider functions containing instructions like calls, logs or memory copies for inlining.
+		bool runInlinerWithSideEffects = false;
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
+		/// Replace short windows of stack code by cheaper equivalents found by exhaustive search.
+		bool runSuperoptimiser = false;
 		bool runDeduplicate = false;
 		bool runCSE = false;
+		/// Keep the CSE knowledge for the code directly following a conditional jump.
+		bool runCSEAcrossBlocks = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// If nonzero, the CSE splits blocks after this many items.
+		size_t cseMaxBlockLength = 0;
+		/// Let the constant optimiser also try to compute the negation of constants that are not shorter.
+		bool constantOptimiserNegation = false;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// @param _parallelism maximum number of threads used to optimise independent
+	/// sub-assemblies. Does not influence the result.
+	Assembly& optimise(OptimiserSettings const& _settings, size_t _parallelism = 1);
 
 	/// Modify (if @a _enable is set) and return the current assembly such that creation and
 	/// execution gas usage is optimised. @a _isCreation should be true for the top-level assembly.
@@ -168,10 +181,19 @@ protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	std::map<u256, u256> const& optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		size_t _parallelism
+	);
 
 	unsigned codeSize(unsigned subTagSize) const;
 
+	/// Adds this assembly and all assemblies reachable from it that are not optimised yet
+	/// to @a _assemblies.
+	/// @returns false if one of them is reachable in more than one way or was already contained.
+	bool collectUnoptimisedAssemblies(std::set<Assembly const*>& _assemblies) const;
+
 private:
 	static Json::Value createJsonValue(
 		std::string _name,
@@ -183,6 +205,15 @@ private:
 	);
 	static std::string toStringInHex(u256 _value);
 
+	/// Indices of the sources looked up by name, keyed by the interned name of the source.
+	using SourceIndexTable = std::map<std::string const*, int>;
+	/// Creates the JSON representation of the assembly, resolving the index of every source
+	/// referenced by the items (including those of the sub-assemblies) only once.
+	Json::Value assemblyJSON(
+		std::map<std::string, unsigned> const& _sourceIndices,
+		SourceIndexTable& _sourceIndexTable
+	) const;
+
 	bool m_invalid = false;
 
 	Assembly const* subAssemblyById(size_t _subId) const;
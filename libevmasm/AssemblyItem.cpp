@@ -26,6 +26,7 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
 #include <limits>
 
@@ -363,24 +364,37 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	string ret;
+	// Most entries only consist of the separator, reserve enough for a few short fields.
+	ret.reserve(_items.size() * 4);
+	auto appendNumber = [&](int _number)
+	{
+		char buffer[16];
+		auto result = to_chars(begin(buffer), end(buffer), _number);
+		ret.append(buffer, result.ptr);
+	};
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items usually share the source name, so its index is only looked up when it changes.
+	string const* prevSourceName = nullptr;
 
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
-			ret += ";";
+			ret += ';';
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
+		int sourceIndex = prevSourceIndex;
+		if (location.sourceName != prevSourceName || !prevSourceName)
+		{
+			auto index = location.sourceName ? _sourceIndicesMap.find(*location.sourceName) : _sourceIndicesMap.end();
+			sourceIndex = index != _sourceIndicesMap.end() ? static_cast<int>(index->second) : -1;
+			prevSourceName = location.sourceName;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -411,17 +425,17 @@ std::string AssemblyItem::computeSourceMapping(
 		if (components-- > 0)
 		{
 			if (location.start != prevStart)
-				ret += to_string(location.start);
+				appendNumber(location.start);
 			if (components-- > 0)
 			{
 				ret += ':';
 				if (length != prevLength)
-					ret += to_string(length);
+					appendNumber(length);
 				if (components-- > 0)
 				{
 					ret += ':';
 					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+						appendNumber(sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
@@ -431,7 +445,7 @@ std::string AssemblyItem::computeSourceMapping(
 						{
 							ret += ':';
 							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
+								appendNumber(modifierDepth);
 						}
 					}
 				}
@@ -439,7 +453,7 @@ std::string AssemblyItem::computeSourceMapping(
 		}
 
 		if (item.opcodeCount() > 1)
-			ret += string(item.opcodeCount() - 1, ';');
+			ret.append(item.opcodeCount() - 1, ';');
 
 		prevStart = location.start;
 		prevLength = length;
@@ -449,3 +463,76 @@ std::string AssemblyItem::computeSourceMapping(
 	}
 	return ret;
 }
+
+bytes AssemblyItem::computeBinarySourceMapping(
+	AssemblyItems const& _items,
+	map<string, unsigned> const& _sourceIndicesMap,
+	bytes const& _bytecode
+)
+{
+	auto appendNumber = [](bytes& _out, uint32_t _value, size_t _width)
+	{
+		for (size_t i = _width; i > 0; --i)
+			_out.push_back(static_cast<uint8_t>(_value >> (8 * (i - 1))));
+	};
+
+	bytes entries;
+	vector<uint32_t> instructionOfByte;
+	size_t instructionCount = 0;
+	size_t offset = 0;
+	int sourceIndex = -1;
+	string const* prevSourceName = nullptr;
+
+	for (auto const& item: _items)
+	{
+		SourceLocation const& location = item.location();
+		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		if (location.sourceName != prevSourceName)
+		{
+			auto index = location.sourceName ? _sourceIndicesMap.find(*location.sourceName) : _sourceIndicesMap.end();
+			sourceIndex = index != _sourceIndicesMap.end() ? static_cast<int>(index->second) : -1;
+			prevSourceName = location.sourceName;
+		}
+		char jump = '-';
+		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
+			jump = 'i';
+		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
+			jump = 'o';
+		assertThrow(item.m_modifierDepth <= 0xffff, AssemblyException, "Modifier depth too large for the binary source mapping.");
+
+		// As in the text format, every opcode of an immutable assignment gets its own entry,
+		// while verbatim bytecode is a single instruction.
+		for (size_t opcode = 0; opcode < item.opcodeCount(); ++opcode)
+		{
+			appendNumber(entries, static_cast<uint32_t>(location.start), 4);
+			appendNumber(entries, static_cast<uint32_t>(length), 4);
+			appendNumber(entries, static_cast<uint32_t>(sourceIndex), 4);
+			appendNumber(entries, static_cast<uint32_t>(item.m_modifierDepth), 2);
+			entries.push_back(static_cast<uint8_t>(jump));
+			entries.push_back(0);
+
+			size_t size = 0;
+			if (item.type() == VerbatimBytecode)
+				size = item.verbatimData().size();
+			else
+			{
+				assertThrow(offset < _bytecode.size(), AssemblyException, "Bytecode does not match the assembly items.");
+				Instruction instruction = static_cast<Instruction>(_bytecode[offset]);
+				size = 1 + (isPushInstruction(instruction) ? getPushNumber(instruction) : 0);
+			}
+			assertThrow(offset + size <= _bytecode.size(), AssemblyException, "Bytecode does not match the assembly items.");
+			instructionOfByte.insert(instructionOfByte.end(), size, static_cast<uint32_t>(instructionCount));
+			offset += size;
+			++instructionCount;
+		}
+	}
+
+	bytes ret;
+	ret.reserve(8 + entries.size() + 4 * instructionOfByte.size());
+	appendNumber(ret, static_cast<uint32_t>(instructionCount), 4);
+	ret += entries;
+	appendNumber(ret, static_cast<uint32_t>(instructionOfByte.size()), 4);
+	for (uint32_t index: instructionOfByte)
+		appendNumber(ret, index, 4);
+	return ret;
+}
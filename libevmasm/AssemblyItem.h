@@ -28,6 +28,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
+#include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
@@ -62,7 +63,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -78,12 +79,16 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			m_data = std::move(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}}
+		m_verbatimBytecode{std::make_shared<std::tuple<size_t, size_t, bytes> const>(
+			_arguments,
+			_returnVariables,
+			std::move(_verbatimData)
+		)}
 	{}
 
 	AssemblyItem(AssemblyItem const&) = default;
@@ -103,8 +108,8 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return m_data; }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = _data; }
 
 	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
 
@@ -149,6 +154,20 @@ public:
 		std::map<std::string, unsigned> const& _sourceIndicesMap
 	);
 
+	/// @returns the source mapping of @a _items in a binary format that allows random access,
+	/// given the @a _bytecode they were assembled to. All numbers are big-endian:
+	///  - the number of instructions (4 bytes),
+	///  - for each instruction 16 bytes: start, length and source index (4 bytes each, -1 if unknown),
+	///    modifier depth (2 bytes), jump type (``i``, ``o`` or ``-``, 1 byte) and a zero byte,
+	///  - the number of bytes covered by the instructions (4 bytes),
+	///  - for each of these bytes the index of the instruction it belongs to (4 bytes each).
+	/// The instructions are the same as those of the text format.
+	static bytes computeBinarySourceMapping(
+		AssemblyItems const& _items,
+		std::map<std::string, unsigned> const& _sourceIndicesMap,
+		bytes const& _bytecode
+	);
+
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
 	/// @param _precision Whether to return a precise count (which involves
@@ -181,14 +200,18 @@ public:
 private:
 	size_t opcodeCount() const noexcept;
 
+	// The small members are kept together to avoid padding, since items are copied a lot.
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	JumpType m_jumpType = JumpType::Ordinary;
+	/// Only valid if m_type != Operation. Stored inline, because almost all items carry data
+	/// and sharing it between copies would cost an allocation per item.
+	u256 m_data;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// return variables and verbatim bytecode. It is shared between copies, as it is never modified
+	/// and keeping it inline would make all items considerably larger.
+	std::shared_ptr<std::tuple<size_t, size_t, bytes> const> m_verbatimBytecode;
 	langutil::SourceLocation m_location;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
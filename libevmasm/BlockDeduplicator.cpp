@@ -28,12 +28,29 @@
 #include <libevmasm/SemanticInformation.h>
 
 #include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// @returns a hash of the type and data of @a _item, ignoring the values of pushed tags.
+size_t fingerprint(AssemblyItem const& _item)
+{
+	size_t hash = static_cast<size_t>(_item.type());
+	if (_item.type() == Operation)
+		hash = hash * 31 + static_cast<size_t>(_item.instruction());
+	else if (_item.type() != PushTag && _item.type() != VerbatimBytecode)
+		hash = hash * 31 + static_cast<size_t>(_item.data() & numeric_limits<size_t>::max());
+	return hash;
+}
+
+}
 
 bool BlockDeduplicator::deduplicate()
 {
@@ -80,15 +97,32 @@ bool BlockDeduplicator::deduplicate()
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Blocks are only compared to blocks with the same fingerprint. Pushed tags do not
+		// contribute to the fingerprint, since they are unified with the block's own tag
+		// by the comparator, so the fingerprints of all blocks can be computed in a single
+		// backwards pass over the items.
+		vector<size_t> fingerprints(m_items.size() + 1, 0);
+		for (size_t i = m_items.size(); i-- > 0;)
+		{
+			AssemblyItem const& item = m_items[i];
+			if (item.type() == Tag)
+				fingerprints[i] = fingerprints[i + 1];
+			else
+			{
+				bool endsBlock = SemanticInformation::altersControlFlow(item) && item != AssemblyItem{Instruction::JUMPI};
+				fingerprints[i] = fingerprint(item) ^ ((endsBlock ? 0 : fingerprints[i + 1]) * 0x100000001b3);
+			}
+		}
+
+		unordered_map<size_t, set<size_t, function<bool(size_t, size_t)>>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			auto& candidates = blocksSeen.try_emplace(fingerprints[i], comparator).first->second;
+			auto it = candidates.find(i);
+			if (it == candidates.end())
+				candidates.insert(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
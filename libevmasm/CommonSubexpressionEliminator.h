@@ -31,6 +31,7 @@
 #include <ostream>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/Profiler.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
 #include <libevmasm/KnownState.h>
@@ -70,8 +71,15 @@ public:
 	/// Feeds AssemblyItems into the eliminator and @returns the iterator pointing at the first
 	/// item that must be fed into a new instance of the eliminator.
 	/// @param _msizeImportant if false, do not consider modification of MSIZE a side-effect
+	/// @param _maxItems if nonzero, the block is split after this many items to bound the
+	/// size of the analysis.
 	template <class AssemblyItemIterator>
-	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+	AssemblyItemIterator feedItems(
+		AssemblyItemIterator _iterator,
+		AssemblyItemIterator _end,
+		bool _msizeImportant,
+		size_t _maxItems = 0
+	);
 
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
@@ -174,12 +182,20 @@ template <class AssemblyItemIterator>
 AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 	AssemblyItemIterator _iterator,
 	AssemblyItemIterator _end,
-	bool _msizeImportant
+	bool _msizeImportant,
+	size_t _maxItems
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
-	for (; _iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant); ++_iterator)
+	for (size_t count = 0; _iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant); ++_iterator)
+	{
+		if (_maxItems && count++ == _maxItems)
+		{
+			util::Profiler::count("cseBlockSplit");
+			return _iterator;
+		}
 		feedItem(*_iterator);
+	}
 	if (_iterator != _end)
 		m_breakingItem = &(*_iterator++);
 	return _iterator;
@@ -24,6 +24,12 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -32,7 +38,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	bool _computeNegation
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -44,6 +51,7 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		if (item.type() == Push)
 			pushes[item]++;
 	map<u256, AssemblyItems> pendingReplacements;
+	RepresentationCache representations;
 	for (auto it: pushes)
 	{
 		AssemblyItem const& item = it.first;
@@ -54,6 +62,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
+		params.computeNegation = _computeNegation;
+		params.representations = &representations;
 		LiteralMethod lit(params, item.data());
 		bigint literalGas = lit.gasNeeded();
 		CodeCopyMethod copy(params, item.data());
@@ -95,7 +105,7 @@ bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 	return gas;
 }
 
-bigint ConstantOptimisationMethod::dataGas(bytes const& _data) const
+bigint ConstantOptimisationMethod::dataGas(bytesConstRef _data) const
 {
 	assertThrow(_data.size() > 0, OptimizerException, "Empty bytecode generated.");
 	return bigint(GasMeter::dataGas(_data, m_params.isCreation, m_params.evmVersion));
@@ -130,10 +140,11 @@ void ConstantOptimisationMethod::replaceConstants(
 
 bigint LiteralMethod::gasNeeded() const
 {
+	util::h256 buffer;
 	return combineGas(
 		simpleRunGas({Instruction::PUSH1}),
 		// PUSHX plus data
-		(m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas) + dataGas(toCompactBigEndian(m_value, 1)),
+		(m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas) + dataGas(compactBigEndian(m_value, buffer, 1)),
 		0
 	);
 }
@@ -146,7 +157,7 @@ bigint CodeCopyMethod::gasNeeded() const
 		// Data gas for copy routines: Some bytes are zero, but we ignore them.
 		bytesRequired(copyRoutine()) * (m_params.isCreation ? GasCosts::txDataNonZeroGas(m_params.evmVersion) : GasCosts::createDataGas),
 		// Data gas for data itself
-		dataGas(toBigEndian(m_value))
+		dataGas(util::h256(m_value).ref())
 	);
 }
 
@@ -192,64 +203,96 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 	if (_value < 0x10000)
 		// Very small value, not worth computing
 		return AssemblyItems{_value};
-	else if (numberEncodingSize(~_value) < numberEncodingSize(_value))
+
+	// As long as the step budget is not exhausted, the search only depends on the value and the
+	// parameters. Such results are shared between all constants (and the subexpressions of their
+	// representations). Using them costs the same number of steps as searching again, so the
+	// result does not depend on the order in which the constants are optimised.
+	pair<u256, size_t> key{_value, m_params.multiplicity};
+	if (m_params.representations)
+		if (CachedRepresentation const* cached = util::valueOrNullptr(*m_params.representations, key))
+			if (cached->steps < m_maxSteps)
+			{
+				m_maxSteps -= cached->steps;
+				return cached->routine;
+			}
+
+	size_t const stepsBefore = m_maxSteps;
+	AssemblyItems routine = computeRepresentation(_value);
+	if (m_params.representations && m_maxSteps > 0)
+		m_params.representations->emplace(move(key), CachedRepresentation{routine, stepsBefore - m_maxSteps});
+	return routine;
+}
+
+AssemblyItems ComputeMethod::computeRepresentation(u256 const& _value)
+{
+	if (numberEncodingSize(~_value) < numberEncodingSize(_value))
 		// Negated is shorter to represent
 		return findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
-	else
+
+	// Decompose value into a * 2**k + b where abs(b) << 2**k
+	// Is not always better, try literal and decomposition method.
+	AssemblyItems routine{u256(_value)};
+	bigint bestGas = gasNeeded(routine);
+	auto consider = [&](AssemblyItems _newRoutine)
 	{
-		// Decompose value into a * 2**k + b where abs(b) << 2**k
-		// Is not always better, try literal and decomposition method.
-		AssemblyItems routine{u256(_value)};
-		bigint bestGas = gasNeeded(routine);
-		for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
+		bigint newGas = gasNeeded(_newRoutine);
+		if (newGas < bestGas)
 		{
-			unsigned gapDetector = unsigned((_value >> (bits - 8)) & 0x1ff);
-			if (gapDetector != 0xff && gapDetector != 0x100)
-				continue;
+			bestGas = move(newGas);
+			routine = move(_newRoutine);
+		}
+	};
 
-			u256 powerOfTwo = u256(1) << bits;
-			u256 upperPart = _value >> bits;
-			bigint lowerPart = _value & (powerOfTwo - 1);
-			if ((powerOfTwo - lowerPart) < lowerPart)
-			{
-				lowerPart = lowerPart - powerOfTwo; // make it negative
-				upperPart++;
-			}
-			if (upperPart == 0)
-				continue;
-			if (abs(lowerPart) >= (powerOfTwo >> 8))
-				continue;
+	for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
+	{
+		unsigned gapDetector = unsigned((_value >> (bits - 8)) & 0x1ff);
+		if (gapDetector != 0xff && gapDetector != 0x100)
+			continue;
 
-			AssemblyItems newRoutine;
-			if (lowerPart != 0)
-				newRoutine += findRepresentation(u256(abs(lowerPart)));
-			if (m_params.evmVersion.hasBitwiseShifting())
-			{
-				newRoutine += findRepresentation(upperPart);
-				newRoutine += AssemblyItems{u256(bits), Instruction::SHL};
-			}
-			else
-			{
-				newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
-				if (upperPart != 1)
-					newRoutine += findRepresentation(upperPart) + AssemblyItems{Instruction::MUL};
-			}
-			if (lowerPart > 0)
-				newRoutine += AssemblyItems{Instruction::ADD};
-			else if (lowerPart < 0)
-				newRoutine.push_back(Instruction::SUB);
-
-			if (m_maxSteps > 0)
-				m_maxSteps--;
-			bigint newGas = gasNeeded(newRoutine);
-			if (newGas < bestGas)
-			{
-				bestGas = move(newGas);
-				routine = move(newRoutine);
-			}
+		u256 powerOfTwo = u256(1) << bits;
+		u256 upperPart = _value >> bits;
+		bigint lowerPart = _value & (powerOfTwo - 1);
+		if ((powerOfTwo - lowerPart) < lowerPart)
+		{
+			lowerPart = lowerPart - powerOfTwo; // make it negative
+			upperPart++;
+		}
+		if (upperPart == 0)
+			continue;
+		if (abs(lowerPart) >= (powerOfTwo >> 8))
+			continue;
+
+		AssemblyItems newRoutine;
+		if (lowerPart != 0)
+			newRoutine += findRepresentation(u256(abs(lowerPart)));
+		if (m_params.evmVersion.hasBitwiseShifting())
+		{
+			newRoutine += findRepresentation(upperPart);
+			newRoutine += AssemblyItems{u256(bits), Instruction::SHL};
 		}
-		return routine;
+		else
+		{
+			newRoutine += AssemblyItems{u256(bits), u256(2), Instruction::EXP};
+			if (upperPart != 1)
+				newRoutine += findRepresentation(upperPart) + AssemblyItems{Instruction::MUL};
+		}
+		if (lowerPart > 0)
+			newRoutine += AssemblyItems{Instruction::ADD};
+		else if (lowerPart < 0)
+			newRoutine.push_back(Instruction::SUB);
+
+		if (m_maxSteps > 0)
+			m_maxSteps--;
+		consider(move(newRoutine));
 	}
+
+	// The negation is not shorter, but it might still be cheaper to compute. Only smaller values
+	// are considered, so that the recursion terminates.
+	if (m_params.computeNegation && ~_value < _value && m_maxSteps > 0)
+		consider(findRepresentation(~_value) + AssemblyItems{Instruction::NOT});
+
+	return routine;
 }
 
 bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const
@@ -29,6 +29,8 @@
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
 
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace solidity::evmasm
@@ -46,23 +48,38 @@ class ConstantOptimisationMethod
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
+	/// @param _computeNegation if true, also tries to compute the negation of constants that
+	/// are not shorter to encode than the constant itself.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		bool _computeNegation = false
 	);
 
 protected:
 	/// This is the public API for the optimiser methods, but it doesn't need to be exposed to the caller.
 
+	/// A representation found by the compute method and the number of search steps it took.
+	struct CachedRepresentation
+	{
+		AssemblyItems routine;
+		size_t steps;
+	};
+	/// Representations found by the compute method, by value and multiplicity.
+	using RepresentationCache = std::map<std::pair<u256, size_t>, CachedRepresentation>;
+
 	struct Params
 	{
 		bool isCreation; ///< Whether this is called during contract creation or runtime.
 		size_t runs; ///< Estimated number of calls per opcode oven the lifetime of the contract.
 		size_t multiplicity; ///< Number of times the constant appears in the code.
 		langutil::EVMVersion evmVersion; ///< Version of the EVM
+		bool computeNegation = false; ///< Whether to also try computing negations that are not shorter.
+		/// Results of the compute method shared by all constants of an assembly, if not null.
+		RepresentationCache* representations = nullptr;
 	};
 
 	explicit ConstantOptimisationMethod(Params const& _params, u256 const& _value):
@@ -78,7 +95,7 @@ protected:
 	/// @returns the run gas for the given items ignoring special gas costs
 	static bigint simpleRunGas(AssemblyItems const& _items);
 	/// @returns the gas needed to store the given data literally
-	bigint dataGas(bytes const& _data) const;
+	bigint dataGas(bytesConstRef _data) const;
 	static size_t bytesRequired(AssemblyItems const& _items);
 	/// @returns the combined estimated gas usage taking @a m_params into account.
 	bigint combineGas(
@@ -150,8 +167,12 @@ public:
 	}
 
 protected:
-	/// Tries to recursively find a way to compute @a _value.
+	/// Tries to recursively find a way to compute @a _value (or its negation).
+	/// Results that were found without exhausting the step budget are shared with the other
+	/// constants of the assembly via @a m_params.representations.
 	AssemblyItems findRepresentation(u256 const& _value);
+	/// Computes the representation for findRepresentation without consulting the cache.
+	AssemblyItems computeRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
 	bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const;
 	bigint gasNeeded(AssemblyItems const& _routine) const;
@@ -71,64 +71,70 @@ void ControlFlowGraph::findLargestTag()
 void ControlFlowGraph::splitBlocks()
 {
 	m_blocks.clear();
+	// One entry for each tag and one for the initial block. New IDs are inserted in front of
+	// the initial block by generateNewId.
+	m_blocks.resize(size_t(m_lastUsedId) + 2);
 	BlockId id = BlockId::initial();
-	m_blocks[id].begin = 0;
+	createBlock(id).begin = 0;
 	for (size_t index = 0; index < m_items.size(); ++index)
 	{
 		AssemblyItem const& item = m_items.at(index);
 		if (item.type() == Tag)
 		{
 			if (id)
-				m_blocks[id].end = static_cast<unsigned>(index);
+				createBlock(id).end = static_cast<unsigned>(index);
 			id = BlockId::invalid();
 		}
 		if (!id)
 		{
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
-			m_blocks[id].begin = static_cast<unsigned>(index);
+			createBlock(id).begin = static_cast<unsigned>(index);
 		}
 		if (item.type() == PushTag)
-			m_blocks[id].pushedTags.emplace_back(item.data());
+			createBlock(id).pushedTags.emplace_back(item.data());
 		if (SemanticInformation::altersControlFlow(item))
 		{
-			m_blocks[id].end = static_cast<unsigned>(index + 1);
+			BasicBlock& block = createBlock(id);
+			block.end = static_cast<unsigned>(index + 1);
 			if (item == Instruction::JUMP)
-				m_blocks[id].endType = BasicBlock::EndType::JUMP;
+				block.endType = BasicBlock::EndType::JUMP;
 			else if (item == Instruction::JUMPI)
-				m_blocks[id].endType = BasicBlock::EndType::JUMPI;
+				block.endType = BasicBlock::EndType::JUMPI;
 			else
-				m_blocks[id].endType = BasicBlock::EndType::STOP;
+				block.endType = BasicBlock::EndType::STOP;
 			id = BlockId::invalid();
 		}
 	}
 	if (id)
 	{
-		m_blocks[id].end = static_cast<unsigned>(m_items.size());
-		if (m_blocks[id].endType == BasicBlock::EndType::HANDOVER)
-			m_blocks[id].endType = BasicBlock::EndType::STOP;
+		BasicBlock& block = createBlock(id);
+		block.end = static_cast<unsigned>(m_items.size());
+		if (block.endType == BasicBlock::EndType::HANDOVER)
+			block.endType = BasicBlock::EndType::STOP;
 	}
 }
 
 void ControlFlowGraph::resolveNextLinks()
 {
-	map<unsigned, BlockId> blockByBeginPos;
-	for (auto const& idAndBlock: m_blocks)
-		if (idAndBlock.second.begin != idAndBlock.second.end)
-			blockByBeginPos[idAndBlock.second.begin] = idAndBlock.first;
+	vector<BlockId> blockByBeginPos(m_items.size() + 1, BlockId::invalid());
+	for (size_t index = 0; index < m_blocks.size(); ++index)
+		if (m_blocks[index] && m_blocks[index]->begin != m_blocks[index]->end)
+			blockByBeginPos[m_blocks[index]->begin] = blockId(index);
 
-	for (auto& idAndBlock: m_blocks)
+	for (auto& block: m_blocks)
 	{
-		BasicBlock& block = idAndBlock.second;
-		switch (block.endType)
+		if (!block)
+			continue;
+		switch (block->endType)
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
 			assertThrow(
-				blockByBeginPos.count(block.end),
+				block->end < blockByBeginPos.size() && blockByBeginPos[block->end],
 				OptimizerException,
 				"Successor block not found."
 			);
-			block.next = blockByBeginPos.at(block.end);
+			block->next = blockByBeginPos[block->end];
 			break;
 		default:
 			break;
@@ -139,70 +145,78 @@ void ControlFlowGraph::resolveNextLinks()
 void ControlFlowGraph::removeUnusedBlocks()
 {
 	vector<BlockId> blocksToProcess{BlockId::initial()};
-	set<BlockId> neededBlocks{BlockId::initial()};
+	vector<bool> neededBlocks(m_blocks.size(), false);
+	neededBlocks[blockIndex(BlockId::initial())] = true;
 	while (!blocksToProcess.empty())
 	{
-		BasicBlock const& block = m_blocks.at(blocksToProcess.back());
+		BasicBlock const& block = *this->block(blocksToProcess.back());
 		blocksToProcess.pop_back();
 		for (BlockId tag: block.pushedTags)
-			if (!neededBlocks.count(tag) && m_blocks.count(tag))
+			if (this->block(tag) && !neededBlocks[blockIndex(tag)])
 			{
-				neededBlocks.insert(tag);
+				neededBlocks[blockIndex(tag)] = true;
 				blocksToProcess.push_back(tag);
 			}
-		if (block.next && !neededBlocks.count(block.next))
+		if (block.next && !neededBlocks[blockIndex(block.next)])
 		{
-			neededBlocks.insert(block.next);
+			neededBlocks[blockIndex(block.next)] = true;
 			blocksToProcess.push_back(block.next);
 		}
 	}
-	for (auto it = m_blocks.begin(); it != m_blocks.end();)
-		if (neededBlocks.count(it->first))
-			++it;
-		else
-			m_blocks.erase(it++);
+	for (size_t index = 0; index < m_blocks.size(); ++index)
+		if (!neededBlocks[index])
+			m_blocks[index].reset();
 }
 
 void ControlFlowGraph::setPrevLinks()
 {
-	for (auto& idAndBlock: m_blocks)
+	for (size_t index = 0; index < m_blocks.size(); ++index)
 	{
-		BasicBlock& block = idAndBlock.second;
+		if (!m_blocks[index])
+			continue;
+		BasicBlock& block = *m_blocks[index];
 		switch (block.endType)
 		{
 		case BasicBlock::EndType::JUMPI:
 		case BasicBlock::EndType::HANDOVER:
+		{
+			BasicBlock* next = this->block(block.next);
+			assertThrow(next, OptimizerException, "Successor block not found.");
 			assertThrow(
-				!m_blocks.at(block.next).prev,
+				!next->prev,
 				OptimizerException,
 				"Successor already has predecessor."
 			);
-			m_blocks[block.next].prev = idAndBlock.first;
+			next->prev = blockId(index);
 			break;
+		}
 		default:
 			break;
 		}
 	}
 	// If block ends with jump to not yet linked block, link them removing the jump
-	for (auto& idAndBlock: m_blocks)
+	for (size_t index = 0; index < m_blocks.size(); ++index)
 	{
-		BlockId blockId = idAndBlock.first;
-		BasicBlock& block = idAndBlock.second;
+		if (!m_blocks[index])
+			continue;
+		BlockId blockId = this->blockId(index);
+		BasicBlock& block = *m_blocks[index];
 		if (block.endType != BasicBlock::EndType::JUMP || block.end - block.begin < 2)
 			continue;
 		AssemblyItem const& push = m_items.at(block.end - 2);
 		if (push.type() != PushTag)
 			continue;
 		BlockId nextId(push.data());
-		if (m_blocks.count(nextId) && m_blocks.at(nextId).prev)
+		BasicBlock* next = this->block(nextId);
+		if (next && next->prev)
 			continue;
 		bool hasLoop = false;
-		for (BlockId id = nextId; id && m_blocks.count(id) && !hasLoop; id = m_blocks.at(id).next)
+		for (BlockId id = nextId; id && this->block(id) && !hasLoop; id = this->block(id)->next)
 			hasLoop = (id == blockId);
-		if (hasLoop || !m_blocks.count(nextId))
+		if (hasLoop || !next)
 			continue;
 
-		m_blocks[nextId].prev = blockId;
+		next->prev = blockId;
 		block.next = nextId;
 		block.end -= 2;
 		assertThrow(
@@ -222,20 +236,36 @@ void ControlFlowGraph::gatherKnowledge()
 	KnownStatePointer emptyState = make_shared<KnownState>();
 	bool unknownJumpEncountered = false;
 
+	/// The blocks on the path that led to a work queue item. The paths of the successors of
+	/// a block share the path to the block.
+	struct PathNode
+	{
+		BlockId blockId;
+		shared_ptr<PathNode const> previous;
+	};
+	auto const onPath = [](shared_ptr<PathNode const> const& _path, BlockId _blockId)
+	{
+		for (PathNode const* node = _path.get(); node; node = node->previous.get())
+			if (node->blockId == _blockId)
+				return true;
+		return false;
+	};
+
 	struct WorkQueueItem {
 		BlockId blockId;
+		/// State when entering the block. It is shared with other items and the end state of
+		/// the previous block and only copied once it is modified.
 		KnownStatePointer state;
-		set<BlockId> blocksSeen;
+		shared_ptr<PathNode const> blocksSeen;
 	};
 
-	vector<WorkQueueItem> workQueue{WorkQueueItem{BlockId::initial(), emptyState->copy(), set<BlockId>()}};
+	vector<WorkQueueItem> workQueue{WorkQueueItem{BlockId::initial(), emptyState, nullptr}};
 	auto addWorkQueueItem = [&](WorkQueueItem const& _currentItem, BlockId _to, KnownStatePointer const& _state)
 	{
 		WorkQueueItem item;
 		item.blockId = _to;
-		item.state = _state->copy();
-		item.blocksSeen = _currentItem.blocksSeen;
-		item.blocksSeen.insert(_currentItem.blockId);
+		item.state = _state;
+		item.blocksSeen = make_shared<PathNode const>(PathNode{_currentItem.blockId, _currentItem.blocksSeen});
 		workQueue.push_back(move(item));
 	};
 
@@ -245,17 +275,18 @@ void ControlFlowGraph::gatherKnowledge()
 		workQueue.pop_back();
 		//@todo we might have to do something like incrementing the sequence number for each JUMPDEST
 		assertThrow(!!item.blockId, OptimizerException, "");
-		if (!m_blocks.count(item.blockId))
+		BasicBlock* blockPointer = this->block(item.blockId);
+		if (!blockPointer)
 			continue; // too bad, we do not know the tag, probably an invalid jump
-		BasicBlock& block = m_blocks.at(item.blockId);
-		KnownStatePointer state = item.state;
+		BasicBlock& block = *blockPointer;
+		KnownStatePointer state = item.state.use_count() > 1 ? item.state->copy() : move(item.state);
 		if (block.startState)
 		{
 			// We call reduceToCommonKnowledge even in the non-join setting to get the correct
 			// sequence number
 			if (!m_joinKnowledge)
 				state->reset();
-			state->reduceToCommonKnowledge(*block.startState, !item.blocksSeen.count(item.blockId));
+			state->reduceToCommonKnowledge(*block.startState, !onPath(item.blocksSeen, item.blockId));
 			if (*state == *block.startState)
 				continue;
 		}
@@ -287,9 +318,13 @@ void ControlFlowGraph::gatherKnowledge()
 					// We do not know the target of this jump, so we have to reset the states of all
 					// JUMPDESTs.
 					unknownJumpEncountered = true;
-					for (auto const& it: m_blocks)
-						if (it.second.begin < it.second.end && m_items[it.second.begin].type() == Tag)
-							workQueue.push_back(WorkQueueItem{it.first, emptyState->copy(), set<BlockId>()});
+					for (size_t index = 0; index < m_blocks.size(); ++index)
+						if (
+							m_blocks[index] &&
+							m_blocks[index]->begin < m_blocks[index]->end &&
+							m_items[m_blocks[index]->begin].type() == Tag
+						)
+							workQueue.push_back(WorkQueueItem{blockId(index), emptyState, nullptr});
 				}
 			}
 			else
@@ -312,46 +347,48 @@ void ControlFlowGraph::gatherKnowledge()
 	// Remove all blocks we never visited here. This might happen because a tag is pushed but
 	// never used for a JUMP.
 	// Note that this invalidates some contents of pushedTags
-	for (auto it = m_blocks.begin(); it != m_blocks.end();)
-		if (!it->second.startState)
-			it = m_blocks.erase(it);
-		else
-			it++;
+	for (auto& block: m_blocks)
+		if (block && !block->startState)
+			block.reset();
 }
 
 BasicBlocks ControlFlowGraph::rebuildCode()
 {
-	map<BlockId, unsigned> pushes;
-	for (auto& idAndBlock: m_blocks)
-		for (BlockId ref: idAndBlock.second.pushedTags)
-			if (m_blocks.count(ref))
-				pushes[ref]++;
-
-	set<BlockId> blocksToAdd;
-	for (auto it: m_blocks)
-		blocksToAdd.insert(it.first);
-	set<BlockId> blocksAdded;
+	auto blockAt = [&](BlockId _id) -> BasicBlock&
+	{
+		BasicBlock* block = this->block(_id);
+		assertThrow(block, OptimizerException, "Block not found.");
+		return *block;
+	};
+
+	vector<unsigned> pushes(m_blocks.size(), 0);
+	for (auto const& block: m_blocks)
+		if (block)
+			for (BlockId ref: block->pushedTags)
+				if (this->block(ref))
+					pushes[blockIndex(ref)]++;
+
+	vector<bool> blocksToAdd(m_blocks.size(), false);
+	for (size_t index = 0; index < m_blocks.size(); ++index)
+		blocksToAdd[index] = m_blocks[index].has_value();
+	// All blocks before this index have been added.
+	size_t nextBlockToAdd = 0;
 	BasicBlocks blocks;
 
-	for (
-		BlockId blockId = BlockId::initial();
-		blockId;
-		blockId = blocksToAdd.empty() ? BlockId::invalid() : *blocksToAdd.begin()
-	)
+	for (BlockId blockId = BlockId::initial(); blockId;)
 	{
 		bool previousHandedOver = (blockId == BlockId::initial());
-		while (m_blocks.at(blockId).prev)
-			blockId = m_blocks.at(blockId).prev;
-		for (; blockId; blockId = m_blocks.at(blockId).next)
+		while (blockAt(blockId).prev)
+			blockId = blockAt(blockId).prev;
+		for (; blockId; blockId = blockAt(blockId).next)
 		{
-			BasicBlock& block = m_blocks.at(blockId);
-			blocksToAdd.erase(blockId);
-			blocksAdded.insert(blockId);
+			BasicBlock& block = blockAt(blockId);
+			blocksToAdd[blockIndex(blockId)] = false;
 
 			if (block.begin == block.end)
 				continue;
 			// If block starts with unused tag, skip it.
-			if (previousHandedOver && !pushes[blockId] && m_items[block.begin].type() == Tag)
+			if (previousHandedOver && !pushes[blockIndex(blockId)] && m_items[block.begin].type() == Tag)
 				++block.begin;
 			if (block.begin < block.end)
 			{
@@ -361,6 +398,10 @@ BasicBlocks ControlFlowGraph::rebuildCode()
 			}
 			previousHandedOver = (block.endType == BasicBlock::EndType::HANDOVER);
 		}
+
+		while (nextBlockToAdd < blocksToAdd.size() && !blocksToAdd[nextBlockToAdd])
+			++nextBlockToAdd;
+		blockId = nextBlockToAdd < blocksToAdd.size() ? this->blockId(nextBlockToAdd) : BlockId::invalid();
 	}
 
 	return blocks;
@@ -370,5 +411,37 @@ BlockId ControlFlowGraph::generateNewId()
 {
 	BlockId id = BlockId(++m_lastUsedId);
 	assertThrow(id < BlockId::initial(), OptimizerException, "Out of block IDs.");
+	// The initial block stays at the end.
+	m_blocks.emplace(m_blocks.end() - 1);
 	return id;
 }
+
+size_t ControlFlowGraph::blockIndex(BlockId _id) const
+{
+	assertThrow(_id, OptimizerException, "Invalid block ID.");
+	return _id == BlockId::initial() ? m_blocks.size() - 1 : _id.tag();
+}
+
+BlockId ControlFlowGraph::blockId(size_t _index) const
+{
+	return _index == m_blocks.size() - 1 ? BlockId::initial() : BlockId(static_cast<unsigned>(_index));
+}
+
+BasicBlock* ControlFlowGraph::block(BlockId _id)
+{
+	if (!_id)
+		return nullptr;
+	size_t index = blockIndex(_id);
+	if (index >= m_blocks.size() || !m_blocks[index])
+		return nullptr;
+	return &*m_blocks[index];
+}
+
+BasicBlock& ControlFlowGraph::createBlock(BlockId _id)
+{
+	size_t index = blockIndex(_id);
+	assertThrow(index < m_blocks.size(), OptimizerException, "Tag number too large.");
+	if (!m_blocks[index])
+		m_blocks[index].emplace();
+	return *m_blocks[index];
+}
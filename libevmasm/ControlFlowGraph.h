@@ -31,6 +31,7 @@
 #include <vector>
 #include <memory>
 #include <limits>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -55,6 +56,8 @@ public:
 	bool operator!=(BlockId const& _other) const { return m_id != _other.m_id; }
 	bool operator<(BlockId const& _other) const { return m_id < _other.m_id; }
 	explicit operator bool() const { return *this != invalid(); }
+	/// @returns the tag number of the block. Only valid for blocks other than the initial block.
+	unsigned tag() const { return m_id; }
 
 private:
 	unsigned m_id;
@@ -120,10 +123,20 @@ private:
 
 	BlockId generateNewId();
 
+	/// @returns the index of the block with ID @a _id in @a m_blocks.
+	size_t blockIndex(BlockId _id) const;
+	/// @returns the ID of the block at index @a _index of @a m_blocks.
+	BlockId blockId(size_t _index) const;
+	/// @returns the block with ID @a _id or nullptr if there is no such block.
+	BasicBlock* block(BlockId _id);
+	/// @returns the block with ID @a _id, creating it if there is no such block.
+	BasicBlock& createBlock(BlockId _id);
+
 	unsigned m_lastUsedId = 0;
 	AssemblyItems const& m_items;
 	bool m_joinKnowledge = true;
-	std::map<BlockId, BasicBlock> m_blocks;
+	/// The blocks indexed by their tag number, followed by the initial block, i.e. ordered by ID.
+	std::vector<std::optional<BasicBlock>> m_blocks;
 };
 
 
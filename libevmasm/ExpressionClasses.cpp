@@ -27,6 +27,8 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <libsolutil/Profiler.h>
+
 #include <functional>
 #include <tuple>
 #include <limits>
@@ -150,7 +152,7 @@ bool ExpressionClasses::knownNonZero(Id _c)
 
 u256 const* ExpressionClasses::knownConstant(Id _c)
 {
-	map<unsigned, Expression const*> matchGroups;
+	MatchGroups<Expression> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
@@ -183,7 +185,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// Matching stores state in the rules, so every thread needs its own copy.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -206,6 +209,7 @@ ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 			cout << "to " << match->action().toString() << endl;
 		}
 
+		SOL_OPTIMIZER_COUNT("evmasmCSE/" + match->pattern.toString());
 		return rebuildExpression(ExpressionTemplate(match->action(), _expr.item->location()));
 	}
 
@@ -272,7 +272,7 @@ unsigned GasMeter::runGas(Instruction _instruction)
 	return 0;
 }
 
-u256 GasMeter::dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
+u256 GasMeter::dataGas(bytesConstRef _data, bool _inCreation, langutil::EVMVersion _evmVersion)
 {
 	bigint gas = 0;
 	if (_inCreation)
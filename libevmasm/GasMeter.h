@@ -226,7 +226,11 @@ public:
 	/// @returns the gas cost of the supplied data, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
 	/// otherwise code will be stored and have to pay "createDataGas" cost.
-	static u256 dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion);
+	static u256 dataGas(bytesConstRef _data, bool _inCreation, langutil::EVMVersion _evmVersion);
+	static u256 dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
+	{
+		return dataGas(bytesConstRef(&_data), _inCreation, _evmVersion);
+	}
 
 	/// @returns the gas cost of non-zero data of the supplied length, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
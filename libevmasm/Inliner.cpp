@@ -66,6 +66,15 @@ uint64_t codeSize(RangeType const& _itemRange)
 		[](auto const& _item) { return _item.bytesRequired(2, Precision::Approximate); }
 	), 0u);
 }
+/// @returns true if @a _item does not alter the control flow and behaves the same when copied
+/// to a different position in the code.
+bool isCopyableStraightLineItem(AssemblyItem const& _item)
+{
+	return
+		_item.type() == Operation &&
+		!SemanticInformation::altersControlFlow(_item) &&
+		_item != Instruction::PC;
+}
 /// @returns the tag id, if @a _item is a PushTag or Tag into the current subassembly, nullopt otherwise.
 optional<size_t> getLocalTag(AssemblyItem const& _item)
 {
@@ -113,7 +122,11 @@ map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyI
 
 		// We can only inline blocks with straight control flow that end in a jump.
 		// Using breaksCSEAnalysisBlock will hopefully allow the return jump to be optimized after inlining.
-		if (lastTag && SemanticInformation::breaksCSEAnalysisBlock(item, false))
+		if (
+			lastTag &&
+			SemanticInformation::breaksCSEAnalysisBlock(item, false) &&
+			!(m_withSideEffects && isCopyableStraightLineItem(item))
+		)
 		{
 			ranges::span<AssemblyItem const> block = _items | ranges::views::slice(*lastTag + 1, index + 1);
 			if (optional<size_t> tag = getLocalTag(_items[*lastTag]))
@@ -42,13 +42,15 @@ public:
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		bool _withSideEffects = false
 	):
 	m_items(_items),
 	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
 	m_runs(_runs),
 	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_withSideEffects(_withSideEffects)
 	{
 	}
 	virtual ~Inliner() = default;
@@ -79,6 +81,9 @@ private:
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// If true, blocks are not ended by instructions that only break the CSE analysis
+	/// (like calls, logs or memory copies), so that functions containing them can be inlined.
+	bool const m_withSideEffects = false;
 };
 
 }
@@ -297,6 +297,6 @@ InstructionInfo instructionInfo(Instruction _inst);
 bool isValidInstruction(Instruction _inst);
 
 /// Convert from string mnemonic to Instruction type.
-extern const std::map<std::string, Instruction> c_instructions;
+std::map<std::string, Instruction> const& instructions();
 
 }
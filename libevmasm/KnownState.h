@@ -108,11 +108,11 @@ public:
 	StoreOperation feedItem(AssemblyItem const& _item, bool _copyItem = false);
 
 	/// Resets any knowledge about storage.
-	void resetStorage() { m_storageContent.clear(); }
+	void resetStorage() { m_storageContent = {}; }
 	/// Resets any knowledge about storage.
-	void resetMemory() { m_memoryContent.clear(); }
+	void resetMemory() { m_memoryContent = {}; }
 	/// Resets known Keccak-256 hashes
-	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.clear(); }
+	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes = {}; }
 	/// Resets any knowledge about the current stack.
 	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
 	/// Resets any knowledge.
@@ -127,6 +127,7 @@ public:
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
 	/// @returns a shared pointer to a copy of this state.
+	/// The knowledge about storage and memory is shared with the copy until one of them changes it.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -149,9 +150,41 @@ public:
 	std::map<int, Id> const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
+	/// Value that is shared between copies of its owner until one of them modifies it.
+	/// States are copied at every edge of the control flow graph, but the knowledge about storage
+	/// and memory often stays the same across many blocks.
+	template <class T>
+	class CopyOnWrite
+	{
+	public:
+		T const& operator*() const
+		{
+			static T const empty;
+			return m_value ? *m_value : empty;
+		}
+		T const* operator->() const { return &**this; }
+		/// @returns the value for modification, copying it first if it is shared.
+		T& write()
+		{
+			if (!m_value)
+				m_value = std::make_shared<T>();
+			else if (m_value.use_count() > 1)
+				m_value = std::make_shared<T>(*m_value);
+			return *m_value;
+		}
+		void set(T _value) { m_value = std::make_shared<T>(std::move(_value)); }
+		/// @returns true if the value is shared with @a _other, i.e. known to be equal to it.
+		bool sharedWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+		bool operator==(CopyOnWrite const& _other) const { return sharedWith(_other) || **this == *_other; }
+		bool operator!=(CopyOnWrite const& _other) const { return !(*this == _other); }
+
+	private:
+		std::shared_ptr<T> m_value;
+	};
+
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
 	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
@@ -182,18 +215,18 @@ private:
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	CopyOnWrite<std::map<Id, Id>> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	CopyOnWrite<std::map<Id, Id>> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	CopyOnWrite<std::map<std::pair<std::vector<Id>, unsigned>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	CopyOnWrite<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
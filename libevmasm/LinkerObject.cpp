@@ -50,10 +50,15 @@ void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 string LinkerObject::toHex() const
 {
 	string hex = solidity::util::toHex(bytecode);
+	// Libraries are usually referenced several times, so their placeholders are computed only once.
+	map<string, string> placeholders;
 	for (auto const& ref: linkReferences)
 	{
 		size_t pos = ref.first * 2;
-		string hash = libraryPlaceholder(ref.second);
+		auto [it, inserted] = placeholders.try_emplace(ref.second);
+		if (inserted)
+			it->second = libraryPlaceholder(ref.second);
+		string const& hash = it->second;
 		hex[pos] = hex[pos + 1] = hex[pos + 38] = hex[pos + 39] = '_';
 		for (size_t i = 0; i < 36; ++i)
 			hex[pos + 2 + i] = hash.at(i);
@@ -28,8 +28,8 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, size_t _maxPaths):
+	m_items(_items), m_evmVersion(_evmVersion), m_remainingPaths(_maxPaths)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -48,7 +48,12 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 
 	GasMeter::GasConsumption gas;
 	while (!m_queue.empty() && !gas.isInfinite)
+	{
+		if (m_remainingPaths == 0)
+			return GasMeter::GasConsumption::infinite();
+		--m_remainingPaths;
 		gas = max(gas, handleQueueItem());
+	}
 	return gas;
 }
 
@@ -123,12 +128,21 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		{
 			auto newPath = make_unique<GasPath>();
 			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			if (auto it = m_tagPositions.find(tag); it != m_tagPositions.end())
+				newPath->index = it->second;
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
-			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
+			// The last target of a path that does not continue can take over its state.
+			if (branchStops && tag == *jumpTags.rbegin())
+			{
+				newPath->state = state;
+				newPath->visitedJumpdests = move(path->visitedJumpdests);
+			}
+			else
+			{
+				newPath->state = state->copy();
+				newPath->visitedJumpdests = path->visitedJumpdests;
+			}
 			queue(move(newPath));
 		}
 
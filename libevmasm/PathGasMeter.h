@@ -48,11 +48,20 @@ struct GasPath
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ * The exploration is limited to a number of paths (each running from a jumpdest to the next jump),
+ * after which the gas usage is reported as infinite.
  */
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// Default for the maximal number of paths explored in a single estimation.
+	static size_t constexpr defaultMaxPaths = 100000;
+
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _maxPaths = defaultMaxPaths
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -60,10 +69,11 @@ public:
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		size_t _maxPaths = defaultMaxPaths
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, _maxPaths).estimateMax(_startIndex, _state);
 	}
 
 private:
@@ -81,6 +91,8 @@ private:
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	/// Number of paths that can still be explored.
+	size_t m_remainingPaths;
 };
 
 }
@@ -25,6 +25,14 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/Profiler.h>
+
+#ifdef SOL_OPTIMIZER_COUNTERS
+#include <boost/core/demangle.hpp>
+
+#include <typeinfo>
+#endif
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -372,11 +380,23 @@ void applyMethods(OptimiserState&)
 	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
 }
 
+#ifdef SOL_OPTIMIZER_COUNTERS
+/// @returns the name of the optimizer method @a Method, without the enclosing namespace.
+template <typename Method>
+string methodName()
+{
+	string name = boost::core::demangle(typeid(Method).name());
+	return name.substr(name.rfind(':') == string::npos ? 0 : name.rfind(':') + 1);
+}
+#endif
+
 template <typename Method, typename... OtherMethods>
 void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
 	if (!Method::apply(_state))
 		applyMethods(_state, _other...);
+	else if constexpr (!is_same_v<Method, Identity>)
+		SOL_OPTIMIZER_COUNT("peepholeOptimiser/" + methodName<Method>());
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -23,6 +23,8 @@
 
 #include <libevmasm/Instruction.h>
 #include <libsolutil/CommonData.h>
+
+#include <array>
 #include <functional>
 
 namespace solidity::evmasm
@@ -51,6 +53,26 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/**
+ * Expressions matched by the match groups of the patterns of a rule during matching, indexed
+ * by match group. The match groups of the rule list are small numbers, so a fixed-size array
+ * is enough and matching does not need to allocate. Provides the subset of the interface
+ * of a map that is used by the patterns.
+ */
+template <class Expression>
+class MatchGroups
+{
+public:
+	static constexpr unsigned MaxGroups = 8;
+
+	size_t count(unsigned _group) const { return m_matches.at(_group) ? 1 : 0; }
+	Expression const*& operator[](unsigned _group) { return m_matches.at(_group); }
+	void clear() { m_matches.fill(nullptr); }
+
+private:
+	std::array<Expression const*, MaxGroups> m_matches{};
+};
+
 template <typename Pattern>
 struct EVMBuiltins
 {
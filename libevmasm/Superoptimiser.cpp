@@ -0,0 +1,201 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file Superoptimiser.cpp
+ * Replaces short windows of straight-line stack code by cheaper equivalent sequences
+ * found by exhaustive search.
+ */
+
+#include <libevmasm/Superoptimiser.h>
+
+#include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns true if the item can be part of a window, i.e. if it only modifies the stack and
+/// its result only depends on the stack (and on values that are constant during the execution).
+bool isStackOnly(AssemblyItem const& _item)
+{
+	if (_item.type() == Push)
+		return true;
+	if (_item.type() != Operation)
+		return false;
+	Instruction instruction = _item.instruction();
+	if (isDupInstruction(instruction) || isSwapInstruction(instruction) || instruction == Instruction::POP)
+		return true;
+	return
+		SemanticInformation::movable(instruction) &&
+		SemanticInformation::memory(instruction) == SemanticInformation::None &&
+		SemanticInformation::storage(instruction) == SemanticInformation::None &&
+		// The cost of EXP depends on its argument.
+		instruction != Instruction::EXP;
+}
+
+/// @returns the run gas and the size in bytes of the items.
+pair<unsigned, size_t> cost(AssemblyItems const& _items)
+{
+	unsigned gas = 0;
+	for (AssemblyItem const& item: _items)
+		gas += GasMeter::runGas(item.type() == Push ? Instruction::PUSH1 : item.instruction());
+	return {gas, bytesRequired(_items, 1)};
+}
+
+/// @returns the number of stack elements below the initial top that are accessed by the items
+/// and the difference of the stack height after and before the items.
+pair<size_t, int> stackEffect(AssemblyItems const& _items)
+{
+	int height = 0;
+	int lowest = 0;
+	for (AssemblyItem const& item: _items)
+	{
+		lowest = min(lowest, height - static_cast<int>(item.arguments()));
+		height += static_cast<int>(item.returnValues()) - static_cast<int>(item.arguments());
+	}
+	return {static_cast<size_t>(-lowest), height};
+}
+
+/// @returns the classes of the stack elements from @a _depth elements below the initial top
+/// up to the final top after executing the items.
+vector<ExpressionClasses::Id> stackAfter(
+	AssemblyItems const& _items,
+	size_t _depth,
+	shared_ptr<ExpressionClasses> const& _classes
+)
+{
+	KnownState state(_classes);
+	for (AssemblyItem const& item: _items)
+		state.feedItem(item, true);
+	vector<ExpressionClasses::Id> stack;
+	for (int height = 1 - static_cast<int>(_depth); height <= state.stackHeight(); ++height)
+		stack.push_back(state.stackElement(height, {}));
+	return stack;
+}
+
+}
+
+bool Superoptimiser::optimise()
+{
+	AssemblyItems optimisedItems;
+	bool changed = false;
+	for (size_t i = 0; i < m_items.size();)
+	{
+		size_t windowSize = 0;
+		while (windowSize < m_maxWindowSize && i + windowSize < m_items.size() && isStackOnly(m_items[i + windowSize]))
+			windowSize++;
+
+		optional<AssemblyItems> replacement;
+		for (; windowSize > 0 && !replacement; --windowSize)
+			replacement = cheapestEquivalent(AssemblyItems(
+				m_items.begin() + static_cast<ptrdiff_t>(i),
+				m_items.begin() + static_cast<ptrdiff_t>(i + windowSize)
+			));
+
+		if (replacement)
+		{
+			// The loop above decremented the size once more.
+			windowSize++;
+			for (AssemblyItem& item: *replacement)
+				item.setLocation(m_items[i].location());
+			optimisedItems += move(*replacement);
+			i += windowSize;
+			changed = true;
+		}
+		else
+			optimisedItems.push_back(m_items[i++]);
+	}
+
+	if (changed)
+		m_items = move(optimisedItems);
+	return changed;
+}
+
+optional<AssemblyItems> Superoptimiser::cheapestEquivalent(AssemblyItems const& _window)
+{
+	thread_local map<AssemblyItems, optional<AssemblyItems>> cache;
+	size_t constexpr maxCacheSize = 0x10000;
+	if (auto it = cache.find(_window); it != cache.end())
+		return it->second;
+
+	auto const [depth, heightChange] = stackEffect(_window);
+	pair<unsigned, size_t> const windowCost = cost(_window);
+
+	// Candidates are built from the pushes and operations of the window and from the stack
+	// instructions that only access elements the window can access.
+	set<AssemblyItem> operations;
+	for (AssemblyItem const& item: _window)
+		if (item.type() == Push)
+			operations.emplace(item.data());
+		else if (!isDupInstruction(item.instruction()) && !isSwapInstruction(item.instruction()))
+			operations.emplace(item.instruction());
+	AssemblyItems alphabet(operations.begin(), operations.end());
+	for (unsigned number = 1; number <= min<size_t>(16, depth + _window.size()); ++number)
+	{
+		alphabet.emplace_back(dupInstruction(number));
+		alphabet.emplace_back(swapInstruction(number));
+	}
+
+	auto classes = make_shared<ExpressionClasses>();
+	vector<ExpressionClasses::Id> const target = stackAfter(_window, depth, classes);
+
+	optional<AssemblyItems> best;
+	pair<unsigned, size_t> bestCost = windowCost;
+	AssemblyItems candidate;
+	function<void()> search = [&]()
+	{
+		auto const [candidateDepth, candidateHeightChange] = stackEffect(candidate);
+		if (candidateDepth > depth)
+			return;
+		pair<unsigned, size_t> const candidateCost = cost(candidate);
+		if (
+			candidateHeightChange == heightChange &&
+			candidateCost.first <= windowCost.first &&
+			candidateCost.second <= windowCost.second &&
+			candidateCost < bestCost &&
+			stackAfter(candidate, depth, classes) == target
+		)
+		{
+			best = candidate;
+			bestCost = candidateCost;
+		}
+		if (candidate.size() + 1 < _window.size())
+			for (AssemblyItem const& item: alphabet)
+			{
+				candidate.push_back(item);
+				search();
+				candidate.pop_back();
+			}
+	};
+	search();
+
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	return cache[_window] = move(best);
+}
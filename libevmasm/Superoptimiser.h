@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file Superoptimiser.h
+ * Replaces short windows of straight-line stack code by cheaper equivalent sequences
+ * found by exhaustive search.
+ */
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <optional>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Optimisation step that, for every window of at most @a _maxWindowSize items that only
+ * shuffle the stack and compute pure functions of it, enumerates all shorter sequences built
+ * from the DUP, SWAP and POP instructions and the pushes and operations of the window.
+ * Sequences that need no deeper stack than the window and lead to the same stack contents
+ * (as determined by ExpressionClasses, which also applies the simplification rules) are
+ * equivalent and the cheapest one (in run gas and bytes) replaces the window.
+ *
+ * The search is exponential in the window size, so the results for all windows seen so far
+ * are memoised per thread.
+ */
+class Superoptimiser
+{
+public:
+	explicit Superoptimiser(AssemblyItems& _items, size_t _maxWindowSize = 3):
+		m_items(_items), m_maxWindowSize(_maxWindowSize)
+	{}
+
+	/// Replaces windows by cheaper equivalents.
+	/// @returns true iff the items were modified.
+	bool optimise();
+
+private:
+	/// @returns the cheapest sequence equivalent to @a _window if it is cheaper than the window.
+	static std::optional<AssemblyItems> cheapestEquivalent(AssemblyItems const& _window);
+
+	AssemblyItems& m_items;
+	size_t m_maxWindowSize;
+};
+
+}
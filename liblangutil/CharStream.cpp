@@ -51,6 +51,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -86,15 +88,12 @@ string CharStream::lineAtPosition(int _position) const
 	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	// The line containing searchStart, or the one following it if searchStart is a line break.
+	size_t lineIndex = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), searchStart + 1) - starts.begin()) - 1;
+	size_type lineStart = starts[lineIndex];
+	size_type lineEnd = lineIndex + 1 < starts.size() ? starts[lineIndex + 1] - 1 : m_source.size();
+	string line = m_source.substr(lineStart, lineEnd - lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -103,18 +102,10 @@ string CharStream::lineAtPosition(int _position) const
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	using diff_type = string::difference_type;
 	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	vector<size_t> const& starts = lineStarts();
+	size_t line = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), searchPosition) - starts.begin()) - 1;
+	return LineColumn{static_cast<int>(line), static_cast<int>(searchPosition - starts[line])};
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -147,7 +138,19 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	if (_lineColumn.line < 0)
+		return nullopt;
+
+	vector<size_t> const& starts = lineStarts();
+	size_t line = static_cast<size_t>(_lineColumn.line);
+	if (line >= starts.size())
+		return nullopt;
+
+	size_t offset = starts[line];
+	size_t endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (offset + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return offset + static_cast<size_t>(_lineColumn.column);
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -173,3 +176,19 @@ optional<int> CharStream::translateLineColumnToPosition(std::string const& _text
 	return offset + static_cast<size_t>(_input.column);
 }
 
+vector<size_t> const& CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> lineStarts = atomic_load(&m_lineStarts);
+	if (!lineStarts)
+	{
+		auto starts = make_shared<vector<size_t>>(1, 0);
+		for (size_t position = m_source.find('\n'); position != string::npos; position = m_source.find('\n', position + 1))
+			starts->push_back(position + 1);
+		shared_ptr<vector<size_t> const> expected;
+		// If another thread was faster, use its index, so that the returned reference stays valid.
+		lineStarts = move(starts);
+		if (!atomic_compare_exchange_strong(&m_lineStarts, &expected, lineStarts))
+			lineStarts = move(expected);
+	}
+	return *lineStarts;
+}
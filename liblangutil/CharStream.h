@@ -51,10 +51,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -96,8 +98,8 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, later calls only do a binary search.
 	std::string lineAtPosition(int _position) const;
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
@@ -136,9 +138,16 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the positions at which the lines of the source start, in ascending order.
+	/// Computed on first use.
+	std::vector<size_t> const& lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Index of the line starts. Only accessed atomically, so that it can be built lazily by const
+	/// member functions. The source does not change, so copies can share it.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
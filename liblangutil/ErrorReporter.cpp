@@ -34,6 +34,7 @@ ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 	if (&_errorReporter == this)
 		return *this;
 	m_errorList = _errorReporter.m_errorList;
+	m_suppressed = _errorReporter.m_suppressed;
 	return *this;
 }
 
@@ -63,7 +64,7 @@ void ErrorReporter::warning(
 
 void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation const& _location, string const& _description)
 {
-	if (checkForExcessiveErrors(_type))
+	if (suppressed(_errorId, _type) || checkForExcessiveErrors(_type))
 		return;
 
 	m_errorList.push_back(make_shared<Error>(_errorId, _type, _description, _location));
@@ -71,7 +72,7 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 
 void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation const& _location, SecondarySourceLocation const& _secondaryLocation, string const& _description)
 {
-	if (checkForExcessiveErrors(_type))
+	if (suppressed(_errorId, _type) || checkForExcessiveErrors(_type))
 		return;
 
 	m_errorList.push_back(make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
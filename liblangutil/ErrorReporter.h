@@ -32,6 +32,8 @@
 
 #include <boost/range/adaptor/filtered.hpp>
 
+#include <functional>
+
 namespace solidity::langutil
 {
 
@@ -43,13 +45,38 @@ public:
 		m_errorList(_errors) { }
 
 	ErrorReporter(ErrorReporter const& _errorReporter) noexcept:
-		m_errorList(_errorReporter.m_errorList) { }
+		m_errorList(_errorReporter.m_errorList),
+		m_suppressed(_errorReporter.m_suppressed)
+	{ }
 
 	ErrorReporter& operator=(ErrorReporter const& _errorReporter);
 
+	/// Sets a filter for warnings and infos. Diagnostics for which @a _suppressed returns true
+	/// are dropped before an Error is created and do not count towards the limit of reported
+	/// warnings and infos. Errors are never suppressed.
+	void setSuppressionFilter(std::function<bool(ErrorId, Error::Type)> _suppressed)
+	{
+		m_suppressed = std::move(_suppressed);
+	}
+
+	/// @returns false if a diagnostic of the given type and ID would be dropped by the
+	/// suppression filter, so that callers can avoid building its description.
+	bool isReported(ErrorId _error, Error::Type _type) const
+	{
+		return !suppressed(_error, _type);
+	}
+
+	/// Appends @a _errorList except for the diagnostics dropped by the suppression filter.
 	void append(ErrorList const& _errorList)
 	{
-		m_errorList += _errorList;
+		if (!m_suppressed)
+		{
+			m_errorList += _errorList;
+			return;
+		}
+		for (std::shared_ptr<Error const> const& error: _errorList)
+			if (!suppressed(error->errorId(), error->type()))
+				m_errorList.push_back(error);
 	}
 
 	void warning(ErrorId _error, std::string const& _description);
@@ -183,7 +210,16 @@ private:
 	// @returns true if error shouldn't be stored
 	bool checkForExcessiveErrors(Error::Type _type);
 
+	bool suppressed(ErrorId _error, Error::Type _type) const
+	{
+		return
+			m_suppressed &&
+			(_type == Error::Type::Warning || _type == Error::Type::Info) &&
+			m_suppressed(_error, _type);
+	}
+
 	ErrorList& m_errorList;
+	std::function<bool(ErrorId, Error::Type)> m_suppressed;
 
 	unsigned m_errorCount = 0;
 	unsigned m_warningCount = 0;
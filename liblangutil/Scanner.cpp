@@ -60,6 +60,7 @@
 #include <string_view>
 #include <tuple>
 #include <array>
+#include <cstring>
 
 using namespace std;
 
@@ -245,22 +246,51 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+namespace
+{
+
+/// @returns the first position at or after @a _position in @a _text whose character
+/// does not satisfy @a _predicate or the size of @a _text if there is none.
+/// Used to skip runs of characters without going through CharStream::advanceAndGet for each of them.
+template <typename Predicate>
+size_t skipWhile(string const& _text, size_t _position, Predicate _predicate)
+{
+	char const* data = _text.data();
+	size_t const size = _text.size();
+	while (_position < size && _predicate(data[_position]))
+		++_position;
+	return _position;
+}
+
+/// @returns true if @a _c can be the first byte of a line terminator recognized by
+/// Scanner::isUnicodeLinebreak().
+bool mayStartUnicodeLinebreak(char _c)
+{
+	return (0x0a <= _c && _c <= 0x0d) || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+}
+
 bool Scanner::skipWhitespace()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// The current character is checked separately because it does not
+	// always match the source (see skipMultiLineComment()).
+	if (!isWhiteSpace(m_char))
+		return false;
+	advance();
+	m_char = m_source.setPosition(skipWhile(m_source.source(), sourcePos(), isWhiteSpace));
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 {
-	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// Apart from line terminators, the only whitespace characters are space and tab.
+	auto isSpaceOrTab = [](char _c) { return _c == ' ' || _c == '\t'; };
+	if (!isSpaceOrTab(m_char))
+		return false;
+	advance();
+	m_char = m_source.setPosition(skipWhile(m_source.source(), sourcePos(), isSpaceOrTab));
+	return true;
 }
 
 
@@ -283,6 +313,9 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	};
 
 	size_t endPosition = _stream.position();
+	// All of the sequences start with 0xE2, so there is nothing to check without it.
+	if (!memchr(_stream.source().data() + _startPosition, '\xE2', endPosition - _startPosition))
+		return ScannerError::NoError;
 	_stream.setPosition(_startPosition);
 
 	int directionOverrideDepth = 0;
@@ -312,8 +345,15 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
 	while (!isUnicodeLinebreak())
+	{
 		if (!advance())
 			break;
+		m_char = m_source.setPosition(skipWhile(
+			m_source.source(),
+			sourcePos(),
+			[](char _c) { return !mayStartUnicodeLinebreak(_c); }
+		));
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -383,6 +423,15 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		// Copy the rest of the line up to anything that might terminate it in one go.
+		size_t const runStart = sourcePos();
+		size_t const runEnd = skipWhile(
+			m_source.source(),
+			runStart,
+			[](char _c) { return !mayStartUnicodeLinebreak(_c); }
+		);
+		m_skippedComments[NextNext].literal.append(m_source.source(), runStart, runEnd - runStart);
+		m_char = m_source.setPosition(runEnd);
 	}
 	literal.complete();
 	return endPosition;
@@ -408,6 +457,15 @@ Token Scanner::skipMultiLineComment()
 			m_char = ' ';
 			return Token::Whitespace;
 		}
+		if (m_char != '*')
+		{
+			// Only a '*' can start the terminator, so jump to the next one.
+			string const& source = m_source.source();
+			void const* nextStar = memchr(source.data() + sourcePos(), '*', source.size() - sourcePos());
+			m_char = m_source.setPosition(
+				nextStar ? static_cast<size_t>(static_cast<char const*>(nextStar) - source.data()) : source.size()
+			);
+		}
 	}
 	// Unterminated multi-line comment.
 	return setError(ScannerError::IllegalCommentTerminator);
@@ -460,6 +518,15 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		// Copy everything up to the next line break or potential terminator in one go.
+		size_t const runStart = sourcePos();
+		size_t const runEnd = skipWhile(
+			m_source.source(),
+			runStart,
+			[](char _c) { return _c != '*' && _c != '\n' && _c != '\r'; }
+		);
+		m_skippedComments[NextNext].literal.append(m_source.source(), runStart, runEnd - runStart);
+		m_char = m_source.setPosition(runEnd);
 	}
 	literal.complete();
 	if (!endFound)
@@ -1012,8 +1079,14 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	bool const allowDot = m_kind == ScannerKind::Yul;
+	size_t const end = skipWhile(
+		m_source.source(),
+		sourcePos(),
+		[&](char _c) { return isIdentifierPart(_c) || (_c == '.' && allowDot); }
+	);
+	m_tokens[NextNext].literal.append(m_source.source(), sourcePos(), end - sourcePos());
+	m_char = m_source.setPosition(end);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
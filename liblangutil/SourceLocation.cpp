@@ -18,41 +18,75 @@
 
 #include <liblangutil/Exceptions.h>
 
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string.hpp>
-
+#include <array>
+#include <charconv>
 #include <iostream>
+#include <mutex>
+#include <unordered_set>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
-SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+namespace
 {
-	// Expected input: "start:length:sourceindex"
-	enum SrcElem: size_t { Start, Length, Index };
-
-	vector<string> pos;
-
-	boost::algorithm::split(pos, _input, boost::is_any_of(":"));
-
-	solAssert(pos.size() == 3, "SourceLocation string must have 3 colon separated numeric fields.");
-	auto const sourceIndex = stoi(pos[Index]);
 
+/// @returns the start, end and source index of a location "start:length:sourceindex".
+tuple<int, int, int> parseSourceLocationFields(string_view _input, size_t _sourceCount)
+{
+	array<int, 3> fields{};
+	char const* position = _input.data();
+	char const* end = _input.data() + _input.size();
+	for (size_t i = 0; i < fields.size(); ++i)
+	{
+		if (i > 0)
+		{
+			solAssert(position != end && *position == ':', "SourceLocation string must have 3 colon separated numeric fields.");
+			++position;
+		}
+		auto [next, error] = from_chars(position, end, fields[i]);
+		solAssert(error == errc{}, "SourceLocation string must have 3 colon separated numeric fields.");
+		position = next;
+	}
+	solAssert(position == end, "SourceLocation string must have 3 colon separated numeric fields.");
+
+	auto const [start, length, sourceIndex] = fields;
 	astAssert(
-		sourceIndex == -1 || (0 <= sourceIndex && static_cast<size_t>(sourceIndex) < _sourceNames.size()),
+		sourceIndex == -1 || (0 <= sourceIndex && static_cast<size_t>(sourceIndex) < _sourceCount),
 		"'src'-field ill-formatted or src-index too high"
 	);
+	return {start, start + length, sourceIndex};
+}
 
-	int start = stoi(pos[Start]);
-	int end = start + stoi(pos[Length]);
+}
 
+SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+{
+	auto const [start, end, sourceIndex] = parseSourceLocationFields(_input, _sourceNames.size());
+	SourceLocation result{start, end, {}};
+	if (sourceIndex != -1)
+		result.sourceName = internSourceName(*_sourceNames.at(static_cast<size_t>(sourceIndex)));
+	return result;
+}
+
+SourceLocation solidity::langutil::parseSourceLocation(string_view _input, vector<string const*> const& _sourceNames)
+{
+	auto const [start, end, sourceIndex] = parseSourceLocationFields(_input, _sourceNames.size());
 	SourceLocation result{start, end, {}};
 	if (sourceIndex != -1)
 		result.sourceName = _sourceNames.at(static_cast<size_t>(sourceIndex));
 	return result;
 }
 
+string const* solidity::langutil::internSourceName(string const& _name)
+{
+	static mutex namesMutex;
+	// Elements of an unordered_set do not move when it grows.
+	static unordered_set<string> names;
+	lock_guard lock(namesMutex);
+	return &*names.insert(_name).first;
+}
+
 std::ostream& solidity::langutil::operator<<(std::ostream& _out, SourceLocation const& _location)
 {
 	if (!_location.isValid())
@@ -26,6 +26,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -73,14 +74,8 @@ struct SourceLocation
 		return _other.start < end && start < _other.end;
 	}
 
-	bool equalSources(SourceLocation const& _other) const
-	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
-			return false;
-		return true;
-	}
+	/// Source names are interned, so they can be compared by pointer.
+	bool equalSources(SourceLocation const& _other) const { return sourceName == _other.sourceName; }
 
 	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
@@ -108,14 +103,24 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	/// The name of the source, which has to be obtained from internSourceName, or null.
+	/// Since interned names are never freed, locations can be copied without reference counting.
+	std::string const* sourceName = nullptr;
 };
 
+/// @returns a pointer to a string equal to @a _name that stays valid until the end of the program.
+/// The pointer is the same for all calls with equal names. Thread-safe.
+std::string const* internSourceName(std::string const& _name);
+
 SourceLocation parseSourceLocation(
 	std::string const& _input,
 	std::vector<std::shared_ptr<std::string const>> const& _sourceNames
 );
 
+/// Parses a source location of the form "start:length:sourceIndex".
+/// @param _sourceNames the names of the sources by index, obtained from internSourceName.
+SourceLocation parseSourceLocation(std::string_view _input, std::vector<std::string const*> const& _sourceNames);
+
 /// Stream output for Location (used e.g. in boost exceptions).
 std::ostream& operator<<(std::ostream& _out, SourceLocation const& _location);
 
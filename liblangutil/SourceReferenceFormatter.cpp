@@ -23,6 +23,7 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/UTF8.h>
 #include <iomanip>
 #include <string_view>
@@ -199,10 +200,24 @@ void SourceReferenceFormatter::printExceptionInformation(util::Exception const&
 	printExceptionInformation(SourceReferenceExtractor::extract(m_charStreamProvider, _exception, _severity));
 }
 
-void SourceReferenceFormatter::printErrorInformation(ErrorList const& _errors)
+void SourceReferenceFormatter::printErrorInformation(ErrorList const& _errors, size_t _parallelism)
 {
-	for (auto const& error: _errors)
-		printErrorInformation(*error);
+	if (_parallelism <= 1 || _errors.size() <= 1)
+	{
+		for (auto const& error: _errors)
+			printErrorInformation(*error);
+		return;
+	}
+
+	vector<string> formattedErrors(_errors.size());
+	parallelForEach(_errors.size(), _parallelism, [&](size_t _index) {
+		ostringstream output;
+		SourceReferenceFormatter formatter(output, m_charStreamProvider, m_colored, m_withErrorIds);
+		formatter.printErrorInformation(*_errors[_index]);
+		formattedErrors[_index] = output.str();
+	});
+	for (string const& formattedError: formattedErrors)
+		m_stream << formattedError;
 }
 
 void SourceReferenceFormatter::printErrorInformation(Error const& _error)
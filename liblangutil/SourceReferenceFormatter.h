@@ -53,7 +53,9 @@ public:
 	void printSourceLocation(SourceReference const& _ref);
 	void printExceptionInformation(SourceReferenceExtractor::Message const& _msg);
 	void printExceptionInformation(util::Exception const& _exception, std::string const& _severity);
-	void printErrorInformation(langutil::ErrorList const& _errors);
+	/// Prints all errors of @a _errors in order. With @a _parallelism > 1 the errors are
+	/// extracted and formatted on up to that many threads before being written to the stream.
+	void printErrorInformation(langutil::ErrorList const& _errors, size_t _parallelism = 1);
 	void printErrorInformation(Error const& _error);
 
 	static std::string formatExceptionInformation(
@@ -21,6 +21,10 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Exceptions.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <unordered_map>
+
 namespace solidity::langutil
 {
 
@@ -77,9 +81,9 @@ public:
 
 	bool seen(ErrorId _error, SourceLocation const& _location, std::string const& _description) const
 	{
-		if (m_seenErrors.count({_error, _location}))
+		if (auto it = m_seenErrors.find({_error, _location}); it != m_seenErrors.end())
 		{
-			solAssert(m_seenErrors.at({_error, _location}) == _description, "");
+			solAssert(it->second == _description, "");
 			return true;
 		}
 		return false;
@@ -96,9 +100,23 @@ public:
 	void clear() { m_errorReporter.clear(); }
 
 private:
+	struct ErrorKeyHash
+	{
+		size_t operator()(std::pair<ErrorId, SourceLocation> const& _key) const
+		{
+			// Source names are interned, so hashing their address is consistent with equality.
+			size_t seed = 0;
+			boost::hash_combine(seed, _key.first.error);
+			boost::hash_combine(seed, _key.second.start);
+			boost::hash_combine(seed, _key.second.end);
+			boost::hash_combine(seed, _key.second.sourceName);
+			return seed;
+		}
+	};
+
 	ErrorReporter m_errorReporter;
 	ErrorList m_uniqueErrors;
-	std::map<std::pair<ErrorId, SourceLocation>, std::string> m_seenErrors;
+	std::unordered_map<std::pair<ErrorId, SourceLocation>, std::string, ErrorKeyHash> m_seenErrors;
 };
 
 }
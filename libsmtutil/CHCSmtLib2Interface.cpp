@@ -62,12 +62,11 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 {
 	smtAssert(_expr.sort);
 	smtAssert(_expr.sort->kind == Kind::Function);
-	if (!m_variables.count(_expr.name))
+	if (m_variables.insert(_expr.name).second)
 	{
 		auto fSort = dynamic_pointer_cast<FunctionSort>(_expr.sort);
 		string domain = toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
-		m_variables.insert(_expr.name);
 		write(
 			"(declare-fun |" +
 			_expr.name +
@@ -126,18 +125,16 @@ void CHCSmtLib2Interface::declareVariable(string const& _name, SortPointer const
 	smtAssert(_sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, _sort);
-	else if (!m_variables.count(_name))
-	{
-		m_variables.insert(_name);
+	else if (m_variables.insert(_name).second)
 		write("(declare-var |" + _name + "| " + toSmtLibSort(*_sort) + ')');
-	}
 }
 
 string CHCSmtLib2Interface::toSmtLibSort(Sort const& _sort)
 {
-	if (!m_sortNames.count(&_sort))
-		m_sortNames[&_sort] = m_smtlib2->toSmtLibSort(_sort);
-	return m_sortNames.at(&_sort);
+	auto [name, inserted] = m_sortNames.try_emplace(&_sort);
+	if (inserted)
+		name->second = m_smtlib2->toSmtLibSort(_sort);
+	return name->second;
 }
 
 string CHCSmtLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
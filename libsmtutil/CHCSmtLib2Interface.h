@@ -26,6 +26,9 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace solidity::smtutil
 {
 
@@ -72,14 +75,14 @@ private:
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
 	std::string m_accumulatedOutput;
-	std::set<std::string> m_variables;
+	std::unordered_set<std::string> m_variables;
 
 	std::map<util::h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
 
-	std::map<Sort const*, std::string> m_sortNames;
+	std::unordered_map<Sort const*, std::string> m_sortNames;
 };
 
 }
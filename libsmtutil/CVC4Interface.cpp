@@ -121,11 +121,18 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	// Makes a running checkSat() return an unknown result.
+	m_solver.interrupt();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	auto variable = m_variables.find(_expr.name);
+	if (_expr.arguments.empty() && variable != m_variables.end())
+		return variable->second;
 
 	vector<CVC4::Expr> arguments;
 	for (auto const& arg: _expr.arguments)
@@ -135,8 +142,8 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 	{
 		string const& n = _expr.name;
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
-			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
+		if (!arguments.empty() && variable != m_variables.end())
+			return m_context.mkExpr(CVC4::kind::APPLY_UF, variable->second, arguments);
 		// Literal
 		else if (arguments.empty())
 		{
@@ -33,6 +33,8 @@
 #undef _GLIBCXX_PERMIT_BACKWARD_HASH
 #endif
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -54,6 +56,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
@@ -62,7 +65,7 @@ private:
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
-	std::map<std::string, CVC4::Expr> m_variables;
+	std::unordered_map<std::string, CVC4::Expr> m_variables;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
@@ -20,7 +20,6 @@
 
 #include <libsolutil/Keccak256.h>
 
-#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <range/v3/algorithm/find_if.hpp>
@@ -54,7 +53,7 @@ SMTLib2Interface::SMTLib2Interface(
 void SMTLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
-	m_accumulatedOutput.emplace_back();
+	m_frameStarts.clear();
 	m_variables.clear();
 	m_userSorts.clear();
 	write("(set-option :produce-models true)");
@@ -65,13 +64,16 @@ void SMTLib2Interface::reset()
 
 void SMTLib2Interface::push()
 {
-	m_accumulatedOutput.emplace_back();
+	m_frameStarts.push_back(m_accumulatedOutput.size());
+	// Frames are separated by an empty line.
+	m_accumulatedOutput += "\n";
 }
 
 void SMTLib2Interface::pop()
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.pop_back();
+	smtAssert(!m_frameStarts.empty(), "");
+	m_accumulatedOutput.resize(m_frameStarts.back());
+	m_frameStarts.pop_back();
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -116,10 +118,11 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	// The command is appended temporarily to avoid copying the accumulated output.
+	size_t outputSize = m_accumulatedOutput.size();
+	m_accumulatedOutput += checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	string response = querySolver(m_accumulatedOutput);
+	m_accumulatedOutput.resize(outputSize);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -263,8 +266,8 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 
 void SMTLib2Interface::write(string _data)
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	m_accumulatedOutput += move(_data);
+	m_accumulatedOutput += '\n';
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -64,7 +64,7 @@ public:
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
-	std::map<std::string, SortPointer> variables() { return m_variables; }
+	std::map<std::string, SortPointer> const& variables() const { return m_variables; }
 
 	std::vector<std::pair<std::string, std::string>> const& userSorts() const { return m_userSorts; }
 
@@ -79,7 +79,11 @@ private:
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
 
-	std::vector<std::string> m_accumulatedOutput;
+	/// The declarations and assertions of all frames, which are only appended to and truncated
+	/// on pop(), so that a query does not need to assemble the frames again.
+	std::string m_accumulatedOutput;
+	/// The positions in m_accumulatedOutput at which the frames opened by push() start.
+	std::vector<size_t> m_frameStarts;
 	std::map<std::string, SortPointer> m_variables;
 
 	/// Each pair in this vector represents an SMTChecker created
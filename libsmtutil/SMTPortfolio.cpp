@@ -26,6 +26,12 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,9 +42,11 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers)
 {
 	if (_enabledSolvers.smtlib2)
 		m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
@@ -83,8 +91,95 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
 		s->addAssertion(_expr);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (m_raceSolvers && m_solvers.size() > 1)
+		return race(_expressionsToEvaluate);
+	return validate(_expressionsToEvaluate);
+}
+
+void SMTPortfolio::interrupt()
+{
+	for (auto const& s: m_solvers)
+		s->interrupt();
+}
+
 /*
- * Broadcasts the SMT query to all solvers and returns a single result.
+ * Runs every solver on its own thread and returns the first answer (SAT or UNSAT).
+ * As soon as a solver answers, the solvers that are still running are interrupted.
+ * Solvers that cannot be interrupted (like the SMT-LIB2 interface, which might have to
+ * hand the query to a callback) are waited for, so that all solvers see every query
+ * and are idle again once this function returns.
+ * The first solver is run on the calling thread, which keeps the SMT-LIB2 callback there.
+ *
+ * Conflicting answers are not detected, since the other solvers are stopped before they answer.
+ * If no solver answers, the result is UNKNOWN if at least one solver returned UNKNOWN
+ * and ERROR otherwise, as in validate().
+ * If solvers throw, the exception of the first of them is rethrown.
+*/
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	vector<exception_ptr> exceptions(m_solvers.size());
+	vector<bool> finished(m_solvers.size(), false);
+	optional<size_t> winner;
+	mutex resultMutex;
+
+	auto run = [&](size_t _index) {
+		pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+		try
+		{
+			result = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			exceptions[_index] = current_exception();
+		}
+
+		lock_guard lock(resultMutex);
+		finished[_index] = true;
+		if (!winner && !exceptions[_index] && solverAnswered(result.first))
+		{
+			winner = _index;
+			// A solver that has not started its check yet misses the interruption and runs to
+			// completion, which only costs time.
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (!finished[i])
+					m_solvers[i]->interrupt();
+		}
+		results[_index] = move(result);
+	};
+
+	vector<thread> threads;
+	threads.reserve(m_solvers.size() - 1);
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		try
+		{
+			threads.emplace_back(run, i);
+		}
+		catch (system_error const&)
+		{
+			// No threads are available (for example in builds without thread support).
+			run(i);
+		}
+	run(0);
+	for (thread& t: threads)
+		t.join();
+
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+
+	if (winner)
+		return move(results[*winner]);
+	bool unknown = any_of(results.begin(), results.end(), [](auto const& _result) {
+		return _result.first == CheckResult::UNKNOWN;
+	});
+	return make_pair(unknown ? CheckResult::UNKNOWN : CheckResult::ERROR, vector<string>{});
+}
+
+/*
+ * Broadcasts the SMT query to all solvers one after the other and returns a single result.
  * This comment explains how this result is decided.
  *
  * When a solver is queried, there are four possible answers:
@@ -113,7 +208,7 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *
  *   If all solvers return ERROR, the result is ERROR.
 */
-pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+pair<CheckResult, vector<string>> SMTPortfolio::validate(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
@@ -34,6 +34,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * If racing is requested, every solver runs on its own thread instead, the first
+ * SAT or UNSAT answer is used and the remaining solvers are interrupted.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +48,8 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false
 	);
 
 	void reset() override;
@@ -59,13 +62,18 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 private:
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+	std::pair<CheckResult, std::vector<std::string>> validate(std::vector<Expression> const& _expressionsToEvaluate);
+
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_raceSolvers = false;
 
 	std::vector<Expression> m_assertions;
 };
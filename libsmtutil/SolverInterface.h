@@ -485,8 +485,47 @@ public:
 		return Expression(name, std::move(_arguments), fSort->codomain);
 	}
 
+	/// Immutable list of the arguments of an expression. The list is shared between all copies
+	/// of the expression, so copying an expression is cheap regardless of its size, and a
+	/// subexpression that occurs in multiple expressions is only stored once.
+	/// Solvers use the identity of the list to translate shared subexpressions only once.
+	class Arguments
+	{
+	public:
+		Arguments() = default;
+		Arguments(std::vector<Expression> _arguments):
+			m_arguments(
+				_arguments.empty() ?
+				nullptr :
+				std::make_shared<std::vector<Expression> const>(std::move(_arguments))
+			)
+		{}
+
+		std::vector<Expression> const& get() const
+		{
+			static std::vector<Expression> const empty;
+			return m_arguments ? *m_arguments : empty;
+		}
+		operator std::vector<Expression> const&() const { return get(); }
+
+		size_t size() const { return get().size(); }
+		bool empty() const { return !m_arguments; }
+		Expression const& at(size_t _index) const { return get().at(_index); }
+		Expression const& operator[](size_t _index) const { return get()[_index]; }
+		Expression const& front() const { return get().front(); }
+		Expression const& back() const { return get().back(); }
+		std::vector<Expression>::const_iterator begin() const { return get().begin(); }
+		std::vector<Expression>::const_iterator end() const { return get().end(); }
+
+		/// @returns the shared list, which is null if there are no arguments.
+		std::shared_ptr<std::vector<Expression> const> const& shared() const { return m_arguments; }
+
+	private:
+		std::shared_ptr<std::vector<Expression> const> m_arguments;
+	};
+
 	std::string name;
-	std::vector<Expression> arguments;
+	Arguments arguments;
 	SortPointer sort;
 
 private:
@@ -531,6 +570,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running on another thread to return as soon as possible,
+	/// in which case it reports UNKNOWN or ERROR. Does nothing for solvers that cannot be interrupted.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
@@ -0,0 +1,238 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SolverProcessPool.h>
+
+#include <libsmtutil/Exceptions.h>
+
+#ifndef __EMSCRIPTEN__
+#include <boost/process.hpp>
+#endif
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <csignal>
+#include <pthread.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// The response of the solver to the echo command that ends every query. It is prefixed with
+/// a character that cannot start a response to an SMT-LIB2 command.
+string const endOfResponse = "#end-of-response";
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+/// Blocks SIGPIPE in the current thread for its lifetime, so that writing to a process that has
+/// exited fails instead of terminating the compiler, without changing the signal disposition of
+/// the whole program. A SIGPIPE raised in the meantime is consumed before the signal is unblocked.
+class SigpipeBlock
+{
+public:
+	SigpipeBlock()
+	{
+		sigemptyset(&m_sigpipe);
+		sigaddset(&m_sigpipe, SIGPIPE);
+		sigset_t pending;
+		sigemptyset(&pending);
+		sigpending(&pending);
+		m_wasPending = sigismember(&pending, SIGPIPE) == 1;
+		pthread_sigmask(SIG_BLOCK, &m_sigpipe, &m_previousMask);
+	}
+	~SigpipeBlock()
+	{
+		if (!m_wasPending)
+		{
+			sigset_t pending;
+			sigemptyset(&pending);
+			sigpending(&pending);
+			int received = 0;
+			if (sigismember(&pending, SIGPIPE) == 1)
+				sigwait(&m_sigpipe, &received);
+		}
+		pthread_sigmask(SIG_SETMASK, &m_previousMask, nullptr);
+	}
+
+	SigpipeBlock(SigpipeBlock const&) = delete;
+	SigpipeBlock& operator=(SigpipeBlock const&) = delete;
+
+private:
+	sigset_t m_sigpipe;
+	sigset_t m_previousMask;
+	/// Whether a SIGPIPE was already pending, in which case it is not ours to consume.
+	bool m_wasPending = false;
+};
+#else
+/// Writing to a process that has exited does not raise a signal on this platform.
+struct SigpipeBlock
+{
+};
+#endif
+
+}
+
+#ifndef __EMSCRIPTEN__
+struct SolverProcessPool::Process
+{
+	boost::process::opstream input;
+	boost::process::ipstream output;
+	boost::process::child child;
+};
+#else
+/// Processes cannot be started in the browser, so the pool is never created by z3()
+/// and start() always fails.
+struct SolverProcessPool::Process
+{
+};
+#endif
+
+SolverProcessPool::SolverProcessPool(boost::filesystem::path _executable, vector<string> _arguments, size_t _processes):
+	m_executable(move(_executable)),
+	m_arguments(move(_arguments)),
+	m_idle(_processes)
+{
+	smtAssert(_processes > 0);
+}
+
+SolverProcessPool::~SolverProcessPool()
+{
+#ifndef __EMSCRIPTEN__
+	SigpipeBlock sigpipeBlock;
+	// The processes exit at the end of their input.
+	for (auto& process: m_idle)
+		if (process)
+		{
+			process->input.pipe().close();
+			error_code error;
+			process->child.wait(error);
+		}
+#endif
+}
+
+string SolverProcessPool::query(string const& _query)
+{
+	unique_ptr<Process> process;
+	{
+		unique_lock lock(m_mutex);
+		m_released.wait(lock, [&]() { return !m_idle.empty(); });
+		process = move(m_idle.back());
+		m_idle.pop_back();
+	}
+
+	optional<string> response;
+#ifndef __EMSCRIPTEN__
+	bool running = (process && process->child.running()) || start(process);
+	if (running)
+	{
+		SigpipeBlock sigpipeBlock;
+		process->input << _query << "\n(echo \"" << endOfResponse << "\")\n(reset)\n" << flush;
+		string answer;
+		string line;
+		while (getline(process->output, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			// Some solvers print the quotes of the echoed string.
+			if (line == endOfResponse || line == "\"" + endOfResponse + "\"")
+			{
+				response = move(answer);
+				break;
+			}
+			answer += line + "\n";
+		}
+		if (!response)
+		{
+			// Closing the pipe discards what is left in the input buffer, which cannot be written.
+			process->input.pipe().close();
+			error_code error;
+			process->child.terminate(error);
+			process.reset();
+		}
+	}
+#else
+	bool running = start(process);
+#endif
+
+	{
+		lock_guard lock(m_mutex);
+		m_idle.push_back(move(process));
+	}
+	m_released.notify_one();
+
+	if (!running)
+		return "(error \"The solver process " + m_executable.string() + " could not be started.\")\n";
+	if (!response)
+		return "(error \"The solver process " + m_executable.string() + " exited before answering the query.\")\n";
+	return *response;
+}
+
+ReadCallback::Callback SolverProcessPool::callback()
+{
+	return [this](string const& _kind, string const& _query) -> ReadCallback::Result {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+			return {false, "Solver processes can only answer SMT queries."};
+		return {true, query(_query)};
+	};
+}
+
+unique_ptr<SolverProcessPool> SolverProcessPool::z3(size_t _processes, optional<unsigned> _memoryLimit)
+{
+#ifdef __EMSCRIPTEN__
+	(void)_processes;
+	(void)_memoryLimit;
+	return nullptr;
+#else
+	boost::filesystem::path executable = boost::process::search_path("z3");
+	if (executable.empty())
+		return nullptr;
+	vector<string> arguments{"-in", "-smt2"};
+	if (_memoryLimit)
+		arguments.push_back("-memory:" + to_string(*_memoryLimit));
+	return make_unique<SolverProcessPool>(move(executable), move(arguments), _processes);
+#endif
+}
+
+bool SolverProcessPool::start(unique_ptr<Process>& _process) const
+{
+#ifdef __EMSCRIPTEN__
+	_process.reset();
+	return false;
+#else
+	_process = make_unique<Process>();
+	try
+	{
+		_process->child = boost::process::child(
+			m_executable,
+			boost::process::args(m_arguments),
+			boost::process::std_in < _process->input,
+			boost::process::std_out > _process->output,
+			boost::process::std_err > boost::process::null
+		);
+	}
+	catch (boost::process::process_error const&)
+	{
+		_process.reset();
+		return false;
+	}
+	return true;
+#endif
+}
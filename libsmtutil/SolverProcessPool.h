@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * A pool of long-lived solver processes that read SMT-LIB2 scripts from their standard input
+ * and answer them on their standard output.
+ *
+ * A query is sent to an idle process, followed by a command that echoes a marker, which ends
+ * the response, and by (reset), so that the next script starts afresh. If all processes are busy,
+ * the query waits for one of them. The processes are started on first use. If a process exits
+ * before answering, e.g. because it ran out of memory, the query is answered with an error and
+ * the process is started again for the next query, so that a solver failure does not affect
+ * the compiler. The pool can be used from several threads.
+ */
+class SolverProcessPool
+{
+public:
+	SolverProcessPool(boost::filesystem::path _executable, std::vector<std::string> _arguments, size_t _processes);
+	~SolverProcessPool();
+
+	SolverProcessPool(SolverProcessPool const&) = delete;
+	SolverProcessPool& operator=(SolverProcessPool const&) = delete;
+
+	/// @returns the response of a solver process to the SMT-LIB2 script @a _query,
+	/// or an SMT-LIB2 error response if the process failed.
+	std::string query(std::string const& _query);
+
+	/// @returns a callback that answers SMT queries by query() and which
+	/// must not be used after the pool is destroyed.
+	frontend::ReadCallback::Callback callback();
+
+	/// @returns a pool of @a _processes instances of the z3 executable found in the search path,
+	/// each with the memory limit @a _memoryLimit in MiB, or nullptr if there is no z3 executable.
+	static std::unique_ptr<SolverProcessPool> z3(size_t _processes, std::optional<unsigned> _memoryLimit);
+
+private:
+	struct Process;
+
+	/// Starts the solver in @a _process. @returns false if it could not be started.
+	bool start(std::unique_ptr<Process>& _process) const;
+
+	boost::filesystem::path m_executable;
+	std::vector<std::string> m_arguments;
+
+	std::mutex m_mutex;
+	std::condition_variable m_released;
+	/// The processes that are not answering a query, or null if they are not running.
+	std::vector<std::unique_ptr<Process>> m_idle;
+};
+
+}
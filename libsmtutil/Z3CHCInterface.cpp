@@ -59,7 +59,8 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	z3::func_decl relation = m_z3Interface->functions().at(_expr.name);
+	m_solver.register_relation(relation);
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
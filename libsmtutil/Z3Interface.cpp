@@ -55,6 +55,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
 	m_solver.reset();
 }
 
@@ -73,8 +74,11 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	smtAssert(_sort, "");
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
-	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+	else if (auto constant = m_constants.find(_name); constant != m_constants.end())
+	{
+		constant->second = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		m_translations.clear();
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -83,8 +87,11 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 {
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
-	if (m_functions.count(_name))
-		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	if (auto function = m_functions.find(_name); function != m_functions.end())
+	{
+		function->second = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		m_translations.clear();
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -139,10 +146,32 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// Makes a running check() throw a z3::exception with the message "canceled".
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	// Subexpressions are shared between the expressions built by the encoding, e.g. the
+	// state of a variable that occurs in multiple assertions, so they are only translated once.
+	TranslationKey key{_expr.arguments.shared().get(), _expr.name, _expr.sort.get()};
+	if (auto it = m_translations.find(key); it != m_translations.end())
+		return it->second.second;
+	z3::expr result = translate(_expr);
+	m_translations.emplace(move(key), make_pair(_expr, result));
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		if (auto constant = m_constants.find(_expr.name); constant != m_constants.end())
+			return constant->second;
 	z3::expr_vector arguments(m_context);
 	for (auto const& arg: _expr.arguments)
 		arguments.push_back(toZ3Expr(arg));
@@ -150,8 +179,8 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 	try
 	{
 		string const& n = _expr.name;
-		if (m_functions.count(n))
-			return m_functions.at(n)(arguments);
+		if (auto function = m_functions.find(n); function != m_functions.end())
+			return function->second(arguments);
 		else if (m_constants.count(n))
 		{
 			smtAssert(arguments.empty(), "");
@@ -21,6 +21,13 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace solidity::smtutil
 {
 
@@ -44,12 +51,13 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
-	std::map<std::string, z3::expr> constants() const { return m_constants; }
-	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	std::map<std::string, z3::expr> const& constants() const { return m_constants; }
+	std::unordered_map<std::string, z3::func_decl> const& functions() const { return m_functions; }
 
 	z3::context* context() { return &m_context; }
 
@@ -58,6 +66,12 @@ public:
 	static int const resourceLimit = 1000000;
 
 private:
+	/// Identifies an expression with arguments by its (shared) argument list, name and sort.
+	using TranslationKey = std::tuple<std::vector<Expression> const*, std::string, Sort const*>;
+
+	/// Translates @a _expr without looking it up in m_translations.
+	z3::expr translate(Expression const& _expr);
+
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
 	z3::sort z3Sort(Sort const& _sort);
@@ -68,8 +82,13 @@ private:
 	z3::context m_context;
 	z3::solver m_solver;
 
+	/// The constants are kept sorted, since they are bound in this order in the rules of the CHC solver.
 	std::map<std::string, z3::expr> m_constants;
-	std::map<std::string, z3::func_decl> m_functions;
+	std::unordered_map<std::string, z3::func_decl> m_functions;
+	/// Translations of the expressions with arguments, together with the expressions themselves,
+	/// which keep the argument lists and sorts that make up the keys alive.
+	/// Cleared whenever a declaration changes.
+	std::map<TranslationKey, std::pair<Expression, z3::expr>> m_translations;
 };
 
 }
@@ -28,6 +28,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -39,12 +40,20 @@ using namespace solidity::util;
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
 
+struct solidity_context
+{
+	/// The results of the compilations in the context, which must not be resized either.
+	list<string> results;
+};
+
 namespace
 {
 
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+/// Guards solidityAllocations, which is shared by the compilations in all contexts.
+static mutex solidityAllocationsMutex;
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -53,6 +62,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -129,13 +139,16 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	string output = compile(_input, _readCallback, _readContext);
+	lock_guard lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(move(output)).data();
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
+		lock_guard lock(solidityAllocationsMutex);
 		return solidityAllocations.emplace_back(_size, '\0').data();
 	}
 	catch (...)
@@ -155,6 +168,29 @@ extern void solidity_reset() noexcept
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
 	yul::YulStringRepository::reset();
+	lock_guard lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern solidity_context* solidity_context_create() noexcept
+{
+	return new (nothrow) solidity_context{};
+}
+
+extern char* solidity_compile_ctx(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	// Every compilation uses a type provider and a Yul string repository of its own (see
+	// StandardCompiler::compile), so only the allocations of the callbacks are shared.
+	return _context->results.emplace_back(compile(_input, _readCallback, _readContext)).data();
+}
+
+extern void solidity_context_free(solidity_context* _context) noexcept
+{
+	delete _context;
+}
 }
@@ -93,9 +93,37 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
-/// is invalid after calling this!
+/// is invalid after calling this! It must not be called while a compilation is running in a context
+/// (see solidity_compile_ctx()), since the contents allocated by its callback would be freed.
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// A compiler context, which owns the results of the compilations in it.
+///
+/// Compilations in different contexts can run concurrently on different threads.
+/// A single context must not be used by several threads at the same time.
+typedef struct solidity_context solidity_context;
+
+/// Creates a new compiler context.
+///
+/// @returns A pointer to the context, which must be freed by the caller using solidity_context_free(),
+///          or NULL if the context could not be allocated.
+solidity_context* solidity_context_create() SOLC_NOEXCEPT;
+
+/// Like solidity_compile(), but the result is owned by @p _context and the call can run
+/// concurrently with compilations in other contexts. The contents passed to the compiler by
+/// @p _readCallback must still be allocated using solidity_alloc().
+///
+/// @returns A pointer to the result, which is valid until @p _context is freed. It must NOT be freed by the caller.
+char* solidity_compile_ctx(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Frees @p _context and all results of the compilations in it.
+void solidity_context_free(solidity_context* _context) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
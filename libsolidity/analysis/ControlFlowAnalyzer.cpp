@@ -20,6 +20,7 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/algorithm/sort.hpp>
 
@@ -30,20 +31,83 @@ using namespace std::placeholders;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+ErrorId const unreachableCodeWarning = 5740_error;
+
+/// Set of the integers below a fixed bound, stored as a bit vector.
+class DenseSet
+{
+public:
+	explicit DenseSet(size_t _bound): m_words((_bound + 63) / 64, 0) {}
+
+	bool contains(size_t _element) const { return (m_words[_element / 64] >> (_element % 64)) & 1; }
+	void insert(size_t _element) { m_words[_element / 64] |= uint64_t(1) << (_element % 64); }
+	void erase(size_t _element) { m_words[_element / 64] &= ~(uint64_t(1) << (_element % 64)); }
+
+	/// Adds all elements of @a _other, which has to have the same bound.
+	/// @returns true if this added at least one element.
+	bool insertAll(DenseSet const& _other)
+	{
+		uint64_t added = 0;
+		for (size_t i = 0; i < m_words.size(); ++i)
+		{
+			added |= _other.m_words[i] & ~m_words[i];
+			m_words[i] |= _other.m_words[i];
+		}
+		return added != 0;
+	}
+
+	/// Calls @a _callback for all elements in increasing order.
+	template <typename Callback>
+	void forEach(Callback&& _callback) const
+	{
+		for (size_t i = 0; i < m_words.size(); ++i)
+			if (m_words[i])
+				for (size_t bit = 0; bit < 64; ++bit)
+					if ((m_words[i] >> bit) & 1)
+						_callback(i * 64 + bit);
+	}
+
+private:
+	std::vector<uint64_t> m_words;
+};
+
+}
 
 bool ControlFlowAnalyzer::run()
 {
+	vector<pair<CFG::FunctionContractTuple const*, FunctionFlow const*>> flows;
 	for (auto& [pair, flow]: m_cfg.allFunctionFlows())
-		analyze(*pair.function, pair.contract, *flow);
+		flows.emplace_back(&pair, flow.get());
+
+	// Reachability is only needed for the warning, which can be suppressed.
+	bool const findUnreachable = m_errorReporter.isReported(unreachableCodeWarning, Error::Type::Warning);
+	vector<Findings> findings(flows.size());
+	util::parallelForEach(flows.size(), m_parallelism, [&](size_t _index) {
+		if (flows[_index].first->function->isImplemented())
+			findings[_index] = analyze(*flows[_index].second, findUnreachable);
+	});
+
+	for (size_t i = 0; i < flows.size(); ++i)
+		if (flows[i].first->function->isImplemented())
+			report(*flows[i].first->function, flows[i].first->contract, findings[i]);
 
 	return !Error::containsErrors(m_errorReporter.errors());
 }
 
-void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractDefinition const* _contract, FunctionFlow const& _flow)
+ControlFlowAnalyzer::Findings ControlFlowAnalyzer::analyze(FunctionFlow const& _flow, bool _findUnreachable)
 {
-	if (!_function.isImplemented())
-		return;
+	Findings findings;
+	findings.uninitializedAccesses = checkUninitializedAccess(_flow.entry, _flow.exit);
+	if (_findUnreachable)
+		findings.unreachableLocations = checkUnreachable(_flow.entry, _flow.exit, _flow.revert, _flow.transactionReturn);
+	return findings;
+}
 
+void ControlFlowAnalyzer::report(FunctionDefinition const& _function, ContractDefinition const* _contract, Findings const& _findings)
+{
 	optional<string> mostDerivedContractName;
 
 	// The name of the most derived contract only required if it differs from
@@ -51,59 +115,97 @@ void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractD
 	if (_contract && _contract != _function.annotation().contract)
 		mostDerivedContractName = _contract->name();
 
-	checkUninitializedAccess(
-		_flow.entry,
-		_flow.exit,
+	reportUninitializedAccess(
+		_findings.uninitializedAccesses,
 		_function.body().statements().empty(),
 		mostDerivedContractName
 	);
-	checkUnreachable(_flow.entry, _flow.exit, _flow.revert, _flow.transactionReturn);
+
+	for (SourceLocation const& location: _findings.unreachableLocations)
+		if (m_unreachableLocationsAlreadyWarnedFor.emplace(location).second)
+			m_errorReporter.warning(unreachableCodeWarning, location, "Unreachable code.");
 }
 
 
-void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
+vector<VariableOccurrence const*> ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit)
 {
-	struct NodeInfo
+	// Number the nodes reachable from the entry, the variables occurring in them and the
+	// occurrences that read a variable, so that the sets propagated through the graph
+	// can be stored as bit vectors.
+	vector<CFGNode const*> nodes;
+	map<CFGNode const*, size_t> nodeIndices;
+	util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
+		[&](CFGNode const* _node, auto&& _addChild) {
+			nodeIndices[_node] = nodes.size();
+			nodes.push_back(_node);
+			for (CFGNode const* exit: _node->exits)
+				_addChild(exit);
+		}
+	);
+	if (!nodeIndices.count(_exit))
+		return {};
+
+	/// Effect of a variable occurrence on the dataflow, in terms of the dense indices.
+	struct Operation
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
-		/// Propagate the information from another node to this node.
-		/// To be used to propagate information from a node to its exit nodes.
-		/// Returns true, if new variables were added and thus the current node has
-		/// to be traversed again.
-		bool propagateFrom(NodeInfo const& _entryNode)
+		VariableOccurrence::Kind kind;
+		size_t variable;
+		/// Index of the occurrence among the reading occurrences, if it reads the variable.
+		size_t access;
+	};
+	map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	vector<vector<Operation>> operations(nodes.size());
+	vector<vector<size_t>> exits(nodes.size());
+	for (size_t node = 0; node < nodes.size(); ++node)
+	{
+		for (auto const& variableOccurrence: nodes[node]->variableOccurrences)
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			size_t variable = variableIndices.emplace(&variableOccurrence.declaration(), variableIndices.size()).first->second;
+			size_t access = accesses.size();
+			if (
+				variableOccurrence.kind() != VariableOccurrence::Kind::Assignment &&
+				variableOccurrence.kind() != VariableOccurrence::Kind::Declaration
+			)
+				accesses.push_back(&variableOccurrence);
+			operations[node].push_back({variableOccurrence.kind(), variable, access});
 		}
+		for (CFGNode const* exit: nodes[node]->exits)
+			exits[node].push_back(nodeIndices.at(exit));
+	}
+
+	struct NodeInfo
+	{
+		DenseSet unassignedVariablesAtEntry;
+		DenseSet uninitializedVariableAccesses;
+		/// Whether the node was traversed or is queued for traversal.
+		bool visited = false;
+		bool queued = false;
 	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
+	vector<NodeInfo> nodeInfos(nodes.size(), NodeInfo{
+		DenseSet(variableIndices.size()),
+		DenseSet(accesses.size())
+	});
+	vector<size_t> nodesToTraverse{nodeIndices.at(_entry)};
+	nodeInfos[nodesToTraverse.front()].visited = nodeInfos[nodesToTraverse.front()].queued = true;
 
-	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
-	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
-	// variables and accesses.
+	// Walk all paths starting from the nodes in ``nodesToTraverse`` until propagating the
+	// information of a node does not add anything to the information of its exits, i.e. until
+	// all paths have been walked with maximal sets of unassigned variables and accesses.
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
-		nodesToTraverse.erase(nodesToTraverse.begin());
+		size_t currentNode = nodesToTraverse.back();
+		nodesToTraverse.pop_back();
 
 		auto& nodeInfo = nodeInfos[currentNode];
-		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		nodeInfo.queued = false;
+		DenseSet unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
+		for (Operation const& operation: operations[currentNode])
 		{
-			switch (variableOccurrence.kind())
+			switch (operation.kind)
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.erase(operation.variable);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -111,90 +213,106 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					if (unassignedVariables.contains(operation.variable))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						nodeInfo.uninitializedVariableAccesses.insert(operation.access);
 					}
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.insert(operation.variable);
 					break;
 			}
 		}
-		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
-	}
-
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
-	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
-		ranges::sort(
-			uninitializedAccessesOrdered,
-			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
+		for (size_t exit: exits[currentNode])
+		{
+			NodeInfo& exitInfo = nodeInfos[exit];
+			bool changed = exitInfo.unassignedVariablesAtEntry.insertAll(unassignedVariables);
+			changed = exitInfo.uninitializedVariableAccesses.insertAll(nodeInfo.uninitializedVariableAccesses) || changed;
+			if ((changed || !exitInfo.visited) && !exitInfo.queued)
 			{
-				return *lhs < *rhs;
+				exitInfo.queued = exitInfo.visited = true;
+				nodesToTraverse.push_back(exit);
 			}
-		);
+		}
+	}
 
-		for (auto const* variableOccurrence: uninitializedAccessesOrdered)
+	// Order the accesses by address first, so that accesses comparing equal keep the order
+	// they would have from a set of pointers.
+	vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+	nodeInfos[nodeIndices.at(_exit)].uninitializedVariableAccesses.forEach([&](size_t _access) {
+		uninitializedAccessesOrdered.push_back(accesses[_access]);
+	});
+	sort(uninitializedAccessesOrdered.begin(), uninitializedAccessesOrdered.end());
+	ranges::sort(
+		uninitializedAccessesOrdered,
+		[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
 		{
-			VariableDeclaration const& varDecl = variableOccurrence->declaration();
-
-			SecondarySourceLocation ssl;
-			if (variableOccurrence->occurrence())
-				ssl.append("The variable was declared here.", varDecl.location());
-
-			bool isStorage = varDecl.type()->dataStoredIn(DataLocation::Storage);
-			bool isCalldata = varDecl.type()->dataStoredIn(DataLocation::CallData);
-			if (isStorage || isCalldata)
-				m_errorReporter.typeError(
-					3464_error,
-					variableOccurrence->occurrence() ?
-						*variableOccurrence->occurrence() :
-						varDecl.location(),
-					ssl,
-					"This variable is of " +
-					string(isStorage ? "storage" : "calldata") +
-					" pointer type and can be " +
-					(variableOccurrence->kind() == VariableOccurrence::Kind::Return ? "returned" : "accessed") +
-					" without prior assignment, which would lead to undefined behaviour."
-				);
-			else if (!_emptyBody && varDecl.name().empty())
-			{
-				if (!m_unassignedReturnVarsAlreadyWarnedFor.emplace(&varDecl).second)
-					continue;
+			return *lhs < *rhs;
+		}
+	);
+	return uninitializedAccessesOrdered;
+}
+
+void ControlFlowAnalyzer::reportUninitializedAccess(
+	vector<VariableOccurrence const*> const& _accesses,
+	bool _emptyBody,
+	optional<string> _contractName
+)
+{
+	for (auto const* variableOccurrence: _accesses)
+	{
+		VariableDeclaration const& varDecl = variableOccurrence->declaration();
+
+		SecondarySourceLocation ssl;
+		if (variableOccurrence->occurrence())
+			ssl.append("The variable was declared here.", varDecl.location());
 
-				m_errorReporter.warning(
-					6321_error,
+		bool isStorage = varDecl.type()->dataStoredIn(DataLocation::Storage);
+		bool isCalldata = varDecl.type()->dataStoredIn(DataLocation::CallData);
+		if (isStorage || isCalldata)
+			m_errorReporter.typeError(
+				3464_error,
+				variableOccurrence->occurrence() ?
+					*variableOccurrence->occurrence() :
 					varDecl.location(),
-					"Unnamed return variable can remain unassigned" +
-					(
-						_contractName.has_value() ?
-						" when the function is called when \"" + _contractName.value() + "\" is the most derived contract." :
-						"."
-					) +
-					" Add an explicit return with value to all non-reverting code paths or name the variable."
-				);
-			}
+				ssl,
+				"This variable is of " +
+				string(isStorage ? "storage" : "calldata") +
+				" pointer type and can be " +
+				(variableOccurrence->kind() == VariableOccurrence::Kind::Return ? "returned" : "accessed") +
+				" without prior assignment, which would lead to undefined behaviour."
+			);
+		else if (!_emptyBody && varDecl.name().empty())
+		{
+			if (!m_unassignedReturnVarsAlreadyWarnedFor.emplace(&varDecl).second)
+				continue;
+
+			m_errorReporter.warning(
+				6321_error,
+				varDecl.location(),
+				"Unnamed return variable can remain unassigned" +
+				(
+					_contractName.has_value() ?
+					" when the function is called when \"" + _contractName.value() + "\" is the most derived contract." :
+					"."
+				) +
+				" Add an explicit return with value to all non-reverting code paths or name the variable."
+			);
 		}
 	}
 }
 
-void ControlFlowAnalyzer::checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn)
+vector<SourceLocation> ControlFlowAnalyzer::checkUnreachable(
+	CFGNode const* _entry,
+	CFGNode const* _exit,
+	CFGNode const* _revert,
+	CFGNode const* _transactionReturn
+)
 {
 	// collect all nodes reachable from the entry point
 	std::set<CFGNode const*> reachable = util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
@@ -216,14 +334,14 @@ void ControlFlowAnalyzer::checkUnreachable(CFGNode const* _entry, CFGNode const*
 		}
 	);
 
+	vector<SourceLocation> unreachableLocations;
 	for (auto it = unreachable.begin(); it != unreachable.end();)
 	{
 		SourceLocation location = *it++;
 		// Extend the location, as long as the next location overlaps (unreachable is sorted).
 		for (; it != unreachable.end() && it->start <= location.end; ++it)
 			location.end = std::max(location.end, it->end);
-
-		if (m_unreachableLocationsAlreadyWarnedFor.emplace(location).second)
-			m_errorReporter.warning(5740_error, location, "Unreachable code.");
+		unreachableLocations.emplace_back(std::move(location));
 	}
+	return unreachableLocations;
 }
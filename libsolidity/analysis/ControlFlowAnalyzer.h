@@ -20,7 +20,10 @@
 
 #include <libsolidity/analysis/ControlFlowGraph.h>
 #include <liblangutil/ErrorReporter.h>
+#include <optional>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -28,26 +31,52 @@ namespace solidity::frontend
 class ControlFlowAnalyzer
 {
 public:
-	explicit ControlFlowAnalyzer(CFG const& _cfg, langutil::ErrorReporter& _errorReporter):
-		m_cfg(_cfg), m_errorReporter(_errorReporter) {}
+	/// @param _parallelism maximum number of threads used to analyze the function flows.
+	explicit ControlFlowAnalyzer(CFG const& _cfg, langutil::ErrorReporter& _errorReporter, size_t _parallelism = 1):
+		m_cfg(_cfg), m_errorReporter(_errorReporter), m_parallelism(_parallelism) {}
 
 	bool run();
 
 private:
-	void analyze(FunctionDefinition const& _function, ContractDefinition const* _contract, FunctionFlow const& _flow);
-	/// Checks for uninitialized variable accesses in the control flow between @param _entry and @param _exit.
+	/// Results of the analysis of a single function flow. The analysis only reads the
+	/// control flow graph, so that flows can be analyzed concurrently. The results are
+	/// reported afterwards in a fixed order.
+	struct Findings
+	{
+		/// Accesses to variables that can remain unassigned, in source order.
+		std::vector<VariableOccurrence const*> uninitializedAccesses;
+		/// Disjoint locations of unreachable code, in source order.
+		std::vector<langutil::SourceLocation> unreachableLocations;
+	};
+
+	/// Unreachable code is only searched for if @a _findUnreachable is true.
+	static Findings analyze(FunctionFlow const& _flow, bool _findUnreachable);
+	void report(FunctionDefinition const& _function, ContractDefinition const* _contract, Findings const& _findings);
+	/// Finds uninitialized variable accesses in the control flow between @param _entry and @param _exit.
 	/// @param _entry entry node
 	/// @param _exit exit node
+	static std::vector<VariableOccurrence const*> checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit);
+	/// Finds unreachable code, i.e. code ending in @param _exit, @param _revert or @param _transactionReturn
+	/// that can not be reached from @param _entry.
+	static std::vector<langutil::SourceLocation> checkUnreachable(
+		CFGNode const* _entry,
+		CFGNode const* _exit,
+		CFGNode const* _revert,
+		CFGNode const* _transactionReturn
+	);
+	/// Reports the uninitialized accesses found in a function.
 	/// @param _emptyBody whether the body of the function is empty (true) or not (false)
 	/// @param _contractName name of the most derived contract, should be empty
 	///        if the function is also defined in it
-	void checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, std::optional<std::string> _contractName = {});
-	/// Checks for unreachable code, i.e. code ending in @param _exit, @param _revert or @param _transactionReturn
-	/// that can not be reached from @param _entry.
-	void checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn);
+	void reportUninitializedAccess(
+		std::vector<VariableOccurrence const*> const& _accesses,
+		bool _emptyBody,
+		std::optional<std::string> _contractName = {}
+	);
 
 	CFG const& m_cfg;
 	langutil::ErrorReporter& m_errorReporter;
+	size_t m_parallelism = 1;
 
 	std::set<langutil::SourceLocation> m_unreachableLocationsAlreadyWarnedFor;
 	std::set<VariableDeclaration const*> m_unassignedReturnVarsAlreadyWarnedFor;
@@ -78,12 +78,19 @@ void ControlFlowRevertPruner::findRevertStates()
 
 		solidity::util::BreadthFirstSearch<CFGNode*>{{functionFlow.entry}}.run(
 			[&](CFGNode* _node, auto&& _addChild) {
+				// Once the exit is found, the function has a non-reverting path
+				// regardless of the remaining nodes.
+				if (foundExit)
+					return;
 				if (_node == functionFlow.exit)
+				{
 					foundExit = true;
+					return;
+				}
 
 				if (auto const* functionCall = _node->functionCall)
 				{
-					auto const* resolvedFunction = ASTNode::resolveFunctionCall(*functionCall, item.contract);
+					auto const* resolvedFunction = resolveFunctionCall(*functionCall, item.contract);
 
 					if (resolvedFunction && resolvedFunction->isImplemented())
 					{
@@ -128,6 +135,17 @@ void ControlFlowRevertPruner::findRevertStates()
 	}
 }
 
+FunctionDefinition const* ControlFlowRevertPruner::resolveFunctionCall(
+	FunctionCall const& _functionCall,
+	ContractDefinition const* _contract
+)
+{
+	auto [it, inserted] = m_resolveCache.try_emplace({&_functionCall, _contract}, nullptr);
+	if (inserted)
+		it->second = ASTNode::resolveFunctionCall(_functionCall, _contract);
+	return it->second;
+}
+
 void ControlFlowRevertPruner::modifyFunctionFlows()
 {
 	for (auto& item: m_functions)
@@ -137,7 +155,7 @@ void ControlFlowRevertPruner::modifyFunctionFlows()
 			[&](CFGNode* _node, auto&& _addChild) {
 				if (auto const* functionCall = _node->functionCall)
 				{
-					auto const* resolvedFunction = ASTNode::resolveFunctionCall(*functionCall, item.first.contract);
+					auto const* resolvedFunction = resolveFunctionCall(*functionCall, item.first.contract);
 
 					if (resolvedFunction && resolvedFunction->isImplemented())
 						switch (m_functions.at({findScopeContract(*resolvedFunction, item.first.contract), resolvedFunction}))
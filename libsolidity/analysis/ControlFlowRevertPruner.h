@@ -51,6 +51,10 @@ private:
 	/// Modify function flows so that edges with reverting function calls are removed
 	void modifyFunctionFlows();
 
+	/// @returns the function called by @a _functionCall if the most derived
+	/// contract is @a _contract, resolving each call only once.
+	FunctionDefinition const* resolveFunctionCall(FunctionCall const& _functionCall, ContractDefinition const* _contract);
+
 	/// Control Flow Graph object.
 	CFG& m_cfg;
 
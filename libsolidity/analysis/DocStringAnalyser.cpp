@@ -124,7 +124,8 @@ bool DocStringAnalyser::visit(FunctionDefinition const& _function)
 {
 	if (!_function.isConstructor())
 		handleCallable(_function, _function, _function.annotation(), TypeProvider::function(_function));
-	return true;
+	// Nothing inside a function can have doc tags.
+	return false;
 }
 
 bool DocStringAnalyser::visit(VariableDeclaration const& _variable)
@@ -146,21 +147,21 @@ bool DocStringAnalyser::visit(ModifierDefinition const& _modifier)
 {
 	handleCallable(_modifier, _modifier, _modifier.annotation());
 
-	return true;
+	return false;
 }
 
 bool DocStringAnalyser::visit(EventDefinition const& _event)
 {
 	handleCallable(_event, _event, _event.annotation());
 
-	return true;
+	return false;
 }
 
 bool DocStringAnalyser::visit(ErrorDefinition const& _error)
 {
 	handleCallable(_error, _error, _error.annotation());
 
-	return true;
+	return false;
 }
 
 void DocStringAnalyser::handleCallable(
@@ -33,7 +33,7 @@
 
 #include <boost/algorithm/string.hpp>
 
-#include <regex>
+#include <algorithm>
 #include <string_view>
 
 using namespace std;
@@ -53,7 +53,8 @@ bool DocStringTagParser::validateDocStringsUsingTypes(SourceUnit const& _sourceU
 	ErrorReporter::ErrorWatcher errorWatcher = m_errorReporter.errorWatcher();
 
 	SimpleASTVisitor visitReturns(
-		[](ASTNode const&) { return true; },
+		// Statements cannot be documented, so there is no need to look into function bodies.
+		[](ASTNode const& _node) { return !dynamic_cast<Statement const*>(&_node); },
 		[&](ASTNode const& _node)
 		{
 			if (auto const* annotation = dynamic_cast<StructurallyDocumentedAnnotation const*>(&_node.annotation()))
@@ -124,7 +125,8 @@ bool DocStringTagParser::visit(FunctionDefinition const& _function)
 		handleConstructor(_function, _function, _function.annotation());
 	else
 		handleCallable(_function, _function, _function.annotation());
-	return true;
+	// Nothing inside a function can have doc tags.
+	return false;
 }
 
 bool DocStringTagParser::visit(VariableDeclaration const& _variable)
@@ -145,21 +147,21 @@ bool DocStringTagParser::visit(ModifierDefinition const& _modifier)
 {
 	handleCallable(_modifier, _modifier, _modifier.annotation());
 
-	return true;
+	return false;
 }
 
 bool DocStringTagParser::visit(EventDefinition const& _event)
 {
 	handleCallable(_event, _event, _event.annotation());
 
-	return true;
+	return false;
 }
 
 bool DocStringTagParser::visit(ErrorDefinition const& _error)
 {
 	handleCallable(_error, _error, _error.annotation());
 
-	return true;
+	return false;
 }
 
 void DocStringTagParser::checkParameters(
@@ -243,8 +245,13 @@ void DocStringTagParser::parseDocStrings(
 			);
 		else if (boost::starts_with(tagName, customPrefix) && tagName.size() > customPrefix.size())
 		{
-			regex static const customRegex("^custom:[a-z][a-z-]*$");
-			if (!regex_match(tagName, customRegex))
+			// Equivalent to matching "^custom:[a-z][a-z-]*$".
+			string_view customName = string_view(tagName).substr(customPrefix.size());
+			auto isLowercase = [](char _c) { return 'a' <= _c && _c <= 'z'; };
+			if (
+				!isLowercase(customName.front()) ||
+				!all_of(customName.begin(), customName.end(), [&](char _c) { return isLowercase(_c) || _c == '-'; })
+			)
 				m_errorReporter.docstringParsingError(
 					2968_error,
 					_node.documentation()->location(),
@@ -208,6 +208,16 @@ Declaration const* NameAndTypeResolver::pathFromCurrentScope(vector<ASTString> c
 
 void NameAndTypeResolver::warnHomonymDeclarations() const
 {
+	ErrorId const builtinShadowedWarning = 2319_error;
+	ErrorId const homonymWarning = 8760_error;
+	ErrorId const shadowedWarning = 2519_error;
+	bool const reportBuiltinShadowed = m_errorReporter.isReported(builtinShadowedWarning, Error::Type::Warning);
+	bool const reportHomonyms = m_errorReporter.isReported(homonymWarning, Error::Type::Warning);
+	bool const reportShadowed = m_errorReporter.isReported(shadowedWarning, Error::Type::Warning);
+	// Collecting the homonyms walks all scopes, which is only needed for the warnings.
+	if (!reportBuiltinShadowed && !reportHomonyms && !reportShadowed)
+		return;
+
 	DeclarationContainer::Homonyms homonyms;
 	m_scopes.at(nullptr)->populateHomonyms(back_inserter(homonyms));
 
@@ -224,27 +234,30 @@ void NameAndTypeResolver::warnHomonymDeclarations() const
 			if (dynamic_cast<MagicVariableDeclaration const*>(outerDeclaration))
 				magicShadowed = true;
 			else if (!outerDeclaration->isVisibleInContract())
-				homonymousLocations.append("The other declaration is here:", outerDeclaration->location());
-			else
+			{
+				if (reportHomonyms)
+					homonymousLocations.append("The other declaration is here:", outerDeclaration->location());
+			}
+			else if (reportShadowed)
 				shadowedLocations.append("The shadowed declaration is here:", outerDeclaration->location());
 		}
 
-		if (magicShadowed)
+		if (magicShadowed && reportBuiltinShadowed)
 			m_errorReporter.warning(
-				2319_error,
+				builtinShadowedWarning,
 				*innerLocation,
 				"This declaration shadows a builtin symbol."
 			);
 		if (!homonymousLocations.infos.empty())
 			m_errorReporter.warning(
-				8760_error,
+				homonymWarning,
 				*innerLocation,
 				"This declaration has the same name as another declaration.",
 				homonymousLocations
 			);
 		if (!shadowedLocations.infos.empty())
 			m_errorReporter.warning(
-				2519_error,
+				shadowedWarning,
 				*innerLocation,
 				"This declaration shadows an existing declaration.",
 				shadowedLocations
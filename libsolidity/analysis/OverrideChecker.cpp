@@ -883,53 +883,69 @@ void OverrideChecker::checkOverrideList(OverrideProxy _item, OverrideProxyBySign
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedFunctions(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedFunctions.count(&_contract))
+	if (auto it = m_inheritedFunctions.find(&_contract); it != m_inheritedFunctions.end())
+		return it->second;
+
+	OverrideProxyBySignatureMultiSet result;
+
+	for (auto const* base: resolveDirectBaseContracts(_contract))
 	{
-		OverrideProxyBySignatureMultiSet result;
+		OverrideProxyBySignatureSet const& functionsInBase = definedFunctions(*base);
 
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
-			for (FunctionDefinition const* fun: base->definedFunctions())
-				if (!fun->isConstructor())
-					functionsInBase.emplace(OverrideProxy{fun});
-			for (VariableDeclaration const* var: base->stateVariables())
-				if (var->isPublic())
-					functionsInBase.emplace(OverrideProxy{var});
-
-			result += functionsInBase;
-
-			for (OverrideProxy const& func: inheritedFunctions(*base))
-				if (!functionsInBase.count(func))
-					result.insert(func);
-		}
+		result += functionsInBase;
 
-		m_inheritedFunctions[&_contract] = result;
+		for (OverrideProxy const& func: inheritedFunctions(*base))
+			if (!functionsInBase.count(func))
+				result.insert(func);
 	}
 
-	return m_inheritedFunctions[&_contract];
+	return m_inheritedFunctions[&_contract] = move(result);
 }
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedModifiers(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedModifiers.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
+	if (auto it = m_inheritedModifiers.find(&_contract); it != m_inheritedModifiers.end())
+		return it->second;
 
-		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
-			for (ModifierDefinition const* mod: base->functionModifiers())
-				modifiersInBase.emplace(OverrideProxy{mod});
+	OverrideProxyBySignatureMultiSet result;
 
-			for (OverrideProxy const& mod: inheritedModifiers(*base))
-				modifiersInBase.insert(mod);
+	for (auto const* base: resolveDirectBaseContracts(_contract))
+	{
+		OverrideProxyBySignatureSet modifiersInBase = definedModifiers(*base);
 
-			result += modifiersInBase;
-		}
+		for (OverrideProxy const& mod: inheritedModifiers(*base))
+			modifiersInBase.insert(mod);
 
-		m_inheritedModifiers[&_contract] = result;
+		result += modifiersInBase;
 	}
 
-	return m_inheritedModifiers[&_contract];
+	return m_inheritedModifiers[&_contract] = move(result);
+}
+
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::definedFunctions(ContractDefinition const& _contract) const
+{
+	if (auto it = m_definedFunctions.find(&_contract); it != m_definedFunctions.end())
+		return it->second;
+
+	OverrideProxyBySignatureSet functions;
+	for (FunctionDefinition const* fun: _contract.definedFunctions())
+		if (!fun->isConstructor())
+			functions.emplace(OverrideProxy{fun});
+	for (VariableDeclaration const* var: _contract.stateVariables())
+		if (var->isPublic())
+			functions.emplace(OverrideProxy{var});
+
+	return m_definedFunctions[&_contract] = move(functions);
+}
+
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::definedModifiers(ContractDefinition const& _contract) const
+{
+	if (auto it = m_definedModifiers.find(&_contract); it != m_definedModifiers.end())
+		return it->second;
+
+	OverrideProxyBySignatureSet modifiers;
+	for (ModifierDefinition const* mod: _contract.functionModifiers())
+		modifiers.emplace(OverrideProxy{mod});
+
+	return m_definedModifiers[&_contract] = move(modifiers);
 }
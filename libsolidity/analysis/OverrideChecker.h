@@ -182,11 +182,21 @@ private:
 
 	void checkOverrideList(OverrideProxy _item, OverrideProxyBySignatureMultiSet const& _inherited);
 
+	using OverrideProxyBySignatureSet = std::set<OverrideProxy, OverrideProxy::CompareBySignature>;
+	/// @returns the functions (excluding the constructor) and public state variables defined in @a _contract.
+	OverrideProxyBySignatureSet const& definedFunctions(ContractDefinition const& _contract) const;
+	/// @returns the modifiers defined in @a _contract.
+	OverrideProxyBySignatureSet const& definedModifiers(ContractDefinition const& _contract) const;
+
 	langutil::ErrorReporter& m_errorReporter;
 
 	/// Cache for inheritedFunctions().
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Caches for definedFunctions() and definedModifiers(), so that all contracts deriving
+	/// from a base share the proxies and their signatures are only computed once.
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_definedFunctions;
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_definedModifiers;
 };
 
 }
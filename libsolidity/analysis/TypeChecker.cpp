@@ -298,7 +298,7 @@ void TypeChecker::endVisit(InheritanceSpecifier const& _inheritance)
 		}
 		for (size_t i = 0; i < std::min(arguments->size(), parameterTypes.size()); ++i)
 		{
-			BoolResult result = type(*(*arguments)[i])->isImplicitlyConvertibleTo(*parameterTypes[i]);
+			BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*(*arguments)[i]), *parameterTypes[i]);
 			if (!result)
 				m_errorReporter.typeErrorConcatenateDescriptions(
 					9827_error,
@@ -707,7 +707,7 @@ void TypeChecker::visitManually(
 	}
 	for (size_t i = 0; i < arguments.size(); ++i)
 	{
-		BoolResult result = type(*arguments[i])->isImplicitlyConvertibleTo(*type(*(*parameters)[i]));
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*arguments[i]), *type(*(*parameters)[i]));
 		if (!result)
 			m_errorReporter.typeErrorConcatenateDescriptions(
 				4649_error,
@@ -1202,7 +1202,7 @@ void TypeChecker::endVisit(Return const& _return)
 	else
 	{
 		Type const* expected = type(*params->parameters().front());
-		BoolResult result = type(*_return.expression())->isImplicitlyConvertibleTo(*expected);
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*_return.expression()), *expected);
 		if (!result)
 			m_errorReporter.typeErrorConcatenateDescriptions(
 				6359_error,
@@ -1310,7 +1310,7 @@ bool TypeChecker::visit(VariableDeclarationStatement const& _statement)
 		solAssert(var.annotation().type, "");
 
 		var.accept(*this);
-		BoolResult result = valueComponentType->isImplicitlyConvertibleTo(*var.annotation().type);
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*valueComponentType, *var.annotation().type);
 		if (!result)
 		{
 			auto errorMsg = "Type " +
@@ -2190,7 +2190,7 @@ void TypeChecker::typeCheckABIEncodeCallFunction(FunctionCall const& _functionCa
 	for (size_t i = 0; i < numParameters; i++)
 	{
 		Type const& argType = *type(*callArguments[i]);
-		BoolResult result = argType.isImplicitlyConvertibleTo(*functionPointerType->parameterTypes()[i]);
+		BoolResult result = TypeProvider::isImplicitlyConvertible(argType, *functionPointerType->parameterTypes()[i]);
 		if (!result)
 			m_errorReporter.typeError(
 				5407_error,
@@ -2438,7 +2438,7 @@ void TypeChecker::typeCheckFunctionGeneralChecks(
 	for (size_t i = 0; i < paramArgMap.size(); ++i)
 	{
 		solAssert(!!paramArgMap[i], "unmapped parameter");
-		BoolResult result = type(*paramArgMap[i])->isImplicitlyConvertibleTo(*parameterTypes[i]);
+		BoolResult result = TypeProvider::isImplicitlyConvertible(*type(*paramArgMap[i]), *parameterTypes[i]);
 		if (!result)
 		{
 			auto [errorId, description] = [&]() -> tuple<ErrorId, string> {
@@ -3669,7 +3669,7 @@ Declaration const& TypeChecker::dereference(IdentifierPath const& _path) const
 bool TypeChecker::expectType(Expression const& _expression, Type const& _expectedType)
 {
 	_expression.accept(*this);
-	BoolResult result = type(_expression)->isImplicitlyConvertibleTo(_expectedType);
+	BoolResult result = TypeProvider::isImplicitlyConvertible(*type(_expression), _expectedType);
 	if (!result)
 	{
 		auto errorMsg = "Type " +
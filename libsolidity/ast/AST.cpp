@@ -145,20 +145,23 @@ bool ContractDefinition::derivesFrom(ContractDefinition const& _base) const
 	return util::contains(annotation().linearizedBaseContracts, &_base);
 }
 
-map<util::FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions(bool _includeInheritedFunctions) const
+map<util::FixedHash<4>, FunctionTypePointer> const& ContractDefinition::interfaceFunctions(bool _includeInheritedFunctions) const
 {
-	auto exportedFunctionList = interfaceFunctionList(_includeInheritedFunctions);
+	return m_interfaceFunctions[_includeInheritedFunctions].init([&]{
+		auto const& exportedFunctionList = interfaceFunctionList(_includeInheritedFunctions);
 
-	map<util::FixedHash<4>, FunctionTypePointer> exportedFunctions;
-	for (auto const& it: exportedFunctionList)
-		exportedFunctions.insert(it);
+		map<util::FixedHash<4>, FunctionTypePointer> exportedFunctions(
+			exportedFunctionList.begin(),
+			exportedFunctionList.end()
+		);
 
-	solAssert(
-		exportedFunctionList.size() == exportedFunctions.size(),
-		"Hash collision at Function Definition Hash calculation"
-	);
+		solAssert(
+			exportedFunctionList.size() == exportedFunctions.size(),
+			"Hash collision at Function Definition Hash calculation"
+		);
 
-	return exportedFunctions;
+		return exportedFunctions;
+	});
 }
 
 FunctionDefinition const* ContractDefinition::constructor() const
@@ -192,6 +195,16 @@ FunctionDefinition const* ContractDefinition::receiveFunction() const
 	return nullptr;
 }
 
+vector<VariableDeclaration const*> const& ContractDefinition::stateVariablesIncludingInherited() const
+{
+	return m_stateVariablesIncludingInherited.init([&]{
+		vector<VariableDeclaration const*> stateVars;
+		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			stateVars += contract->stateVariables();
+		return stateVars;
+	});
+}
+
 vector<EventDefinition const*> const& ContractDefinition::definedInterfaceEvents() const
 {
 	return m_interfaceEvents.init([&]{
@@ -246,6 +259,7 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		set<string> signaturesSeen;
+		vector<string> signatures;
 		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
@@ -268,12 +282,20 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					util::FixedHash<4> hash(util::keccak256(functionSignature));
-					interfaceFunctionList.emplace_back(hash, fun);
+					signatures.emplace_back(move(functionSignature));
+					interfaceFunctionList.emplace_back(util::FixedHash<4>{}, fun);
 				}
 			}
 		}
 
+		// The selectors of all functions are hashed at once.
+		vector<bytesConstRef> hashInputs;
+		for (string const& signature: signatures)
+			hashInputs.emplace_back(&signature);
+		vector<util::h256> hashes = util::keccak256(hashInputs);
+		for (size_t i = 0; i < hashes.size(); ++i)
+			interfaceFunctionList[i].first = util::FixedHash<4>(hashes[i]);
+
 		return interfaceFunctionList;
 	});
 }
@@ -79,6 +79,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the identifier. Used to combine the results of several parsers
+	/// into a single compilation run.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(id() + _offset); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -121,7 +124,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -509,6 +512,9 @@ public:
 	std::vector<StructDefinition const*> definedStructs() const { return filteredNodes<StructDefinition>(m_subNodes); }
 	std::vector<EnumDefinition const*> definedEnums() const { return filteredNodes<EnumDefinition>(m_subNodes); }
 	std::vector<VariableDeclaration const*> stateVariables() const { return filteredNodes<VariableDeclaration>(m_subNodes); }
+	/// @returns the state variables of this contract and all its base contracts,
+	/// including private ones, in the order of the linearized base contracts.
+	std::vector<VariableDeclaration const*> const& stateVariablesIncludingInherited() const;
 	std::vector<ModifierDefinition const*> functionModifiers() const { return filteredNodes<ModifierDefinition>(m_subNodes); }
 	std::vector<FunctionDefinition const*> definedFunctions() const { return filteredNodes<FunctionDefinition>(m_subNodes); }
 	/// @returns a view<FunctionDefinition const*> of all functions
@@ -532,8 +538,8 @@ public:
 	bool derivesFrom(ContractDefinition const& _base) const;
 
 	/// @returns a map of canonical function signatures to FunctionDefinitions
-	/// as intended for use by the ABI.
-	std::map<util::FixedHash<4>, FunctionTypePointer> interfaceFunctions(bool _includeInheritedFunctions = true) const;
+	/// as intended for use by the ABI. The map is computed only once.
+	std::map<util::FixedHash<4>, FunctionTypePointer> const& interfaceFunctions(bool _includeInheritedFunctions = true) const;
 	std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>> const& interfaceFunctionList(bool _includeInheritedFunctions = true) const;
 	/// @returns the EIP-165 compatible interface identifier. This will exclude inherited functions.
 	uint32_t interfaceId() const;
@@ -576,7 +582,9 @@ private:
 	bool m_abstract{false};
 
 	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList[2];
+	util::LazyInit<std::map<util::FixedHash<4>, FunctionTypePointer>> m_interfaceFunctions[2];
 	util::LazyInit<std::vector<EventDefinition const*>> m_interfaceEvents;
+	util::LazyInit<std::vector<VariableDeclaration const*>> m_stateVariablesIncludingInherited;
 	util::LazyInit<std::multimap<std::string, FunctionDefinition const*>> m_definedFunctionsByName;
 };
 
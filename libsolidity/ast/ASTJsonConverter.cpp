@@ -107,15 +107,20 @@ void ASTJsonConverter::setJsonNode(
 			m_currentValue["documentation"] = *documented->documentation();
 	m_currentValue["nodeType"] = _nodeType;
 	for (auto& e: _attributes)
-		m_currentValue[e.first] = std::move(e.second);
+		if (!e.second.isNull())
+			m_currentValue[e.first] = std::move(e.second);
 }
 
 optional<size_t> ASTJsonConverter::sourceIndexFromLocation(SourceLocation const& _location) const
 {
-	if (_location.sourceName && m_sourceIndices.count(*_location.sourceName))
-		return m_sourceIndices.at(*_location.sourceName);
-	else
+	if (!_location.sourceName)
 		return nullopt;
+
+	auto [cached, inserted] = m_sourceIndexCache.try_emplace(_location.sourceName);
+	if (inserted)
+		if (auto it = m_sourceIndices.find(*_location.sourceName); it != m_sourceIndices.end())
+			cached->second = it->second;
+	return cached->second;
 }
 
 string ASTJsonConverter::sourceLocationToString(SourceLocation const& _location) const
@@ -124,7 +129,12 @@ string ASTJsonConverter::sourceLocationToString(SourceLocation const& _location)
 	int length = -1;
 	if (_location.start >= 0 && _location.end >= 0)
 		length = _location.end - _location.start;
-	return to_string(_location.start) + ":" + to_string(length) + ":" + (sourceIndexOpt.has_value() ? to_string(sourceIndexOpt.value()) : "-1");
+	string result = to_string(_location.start);
+	result += ':';
+	result += to_string(length);
+	result += ':';
+	result += sourceIndexOpt.has_value() ? to_string(sourceIndexOpt.value()) : "-1";
+	return result;
 }
 
 string ASTJsonConverter::namePathToString(std::vector<ASTString> const& _namePath)
@@ -196,7 +206,15 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
-	_node.accept(*this);
+	{
+		++m_toJsonDepth;
+		ScopeGuard decreaseDepth([&]() { --m_toJsonDepth; });
+		_node.accept(*this);
+	}
+	// Null members of nested nodes are removed together with those of the outermost one
+	// instead of walking each subtree once per enclosing node.
+	if (m_toJsonDepth > 0)
+		return std::move(m_currentValue);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
@@ -34,6 +34,7 @@
 #include <optional>
 #include <ostream>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
 namespace solidity::langutil
@@ -197,7 +198,11 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Number of enclosing calls to toJson, null members are only removed by the outermost one.
+	size_t m_toJsonDepth = 0;
 	std::map<std::string, unsigned> m_sourceIndices;
+	/// Source indices by interned source name, filled on demand from m_sourceIndices.
+	mutable std::unordered_map<std::string const*, std::optional<size_t>> m_sourceIndexCache;
 };
 
 }
@@ -43,6 +43,20 @@ namespace solidity::frontend
 
 using SourceLocation = langutil::SourceLocation;
 
+namespace
+{
+
+/// @returns a view of the string value @a _value without copying it.
+string_view asStringView(Json::Value const& _value)
+{
+	char const* begin = nullptr;
+	char const* end = nullptr;
+	astAssert(_value.getString(&begin, &end), "Expected string.");
+	return {begin, static_cast<size_t>(end - begin)};
+}
+
+}
+
 template<class T>
 ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 {
@@ -58,7 +72,7 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(map<string, Json::Value> const& _sourceList)
 {
 	for (auto const& src: _sourceList)
-		m_sourceNames.emplace_back(make_shared<string const>(src.first));
+		m_sourceNames.emplace_back(langutil::internSourceName(src.first));
 	for (auto const& srcPair: _sourceList)
 	{
 		astAssert(!srcPair.second.isNull());
@@ -90,16 +104,18 @@ ASTPointer<T> ASTJsonImporter::createASTNode(Json::Value const& _node, Args&&...
 
 SourceLocation const ASTJsonImporter::createSourceLocation(Json::Value const& _node)
 {
-	astAssert(member(_node, "src").isString(), "'src' must be a string");
+	Json::Value const& src = member(_node, "src");
+	astAssert(src.isString(), "'src' must be a string");
 
-	return solidity::langutil::parseSourceLocation(_node["src"].asString(), m_sourceNames);
+	return solidity::langutil::parseSourceLocation(asStringView(src), m_sourceNames);
 }
 
 SourceLocation ASTJsonImporter::createNameSourceLocation(Json::Value const& _node)
 {
-	astAssert(member(_node, "nameLocation").isString(), "'nameLocation' must be a string");
+	Json::Value const& nameLocation = member(_node, "nameLocation");
+	astAssert(nameLocation.isString(), "'nameLocation' must be a string");
 
-	return solidity::langutil::parseSourceLocation(_node["nameLocation"].asString(), m_sourceNames);
+	return solidity::langutil::parseSourceLocation(asStringView(nameLocation), m_sourceNames);
 }
 
 template<class T>
@@ -961,10 +977,10 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json::V
 
 // ===== helper functions ==========
 
-Json::Value ASTJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& ASTJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
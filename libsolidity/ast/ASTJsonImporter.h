@@ -129,8 +129,8 @@ private:
 	///@}
 
 	// =============== general helper functions ===================
-	/// @returns the member of a given JSON object, throws if member does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	/// @returns the member of a given JSON object or a null value if it does not exist
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json::Value const& _node);
 	template<class T>
@@ -153,8 +153,8 @@ private:
 	///@}
 
 	// =========== member variables ===============
-	/// list of source names, order by source index
-	std::vector<std::shared_ptr<std::string const>> m_sourceNames;
+	/// list of source names, order by source index, obtained from langutil::internSourceName
+	std::vector<std::string const*> m_sourceNames;
 	/// filepath to AST
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	/// IDs already used by the nodes
@@ -24,7 +24,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -37,18 +39,48 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * The types are owned by a TypeProvider instance. By default, a single process-wide instance is
+ * used. An instance can also be owned by a single compilation and be made the current one via
+ * a Scope object, which allows independent compilations to run concurrently on different threads.
+ * Types from different instances must not be mixed. Access to an instance is not synchronized.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	/// Makes the given type provider the one used by the static functions on the current thread
+	/// for the lifetime of the Scope object.
+	class Scope
+	{
+	public:
+		explicit Scope(TypeProvider& _typeProvider): m_previous(current())
+		{
+			current() = &_typeProvider;
+		}
+		~Scope() { current() = m_previous; }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		TypeProvider* m_previous;
+	};
+
+	TypeProvider();
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
-	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
+	/// @returns the type provider of the innermost active Scope of the current thread
+	/// or the process-wide type provider if there is none.
+	static TypeProvider& instance()
+	{
+		if (TypeProvider* typeProvider = current())
+			return *typeProvider;
+		static TypeProvider provider;
+		return provider;
+	}
+
+	/// Resets state of the current TypeProvider (see instance()) to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
@@ -61,10 +93,10 @@ public:
 	static Type const* fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() noexcept { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -83,16 +115,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() noexcept { return &instance().m_payableAddress; }
+	static AddressType const* address() noexcept { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return instance().m_uintM.at(_bits / 8 - 1).get();
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return instance().m_intM.at(_bits / 8 - 1).get();
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -107,7 +139,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() noexcept { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -177,7 +209,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -199,39 +231,69 @@ public:
 
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
+	/// @returns the result of @a _from.isImplicitlyConvertibleTo(@a _to), which is cached if
+	/// @a _from is a composite type, whose conversions are expensive to check.
+	/// Both types have to be provided by the type provider, i.e. they must not be temporaries.
+	static BoolResult isImplicitlyConvertible(Type const& _from, Type const& _to);
+
 private:
-	/// Global TypeProvider instance.
-	static TypeProvider& instance()
+	static TypeProvider*& current()
 	{
-		static TypeProvider _provider;
-		return _provider;
+		thread_local TypeProvider* typeProvider = nullptr;
+		return typeProvider;
 	}
 
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
-
-	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	/// Types created from the same arguments, by the arguments.
+	template <typename Key, typename T>
+	using TypeCache = std::map<Key, T const*>;
+
+	/// @returns the type stored in @a _cache under @a _key or creates it from @a _args and stores it
+	/// there. Only usable for types whose construction does not depend on anything
+	/// but the arguments (e.g. not on annotations of the AST).
+	template <typename T, typename Key, typename... Args>
+	static inline T const* cachedCreateAndGet(TypeCache<Key, T>& _cache, Key _key, Args&& ... _args);
+
+	BoolType const m_boolean{};
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
+
+	/// These are lazy-initialized because they depend on `byte` being available,
+	/// which is not the case while the instance is constructed.
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_payableAddress{StateMutability::Payable};
+	AddressType const m_address{StateMutability::NonPayable};
+	std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
+	std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	TypeCache<std::tuple<ReferenceType const*, DataLocation, bool>, ReferenceType> m_withLocation;
+	TypeCache<std::tuple<DataLocation, Type const*, std::optional<u256>>, ArrayType> m_arrays;
+	TypeCache<ArrayType const*, ArraySliceType> m_arraySlices;
+	TypeCache<std::pair<Type const*, Type const*>, MappingType> m_mappings;
+	TypeCache<std::vector<Type const*>, TupleType> m_tuples;
+	TypeCache<Type const*, TypeType> m_typeTypes;
+	TypeCache<Type const*, MagicType> m_metaTypes;
+	TypeCache<std::pair<ContractDefinition const*, bool>, ContractType> m_contracts;
+	TypeCache<std::pair<StructDefinition const*, DataLocation>, StructType> m_structs;
+	TypeCache<EnumDefinition const*, EnumType> m_enums;
+	TypeCache<UserDefinedValueTypeDefinition const*, UserDefinedValueType> m_userDefinedValueTypes;
+	TypeCache<SourceUnit const*, ModuleType> m_modules;
+
+	std::map<std::pair<Type const*, Type const*>, BoolResult> m_implicitConversions;
 };
 
 }
@@ -1603,6 +1603,9 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	// Types created from the same arguments are shared by the type provider.
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -2955,6 +2958,8 @@ string FunctionType::richIdentifier() const
 
 bool FunctionType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
@@ -3437,8 +3442,11 @@ bool FunctionType::isBareCall() const
 	}
 }
 
-string FunctionType::externalSignature() const
+string const& FunctionType::externalSignature() const
 {
+	if (m_externalSignature)
+		return *m_externalSignature;
+
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
 	solAssert(!m_declaration->name().empty(), "Fallback function has no signature.");
 	switch (kind())
@@ -3472,7 +3480,8 @@ string FunctionType::externalSignature() const
 			typeName += " storage";
 		return typeName;
 	});
-	return m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	m_externalSignature = m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	return *m_externalSignature;
 }
 
 u256 FunctionType::externalIdentifier() const
@@ -3644,6 +3653,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -3690,6 +3701,8 @@ string TypeType::richIdentifier() const
 
 bool TypeType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	TypeType const& other = dynamic_cast<TypeType const&>(_other);
@@ -1408,8 +1408,9 @@ public:
 	bool isBareCall() const;
 	Kind const& kind() const { return m_kind; }
 	StateMutability stateMutability() const { return m_stateMutability; }
-	/// @returns the external signature of this function type given the function name
-	std::string externalSignature() const;
+	/// @returns the external signature of this function type given the function name.
+	/// The signature is computed only once.
+	std::string const& externalSignature() const;
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	/// @returns the external identifier of this function (the hash of the signature) as a hex string.
@@ -1485,6 +1486,7 @@ private:
 	StateMutability m_stateMutability = StateMutability::NonPayable;
 	Declaration const* m_declaration = nullptr;
 	Options const m_options;
+	mutable std::optional<std::string> m_externalSignature;
 };
 
 /**
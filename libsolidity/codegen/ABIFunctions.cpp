@@ -1178,6 +1178,32 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
+		if (!_fromMemory && decodedByCopy(*_type.baseType()))
+			return Whiskers(R"(
+				// <readableTypeName>
+				function <functionName>(offset, length, end) -> array {
+					array := <allocate>(<allocationSize>(length))
+					let dst := array
+					<?dynamic>
+						mstore(array, length)
+						dst := add(array, 0x20)
+					</dynamic>
+					let size := mul(length, <stride>)
+					if gt(add(offset, size), end) {
+						<revertInvalidStride>()
+					}
+					calldatacopy(dst, offset, size)
+				}
+			)")
+			("functionName", functionName)
+			("readableTypeName", _type.toString(true))
+			("allocate", m_utils.allocationFunction())
+			("allocationSize", m_utils.arrayAllocationSizeFunction(_type))
+			("stride", toCompactHexWithPrefix(_type.calldataStride()))
+			("dynamic", _type.isDynamicallySized())
+			("revertInvalidStride", revertReasonIfDebugFunction("ABI decoding: invalid calldata array stride"))
+			.render();
+
 		Whiskers templ(R"(
 			// <readableTypeName>
 			function <functionName>(offset, length, end) -> array {
@@ -1334,6 +1360,26 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 		(_fromMemory ? "_fromMemory" : "");
 
 	return createFunction(functionName, [&]() {
+		solAssert(_type.memoryDataSize() < u256("0xffffffffffffffff"), "");
+		auto const& members = _type.members(nullptr);
+		if (!_fromMemory && all_of(members.begin(), members.end(), [&](auto const& _member) {
+			return _member.type->decodingType() && decodedByCopy(*_member.type->decodingType());
+		}))
+			return Whiskers(R"(
+				// <readableTypeName>
+				function <functionName>(headStart, end) -> value {
+					if slt(sub(end, headStart), <size>) { <revertString>() }
+					value := <allocate>(<size>)
+					calldatacopy(value, headStart, <size>)
+				}
+			)")
+			("functionName", functionName)
+			("readableTypeName", _type.toString(true))
+			("revertString", revertReasonIfDebugFunction("ABI decoding: struct data too short"))
+			("allocate", m_utils.allocationFunction())
+			("size", toCompactHexWithPrefix(_type.memoryDataSize()))
+			.render();
+
 		Whiskers templ(R"(
 			// <readableTypeName>
 			function <functionName>(headStart, end) -> value {
@@ -1352,11 +1398,10 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 		templ("functionName", functionName);
 		templ("readableTypeName", _type.toString(true));
 		templ("allocate", m_utils.allocationFunction());
-		solAssert(_type.memoryDataSize() < u256("0xffffffffffffffff"), "");
 		templ("memorySize", toCompactHexWithPrefix(_type.memoryDataSize()));
 		size_t headPos = 0;
-		vector<map<string, string>> members;
-		for (auto const& member: _type.members(nullptr))
+		vector<map<string, string>> memberDecoders;
+		for (auto const& member: members)
 		{
 			solAssert(member.type, "");
 			solAssert(!member.type->containsNestedMapping(), "");
@@ -1379,12 +1424,12 @@ string ABIFunctions::abiDecodingFunctionStruct(StructType const& _type, bool _fr
 			memberTempl("memoryOffset", toCompactHexWithPrefix(_type.memoryOffsetOfMember(member.name)));
 			memberTempl("abiDecode", abiDecodingFunction(*member.type, _fromMemory, false));
 
-			members.emplace_back();
-			members.back()["decode"] = memberTempl.render();
-			members.back()["memberName"] = member.name;
+			memberDecoders.emplace_back();
+			memberDecoders.back()["decode"] = memberTempl.render();
+			memberDecoders.back()["memberName"] = member.name;
 			headPos += decodingType->calldataHeadSize();
 		}
-		templ("members", members);
+		templ("members", memberDecoders);
 		templ("minimumSize", toCompactHexWithPrefix(headPos));
 		return templ.render();
 	});
@@ -1538,6 +1583,21 @@ string ABIFunctions::createFunction(string const& _name, function<string ()> con
 	return m_functionCollector.createFunction(_name, _creator);
 }
 
+bool ABIFunctions::decodedByCopy(Type const& _type) const
+{
+	if (!m_functionCollector.copyCalldataInABIDecoder())
+		return false;
+	Type const* type = &_type;
+	if (auto userDefinedValueType = dynamic_cast<UserDefinedValueType const*>(type))
+		type = &userDefinedValueType->underlyingType();
+	// Only values of types whose cleanup does not change any value are not validated.
+	if (auto integerType = dynamic_cast<IntegerType const*>(type))
+		return integerType->numBits() == 256;
+	if (auto fixedBytesType = dynamic_cast<FixedBytesType const*>(type))
+		return fixedBytesType->numBytes() == 32;
+	return false;
+}
+
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
 {
 	size_t headSize = 0;
@@ -264,6 +264,11 @@ private:
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
+	/// @returns true if the function collector requests decoders that copy values of type @a _type
+	/// from calldata to memory, which is only possible if the ABI encoding of the values is
+	/// their memory representation and decoding does not validate them.
+	bool decodedByCopy(Type const& _type) const;
+
 	/// @returns the size of the static part of the encoding of the given types.
 	static size_t headSize(TypePointers const& _targetTypes);
 
@@ -37,8 +37,16 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _parallelism maximum number of threads used to optimise the sub-assemblies
+	/// of the contract. Does not influence the result.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		size_t _parallelism = 1
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_parallelism(_parallelism),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
@@ -59,11 +67,20 @@ public:
 	/// @returns Runtime assembly as a shared pointer.
 	std::shared_ptr<evmasm::Assembly> runtimeAssemblyPtr() const;
 
+	/// Lets the creation and runtime code share the optimized Yul code in @a _cache
+	/// with all other users of the cache.
+	void setOptimizedObjectCache(std::shared_ptr<yul::OptimizedObjectCache> const& _cache)
+	{
+		m_context.setOptimizedObjectCache(_cache);
+		m_runtimeContext.setOptimizedObjectCache(_cache);
+	}
+
 	std::string generatedYulUtilityCode() const { return m_context.generatedYulUtilityCode(); }
 	std::string runtimeGeneratedYulUtilityCode() const { return m_runtimeContext.generatedYulUtilityCode(); }
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_parallelism = 1;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
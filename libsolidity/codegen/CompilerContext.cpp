@@ -36,8 +36,10 @@
 #include <libyul/backends/evm/AsmCodeGen.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/Object.h>
+#include <libyul/OptimizedObjectCache.h>
 #include <libyul/YulString.h>
 #include <libyul/Utilities.h>
 
@@ -61,6 +63,50 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Collects the names of the sources referenced by the origin locations of a Yul AST.
+class SourceNameCollector: public yul::ASTWalker
+{
+public:
+	using yul::ASTWalker::operator();
+
+	void operator()(yul::VariableDeclaration const& _varDecl) override
+	{
+		for (yul::TypedName const& variable: _varDecl.variables)
+			add(variable.debugData);
+		yul::ASTWalker::operator()(_varDecl);
+	}
+	void operator()(yul::FunctionDefinition const& _function) override
+	{
+		for (yul::TypedName const& parameter: _function.parameters + _function.returnVariables)
+			add(parameter.debugData);
+		yul::ASTWalker::operator()(_function);
+	}
+	void visit(yul::Statement const& _statement) override
+	{
+		add(yul::debugDataOf(_statement));
+		yul::ASTWalker::visit(_statement);
+	}
+	void visit(yul::Expression const& _expression) override
+	{
+		add(yul::debugDataOf(_expression));
+		yul::ASTWalker::visit(_expression);
+	}
+
+	set<string> names;
+
+private:
+	void add(shared_ptr<yul::DebugData const> const& _debugData)
+	{
+		if (_debugData && _debugData->originLocation.sourceName)
+			names.insert(*_debugData->originLocation.sourceName);
+	}
+};
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -194,6 +240,7 @@ void CompilerContext::appendYulUtilityFunctions(OptimiserSettings const& _optimi
 	solAssert(!m_appendYulUtilityFunctionsRan, "requestedYulFunctions called more than once.");
 	m_appendYulUtilityFunctionsRan = true;
 
+	m_yulFunctionCollector.setPruneUnusedFunctions(_optimiserSettings.pruneUnusedFunctions);
 	string code = m_yulFunctionCollector.requestedFunctions();
 	if (!code.empty())
 	{
@@ -394,6 +441,10 @@ void CompilerContext::appendInlineAssembly(
 	for (auto const& var: _localVariables)
 		externallyUsedIdentifiers.insert(yul::YulString(var));
 
+	optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
+
 	yul::ExternalIdentifierAccess identifierAccess;
 	identifierAccess.resolve = [&](
 		yul::Identifier const& _identifier,
@@ -421,7 +472,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(nativeLocationOf(_identifier)) <<
+				errinfo_sourceLocation(locationOverride.value_or(nativeLocationOf(_identifier))) <<
 				util::errinfo_comment("Stack too deep (" + to_string(stackDiff) + "), try removing local variables.")
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -433,15 +484,30 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
+	// Snippets that are not optimized are parsed and analyzed only once. They are parsed without
+	// the location override, which is instead assigned to the generated items, so that the same
+	// snippet can be reused at all places it is generated for.
+	bool const useCache = !_system && !(_optimiserSettings.runYulOptimiser && _localVariables.empty());
+	auto cacheKey = make_tuple(_assembly, _localVariables, _sourceName);
+	if (useCache)
+		if (auto cached = m_inlineAssemblyCache.find(cacheKey); cached != m_inlineAssemblyCache.end())
+		{
+			assembleInlineAssembly(
+				*cached->second.first,
+				*cached->second.second,
+				identifierAccess.generateCode,
+				*locationOverride,
+				_optimiserSettings
+			);
+			return;
+		}
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	langutil::CharStream charStream(_assembly, _sourceName);
-	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
 	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
+		yul::Parser(errorReporter, dialect, useCache ? nullopt : locationOverride)
 		.parse(charStream);
 #ifdef SOL_OUTPUT_ASM
 	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
@@ -464,11 +530,11 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
+	auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
 	bool analyzerResult = false;
 	if (parserResult)
 		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
+			*analysisInfo,
 			errorReporter,
 			dialect,
 			identifierAccess.resolve
@@ -482,7 +548,7 @@ void CompilerContext::appendInlineAssembly(
 	{
 		yul::Object obj;
 		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		obj.analysisInfo = analysisInfo;
 
 		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
 
@@ -497,7 +563,7 @@ void CompilerContext::appendInlineAssembly(
 			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
+		analysisInfo = std::move(obj.analysisInfo);
 		parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
@@ -516,9 +582,22 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	if (useCache)
+	{
+		m_inlineAssemblyCache.emplace(move(cacheKey), make_pair(parserResult, analysisInfo));
+		assembleInlineAssembly(
+			*parserResult,
+			*analysisInfo,
+			identifierAccess.generateCode,
+			*locationOverride,
+			_optimiserSettings
+		);
+		return;
+	}
+
 	yul::CodeGenerator::assemble(
 		*parserResult,
-		analysisInfo,
+		*analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess.generateCode,
@@ -530,6 +609,40 @@ void CompilerContext::appendInlineAssembly(
 	updateSourceLocation();
 }
 
+void CompilerContext::assembleInlineAssembly(
+	yul::Block const& _code,
+	yul::AsmAnalysisInfo& _analysisInfo,
+	yul::ExternalIdentifierAccess::CodeGenerator const& _identifierAccess,
+	langutil::SourceLocation const& _location,
+	OptimiserSettings const& _optimiserSettings
+)
+{
+	size_t firstItem = m_asm->items().size();
+	try
+	{
+		yul::CodeGenerator::assemble(
+			_code,
+			_analysisInfo,
+			*m_asm,
+			m_evmVersion,
+			_identifierAccess,
+			false,
+			_optimiserSettings.optimizeStackAllocation
+		);
+	}
+	catch (StackTooDeepError& _error)
+	{
+		// The snippet is shared between call sites, so the errors are reported at this one.
+		_error << errinfo_sourceLocation(_location);
+		throw;
+	}
+	// The code was parsed without a location override, so the location is assigned here.
+	for (size_t i = firstItem; i < m_asm->items().size(); ++i)
+		m_asm->items()[i].setLocation(_location);
+
+	updateSourceLocation();
+}
+
 
 void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSettings, std::set<yul::YulString> const& _externalIdentifiers)
 {
@@ -538,7 +651,47 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 #endif
 
 	bool const isCreation = runtimeContext() != nullptr;
+	optional<util::h256> cacheKey;
+	if (m_optimizedObjectCache)
+	{
+		string context =
+			"legacy:" + m_evmVersion.name() + ":" +
+			(isCreation ? "creation" : "runtime") + ":" +
+			(_optimiserSettings.optimizeStackAllocation ? "stackAllocation" : "") + ":" +
+			to_string(_optimiserSettings.expectedExecutionsPerDeployment) + ":" +
+			to_string(_optimiserSettings.inlinerGrowthBudget) + ":" +
+			(_optimiserSettings.reuseMemorySlots ? "reuseMemorySlots" : "") + ":" +
+			(_optimiserSettings.rematerialiserGasCosts ? "rematerialiserGasCosts" : "") + ":" +
+			(_optimiserSettings.storeKnowledgeAcrossCalls ? "storeKnowledgeAcrossCalls" : "") + ":" +
+			(_optimiserSettings.storeKnowledgeInLoops ? "storeKnowledgeInLoops" : "") + ":" +
+			to_string(_optimiserSettings.yulOptimiserMaxCodeGrowth) + ":" +
+			to_string(_optimiserSettings.yulOptimiserMaxSteps) + ":" +
+			_optimiserSettings.yulOptimiserSteps;
+		for (yul::YulString const& identifier: _externalIdentifiers)
+			context += ":" + identifier.str();
+		if (!_object.debugData)
+		{
+			// The legacy code generator does not number its sources, but the key has to contain
+			// the source locations, so that identical code at different places is not merged.
+			SourceNameCollector collector;
+			collector(*_object.code);
+			yul::SourceNameMap sourceNames;
+			for (string const& name: collector.names)
+				sourceNames.emplace(static_cast<unsigned>(sourceNames.size()), make_shared<string const>(name));
+			_object.debugData = make_shared<yul::ObjectDebugData>(yul::ObjectDebugData{move(sourceNames)});
+		}
+		cacheKey = yul::OptimizedObjectCache::key(_object, _dialect, context);
+		if (shared_ptr<yul::Object> cached = m_optimizedObjectCache->lookup(*cacheKey, _dialect))
+		{
+			_object.code = move(cached->code);
+			_object.analysisInfo = move(cached->analysisInfo);
+			return;
+		}
+	}
+
 	yul::GasMeter meter(_dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
+	// The blocks of inline assembly and the utility functions optimised here are small, so
+	// a trip of the guard is not reported.
 	yul::OptimiserSuite::run(
 		_dialect,
 		&meter,
@@ -546,9 +699,21 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
 		isCreation? nullopt : make_optional(_optimiserSettings.expectedExecutionsPerDeployment),
-		_externalIdentifiers
+		_externalIdentifiers,
+		1,
+		{},
+		_optimiserSettings.inlinerGrowthBudget,
+		_optimiserSettings.reuseMemorySlots,
+		_optimiserSettings.rematerialiserGasCosts,
+		_optimiserSettings.storeKnowledgeAcrossCalls,
+		_optimiserSettings.storeKnowledgeInLoops,
+		_optimiserSettings.yulOptimiserMaxCodeGrowth,
+		_optimiserSettings.yulOptimiserMaxSteps
 	);
 
+	if (cacheKey)
+		m_optimizedObjectCache->store(*cacheKey, _object);
+
 #ifdef SOL_OUTPUT_ASM
 	cout << "After optimizer:" << endl;
 	cout << yul::AsmPrinter(*dialect)(*object.code) << endl;
@@ -572,15 +737,20 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false,  false, false, false, false, false, false, false, m_evmVersion, 0, 0};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
+	asmSettings.runInlinerWithSideEffects = _settings.runInlinerWithSideEffects;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
+	asmSettings.runSuperoptimiser = _settings.runSuperoptimiser;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runCSEAcrossBlocks = _settings.runCSEAcrossBlocks;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.cseMaxBlockLength = _settings.cseMaxBlockLength;
+	asmSettings.constantOptimiserNegation = _settings.constantOptimiserNegation;
 	asmSettings.evmVersion = m_evmVersion;
 	return asmSettings;
 }
@@ -48,6 +48,11 @@
 #include <utility>
 #include <limits>
 
+namespace solidity::yul
+{
+class OptimizedObjectCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -278,12 +283,18 @@ public:
 	std::string revertReasonIfDebug(std::string const& _message = "");
 
 	void optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSetting, std::set<yul::YulString> const& _externalIdentifiers = {});
+	/// Sets a cache that is used by @a optimizeYul to optimize identical Yul code, like the
+	/// utility functions needed by several contracts, only once.
+	void setOptimizedObjectCache(std::shared_ptr<yul::OptimizedObjectCache> _cache) { m_optimizedObjectCache = std::move(_cache); }
 
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, using up to @a _parallelism threads for independent sub-assemblies.
+	void optimise(OptimiserSettings const& _settings, size_t _parallelism = 1)
+	{
+		m_asm->optimise(translateOptimiserSettings(_settings), _parallelism);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -314,6 +325,16 @@ private:
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
+	/// Appends the code for the parsed and analyzed inline assembly snippet @a _code
+	/// and assigns the location @a _location to all generated items.
+	void assembleInlineAssembly(
+		yul::Block const& _code,
+		yul::AsmAnalysisInfo& _analysisInfo,
+		yul::ExternalIdentifierAccess::CodeGenerator const& _identifierAccess,
+		langutil::SourceLocation const& _location,
+		OptimiserSettings const& _optimiserSettings
+	);
+
 	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
 
 	/**
@@ -387,6 +408,14 @@ private:
 	/// Generated Yul code used as utility. Source references from the bytecode can point here.
 	/// Produced from @a m_yulFunctionCollector.
 	std::string m_generatedYulUtilityCode;
+	/// Parsed and analyzed snippets of inline assembly that are not optimized, by their code,
+	/// local variables and source name. Used by @a appendInlineAssembly.
+	std::map<
+		std::tuple<std::string, std::vector<std::string>, std::string>,
+		std::pair<std::shared_ptr<yul::Block>, std::shared_ptr<yul::AsmAnalysisInfo>>
+	> m_inlineAssemblyCache;
+	/// Cache of optimized Yul code, possibly shared with other contexts.
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
 	/// Container for ABI functions to be generated.
 	ABIFunctions m_abiFunctions;
 	/// Container for Yul Util functions to be generated.
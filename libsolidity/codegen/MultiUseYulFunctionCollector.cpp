@@ -23,6 +23,8 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
@@ -33,49 +35,139 @@ using namespace solidity::util;
 
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
-	string result = move(m_code);
-	m_code.clear();
+	set<string> used;
+	if (m_pruneUnusedFunctions)
+	{
+		map<string, Function const*> functionsByName;
+		for (Function const& function: m_functions)
+			functionsByName[function.name] = &function;
+		vector<string> toVisit(m_rootFunctions.begin(), m_rootFunctions.end());
+		while (!toVisit.empty())
+		{
+			string name = move(toVisit.back());
+			toVisit.pop_back();
+			if (!used.insert(name).second)
+				continue;
+			if (auto function = functionsByName.find(name); function != functionsByName.end())
+				toVisit += function->second->calledFunctions;
+		}
+	}
+
+	string result;
+	for (Function& function: m_functions)
+		if (!m_pruneUnusedFunctions || used.count(function.name))
+			result += move(function.code);
+	m_functions.clear();
+	m_rootFunctions.clear();
 	m_requestedFunctions.clear();
 	return result;
 }
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
+	return create(_name, true, [&]() {
 		string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
-		m_code += move(fun);
-	}
-	return _name;
+		return fun;
+	});
 }
 
 string MultiUseYulFunctionCollector::createFunction(
 	string const& _name,
 	function<string(vector<string>&, vector<string>&)> const& _creator
 )
+{
+	return create(_name, true, [&]() { return render(_name, _creator); });
+}
+
+string MultiUseYulFunctionCollector::createContractFunction(string const& _name, function<string()> const& _creator)
+{
+	return create(_name, false, [&]() {
+		string fun = _creator();
+		solAssert(!fun.empty(), "");
+		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+		return fun;
+	});
+}
+
+string MultiUseYulFunctionCollector::createContractFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return create(_name, false, [&]() { return render(_name, _creator); });
+}
+
+string MultiUseYulFunctionCollector::create(string const& _name, bool _shared, function<string()> const& _generate)
 {
 	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
+	if (m_dependencies.empty())
+		m_rootFunctions.insert(_name);
+	else
+		m_dependencies.back().push_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	if (_shared && m_sharedFunctions && m_sharedFunctions->functions.count(_name))
 	{
-		m_requestedFunctions.insert(_name);
-		vector<string> arguments;
-		vector<string> returnParameters;
-		string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
+		addSharedFunction(_name);
+		return _name;
+	}
+
+	m_requestedFunctions.insert(_name);
+	m_dependencies.emplace_back();
+	ScopeGuard popDependencies([&]() { m_dependencies.pop_back(); });
+	string code = _generate();
+	if (_shared && m_sharedFunctions)
+		m_sharedFunctions->functions[_name] = {m_dependencies.back(), code};
+	add(_name, move(code), m_dependencies.back());
+	return _name;
+}
 
-		m_code += Whiskers(R"(
+void MultiUseYulFunctionCollector::addSharedFunction(string const& _name)
+{
+	m_requestedFunctions.insert(_name);
+	auto const& function = m_sharedFunctions->functions.at(_name);
+	for (string const& dependency: function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			solAssert(m_sharedFunctions->functions.count(dependency), "Shared function depends on unshared function.");
+			addSharedFunction(dependency);
+		}
+	add(_name, function.code, function.dependencies);
+}
+
+void MultiUseYulFunctionCollector::add(string const& _name, string _code, vector<string> const& _dependencies)
+{
+	vector<string> calledFunctions;
+	if (m_pruneUnusedFunctions)
+		for (string const& dependency: _dependencies)
+			// This can also find calls of functions whose names end in the name of the dependency,
+			// which only keeps the dependency.
+			if (_code.find(dependency + "(") != string::npos)
+				calledFunctions.push_back(dependency);
+	m_functions.push_back({_name, move(_code), move(calledFunctions)});
+}
+
+string MultiUseYulFunctionCollector::render(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	vector<string> arguments;
+	vector<string> returnParameters;
+	string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
+
+	return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
 		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
-	}
-	return _name;
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
 }
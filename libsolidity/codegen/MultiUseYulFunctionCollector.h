@@ -24,12 +24,31 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Functions generated by the collectors of all contracts of a compilation, which are taken from
+ * here instead of being generated again. Since the names of the utility functions encode the
+ * types and parameters they depend on, functions with the same name have the same code.
+ */
+struct SharedYulFunctions
+{
+	struct Function
+	{
+		/// The names of the functions requested while generating the function, in the order of
+		/// the requests. These are added before the function if they are not present yet.
+		std::vector<std::string> dependencies;
+		std::string code;
+	};
+	std::map<std::string, Function> functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,6 +56,23 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	/// Sets the functions to share with other collectors. Must be set before any function is created.
+	void setSharedFunctions(std::shared_ptr<SharedYulFunctions> _sharedFunctions)
+	{
+		m_sharedFunctions = std::move(_sharedFunctions);
+	}
+
+	/// If @a _prune is true, requestedFunctions() only returns the functions that are called by
+	/// functions requested outside of the creation of other functions, directly or indirectly.
+	/// Functions can be requested without being called, e.g. by code templates that only use
+	/// them under a condition.
+	void setPruneUnusedFunctions(bool _prune) { m_pruneUnusedFunctions = _prune; }
+
+	/// If @a _copy is true, the ABI decoders copy arrays and structs of values that are not validated
+	/// from calldata to memory with a single calldatacopy (see ABIFunctions).
+	void setCopyCalldataInABIDecoder(bool _copy) { m_copyCalldataInABIDecoder = _copy; }
+	bool copyCalldataInABIDecoder() const { return m_copyCalldataInABIDecoder; }
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -47,8 +83,16 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Same as createFunction, but for functions whose code depends on the contract they are
+	/// generated for, which are not shared with other collectors.
+	std::string createContractFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	std::string createContractFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
-	/// generated.
+	/// generated, without the unused ones if they are pruned.
 	/// Clears the internal list, i.e. calling it again will result in an
 	/// empty return value.
 	std::string requestedFunctions();
@@ -57,8 +101,38 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// Adds the function @a _name with the code returned by @a _generate, unless it is present already.
+	/// The function is taken from or added to the shared functions if @a _shared is true.
+	std::string create(std::string const& _name, bool _shared, std::function<std::string()> const& _generate);
+	/// Adds the shared function @a _name and its dependencies that are not present yet.
+	void addSharedFunction(std::string const& _name);
+	/// Adds the function @a _name with the code @a _code, which was generated while requesting
+	/// the functions @a _dependencies.
+	void add(std::string const& _name, std::string _code, std::vector<std::string> const& _dependencies);
+
+	static std::string render(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
+	struct Function
+	{
+		std::string name;
+		std::string code;
+		/// The requested functions that are called by the code.
+		std::vector<std::string> calledFunctions;
+	};
+
 	std::set<std::string> m_requestedFunctions;
-	std::string m_code;
+	/// The generated functions in the order in which they were generated.
+	std::vector<Function> m_functions;
+	/// The functions requested outside of the creation of other functions.
+	std::set<std::string> m_rootFunctions;
+	bool m_pruneUnusedFunctions = false;
+	bool m_copyCalldataInABIDecoder = false;
+	std::shared_ptr<SharedYulFunctions> m_sharedFunctions;
+	/// The dependencies of the functions that are being generated, the innermost one last.
+	std::vector<std::vector<std::string>> m_dependencies;
 };
 
 }
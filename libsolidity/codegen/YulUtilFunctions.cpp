@@ -2826,6 +2826,40 @@ string YulUtilFunctions::updateStorageValueFunction(
 	});
 }
 
+string YulUtilFunctions::updateStorageValuesFunction(vector<pair<Type const*, unsigned>> const& _members)
+{
+	solAssert(!_members.empty());
+	string functionName = "update_storage_values";
+	for (auto const& [type, offset]: _members)
+		functionName += "_offset_" + to_string(offset) + "_" + type->identifier();
+
+	return m_functionCollector.createFunction(functionName, [&] {
+		vector<map<string, string>> members;
+		for (auto const& [type, offset]: _members)
+		{
+			solAssert(type->isValueType() && type->sizeOnStack() == 1, "");
+			solAssert(offset + type->storageBytes() <= 32, "Invalid storage offset.");
+			members.emplace_back(map<string, string>{
+				{"value", "value_" + to_string(members.size())},
+				{"update", updateByteSliceFunction(type->storageBytes(), offset)},
+				{"prepare", prepareStoreFunction(*type)}
+			});
+		}
+		return Whiskers(R"(
+			function <functionName>(slot<#members>, <value></members>) {
+				let slotValue := sload(slot)
+				<#members>
+				slotValue := <update>(slotValue, <prepare>(<value>))
+				</members>
+				sstore(slot, slotValue)
+			}
+		)")
+		("functionName", functionName)
+		("members", members)
+		.render();
+	});
+}
+
 string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 {
 	string const functionName = "write_to_memory_" + _type.identifier();
@@ -358,6 +358,13 @@ public:
 		std::optional<unsigned> const& _offset = std::optional<unsigned>()
 	);
 
+	/// Returns the name of a function that writes the given values to the value type members
+	/// @a _members, given by their types and offsets, of the same storage slot with a single
+	/// sload and sstore. Later members overwrite earlier ones at the same offset.
+	/// The values are expected to be converted to the types of the members already.
+	/// signature: (slot, value_0, ..., value_n)
+	std::string updateStorageValuesFunction(std::vector<std::pair<Type const*, unsigned>> const& _members);
+
 	/// Returns the name of a function that will write the given value to
 	/// the specified address.
 	/// Performs a cleanup before writing for value types.
@@ -157,6 +157,7 @@ public:
 	ABIFunctions abiFunctions();
 
 	RevertStrings revertStrings() const { return m_revertStrings; }
+	OptimiserSettings const& optimiserSettings() const { return m_optimiserSettings; }
 
 	std::set<ContractDefinition const*, ASTNode::CompareByID>& subObjectsCreated() { return m_subObjects; }
 
@@ -31,7 +31,10 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/OptimizedObjectCache.h>
 #include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
@@ -52,6 +55,14 @@ using namespace solidity::util;
 namespace
 {
 
+string const experimentalWarning =
+	"/*=====================================================*\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *=====================================================*/\n\n";
+
 void verifyCallGraph(
 	set<CallableDeclaration const*, ASTNode::CompareByID> const& _expectedCallables,
 	set<FunctionDefinition const*> _generatedFunctions
@@ -85,15 +96,83 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+/// Inserts copies of the objects of @a _contracts taken from @a _objects into the sub-objects
+/// of @a _object before position @a _position.
+void insertSubObjects(
+	yul::Object& _object,
+	size_t _position,
+	set<ContractDefinition const*, ASTNode::CompareByID> const& _contracts,
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> const& _objects
+)
+{
+	solAssert(_position <= _object.subObjects.size(), "");
+	vector<shared_ptr<yul::ObjectNode>> subObjects;
+	for (ContractDefinition const* contract: _contracts)
+		subObjects.emplace_back(yul::OptimizedObjectCache::copy(*_objects.at(contract)));
+	_object.subObjects.insert(
+		_object.subObjects.begin() + static_cast<ptrdiff_t>(_position),
+		subObjects.begin(),
+		subObjects.end()
+	);
+	_object.subIndexByName.clear();
+	for (size_t i = 0; i < _object.subObjects.size(); ++i)
+		_object.subIndexByName[_object.subObjects[i]->name] = i;
+}
+
+/// @returns code that selects the case of @a _cases in [@a _begin, @a _end) whose selector
+/// equals the variable ``selector`` by a binary search over the sorted selectors, falling
+/// through if there is none. The remaining cases are compared one by one once there are
+/// at most four of them, since a split is not cheaper for fewer functions.
+string selectorSearch(vector<map<string, string>> const& _cases, size_t _begin, size_t _end)
+{
+	if (_end - _begin <= 4)
+	{
+		string code = "switch selector\n";
+		for (size_t i = _begin; i < _end; ++i)
+			code += Whiskers(R"(
+				case <functionSelector>
+				{
+					// <functionName>
+					<delegatecallCheck>
+					<externalFunction>()
+				}
+			)")
+			("functionSelector", _cases[i].at("functionSelector"))
+			("functionName", _cases[i].at("functionName"))
+			("delegatecallCheck", _cases[i].at("delegatecallCheck"))
+			("externalFunction", _cases[i].at("externalFunction"))
+			.render();
+		return code + "default {}\n";
+	}
+
+	size_t pivot = _begin + (_end - _begin) / 2;
+	return Whiskers(R"(
+		switch lt(selector, <pivot>)
+		case 0 {
+			<larger>
+		}
+		default {
+			<smaller>
+		}
+	)")
+	("pivot", _cases[pivot].at("functionSelector"))
+	("larger", selectorSearch(_cases, pivot, _end))
+	("smaller", selectorSearch(_cases, _begin, pivot))
+	.render();
+}
+
 }
 
-pair<string, string> IRGenerator::run(
+tuple<string, shared_ptr<yul::Object const>, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> const& _otherYulObjects,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	bool _printCode
 )
 {
-	string const ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	Code code = generate(_contract, _cborMetadata, _printCode ? &_otherYulSources : nullptr);
+	string const ir = yul::reindent(code.code);
 
 	yul::AssemblyStack asmStack(
 		m_evmVersion,
@@ -101,7 +180,24 @@ pair<string, string> IRGenerator::run(
 		m_optimiserSettings,
 		m_context.debugInfoSelection()
 	);
-	if (!asmStack.parseAndAnalyze("", ir))
+	asmStack.setOptimizedObjectCache(m_optimizedObjectCache);
+	asmStack.setPreoptimizedFunctions(move(code.libraryFunctions));
+	shared_ptr<yul::Object> object = asmStack.parse("", ir);
+	if (object)
+	{
+		// The objects of the created contracts are not parsed again but copied from the results
+		// of their own compilation. They are placed where their code would be, that is, after the
+		// deployed object in the creation object and before the metadata in the deployed object.
+		string deployedName = IRNames::deployedObject(_contract);
+		solAssert(object->subIndexByName.count(yul::YulString(deployedName)), "");
+		auto* deployedObject = dynamic_cast<yul::Object*>(
+			object->subObjects.at(object->subIndexByName.at(yul::YulString(deployedName))).get()
+		);
+		solAssert(deployedObject && !deployedObject->subObjects.empty(), "");
+		insertSubObjects(*deployedObject, deployedObject->subObjects.size() - 1, code.deployedSubObjects, _otherYulObjects);
+		insertSubObjects(*object, object->subObjects.size(), code.creationSubObjects, _otherYulObjects);
+	}
+	if (!object || !asmStack.analyze())
 	{
 		string errorMessage;
 		for (auto const& error: asmStack.errors())
@@ -111,32 +207,39 @@ pair<string, string> IRGenerator::run(
 			);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	// The optimizer modifies the object, so the unoptimized object is copied first.
+	shared_ptr<yul::Object const> unoptimized = yul::OptimizedObjectCache::copy(*object);
 	asmStack.optimize();
+	// The analysis succeeded, so the only errors are the warnings of the optimizer.
+	m_optimiserWarnings = asmStack.errors();
 
-	string warning =
-		"/*=====================================================*\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *=====================================================*/\n\n";
+	string printed = _printCode ? experimentalWarning + yul::reindent(code.fullCode) : string{};
+	return {move(printed), move(unoptimized), asmStack.parserResult()};
+}
 
-	return {warning + ir, warning + asmStack.print(m_context.soliditySourceProvider())};
+string IRGenerator::printOptimized(yul::Object const& _object) const
+{
+	return experimentalWarning + _object.toString(
+		&yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion),
+		m_context.debugInfoSelection(),
+		m_context.soliditySourceProvider()
+	) + "\n";
 }
 
-string IRGenerator::generate(
+IRGenerator::Code IRGenerator::generate(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const* _otherYulSources
 )
 {
 	auto subObjectSources = [&_otherYulSources](std::set<ContractDefinition const*, ASTNode::CompareByID> const& subObjects) -> string
 	{
 		std::string subObjectsSources;
 		for (ContractDefinition const* subObject: subObjects)
-			subObjectsSources += _otherYulSources.at(subObject);
+			subObjectsSources += _otherYulSources->at(subObject);
 		return subObjectsSources;
 	};
+	Code result;
 	auto formatUseSrcMap = [](IRGenerationContext const& _context) -> string
 	{
 		return joinHumanReadable(
@@ -210,7 +313,7 @@ string IRGenerator::generate(
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions(_contract);
 
 	t("functions", m_context.functionCollector().requestedFunctions());
-	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	result.creationSubObjects = m_context.subObjectsCreated();
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesAssembly = m_context.inlineAssemblySeen();
@@ -232,7 +335,7 @@ string IRGenerator::generate(
 	set<FunctionDefinition const*> deployedFunctionList = generateQueuedFunctions();
 	generateInternalDispatchFunctions(_contract);
 	t("deployedFunctions", m_context.functionCollector().requestedFunctions());
-	t("deployedSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	result.deployedSubObjects = m_context.subObjectsCreated();
 	t("metadataName", yul::Object::metadataName());
 	t("cborMetadata", toHex(_cborMetadata));
 
@@ -244,10 +347,21 @@ string IRGenerator::generate(
 
 	solAssert(_contract.annotation().creationCallGraph->get() != nullptr, "");
 	solAssert(_contract.annotation().deployedCallGraph->get() != nullptr, "");
+	if (m_optimiserSettings.preoptimizeLibraryFunctions)
+		for (auto const* functionList: {&creationFunctionList, &deployedFunctionList})
+			for (FunctionDefinition const* function: *functionList)
+				if (function->annotation().contract && function->annotation().contract->isLibrary())
+					result.libraryFunctions.insert(IRNames::function(*function));
 	verifyCallGraph(collectReachableCallables(**_contract.annotation().creationCallGraph), move(creationFunctionList));
 	verifyCallGraph(collectReachableCallables(**_contract.annotation().deployedCallGraph), move(deployedFunctionList));
 
-	return t.render();
+	if (_otherYulSources)
+		result.fullCode = Whiskers(t)
+			("subObjects", subObjectSources(result.creationSubObjects))
+			("deployedSubObjects", subObjectSources(result.deployedSubObjects))
+			.render();
+	result.code = t("subObjects", "")("deployedSubObjects", "").render();
+	return result;
 }
 
 string IRGenerator::generate(Block const& _block)
@@ -285,7 +399,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 	for (YulArity const& arity: internalDispatchMap | ranges::views::keys)
 	{
 		string funName = IRNames::internalDispatch(arity);
-		m_context.functionCollector().createFunction(funName, [&]() {
+		m_context.functionCollector().createContractFunction(funName, [&]() {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
@@ -342,7 +456,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::function(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -413,7 +527,7 @@ string IRGenerator::generateModifier(
 )
 {
 	string functionName = IRNames::modifierInvocation(_modifierInvocation);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -505,7 +619,7 @@ string IRGenerator::generateModifier(
 string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::functionWithModifierInner(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<sourceLocationComment>
@@ -545,7 +659,7 @@ string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const&
 string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 {
 	string functionName = IRNames::function(_varDecl);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractFunction(functionName, [&]() {
 		Type const* type = _varDecl.annotation().type;
 
 		solAssert(_varDecl.isStateVariable(), "");
@@ -738,7 +852,7 @@ string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 string IRGenerator::generateExternalFunction(ContractDefinition const& _contract, FunctionType const& _functionType)
 {
 	string functionName = IRNames::externalFunctionABIWrapper(_functionType.declaration());
-	return m_context.functionCollector().createFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
+	return m_context.functionCollector().createContractFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
 		Whiskers t(R"X(
 			<callValueCheck>
 			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
@@ -873,7 +987,7 @@ void IRGenerator::generateConstructors(ContractDefinition const& _contract)
 		baseConstructorParams.erase(contract);
 
 		m_context.resetLocalVariables();
-		m_context.functionCollector().createFunction(IRNames::constructor(*contract), [&]() {
+		m_context.functionCollector().createContractFunction(IRNames::constructor(*contract), [&]() {
 			Whiskers t(R"(
 				<astIDComment><sourceLocationComment>
 				function <functionName>(<params><comma><baseParams>) {
@@ -1008,7 +1122,7 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		<?+cases>if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
+			<?binarySearch><selectorSearch><!binarySearch>switch selector
 			<#cases>
 			case <functionSelector>
 			{
@@ -1017,7 +1131,7 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 				<externalFunction>()
 			}
 			</cases>
-			default {}
+			default {}</binarySearch>
 		}</+cases>
 		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
 		<fallback>
@@ -1047,6 +1161,10 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 
 		templ["externalFunction"] = generateExternalFunction(_contract, *type);
 	}
+	// The interface functions are sorted by their selectors.
+	bool binarySearch = m_optimiserSettings.binarySearchDispatch && functions.size() > 4;
+	t("binarySearch", binarySearch);
+	t("selectorSearch", binarySearch ? selectorSearch(functions, 0, functions.size()) : "");
 	t("cases", functions);
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
@@ -1126,6 +1244,9 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 	);
 	newContext.copyFunctionIDsFrom(m_context);
 	m_context = move(newContext);
+	m_context.functionCollector().setSharedFunctions(m_sharedFunctions);
+	m_context.functionCollector().setPruneUnusedFunctions(m_optimiserSettings.pruneUnusedFunctions);
+	m_context.functionCollector().setCopyCalldataInABIDecoder(m_optimiserSettings.copyCalldataInABIDecoder);
 
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
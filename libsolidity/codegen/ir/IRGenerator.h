@@ -31,8 +31,19 @@
 
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/Exceptions.h>
 
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Object;
+class OptimizedObjectCache;
+}
 
 namespace solidity::frontend
 {
@@ -66,19 +77,61 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates the IR of @a _contract, which includes the objects of the contracts it creates.
+	/// These are taken from @a _otherYulObjects, which have to be returned by run() as unoptimized
+	/// objects, and, for the code, from @a _otherYulSources.
+	/// @returns the IR code, which is only printed if @a _printCode is true, the unoptimized
+	/// Yul object of the code, which is not analyzed, and the analyzed Yul object of the code,
+	/// which is optimized depending on the optimizer settings.
+	std::tuple<std::string, std::shared_ptr<yul::Object const>, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::shared_ptr<yul::Object const>> const& _otherYulObjects,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		bool _printCode
 	);
 
+	/// Sets a cache of optimised objects, so that the objects of created contracts are only
+	/// optimised once for all contracts creating them.
+	void setOptimizedObjectCache(std::shared_ptr<yul::OptimizedObjectCache> _cache) { m_optimizedObjectCache = std::move(_cache); }
+
+	/// Sets the utility functions shared with the IR generators of other contracts, so that
+	/// the functions are only generated once for all contracts.
+	void setSharedFunctions(std::shared_ptr<SharedYulFunctions> _sharedFunctions)
+	{
+		m_sharedFunctions = std::move(_sharedFunctions);
+		m_context.functionCollector().setSharedFunctions(m_sharedFunctions);
+	}
+
+	/// @returns the optimized IR code printed from @a _object, which has to be returned by run()
+	/// and must not have been modified since.
+	std::string printOptimized(yul::Object const& _object) const;
+
+	/// @returns the warnings of the Yul optimizer in the last call to run(), e.g. about objects
+	/// whose optimization sequence was stopped because they exceeded the limits of the settings.
+	langutil::ErrorList const& optimiserWarnings() const { return m_optimiserWarnings; }
+
 private:
-	std::string generate(
+	/// The IR code of a contract and the contracts it creates.
+	struct Code
+	{
+		/// The code without the objects of the created contracts.
+		std::string code;
+		/// The code including the code of the created contracts, if requested.
+		std::string fullCode;
+		/// The contracts created by the creation code and by the deployed code.
+		std::set<ContractDefinition const*, ASTNode::CompareByID> creationSubObjects;
+		std::set<ContractDefinition const*, ASTNode::CompareByID> deployedSubObjects;
+		/// The names of the internal library functions in the code, if they are pre-optimised.
+		std::set<std::string> libraryFunctions;
+	};
+
+	/// Generates the IR code of @a _contract, including the code of the created contracts
+	/// from @a _otherYulSources if it is given.
+	Code generate(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const* _otherYulSources
 	);
 	std::string generate(Block const& _block);
 
@@ -142,6 +195,9 @@ private:
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
+	std::shared_ptr<SharedYulFunctions> m_sharedFunctions;
+	langutil::ErrorList m_optimiserWarnings;
 };
 
 }
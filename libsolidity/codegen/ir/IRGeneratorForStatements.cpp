@@ -215,6 +215,95 @@ private:
 	ExternalRefsMap const& m_references;
 };
 
+/**
+ * Checks that an expression only consists of literals, local variables of value type and
+ * operators that do not modify them, so that it can be evaluated before or after writes
+ * to storage without changing its value.
+ */
+class StorageIndependentExpression: private ASTConstVisitor
+{
+public:
+	static bool check(Expression const& _expression)
+	{
+		StorageIndependentExpression checker;
+		_expression.accept(checker);
+		return checker.m_independent;
+	}
+
+private:
+	bool visit(Literal const&) override { return true; }
+	bool visit(Identifier const& _identifier) override
+	{
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration);
+		if (!variable || !variable->isLocalVariable() || !variable->type()->isValueType())
+			m_independent = false;
+		return false;
+	}
+	bool visit(UnaryOperation const& _operation) override
+	{
+		if (TokenTraits::isCountOp(_operation.getOperator()) || _operation.getOperator() == Token::Delete)
+			m_independent = false;
+		return m_independent;
+	}
+	bool visit(BinaryOperation const&) override { return true; }
+	bool visit(Conditional const&) override { return true; }
+	bool visit(TupleExpression const& _tuple) override
+	{
+		if (_tuple.isInlineArray())
+			m_independent = false;
+		return m_independent;
+	}
+	bool visitNode(ASTNode const&) override
+	{
+		m_independent = false;
+		return false;
+	}
+
+	bool m_independent = true;
+};
+
+/// An assignment statement to a value type member of a storage struct that shares its slot
+/// with other members.
+struct PackedStorageWrite
+{
+	Assignment const* assignment = nullptr;
+	/// The variable that refers to the struct.
+	VariableDeclaration const* base = nullptr;
+	/// The slot of the member relative to the slot of the struct.
+	u256 slot;
+};
+
+/// @returns the write to a packed storage member performed by @a _statement, if it is a plain
+/// assignment to a member of a state variable or local storage pointer of struct type whose
+/// right hand side does not depend on storage.
+optional<PackedStorageWrite> packedStorageWrite(Statement const& _statement)
+{
+	auto const* statement = dynamic_cast<ExpressionStatement const*>(&_statement);
+	if (!statement)
+		return nullopt;
+	auto const* assignment = dynamic_cast<Assignment const*>(&statement->expression());
+	if (!assignment || assignment->assignmentOperator() != Token::Assign)
+		return nullopt;
+	auto const* memberAccess = dynamic_cast<MemberAccess const*>(&assignment->leftHandSide());
+	if (!memberAccess)
+		return nullopt;
+	auto const* structType = dynamic_cast<StructType const*>(memberAccess->expression().annotation().type);
+	auto const* identifier = dynamic_cast<Identifier const*>(&memberAccess->expression());
+	if (!structType || structType->location() != DataLocation::Storage || !identifier)
+		return nullopt;
+	auto const* base = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+	Type const& memberType = *memberAccess->annotation().type;
+	if (
+		!base ||
+		!memberType.isValueType() ||
+		memberType.sizeOnStack() != 1 ||
+		memberType.storageBytes() >= 32 ||
+		!StorageIndependentExpression::check(assignment->rightHandSide())
+	)
+		return nullopt;
+	return PackedStorageWrite{assignment, base, structType->storageOffsetsOfMember(memberAccess->memberName()).first};
+}
+
 }
 
 string IRGeneratorForStatementsBase::code() const
@@ -344,7 +433,7 @@ string IRGeneratorForStatements::constantValueFunction(VariableDeclaration const
 	try
 	{
 		string functionName = IRNames::constantValueFunction(_constant);
-		return m_context.functionCollector().createFunction(functionName, [&] {
+		return m_context.functionCollector().createContractFunction(functionName, [&] {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>() -> <ret> {
@@ -571,7 +660,33 @@ bool IRGeneratorForStatements::visit(Block const& _block)
 		solAssert(m_context.arithmetic() == Arithmetic::Checked);
 		m_context.setArithmetic(Arithmetic::Wrapping);
 	}
-	return true;
+	if (!m_context.optimiserSettings().coalesceStorageWrites)
+		return true;
+
+	auto const& statements = _block.statements();
+	for (size_t i = 0; i < statements.size();)
+	{
+		vector<Assignment const*> writes;
+		if (optional<PackedStorageWrite> first = packedStorageWrite(*statements[i]))
+		{
+			writes.emplace_back(first->assignment);
+			for (size_t j = i + 1; j < statements.size(); ++j)
+			{
+				optional<PackedStorageWrite> next = packedStorageWrite(*statements[j]);
+				if (!next || next->base != first->base || next->slot != first->slot)
+					break;
+				writes.emplace_back(next->assignment);
+			}
+		}
+		if (writes.size() > 1)
+		{
+			writePackedStorageMembers(writes);
+			i += writes.size();
+		}
+		else
+			statements[i++]->accept(*this);
+	}
+	return false;
 }
 
 void IRGeneratorForStatements::endVisit(Block const& _block)
@@ -884,6 +999,38 @@ bool IRGeneratorForStatements::visit(BinaryOperation const& _binOp)
 	return false;
 }
 
+bool IRGeneratorForStatements::visit(FunctionCall const& _functionCall)
+{
+	if (
+		!m_context.optimiserSettings().hashInputInScratchMemory ||
+		*_functionCall.annotation().kind != FunctionCallKind::FunctionCall ||
+		_functionCall.arguments().size() != 1
+	)
+		return true;
+
+	auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+	auto const* argument = dynamic_cast<FunctionCall const*>(_functionCall.arguments().front().get());
+	if (!functionType || functionType->kind() != FunctionType::Kind::KECCAK256 || !argument)
+		return true;
+	// The memory of the encoded arguments is not needed after hashing, since keccak256
+	// is applied to it directly after encoding.
+	if (auto const* argumentType = dynamic_cast<FunctionType const*>(argument->expression().annotation().type))
+		switch (argumentType->kind())
+		{
+		case FunctionType::Kind::ABIEncode:
+		case FunctionType::Kind::ABIEncodePacked:
+		case FunctionType::Kind::ABIEncodeWithSelector:
+		case FunctionType::Kind::ABIEncodeCall:
+		case FunctionType::Kind::ABIEncodeWithSignature:
+			if (*argument->annotation().kind == FunctionCallKind::FunctionCall)
+				m_temporaryEncodings.insert(argument);
+			break;
+		default:
+			break;
+		}
+	return true;
+}
+
 void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 {
 	setLocation(_functionCall);
@@ -1223,7 +1370,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			</+selector>
 			let <mend> := <encode>(<memPtr><arguments>)
 			mstore(<data>, sub(<mend>, add(<data>, 0x20)))
-			<finalizeAllocation>(<data>, sub(<mend>, <data>))
+			<?allocate><finalizeAllocation>(<data>, sub(<mend>, <data>))</allocate>
 		)");
 		templ("data", IRVariable(_functionCall).part("mpos").name());
 		templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
@@ -1236,7 +1383,9 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 			m_context.abiFunctions().tupleEncoder(argumentTypes, targetTypes, false)
 		);
 		templ("arguments", joinHumanReadablePrefixed(argumentVars));
-		templ("finalizeAllocation", m_utils.finalizeAllocationFunction());
+		bool const allocate = !m_temporaryEncodings.count(&_functionCall);
+		templ("allocate", allocate);
+		templ("finalizeAllocation", allocate ? m_utils.finalizeAllocationFunction() : "");
 
 		appendCode() << templ.render();
 		break;
@@ -2164,12 +2313,34 @@ void IRGeneratorForStatements::endVisit(IndexAccess const& _indexAccess)
 		Type const& keyType = *_indexAccess.indexExpression()->annotation().type;
 
 		string slot = m_context.newYulVariable();
-		Whiskers templ("let <slot> := <indexAccess>(<base><?+key>,<key></+key>)\n");
-		templ("slot", slot);
-		templ("indexAccess", m_utils.mappingIndexAccessFunction(mappingType, keyType));
-		templ("base", IRVariable(_indexAccess.baseExpression()).commaSeparatedList());
-		templ("key", IRVariable(*_indexAccess.indexExpression()).commaSeparatedList());
-		appendCode() << templ.render();
+		auto const* constantKey = dynamic_cast<RationalNumberType const*>(&keyType);
+		optional<u256> baseSlot;
+		if (
+			m_context.optimiserSettings().precomputeMappingSlots &&
+			constantKey &&
+			!constantKey->isFractional() &&
+			mappingType.keyType()->category() == Type::Category::Integer
+		)
+			baseSlot = constantMappingSlot(_indexAccess.baseExpression());
+		if (baseSlot)
+		{
+			// Computes keccak256(key . slot) of the key converted to the key type of the mapping.
+			u256 dataSlot(keccak256(
+				toBigEndian(constantKey->literalValue(nullptr)) +
+				toBigEndian(*baseSlot)
+			));
+			m_constantMappingSlots[&_indexAccess] = dataSlot;
+			appendCode() << "let " << slot << " := " << formatNumber(dataSlot) << "\n";
+		}
+		else
+		{
+			Whiskers templ("let <slot> := <indexAccess>(<base><?+key>,<key></+key>)\n");
+			templ("slot", slot);
+			templ("indexAccess", m_utils.mappingIndexAccessFunction(mappingType, keyType));
+			templ("base", IRVariable(_indexAccess.baseExpression()).commaSeparatedList());
+			templ("key", IRVariable(*_indexAccess.indexExpression()).commaSeparatedList());
+			appendCode() << templ.render();
+		}
 		setLValue(_indexAccess, IRLValue{
 			*_indexAccess.annotation().type,
 			IRLValue::Storage{
@@ -3036,6 +3207,49 @@ void IRGeneratorForStatements::writeToLValue(IRLValue const& _lvalue, IRVariable
 	);
 }
 
+void IRGeneratorForStatements::writePackedStorageMembers(vector<Assignment const*> const& _assignments)
+{
+	vector<string> values;
+	vector<pair<Type const*, unsigned>> members;
+	for (Assignment const* assignment: _assignments)
+	{
+		assignment->rightHandSide().accept(*this);
+		setLocation(*assignment);
+		values.emplace_back(convert(assignment->rightHandSide(), type(*assignment)).name());
+
+		auto const& memberAccess = dynamic_cast<MemberAccess const&>(assignment->leftHandSide());
+		auto const& structType = dynamic_cast<StructType const&>(type(memberAccess.expression()));
+		members.emplace_back(&type(memberAccess), structType.storageOffsetsOfMember(memberAccess.memberName()).second);
+	}
+
+	// All members are in the same slot, so the slot only has to be computed once.
+	_assignments.front()->leftHandSide().accept(*this);
+	solAssert(m_currentLValue, "LValue not retrieved.");
+	auto const* storage = get_if<IRLValue::Storage>(&m_currentLValue->kind);
+	solAssert(storage);
+	setLocation(*_assignments.back());
+
+	appendCode() <<
+		m_utils.updateStorageValuesFunction(members) <<
+		"(" <<
+		storage->slot <<
+		joinHumanReadablePrefixed(values) <<
+		")\n";
+	m_currentLValue.reset();
+}
+
+optional<u256> IRGeneratorForStatements::constantMappingSlot(Expression const& _mapping) const
+{
+	if (auto const* indexAccess = dynamic_cast<IndexAccess const*>(&_mapping))
+		if (auto slot = m_constantMappingSlots.find(indexAccess); slot != m_constantMappingSlots.end())
+			return slot->second;
+	if (auto const* identifier = dynamic_cast<Identifier const*>(&_mapping))
+		if (auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration))
+			if (m_context.isStateVariable(*variable))
+				return m_context.storageLocationOfStateVariable(*variable).first;
+	return nullopt;
+}
+
 IRVariable IRGeneratorForStatements::readFromLValue(IRLValue const& _lvalue)
 {
 	IRVariable result{m_context.newYulVariable(), _lvalue.type};
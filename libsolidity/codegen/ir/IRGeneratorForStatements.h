@@ -26,6 +26,9 @@
 #include <libsolidity/codegen/ir/IRVariable.h>
 
 #include <functional>
+#include <map>
+#include <optional>
+#include <set>
 
 namespace solidity::frontend
 {
@@ -120,6 +123,7 @@ public:
 	void endVisit(Return const& _return) override;
 	bool visit(UnaryOperation const& _unaryOperation) override;
 	bool visit(BinaryOperation const& _binOp) override;
+	bool visit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCall const& _funCall) override;
 	void endVisit(FunctionCallOptions const& _funCallOptions) override;
 	bool visit(MemberAccess const& _memberAccess) override;
@@ -224,6 +228,14 @@ private:
 
 	/// Assigns the value of @a _value to the lvalue @a _lvalue.
 	void writeToLValue(IRLValue const& _lvalue, IRVariable const& _value);
+	/// Generates code for the assignment statements @a _assignments to members of a storage struct
+	/// that share a slot, which writes the slot only once after evaluating all right hand sides.
+	/// The right hand sides must neither have side effects nor read from storage.
+	void writePackedStorageMembers(std::vector<Assignment const*> const& _assignments);
+
+	/// @returns the slot of the mapping @a _mapping if it is known at compile time, i.e. if it is
+	/// a state variable or an access with a constant key to such a mapping.
+	std::optional<u256> constantMappingSlot(Expression const& _mapping) const;
 	/// @returns a fresh IR variable containing the value of the lvalue @a _lvalue.
 	IRVariable readFromLValue(IRLValue const& _lvalue);
 
@@ -245,6 +257,11 @@ private:
 	std::function<std::string()> m_placeholderCallback;
 	YulUtilFunctions& m_utils;
 	std::optional<IRLValue> m_currentLValue;
+	/// Calls to the ABI encoding functions whose result is only hashed, which encode at the
+	/// free memory pointer without allocating the memory.
+	std::set<FunctionCall const*> m_temporaryEncodings;
+	/// The slots of the accesses to mappings that are computed at compile time.
+	std::map<IndexAccess const*, u256> m_constantMappingSlots;
 };
 
 }
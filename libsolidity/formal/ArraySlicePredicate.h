@@ -56,7 +56,8 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Like the predicates, the slice data is kept per thread.
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
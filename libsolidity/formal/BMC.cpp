@@ -25,10 +25,15 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/Parallel.h>
+
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
 #endif
 
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -41,11 +46,31 @@ BMC::BMC(
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism,
+	smt::QueryCache* _queryCache,
+	smt::TimeBudget* _timeBudget,
+	smt::Statistics* _statistics
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_settings.timeout,
+		_settings.raceSolvers
+	)),
+	m_parallelism(_parallelism),
+	m_solverProcessesCallback(_settings.solverProcesses ? _smtCallback : ReadCallback::Callback{}),
+	m_queryCache(_queryCache),
+	m_timeBudget(_timeBudget),
+	m_statistics(_statistics)
 {
+	m_checkSeparately =
+		(m_parallelism > 1 || (m_timeBudget && m_timeBudget->active())) &&
+		(!m_settings.solvers.smtlib2 || m_solverProcessesCallback) &&
+		m_interface->solvers() > 0;
+
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -78,13 +103,16 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	SMTEncoder::resetSourceAnalysis();
 
 	m_solvedTargets = move(_solvedTargets);
-	m_context.setSolver(m_interface.get());
+	m_context.setSolver(m_interface.get(), m_checkSeparately || m_queryCache);
+	m_declarationSorts.clear();
+	m_declarationSortsCount = 0;
 	m_context.reset();
 	m_context.setAssertionAccumulation(true);
 	m_variableUsage.setFunctionInlining(shouldInlineFunctionCall);
 	createFreeConstants(sourceDependencies(_source));
 	state().prepareForSourceUnit(_source);
 	m_unprovedAmt = 0;
+	m_skippedAmt = 0;
 
 	_source.accept(*this);
 
@@ -100,6 +128,16 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 			" Consider increasing the timeout per query."
 		);
 
+	if (m_skippedAmt > 0 && !m_settings.showUnproved)
+		m_errorReporter.warning(
+			6153_error,
+			{},
+			"BMC: " +
+			to_string(m_skippedAmt) +
+			" verification condition(s) were not checked because the time budget of the model checker was used up." +
+			" Enable the model checker option \"show unproved\" to see all of them."
+		);
+
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver, if enabled.
@@ -148,8 +186,16 @@ bool BMC::shouldInlineFunctionCall(
 
 bool BMC::visit(ContractDefinition const& _contract)
 {
+	if (m_timeBudget)
+		m_timeBudget->startContract();
+
 	initContract(_contract);
 
+	// The functions of a contract are encoded independently of each other, so the conditions
+	// of all its functions are collected and checked together in endVisit.
+	if (m_checkSeparately)
+		m_pendingConditions.emplace();
+
 	SMTEncoder::visit(_contract);
 
 	return false;
@@ -170,7 +216,17 @@ void BMC::endVisit(ContractDefinition const& _contract)
 		m_verificationTargets.clear();
 	}
 
+	if (m_pendingConditions)
+	{
+		vector<Condition> conditions = move(*m_pendingConditions);
+		m_pendingConditions.reset();
+		checkConditionsSeparately(conditions);
+	}
+
 	SMTEncoder::endVisit(_contract);
+
+	if (m_timeBudget)
+		m_timeBudget->endContract();
 }
 
 bool BMC::visit(FunctionDefinition const& _function)
@@ -703,6 +759,16 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	if (!m_checkSeparately)
+	{
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		return;
+	}
+
+	// The conditions are only collected here and checked at the end of the contract,
+	// where they are reported in the order of the targets.
+	solAssert(m_pendingConditions, "");
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
 }
@@ -769,6 +835,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		VerificationTargetType::Underflow,
 		_target.constraints && _target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -802,6 +869,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		VerificationTargetType::Overflow,
 		_target.constraints && _target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -825,6 +893,7 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		VerificationTargetType::DivByZero,
 		_target.constraints && (_target.value == 0),
 		_target.callStack,
 		_target.modelExpressions,
@@ -841,6 +910,7 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
+		VerificationTargetType::Balance,
 		_target.constraints && _target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -863,6 +933,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		VerificationTargetType::Assert,
 		_target.constraints && !_target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -901,6 +972,7 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
+	VerificationTargetType _type,
 	smtutil::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
@@ -912,65 +984,100 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	vector<smtutil::Expression> expressionsToEvaluate;
-	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
-		if (_additionalValue)
-		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
-		}
-	smtutil::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
-
-	string extraComment = SMTEncoder::extraComment();
+	Condition condition{
+		_type,
+		move(_condition),
+		_callStack,
+		_modelExpressions.first,
+		_modelExpressions.second,
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		_description,
+		SMTEncoder::extraComment()
+	};
 	if (m_loopExecutionHappened)
-		extraComment +=
+		condition.extraComment +=
 			"\nNote that some information is erased after the execution of loops.\n"
 			"You can re-introduce information using require().";
 	if (m_externalFunctionCallHappened)
-		extraComment +=
+		condition.extraComment +=
 			"\nNote that external function calls are not inlined,"
 			" even if the source code of the function is available."
 			" This is due to the possibility that the actual called contract"
 			" has the same ABI but implements the function differently.";
+	if (_callStack.size())
+		if (_additionalValue)
+		{
+			condition.expressionsToEvaluate.emplace_back(*_additionalValue);
+			condition.expressionNames.push_back(_additionalValueName);
+		}
+	// The model is not evaluated if it would not be reported anyway.
+	if (counterexampleLimitReached())
+	{
+		condition.expressionsToEvaluate.clear();
+		condition.expressionNames.clear();
+	}
 
+	if (m_pendingConditions)
+	{
+		m_pendingConditions->emplace_back(move(condition));
+		return;
+	}
+
+	if (timeBudgetExhausted())
+	{
+		reportSkippedCondition(condition);
+		return;
+	}
+
+	optional<smt::Statistics::Target> statistics;
+	if (m_statistics)
+		statistics = targetStatistics(condition);
+	auto [result, values] = checkSatisfiableAndGenerateModel(
+		condition.condition,
+		condition.expressionsToEvaluate,
+		statistics ? &*statistics : nullptr
+	);
+	if (statistics)
+		m_statistics->add(move(*statistics), result, m_settings.timeout);
+	reportCondition(condition, result, values);
+}
+
+void BMC::reportCondition(Condition const& _condition, smtutil::CheckResult _result, vector<string> const& _values)
+{
 	SecondarySourceLocation secondaryLocation{};
-	secondaryLocation.append(extraComment, SourceLocation{});
+	secondaryLocation.append(_condition.extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_condition.callStack.empty(), "");
 		std::ostringstream message;
-		message << "BMC: " << _description << " happens here.";
+		message << "BMC: " << _condition.description << " happens here.";
 
 		std::ostringstream modelMessage;
 		// Sometimes models have complex smtlib2 expressions that SMTLib2Interface fails to parse.
-		if (values.size() == expressionNames.size())
+		if (!counterexampleLimitReached() && _values.size() == _condition.expressionNames.size())
 		{
+			++m_counterexampleAmt;
 			modelMessage << "Counterexample:\n";
 			map<string, string> sortedModel;
-			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+			for (size_t i = 0; i < _values.size(); ++i)
+				if (_condition.expressionsToEvaluate.at(i).name != _values.at(i))
+					sortedModel[_condition.expressionNames.at(i)] = _values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 		}
 
 		m_errorReporter.warning(
-			_errorHappens,
-			_location,
+			_condition.errorHappens,
+			_condition.location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(_condition.callStack))
 			.append(move(secondaryLocation))
 		);
 		break;
@@ -981,18 +1088,59 @@ void BMC::checkCondition(
 	{
 		++m_unprovedAmt;
 		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+			m_errorReporter.warning(_condition.errorMightHappen, _condition.location, "BMC: " + _condition.description + " might happen here.", secondaryLocation);
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _condition.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _condition.location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
+}
+
+void BMC::reportSkippedCondition(Condition const& _condition)
+{
+	++m_skippedAmt;
+	if (m_statistics)
+		m_statistics->addSkipped(targetStatistics(_condition));
+	if (m_settings.showUnproved)
+		m_errorReporter.warning(
+			2515_error,
+			_condition.location,
+			"BMC: " + _condition.description + " was not checked because the time budget of the model checker was used up."
+		);
+}
+
+smt::Statistics::Target BMC::targetStatistics(Condition const& _condition) const
+{
+	return smt::Statistics::target(
+		"bmc",
+		_condition.type,
+		_condition.location,
+		smt::TimeBudget::querySize({_condition.condition})
+	);
+}
+
+namespace
+{
+
+/// @returns the result of checking that a condition is not constant, where the checks of
+/// the condition being true and false have the results @a _positive and @a _negated.
+/// The condition is safe if it can be both true and false.
+smtutil::CheckResult constantConditionResult(smtutil::CheckResult _positive, smtutil::CheckResult _negated)
+{
+	for (auto result: {smtutil::CheckResult::ERROR, smtutil::CheckResult::CONFLICTING})
+		if (_positive == result || _negated == result)
+			return result;
+	if (_positive == smtutil::CheckResult::SATISFIABLE && _negated == smtutil::CheckResult::SATISFIABLE)
+		return smtutil::CheckResult::UNSATISFIABLE;
+	if (_positive == smtutil::CheckResult::UNKNOWN || _negated == smtutil::CheckResult::UNKNOWN)
+		return smtutil::CheckResult::UNKNOWN;
+	return smtutil::CheckResult::SATISFIABLE;
+}
 
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -1006,15 +1154,27 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
+	optional<smt::Statistics::Target> statistics;
+	if (m_statistics)
+		statistics = smt::Statistics::target(
+			"bmc",
+			VerificationTargetType::ConstantCondition,
+			_condition.location(),
+			smt::TimeBudget::querySize({_constraints, _value})
+		);
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	if (timeBudgetExhausted())
+	{
+		++m_skippedAmt;
+		if (statistics)
+			m_statistics->addSkipped(move(*statistics));
+		return;
+	}
+
+	auto positiveResult = checkSatisfiable(_constraints && _value, statistics ? &*statistics : nullptr);
+	auto negatedResult = checkSatisfiable(_constraints && !_value, statistics ? &*statistics : nullptr);
+	if (statistics)
+		m_statistics->add(move(*statistics), constantConditionResult(positiveResult, negatedResult), m_settings.timeout);
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
@@ -1053,21 +1213,29 @@ void BMC::checkBooleanNotConstant(
 	}
 }
 
-pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+namespace
+{
+
+/// Checks the assertions of @a _solver.
+/// @returns the result, the values of @a _expressionsToEvaluate in the model
+/// and the description of the error of the solver, if there was one.
+tuple<smtutil::CheckResult, vector<string>, optional<string>> querySolver(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
+	optional<string> error;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
-		string description("BMC: Error querying SMT solver");
+		error = "BMC: Error querying SMT solver";
 		if (_e.comment())
-			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
+			*error += ": " + *_e.comment();
 		result = smtutil::CheckResult::ERROR;
 	}
 
@@ -1081,12 +1249,152 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
+	return {result, move(values), move(error)};
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+/// Adds the names of the symbols in @a _expression, which include its variables, to @a _names.
+void collectNames(smtutil::Expression const& _expression, set<string>& _names)
+{
+	_names.insert(_expression.name);
+	for (smtutil::Expression const& argument: _expression.arguments)
+		collectNames(argument, _names);
+}
+
+}
+
+pair<smtutil::CheckResult, vector<string>> BMC::checkSatisfiableAndGenerateModel(
+	smtutil::Expression const& _condition,
+	vector<smtutil::Expression> const& _expressionsToEvaluate,
+	smt::Statistics::Target* _statistics
+)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	updateDeclarationSorts();
+	auto [result, values, error] = solveCached(_condition, _expressionsToEvaluate, [&]() {
+		m_interface->push();
+		m_interface->addAssertion(_condition);
+		auto result = smt::Statistics::measure(_statistics, [&]() { return querySolver(*m_interface, _expressionsToEvaluate); });
+		m_interface->pop();
+		return result;
+	});
+	if (error)
+		m_errorReporter.warning(8140_error, *error);
+	return make_pair(result, move(values));
+}
+
+smtutil::CheckResult BMC::checkSatisfiable(smtutil::Expression const& _condition, smt::Statistics::Target* _statistics)
+{
+	return checkSatisfiableAndGenerateModel(_condition, {}, _statistics).first;
+}
+
+void BMC::updateDeclarationSorts()
+{
+	auto const& declarations = m_context.declarations();
+	for (; m_declarationSortsCount < declarations.size(); ++m_declarationSortsCount)
+	{
+		auto const& [name, sort] = declarations[m_declarationSortsCount];
+		m_declarationSorts[name] = sort;
+	}
+}
+
+vector<pair<string, smtutil::SortPointer>> BMC::usedDeclarations(
+	smtutil::Expression const& _condition,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+) const
+{
+	set<string> names;
+	collectNames(_condition, names);
+	for (smtutil::Expression const& expression: _expressionsToEvaluate)
+		collectNames(expression, names);
+
+	vector<pair<string, smtutil::SortPointer>> declarations;
+	for (string const& name: names)
+		if (auto declaration = m_declarationSorts.find(name); declaration != m_declarationSorts.end())
+			declarations.emplace_back(name, declaration->second);
+	return declarations;
+}
+
+tuple<smtutil::CheckResult, vector<string>, optional<string>> BMC::solveCached(
+	smtutil::Expression const& _condition,
+	vector<smtutil::Expression> const& _expressionsToEvaluate,
+	function<tuple<smtutil::CheckResult, vector<string>, optional<string>>()> const& _solve
+) const
+{
+	if (!m_queryCache)
+		return _solve();
+
+	h256 key = smt::QueryCache::bmcKey(m_settings, usedDeclarations(_condition, _expressionsToEvaluate), _condition, _expressionsToEvaluate);
+	if (auto result = m_queryCache->lookupBMC(key))
+		return {result->first, move(result->second), nullopt};
+	auto result = _solve();
+	auto const& [checkResult, values, error] = result;
+	if (!error)
+		m_queryCache->storeBMC(m_settings, key, {checkResult, values});
+	return result;
+}
+
+void BMC::checkConditionsSeparately(vector<Condition> const& _conditions)
+{
+	updateDeclarationSorts();
+
+	// With a time budget, the smaller conditions are checked first, so that the time left
+	// by the conditions that are solved quickly goes to the harder ones.
+	vector<size_t> order(_conditions.size());
+	iota(order.begin(), order.end(), 0);
+	if (m_timeBudget && m_timeBudget->active())
+	{
+		vector<size_t> sizes = applyMap(_conditions, [](Condition const& _condition) {
+			return smt::TimeBudget::querySize({_condition.condition});
+		});
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) { return sizes[_a] < sizes[_b]; });
+	}
+
+	// Every condition is checked by a solver of its own that only knows the variables used
+	// in the condition, so that the results do not depend on the order or number of threads.
+	vector<optional<tuple<smtutil::CheckResult, vector<string>, optional<string>>>> results(_conditions.size());
+	vector<optional<unsigned>> timeouts(_conditions.size());
+	vector<smt::Statistics::Target> statistics;
+	if (m_statistics)
+		statistics = applyMap(_conditions, [&](Condition const& _condition) { return targetStatistics(_condition); });
+	util::parallelForEach(_conditions.size(), m_parallelism, [&](size_t _position) {
+		size_t index = order[_position];
+		if (timeBudgetExhausted())
+			return;
+		optional<unsigned> timeout = m_timeBudget ?
+			m_timeBudget->queryTimeout(_conditions.size() - _position, m_parallelism) :
+			m_settings.timeout;
+		timeouts[index] = timeout;
+		Condition const& condition = _conditions[index];
+		results[index] = solveCached(condition.condition, condition.expressionsToEvaluate, [&]() {
+			smtutil::SMTPortfolio solver(
+				{},
+				m_solverProcessesCallback,
+				m_settings.solvers,
+				timeout,
+				m_settings.raceSolvers
+			);
+			for (auto const& [name, sort]: usedDeclarations(condition.condition, condition.expressionsToEvaluate))
+				solver.declareVariable(name, sort);
+			solver.addAssertion(condition.condition);
+			return smt::Statistics::measure(m_statistics ? &statistics[index] : nullptr, [&]() {
+				return querySolver(solver, condition.expressionsToEvaluate);
+			});
+		});
+	});
+
+	for (size_t i = 0; i < _conditions.size(); ++i)
+	{
+		if (!results[i])
+		{
+			reportSkippedCondition(_conditions[i]);
+			continue;
+		}
+		auto const& [result, values, error] = *results[i];
+		if (error)
+			m_errorReporter.warning(8140_error, *error);
+		if (m_statistics)
+			m_statistics->add(move(statistics[i]), result, timeouts[i]);
+		reportCondition(_conditions[i], result, values);
+	}
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
@@ -30,14 +30,18 @@
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/QueryCache.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/Statistics.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -63,7 +67,11 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1,
+		smt::QueryCache* _queryCache = nullptr,
+		smt::TimeBudget* _timeBudget = nullptr,
+		smt::Statistics* _statistics = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -156,6 +164,7 @@ private:
 	//@{
 	/// Check that a condition can be satisfied.
 	void checkCondition(
+		VerificationTargetType _type,
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
@@ -174,14 +183,92 @@ private:
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
-	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Checks @a _condition in m_interface and evaluates @a _expressionsToEvaluate if it is satisfiable.
+	/// The query is counted into @a _statistics unless it is null.
+	std::pair<smtutil::CheckResult, std::vector<std::string>> checkSatisfiableAndGenerateModel(
+		smtutil::Expression const& _condition,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+		smt::Statistics::Target* _statistics = nullptr
+	);
+
+	smtutil::CheckResult checkSatisfiable(smtutil::Expression const& _condition, smt::Statistics::Target* _statistics = nullptr);
 
-	smtutil::CheckResult checkSatisfiable();
+	/// Adds the declarations of the encoding context that are not in m_declarationSorts yet.
+	void updateDeclarationSorts();
+	/// @returns the variables and functions used in @a _condition and @a _expressionsToEvaluate
+	/// together with their sorts, sorted by name.
+	std::vector<std::pair<std::string, smtutil::SortPointer>> usedDeclarations(
+		smtutil::Expression const& _condition,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	) const;
+	/// @returns the result of checking @a _condition from the query cache, or the result of
+	/// @a _solve, which is then stored in the cache unless the solver reported an error.
+	std::tuple<smtutil::CheckResult, std::vector<std::string>, std::optional<std::string>> solveCached(
+		smtutil::Expression const& _condition,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+		std::function<std::tuple<smtutil::CheckResult, std::vector<std::string>, std::optional<std::string>>()> const& _solve
+	) const;
+
+	/// A condition to be checked by checkCondition and the information needed to report the result.
+	struct Condition
+	{
+		VerificationTargetType type;
+		smtutil::Expression condition;
+		std::vector<CallStackEntry> callStack;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+		std::string description;
+		/// Notes about the encoding of the function the condition belongs to.
+		std::string extraComment;
+	};
+	void reportCondition(Condition const& _condition, smtutil::CheckResult _result, std::vector<std::string> const& _values);
+	/// Reports that @a _condition was not checked since the time budget is used up.
+	void reportSkippedCondition(Condition const& _condition);
+	/// @returns the entry of @a _condition in the statistics, without queries.
+	smt::Statistics::Target targetStatistics(Condition const& _condition) const;
+	/// @returns true if the time budget is used up.
+	bool timeBudgetExhausted() const { return m_timeBudget && m_timeBudget->exhausted(); }
+	/// @returns true if no more counterexamples are generated since the limit of the settings is reached.
+	bool counterexampleLimitReached() const
+	{
+		return m_settings.counterexampleLimit && m_counterexampleAmt >= *m_settings.counterexampleLimit;
+	}
+	/// Checks the conditions in separate solvers, in parallel and in the order of their size
+	/// if a time budget is set, and reports them in order.
+	void checkConditionsSeparately(std::vector<Condition> const& _conditions);
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
 
+	/// Parallel checking of verification targets.
+	//@{
+	/// Maximum number of threads used to check the verification targets of a contract.
+	size_t m_parallelism = 1;
+	/// Whether every verification target is checked in a solver of its own, which is needed to check
+	/// them in parallel or with timeouts derived from a time budget. This requires that SMT-LIB2 is
+	/// not used, since its queries have to reach the callback in order, unless they are answered
+	/// by solver processes.
+	bool m_checkSeparately = false;
+	/// The callback of the solver processes of the model checker, which can be called from any thread,
+	/// if they are requested in the settings.
+	frontend::ReadCallback::Callback m_solverProcessesCallback;
+	/// Set while the conditions of the verification targets of the functions of a contract are collected.
+	std::optional<std::vector<Condition>> m_pendingConditions;
+	/// The sort of the last declaration of every variable declared in m_interface,
+	/// taking into account the first m_declarationSortsCount declarations of the encoding context,
+	/// which are only recorded if the conditions are checked in parallel or the queries are cached.
+	std::map<std::string, smtutil::SortPointer> m_declarationSorts;
+	size_t m_declarationSortsCount = 0;
+	//@}
+
+	smt::QueryCache* m_queryCache = nullptr;
+	smt::TimeBudget* m_timeBudget = nullptr;
+	/// Collects the statistics of the targets, if requested in the settings.
+	smt::Statistics* m_statistics = nullptr;
+
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
 	bool m_externalFunctionCallHappened = false;
@@ -193,6 +280,10 @@ private:
 
 	/// Number of verification conditions that could not be proved.
 	size_t m_unprovedAmt = 0;
+	/// Number of verification conditions that were not checked since the time budget was used up.
+	size_t m_skippedAmt = 0;
+	/// Number of violated verification conditions reported with a counterexample.
+	size_t m_counterexampleAmt = 0;
 };
 
 }
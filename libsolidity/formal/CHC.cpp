@@ -33,6 +33,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
@@ -45,7 +46,9 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
 #include <charconv>
+#include <numeric>
 #include <queue>
 
 using namespace std;
@@ -60,11 +63,20 @@ CHC::CHC(
 	EncodingContext& _context,
 	UniqueErrorReporter& _errorReporter,
 	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
-	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
+	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism,
+	smt::QueryCache* _queryCache,
+	smt::TimeBudget* _timeBudget,
+	smt::Statistics* _statistics
 ):
-	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider)
+	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
+	m_parallelism(_parallelism),
+	m_solverProcessesCallback(_settings.solverProcesses ? _smtCallback : ReadCallback::Callback{}),
+	m_queryCache(_queryCache),
+	m_timeBudget(_timeBudget),
+	m_statistics(_statistics)
 {
 	bool usesZ3 = m_settings.solvers.z3;
 #ifdef HAVE_Z3
@@ -97,6 +109,13 @@ void CHC::analyze(SourceUnit const& _source)
 
 	resetSourceAnalysis();
 
+	util::h256 invariantsKey;
+	if (m_useInvariantHints)
+	{
+		invariantsKey = smt::QueryCache::invariantsKey(*_source.location().sourceName);
+		m_invariantHints.reset(m_queryCache->lookupInvariants(invariantsKey).value_or(smt::QueryCache::Invariants{}));
+	}
+
 	auto sources = sourceDependencies(_source);
 	collectFreeFunctions(sources);
 	createFreeConstants(sources);
@@ -109,6 +128,10 @@ void CHC::analyze(SourceUnit const& _source)
 
 	checkVerificationTargets();
 
+	// The hints of the previous run are kept if no target could be proven.
+	if (m_useInvariantHints && !m_invariantHints.learned().empty())
+		m_queryCache->storeInvariants(invariantsKey, m_invariantHints.learned());
+
 	bool ranSolver = true;
 	// If ranSolver is true here it's because an SMT solver callback was
 	// actually given and the queries were solved.
@@ -610,7 +633,7 @@ void CHC::endVisit(IndexRangeAccess const& _range)
 	if (!sliceData.first)
 	{
 		for (auto pred: sliceData.second.predicates)
-			m_interface->registerRelation(pred->functor());
+			registerRelation(pred->functor());
 		for (auto const& rule: sliceData.second.rules)
 			addRule(rule, "");
 	}
@@ -982,6 +1005,7 @@ void CHC::resetSourceAnalysis()
 	SMTEncoder::resetSourceAnalysis();
 
 	m_unprovedTargets.clear();
+	m_skippedTargets.clear();
 	m_invariants.clear();
 	m_functionTargetIds.clear();
 	m_verificationTargets.clear();
@@ -996,6 +1020,12 @@ void CHC::resetSourceAnalysis()
 	Predicate::reset();
 	ArraySlicePredicate::reset();
 	m_blockCounter = 0;
+	m_hornClauses.clear();
+	m_recordHornClauses = false;
+	m_hashHornClauses = false;
+	m_hornClausesHash = util::h256();
+	m_hornClausesSize = 0;
+	m_useInvariantHints = false;
 
 	bool usesZ3 = false;
 #ifdef HAVE_Z3
@@ -1006,7 +1036,18 @@ void CHC::resetSourceAnalysis()
 		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
-		m_context.setSolver(z3Interface->z3Interface());
+		// The budget of a contract does not apply to CHC, which checks the targets
+		// of all contracts of a source together.
+		// The invariant hints are only used by and stored in the query cache.
+		m_useInvariantHints = m_settings.invariantHints && m_queryCache;
+		m_recordHornClauses =
+			m_parallelism > 1 ||
+			(m_timeBudget && m_timeBudget->hasRunBudget()) ||
+			m_settings.sliceHornClauses ||
+			m_useInvariantHints;
+		// Queries of the SMT-LIB2 interface are answered by the callback and are not cached.
+		m_hashHornClauses = m_queryCache != nullptr;
+		m_context.setSolver(z3Interface->z3Interface(), m_recordHornClauses);
 	}
 #endif
 	if (!usesZ3)
@@ -1014,7 +1055,17 @@ void CHC::resetSourceAnalysis()
 		auto smtlib2Interface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		solAssert(smtlib2Interface, "");
 		smtlib2Interface->reset();
-		m_context.setSolver(smtlib2Interface->smtlib2Interface());
+		// Targets are only checked separately with SMT-LIB2 if the queries are answered by
+		// solver processes, since otherwise they have to reach the callback in order.
+		if (m_solverProcessesCallback)
+		{
+			m_recordHornClauses =
+				m_parallelism > 1 ||
+				(m_timeBudget && m_timeBudget->hasRunBudget()) ||
+				m_settings.sliceHornClauses;
+			m_hashHornClauses = m_queryCache != nullptr;
+		}
+		m_context.setSolver(smtlib2Interface->smtlib2Interface(), m_recordHornClauses);
 	}
 
 	m_context.reset();
@@ -1130,7 +1181,7 @@ SortPointer CHC::sort(ASTNode const* _node)
 Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name, PredicateType _predType, ASTNode const* _node, ContractDefinition const* _contractContext)
 {
 	auto const* block = Predicate::create(_sort, _name, _predType, m_context, _node, _contractContext, m_scopes);
-	m_interface->registerRelation(block->functor());
+	registerRelation(block->functor());
 	return block;
 }
 
@@ -1362,7 +1413,7 @@ void CHC::createErrorBlock()
 		"error_target_" + to_string(m_context.newUniqueId()),
 		PredicateType::Error
 	);
-	m_interface->registerRelation(m_errorPredicate->functor());
+	registerRelation(m_errorPredicate->functor());
 }
 
 void CHC::connectBlocks(smtutil::Expression const& _from, smtutil::Expression const& _to, smtutil::Expression const& _constraints)
@@ -1534,55 +1585,97 @@ smtutil::Expression CHC::predicate(FunctionCall const& _funCall)
 	return callPredicate(args);
 }
 
+void CHC::registerRelation(smtutil::Expression const& _relation)
+{
+	if (m_recordHornClauses)
+		m_hornClauses.push_back({m_context.declarations().size(), {}, _relation});
+	if (m_hashHornClauses)
+		m_hornClausesHash = smt::QueryCache::hashHornClause(m_hornClausesHash, _relation, nullopt);
+	if (m_useInvariantHints)
+		m_invariantHints.registerRelation(_relation);
+	if (m_statistics)
+		m_hornClausesSize += smt::TimeBudget::querySize({_relation});
+	m_interface->registerRelation(_relation);
+}
+
 void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 {
+	if (m_recordHornClauses)
+		m_hornClauses.push_back({m_context.declarations().size(), _ruleName, _rule});
+	if (m_hashHornClauses)
+		m_hornClausesHash = smt::QueryCache::hashHornClause(m_hornClausesHash, _rule, _ruleName);
+	if (m_statistics)
+		m_hornClausesSize += smt::TimeBudget::querySize({_rule});
 	m_interface->addRule(_rule, _ruleName);
 }
 
-tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(
+	smtutil::Expression const& _query,
+	langutil::SourceLocation const& _location,
+	smt::Statistics::Target* _statistics
+)
+{
+	auto result = solveCached(m_hornClausesHash, _query, [&]() {
+		return smt::Statistics::measure(_statistics, [&]() { return solve(*m_interface, _query); });
+	});
+	reportSolverErrors(get<0>(result), _location);
+	return result;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::solve(CHCSolverInterface& _interface, smtutil::Expression const& _query) const
 {
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, invariant, cex) = _interface.query(_query);
 #ifdef HAVE_Z3
-		if (m_settings.solvers.z3)
-		{
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+	if (result == CheckResult::SATISFIABLE && m_settings.solvers.z3 && !counterexampleLimitReached())
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_interface);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		tie(resultNoOpt, invariantNoOpt, cexNoOpt) = _interface.query(_query);
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
-		}
-#endif
-		break;
+		spacer->setSpacerOptions(true);
 	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
+#endif
+	return {result, invariant, cex};
+}
+
+smt::QueryCache::CHCResult CHC::solveCached(
+	util::h256 const& _hornClausesHash,
+	smtutil::Expression const& _query,
+	std::function<smt::QueryCache::CHCResult()> const& _solve
+) const
+{
+	if (!m_hashHornClauses)
+		return _solve();
+
+	util::h256 key = smt::QueryCache::chcKey(m_settings, _hornClausesHash, _query);
+	if (auto result = m_queryCache->lookupCHC(key))
+		return move(*result);
+	auto result = _solve();
+	// Without the counterexample limit, the same query could need a complete counterexample.
+	if (!counterexampleLimitReached())
+		m_queryCache->storeCHC(m_settings, key, result);
+	return result;
+}
+
+void CHC::reportSolverErrors(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	if (_result == CheckResult::CONFLICTING)
 		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
+	else if (_result == CheckResult::ERROR)
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
-	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1639,6 +1732,15 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
+	// With parallelism, the error blocks of all targets are created first, then the
+	// targets are queried in parallel and finally the results are reported in order.
+	size_t sharedHornClauses = m_hornClauses.size();
+	if (m_recordHornClauses)
+	{
+		m_pendingTargets.emplace();
+		m_sharedHornClausesHash = m_hornClausesHash;
+	}
+
 	set<unsigned> checkedErrorIds;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
@@ -1694,15 +1796,29 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		checkAndReportTarget(
+			target,
+			placeholders,
+			errorReporterId,
+			errorType + " happens here.",
+			errorType + " might happen here.",
+			errorType + " was not checked because the time budget of the model checker was used up."
+		);
 		checkedErrorIds.insert(target.errorId);
 	}
 
+	if (m_pendingTargets)
+	{
+		checkPendingTargets(sharedHornClauses);
+		m_pendingTargets.reset();
+	}
+
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
-		for (auto const& [node, targets]: m_unprovedTargets)
-			for (auto const& [target, info]: targets)
-				toReport[node].emplace(target, info);
+		for (auto const& unreported: {&m_unprovedTargets, &m_skippedTargets})
+			for (auto const& [node, targets]: *unreported)
+				for (auto const& [target, info]: targets)
+					toReport[node].emplace(target, info);
 
 	for (auto const& [node, targets]: toReport)
 		for (auto const& [target, info]: targets)
@@ -1724,6 +1840,16 @@ void CHC::checkVerificationTargets()
 			" Consider increasing the timeout per query."
 		);
 
+	if (!m_settings.showUnproved && !m_skippedTargets.empty())
+		m_errorReporter.warning(
+			6029_error,
+			{},
+			"CHC: " +
+			to_string(m_skippedTargets.size()) +
+			" verification condition(s) were not checked because the time budget of the model checker was used up." +
+			" Enable the model checker option \"show unproved\" to see all of them."
+		);
+
 	if (!m_settings.invariants.invariants.empty())
 	{
 		string msg;
@@ -1790,12 +1916,23 @@ void CHC::checkAndReportTarget(
 	vector<CHCQueryPlaceholder> const& _placeholders,
 	ErrorId _errorReporterId,
 	string _satMsg,
-	string _unknownMsg
+	string _unknownMsg,
+	string _skippedMsg
 )
 {
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
+	if (!m_pendingTargets && timeBudgetExhausted())
+	{
+		reportSkippedTarget(_target, _skippedMsg, m_hornClausesSize);
+		return;
+	}
+
+	size_t firstHornClause = m_hornClauses.size();
+	// The solver of a target checked in parallel only contains the shared clauses and its error block.
+	if (m_pendingTargets)
+		m_hornClausesHash = m_sharedHornClausesHash;
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -1803,9 +1940,294 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	if (m_pendingTargets)
+	{
+		m_pendingTargets->push_back({
+			&_target,
+			_errorReporterId,
+			move(_satMsg),
+			move(_unknownMsg),
+			move(_skippedMsg),
+			error(),
+			firstHornClause,
+			m_hornClauses.size(),
+			m_hornClausesHash
+		});
+		return;
+	}
+
+	optional<smt::Statistics::Target> statistics;
+	if (m_statistics)
+		statistics = smt::Statistics::target("chc", _target.type, _target.errorNode->location(), m_hornClausesSize);
+	auto [result, invariant, model] = query(error(), _target.errorNode->location(), statistics ? &*statistics : nullptr);
+	if (statistics)
+		m_statistics->add(move(*statistics), result, m_settings.timeout);
+	reportTarget(_target, _errorReporterId, _satMsg, _unknownMsg, result, invariant, model, error().name);
+}
+
+namespace
+{
+
+/// The predicates a Horn clause defines and depends on.
+struct ClauseDependencies
+{
+	/// The relation or the predicate in the head of the rule, or nullopt if the rule has no head.
+	optional<string> head;
+	/// The predicates in the body of the rule.
+	set<string> body;
+};
+
+/// @returns the dependencies of @a _clauses, where @a _relations are the names of all relations.
+vector<ClauseDependencies> clauseDependencies(vector<pair<smtutil::Expression const*, bool>> const& _clauses, set<string> const& _relations)
+{
+	vector<ClauseDependencies> dependencies;
+	for (auto const& [clause, isRule]: _clauses)
+	{
+		ClauseDependencies& current = dependencies.emplace_back();
+		if (!isRule)
+		{
+			current.head = clause->name;
+			continue;
+		}
+		if (clause->name != "=>" || clause->arguments.size() != 2)
+			continue;
+		current.head = clause->arguments[1].name;
+
+		// The body is traversed as a graph, since its subexpressions are shared.
+		set<vector<smtutil::Expression> const*> visited;
+		vector<smtutil::Expression const*> toVisit{&clause->arguments[0]};
+		while (!toVisit.empty())
+		{
+			smtutil::Expression const* expression = toVisit.back();
+			toVisit.pop_back();
+			if (_relations.count(expression->name))
+				current.body.insert(expression->name);
+			if (!expression->arguments.empty() && visited.insert(expression->arguments.shared().get()).second)
+				for (smtutil::Expression const& argument: expression->arguments)
+					toVisit.push_back(&argument);
+		}
+	}
+	return dependencies;
+}
+
+/// @returns which of the clauses with the dependencies @a _dependencies and indices in @a _ranges
+/// can take part in a derivation of @a _query: the relations and rules defining the predicates
+/// that @a _query depends on directly or indirectly, and the rules without head.
+vector<bool> coneOfInfluence(
+	vector<ClauseDependencies> const& _dependencies,
+	vector<pair<size_t, size_t>> const& _ranges,
+	string const& _query
+)
+{
+	vector<bool> inCone(_dependencies.size(), false);
+	map<string, vector<size_t>> clausesByHead;
+	for (auto [begin, end]: _ranges)
+		for (size_t i = begin; i < end; ++i)
+			if (_dependencies[i].head)
+				clausesByHead[*_dependencies[i].head].push_back(i);
+			else
+				inCone[i] = true;
+
+	set<string> predicates{_query};
+	vector<string> toVisit{_query};
+	while (!toVisit.empty())
+	{
+		string predicate = move(toVisit.back());
+		toVisit.pop_back();
+		if (auto clauses = clausesByHead.find(predicate); clauses != clausesByHead.end())
+			for (size_t i: clauses->second)
+			{
+				inCone[i] = true;
+				for (string const& dependency: _dependencies[i].body)
+					if (predicates.insert(dependency).second)
+						toVisit.push_back(dependency);
+			}
+	}
+	return inCone;
+}
+
+}
+
+void CHC::checkPendingTargets(size_t _sharedHornClauses)
+{
+	solAssert(m_pendingTargets, "");
+	vector<PendingTarget> const& targets = *m_pendingTargets;
+	vector<optional<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>>> results(targets.size());
+
+	// With slicing, the solver of a target only receives the clauses in the cone of influence
+	// of its error predicate.
+	vector<ClauseDependencies> dependencies;
+	if (m_settings.sliceHornClauses)
+	{
+		set<string> relations;
+		vector<pair<smtutil::Expression const*, bool>> clauses;
+		for (HornClause const& clause: m_hornClauses)
+		{
+			if (!clause.ruleName)
+				relations.insert(clause.expression.name);
+			clauses.emplace_back(&clause.expression, clause.ruleName.has_value());
+		}
+		dependencies = clauseDependencies(clauses, relations);
+	}
+
+	// With a time budget, the targets with the smallest error blocks are queried first, so that
+	// the time left by the targets that are solved quickly goes to the harder ones.
+	vector<size_t> order(targets.size());
+	iota(order.begin(), order.end(), 0);
+	if (m_timeBudget && m_timeBudget->hasRunBudget())
+	{
+		vector<size_t> sizes = applyMap(targets, [&](PendingTarget const& _target) {
+			vector<smtutil::Expression> clauses;
+			for (size_t i = _target.firstHornClause; i < _target.endHornClause; ++i)
+				clauses.push_back(m_hornClauses[i].expression);
+			return smt::TimeBudget::querySize(clauses);
+		});
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) { return sizes[_a] < sizes[_b]; });
+	}
+
+	// The clauses of the solver of a target.
+	auto targetClauses = [&](PendingTarget const& _target) {
+		vector<pair<size_t, size_t>> ranges{{0, _sharedHornClauses}, {_target.firstHornClause, _target.endHornClause}};
+		vector<bool> inCone;
+		if (m_settings.sliceHornClauses)
+			inCone = coneOfInfluence(dependencies, ranges, _target.query.name);
+		vector<HornClause const*> clauses;
+		for (auto [begin, end]: ranges)
+			for (size_t i = begin; i < end; ++i)
+				if (inCone.empty() || inCone[i])
+					clauses.push_back(&m_hornClauses[i]);
+		return clauses;
+	};
+	auto clausesSize = [](vector<HornClause const*> const& _clauses) {
+		return smt::TimeBudget::querySize(applyMap(_clauses, [](HornClause const* _clause) { return _clause->expression; }));
+	};
+
+	// Every target is queried in a solver of its own that only contains the clauses shared by all targets
+	// and the error block of the target, so that the results do not depend on the order or number of threads.
+	vector<optional<unsigned>> timeouts(targets.size());
+	vector<optional<smt::Statistics::Target>> statistics(targets.size());
+	util::parallelForEach(targets.size(), m_parallelism, [&](size_t _position) {
+		size_t index = order[_position];
+		if (timeBudgetExhausted())
+			return;
+		optional<unsigned> timeout = m_timeBudget ?
+			m_timeBudget->queryTimeout(targets.size() - _position, m_parallelism) :
+			m_settings.timeout;
+		timeouts[index] = timeout;
+		PendingTarget const& target = targets[index];
+		vector<HornClause const*> clauses = targetClauses(target);
+		if (m_statistics)
+			statistics[index] = smt::Statistics::target(
+				"chc",
+				target.target->type,
+				target.target->errorNode->location(),
+				clausesSize(clauses)
+			);
+		smt::Statistics::Target* targetStatistics = statistics[index] ? &*statistics[index] : nullptr;
+		results[index] = solveCached(target.hornClausesHash, target.query, [&]() {
+			if (m_useInvariantHints)
+				if (auto result = smt::Statistics::measure(targetStatistics, [&]() { return proveWithHints(clauses, target.query, timeout); }))
+					return move(*result);
+
+			return smt::Statistics::measure(targetStatistics, [&]() {
+				auto const& declarations = m_context.declarations();
+				unique_ptr<CHCSolverInterface> solver = targetSolver(timeout);
+				size_t declared = 0;
+				for (HornClause const* clause: clauses)
+				{
+					for (; declared < clause->declarations; ++declared)
+						solver->declareVariable(declarations[declared].first, declarations[declared].second);
+					if (clause->ruleName)
+						solver->addRule(clause->expression, *clause->ruleName);
+					else
+						solver->registerRelation(clause->expression);
+				}
+				return solve(*solver, target.query);
+			});
+		});
+	});
+
+	for (size_t i = 0; i < targets.size(); ++i)
+	{
+		PendingTarget const& target = targets[i];
+		if (m_unsafeTargets.count(target.target->errorNode) && m_unsafeTargets.at(target.target->errorNode).count(target.target->type))
+			continue;
+		if (!results[i])
+		{
+			reportSkippedTarget(*target.target, target.skippedMessage, m_statistics ? clausesSize(targetClauses(target)) : 0);
+			continue;
+		}
+		auto& [checkResult, invariant, model] = *results[i];
+		if (statistics[i])
+			m_statistics->add(move(*statistics[i]), checkResult, timeouts[i]);
+		reportSolverErrors(checkResult, target.target->errorNode->location());
+		reportTarget(*target.target, target.errorReporterId, target.satMessage, target.unknownMessage, checkResult, invariant, model, target.query.name);
+	}
+}
+
+unique_ptr<CHCSolverInterface> CHC::targetSolver(optional<unsigned> _timeout) const
+{
+#ifdef HAVE_Z3
+	if (!m_solverProcessesCallback)
+		return make_unique<Z3CHCInterface>(_timeout);
+#endif
+	solAssert(m_solverProcessesCallback, "Verification targets can only be checked separately with Z3 or solver processes.");
+	// The queries of the solver processes are never answered from the responses given as input.
+	static map<util::h256, string> const noResponses;
+	return make_unique<CHCSmtLib2Interface>(noResponses, m_solverProcessesCallback, _timeout);
+}
+
+optional<smt::QueryCache::CHCResult> CHC::proveWithHints(
+	vector<HornClause const*> const& _clauses,
+	smtutil::Expression const& _query,
+	[[maybe_unused]] optional<unsigned> _timeout
+) const
+{
+#ifdef HAVE_Z3
+	vector<pair<smtutil::Expression const*, bool>> clauses;
+	for (HornClause const* clause: _clauses)
+		clauses.emplace_back(&clause->expression, clause->ruleName.has_value());
+	auto proof = m_invariantHints.proofObligation(clauses, _query);
+	if (!proof)
+		return nullopt;
+
+	// The hints prove the target if no rule is violated by them and they exclude the query.
+	Z3Interface solver(_timeout);
+	for (auto const& [name, sort]: m_context.declarations())
+		solver.declareVariable(name, sort);
+	solver.addAssertion(proof->violation);
+	if (solver.check({}).first != CheckResult::UNSATISFIABLE)
+		return nullopt;
+	return smt::QueryCache::CHCResult{CheckResult::UNSATISFIABLE, move(proof->invariant), {}};
+#else
+	return nullopt;
+#endif
+}
+
+void CHC::reportSkippedTarget(CHCVerificationTarget const& _target, string const& _skippedMsg, size_t _size)
+{
+	if (m_statistics)
+		m_statistics->addSkipped(smt::Statistics::target("chc", _target.type, _target.errorNode->location(), _size));
+	m_skippedTargets[_target.errorNode][_target.type] = {
+		1897_error,
+		_target.errorNode->location(),
+		"CHC: " + _skippedMsg
+	};
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	CheckResult _result,
+	smtutil::Expression const& _invariant,
+	CHCSolverInterface::CexGraph const& _model,
+	string const& _errorName
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
-	if (result == CheckResult::UNSATISFIABLE)
+	if (_result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target.type);
 		set<Predicate const*> predicates;
@@ -1813,20 +2235,27 @@ void CHC::checkAndReportTarget(
 			predicates.insert(pred);
 		for (auto const* pred: m_nondetInterfaces | ranges::views::values)
 			predicates.insert(pred);
-		map<Predicate const*, set<string>> invariants = collectInvariants(invariant, predicates, m_settings.invariants);
+		map<Predicate const*, set<string>> invariants = collectInvariants(_invariant, predicates, m_settings.invariants);
 		for (auto pred: invariants | ranges::views::keys)
 			m_invariants[pred] += move(invariants.at(pred));
+		if (m_useInvariantHints)
+			m_invariantHints.learn(_invariant);
 	}
-	else if (result == CheckResult::SATISFIABLE)
+	else if (_result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		optional<string> cex;
+		if (!counterexampleLimitReached())
+			cex = generateCounterexample(_model, _errorName);
 		if (cex)
+		{
+			++m_counterexampleAmt;
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
 				location,
 				"CHC: " + _satMsg + "\nCounterexample:\n" + *cex
 			};
+		}
 		else
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
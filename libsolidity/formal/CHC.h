@@ -31,9 +31,13 @@
 
 #pragma once
 
+#include <libsolidity/formal/InvariantHints.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
+#include <libsolidity/formal/QueryCache.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/Statistics.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -60,7 +64,11 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1,
+		smt::QueryCache* _queryCache = nullptr,
+		smt::TimeBudget* _timeBudget = nullptr,
+		smt::Statistics* _statistics = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -243,11 +251,29 @@ private:
 
 	/// Solver related.
 	//@{
+	/// Adds a relation to the solver.
+	void registerRelation(smtutil::Expression const& _relation);
 	/// Adds Horn rule to the solver.
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
-	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// The query is counted into @a _statistics unless it is null.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::Expression const& _query,
+		langutil::SourceLocation const& _location,
+		smt::Statistics::Target* _statistics = nullptr
+	);
+	/// Queries @a _interface like query(), but without reporting errors.
+	/// Only reads the state of the engine, so it can be called on several threads.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> solve(smtutil::CHCSolverInterface& _interface, smtutil::Expression const& _query) const;
+	/// @returns the result of @a _query in the system of Horn clauses with the hash @a _hornClausesHash
+	/// from the query cache, or the result of @a _solve, which is then stored in the cache.
+	smt::QueryCache::CHCResult solveCached(
+		util::h256 const& _hornClausesHash,
+		smtutil::Expression const& _query,
+		std::function<smt::QueryCache::CHCResult()> const& _solve
+	) const;
+	void reportSolverErrors(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -261,7 +287,32 @@ private:
 		std::vector<CHCQueryPlaceholder> const& _placeholders,
 		langutil::ErrorId _errorReporterId,
 		std::string _satMsg,
-		std::string _unknownMsg = ""
+		std::string _unknownMsg = "",
+		std::string _skippedMsg = ""
+	);
+	/// Queries the targets collected in m_pendingTargets, in parallel and in the order of their size
+	/// if a time budget is set, and reports them in order.
+	/// The first @a _sharedHornClauses clauses are needed by all of them.
+	void checkPendingTargets(size_t _sharedHornClauses);
+	/// Records that @a _target was not queried since the time budget is used up.
+	/// @param _size the size of the clauses the target would have been checked with.
+	void reportSkippedTarget(CHCVerificationTarget const& _target, std::string const& _skippedMsg, size_t _size);
+	/// @returns true if the time budget is used up.
+	bool timeBudgetExhausted() const { return m_timeBudget && m_timeBudget->exhausted(); }
+	/// @returns true if no more counterexamples are generated since the limit of the settings is reached.
+	bool counterexampleLimitReached() const
+	{
+		return m_settings.counterexampleLimit && m_counterexampleAmt >= *m_settings.counterexampleLimit;
+	}
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		smtutil::CheckResult _result,
+		smtutil::Expression const& _invariant,
+		smtutil::CHCSolverInterface::CexGraph const& _model,
+		std::string const& _errorName
 	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
@@ -380,6 +431,10 @@ private:
 	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> m_unsafeTargets;
 	/// Targets not proved.
 	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> m_unprovedTargets;
+	/// Targets not queried since the time budget was used up.
+	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> m_skippedTargets;
+	/// Number of unsafe targets reported with a counterexample.
+	size_t m_counterexampleAmt = 0;
 
 	/// Inferred invariants.
 	std::map<Predicate const*, std::set<std::string>, PredicateCompare> m_invariants;
@@ -421,6 +476,82 @@ private:
 
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
+
+	/// Parallel checking of verification targets.
+	//@{
+	/// Maximum number of threads used to query the verification targets.
+	size_t m_parallelism = 1;
+	/// The callback of the solver processes of the model checker, which can be called from any thread,
+	/// if they are requested in the settings.
+	frontend::ReadCallback::Callback m_solverProcessesCallback;
+	/// @returns a new solver in which a single target is checked with the timeout @a _timeout.
+	std::unique_ptr<smtutil::CHCSolverInterface> targetSolver(std::optional<unsigned> _timeout) const;
+
+	/// A relation (without rule name) or rule added to m_interface, together with the number
+	/// of variables declared before it, so that it can be added to other solvers in the same context.
+	struct HornClause
+	{
+		size_t declarations;
+		std::optional<std::string> ruleName;
+		smtutil::Expression expression;
+	};
+	/// Whether the clauses are recorded in m_hornClauses, which is the case if the targets are checked
+	/// in parallel or with timeouts derived from a time budget, either with Z3 or with solver processes.
+	bool m_recordHornClauses = false;
+	std::vector<HornClause> m_hornClauses;
+
+	/// A verification target whose error block has been added to the solver and that is queried
+	/// together with the other targets of the source.
+	struct PendingTarget
+	{
+		CHCVerificationTarget const* target;
+		langutil::ErrorId errorReporterId;
+		std::string satMessage;
+		std::string unknownMessage;
+		std::string skippedMessage;
+		smtutil::Expression query;
+		/// The clauses of the error block of the target are [firstHornClause, endHornClause).
+		size_t firstHornClause;
+		size_t endHornClause;
+		/// The hash of the clauses shared by all targets followed by the clauses of the error block.
+		util::h256 hornClausesHash;
+	};
+	/// Set while the verification targets of a source are collected to be checked in parallel.
+	std::optional<std::vector<PendingTarget>> m_pendingTargets;
+	//@}
+
+	/// Caching of query results.
+	//@{
+	smt::QueryCache* m_queryCache = nullptr;
+	/// Whether the clauses are hashed into m_hornClausesHash, which is the case if the queries are cached.
+	bool m_hashHornClauses = false;
+	/// The hash of the clauses added to m_interface.
+	util::h256 m_hornClausesHash;
+	/// The sum of the sizes of the clauses added to m_interface, if statistics are collected.
+	size_t m_hornClausesSize = 0;
+	/// The hash of the clauses shared by all targets that are checked in parallel.
+	util::h256 m_sharedHornClausesHash;
+	//@}
+
+	/// Invariants of earlier runs.
+	//@{
+	/// @returns the result of @a _query in the system of Horn clauses @a _clauses if the
+	/// invariant hints prove it unreachable within the timeout @a _timeout.
+	/// Only reads the state of the engine, so it can be called on several threads.
+	std::optional<smt::QueryCache::CHCResult> proveWithHints(
+		std::vector<HornClause const*> const& _clauses,
+		smtutil::Expression const& _query,
+		std::optional<unsigned> _timeout
+	) const;
+	/// Whether the invariants found for the source are stored in the query cache and used
+	/// as hints, which requires the clauses to be recorded.
+	bool m_useInvariantHints = false;
+	smt::InvariantHints m_invariantHints;
+	//@}
+
+	smt::TimeBudget* m_timeBudget = nullptr;
+	/// Collects the statistics of the targets, if requested in the settings.
+	smt::Statistics* m_statistics = nullptr;
 };
 
 }
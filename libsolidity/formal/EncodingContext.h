@@ -50,10 +50,14 @@ public:
 
 	/// Sets the current solver used by the current engine for
 	/// SMT variable declaration.
-	void setSolver(smtutil::SolverInterface* _solver)
+	/// If @a _recordDeclarations is true, the declarations are also recorded,
+	/// so that they can be repeated in other solvers.
+	void setSolver(smtutil::SolverInterface* _solver, bool _recordDeclarations = false)
 	{
 		solAssert(_solver, "");
 		m_solver = _solver;
+		m_recordDeclarations = _recordDeclarations;
+		m_declarations.clear();
 	}
 
 	/// Sets whether the context should conjoin assertions in the assertion stack.
@@ -63,9 +67,15 @@ public:
 	smtutil::Expression newVariable(std::string _name, smtutil::SortPointer _sort)
 	{
 		solAssert(m_solver, "");
+		if (m_recordDeclarations)
+			m_declarations.emplace_back(_name, _sort);
 		return m_solver->newVariable(move(_name), move(_sort));
 	}
 
+	/// @returns the variables declared in the current solver in the order of their declaration,
+	/// if it was set to record them.
+	std::vector<std::pair<std::string, smtutil::SortPointer>> const& declarations() const { return m_declarations; }
+
 	struct IdCompare
 	{
 		bool operator()(ASTNode const* lhs, ASTNode const* rhs) const
@@ -174,6 +184,10 @@ private:
 	/// Solver can be SMT solver or Horn solver in the future.
 	smtutil::SolverInterface* m_solver = nullptr;
 
+	/// Variables declared in m_solver, if m_recordDeclarations is set.
+	bool m_recordDeclarations = false;
+	std::vector<std::pair<std::string, smtutil::SortPointer>> m_declarations;
+
 	/// Assertion stack.
 	std::vector<smtutil::Expression> m_assertions;
 
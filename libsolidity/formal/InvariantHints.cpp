@@ -0,0 +1,341 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/InvariantHints.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <set>
+
+using namespace std;
+using boost::algorithm::starts_with;
+using namespace solidity;
+using namespace solidity::smtutil;
+using namespace solidity::frontend::smt;
+
+namespace
+{
+
+bool isNumber(string const& _name)
+{
+	return !_name.empty() && all_of(_name.begin(), _name.end(), [](unsigned char _c) { return isdigit(_c); });
+}
+
+/// @returns true if all arguments "#i" in @a _formula are less than @a _arity.
+bool validArguments(Expression const& _formula, size_t _arity)
+{
+	if (_formula.arguments.empty())
+		return !starts_with(_formula.name, "#") || (isNumber(_formula.name.substr(1)) && stoul(_formula.name.substr(1)) < _arity);
+	return all_of(_formula.arguments.begin(), _formula.arguments.end(), [&](Expression const& _argument) {
+		return validArguments(_argument, _arity);
+	});
+}
+
+bool equal(Expression const& _a, Expression const& _b)
+{
+	if (_a.name != _b.name || _a.arguments.size() != _b.arguments.size())
+		return false;
+	for (size_t i = 0; i < _a.arguments.size(); ++i)
+		if (!equal(_a.arguments[i], _b.arguments[i]))
+			return false;
+	return true;
+}
+
+void collectConjuncts(Expression const& _expr, vector<Expression const*>& _conjuncts)
+{
+	if (_expr.name == "and")
+		for (Expression const& argument: _expr.arguments)
+			collectConjuncts(argument, _conjuncts);
+	else
+		_conjuncts.push_back(&_expr);
+}
+
+string argumentName(size_t _index)
+{
+	return "#" + to_string(_index);
+}
+
+/// @returns @a _expr in the form that the SMT solvers accept, with the leaves that are
+/// names in @a _parameters replaced by the arguments with the corresponding indices,
+/// or nullopt if @a _expr uses other variables or constructs that cannot be converted.
+optional<Expression> normalize(Expression const& _expr, map<string, size_t> const& _parameters)
+{
+	if (_expr.arguments.empty())
+	{
+		if (auto parameter = _parameters.find(_expr.name); parameter != _parameters.end())
+			return Expression(argumentName(parameter->second), {}, _expr.sort);
+		if (_expr.name == "true" || _expr.name == "false" || _expr.sort->kind == Kind::Sort || isNumber(_expr.name))
+			return _expr;
+		// Negative numbers are printed as "(- n)" by z3.
+		if (starts_with(_expr.name, "(- ") && _expr.name.back() == ')')
+			if (string number = _expr.name.substr(3, _expr.name.size() - 4); isNumber(number))
+				return Expression("-", {Expression(size_t(0)), Expression(number, {}, _expr.sort)}, _expr.sort);
+		return nullopt;
+	}
+
+	vector<Expression> arguments;
+	for (Expression const& argument: _expr.arguments)
+		if (auto normalized = normalize(argument, _parameters))
+			arguments.push_back(move(*normalized));
+		else
+			return nullopt;
+
+	static set<string> const booleanOperators{"not", "and", "or", "=>"};
+	if (booleanOperators.count(_expr.name))
+		for (Expression const& argument: arguments)
+			if (argument.sort->kind != Kind::Bool)
+				return nullopt;
+
+	// The solvers only accept binary conjunctions, disjunctions, sums and products.
+	static set<string> const associativeOperators{"and", "or", "+", "*"};
+	if (associativeOperators.count(_expr.name))
+	{
+		Expression result = move(arguments.front());
+		for (size_t i = 1; i < arguments.size(); ++i)
+			result = Expression(_expr.name, {move(result), move(arguments[i])}, _expr.sort);
+		return result;
+	}
+
+	if (starts_with(_expr.name, "dt_accessor_") && arguments.size() == 1)
+	{
+		auto tupleSort = dynamic_pointer_cast<TupleSort>(arguments.front().sort);
+		if (!tupleSort)
+			return nullopt;
+		string member = _expr.name.substr(string("dt_accessor_").size());
+		auto position = find(tupleSort->members.begin(), tupleSort->members.end(), member);
+		if (position == tupleSort->members.end())
+			return nullopt;
+		return Expression::tuple_get(move(arguments.front()), static_cast<size_t>(position - tupleSort->members.begin()));
+	}
+
+	static set<string> const operators{
+		"ite", "not", "=>", "=", "<", "<=", ">", ">=", "-", "div", "mod",
+		"int2bv", "bv2int", "select", "store", "const_array", "tuple_get", "tuple_constructor"
+	};
+	if (!operators.count(_expr.name))
+		return nullopt;
+	if (_expr.name == "tuple_constructor" && !dynamic_pointer_cast<TupleSort>(_expr.sort))
+		return nullopt;
+	Expression result(_expr.name, move(arguments), _expr.sort);
+	if (!result.hasCorrectArity())
+		return nullopt;
+	return result;
+}
+
+/// @returns @a _formula with the arguments "#i" replaced by @a _arguments.
+Expression instantiate(Expression const& _formula, vector<Expression> const& _arguments)
+{
+	if (_formula.arguments.empty())
+	{
+		if (starts_with(_formula.name, "#"))
+		{
+			size_t index = stoul(_formula.name.substr(1));
+			smtAssert(index < _arguments.size(), "");
+			return _arguments[index];
+		}
+		return _formula;
+	}
+	vector<Expression> arguments;
+	for (Expression const& argument: _formula.arguments)
+		arguments.push_back(instantiate(argument, _arguments));
+	return Expression(_formula.name, move(arguments), _formula.sort);
+}
+
+/// @returns the disjunction of @a _disjuncts as a balanced tree.
+Expression balancedDisjunction(vector<Expression> const& _disjuncts, size_t _begin, size_t _end)
+{
+	smtAssert(_begin < _end, "");
+	if (_end - _begin == 1)
+		return _disjuncts[_begin];
+	size_t middle = _begin + (_end - _begin) / 2;
+	return balancedDisjunction(_disjuncts, _begin, middle) || balancedDisjunction(_disjuncts, middle, _end);
+}
+
+}
+
+void InvariantHints::reset(QueryCache::Invariants _hints)
+{
+	m_relations.clear();
+	m_occurrences.clear();
+	m_hints = move(_hints);
+	for (auto it = m_hints.begin(); it != m_hints.end();)
+	{
+		auto const* functionSort = dynamic_cast<FunctionSort const*>(it->second.first.get());
+		if (functionSort && validArguments(it->second.second, functionSort->domain.size()))
+			++it;
+		else
+			it = m_hints.erase(it);
+	}
+	m_learned.clear();
+}
+
+void InvariantHints::registerRelation(Expression const& _relation)
+{
+	if (m_relations.count(_relation.name))
+		return;
+	string stripped = stripIds(_relation.name);
+	m_relations[_relation.name] = {stripped + "/" + to_string(m_occurrences[stripped]++), _relation.sort};
+}
+
+optional<InvariantHints::Proof> InvariantHints::proofObligation(
+	vector<pair<Expression const*, bool>> const& _clauses,
+	Expression const& _query
+) const
+{
+	vector<Expression> invariants;
+	for (auto const& [clause, isRule]: _clauses)
+		if (!isRule && m_relations.count(clause->name))
+			if (Expression const* formula = hint(m_relations.at(clause->name)))
+			{
+				auto const& functionSort = dynamic_cast<FunctionSort const&>(*m_relations.at(clause->name).sort);
+				vector<Expression> arguments;
+				for (size_t i = 0; i < functionSort.domain.size(); ++i)
+					arguments.emplace_back(argumentName(i), vector<Expression>{}, functionSort.domain[i]);
+				invariants.push_back(Expression(clause->name, move(arguments), SortProvider::boolSort) == *formula);
+			}
+	if (invariants.empty())
+		return nullopt;
+
+	// The clauses share subexpressions, which are only rebuilt once.
+	map<pair<vector<Expression> const*, string>, Expression> substituted;
+	function<Expression(Expression const&)> substitute = [&](Expression const& _expr) -> Expression {
+		if (auto relation = m_relations.find(_expr.name); relation != m_relations.end())
+		{
+			Expression const* formula = hint(relation->second);
+			if (!formula)
+				return Expression(true);
+			vector<Expression> arguments;
+			for (Expression const& argument: _expr.arguments)
+				arguments.push_back(substitute(argument));
+			return instantiate(*formula, arguments);
+		}
+		if (_expr.arguments.empty())
+			return _expr;
+
+		pair<vector<Expression> const*, string> key{_expr.arguments.shared().get(), _expr.name};
+		if (auto it = substituted.find(key); it != substituted.end())
+			return it->second;
+		vector<Expression> arguments;
+		bool changed = false;
+		for (Expression const& argument: _expr.arguments)
+		{
+			arguments.push_back(substitute(argument));
+			changed = changed ||
+				arguments.back().name != argument.name ||
+				arguments.back().arguments.shared() != argument.arguments.shared();
+		}
+		Expression result = changed ? Expression(_expr.name, move(arguments), _expr.sort) : _expr;
+		substituted.emplace(move(key), result);
+		return result;
+	};
+
+	vector<Expression> disjuncts{substitute(_query)};
+	for (auto const& [clause, isRule]: _clauses)
+		if (isRule)
+			disjuncts.push_back(!substitute(*clause));
+	return Proof{balancedDisjunction(disjuncts, 0, disjuncts.size()), Expression::mkAnd(move(invariants))};
+}
+
+void InvariantHints::learn(Expression const& _invariant)
+{
+	vector<Expression const*> conjuncts;
+	collectConjuncts(_invariant, conjuncts);
+	for (Expression const* conjunct: conjuncts)
+	{
+		// The interpretations are universally quantified over the arguments of the relations.
+		Expression const* body = conjunct;
+		if (body->name == "forall" && body->arguments.size() == 1)
+			body = &body->arguments.front();
+
+		// The interpretation of a relation is given as an equality, or as the relation itself
+		// or its negation if it is true or false.
+		Expression const* application = nullptr;
+		optional<Expression> interpretation;
+		if (body->name == "=" && body->arguments.size() == 2)
+			for (size_t side: {0u, 1u})
+				if (m_relations.count(body->arguments[side].name))
+				{
+					application = &body->arguments[side];
+					interpretation = body->arguments[1 - side];
+					break;
+				}
+		if (!application && m_relations.count(body->name))
+		{
+			application = body;
+			interpretation = Expression(true);
+		}
+		if (!application && body->name == "not" && body->arguments.size() == 1 && m_relations.count(body->arguments.front().name))
+		{
+			application = &body->arguments.front();
+			interpretation = Expression(false);
+		}
+		if (!application)
+			continue;
+
+		map<string, size_t> parameters;
+		for (size_t i = 0; i < application->arguments.size(); ++i)
+		{
+			Expression const& argument = application->arguments[i];
+			if (
+				!argument.arguments.empty() ||
+				argument.name == "true" ||
+				argument.name == "false" ||
+				isNumber(argument.name) ||
+				!parameters.emplace(argument.name, i).second
+			)
+			{
+				parameters.clear();
+				interpretation.reset();
+				break;
+			}
+		}
+		if (interpretation)
+			interpretation = normalize(*interpretation, parameters);
+		if (!interpretation)
+			continue;
+
+		Relation const& relation = m_relations.at(application->name);
+		auto [learned, inserted] = m_learned.emplace(relation.key, make_pair(relation.sort, *interpretation));
+		if (inserted)
+			continue;
+		// The conjunction of inductive invariants is inductive.
+		vector<Expression const*> known;
+		collectConjuncts(learned->second.second, known);
+		if (none_of(known.begin(), known.end(), [&](Expression const* _known) { return equal(*_known, *interpretation); }))
+			learned->second.second = learned->second.second && *interpretation;
+	}
+}
+
+string InvariantHints::stripIds(string const& _name)
+{
+	vector<string> parts;
+	boost::split(parts, _name, boost::is_any_of("_"));
+	parts.erase(remove_if(parts.begin(), parts.end(), isNumber), parts.end());
+	return boost::join(parts, "_");
+}
+
+Expression const* InvariantHints::hint(Relation const& _relation) const
+{
+	auto hint = m_hints.find(_relation.key);
+	if (hint == m_hints.end() || !(*hint->second.first == *_relation.sort))
+		return nullptr;
+	return &hint->second.second;
+}
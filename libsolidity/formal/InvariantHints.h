@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/formal/QueryCache.h>
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Invariants that CHC found in an earlier run and that are used to prove targets
+ * without querying the Horn solver.
+ *
+ * The invariants are taken from the answers of the Horn solver for safe targets, which interpret
+ * every predicate by a formula over its arguments. The arguments are called "#0", "#1" and so on
+ * in the stored formulas. The names of the predicates contain the ids of AST nodes, which change
+ * whenever the sources are modified, so the formulas are stored under the name of the predicate
+ * without its numeric parts, followed by the number of predicates with the same stripped name
+ * registered before it.
+ *
+ * The hints prove a target if interpreting every predicate by its hint, or by true if there is
+ * none, satisfies all Horn clauses and makes the query false. This is checked by a single SMT
+ * query, so wrong or outdated hints are harmless.
+ */
+class InvariantHints
+{
+public:
+	/// The formula that is unsatisfiable if the hints prove a target safe, and the hints
+	/// for the relations of the target as an answer of the Horn solver.
+	struct Proof
+	{
+		smtutil::Expression violation;
+		smtutil::Expression invariant;
+	};
+
+	/// Forgets the relations and the learned invariants and uses @a _hints from now on.
+	void reset(QueryCache::Invariants _hints);
+
+	/// Adds the relation @a _relation of the system of Horn clauses.
+	void registerRelation(smtutil::Expression const& _relation);
+
+	/// @returns the proof obligation for the unreachability of @a _query in the system of Horn
+	/// clauses @a _clauses, which are given with whether they are rules, or nullopt if there
+	/// are no hints for its relations.
+	std::optional<Proof> proofObligation(
+		std::vector<std::pair<smtutil::Expression const*, bool>> const& _clauses,
+		smtutil::Expression const& _query
+	) const;
+
+	/// Adds the interpretations of the relations in the answer @a _invariant of the Horn solver
+	/// for a safe target to the learned invariants.
+	void learn(smtutil::Expression const& _invariant);
+	QueryCache::Invariants const& learned() const { return m_learned; }
+
+	/// @returns @a _name without its parts that only consist of digits.
+	static std::string stripIds(std::string const& _name);
+
+private:
+	struct Relation
+	{
+		/// The key of the interpretation of the relation in the hints and the learned invariants.
+		std::string key;
+		smtutil::SortPointer sort;
+	};
+
+	/// @returns the hint for @a _relation, if there is one whose sort matches.
+	smtutil::Expression const* hint(Relation const& _relation) const;
+
+	std::map<std::string, Relation> m_relations;
+	/// The number of registered relations by stripped name.
+	std::map<std::string, size_t> m_occurrences;
+	QueryCache::Invariants m_hints;
+	QueryCache::Invariants m_learned;
+};
+
+}
@@ -30,21 +30,83 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Reports the deprecation warning of the SMTChecker pragma through @a _errorReporter,
+/// which is either an ErrorReporter or a UniqueErrorReporter.
+// TODO This should be removed for 0.9.0.
+template <class Reporter>
+void reportDeprecatedPragma(Reporter& _errorReporter, SourceUnit const& _source)
+{
+	if (!_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
+		return;
+
+	PragmaDirective const* smtPragma = nullptr;
+	for (auto node: _source.nodes())
+		if (auto pragma = dynamic_pointer_cast<PragmaDirective>(node))
+			if (
+				pragma->literals().size() >= 2 &&
+				pragma->literals().at(1) == "SMTChecker"
+			)
+			{
+				smtPragma = pragma.get();
+				break;
+			}
+	solAssert(smtPragma, "");
+	_errorReporter.warning(
+		5523_error,
+		smtPragma->location(),
+		"The SMTChecker pragma has been deprecated and will be removed in the future. "
+		"Please use the \"model checker engine\" compiler setting to activate the SMTChecker instead. "
+		"If the pragma is enabled, all engines will be used."
+	);
+}
+
+}
+
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
 	langutil::CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	size_t _parallelism
 ):
 	m_errorReporter(_errorReporter),
 	m_settings(move(_settings)),
 	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_queryCache(m_settings.cacheDirectory ? make_unique<smt::QueryCache>(*m_settings.cacheDirectory) : nullptr),
+	m_timeBudget(m_settings),
+	m_statistics(m_settings.printStats ? make_optional<smt::Statistics>() : nullopt),
+	m_solverProcesses(startSolverProcesses()),
+	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, m_solverProcesses ? m_solverProcesses->callback() : _smtCallback, m_settings, _charStreamProvider, _parallelism, m_queryCache.get(), &m_timeBudget, m_statistics ? &*m_statistics : nullptr),
+	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, m_solverProcesses ? m_solverProcesses->callback() : _smtCallback, m_settings, _charStreamProvider, _parallelism, m_queryCache.get(), &m_timeBudget, m_statistics ? &*m_statistics : nullptr)
 {
 }
 
+unique_ptr<smtutil::SolverProcessPool> ModelChecker::startSolverProcesses()
+{
+	if (!m_settings.solverProcesses)
+		return nullptr;
+
+	auto pool = smtutil::SolverProcessPool::z3(*m_settings.solverProcesses, m_settings.solverMemoryLimit);
+	if (!pool)
+	{
+		m_uniqueErrorReporter.warning(
+			1703_error,
+			SourceLocation(),
+			"No z3 executable was found in the search path to start the requested solver processes."
+			" The solvers linked into the compiler are used instead."
+		);
+		m_settings.solverProcesses.reset();
+		return nullptr;
+	}
+	// The engines send SMT-LIB2 scripts, which are answered by the solver processes.
+	m_settings.solvers = smtutil::SMTSolverChoice::SMTLIB2();
+	return pool;
+}
+
 // TODO This should be removed for 0.9.0.
 void ModelChecker::enableAllEnginesIfPragmaPresent(vector<shared_ptr<SourceUnit>> const& _sources)
 {
@@ -87,35 +149,21 @@ void ModelChecker::checkRequestedSourcesAndContracts(vector<shared_ptr<SourceUni
 	}
 }
 
+// TODO This should be removed for 0.9.0.
+void ModelChecker::warnAboutDeprecatedPragma(ErrorReporter& _errorReporter, SourceUnit const& _source)
+{
+	reportDeprecatedPragma(_errorReporter, _source);
+}
+
 void ModelChecker::analyze(SourceUnit const& _source)
 {
-	// TODO This should be removed for 0.9.0.
-	if (_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
-	{
-		PragmaDirective const* smtPragma = nullptr;
-		for (auto node: _source.nodes())
-			if (auto pragma = dynamic_pointer_cast<PragmaDirective>(node))
-				if (
-					pragma->literals().size() >= 2 &&
-					pragma->literals().at(1) == "SMTChecker"
-				)
-				{
-					smtPragma = pragma.get();
-					break;
-				}
-		solAssert(smtPragma, "");
-		m_uniqueErrorReporter.warning(
-			5523_error,
-			smtPragma->location(),
-			"The SMTChecker pragma has been deprecated and will be removed in the future. "
-			"Please use the \"model checker engine\" compiler setting to activate the SMTChecker instead. "
-			"If the pragma is enabled, all engines will be used."
-		);
-	}
+	reportDeprecatedPragma(m_uniqueErrorReporter, _source);
 
 	if (m_settings.engine.none())
 		return;
 
+	m_timeBudget.startRun();
+
 	if (m_settings.engine.chc)
 		m_chc.analyze(_source);
 
@@ -126,6 +174,9 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.bmc)
 		m_bmc.analyze(_source, solvedTargets);
 
+	if (m_queryCache)
+		m_queryCache->flush();
+
 	m_errorReporter.append(m_uniqueErrorReporter.errors());
 	m_uniqueErrorReporter.clear();
 }
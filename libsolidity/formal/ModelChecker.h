@@ -27,10 +27,14 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/QueryCache.h>
+#include <libsolidity/formal/Statistics.h>
+#include <libsolidity/formal/TimeBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
+#include <libsmtutil/SolverProcessPool.h>
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/UniqueErrorReporter.h>
@@ -49,17 +53,24 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _parallelism maximum number of threads used to check independent verification targets.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		size_t _parallelism = 1
 	);
 
 	// TODO This should be removed for 0.9.0.
 	void enableAllEnginesIfPragmaPresent(std::vector<std::shared_ptr<SourceUnit>> const& _sources);
 
+	/// Reports a deprecation warning if @a _source uses the SMTChecker pragma.
+	/// Also called if the model checker does not run at all.
+	// TODO This should be removed for 0.9.0.
+	static void warnAboutDeprecatedPragma(langutil::ErrorReporter& _errorReporter, SourceUnit const& _source);
+
 	/// Generates error messages if the requested sources and contracts
 	/// do not exist.
 	void checkRequestedSourcesAndContracts(std::vector<std::shared_ptr<SourceUnit>> const& _sources);
@@ -71,10 +82,17 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries();
 
+	/// @returns the statistics of the verification targets, if they are requested in the settings.
+	std::optional<smt::Statistics> const& statistics() const { return m_statistics; }
+
 	/// @returns SMT solvers that are available via the C++ API.
 	static smtutil::SMTSolverChoice availableSolvers();
 
 private:
+	/// Starts the solver processes requested in the settings and makes the engines use only them.
+	/// @returns nullptr if no solver processes are requested or the solver cannot be found.
+	std::unique_ptr<smtutil::SolverProcessPool> startSolverProcesses();
+
 	/// Error reporter from CompilerStack.
 	/// We need to append m_uniqueErrorReporter
 	/// to this one when the analysis is done.
@@ -90,6 +108,18 @@ private:
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
+	/// Cache of the results of solver queries, if a cache directory is given in the settings.
+	std::unique_ptr<smt::QueryCache> m_queryCache;
+
+	/// Time budgets shared by the engines.
+	smt::TimeBudget m_timeBudget;
+
+	/// Statistics collected by the engines, if requested in the settings.
+	std::optional<smt::Statistics> m_statistics;
+
+	/// Solver processes that answer the queries of the engines, if requested in the settings.
+	std::unique_ptr<smtutil::SolverProcessPool> m_solverProcesses;
+
 	/// Bounded Model Checker engine.
 	BMC m_bmc;
 
@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <set>
 
@@ -142,7 +144,14 @@ struct ModelCheckerTargets
 
 struct ModelCheckerSettings
 {
+	/// Directory in which the results of solver queries are cached across compilations.
+	std::optional<boost::filesystem::path> cacheDirectory;
+	/// Wall-clock time in milliseconds that BMC may spend on the verification targets of a contract.
+	std::optional<unsigned> contractTimeBudget;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
+	/// Maximum number of violated targets per engine that are reported with a counterexample.
+	/// The targets found after that are only reported as violated.
+	std::optional<unsigned> counterexampleLimit;
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
 	/// where k and m are slack variables.
@@ -151,24 +160,53 @@ struct ModelCheckerSettings
 	/// might prefer the precise encoding.
 	bool divModNoSlacks = false;
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
+	/// Stores the invariants found by CHC in the cache directory and tries to prove
+	/// the targets of later runs with them before querying the Horn solver.
+	bool invariantHints = false;
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// Collects the number of queries, their size, the solver time and the outcome
+	/// of every verification target.
+	bool printStats = false;
 	bool showUnproved = false;
+	/// Queries every CHC target in a solver of its own that only contains the clauses
+	/// in the cone of influence of its error predicate.
+	bool sliceHornClauses = false;
+	/// Memory limit in MiB of every solver process.
+	std::optional<unsigned> solverMemoryLimit;
+	/// Number of z3 processes that answer the queries of the model checker as SMT-LIB2 scripts
+	/// instead of the solvers linked into the compiler.
+	std::optional<unsigned> solverProcesses;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
+	/// Wall-clock time in milliseconds that the model checker may spend on verification targets in total.
+	std::optional<unsigned> timeBudget;
 	std::optional<unsigned> timeout;
+	/// By default, BMC queries all enabled SMT solvers one after the other and reports conflicting answers.
+	/// This option races them instead and uses the first answer, which is not deterministic.
+	bool raceSolvers = false;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			cacheDirectory == _other.cacheDirectory &&
+			contractTimeBudget == _other.contractTimeBudget &&
 			contracts == _other.contracts &&
+			counterexampleLimit == _other.counterexampleLimit &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
+			invariantHints == _other.invariantHints &&
 			invariants == _other.invariants &&
+			printStats == _other.printStats &&
 			showUnproved == _other.showUnproved &&
+			sliceHornClauses == _other.sliceHornClauses &&
+			solverMemoryLimit == _other.solverMemoryLimit &&
+			solverProcesses == _other.solverProcesses &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeBudget == _other.timeBudget &&
+			timeout == _other.timeout &&
+			raceSolvers == _other.raceSolvers;
 	}
 };
 
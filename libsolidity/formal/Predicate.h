@@ -210,7 +210,9 @@ private:
 
 	/// Maps the name of the predicate to the actual Predicate.
 	/// Used in counterexample generation.
-	static std::map<std::string, Predicate> m_predicates;
+	/// The predicates are created and used by the thread that runs the model checker, so that
+	/// compilations on other threads do not interfere.
+	static thread_local std::map<std::string, Predicate> m_predicates;
 
 	/// The scope stack when the predicate was created.
 	/// Used to identify the subset of variables in scope.
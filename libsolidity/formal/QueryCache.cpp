@@ -0,0 +1,500 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/QueryCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+using namespace solidity::frontend;
+using namespace solidity::frontend::smt;
+
+namespace
+{
+
+struct InvalidEntry {};
+
+/// Converts expressions into JSON. Every distinct sort is only written once, into the
+/// table returned by sorts(), and referred to by its index in the table.
+class ExpressionWriter
+{
+public:
+	Json::Value write(Expression const& _expression)
+	{
+		Json::Value json{Json::arrayValue};
+		json.append(_expression.name);
+		json.append(sortIndex(_expression.sort));
+		for (Expression const& argument: _expression.arguments)
+			json.append(write(argument));
+		return json;
+	}
+
+	Json::Value::UInt sortIndex(SortPointer const& _sort)
+	{
+		if (auto index = m_indicesBySort.find(_sort.get()); index != m_indicesBySort.end())
+			return index->second;
+
+		Json::Value json = writeSort(*_sort);
+		auto [index, inserted] = m_indices.emplace(jsonCompactPrint(json), m_sorts.size());
+		if (inserted)
+			m_sorts.append(move(json));
+		m_indicesBySort[_sort.get()] = index->second;
+		return index->second;
+	}
+
+	Json::Value const& sorts() const { return m_sorts; }
+
+private:
+	Json::Value writeSort(Sort const& _sort)
+	{
+		Json::Value json{Json::arrayValue};
+		switch (_sort.kind)
+		{
+		case Kind::Int:
+			json.append("Int");
+			json.append(dynamic_cast<IntSort const&>(_sort).isSigned);
+			break;
+		case Kind::Bool:
+			json.append("Bool");
+			break;
+		case Kind::BitVector:
+			json.append("BitVector");
+			json.append(dynamic_cast<BitVectorSort const&>(_sort).size);
+			break;
+		case Kind::Function:
+		{
+			auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+			json.append("Function");
+			json.append(sortIndex(functionSort.codomain));
+			for (SortPointer const& domain: functionSort.domain)
+				json.append(sortIndex(domain));
+			break;
+		}
+		case Kind::Array:
+		{
+			auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+			json.append("Array");
+			json.append(sortIndex(arraySort.domain));
+			json.append(sortIndex(arraySort.range));
+			break;
+		}
+		case Kind::Sort:
+			json.append("Sort");
+			json.append(sortIndex(dynamic_cast<SortSort const&>(_sort).inner));
+			break;
+		case Kind::Tuple:
+		{
+			auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+			json.append("Tuple");
+			json.append(tupleSort.name);
+			Json::Value members{Json::arrayValue};
+			for (string const& member: tupleSort.members)
+				members.append(member);
+			json.append(move(members));
+			Json::Value components{Json::arrayValue};
+			for (SortPointer const& component: tupleSort.components)
+				components.append(sortIndex(component));
+			json.append(move(components));
+			break;
+		}
+		}
+		return json;
+	}
+
+	Json::Value m_sorts{Json::arrayValue};
+	map<string, Json::Value::UInt> m_indices;
+	map<Sort const*, Json::Value::UInt> m_indicesBySort;
+};
+
+/// Converts JSON written by ExpressionWriter back into expressions.
+/// Throws on malformed input.
+class ExpressionReader
+{
+public:
+	explicit ExpressionReader(Json::Value const& _sorts)
+	{
+		if (!_sorts.isArray())
+			throw InvalidEntry{};
+		for (Json::Value const& sort: _sorts)
+			m_sorts.push_back(readSort(sort));
+	}
+
+	Expression read(Json::Value const& _json) const
+	{
+		if (!_json.isArray() || _json.size() < 2)
+			throw InvalidEntry{};
+		vector<Expression> arguments;
+		for (Json::Value::ArrayIndex i = 2; i < _json.size(); ++i)
+			arguments.push_back(read(_json[i]));
+		return Expression(_json[0].asString(), move(arguments), sort(_json[1]));
+	}
+
+private:
+	SortPointer readSort(Json::Value const& _sort) const
+	{
+		if (!_sort.isArray() || _sort.empty())
+			throw InvalidEntry{};
+		string kind = _sort[0].asString();
+		if (kind == "Int")
+			return SortProvider::intSort(_sort[1].asBool());
+		else if (kind == "Bool")
+			return SortProvider::boolSort;
+		else if (kind == "BitVector")
+			return make_shared<BitVectorSort>(_sort[1].asUInt());
+		else if (kind == "Function")
+		{
+			vector<SortPointer> domain;
+			for (Json::Value::ArrayIndex i = 2; i < _sort.size(); ++i)
+				domain.push_back(sort(_sort[i]));
+			return make_shared<FunctionSort>(move(domain), sort(_sort[1]));
+		}
+		else if (kind == "Array")
+			return make_shared<ArraySort>(sort(_sort[1]), sort(_sort[2]));
+		else if (kind == "Sort")
+			return make_shared<SortSort>(sort(_sort[1]));
+		else if (kind == "Tuple")
+		{
+			vector<string> members;
+			for (Json::Value const& member: _sort[2])
+				members.push_back(member.asString());
+			vector<SortPointer> components;
+			for (Json::Value const& component: _sort[3])
+				components.push_back(sort(component));
+			if (members.size() != components.size())
+				throw InvalidEntry{};
+			return make_shared<TupleSort>(_sort[1].asString(), move(members), move(components));
+		}
+		throw InvalidEntry{};
+	}
+
+	/// @returns the sort with the given index, which has to precede the sort that is being read.
+	SortPointer sort(Json::Value const& _index) const
+	{
+		if (!_index.isUInt() || _index.asUInt() >= m_sorts.size())
+			throw InvalidEntry{};
+		return m_sorts[_index.asUInt()];
+	}
+
+	vector<SortPointer> m_sorts;
+};
+
+Json::Value toJson(ModelCheckerSettings const& _settings)
+{
+	Json::Value json{Json::objectValue};
+	json["timeout"] = _settings.timeout ? Json::Value(*_settings.timeout) : Json::Value();
+	return json;
+}
+
+h256 hashKey(Json::Value const& _key)
+{
+	return keccak256(frontend::VersionString + '\0' + jsonCompactPrint(_key));
+}
+
+string resultToString(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
+		return "sat";
+	case CheckResult::UNSATISFIABLE:
+		return "unsat";
+	case CheckResult::UNKNOWN:
+		return "unknown";
+	default:
+		return {};
+	}
+}
+
+CheckResult resultFromString(string const& _result)
+{
+	if (_result == "sat")
+		return CheckResult::SATISFIABLE;
+	else if (_result == "unsat")
+		return CheckResult::UNSATISFIABLE;
+	else if (_result == "unknown")
+		return CheckResult::UNKNOWN;
+	throw InvalidEntry{};
+}
+
+/// @returns true if queries with the result @a _result can be cached.
+bool isCacheable(ModelCheckerSettings const& _settings, CheckResult _result)
+{
+	// A timeout in milliseconds or a time budget, which can shorten the timeout,
+	// makes unknown results depend on the speed of the machine.
+	return
+		_result == CheckResult::SATISFIABLE ||
+		_result == CheckResult::UNSATISFIABLE ||
+		(_result == CheckResult::UNKNOWN && !_settings.timeout && !_settings.timeBudget && !_settings.contractTimeBudget);
+}
+
+}
+
+QueryCache::QueryCache(boost::filesystem::path _directory):
+	m_cache(move(_directory), maxEntries)
+{
+}
+
+h256 QueryCache::bmcKey(
+	ModelCheckerSettings const& _settings,
+	vector<pair<string, SortPointer>> const& _declarations,
+	Expression const& _condition,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	ExpressionWriter writer;
+	Json::Value key{Json::objectValue};
+	key["engine"] = "bmc";
+	key["settings"] = toJson(_settings);
+	key["settings"]["solvers"]["cvc4"] = _settings.solvers.cvc4;
+	key["settings"]["solvers"]["smtlib2"] = _settings.solvers.smtlib2;
+	key["settings"]["solvers"]["z3"] = _settings.solvers.z3;
+	key["settings"]["raceSolvers"] = _settings.raceSolvers;
+	key["declarations"] = Json::arrayValue;
+	for (auto const& [name, sort]: _declarations)
+	{
+		Json::Value declaration{Json::arrayValue};
+		declaration.append(name);
+		declaration.append(writer.sortIndex(sort));
+		key["declarations"].append(move(declaration));
+	}
+	key["condition"] = writer.write(_condition);
+	key["expressionsToEvaluate"] = Json::arrayValue;
+	for (Expression const& expression: _expressionsToEvaluate)
+		key["expressionsToEvaluate"].append(writer.write(expression));
+	key["sorts"] = writer.sorts();
+	return hashKey(key);
+}
+
+optional<QueryCache::BMCResult> QueryCache::lookupBMC(h256 const& _key)
+{
+	optional<BMCResult> result;
+	lookup(_key, [&](string const& _entry) {
+		Json::Value entry;
+		if (!jsonParseStrict(_entry, entry) || !entry["values"].isArray())
+			return false;
+		try
+		{
+			vector<string> values;
+			for (Json::Value const& value: entry["values"])
+				values.push_back(value.asString());
+			result.emplace(resultFromString(entry["result"].asString()), move(values));
+		}
+		catch (...)
+		{
+			return false;
+		}
+		return true;
+	});
+	return result;
+}
+
+void QueryCache::storeBMC(ModelCheckerSettings const& _settings, h256 const& _key, BMCResult const& _result)
+{
+	if (!isCacheable(_settings, _result.first))
+		return;
+
+	Json::Value entry{Json::objectValue};
+	entry["result"] = resultToString(_result.first);
+	entry["values"] = Json::arrayValue;
+	for (string const& value: _result.second)
+		entry["values"].append(value);
+	store(_key, jsonCompactPrint(entry));
+}
+
+h256 QueryCache::hashHornClause(
+	h256 const& _clausesHash,
+	Expression const& _clause,
+	optional<string> const& _ruleName
+)
+{
+	ExpressionWriter writer;
+	Json::Value clause{Json::objectValue};
+	clause["clause"] = writer.write(_clause);
+	clause["rule"] = _ruleName ? Json::Value(*_ruleName) : Json::Value();
+	clause["sorts"] = writer.sorts();
+	return keccak256(_clausesHash.hex() + '\0' + jsonCompactPrint(clause));
+}
+
+h256 QueryCache::chcKey(
+	ModelCheckerSettings const& _settings,
+	h256 const& _clausesHash,
+	Expression const& _query
+)
+{
+	ExpressionWriter writer;
+	Json::Value key{Json::objectValue};
+	key["engine"] = "chc";
+	key["settings"] = toJson(_settings);
+	// The system of a sliced query consists of a subset of the clauses hashed into the key.
+	key["settings"]["sliceHornClauses"] = _settings.sliceHornClauses;
+	key["clauses"] = _clausesHash.hex();
+	key["query"] = writer.write(_query);
+	key["sorts"] = writer.sorts();
+	return hashKey(key);
+}
+
+optional<QueryCache::CHCResult> QueryCache::lookupCHC(h256 const& _key)
+{
+	optional<CHCResult> result;
+	lookup(_key, [&](string const& _entry) {
+		Json::Value entry;
+		if (!jsonParseStrict(_entry, entry))
+			return false;
+		try
+		{
+			ExpressionReader reader(entry["sorts"]);
+			CHCSolverInterface::CexGraph counterexample;
+			for (Json::Value const& node: entry["counterexample"]["nodes"])
+				counterexample.nodes.emplace(node[0].asUInt(), reader.read(node[1]));
+			for (Json::Value const& edges: entry["counterexample"]["edges"])
+			{
+				vector<unsigned> children;
+				for (Json::Value const& child: edges[1])
+					children.push_back(child.asUInt());
+				counterexample.edges.emplace(edges[0].asUInt(), move(children));
+			}
+			result.emplace(
+				resultFromString(entry["result"].asString()),
+				reader.read(entry["invariant"]),
+				move(counterexample)
+			);
+		}
+		catch (...)
+		{
+			return false;
+		}
+		return true;
+	});
+	return result;
+}
+
+void QueryCache::storeCHC(ModelCheckerSettings const& _settings, h256 const& _key, CHCResult const& _result)
+{
+	auto const& [result, invariant, counterexample] = _result;
+	if (!isCacheable(_settings, result))
+		return;
+
+	ExpressionWriter writer;
+	Json::Value entry{Json::objectValue};
+	entry["result"] = resultToString(result);
+	entry["invariant"] = writer.write(invariant);
+	entry["counterexample"]["nodes"] = Json::arrayValue;
+	for (auto const& [id, node]: counterexample.nodes)
+	{
+		Json::Value json{Json::arrayValue};
+		json.append(id);
+		json.append(writer.write(node));
+		entry["counterexample"]["nodes"].append(move(json));
+	}
+	entry["counterexample"]["edges"] = Json::arrayValue;
+	for (auto const& [id, children]: counterexample.edges)
+	{
+		Json::Value json{Json::arrayValue};
+		json.append(id);
+		json.append(Json::arrayValue);
+		for (unsigned child: children)
+			json[1].append(child);
+		entry["counterexample"]["edges"].append(move(json));
+	}
+	entry["sorts"] = writer.sorts();
+	store(_key, jsonCompactPrint(entry));
+}
+
+h256 QueryCache::invariantsKey(string const& _sourceName)
+{
+	Json::Value key{Json::objectValue};
+	key["engine"] = "chc";
+	key["invariants"] = _sourceName;
+	return hashKey(key);
+}
+
+optional<QueryCache::Invariants> QueryCache::lookupInvariants(h256 const& _key)
+{
+	optional<Invariants> invariants;
+	lookup(_key, [&](string const& _entry) {
+		Json::Value entry;
+		if (!jsonParseStrict(_entry, entry) || !entry["invariants"].isArray())
+			return false;
+		try
+		{
+			ExpressionReader reader(entry["sorts"]);
+			invariants.emplace();
+			for (Json::Value const& invariant: entry["invariants"])
+			{
+				// The sort of the predicate is read as an expression without arguments.
+				Expression predicate = reader.read(invariant[0]);
+				invariants->emplace(predicate.name, make_pair(predicate.sort, reader.read(invariant[1])));
+			}
+		}
+		catch (...)
+		{
+			invariants.reset();
+			return false;
+		}
+		return true;
+	});
+	return invariants;
+}
+
+void QueryCache::storeInvariants(h256 const& _key, Invariants const& _invariants)
+{
+	ExpressionWriter writer;
+	Json::Value entry{Json::objectValue};
+	entry["invariants"] = Json::arrayValue;
+	for (auto const& [predicate, invariant]: _invariants)
+	{
+		Json::Value json{Json::arrayValue};
+		json.append(writer.write(Expression(predicate, {}, invariant.first)));
+		json.append(writer.write(invariant.second));
+		entry["invariants"].append(move(json));
+	}
+	entry["sorts"] = writer.sorts();
+	store(_key, jsonCompactPrint(entry));
+}
+
+void QueryCache::flush()
+{
+	map<h256, string> entries;
+	{
+		lock_guard lock(m_mutex);
+		swap(entries, m_newEntries);
+	}
+	m_cache.store(entries);
+}
+
+optional<string> QueryCache::lookup(h256 const& _key, function<bool(string const&)> const& _isValid)
+{
+	{
+		lock_guard lock(m_mutex);
+		if (auto entry = m_newEntries.find(_key); entry != m_newEntries.end())
+			return _isValid(entry->second) ? make_optional(entry->second) : nullopt;
+	}
+	return m_cache.lookup(_key, _isValid);
+}
+
+void QueryCache::store(h256 const& _key, string _entry)
+{
+	lock_guard lock(m_mutex);
+	m_newEntries[_key] = move(_entry);
+}
@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Persistent cache of the results of the solver queries of the model checker.
+ *
+ * A query is identified by a hash of everything the solver is given (declarations, assertions
+ * or Horn clauses, the expressions to evaluate), the solver settings and the compiler version,
+ * so a query that is repeated in a later run, e.g. after an unrelated change of the sources,
+ * is answered without calling a solver. Failed queries are not cached, and neither are
+ * unknown results if a timeout other than the deterministic resource limit is used.
+ *
+ * The cache also keeps the invariants that CHC found for the predicates of a source unit,
+ * which are only hints and replaced whenever the source unit is checked again.
+ *
+ * Lookups and stores can happen on multiple threads. New entries are only written
+ * to the cache directory by flush().
+ */
+class QueryCache
+{
+public:
+	using BMCResult = std::pair<smtutil::CheckResult, std::vector<std::string>>;
+	using CHCResult = std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph>;
+	/// Formulas by predicate, together with the sort of the predicate.
+	using Invariants = std::map<std::string, std::pair<smtutil::SortPointer, smtutil::Expression>>;
+
+	explicit QueryCache(boost::filesystem::path _directory);
+
+	/// @returns the key of a BMC query that checks @a _condition, using the variables and
+	/// functions in @a _declarations, and evaluates @a _expressionsToEvaluate in the model.
+	static util::h256 bmcKey(
+		ModelCheckerSettings const& _settings,
+		std::vector<std::pair<std::string, smtutil::SortPointer>> const& _declarations,
+		smtutil::Expression const& _condition,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
+	std::optional<BMCResult> lookupBMC(util::h256 const& _key);
+	void storeBMC(ModelCheckerSettings const& _settings, util::h256 const& _key, BMCResult const& _result);
+
+	/// @returns the hash of a system of Horn clauses that consists of the clauses hashed into
+	/// @a _clausesHash followed by the rule @a _clause named @a _ruleName, or the relation
+	/// @a _clause if no name is given.
+	static util::h256 hashHornClause(
+		util::h256 const& _clausesHash,
+		smtutil::Expression const& _clause,
+		std::optional<std::string> const& _ruleName
+	);
+	/// @returns the key of a CHC query for the reachability of @a _query in the system of
+	/// Horn clauses with the hash @a _clausesHash.
+	static util::h256 chcKey(
+		ModelCheckerSettings const& _settings,
+		util::h256 const& _clausesHash,
+		smtutil::Expression const& _query
+	);
+	std::optional<CHCResult> lookupCHC(util::h256 const& _key);
+	void storeCHC(ModelCheckerSettings const& _settings, util::h256 const& _key, CHCResult const& _result);
+
+	/// @returns the key of the invariants found for the predicates of the source unit @a _sourceName.
+	static util::h256 invariantsKey(std::string const& _sourceName);
+	std::optional<Invariants> lookupInvariants(util::h256 const& _key);
+	void storeInvariants(util::h256 const& _key, Invariants const& _invariants);
+
+	/// Writes the entries stored since the last call to the cache directory.
+	void flush();
+
+private:
+	std::optional<std::string> lookup(util::h256 const& _key, std::function<bool(std::string const&)> const& _isValid);
+	void store(util::h256 const& _key, std::string _entry);
+
+	static size_t constexpr maxEntries = 100000;
+
+	CompilationCache m_cache;
+	std::mutex m_mutex;
+	std::map<util::h256, std::string> m_newEntries;
+};
+
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/Statistics.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+using namespace solidity::frontend;
+using namespace solidity::frontend::smt;
+
+Statistics::Target Statistics::target(
+	string _engine,
+	VerificationTargetType _type,
+	langutil::SourceLocation _location,
+	size_t _size
+)
+{
+	Target target;
+	target.engine = move(_engine);
+	for (auto const& [name, type]: ModelCheckerTargets::targetStrings)
+		if (type == _type)
+			target.type = name;
+	solAssert(!target.type.empty(), "");
+	target.location = move(_location);
+	target.size = _size;
+	return target;
+}
+
+string Statistics::outcome(CheckResult _result, optional<unsigned> _timeout, Duration _time)
+{
+	switch (_result)
+	{
+	case CheckResult::UNSATISFIABLE:
+		return "safe";
+	case CheckResult::SATISFIABLE:
+		return "unsafe";
+	case CheckResult::UNKNOWN:
+		// A timeout of 0 means that there is no timeout.
+		if (_timeout && *_timeout > 0 && _time >= chrono::milliseconds(*_timeout))
+			return "timeout";
+		return "unknown";
+	case CheckResult::CONFLICTING:
+		return "conflicting";
+	case CheckResult::ERROR:
+		return "error";
+	}
+	solAssert(false, "");
+	return "";
+}
+
+void Statistics::add(Target _target, CheckResult _result, optional<unsigned> _timeout)
+{
+	_target.outcome = outcome(_result, _timeout, _target.time);
+	_target.cached = _target.queries == 0;
+	m_targets.push_back(move(_target));
+}
+
+void Statistics::addSkipped(Target _target)
+{
+	_target.outcome = "skipped";
+	m_targets.push_back(move(_target));
+}
+
+map<string, Statistics::Totals> Statistics::totals() const
+{
+	map<string, Totals> totals;
+	for (Target const& target: m_targets)
+	{
+		Totals& engine = totals[target.engine];
+		++engine.targets;
+		engine.queries += target.queries;
+		engine.time += target.time;
+	}
+	return totals;
+}
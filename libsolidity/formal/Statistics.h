@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Statistics of the verification targets checked by the model checker: the number of solver
+ * queries of every target, the size of its encoding, the time spent in the solvers and the outcome.
+ *
+ * The queries of a target are measured into its own entry, possibly on another thread, and the
+ * entries are added on the thread running the analysis in the order in which the targets are
+ * reported, so that only the times differ between runs.
+ */
+class Statistics
+{
+public:
+	using Duration = std::chrono::nanoseconds;
+
+	struct Target
+	{
+		/// "bmc" or "chc".
+		std::string engine;
+		/// The name of the type of the target in the model checker settings.
+		std::string type;
+		langutil::SourceLocation location;
+		/// The number of solver queries, which is zero if the result was taken from the query cache.
+		size_t queries = 0;
+		/// The number of distinct subexpressions of the encoding.
+		size_t size = 0;
+		Duration time{0};
+		/// "safe", "unsafe", "unknown", "timeout", "conflicting", "error" or "skipped".
+		std::string outcome;
+		bool cached = false;
+	};
+
+	struct Totals
+	{
+		size_t targets = 0;
+		size_t queries = 0;
+		Duration time{0};
+	};
+
+	/// @returns an entry for the target of type @a _type at @a _location checked by @a _engine,
+	/// whose encoding has @a _size subexpressions.
+	static Target target(
+		std::string _engine,
+		VerificationTargetType _type,
+		langutil::SourceLocation _location,
+		size_t _size
+	);
+
+	/// Runs the solver query @a _query and counts it and its time into @a _target, unless it is null.
+	/// @returns the result of @a _query.
+	template <typename Query>
+	static auto measure(Target* _target, Query const& _query)
+	{
+		if (!_target)
+			return _query();
+		auto start = std::chrono::steady_clock::now();
+		auto result = _query();
+		_target->time += std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start);
+		++_target->queries;
+		return result;
+	}
+
+	/// @returns the outcome of a target with the result @a _result whose queries ran for @a _time
+	/// with the timeout @a _timeout in milliseconds. An unknown result counts as a timeout
+	/// if the queries ran for at least the timeout.
+	static std::string outcome(smtutil::CheckResult _result, std::optional<unsigned> _timeout, Duration _time);
+
+	/// Adds @a _target with the result @a _result of its queries, which ran with the timeout @a _timeout.
+	void add(Target _target, smtutil::CheckResult _result, std::optional<unsigned> _timeout);
+	/// Adds @a _target, which was not checked since the time budget was used up.
+	void addSkipped(Target _target);
+
+	std::vector<Target> const& targets() const { return m_targets; }
+	/// @returns the number of targets and queries and the solver time by engine.
+	std::map<std::string, Totals> totals() const;
+
+private:
+	std::vector<Target> m_targets;
+};
+
+}
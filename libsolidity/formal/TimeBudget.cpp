@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/TimeBudget.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+using namespace solidity::frontend::smt;
+
+TimeBudget::TimeBudget(ModelCheckerSettings const& _settings):
+	m_timeout(_settings.timeout),
+	m_runBudget(_settings.timeBudget),
+	m_contractBudget(_settings.contractTimeBudget)
+{
+}
+
+void TimeBudget::startRun()
+{
+	if (m_runBudget && !m_runDeadline)
+		m_runDeadline = Clock::now() + chrono::milliseconds(*m_runBudget);
+}
+
+void TimeBudget::startContract()
+{
+	if (m_contractBudget)
+		m_contractDeadline = Clock::now() + chrono::milliseconds(*m_contractBudget);
+}
+
+bool TimeBudget::exhausted() const
+{
+	auto left = remaining();
+	return left && left->count() <= 0;
+}
+
+optional<unsigned> TimeBudget::queryTimeout(size_t _remainingQueries, size_t _parallelism) const
+{
+	auto left = remaining();
+	if (!left)
+		return m_timeout;
+
+	// Queries that finish early leave their time to the later ones, which are the more expensive
+	// ones, since the queries are run in the order of their size.
+	auto leftMs = static_cast<unsigned long long>(max<chrono::milliseconds::rep>(left->count(), 1));
+	auto share = leftMs * max<size_t>(_parallelism, 1) / max<size_t>(_remainingQueries, 1);
+	auto timeout = static_cast<unsigned>(clamp<unsigned long long>(share, 1, min<unsigned long long>(leftMs, numeric_limits<unsigned>::max())));
+	// A timeout of 0 means that there is no timeout.
+	if (m_timeout && *m_timeout > 0)
+		timeout = min(timeout, *m_timeout);
+	return timeout;
+}
+
+size_t TimeBudget::querySize(vector<Expression> const& _expressions)
+{
+	// Subexpressions are shared, so the expressions are traversed as a graph.
+	set<vector<Expression> const*> visited;
+	vector<Expression const*> toVisit;
+	for (Expression const& expression: _expressions)
+		toVisit.push_back(&expression);
+	size_t size = 0;
+	while (!toVisit.empty())
+	{
+		Expression const* expression = toVisit.back();
+		toVisit.pop_back();
+		if (expression->arguments.empty())
+		{
+			++size;
+			continue;
+		}
+		if (!visited.insert(expression->arguments.shared().get()).second)
+			continue;
+		++size;
+		for (Expression const& argument: expression->arguments)
+			toVisit.push_back(&argument);
+	}
+	return size;
+}
+
+optional<chrono::milliseconds> TimeBudget::remaining() const
+{
+	optional<Clock::time_point> deadline = m_runDeadline;
+	if (m_contractDeadline && (!deadline || *m_contractDeadline < *deadline))
+		deadline = m_contractDeadline;
+	if (!deadline)
+		return nullopt;
+	return chrono::duration_cast<chrono::milliseconds>(*deadline - Clock::now());
+}
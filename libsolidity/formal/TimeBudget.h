@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Wall-clock time budgets of the model checker for the whole run and for the
+ * verification targets of a contract, and the query timeouts derived from them.
+ *
+ * The engines check the targets in the order of their estimated cost, give every query
+ * its share of the remaining time and skip the targets reached once a budget is used up.
+ * The budgets are only changed on the thread running the analysis and can be read
+ * from any thread.
+ */
+class TimeBudget
+{
+public:
+	explicit TimeBudget(ModelCheckerSettings const& _settings);
+
+	/// @returns true if a budget for the run or for contracts is set.
+	bool active() const { return m_runBudget || m_contractBudget; }
+	bool hasRunBudget() const { return m_runBudget.has_value(); }
+
+	/// Starts the budget of the run, unless it was started before.
+	void startRun();
+	/// Starts the budget of a contract, which applies until endContract() is called.
+	void startContract();
+	void endContract() { m_contractDeadline.reset(); }
+
+	/// @returns true if a budget that applies now is used up.
+	bool exhausted() const;
+	/// @returns the timeout in milliseconds for the next of @a _remainingQueries queries
+	/// that are run @a _parallelism at a time: the timeout of the settings, limited to the share
+	/// of the query in the time left.
+	std::optional<unsigned> queryTimeout(size_t _remainingQueries, size_t _parallelism) const;
+
+	/// @returns the number of distinct subexpressions of @a _expressions, which is used to
+	/// estimate the cost of a query.
+	static size_t querySize(std::vector<smtutil::Expression> const& _expressions);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/// @returns the time left until the earliest deadline, or nullopt if no deadline applies.
+	std::optional<std::chrono::milliseconds> remaining() const;
+
+	std::optional<unsigned> m_timeout;
+	std::optional<unsigned> m_runBudget;
+	std::optional<unsigned> m_contractBudget;
+	std::optional<Clock::time_point> m_runDeadline;
+	std::optional<Clock::time_point> m_contractDeadline;
+};
+
+}
@@ -46,7 +46,7 @@ Json::Value ABI::generate(ContractDefinition const& _contractDef)
 	};
 	multiset<Json::Value, decltype(compare)> abi(compare);
 
-	for (auto it: _contractDef.interfaceFunctions())
+	for (auto const& it: _contractDef.interfaceFunctions())
 	{
 		if (_contractDef.isLibrary() && (
 			it.second->stateMutability() > StateMutability::View ||
@@ -0,0 +1,199 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+string const g_entryExtension = ".json";
+string const g_statisticsFileName = "statistics.json";
+
+/// Writes the file through a temporary file, so that concurrent readers either see
+/// the old or the new content.
+bool writeFileAtomically(fs::path const& _path, string const& _content)
+{
+	fs::path temporary = _path;
+	temporary += "." + fs::unique_path().string() + ".tmp";
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << _content;
+		if (!file)
+			return false;
+	}
+	boost::system::error_code error;
+	fs::rename(temporary, _path, error);
+	if (error)
+		fs::remove(temporary, error);
+	return !error;
+}
+
+}
+
+CompilationCache::CompilationCache(fs::path _directory, size_t _maxEntries):
+	m_directory(move(_directory)),
+	m_maxEntries(_maxEntries)
+{
+}
+
+optional<string> CompilationCache::lookup(
+	util::h256 const& _key,
+	function<bool(string const&)> const& _isValid
+)
+{
+	fs::path path = entryPath(_key);
+	optional<string> content;
+	try
+	{
+		if (fs::is_regular_file(path))
+			content = util::readFileAsString(path);
+	}
+	catch (...)
+	{
+		content.reset();
+	}
+
+	if (content && _isValid && !_isValid(*content))
+		content.reset();
+
+	if (content)
+	{
+		// Mark the entry as recently used.
+		boost::system::error_code error;
+		fs::last_write_time(path, time(nullptr), error);
+		updateStatistics({1, 0, 0, 0});
+	}
+	else
+		updateStatistics({0, 1, 0, 0});
+	return content;
+}
+
+void CompilationCache::store(util::h256 const& _key, string const& _content)
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error || !writeFileAtomically(entryPath(_key), _content))
+		return;
+	size_t evictions = evict();
+	updateStatistics({0, 0, 1, evictions});
+}
+
+void CompilationCache::store(map<util::h256, string> const& _entries)
+{
+	if (_entries.empty())
+		return;
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+	size_t stores = 0;
+	for (auto const& [key, content]: _entries)
+		if (writeFileAtomically(entryPath(key), content))
+			++stores;
+	size_t evictions = evict();
+	updateStatistics({0, 0, stores, evictions});
+}
+
+CompilationCache::Statistics CompilationCache::statistics() const
+{
+	Statistics statistics;
+	Json::Value json;
+	try
+	{
+		fs::path path = m_directory / g_statisticsFileName;
+		if (!fs::is_regular_file(path) || !util::jsonParseStrict(util::readFileAsString(path), json))
+			return statistics;
+	}
+	catch (...)
+	{
+		return statistics;
+	}
+
+	auto const read = [&](char const* _name) -> size_t {
+		return json[_name].isUInt64() ? static_cast<size_t>(json[_name].asUInt64()) : 0;
+	};
+	statistics.hits = read("hits");
+	statistics.misses = read("misses");
+	statistics.stores = read("stores");
+	statistics.evictions = read("evictions");
+	return statistics;
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + g_entryExtension);
+}
+
+size_t CompilationCache::evict()
+{
+	vector<pair<time_t, fs::path>> entries;
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != g_entryExtension || path.filename() == g_statisticsFileName)
+			continue;
+		time_t lastUse = fs::last_write_time(path, error);
+		if (!error)
+			entries.emplace_back(lastUse, path);
+	}
+	if (entries.size() <= m_maxEntries)
+		return 0;
+
+	sort(entries.begin(), entries.end());
+	size_t evicted = 0;
+	for (size_t i = 0; i < entries.size() - m_maxEntries; ++i)
+		if (fs::remove(entries[i].second, error))
+			++evicted;
+	return evicted;
+}
+
+void CompilationCache::updateStatistics(Statistics const& _delta)
+{
+	Statistics statistics = this->statistics();
+	statistics.hits += _delta.hits;
+	statistics.misses += _delta.misses;
+	statistics.stores += _delta.stores;
+	statistics.evictions += _delta.evictions;
+
+	Json::Value json{Json::objectValue};
+	json["hits"] = Json::UInt64(statistics.hits);
+	json["misses"] = Json::UInt64(statistics.misses);
+	json["stores"] = Json::UInt64(statistics.stores);
+	json["evictions"] = Json::UInt64(statistics.evictions);
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (!error)
+		writeFileAtomically(m_directory / g_statisticsFileName, util::jsonCompactPrint(json));
+}
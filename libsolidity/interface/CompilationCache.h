@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent, content-addressed cache of compilation results.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Cache of compilation results stored as one file per entry inside a directory.
+ * Entries are addressed by a hash of everything that influences the result, so they are
+ * never invalidated, only evicted: once there are more than a given number of entries,
+ * the least recently used ones are removed.
+ *
+ * Failures to access the file system are not reported and just result in cache misses.
+ * The cache directory can be shared between processes, although the statistics
+ * might then be slightly off.
+ */
+class CompilationCache
+{
+public:
+	/// Cumulative statistics, persisted in the cache directory.
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t stores = 0;
+		size_t evictions = 0;
+	};
+
+	static size_t constexpr defaultMaxEntries = 1000;
+
+	explicit CompilationCache(boost::filesystem::path _directory, size_t _maxEntries = defaultMaxEntries);
+
+	/// @returns the content stored under @a _key, provided that it exists and
+	/// @a _isValid (if given) returns true for it.
+	std::optional<std::string> lookup(
+		util::h256 const& _key,
+		std::function<bool(std::string const&)> const& _isValid = {}
+	);
+
+	/// Stores @a _content under @a _key and evicts the least recently used entries
+	/// if the maximum number of entries is exceeded.
+	void store(util::h256 const& _key, std::string const& _content);
+	/// Stores all of @a _entries and evicts only once afterwards.
+	void store(std::map<util::h256, std::string> const& _entries);
+
+	Statistics statistics() const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Removes the least recently used entries until at most m_maxEntries are left.
+	/// @returns the number of removed entries.
+	size_t evict();
+	void updateStatistics(Statistics const& _delta);
+
+	boost::filesystem::path m_directory;
+	size_t m_maxEntries;
+};
+
+}
@@ -53,6 +53,7 @@
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 
@@ -63,6 +64,7 @@
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/OptimizedObjectCache.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 
@@ -76,16 +78,21 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
 #include <range/v3/view/concat.hpp>
+#include <range/v3/view/map.hpp>
 
 #include <utility>
 #include <map>
 #include <limits>
+#include <mutex>
+#include <set>
 #include <string>
 
 using namespace std;
@@ -96,21 +103,32 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+
+/// The types are shared by all users of a TypeProvider, so we must ensure that
+/// no more than one compiler stack is actually using a TypeProvider at a time.
+mutex g_typeProvidersInUseMutex;
+set<TypeProvider const*> g_typeProvidersInUse;
+
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
+	m_typeProvider{TypeProvider::instance()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	lock_guard lock(g_typeProvidersInUseMutex);
+	solAssert(g_typeProvidersInUse.insert(&m_typeProvider).second, "You shall not have another CompilerStack aside me.");
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
+	{
+		lock_guard lock(g_typeProvidersInUseMutex);
+		g_typeProvidersInUse.erase(&m_typeProvider);
+	}
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -218,6 +236,36 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set parallelism before parsing.");
+	solAssert(_parallelism > 0, "");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setReadCallbackThreadSafe(bool _threadSafe)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set the thread safety of the read callback before parsing.");
+	m_readCallbackThreadSafe = _threadSafe;
+}
+
+void CompilerStack::setOptimizedObjectCacheDirectory(boost::filesystem::path _directory)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the cache directory before compiling.");
+	m_optimizedObjectCacheDirectory = move(_directory);
+}
+
+void CompilerStack::enableProfiling(bool _enable)
+{
+	if (!_enable)
+		m_profiler.reset();
+	else if (!m_profiler)
+		m_profiler = make_unique<util::Profiler>();
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -232,6 +280,26 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 	m_modelCheckerSettings = _settings;
 }
 
+void CompilerStack::setModelCheckingEnabled(bool _enabled)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must enable or disable model checking before parsing.");
+	m_modelCheckingEnabled = _enabled;
+}
+
+void CompilerStack::setSuppressedWarnings(set<ErrorId> _errorIds)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set suppressed warnings before parsing.");
+	m_suppressedWarnings = move(_errorIds);
+	if (m_suppressedWarnings.empty())
+		m_errorReporter.setSuppressionFilter({});
+	else
+		m_errorReporter.setSuppressionFilter([this](ErrorId _error, Error::Type) {
+			return m_suppressedWarnings.count(_error) > 0;
+		});
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -294,16 +362,29 @@ void CompilerStack::reset(bool _keepSettings)
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
+	m_prefetchedSources.clear();
+	m_metadataEntriesByKeccak256.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_modelCheckerStatistics.reset();
 	if (!_keepSettings)
 	{
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_readCallbackThreadSafe = false;
+		m_optimizedObjectCacheDirectory.reset();
+		m_profiler.reset();
+		m_progressCallback = {};
+		m_contractCompiledCallback = {};
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
+		m_modelCheckingEnabled = true;
+		m_suppressedWarnings.clear();
+		m_errorReporter.setSuppressionFilter({});
 		m_generateIR = false;
+		m_generateOptimizedIR = false;
 		m_generateEwasm = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
@@ -314,7 +395,12 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_optimizedObjectCache.reset();
+	m_sharedIRFunctions.reset();
+	if (m_profiler)
+		m_profiler = make_unique<util::Profiler>();
 	m_errorReporter.clear();
+	TypeProvider::Scope typeProviderScope(m_typeProvider);
 	TypeProvider::reset();
 }
 
@@ -324,7 +410,7 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
 	m_stackState = SourcesSet;
 }
@@ -335,25 +421,24 @@ bool CompilerStack::parse()
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
 
+	checkpoint("parsing");
+	util::Profiler::Scope profilerScope(m_profiler.get());
+	util::Profiler::Timer timer("parsing");
+
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
-	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
+	auto const processParsedSource = [&](string const& _path) {
+		Source& source = m_sources[_path];
 		if (!source.ast)
 			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
-			source.ast->annotation().path = path;
+			source.ast->annotation().path = _path;
 
 			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
 			{
@@ -364,19 +449,90 @@ bool CompilerStack::parse()
 				// as seen globally.
 				import->annotation().absolutePath = applyRemapping(util::absolutePath(
 					import->path(),
-					path
-				), path);
+					_path
+				), _path);
 			}
 
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+				for (auto& newSource: loadMissingSources(*source.ast))
 				{
 					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
+					m_sources[newPath].charStream = make_shared<CharStream>(std::move(newSource.second), newPath);
 					sourcesToParse.push_back(newPath);
 				}
 		}
+	};
+
+	if (m_parallelism <= 1)
+	{
+		Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		{
+			string const path = sourcesToParse[i];
+			m_sources[path].ast = parser.parse(*m_sources[path].charStream);
+			processParsedSource(path);
+		}
+	}
+	else
+	{
+		// Sources are parsed in waves: All sources known so far are parsed in parallel, each by
+		// its own parser and error reporter. The results are then processed in the order a
+		// single parser would have produced them, which also discovers the sources for the next wave.
+		// Node IDs are shifted such that they are identical to the ones of a sequential run.
+		int64_t nodeIDOffset = 0;
+		for (size_t waveStart = 0; waveStart < sourcesToParse.size();)
+		{
+			size_t const waveEnd = sourcesToParse.size();
+			vector<ErrorList> errors(waveEnd - waveStart);
+			vector<int64_t> nodeIDCounts(waveEnd - waveStart);
+			vector<vector<ASTNode*>> nodes(waveEnd - waveStart);
+			yul::YulStringRepository& yulStrings = yul::YulStringRepository::instance();
+			util::parallelForEach(waveEnd - waveStart, m_parallelism, [&](size_t _index) {
+				yul::YulStringRepository::Scope yulStringScope(yulStrings);
+				ErrorReporter errorReporter(errors[_index]);
+				Parser parser{errorReporter, m_evmVersion, m_parserErrorRecovery};
+				parser.trackNodes();
+				Source& source = m_sources.at(sourcesToParse[waveStart + _index]);
+				source.ast = parser.parse(*source.charStream);
+				nodeIDCounts[_index] = parser.nodeIDCount();
+				nodes[_index] = parser.trackedNodes();
+			});
+
+			if (m_readCallbackThreadSafe && m_readFile && m_stopAfter >= ParsedAndImported)
+			{
+				// All imports of the wave that are not known yet are read concurrently. The
+				// results are used by loadMissingSources in the order of a sequential run.
+				vector<string> importPaths;
+				set<string> seenImportPaths;
+				for (size_t i = waveStart; i < waveEnd; ++i)
+					if (ASTPointer<SourceUnit> const& ast = m_sources.at(sourcesToParse[i]).ast)
+						for (auto const& import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+						{
+							string importPath = applyRemapping(util::absolutePath(import->path(), sourcesToParse[i]), sourcesToParse[i]);
+							if (!m_sources.count(importPath) && seenImportPaths.insert(importPath).second)
+								importPaths.emplace_back(move(importPath));
+						}
+				vector<ReadCallback::Result> results(importPaths.size());
+				util::parallelForEach(importPaths.size(), m_parallelism, [&](size_t _index) {
+					results[_index] = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPaths[_index]);
+				});
+				for (size_t i = 0; i < importPaths.size(); ++i)
+					m_prefetchedSources[importPaths[i]] = move(results[i]);
+			}
+
+			for (size_t i = waveStart; i < waveEnd; ++i)
+			{
+				string const path = sourcesToParse[i];
+				m_errorReporter.append(errors[i - waveStart]);
+				if (nodeIDOffset != 0)
+					for (ASTNode* node: nodes[i - waveStart])
+						node->shiftID(nodeIDOffset);
+				nodeIDOffset += nodeIDCounts[i - waveStart];
+				processParsedSource(path);
+			}
+			waveStart = waveEnd;
+		}
+		m_prefetchedSources.clear();
 	}
 
 	if (m_stopAfter <= Parsed)
@@ -418,8 +574,17 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
+
+	checkpoint("analysis/importResolution");
+	util::Profiler::Scope profilerScope(m_profiler.get());
+	util::Profiler::Timer timer("analysis", "importResolution");
+	auto const startPhase = [&](string const& _phase) {
+		checkpoint("analysis/" + _phase);
+		timer.restart("analysis", _phase);
+	};
 	resolveImports();
 
+	startPhase("scoping");
 	for (Source const* source: m_sourceOrder)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
@@ -428,11 +593,13 @@ bool CompilerStack::analyze()
 
 	try
 	{
+		startPhase("syntaxChecking");
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
+		startPhase("nameAndTypeResolution");
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
@@ -449,22 +616,26 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
+		startPhase("docStringParsing");
 		DocStringTagParser docStringTagParser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
 		// Requires DocStringTagParser
+		startPhase("nameAndTypeResolution");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		startPhase("declarationTypeChecking");
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
 		// Requires DeclarationTypeChecker to have run
+		startPhase("docStringParsing");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
@@ -473,6 +644,7 @@ bool CompilerStack::analyze()
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		startPhase("contractLevelChecking");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 		for (Source const* source: m_sourceOrder)
@@ -480,6 +652,7 @@ bool CompilerStack::analyze()
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
+		startPhase("docStringAnalysis");
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -492,6 +665,7 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		startPhase("typeChecking");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
@@ -500,6 +674,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			startPhase("postTypeChecking");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !postTypeChecker.check(*source->ast))
@@ -511,10 +686,12 @@ bool CompilerStack::analyze()
 		// Create & assign callgraphs and check for contract dependency cycles
 		if (noErrors)
 		{
+			startPhase("callGraphs");
 			createAndAssignCallGraphs();
 			findAndReportCyclicContractDependencies();
 		}
 
+		startPhase("postTypeContractLevelChecking");
 		if (noErrors)
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
@@ -522,6 +699,7 @@ bool CompilerStack::analyze()
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
+		startPhase("immutableValidation");
 		if (noErrors)
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
@@ -533,6 +711,7 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			startPhase("controlFlowAnalysis");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !cfg.constructFlow(*source->ast))
@@ -543,7 +722,7 @@ bool CompilerStack::analyze()
 				ControlFlowRevertPruner pruner(cfg);
 				pruner.run();
 
-				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
+				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter, m_parallelism);
 				if (!controlFlowAnalyzer.run())
 					noErrors = false;
 			}
@@ -552,6 +731,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			startPhase("staticAnalysis");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !staticAnalyzer.analyze(*source->ast))
@@ -561,6 +741,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			startPhase("viewPureChecking");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
@@ -570,9 +751,10 @@ bool CompilerStack::analyze()
 				noErrors = false;
 		}
 
-		if (noErrors)
+		if (noErrors && m_modelCheckingEnabled)
 		{
-			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+			startPhase("modelChecking");
+			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_parallelism);
 			auto allSources = applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 			modelChecker.enableAllEnginesIfPragmaPresent(allSources);
 			modelChecker.checkRequestedSourcesAndContracts(allSources);
@@ -580,7 +762,12 @@ bool CompilerStack::analyze()
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			m_modelCheckerStatistics = modelChecker.statistics();
 		}
+		else if (noErrors)
+			for (Source const* source: m_sourceOrder)
+				if (source->ast)
+					ModelChecker::warnAboutDeprecatedPragma(m_errorReporter, *source->ast);
 	}
 	catch (FatalError const&)
 	{
@@ -646,63 +833,202 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
 
+	util::Profiler::Scope profilerScope(m_profiler.get());
+
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	// The translation of the IR into EVM assembly does not touch any state shared between
+	// contracts, so it is postponed and done for all contracts at once if parallelism is requested.
+	bool const parallelEVMFromIR = m_generateEvmBytecode && m_viaIR && m_parallelism > 1;
+	auto const createOptimizedObjectCache = [&]() {
+		if (!m_optimizedObjectCacheDirectory)
+			return make_shared<yul::OptimizedObjectCache>();
+		// The entries are only valid for the compiler version that optimised them.
+		auto diskCache = make_shared<CompilationCache>(*m_optimizedObjectCacheDirectory);
+		auto const diskKey = [](util::h256 const& _key) {
+			return util::keccak256(VersionString + '\0' + _key.hex());
+		};
+		return make_shared<yul::OptimizedObjectCache>(yul::OptimizedObjectCache::PersistentStore{
+			[=](util::h256 const& _key) { return diskCache->lookup(diskKey(_key)); },
+			[=](util::h256 const& _key, string const& _object) { diskCache->store(diskKey(_key), _object); }
+		});
+	};
+	if (m_viaIR || m_generateIR || m_generateOptimizedIR || m_generateEwasm)
+	{
+		m_optimizedObjectCache = createOptimizedObjectCache();
+		m_sharedIRFunctions = make_shared<SharedYulFunctions>();
+	}
+	else if (m_optimiserSettings.runYulOptimiser)
+	{
+		// The legacy code generator optimizes the utility functions of each contract
+		// and inline assembly blocks without external references.
+		m_optimizedObjectCache = createOptimizedObjectCache();
+	}
+
+	// The outputs of contracts created by other contracts are kept until the end of the compilation.
+	set<ContractDefinition const*> dependencies;
+	if (m_contractCompiledCallback)
+		for (auto const& [name, contract]: m_contracts)
+			if (contract.contract)
+				for (auto const& [dependency, referencee]: contract.contract->annotation().contractDependencies)
+					dependencies.insert(dependency);
+
+	auto const runCodeGeneration = [&](auto&& _generate) -> bool {
+		try
+		{
+			_generate();
+		}
+		catch (Error const& _error)
+		{
+			if (_error.type() != Error::Type::CodeGenerationError)
+				throw;
+			m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+			return false;
+		}
+		catch (UnimplementedFeatureError const& _unimplementedError)
+		{
+			if (
+				SourceLocation const* sourceLocation =
+				boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+			)
+			{
+				string const* comment = _unimplementedError.comment();
+				m_errorReporter.error(
+					1834_error,
+					Error::Type::CodeGenerationError,
+					*sourceLocation,
+					"Unimplemented feature error" +
+					((comment && !comment->empty()) ? ": " + *comment : string{}) +
+					" in " +
+					_unimplementedError.lineInfo()
+				);
+				return false;
+			}
+			else
+				throw;
+		}
+		return true;
+	};
+
+	for (ContractDefinition const* contract: requestedContracts)
+	{
+		checkpoint("codeGeneration/" + contract->fullyQualifiedName());
+		if (!runCodeGeneration([&]() {
+			if (m_viaIR || m_generateIR || m_generateOptimizedIR || m_generateEwasm)
+				generateIR(*contract);
+			if (m_generateEvmBytecode)
+			{
+				if (m_viaIR)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
+					if (!parallelEVMFromIR)
+						generateEVMFromIR(*contract);
 				}
+				else
+					compileContract(*contract, otherCompilers);
+			}
+			if (m_generateEwasm)
+				generateEwasm(*contract);
+		}))
+			return false;
+		if (m_contractCompiledCallback && !parallelEVMFromIR)
+			reportCompiledContract(*contract, dependencies.count(contract), otherCompilers);
+	}
+
+	if (parallelEVMFromIR)
+	{
+		checkpoint("evmFromIR");
+		if (!runCodeGeneration([&]() {
+			yul::YulStringRepository& yulStrings = yul::YulStringRepository::instance();
+			// Threads not needed for separate contracts are used to optimize functions in parallel.
+			size_t const optimizerParallelism = max<size_t>(1, m_parallelism / max<size_t>(1, requestedContracts.size()));
+			util::parallelForEach(requestedContracts.size(), m_parallelism, [&](size_t _index) {
+				yul::YulStringRepository::Scope yulStringScope(yulStrings);
+				TypeProvider::Scope typeProviderScope(m_typeProvider);
+				util::Profiler::Scope workerProfilerScope(m_profiler.get());
+				generateEVMAssemblyFromIR(*requestedContracts[_index], optimizerParallelism);
+			});
+		}))
+			return false;
+		// Assembling reports warnings, so it is done sequentially to keep their order stable.
+		for (ContractDefinition const* contract: requestedContracts)
+		{
+			if (!runCodeGeneration([&]() { generateEVMFromIR(*contract); }))
+				return false;
+			if (m_contractCompiledCallback)
+				reportCompiledContract(*contract, dependencies.count(contract), otherCompilers);
+		}
+	}
+
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+bool CompilerStack::recompileWithOptimiserSettings(OptimiserSettings _settings)
+{
+	if (m_stackState < AnalysisPerformed || m_hasError)
+		solThrow(CompilerError, "Must analyze successfully before compiling with other optimiser settings.");
+
+	m_optimiserSettings = std::move(_settings);
+	// Only the definitions of the contracts are kept, since all outputs
+	// including the metadata can depend on the optimiser settings.
+	decltype(m_contracts) contracts;
+	for (auto const& [name, contract]: m_contracts)
+		contracts[name].contract = contract.contract;
+	m_contracts.swap(contracts);
+	m_stackState = AnalysisPerformed;
+	return compile(m_stopAfter);
+}
+
+void CompilerStack::checkpoint(string const& _step) const
+{
+	if (m_progressCallback && !m_progressCallback(_step))
+		solThrow(CompilationCancelled, "Compilation cancelled before " + _step + ".");
+}
+
+void CompilerStack::reportCompiledContract(
+	ContractDefinition const& _contract,
+	bool _isDependency,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	solAssert(m_stackState == AnalysisPerformed, "");
+	string const contractName = _contract.fullyQualifiedName();
+	Contract& compiledContract = m_contracts.at(contractName);
+	compiledContract.object.link(m_libraries);
+	compiledContract.runtimeObject.link(m_libraries);
+
+	{
+		// The outputs are queried as after a successful compilation.
+		ScopedSaveAndRestore stateGuard(m_stackState, CompilationSuccessful);
+		m_contractCompiledCallback(contractName);
+	}
+
+	shared_ptr<Compiler> compiler;
+	shared_ptr<yul::Object const> yulIRObject;
+	if (_isDependency)
+	{
+		compiler = move(compiledContract.compiler);
+		yulIRObject = move(compiledContract.yulIRObject);
+	}
+	else
+		_otherCompilers.erase(&_contract);
+
+	// The remaining outputs, including those computed on demand, are recomputed if they are queried again.
+	m_contracts.erase(contractName);
+	Contract& releasedContract = m_contracts[contractName];
+	releasedContract.contract = &_contract;
+	releasedContract.compiler = move(compiler);
+	releasedContract.yulIRObject = move(yulIRObject);
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -827,6 +1153,38 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
 }
 
+bytes const* CompilerStack::binarySourceMapping(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& c = contract(_contractName);
+	if (!c.binarySourceMapping)
+	{
+		if (auto items = assemblyItems(_contractName))
+			c.binarySourceMapping.emplace(
+				evmasm::AssemblyItem::computeBinarySourceMapping(*items, sourceIndices(), c.object.bytecode)
+			);
+	}
+	return c.binarySourceMapping ? &*c.binarySourceMapping : nullptr;
+}
+
+bytes const* CompilerStack::runtimeBinarySourceMapping(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& c = contract(_contractName);
+	if (!c.runtimeBinarySourceMapping)
+	{
+		if (auto items = runtimeAssemblyItems(_contractName))
+			c.runtimeBinarySourceMapping.emplace(
+				evmasm::AssemblyItem::computeBinarySourceMapping(*items, sourceIndices(), c.runtimeObject.bytecode)
+			);
+	}
+	return c.runtimeBinarySourceMapping ? &*c.runtimeBinarySourceMapping : nullptr;
+}
+
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -912,6 +1270,16 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap cons
 		return string();
 }
 
+void CompilerStack::assemblyStream(ostream& _out, string const& _contractName, StringMap const& _sourceCodes) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.evmAssembly)
+		currentContract.evmAssembly->assemblyStream(_out, m_debugInfoSelection, "", _sourceCodes);
+}
+
 /// TODO: cache the JSON
 Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
@@ -1084,6 +1452,20 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 	return *source(_sourceName).ast;
 }
 
+set<string> CompilerStack::unresolvedImports() const
+{
+	if (m_stackState < Parsed)
+		solThrow(CompilerError, "Parsing not yet performed.");
+
+	set<string> unresolved;
+	for (Source const& source: m_sources | ranges::views::values)
+		if (source.ast)
+			for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+				if (!m_sources.count(*import->annotation().absolutePath))
+					unresolved.insert(*import->annotation().absolutePath);
+	return unresolved;
+}
+
 ContractDefinition const& CompilerStack::contractDefinition(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1128,6 +1510,28 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
+string const& CompilerStack::Source::metadataEntry(bool _literalContent) const
+{
+	if (metadataEntryCached.empty())
+	{
+		solAssert(charStream, "Character stream not available");
+		Json::Value entry{Json::objectValue};
+		entry["keccak256"] = "0x" + toHex(keccak256().asBytes());
+		if (optional<string> licenseString = ast->licenseString())
+			entry["license"] = *licenseString;
+		if (_literalContent)
+			entry["content"] = charStream->source();
+		else
+		{
+			entry["urls"] = Json::arrayValue;
+			entry["urls"].append("bzz-raw://" + toHex(swarmHash().asBytes()));
+			entry["urls"].append(ipfsUrl());
+		}
+		metadataEntryCached = util::jsonCompactPrint(entry);
+	}
+	return metadataEntryCached;
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1143,11 +1547,16 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 					continue;
 
 				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
+				if (auto prefetched = m_prefetchedSources.find(importPath); prefetched != m_prefetchedSources.end())
+				{
+					result = move(prefetched->second);
+					m_prefetchedSources.erase(prefetched);
+				}
+				else if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = std::move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1308,13 +1717,16 @@ void CompilerStack::compileContract(
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelism);
+	compiler->setOptimizedObjectCache(m_optimizedObjectCache);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
 
+	util::Profiler::Timer timer("codeGeneration");
 	try
 	{
 		// Run optimiser and compile the contract.
@@ -1327,6 +1739,7 @@ void CompilerStack::compileContract(
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
+	timer.restart("assembling");
 	assemble(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
 }
 
@@ -1337,7 +1750,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		solThrow(CompilerError, "Called generateIR with errors.");
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	if (!compiledContract.yulIR.empty())
+	if (compiledContract.yulIRObject)
 		return;
 
 	if (!*_contract.sourceUnit().annotation().useABICoderV2)
@@ -1355,16 +1768,39 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	// The EVM code is generated from the objects, so the IR is only printed if it is requested.
+	// The optimized IR is also needed for Ewasm.
+	bool const printIR = m_generateIR;
+	bool const printOptimizedIR = m_generateOptimizedIR || m_generateEwasm;
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> otherYulObjects;
 	map<ContractDefinition const*, string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+	{
+		Contract const& dependencyContract = m_contracts.at(dependency->fullyQualifiedName());
+		otherYulObjects.emplace(dependency, dependencyContract.yulIRObject);
+		otherYulSources.emplace(dependency, dependencyContract.yulIR);
+	}
+
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ true);
 
+	util::Profiler::Timer timer("irGeneration");
 	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, sourceIndices(), m_debugInfoSelection, this);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
+	generator.setOptimizedObjectCache(m_optimizedObjectCache);
+	generator.setSharedFunctions(m_sharedIRFunctions);
+	tie(compiledContract.yulIR, compiledContract.yulIRObject, compiledContract.yulIROptimizedObject) = generator.run(
 		_contract,
-		createCBORMetadata(compiledContract, /* _forIR */ true),
-		otherYulSources
+		cborEncodedMetadata,
+		otherYulObjects,
+		otherYulSources,
+		printIR
 	);
+	m_errorReporter.append(generator.optimiserWarnings());
+	// The optimized object is printed before it is modified by the code generation.
+	if (printOptimizedIR)
+		compiledContract.yulIROptimized = generator.printOptimized(*compiledContract.yulIROptimizedObject);
+	if (!m_viaIR || !m_generateEvmBytecode)
+		compiledContract.yulIROptimizedObject.reset();
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1377,26 +1813,50 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	generateEVMAssemblyFromIR(_contract);
+
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Timer timer("assembling");
+	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+}
+
+void CompilerStack::generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _optimizerParallelism)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	solAssert(!m_hasError, "");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (compiledContract.evmAssembly)
+		return;
+	solAssert(compiledContract.yulIROptimizedObject, "");
+
+	util::Profiler::Scope profilerScope(m_profiler.get(), _contract.fullyQualifiedName());
+	util::Profiler::Timer timer("yulOptimization");
+
+	// The object is modified by the optimizer and not needed afterwards.
 	yul::AssemblyStack stack(
 		m_evmVersion,
 		yul::AssemblyStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.setOptimizedObjectCache(m_optimizedObjectCache);
+	stack.setOptimizerParallelism(_optimizerParallelism);
+	stack.setParserResult(move(compiledContract.yulIROptimizedObject));
 	stack.optimize();
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
+	timer.restart("evmCodeGeneration");
 	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1487,25 +1947,29 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
 		referencedSources.insert(*sourceUnit->annotation().path);
 
-	meta["sources"] = Json::objectValue;
+	// The entries of the sources are serialised only once and shared by the metadata of all contracts.
+	string sources = "{";
 	for (auto const& s: m_sources)
 	{
 		if (!referencedSources.count(s.first))
 			continue;
 
-		solAssert(s.second.charStream, "Character stream not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + toHex(s.second.keccak256().asBytes());
-		if (optional<string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
-		else
+		if (sources.size() > 1)
+			sources += ",";
+		Source const& source = s.second;
+		if (source.metadataEntryCached.empty())
 		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
+			// Byte-identical sources, e.g. copies of a library under different paths,
+			// share their entry instead of computing the Swarm and IPFS hashes again.
+			auto [entry, inserted] = m_metadataEntriesByKeccak256.emplace(source.keccak256(), string{});
+			if (inserted)
+				entry->second = source.metadataEntry(m_metadataLiteralSources);
+			else
+				source.metadataEntryCached = entry->second;
 		}
+		sources += util::jsonCompactPrint(Json::Value(s.first)) + ":" + source.metadataEntry(m_metadataLiteralSources);
 	}
+	sources += "}";
 
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
@@ -1525,17 +1989,63 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 
 		details["orderLiterals"] = m_optimiserSettings.runOrderLiterals;
 		details["inliner"] = m_optimiserSettings.runInliner;
+		if (m_optimiserSettings.runInlinerWithSideEffects)
+			details["inlinerWithSideEffects"] = true;
 		details["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
 		details["peephole"] = m_optimiserSettings.runPeephole;
+		if (m_optimiserSettings.runSuperoptimiser)
+			details["superoptimizer"] = true;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
+		if (m_optimiserSettings.runCSEAcrossBlocks)
+			details["cseAcrossBlocks"] = true;
+		if (m_optimiserSettings.cseMaxBlockLength > 0)
+			details["cseMaxBlockLength"] = Json::UInt64(m_optimiserSettings.cseMaxBlockLength);
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		if (m_optimiserSettings.constantOptimiserNegation)
+			details["constantOptimizerNegation"] = true;
+		if (m_optimiserSettings.copyCalldataInABIDecoder)
+			details["abiDecoderCalldataCopy"] = true;
+		if (m_optimiserSettings.coalesceStorageWrites)
+			details["storageWriteCoalescing"] = true;
+		if (m_optimiserSettings.hashInputInScratchMemory)
+			details["hashInputScratchMemory"] = true;
+		if (m_optimiserSettings.precomputeMappingSlots)
+			details["constantMappingSlots"] = true;
+		if (m_optimiserSettings.binarySearchDispatch)
+			details["binarySearchDispatch"] = true;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.stackLayoutSearchBudget > 0)
+				details["yulDetails"]["stackLayoutSearchBudget"] = Json::UInt64(m_optimiserSettings.stackLayoutSearchBudget);
+			if (m_optimiserSettings.inlinerGrowthBudget > 0)
+				details["yulDetails"]["inlinerGrowthBudget"] = Json::UInt64(m_optimiserSettings.inlinerGrowthBudget);
+			if (m_optimiserSettings.yulOptimiserMaxCodeGrowth > 0)
+				details["yulDetails"]["maxCodeGrowth"] = Json::UInt64(m_optimiserSettings.yulOptimiserMaxCodeGrowth);
+			if (m_optimiserSettings.yulOptimiserMaxSteps > 0)
+				details["yulDetails"]["maxSteps"] = Json::UInt64(m_optimiserSettings.yulOptimiserMaxSteps);
+			if (m_optimiserSettings.pruneUnusedFunctions)
+				details["yulDetails"]["pruneUnusedFunctions"] = true;
+			if (m_optimiserSettings.reuseMemorySlots)
+				details["yulDetails"]["reuseMemorySlots"] = true;
+			if (m_optimiserSettings.rematerialiserGasCosts)
+				details["yulDetails"]["rematerialiserGasCosts"] = true;
+			if (m_optimiserSettings.storeKnowledgeAcrossCalls)
+				details["yulDetails"]["storeKnowledgeAcrossCalls"] = true;
+			if (m_optimiserSettings.storeKnowledgeInLoops)
+				details["yulDetails"]["storeKnowledgeInLoops"] = true;
+			if (m_optimiserSettings.preoptimizeLibraryFunctions)
+				details["yulDetails"]["preoptimizeLibraryFunctions"] = true;
+			if (!m_optimiserSettings.functionExecutionsPerDeployment.empty())
+			{
+				details["yulDetails"]["functionRuns"] = Json::objectValue;
+				for (auto const& [function, executions]: m_optimiserSettings.functionExecutionsPerDeployment)
+					details["yulDetails"]["functionRuns"][function] = Json::UInt64(executions);
+			}
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1571,7 +2081,19 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	meta["output"]["userdoc"] = natspecUser(_contract);
 	meta["output"]["devdoc"] = natspecDev(_contract);
 
-	return util::jsonCompactPrint(meta);
+	// The members of JSON objects are printed in the order of their names.
+	map<string, string> members;
+	for (string const& name: meta.getMemberNames())
+		members[name] = util::jsonCompactPrint(meta[name]);
+	members["sources"] = move(sources);
+	string metadata = "{";
+	for (auto const& [name, member]: members)
+	{
+		if (metadata.size() > 1)
+			metadata += ",";
+		metadata += util::jsonCompactPrint(Json::Value(name)) + ":" + member;
+	}
+	return metadata + "}";
 }
 
 class MetadataCBOREncoder
@@ -1662,6 +2184,8 @@ bytes CompilerStack::createCBORMetadata(Contract const& _contract, bool _forIR)
 	if (m_metadataFormat == MetadataFormat::NoMetadata)
 		return bytes{};
 
+	util::Profiler::Timer timer("metadata");
+
 	bool const experimentalMode = !onlySafeExperimentalFeaturesActivated(
 		_contract.contract->sourceUnit().annotation().experimentalFeatures
 	);
@@ -1736,7 +2260,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
 		Json::Value externalFunctions(Json::objectValue);
-		for (auto it: contract.interfaceFunctions())
+		for (auto const& it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
 			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
@@ -32,6 +32,7 @@
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/Statistics.h>
 
 #include <libsmtutil/SolverInterface.h>
 
@@ -46,11 +47,15 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -62,6 +67,12 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+class OptimizedObjectCache;
+struct Object;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -72,6 +83,11 @@ using AssemblyItems = std::vector<AssemblyItem>;
 namespace solidity::frontend
 {
 
+class TypeProvider;
+
+/// Thrown when the progress callback of a compiler stack requests the compilation to stop.
+struct CompilationCancelled: virtual util::Exception {};
+
 // forward declarations
 class ASTNode;
 class ContractDefinition;
@@ -81,6 +97,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+struct SharedYulFunctions;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -169,6 +186,49 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used for compilation.
+	/// Currently only parsing, the translation of the IR into EVM assembly (including
+	/// optimisation) and the optimisation of independent sub-assemblies are performed in parallel.
+	/// The results do not depend on this setting.
+	/// Must be set before parsing.
+	void setParallelism(size_t _parallelism);
+
+	/// Declares that the read callback can be called by several threads at the same time.
+	/// If set and the parallelism is larger than 1, the imports of all sources parsed together
+	/// are read concurrently, using at most as many threads as set by @a setParallelism.
+	/// The results do not depend on this setting. Must be set before parsing.
+	void setReadCallbackThreadSafe(bool _threadSafe);
+
+	/// Keeps the optimised Yul objects in @a _directory in addition to memory, so that objects
+	/// that did not change (e.g. the code of unchanged contracts) are not optimised again in
+	/// later compilations. The results do not depend on this setting.
+	/// Must be set before compiling.
+	void setOptimizedObjectCacheDirectory(boost::filesystem::path _directory);
+
+	/// Callback invoked before parsing, before each phase of the analysis and before the code
+	/// of each contract is generated, with the name of the step that is about to start.
+	/// If it returns false, CompilationCancelled is thrown and the compiler stack has to be reset
+	/// before it can be used again.
+	using ProgressCallback = std::function<bool(std::string const& _step)>;
+
+	/// Sets the callback used to report progress and to cancel the compilation.
+	void setProgressCallback(ProgressCallback _callback) { m_progressCallback = std::move(_callback); }
+
+	/// Callback invoked during compile with the fully qualified name of each requested contract
+	/// as soon as its code has been generated and linked. All outputs of the contract can be
+	/// queried inside the callback. Afterwards, the outputs of the contract are released, apart from
+	/// the parts needed to compile contracts that create it, so that the memory used by compile is
+	/// bounded by the largest contract instead of the sum of all of them. The bytecode, the assembly
+	/// and the IR of the reported contracts are thus not available anymore after compile.
+	using ContractCompiledCallback = std::function<void(std::string const& _contractName)>;
+
+	/// Sets the callback that consumes the outputs of each contract during compile.
+	void setContractCompiledCallback(ContractCompiledCallback _callback) { m_contractCompiledCallback = std::move(_callback); }
+
+	/// Enables or disables measuring the time spent in the phases of the compilation.
+	/// The measurements are available via profiler() and are restarted on every reset.
+	void enableProfiling(bool _enable = true);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -177,6 +237,17 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Enables or disables the model checker, regardless of its settings and of the
+	/// SMTChecker pragma. The deprecation warning of the pragma is reported either way.
+	/// Enabled by default.
+	/// Must be set before parsing.
+	void setModelCheckingEnabled(bool _enabled);
+
+	/// Drops the warnings and infos with the given IDs as soon as they are reported, so that
+	/// the analysis can skip the work of producing them. Errors cannot be suppressed.
+	/// Must be set before parsing.
+	void setSuppressedWarnings(std::set<langutil::ErrorId> _errorIds);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -189,8 +260,14 @@ public:
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
-	/// Enable experimental generation of Yul IR code.
-	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
+	/// Enable experimental generation of Yul IR code. The unoptimized and the optimized IR
+	/// are only printed if they are enabled by @a _enable and @a _enableOptimized, respectively.
+	/// If @a _enableOptimized is not given, it is the same as @a _enable.
+	void enableIRGeneration(bool _enable = true, std::optional<bool> _enableOptimized = std::nullopt)
+	{
+		m_generateIR = _enable;
+		m_generateOptimizedIR = _enableOptimized.value_or(_enable);
+	}
 
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
@@ -235,6 +312,12 @@ public:
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Compiles the contracts again with the optimiser settings @a _settings, reusing the results
+	/// of parsing and analysis, which do not depend on them. The previous compilation results
+	/// are replaced. Can only be called after the analysis was successful.
+	/// @returns false on error.
+	bool recompileWithOptimiserSettings(OptimiserSettings _settings);
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -248,6 +331,14 @@ public:
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
+	/// @returns the absolute paths of all imports that could not be loaded.
+	/// Can only be used after parsing.
+	std::set<std::string> unresolvedImports() const;
+
+	/// @returns the time measurements of the phases performed since the last reset
+	/// or nullptr if profiling is not enabled.
+	util::Profiler const* profiler() const { return m_profiler.get(); }
+
 	/// @returns the parsed contract with the supplied name. Throws an exception if the contract
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
@@ -256,6 +347,10 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the statistics of the verification targets checked by the model checker,
+	/// if they are requested in the model checker settings.
+	std::optional<smt::Statistics> const& modelCheckerStatistics() const { return m_modelCheckerStatistics; }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -301,11 +396,24 @@ public:
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
+	/// @returns the source mapping of the bytecode in the binary format with random access
+	/// (see evmasm::AssemblyItem::computeBinarySourceMapping) or a nullptr if the contract
+	/// does not (yet) have bytecode.
+	bytes const* binarySourceMapping(std::string const& _contractName) const;
+
+	/// @returns the binary source mapping of the runtime bytecode or a nullptr
+	/// if the contract does not (yet) have bytecode.
+	bytes const* runtimeBinarySourceMapping(std::string const& _contractName) const;
+
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
 	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
+	/// Writes the same text as assemblyString directly to @a _out.
+	/// Prerequisite: Successful compilation.
+	void assemblyStream(std::ostream& _out, std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
+
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
@@ -358,10 +466,14 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		std::string mutable metadataEntryCached;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
+		/// @returns the serialised entry of the source in the metadata of the contracts that
+		/// reference it, with the content of the source if @a _literalContent is true.
+		std::string const& metadataEntry(bool _literalContent) const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -373,8 +485,10 @@ private:
 		std::shared_ptr<evmasm::Assembly> evmRuntimeAssembly;
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
-		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		std::string yulIR; ///< Experimental Yul IR code, only printed if IR output is requested.
+		std::shared_ptr<yul::Object const> yulIRObject; ///< Unoptimized IR, included in the IR of contracts creating this one.
+		std::string yulIROptimized; ///< Optimized experimental Yul IR code, only printed if IR output is requested.
+		std::shared_ptr<yul::Object> yulIROptimizedObject; ///< Optimized IR, until it is translated to EVM assembly.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -386,6 +500,8 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		mutable std::optional<bytes const> binarySourceMapping;
+		mutable std::optional<bytes const> runtimeBinarySourceMapping;
 	};
 
 	void createAndAssignCallGraphs();
@@ -431,6 +547,14 @@ private:
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Translates the optimized IR of a single contract into EVM assembly and
+	/// stores it in the contract, without assembling it.
+	/// Does not access any state shared between contracts and can thus be run for several
+	/// contracts concurrently.
+	/// Depends on output generated by generateIR.
+	/// @param _optimizerParallelism number of threads the Yul optimizer may use for the contract.
+	void generateEVMAssemblyFromIR(ContractDefinition const& _contract, size_t _optimizerParallelism = 1);
+
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
@@ -476,6 +600,17 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const& _contract) const;
 
+	/// Calls the progress callback for @a _step and throws CompilationCancelled if it requests so.
+	void checkpoint(std::string const& _step) const;
+
+	/// Links the objects of @a _contract, passes it to the contract compiled callback and releases
+	/// its outputs afterwards, except for the compiler and the IR object if @a _isDependency is true.
+	void reportCompiledContract(
+		ContractDefinition const& _contract,
+		bool _isDependency,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -484,15 +619,24 @@ private:
 	) const;
 
 	ReadCallback::Callback m_readFile;
+	bool m_readCallbackThreadSafe = false;
+	/// Results of the read callback for imports that were read before the importing source
+	/// was processed, by import path.
+	std::map<std::string, ReadCallback::Result> m_prefetchedSources;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
+	std::optional<boost::filesystem::path> m_optimizedObjectCacheDirectory;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
+	bool m_modelCheckingEnabled = true;
+	std::set<langutil::ErrorId> m_suppressedWarnings;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_generateOptimizedIR = false;
 	bool m_generateEwasm = false;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
@@ -500,14 +644,27 @@ private:
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
+	std::optional<smt::Statistics> m_modelCheckerStatistics;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimised Yul objects, shared between the contracts compiled via the IR.
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
+	/// Yul utility functions, shared between the IR of all contracts.
+	std::shared_ptr<SharedYulFunctions> m_sharedIRFunctions;
+	ProgressCallback m_progressCallback;
+	ContractCompiledCallback m_contractCompiledCallback;
+	/// Time measurements, only present if profiling is enabled.
+	std::unique_ptr<util::Profiler> m_profiler;
+	/// The type provider that was current when the compiler stack was created.
+	TypeProvider& m_typeProvider;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
+	/// Metadata entries of the sources by the Keccak-256 hash of their content.
+	std::map<util::h256, std::string> mutable m_metadataEntriesByKeccak256;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
 	bool m_parserErrorRecovery = false;
@@ -30,12 +30,21 @@
 
 #include <functional>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
 using solidity::frontend::ReadCallback;
 using solidity::langutil::InternalCompilerError;
 using solidity::util::errinfo_comment;
 using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
+using std::lock_guard;
 using std::map;
+using std::nullopt;
+using std::optional;
 using std::reference_wrapper;
 using std::string;
 using std::vector;
@@ -43,6 +52,116 @@ using std::vector;
 namespace solidity::frontend
 {
 
+optional<boost::filesystem::path> FileReadCache::resolvedPath(string const& _key) const
+{
+	lock_guard lock(m_mutex);
+	auto it = m_resolvedPaths.find(_key);
+	if (it == m_resolvedPaths.end())
+		return nullopt;
+	return it->second;
+}
+
+optional<FileReadCache::FileVersion> FileReadCache::fileVersion(boost::filesystem::path const& _path)
+{
+	// boost::filesystem::last_write_time() only has a resolution of one second, which would
+	// miss changes that are written within the same second and keep the size.
+#if defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExW(_path.wstring().c_str(), GetFileExInfoStandard, &attributes))
+		return nullopt;
+	return FileVersion{
+		static_cast<int64_t>((uint64_t(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime),
+		(uintmax_t(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow
+	};
+#else
+	struct stat status;
+	if (stat(_path.string().c_str(), &status) != 0)
+		return nullopt;
+#if defined(__APPLE__)
+	timespec const& modificationTime = status.st_mtimespec;
+#else
+	timespec const& modificationTime = status.st_mtim;
+#endif
+	return FileVersion{
+		int64_t(modificationTime.tv_sec) * 1000000000 + int64_t(modificationTime.tv_nsec),
+		uintmax_t(status.st_size)
+	};
+#endif
+}
+
+optional<string> FileReadCache::contents(boost::filesystem::path const& _path) const
+{
+	optional<FileVersion> version = fileVersion(_path);
+	if (!version)
+		return nullopt;
+
+	lock_guard lock(m_mutex);
+	auto it = m_files.find(_path);
+	if (it == m_files.end() || it->second.version != *version || it->second.contents.size() != version->size)
+		return nullopt;
+	m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed, it->second.recentlyUsed);
+	return it->second.contents;
+}
+
+void FileReadCache::store(string const& _key, boost::filesystem::path const& _path, FileVersion _version, string _contents)
+{
+	lock_guard lock(m_mutex);
+	if (auto it = m_files.find(_path); it != m_files.end())
+		erase(it);
+	if (_contents.size() > m_sizeLimit)
+		return;
+
+	while (m_contentSize + _contents.size() > m_sizeLimit)
+		erase(m_files.find(m_recentlyUsed.back()));
+
+	m_resolvedPaths[_key] = _path;
+	m_contentSize += _contents.size();
+	m_recentlyUsed.push_front(_path);
+	m_files[_path] = File{_version, std::move(_contents), m_recentlyUsed.begin()};
+}
+
+void FileReadCache::invalidate(boost::filesystem::path const& _path)
+{
+	lock_guard lock(m_mutex);
+	if (auto it = m_files.find(_path); it != m_files.end())
+		erase(it);
+	m_resolvedPaths.clear();
+}
+
+void FileReadCache::clear()
+{
+	lock_guard lock(m_mutex);
+	m_files.clear();
+	m_recentlyUsed.clear();
+	m_resolvedPaths.clear();
+	m_contentSize = 0;
+}
+
+size_t FileReadCache::size() const
+{
+	lock_guard lock(m_mutex);
+	return m_files.size();
+}
+
+size_t FileReadCache::contentSize() const
+{
+	lock_guard lock(m_mutex);
+	return m_contentSize;
+}
+
+void FileReadCache::erase(map<boost::filesystem::path, File>::iterator _file)
+{
+	solAssert(_file != m_files.end(), "");
+	for (auto it = m_resolvedPaths.begin(); it != m_resolvedPaths.end();)
+		if (it->second == _file->first)
+			it = m_resolvedPaths.erase(it);
+		else
+			++it;
+	m_contentSize -= _file->second.contents.size();
+	m_recentlyUsed.erase(_file->second.recentlyUsed);
+	m_files.erase(_file);
+}
+
 FileReader::FileReader(
 	boost::filesystem::path _basePath,
 	vector<boost::filesystem::path> const& _includePaths,
@@ -89,6 +208,13 @@ void FileReader::addOrUpdateFile(boost::filesystem::path const& _path, SourceCod
 	m_sourceCodes[cliPathToSourceUnitName(_path)] = std::move(_source);
 }
 
+void FileReader::replaceInSource(SourceUnitName const& _sourceUnitName, size_t _offset, size_t _length, string const& _text)
+{
+	SourceCode& source = m_sourceCodes.at(_sourceUnitName);
+	solAssert(_offset + _length <= source.size(), "");
+	source.replace(_offset, _length, _text);
+}
+
 void FileReader::setStdin(SourceCode _source)
 {
 	m_sourceCodes["<stdin>"] = std::move(_source);
@@ -109,6 +235,19 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		if (strippedSourceUnitName.find("file://") == 0)
 			strippedSourceUnitName.erase(0, 7);
 
+		string const key = m_cache ? cacheKey(strippedSourceUnitName) : string{};
+		if (m_cache)
+			if (optional<boost::filesystem::path> path = m_cache->resolvedPath(key))
+				if (optional<string> contents = m_cache->contents(*path))
+				{
+					{
+						lock_guard lock(*m_sourceCodesMutex);
+						solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
+						m_sourceCodes[_sourceUnitName] = *contents;
+					}
+					return ReadCallback::Result{true, std::move(*contents)};
+				}
+
 		vector<boost::filesystem::path> candidates;
 		vector<reference_wrapper<boost::filesystem::path>> prefixes = {m_basePath};
 		prefixes += (m_includePaths | ranges::to<vector<reference_wrapper<boost::filesystem::path>>>);
@@ -163,10 +302,18 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		if (!boost::filesystem::is_regular_file(candidates[0]))
 			return ReadCallback::Result{false, "Not a valid file."};
 
+		// The version is taken before reading, so that a concurrent change is not missed.
+		optional<FileReadCache::FileVersion> version = m_cache ? FileReadCache::fileVersion(candidates[0]) : nullopt;
+
 		// NOTE: we ignore the FileNotFound exception as we manually check above
 		auto contents = readFileAsString(candidates[0]);
-		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
+		{
+			lock_guard lock(*m_sourceCodesMutex);
+			solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
+			m_sourceCodes[_sourceUnitName] = contents;
+		}
+		if (m_cache && version)
+			m_cache->store(key, candidates[0], *version, contents);
 		return ReadCallback::Result{true, contents};
 	}
 	catch (util::Exception const& _exception)
@@ -183,6 +330,16 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 	}
 }
 
+string FileReader::cacheKey(string const& _sourceUnitName) const
+{
+	string key = m_basePath.generic_string() + '\n';
+	for (boost::filesystem::path const& includePath: m_includePaths)
+		key += includePath.generic_string() + '\n';
+	for (boost::filesystem::path const& allowedDirectory: m_allowedDirectories)
+		key += allowedDirectory.generic_string() + '\n';
+	return key + '\n' + _sourceUnitName;
+}
+
 string FileReader::cliPathToSourceUnitName(boost::filesystem::path const& _cliPath) const
 {
 	vector<boost::filesystem::path> prefixes = {m_basePath.empty() ? normalizeCLIPathForVFS(".") : m_basePath};
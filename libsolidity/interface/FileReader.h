@@ -22,12 +22,85 @@
 
 #include <boost/filesystem.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 
 namespace solidity::frontend
 {
 
+/// Cache of the files read from disk by FileReader, which can be shared by the file readers
+/// of consecutive compilations, e.g. in the language server.
+///
+/// It memoises the file each source unit name was resolved to and the contents of that file.
+/// Contents are only reused while the modification time (with the full precision of the file
+/// system) and size of the file are unchanged, so changing a file does not require invalidation. Creating or deleting a file may change
+/// the resolution of source unit names and has to be reported via invalidate().
+/// Failed reads are not cached. If the total size of the cached contents exceeds the size
+/// limit, the least recently used files are evicted.
+/// The cache is synchronized, so that it can be invalidated from a different thread.
+class FileReadCache
+{
+public:
+	/// Modification time and size of a file, which change whenever the file is written.
+	struct FileVersion
+	{
+		/// In nanoseconds since the epoch, or in 100 nanosecond intervals on Windows.
+		int64_t modificationTime = 0;
+		uintmax_t size = 0;
+
+		bool operator==(FileVersion const& _other) const { return modificationTime == _other.modificationTime && size == _other.size; }
+		bool operator!=(FileVersion const& _other) const { return !(*this == _other); }
+	};
+
+	explicit FileReadCache(size_t _sizeLimit = std::numeric_limits<size_t>::max()): m_sizeLimit(_sizeLimit) {}
+
+	/// @returns the current version of the file at @a _path, or nullopt if it cannot be determined.
+	static std::optional<FileVersion> fileVersion(boost::filesystem::path const& _path);
+
+	/// @returns the file @a _key was resolved to, if it was resolved before.
+	std::optional<boost::filesystem::path> resolvedPath(std::string const& _key) const;
+	/// @returns the cached contents of @a _path if the file did not change since it was read.
+	std::optional<std::string> contents(boost::filesystem::path const& _path) const;
+	/// Stores that @a _key was resolved to @a _path with the given contents, which were read
+	/// after the file had the version @a _version.
+	void store(std::string const& _key, boost::filesystem::path const& _path, FileVersion _version, std::string _contents);
+
+	/// Removes the contents of @a _path and all resolutions.
+	void invalidate(boost::filesystem::path const& _path);
+	void clear();
+
+	/// @returns the number of cached files.
+	size_t size() const;
+	/// @returns the total size of the cached contents in bytes.
+	size_t contentSize() const;
+
+private:
+	struct File
+	{
+		FileVersion version;
+		std::string contents;
+		/// Position in m_recentlyUsed.
+		std::list<boost::filesystem::path>::iterator recentlyUsed;
+	};
+
+	/// Removes @a _file from the cache. Requires m_mutex to be locked.
+	void erase(std::map<boost::filesystem::path, File>::iterator _file);
+
+	size_t const m_sizeLimit;
+	mutable std::mutex m_mutex;
+	std::map<std::string, boost::filesystem::path> m_resolvedPaths;
+	std::map<boost::filesystem::path, File> m_files;
+	/// Paths of the cached files, most recently used first.
+	mutable std::list<boost::filesystem::path> m_recentlyUsed;
+	size_t m_contentSize = 0;
+};
+
 /// FileReader - used for progressively loading source code.
 ///
 /// It is used in solc to load files from CLI parameters, stdin, or from JSON and
@@ -61,6 +134,9 @@ public:
 	void allowDirectory(boost::filesystem::path _path);
 	FileSystemPathSet const& allowedDirectories() const noexcept { return m_allowedDirectories; }
 
+	/// Sets the cache used by readFile(), which can be null.
+	void setCache(std::shared_ptr<FileReadCache> _cache) { m_cache = std::move(_cache); }
+
 	/// @returns all sources by their internal source unit names.
 	StringMap const& sourceUnits() const noexcept { return m_sourceCodes; }
 
@@ -73,6 +149,10 @@ public:
 	/// Does not enforce @a allowedDirectories().
 	void addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source);
 
+	/// Replaces @a _length characters starting at @a _offset of the existing source stored under
+	/// @a _sourceUnitName by @a _text, in place.
+	void replaceInSource(SourceUnitName const& _sourceUnitName, size_t _offset, size_t _length, std::string const& _text);
+
 	/// Adds the source code under the source unit name of @a <stdin>.
 	/// Does not enforce @a allowedDirectories().
 	void setStdin(SourceCode _source);
@@ -84,6 +164,8 @@ public:
 	/// @return Content of the loaded file or an error message. If the operation succeeds, a copy of
 	/// the content is retained in @a sourceUnits() under the key of @a _sourceUnitName. If the key
 	/// already exists, previous content is discarded.
+	/// Can be called by several threads at the same time, but not concurrently with the
+	/// functions that modify the sources.
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 
 	frontend::ReadCallback::Callback reader()
@@ -155,6 +237,9 @@ private:
 	/// @returns true if the path contains any .. segments.
 	static bool hasDotDotSegments(boost::filesystem::path const& _path);
 
+	/// @returns the key of @a _sourceUnitName in the cache, which includes the paths its resolution depends on.
+	std::string cacheKey(std::string const& _sourceUnitName) const;
+
 	/// Base path, used for resolving relative paths in imports.
 	boost::filesystem::path m_basePath;
 
@@ -166,6 +251,12 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+	/// Protects the insertions into m_sourceCodes by readFile.
+	/// Held by pointer, so that file readers can still be moved.
+	std::unique_ptr<std::mutex> m_sourceCodesMutex = std::make_unique<std::mutex>();
+
+	/// Cache of files read from disk, possibly shared with other file readers.
+	std::shared_ptr<FileReadCache> m_cache;
 };
 
 }
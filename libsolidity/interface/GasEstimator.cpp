@@ -24,7 +24,6 @@
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libsolidity/ast/AST.h>
-#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libevmasm/ControlFlowGraph.h>
@@ -102,23 +101,3 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 
 	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
 }
-
-set<ASTNode const*> GasEstimator::finestNodesAtLocation(
-	vector<ASTNode const*> const& _roots
-)
-{
-	map<SourceLocation, ASTNode const*> locations;
-	set<ASTNode const*> nodes;
-	SimpleASTVisitor visitor(function<bool(ASTNode const&)>(), [&](ASTNode const& _n)
-	{
-		if (!locations.count(_n.location()))
-		{
-			locations[_n.location()] = &_n;
-			nodes.insert(&_n);
-		}
-	});
-
-	for (ASTNode const* root: _roots)
-		root->accept(visitor);
-	return nodes;
-}
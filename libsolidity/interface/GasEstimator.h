@@ -65,8 +65,6 @@ public:
 	) const;
 
 private:
-	/// @returns the set of AST nodes which are the finest nodes at their location.
-	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
 };
 
@@ -26,6 +26,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <map>
 #include <string>
 
 namespace solidity::frontend
@@ -110,15 +111,37 @@ struct OptimiserSettings
 		return
 			runOrderLiterals == _other.runOrderLiterals &&
 			runInliner == _other.runInliner &&
+			runInlinerWithSideEffects == _other.runInlinerWithSideEffects &&
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
+			runSuperoptimiser == _other.runSuperoptimiser &&
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
+			runCSEAcrossBlocks == _other.runCSEAcrossBlocks &&
+			cseMaxBlockLength == _other.cseMaxBlockLength &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			constantOptimiserNegation == _other.constantOptimiserNegation &&
+			copyCalldataInABIDecoder == _other.copyCalldataInABIDecoder &&
+			coalesceStorageWrites == _other.coalesceStorageWrites &&
+			hashInputInScratchMemory == _other.hashInputInScratchMemory &&
+			precomputeMappingSlots == _other.precomputeMappingSlots &&
+			binarySearchDispatch == _other.binarySearchDispatch &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			stackLayoutSearchBudget == _other.stackLayoutSearchBudget &&
+			inlinerGrowthBudget == _other.inlinerGrowthBudget &&
+			pruneUnusedFunctions == _other.pruneUnusedFunctions &&
+			narrowEwasmValues == _other.narrowEwasmValues &&
+			reuseMemorySlots == _other.reuseMemorySlots &&
+			rematerialiserGasCosts == _other.rematerialiserGasCosts &&
+			storeKnowledgeAcrossCalls == _other.storeKnowledgeAcrossCalls &&
+			storeKnowledgeInLoops == _other.storeKnowledgeInLoops &&
+			preoptimizeLibraryFunctions == _other.preoptimizeLibraryFunctions &&
+			yulOptimiserMaxCodeGrowth == _other.yulOptimiserMaxCodeGrowth &&
+			yulOptimiserMaxSteps == _other.yulOptimiserMaxSteps &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			functionExecutionsPerDeployment == _other.functionExecutionsPerDeployment;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -126,17 +149,52 @@ struct OptimiserSettings
 	bool runOrderLiterals = false;
 	/// Inliner
 	bool runInliner = false;
+	/// Let the inliner also consider functions whose body contains instructions like calls,
+	/// logs or memory copies. Whether inlining is profitable is decided by the same
+	/// gas-based model, so such functions are mostly inlined for high values of
+	/// @a expectedExecutionsPerDeployment.
+	bool runInlinerWithSideEffects = false;
 	/// Non-referenced jump destination remover.
 	bool runJumpdestRemover = false;
 	/// Peephole optimizer
 	bool runPeephole = false;
+	/// Replacement of short windows of stack code by the cheapest equivalent sequence found
+	/// by exhaustive search. This complements the fixed rules of the peephole optimizer.
+	bool runSuperoptimiser = false;
 	/// Assembly block deduplicator
 	bool runDeduplicate = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
+	/// Keep the knowledge of the common subexpression eliminator for the code following a
+	/// conditional jump, which can only be reached from the block containing the jump.
+	bool runCSEAcrossBlocks = false;
+	/// If nonzero, the common subexpression eliminator splits blocks after this many
+	/// items, which bounds its running time on very long blocks at the cost of
+	/// missed optimisation opportunities.
+	size_t cseMaxBlockLength = 0;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Let the constant optimizer also try to compute the negation of constants that are not
+	/// shorter to encode than the constant itself.
+	bool constantOptimiserNegation = false;
+	/// Let the ABI decoder of the IR copy arrays and structs of 32 byte values that are not
+	/// validated, like uint256 and bytes32, from calldata to memory with a single calldatacopy
+	/// instead of decoding them one by one.
+	bool copyCalldataInABIDecoder = false;
+	/// Let the IR write consecutive assignments to members of a storage struct that share
+	/// a slot, like ``s.a = x; s.b = y;``, with a single sload and sstore.
+	bool coalesceStorageWrites = false;
+	/// Let the IR encode the arguments of ``keccak256(abi.encode(...))`` and its variants
+	/// at the free memory pointer without allocating the memory, since it is not used
+	/// after hashing.
+	bool hashInputInScratchMemory = false;
+	/// Let the IR compute the storage slots of accesses with constant integer keys to mappings
+	/// in state variables, like ``m[1][2]``, at compile time.
+	bool precomputeMappingSlots = false;
+	/// Let the function dispatcher of the IR find the called function by a binary search over
+	/// the sorted selectors instead of comparing the selector with all of them in turn.
+	bool binarySearchDispatch = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
@@ -146,9 +204,55 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// If nonzero, the stack layout generator of the optimized Yul to EVM code transform
+	/// evaluates up to this many additional candidate layouts at every conditional jump,
+	/// trading compilation time for less stack shuffling. Only has an effect if
+	/// @a optimizeStackAllocation is set.
+	size_t stackLayoutSearchBudget = 0;
+	/// If nonzero, the full inliner of the Yul optimiser stops inlining functions that are
+	/// called more than once as soon as this would let the code of an object grow by more than
+	/// this many percent of its size before optimisation.
+	size_t inlinerGrowthBudget = 0;
+	/// Leave out the generated Yul utility functions that are not called from the code handed
+	/// to the Yul optimiser, e.g. functions that code templates only use under a condition.
+	/// Also leaves out the unused functions of the polyfill when translating to Ewasm.
+	bool pruneUnusedFunctions = false;
+	/// Keep values that provably fit into 64 bits in a single word when translating to Ewasm
+	/// instead of splitting every value into four words.
+	bool narrowEwasmValues = false;
+	/// Let the Yul optimiser move variables that would be unreachable on the stack and are
+	/// never live at the same time to the same memory slot instead of separate slots.
+	bool reuseMemorySlots = false;
+	/// Let the rematerialiser of the Yul optimiser decide based on the gas costs of the EVM,
+	/// weighted by @a expectedExecutionsPerDeployment and the loop nesting, instead of fixed
+	/// thresholds for the code cost.
+	bool rematerialiserGasCosts = false;
+	/// Let the Yul optimiser determine the constant storage slots and memory offsets written
+	/// by each function and keep the knowledge about other locations across calls to it.
+	bool storeKnowledgeAcrossCalls = false;
+	/// Let the Yul optimiser keep the knowledge about storage and memory locations at for loops
+	/// that do not write to them, instead of clearing everything if the loop writes anywhere.
+	bool storeKnowledgeInLoops = false;
+	/// Let the Yul optimiser optimise the internal functions of libraries together with the
+	/// functions they call, but without the code of the contract using them, before optimising
+	/// the contract. The results are reused for all contracts of a compilation using the same
+	/// function. Only has an effect when compiling via IR.
+	bool preoptimizeLibraryFunctions = false;
+	/// If nonzero, the Yul optimiser stops running the steps of @a yulOptimiserSteps on an object
+	/// as soon as its code grew by more than this many percent of its size before optimisation
+	/// and only runs a few cheap cleanup steps instead, followed by the hard-coded steps.
+	size_t yulOptimiserMaxCodeGrowth = 0;
+	/// If nonzero, the Yul optimiser stops running the steps of @a yulOptimiserSteps on an object
+	/// in the same way before it would run more than this many of them.
+	size_t yulOptimiserMaxSteps = 0;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Estimates on how often the code of individual functions of the runtime code of the
+	/// Yul optimiser output will be executed per deployment (e.g. obtained from execution traces),
+	/// indexed by function name. They replace @a expectedExecutionsPerDeployment when choosing
+	/// the representation of constants inside the respective function.
+	std::map<std::string, size_t> functionExecutionsPerDeployment;
 };
 
 }
@@ -22,9 +22,12 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ImportRemapper.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
@@ -38,10 +41,12 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <optional>
 
 using namespace std;
@@ -181,13 +186,16 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	// These are only returned if they are selected explicitly.
+	static set<string> explicitOnly{"evm.bytecode.sourceMapBinary", "evm.deployedBytecode.sourceMapBinary"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		string const& selectedArtifact = selectedArtifactJson.asString();
-		if (
-			_artifact == selectedArtifact ||
-			boost::algorithm::starts_with(_artifact, selectedArtifact + ".")
-		)
+		if (_artifact == selectedArtifact)
+			return true;
+		else if (explicitOnly.count(_artifact))
+			continue;
+		else if (boost::algorithm::starts_with(_artifact, selectedArtifact + "."))
 			return true;
 		else if (selectedArtifact == "*")
 		{
@@ -249,7 +257,7 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 vector<string> evmObjectComponents(string const& _objectKind)
 {
 	solAssert(_objectKind == "bytecode" || _objectKind == "deployedBytecode", "");
-	vector<string> components{"", ".object", ".opcodes", ".sourceMap", ".functionDebugData", ".generatedSources", ".linkReferences"};
+	vector<string> components{"", ".object", ".opcodes", ".sourceMap", ".sourceMapBinary", ".functionDebugData", ".generatedSources", ".linkReferences"};
 	if (_objectKind == "deployedBytecode")
 		components.push_back(".immutableReferences");
 	return util::applyMap(components, [&](auto const& _s) { return "evm." + _objectKind + _s; });
@@ -312,20 +320,17 @@ bool isEwasmRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
-/// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
-/// yet match "ir" or "irOptimized"
-bool isIRRequested(Json::Value const& _outputSelection)
+/// @returns true if the Yul IR, or the optimized Yul IR if @a _optimized is true, was requested.
+/// Note that as an exception, '*' does not yet match "ir" or "irOptimized"
+bool isIRRequested(Json::Value const& _outputSelection, bool _optimized)
 {
-	if (isEwasmRequested(_outputSelection))
-		return true;
-
 	if (!_outputSelection.isObject())
 		return false;
 
 	for (auto const& fileRequests: _outputSelection)
 		for (auto const& requests: fileRequests)
 			for (auto const& request: requests)
-				if (request == "ir" || request == "irOptimized")
+				if (request == (_optimized ? "irOptimized" : "ir"))
 					return true;
 
 	return false;
@@ -384,6 +389,7 @@ Json::Value formatImmutableReferences(map<u256, pair<string, vector<size_t>>> co
 Json::Value collectEVMObject(
 	evmasm::LinkerObject const& _object,
 	string const* _sourceMap,
+	bytes const* _binarySourceMap,
 	Json::Value _generatedSources,
 	bool _runtimeObject,
 	function<bool(string)> const& _artifactRequested
@@ -396,6 +402,8 @@ Json::Value collectEVMObject(
 		output["opcodes"] = evmasm::disassemble(_object.bytecode);
 	if (_artifactRequested("sourceMap"))
 		output["sourceMap"] = _sourceMap ? *_sourceMap : "";
+	if (_artifactRequested("sourceMapBinary"))
+		output["sourceMapBinary"] = _binarySourceMap ? util::toHex(*_binarySourceMap) : "";
 	if (_artifactRequested("functionDebugData"))
 		output["functionDebugData"] = StandardCompiler::formatFunctionDebugData(_object.functionDebugData);
 	if (_artifactRequested("linkReferences"))
@@ -439,13 +447,13 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "cacheDirectory", "lowMemory", "optimizer", "optimizerVariants", "outputSelection", "parallelism", "profile", "remappings", "stopAfter", "suppressedWarnings", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"cacheDirectory", "contractTimeBudget", "contracts", "counterexampleLimit", "divModNoSlacks", "engine", "invariantHints", "invariants", "printStats", "raceSolvers", "showUnproved", "sliceHornClauses", "solverMemoryLimit", "solverProcesses", "solvers", "targets", "timeBudget", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -457,7 +465,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "inliner", "inlinerWithSideEffects", "jumpdestRemover", "orderLiterals", "superoptimizer", "deduplicate", "cse", "cseAcrossBlocks", "cseMaxBlockLength", "constantOptimizer", "constantOptimizerNegation", "abiDecoderCalldataCopy", "storageWriteCoalescing", "hashInputScratchMemory", "constantMappingSlots", "binarySearchDispatch", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -592,8 +600,12 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 
 		if (auto error = checkOptimizerDetail(details, "peephole", settings.runPeephole))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "superoptimizer", settings.runSuperoptimiser))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "inliner", settings.runInliner))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "inlinerWithSideEffects", settings.runInlinerWithSideEffects))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "jumpdestRemover", settings.runJumpdestRemover))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "orderLiterals", settings.runOrderLiterals))
@@ -602,8 +614,28 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "cseAcrossBlocks", settings.runCSEAcrossBlocks))
+			return *error;
+		if (details.isMember("cseMaxBlockLength"))
+		{
+			if (!details["cseMaxBlockLength"].isUInt())
+				return formatFatalError("JSONError", "\"settings.optimizer.details.cseMaxBlockLength\" must be an unsigned number.");
+			settings.cseMaxBlockLength = details["cseMaxBlockLength"].asUInt();
+		}
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "constantOptimizerNegation", settings.constantOptimiserNegation))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "abiDecoderCalldataCopy", settings.copyCalldataInABIDecoder))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "storageWriteCoalescing", settings.coalesceStorageWrites))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "hashInputScratchMemory", settings.hashInputInScratchMemory))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "constantMappingSlots", settings.precomputeMappingSlots))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "binarySearchDispatch", settings.binarySearchDispatch))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
@@ -612,17 +644,118 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "stackLayoutSearchBudget", "inlinerGrowthBudget", "functionRuns", "pruneUnusedFunctions", "narrowEwasmValues", "reuseMemorySlots", "rematerialiserGasCosts", "storeKnowledgeAcrossCalls", "storeKnowledgeInLoops", "preoptimizeLibraryFunctions", "maxCodeGrowth", "maxSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (details["yulDetails"].isMember("stackLayoutSearchBudget"))
+			{
+				if (!details["yulDetails"]["stackLayoutSearchBudget"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.stackLayoutSearchBudget\" must be an unsigned number.");
+				settings.stackLayoutSearchBudget = details["yulDetails"]["stackLayoutSearchBudget"].asUInt();
+			}
+			if (details["yulDetails"].isMember("inlinerGrowthBudget"))
+			{
+				if (!details["yulDetails"]["inlinerGrowthBudget"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.inlinerGrowthBudget\" must be an unsigned number.");
+				settings.inlinerGrowthBudget = details["yulDetails"]["inlinerGrowthBudget"].asUInt();
+			}
+			if (details["yulDetails"].isMember("maxCodeGrowth"))
+			{
+				if (!details["yulDetails"]["maxCodeGrowth"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.maxCodeGrowth\" must be an unsigned number.");
+				settings.yulOptimiserMaxCodeGrowth = details["yulDetails"]["maxCodeGrowth"].asUInt();
+			}
+			if (details["yulDetails"].isMember("maxSteps"))
+			{
+				if (!details["yulDetails"]["maxSteps"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.maxSteps\" must be an unsigned number.");
+				settings.yulOptimiserMaxSteps = details["yulDetails"]["maxSteps"].asUInt();
+			}
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "pruneUnusedFunctions", settings.pruneUnusedFunctions))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "narrowEwasmValues", settings.narrowEwasmValues))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "reuseMemorySlots", settings.reuseMemorySlots))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "rematerialiserGasCosts", settings.rematerialiserGasCosts))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "storeKnowledgeAcrossCalls", settings.storeKnowledgeAcrossCalls))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "storeKnowledgeInLoops", settings.storeKnowledgeInLoops))
+				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "preoptimizeLibraryFunctions", settings.preoptimizeLibraryFunctions))
+				return *error;
+			if (details["yulDetails"].isMember("functionRuns"))
+			{
+				Json::Value const& functionRuns = details["yulDetails"]["functionRuns"];
+				if (!functionRuns.isObject())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.functionRuns\" must be an object.");
+				for (auto const& function: functionRuns.getMemberNames())
+				{
+					if (!functionRuns[function].isUInt())
+						return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.functionRuns." + function + "\" must be an unsigned number.");
+					settings.functionExecutionsPerDeployment[function] = functionRuns[function].asUInt();
+				}
+			}
 		}
 	}
 	return { std::move(settings) };
 }
 
+Json::Value formatProfileEntries(map<string, util::Profiler::Entry> const& _entries)
+{
+	Json::Value ret{Json::objectValue};
+	for (auto const& [phase, entry]: _entries)
+	{
+		ret[phase]["calls"] = Json::UInt64(entry.count);
+		ret[phase]["time"] = chrono::duration<double, milli>(entry.time).count();
+	}
+	return ret;
+}
+
+Json::Value formatProfile(util::Profiler const& _profiler)
+{
+	Json::Value ret{Json::objectValue};
+	ret["phases"] = Json::objectValue;
+	ret["contracts"] = Json::objectValue;
+	for (auto const& [context, entries]: _profiler.entries())
+		if (context.empty())
+			ret["phases"] = formatProfileEntries(entries);
+		else
+			ret["contracts"][context] = formatProfileEntries(entries);
+	return ret;
+}
+
+Json::Value formatModelCheckerStatistics(smt::Statistics const& _statistics)
+{
+	Json::Value ret{Json::objectValue};
+	ret["targets"] = Json::arrayValue;
+	for (smt::Statistics::Target const& target: _statistics.targets())
+	{
+		Json::Value entry{Json::objectValue};
+		entry["engine"] = target.engine;
+		entry["type"] = target.type;
+		entry["sourceLocation"] = formatSourceLocation(&target.location);
+		entry["queries"] = Json::UInt64(target.queries);
+		entry["size"] = Json::UInt64(target.size);
+		entry["time"] = chrono::duration<double, milli>(target.time).count();
+		entry["outcome"] = target.outcome;
+		entry["cached"] = target.cached;
+		ret["targets"].append(move(entry));
+	}
+	ret["engines"] = Json::objectValue;
+	for (auto const& [engine, totals]: _statistics.totals())
+	{
+		ret["engines"][engine]["targets"] = Json::UInt64(totals.targets);
+		ret["engines"][engine]["queries"] = Json::UInt64(totals.queries);
+		ret["engines"][engine]["time"] = chrono::duration<double, milli>(totals.time).count();
+	}
+	return ret;
+}
+
 }
 
 
@@ -669,7 +802,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -695,7 +828,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -778,6 +911,19 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
 	}
 
+	if (settings.isMember("suppressedWarnings"))
+	{
+		Json::Value const& suppressedWarnings = settings["suppressedWarnings"];
+		if (!suppressedWarnings.isArray())
+			return formatFatalError("JSONError", "\"settings.suppressedWarnings\" must be an array of error codes.");
+		for (Json::Value const& errorCode: suppressedWarnings)
+		{
+			if (!errorCode.isUInt())
+				return formatFatalError("JSONError", "\"settings.suppressedWarnings\" must be an array of error codes.");
+			ret.suppressedWarnings.insert(ErrorId{errorCode.asUInt()});
+		}
+	}
+
 	if (settings.isMember("viaIR"))
 	{
 		if (!settings["viaIR"].isBool())
@@ -785,6 +931,34 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("cacheDirectory"))
+	{
+		if (!settings["cacheDirectory"].isString())
+			return formatFatalError("JSONError", "\"settings.cacheDirectory\" must be a string.");
+		ret.cacheDirectory = settings["cacheDirectory"].asString();
+	}
+
+	if (settings.isMember("lowMemory"))
+	{
+		if (!settings["lowMemory"].isBool())
+			return formatFatalError("JSONError", "\"settings.lowMemory\" must be a Boolean.");
+		ret.lowMemory = settings["lowMemory"].asBool();
+	}
+
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("profile"))
+	{
+		if (!settings["profile"].isBool())
+			return formatFatalError("JSONError", "\"settings.profile\" must be a Boolean.");
+		ret.profile = settings["profile"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -863,6 +1037,19 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			ret.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("optimizerVariants"))
+	{
+		if (!settings["optimizerVariants"].isArray())
+			return formatFatalError("JSONError", "\"settings.optimizerVariants\" must be an array.");
+		for (auto const& variant: settings["optimizerVariants"])
+		{
+			auto optimiserSettings = parseOptimizerSettings(variant);
+			if (std::holds_alternative<Json::Value>(optimiserSettings))
+				return std::get<Json::Value>(std::move(optimiserSettings)); // was an error
+			ret.optimiserVariants.emplace_back(std::get<OptimiserSettings>(std::move(optimiserSettings)));
+		}
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -938,6 +1125,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	if (auto result = checkModelCheckerSettingsKeys(modelCheckerSettings))
 		return *result;
 
+	if (modelCheckerSettings.isMember("cacheDirectory"))
+	{
+		if (!modelCheckerSettings["cacheDirectory"].isString())
+			return formatFatalError("JSONError", "settings.modelChecker.cacheDirectory must be a string.");
+		ret.modelCheckerSettings.cacheDirectory = modelCheckerSettings["cacheDirectory"].asString();
+	}
+
+	if (modelCheckerSettings.isMember("contractTimeBudget"))
+	{
+		if (!modelCheckerSettings["contractTimeBudget"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.contractTimeBudget must be an unsigned integer.");
+		ret.modelCheckerSettings.contractTimeBudget = modelCheckerSettings["contractTimeBudget"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("contracts"))
 	{
 		auto const& sources = modelCheckerSettings["contracts"];
@@ -969,6 +1170,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.contracts = {move(sourceContracts)};
 	}
 
+	if (modelCheckerSettings.isMember("counterexampleLimit"))
+	{
+		if (!modelCheckerSettings["counterexampleLimit"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.counterexampleLimit must be an unsigned integer.");
+		ret.modelCheckerSettings.counterexampleLimit = modelCheckerSettings["counterexampleLimit"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("divModNoSlacks"))
 	{
 		auto const& divModNoSlacks = modelCheckerSettings["divModNoSlacks"];
@@ -987,6 +1195,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.engine = *engine;
 	}
 
+	if (modelCheckerSettings.isMember("invariantHints"))
+	{
+		auto const& invariantHints = modelCheckerSettings["invariantHints"];
+		if (!invariantHints.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.invariantHints must be a Boolean value.");
+		ret.modelCheckerSettings.invariantHints = invariantHints.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("invariants"))
 	{
 		auto const& invariantsArray = modelCheckerSettings["invariants"];
@@ -1008,6 +1224,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.isMember("printStats"))
+	{
+		auto const& printStats = modelCheckerSettings["printStats"];
+		if (!printStats.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.printStats must be a Boolean value.");
+		ret.modelCheckerSettings.printStats = printStats.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1016,6 +1240,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.showUnproved = showUnproved.asBool();
 	}
 
+	if (modelCheckerSettings.isMember("sliceHornClauses"))
+	{
+		auto const& sliceHornClauses = modelCheckerSettings["sliceHornClauses"];
+		if (!sliceHornClauses.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.sliceHornClauses must be a Boolean value.");
+		ret.modelCheckerSettings.sliceHornClauses = sliceHornClauses.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("solvers"))
 	{
 		auto const& solversArray = modelCheckerSettings["solvers"];
@@ -1055,6 +1287,27 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.targets = targets;
 	}
 
+	if (modelCheckerSettings.isMember("solverMemoryLimit"))
+	{
+		if (!modelCheckerSettings["solverMemoryLimit"].isUInt() || modelCheckerSettings["solverMemoryLimit"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.solverMemoryLimit must be a positive integer.");
+		ret.modelCheckerSettings.solverMemoryLimit = modelCheckerSettings["solverMemoryLimit"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("solverProcesses"))
+	{
+		if (!modelCheckerSettings["solverProcesses"].isUInt() || modelCheckerSettings["solverProcesses"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.solverProcesses must be a positive integer.");
+		ret.modelCheckerSettings.solverProcesses = modelCheckerSettings["solverProcesses"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("timeBudget"))
+	{
+		if (!modelCheckerSettings["timeBudget"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.timeBudget must be an unsigned integer.");
+		ret.modelCheckerSettings.timeBudget = modelCheckerSettings["timeBudget"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("timeout"))
 	{
 		if (!modelCheckerSettings["timeout"].isUInt())
@@ -1062,6 +1315,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.asBool();
+	}
+
 	return { std::move(ret) };
 }
 
@@ -1069,11 +1330,32 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	vector<string> inputSourceNames;
+	for (auto const& source: _inputsAndSettings.sources)
+		inputSourceNames.emplace_back(source.first);
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
+	// The contents of the input sources are only needed again for the assembly output.
+	optional<StringMap> sourceList;
+	auto inputSources = [&]() -> StringMap const& {
+		if (!sourceList)
+		{
+			sourceList.emplace();
+			for (string const& sourceName: inputSourceNames)
+				(*sourceList)[sourceName] = compilerStack.charStream(sourceName).source();
+		}
+		return *sourceList;
+	};
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setSuppressedWarnings(_inputsAndSettings.suppressedWarnings);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setReadCallbackThreadSafe(m_readCallbackThreadSafe);
+	if (_inputsAndSettings.cacheDirectory && !_inputsAndSettings.profile)
+		// The optimised Yul objects are keyed by their own code, so they can be reused
+		// if other parts of the input changed.
+		compilerStack.setOptimizedObjectCacheDirectory(*_inputsAndSettings.cacheDirectory / "yul");
+	compilerStack.enableProfiling(_inputsAndSettings.profile);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
@@ -1088,12 +1370,139 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableIRGeneration(
+		isIRRequested(_inputsAndSettings.outputSelection, false),
+		isIRRequested(_inputsAndSettings.outputSelection, true)
+	);
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool const wildcardMatchesExperimental = false;
+
+	// Collects the artifacts of a contract, either into @a _contractsOutput or, if @a _serialized is given, into it.
+	auto const collectContract = [&](
+		string const& _contractName,
+		bool _compilationSuccess,
+		SerializedArtifacts* _serialized,
+		Json::Value& _contractsOutput
+	) {
+		size_t colon = _contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		string file = _contractName.substr(0, colon);
+		string name = _contractName.substr(colon + 1);
+
+		// ABI, storage layout, documentation and metadata
+		Json::Value contractData(Json::objectValue);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+			contractData["abi"] = compilerStack.contractABI(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+			contractData["storageLayout"] = compilerStack.storageLayout(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+			contractData["metadata"] = compilerStack.metadata(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+			contractData["userdoc"] = compilerStack.natspecUser(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+			contractData["devdoc"] = compilerStack.natspecDev(_contractName);
+
+		// IR
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+			contractData["ir"] = compilerStack.yulIR(_contractName);
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = compilerStack.yulIROptimized(_contractName);
+
+		// Ewasm
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+			contractData["ewasm"]["wast"] = compilerStack.ewasm(_contractName);
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(_contractName).toHex();
+
+		// EVM
+		Json::Value evmData(Json::objectValue);
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = compilerStack.assemblyString(_contractName, inputSources());
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(_contractName)["methods"];
+		if (_compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = compilerStack.gasEstimates(_contractName);
+
+		if (_compilationSuccess && isArtifactRequested(
+			_inputsAndSettings.outputSelection,
+			file,
+			name,
+			evmObjectComponents("bytecode"),
+			wildcardMatchesExperimental
+		))
+			evmData["bytecode"] = collectEVMObject(
+				compilerStack.object(_contractName),
+				compilerStack.sourceMapping(_contractName),
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.bytecode.sourceMapBinary", false) ?
+					compilerStack.binarySourceMapping(_contractName) :
+					nullptr,
+				compilerStack.generatedSources(_contractName),
+				false,
+				[&](string const& _element) { return isArtifactRequested(
+					_inputsAndSettings.outputSelection,
+					file,
+					name,
+					"evm.bytecode." + _element,
+					wildcardMatchesExperimental
+				); }
+			);
+
+		if (_compilationSuccess && isArtifactRequested(
+			_inputsAndSettings.outputSelection,
+			file,
+			name,
+			evmObjectComponents("deployedBytecode"),
+			wildcardMatchesExperimental
+		))
+			evmData["deployedBytecode"] = collectEVMObject(
+				compilerStack.runtimeObject(_contractName),
+				compilerStack.runtimeSourceMapping(_contractName),
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.deployedBytecode.sourceMapBinary", false) ?
+					compilerStack.runtimeBinarySourceMapping(_contractName) :
+					nullptr,
+				compilerStack.generatedSources(_contractName, true),
+				true,
+				[&](string const& _element) { return isArtifactRequested(
+					_inputsAndSettings.outputSelection,
+					file,
+					name,
+					"evm.deployedBytecode." + _element,
+					wildcardMatchesExperimental
+				); }
+			);
+
+		if (!evmData.empty())
+			contractData["evm"] = evmData;
+
+		if (!contractData.empty())
+		{
+			if (_serialized)
+				_serialized->contracts[file][name] = util::jsonCompactPrint(contractData);
+			else
+			{
+				if (!_contractsOutput.isMember(file))
+					_contractsOutput[file] = Json::objectValue;
+				_contractsOutput[file][name] = std::move(contractData);
+			}
+		}
+	};
+
+	// In the low memory mode, the contracts are collected as soon as they are compiled,
+	// which releases their intermediate outputs in the compiler stack.
+	SerializedArtifacts serializedArtifacts;
+	Json::Value lowMemoryContracts = Json::objectValue;
+	set<string> collectedContracts;
+	if (_inputsAndSettings.lowMemory)
+		compilerStack.setContractCompiledCallback([&](string const& _contractName) {
+			collectContract(_contractName, true, m_serializedArtifacts ? &serializedArtifacts : nullptr, lowMemoryContracts);
+			collectedContracts.insert(_contractName);
+		});
 
 	try
 	{
@@ -1224,6 +1633,14 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
 	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	compilerStack.setContractCompiledCallback({});
+	if (!compilationSuccess)
+	{
+		// The contracts compiled before the failure only report the outputs that do not need the code.
+		collectedContracts.clear();
+		lowMemoryContracts = Json::objectValue;
+		serializedArtifacts.contracts.clear();
+	}
 
 	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
@@ -1244,7 +1661,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
-	bool const wildcardMatchesExperimental = false;
+	if (auto const& statistics = compilerStack.modelCheckerStatistics())
+		output["modelCheckerStatistics"] = formatModelCheckerStatistics(*statistics);
 
 	output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
@@ -1255,112 +1673,153 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
 				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
+			if (m_serializedArtifacts)
+				serializedArtifacts.sources[sourceName] = util::jsonCompactPrint(sourceResult);
+			else
+				output["sources"][sourceName] = std::move(sourceResult);
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	// Collects the artifacts of all contracts apart from those already collected during the compilation.
+	auto const collectContracts = [&](bool _compilationSuccess, SerializedArtifacts* _serialized) {
+		Json::Value contractsOutput = Json::objectValue;
+		for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+			if (!collectedContracts.count(contractName))
+				collectContract(contractName, _compilationSuccess, _serialized, contractsOutput);
+		return contractsOutput;
+	};
+
+	Json::Value contractsOutput = collectContracts(compilationSuccess, m_serializedArtifacts ? &serializedArtifacts : nullptr);
+	for (string const& file: lowMemoryContracts.getMemberNames())
+		for (string const& name: lowMemoryContracts[file].getMemberNames())
+			contractsOutput[file][name] = std::move(lowMemoryContracts[file][name]);
+	collectedContracts.clear();
+	if (!contractsOutput.empty())
+		output["contracts"] = contractsOutput;
+
+	// The additional optimizer settings reuse the analysis and only repeat the code generation.
+	if (compilationSuccess && binariesRequested && !_inputsAndSettings.optimiserVariants.empty())
 	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		output["optimizerVariants"] = Json::arrayValue;
+		for (OptimiserSettings& variantSettings: _inputsAndSettings.optimiserVariants)
+		{
+			Json::Value variant = Json::objectValue;
+			size_t const previousErrors = compilerStack.errors().size();
+			bool variantSuccess = false;
+			try
+			{
+				variantSuccess = compilerStack.recompileWithOptimiserSettings(std::move(variantSettings));
+			}
+			catch (util::Exception const& _exception)
+			{
+				variant["errors"].append(formatError(
+					Error::Severity::Error,
+					"Exception",
+					"general",
+					"Exception during compilation: " + boost::diagnostic_information(_exception)
+				));
+			}
+			for (size_t i = previousErrors; i < compilerStack.errors().size(); ++i)
+			{
+				Error const& err = dynamic_cast<Error const&>(*compilerStack.errors()[i]);
+				variant["errors"].append(formatErrorWithException(
+					compilerStack,
+					err,
+					Error::errorSeverity(err.type()),
+					err.typeName(),
+					"general",
+					"",
+					err.errorId()
+				));
+			}
+			Json::Value variantContracts = collectContracts(variantSuccess, nullptr);
+			if (!variantContracts.empty())
+				variant["contracts"] = std::move(variantContracts);
+			output["optimizerVariants"].append(std::move(variant));
+		}
+	}
 
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+	if (util::Profiler const* profiler = compilerStack.profiler())
+		output["profile"] = formatProfile(*profiler);
 
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+	if (m_serializedArtifacts)
+		*m_serializedArtifacts = std::move(serializedArtifacts);
 
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+	return output;
+}
 
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+Json::Value StandardCompiler::compileSolidityCached(
+	InputsAndSettings _inputsAndSettings,
+	Json::Value const& _input,
+	boost::filesystem::path const& _cacheDirectory
+)
+{
+	// The key covers everything that can influence the output. Sources given via URLs are
+	// keyed by the content that has already been read. The location of the cache does not matter.
+	Json::Value keyInput = _input;
+	keyInput["settings"].removeMember("cacheDirectory");
+	if (keyInput["settings"].isMember("modelChecker") && keyInput["settings"]["modelChecker"].isObject())
+		keyInput["settings"]["modelChecker"].removeMember("cacheDirectory");
+	keyInput["sources"] = Json::objectValue;
+	for (auto const& [sourceName, content]: _inputsAndSettings.sources)
+		keyInput["sources"][sourceName] = util::keccak256(content).hex();
+	util::h256 key = util::keccak256(VersionString + '\0' + util::jsonCompactPrint(keyInput));
+
+	// Imported sources are loaded through the callback and are thus not covered by the key.
+	// The entry records their hashes and is only used if they have not changed.
+	auto const importsUnchanged = [&](string const& _entry) {
+		Json::Value entry;
+		if (!util::jsonParseStrict(_entry, entry) || !entry["output"].isObject())
+			return false;
+		for (string const& sourceName: entry["loadedSources"].getMemberNames())
+		{
+			if (!m_readFile)
+				return false;
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), sourceName);
+			if (!result.success || util::keccak256(result.responseOrErrorMessage).hex() != entry["loadedSources"][sourceName].asString())
+				return false;
+		}
+		return true;
+	};
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	CompilationCache cache(_cacheDirectory);
+	if (optional<string> entry = cache.lookup(key, importsUnchanged))
+	{
+		Json::Value parsedEntry;
+		util::jsonParseStrict(*entry, parsedEntry);
+		return parsedEntry["output"];
+	}
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+	set<string> inputSourceNames;
+	for (auto const& source: _inputsAndSettings.sources)
+		inputSourceNames.insert(source.first);
 
-		if (!contractData.empty())
+	_inputsAndSettings.cacheDirectory = _cacheDirectory;
+	Json::Value output = compileSolidity(move(_inputsAndSettings));
+
+	// Do not store failed compilations, they might depend on missing files.
+	for (Json::Value const& error: output["errors"])
+		if (error["severity"].asString() == "error")
+			return output;
+
+	Json::Value entry{Json::objectValue};
+	entry["loadedSources"] = Json::objectValue;
+	for (string const& sourceName: output["sources"].getMemberNames())
+		if (!inputSourceNames.count(sourceName))
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			if (!m_readFile)
+				return output;
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), sourceName);
+			if (!result.success)
+				return output;
+			entry["loadedSources"][sourceName] = util::keccak256(result.responseOrErrorMessage).hex();
 		}
-	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+	entry["output"] = output;
+	cache.store(key, util::jsonCompactPrint(entry));
 
 	return output;
 }
 
-
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	Json::Value output = Json::objectValue;
@@ -1459,6 +1918,16 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		output["contracts"][sourceName][contractName]["ir"] = stack.print();
 
 	stack.optimize();
+	for (auto const& error: stack.errors())
+		output["errors"].append(formatErrorWithException(
+			stack,
+			*error,
+			Error::errorSeverity(error->type()),
+			error->typeName(),
+			"general",
+			"",
+			error->errorId()
+		));
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject deployedObject;
@@ -1484,6 +1953,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 					collectEVMObject(
 						*o.bytecode,
 						o.sourceMappings.get(),
+						nullptr,
 						Json::arrayValue,
 						isDeployed,
 						[&, kind = kind](string const& _element) { return isArtifactRequested(
@@ -1507,7 +1977,13 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Use a fresh repository, so that compilations are independent and
+	// all the Yul strings are freed at the end.
+	YulStringRepository yulStrings;
+	YulStringRepository::Scope yulStringScope(yulStrings);
+	// The same holds for the types.
+	TypeProvider typeProvider;
+	TypeProvider::Scope typeProviderScope(typeProvider);
 
 	try
 	{
@@ -1515,7 +1991,16 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
+		optional<boost::filesystem::path> cacheDirectory =
+			settings.cacheDirectory.has_value() ? settings.cacheDirectory : m_cacheDirectory;
+		// Time measurements are only meaningful for an actual compilation.
+		if (settings.language == "Solidity" && cacheDirectory.has_value() && !settings.profile)
+		{
+			// The cache stores complete outputs.
+			m_serializedArtifacts = nullptr;
+			return compileSolidityCached(std::move(settings), _input, *cacheDirectory);
+		}
+		else if (settings.language == "Solidity")
 			return compileSolidity(std::move(settings));
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
@@ -1554,12 +2039,51 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	if (!input.isArray())
+		return compileAndPrint(input);
+
+	// Independent compilation units can be given as an array of inputs. They are compiled one after
+	// another and share the files read by the callback and the caches of the process.
+	if (m_jsonPrintingFormat.format != util::JsonFormat::Compact)
+	{
+		Json::Value outputs{Json::arrayValue};
+		for (Json::Value const& unit: input)
+			outputs.append(compile(unit));
+		try
+		{
+			return util::jsonPrint(outputs, m_jsonPrintingFormat);
+		}
+		catch (...)
+		{
+			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		}
+	}
+	string outputs = "[";
+	for (Json::Value const& unit: input)
+	{
+		if (outputs.size() > 1)
+			outputs += ",";
+		outputs += compileAndPrint(unit);
+	}
+	return outputs + "]";
+}
+
+string StandardCompiler::compileAndPrint(Json::Value const& _input) noexcept
+{
+	// The artifacts are only serialised early for the compact format, whose serialisation
+	// does not depend on the nesting depth.
+	SerializedArtifacts artifacts;
+	if (m_jsonPrintingFormat.format == util::JsonFormat::Compact)
+		m_serializedArtifacts = &artifacts;
+	// cout << "Input: " << _input.toStyledString() << endl;
+	Json::Value output = compile(_input);
 	// cout << "Output: " << output.toStyledString() << endl;
+	m_serializedArtifacts = nullptr;
 
 	try
 	{
+		if (m_jsonPrintingFormat.format == util::JsonFormat::Compact)
+			return printCompact(output, artifacts);
 		return util::jsonPrint(output, m_jsonPrintingFormat);
 	}
 	catch (...)
@@ -1568,6 +2092,42 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 }
 
+string StandardCompiler::printCompact(Json::Value const& _output, SerializedArtifacts const& _artifacts)
+{
+	if (_artifacts.sources.empty() && _artifacts.contracts.empty())
+		return util::jsonCompactPrint(_output);
+
+	auto printObject = [](auto const& _members, auto const& _printMember) {
+		string result = "{";
+		for (auto const& [name, member]: _members)
+		{
+			if (result.size() > 1)
+				result += ",";
+			result += util::jsonCompactPrint(Json::Value(name)) + ":" + _printMember(member);
+		}
+		return result + "}";
+	};
+
+	// The members of JSON objects are printed in the order of their names.
+	map<string, Json::Value const*> members;
+	for (string const& name: _output.getMemberNames())
+		members[name] = &_output[name];
+	if (!_artifacts.contracts.empty())
+		members["contracts"] = nullptr;
+	solAssert(_artifacts.sources.empty() || (_output.isMember("sources") && _output["sources"].empty()));
+
+	auto identity = [](string const& _serialized) { return _serialized; };
+	return printObject(members, [&](Json::Value const* _member) {
+		if (_member == &_output["sources"] && !_artifacts.sources.empty())
+			return printObject(_artifacts.sources, identity);
+		if (!_member)
+			return printObject(_artifacts.contracts, [&](map<string, string> const& _contracts) {
+				return printObject(_contracts, identity);
+			});
+		return util::jsonCompactPrint(*_member);
+	});
+}
+
 Json::Value StandardCompiler::formatFunctionDebugData(
 	map<string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
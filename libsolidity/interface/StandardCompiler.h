@@ -28,6 +28,8 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <utility>
 #include <variant>
@@ -56,11 +58,21 @@ public:
 	{
 	}
 
+	/// Enables the persistent compilation cache in the given directory.
+	/// Can be overridden by the ``settings.cacheDirectory`` input setting.
+	void setCacheDirectory(boost::filesystem::path _directory) { m_cacheDirectory = std::move(_directory); }
+
+	/// Declares that the read callback can be called by several threads at the same time,
+	/// so that imports are read concurrently if ``settings.parallelism`` is larger than 1.
+	void setReadCallbackThreadSafe(bool _threadSafe) { m_readCallbackThreadSafe = _threadSafe; }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// If the input is an array, every element is compiled as an input of its own and
+	/// the array of their outputs is returned.
 	std::string compile(std::string const& _input) noexcept;
 
 	static Json::Value formatFunctionDebugData(
@@ -80,6 +92,8 @@ private:
 		std::vector<ImportRemapper::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		/// Further optimiser settings the contracts are compiled with after the analysis.
+		std::vector<OptimiserSettings> optimiserVariants;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
@@ -87,6 +101,22 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		/// IDs of the warnings and infos that are not reported.
+		std::set<langutil::ErrorId> suppressedWarnings;
+		unsigned parallelism = 1;
+		bool profile = false;
+		/// Collect the outputs of each contract as soon as it is compiled and release
+		/// its intermediate outputs in the compiler stack afterwards.
+		bool lowMemory = false;
+		std::optional<boost::filesystem::path> cacheDirectory;
+	};
+
+	/// The compactly serialised outputs of the sources and contracts.
+	struct SerializedArtifacts
+	{
+		std::map<std::string, std::string> sources;
+		/// By file and contract name.
+		std::map<std::string, std::map<std::string, std::string>> contracts;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -94,11 +124,33 @@ private:
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles the input like compileSolidity, but consults the compilation cache
+	/// in @a _cacheDirectory first and stores the result in it.
+	Json::Value compileSolidityCached(
+		InputsAndSettings _inputsAndSettings,
+		Json::Value const& _input,
+		boost::filesystem::path const& _cacheDirectory
+	);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Compiles @a _input and returns the serialized output.
+	std::string compileAndPrint(Json::Value const& _input) noexcept;
+
+	/// @returns the compact serialisation of @a _output with the artifacts @a _artifacts
+	/// inserted into its "sources" and "contracts" members.
+	static std::string printCompact(Json::Value const& _output, SerializedArtifacts const& _artifacts);
+
 	ReadCallback::Callback m_readFile;
+	bool m_readCallbackThreadSafe = false;
+
+	/// If set, compileSolidity serialises the output of every source and contract as soon as it
+	/// is complete and stores it here instead of in its result, so that the JSON values of all
+	/// artifacts do not have to be kept in memory until the output is printed.
+	SerializedArtifacts* m_serializedArtifacts = nullptr;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::optional<boost::filesystem::path> m_cacheDirectory;
 };
 
 }
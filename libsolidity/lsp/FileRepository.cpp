@@ -18,6 +18,8 @@
 
 #include <libsolidity/lsp/FileRepository.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::lsp;
@@ -59,6 +61,63 @@ void FileRepository::setSourceByClientPath(string const& _uri, string _text)
 {
 	// This is needed for uris outside the base path. It can lead to collisions,
 	// but we need to mostly rewrite this in a future version anyway.
-	m_sourceUnitNamesToClientPaths.emplace(clientPathToSourceUnitName(_uri), _uri);
+	string const sourceUnitName = clientPathToSourceUnitName(_uri);
+	m_sourceUnitNamesToClientPaths.emplace(sourceUnitName, _uri);
+	m_lineStarts.erase(sourceUnitName);
 	m_fileReader.addOrUpdateFile(stripFilePrefix(_uri), move(_text));
 }
+
+bool FileRepository::applyChange(string const& _uri, langutil::LineColumn _start, langutil::LineColumn _end, string const& _text)
+{
+	string const sourceUnitName = clientPathToSourceUnitName(_uri);
+	auto source = sourceUnits().find(sourceUnitName);
+	if (source == sourceUnits().end())
+		return false;
+
+	auto [lineStartsIt, inserted] = m_lineStarts.try_emplace(sourceUnitName);
+	vector<size_t>& lineStarts = lineStartsIt->second;
+	if (inserted)
+	{
+		lineStarts.push_back(0);
+		for (size_t i = 0; i < source->second.size(); ++i)
+			if (source->second[i] == '\n')
+				lineStarts.push_back(i + 1);
+	}
+
+	optional<size_t> start = offset(sourceUnitName, lineStarts, _start);
+	optional<size_t> end = offset(sourceUnitName, lineStarts, _end);
+	if (!start || !end || *end < *start)
+		return false;
+
+	m_fileReader.replaceInSource(sourceUnitName, *start, *end - *start, _text);
+
+	// Lines starting inside the replaced text are removed and those after it are shifted.
+	auto firstRemoved = upper_bound(lineStarts.begin(), lineStarts.end(), *start);
+	auto firstShifted = upper_bound(firstRemoved, lineStarts.end(), *end);
+	for (auto it = firstShifted; it != lineStarts.end(); ++it)
+		*it = *it - (*end - *start) + _text.size();
+	vector<size_t> insertedLineStarts;
+	for (size_t i = 0; i < _text.size(); ++i)
+		if (_text[i] == '\n')
+			insertedLineStarts.push_back(*start + i + 1);
+	lineStarts.insert(lineStarts.erase(firstRemoved, firstShifted), insertedLineStarts.begin(), insertedLineStarts.end());
+	return true;
+}
+
+optional<size_t> FileRepository::offset(
+	string const& _sourceUnitName,
+	vector<size_t> const& _lineStarts,
+	langutil::LineColumn _position
+) const
+{
+	if (_position.line < 0 || _position.column < 0 || static_cast<size_t>(_position.line) >= _lineStarts.size())
+		return nullopt;
+
+	size_t line = static_cast<size_t>(_position.line);
+	size_t endOfLine = line + 1 < _lineStarts.size() ?
+		_lineStarts[line + 1] - 1 :
+		sourceUnits().at(_sourceUnitName).size();
+	if (_lineStarts[line] + static_cast<size_t>(_position.column) > endOfLine)
+		return nullopt;
+	return _lineStarts[line] + static_cast<size_t>(_position.column);
+}
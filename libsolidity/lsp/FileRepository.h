@@ -19,8 +19,13 @@
 
 #include <libsolidity/interface/FileReader.h>
 
+#include <liblangutil/SourceLocation.h>
+
+#include <memory>
+#include <optional>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace solidity::lsp
 {
@@ -42,11 +47,27 @@ public:
 	std::map<std::string, std::string> const& sourceUnits() const;
 	/// Changes the source identified by the LSP client path _uri to _text.
 	void setSourceByClientPath(std::string const& _uri, std::string _text);
+	/// Replaces the text between the positions @a _start and @a _end of the source identified by
+	/// the LSP client path _uri by @a _text, without copying the rest of the source.
+	/// @returns false if the source is unknown or the range is not valid in it.
+	bool applyChange(std::string const& _uri, langutil::LineColumn _start, langutil::LineColumn _end, std::string const& _text);
 
 	frontend::ReadCallback::Callback reader() { return m_fileReader.reader(); }
+	/// Sets the cache used when reading the files that are not set by the client from disk.
+	void setFileReadCache(std::shared_ptr<frontend::FileReadCache> _cache) { m_fileReader.setCache(std::move(_cache)); }
 
 private:
+	/// @returns the offset of @a _position in the source @a _sourceUnitName with the line starts @a _lineStarts.
+	std::optional<size_t> offset(
+		std::string const& _sourceUnitName,
+		std::vector<size_t> const& _lineStarts,
+		langutil::LineColumn _position
+	) const;
+
 	std::map<std::string, std::string> m_sourceUnitNamesToClientPaths;
+	/// Offsets of the starts of the lines of the sources changed by applyChange(),
+	/// by source unit name. Kept up to date by applyChange().
+	std::map<std::string, std::vector<size_t>> m_lineStarts;
 	frontend::FileReader m_fileReader;
 };
 
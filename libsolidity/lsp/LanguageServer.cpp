@@ -25,6 +25,8 @@
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
 
@@ -37,6 +39,10 @@
 #include <ostream>
 #include <string>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 using namespace std;
 using namespace std::string_literals;
 using namespace std::placeholders;
@@ -48,6 +54,15 @@ using namespace solidity::frontend;
 namespace
 {
 
+/// Returns the memory freed since the last call to the operating system, where the allocator
+/// supports it. Otherwise the size of the process does not shrink after a large compilation.
+void releaseFreedMemory()
+{
+#if defined(__GLIBC__)
+	malloc_trim(0);
+#endif
+}
+
 Json::Value toJson(LineColumn _pos)
 {
 	Json::Value json = Json::objectValue;
@@ -88,53 +103,39 @@ int toDiagnosticSeverity(Error::Type _errorType)
 
 }
 
-LanguageServer::LanguageServer(Transport& _transport):
+LanguageServer::LanguageServer(Transport& _transport, chrono::milliseconds _debounceDelay):
 	m_client{_transport},
 	m_handlers{
 		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
 		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", bind(&LanguageServer::handleInitialize, this, _1, _2)},
-		{"initialized", [](auto, auto) {}},
+		{"initialized", [this](auto, auto) { handleInitialized(); }},
 		{"shutdown", [this](auto, auto) { m_state = State::ShutdownRequested; }},
 		{"textDocument/didOpen", bind(&LanguageServer::handleTextDocumentDidOpen, this, _2)},
 		{"textDocument/didChange", bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
+		{"textDocument/definition", bind(&LanguageServer::handleTextDocumentDefinition, this, _1, _2)},
+		{"textDocument/references", bind(&LanguageServer::handleTextDocumentReferences, this, _1, _2)},
+		{"textDocument/documentSymbol", bind(&LanguageServer::handleTextDocumentDocumentSymbol, this, _1, _2)},
+		{"textDocument/semanticTokens/full", bind(&LanguageServer::handleTextDocumentSemanticTokens, this, _1, _2, false)},
+		{"textDocument/semanticTokens/full/delta", bind(&LanguageServer::handleTextDocumentSemanticTokens, this, _1, _2, true)},
+		{"workspace/symbol", bind(&LanguageServer::handleWorkspaceSymbol, this, _1, _2)},
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
+		{"workspace/didChangeWatchedFiles", bind(&LanguageServer::handleWorkspaceDidChangeWatchedFiles, this, _2)},
+		{"window/workDoneProgress/cancel", bind(&LanguageServer::handleWorkDoneProgressCancel, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_compilationFiles("/" /* basePath */),
+	m_compilerStack{m_compilationFiles.reader()},
+	m_debounceDelay{_debounceDelay}
 {
 }
 
-optional<SourceLocation> LanguageServer::parsePosition(
-	string const& _sourceUnitName,
-	Json::Value const& _position
-) const
+LanguageServer::~LanguageServer()
 {
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
-		return nullopt;
-
-	if (optional<LineColumn> lineColumn = parseLineColumn(_position))
-		if (optional<int> const offset = CharStream::translateLineColumnToPosition(
-			m_fileRepository.sourceUnits().at(_sourceUnitName),
-			*lineColumn
-		))
-			return SourceLocation{*offset, *offset, make_shared<string>(_sourceUnitName)};
-	return nullopt;
-}
-
-optional<SourceLocation> LanguageServer::parseRange(string const& _sourceUnitName, Json::Value const& _range) const
-{
-	if (!_range.isObject())
-		return nullopt;
-	optional<SourceLocation> start = parsePosition(_sourceUnitName, _range["start"]);
-	optional<SourceLocation> end = parsePosition(_sourceUnitName, _range["end"]);
-	if (!start || !end)
-		return nullopt;
-	solAssert(*start->sourceName == *end->sourceName);
-	start->end = end->end;
-	return start;
+	stopIndexingThread();
+	stopCompilationThread();
 }
 
 Json::Value LanguageServer::toRange(SourceLocation const& _location) const
@@ -153,7 +154,7 @@ Json::Value LanguageServer::toJson(SourceLocation const& _location) const
 {
 	solAssert(_location.sourceName);
 	Json::Value item = Json::objectValue;
-	item["uri"] = m_fileRepository.sourceUnitNameToClientPath(*_location.sourceName);
+	item["uri"] = m_compilationFiles.sourceUnitNameToClientPath(*_location.sourceName);
 	item["range"] = toRange(_location);
 	return item;
 }
@@ -163,35 +164,272 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	m_settingsObject = _settings;
 }
 
-void LanguageServer::compile()
+LanguageServer::Snapshot LanguageServer::snapshot() const
+{
+	Snapshot snapshot{m_fileRepository.basePath(), {}};
+	for (string const& fileName: m_openFiles)
+		snapshot.openFiles[fileName] = m_fileRepository.sourceUnits().at(m_fileRepository.clientPathToSourceUnitName(fileName));
+	return snapshot;
+}
+
+void LanguageServer::scheduleCompilation()
+{
+	if (!m_compilationThread.joinable())
+	{
+		compileAndUpdateDiagnostics();
+		return;
+	}
+
+	{
+		lock_guard lock(m_compilationMutex);
+		m_compilationPending = true;
+		++m_revision;
+	}
+	m_compilationRequested.notify_one();
+}
+
+void LanguageServer::compilationLoop()
+{
+	unique_lock lock(m_compilationMutex);
+	while (true)
+	{
+		m_compilationRequested.wait(lock, [&] { return m_compilationPending || m_stopCompilation; });
+
+		// Wait until no further change arrives within the debounce delay.
+		uint64_t revision = m_revision;
+		while (!m_stopCompilation && m_compilationRequested.wait_for(
+			lock,
+			m_debounceDelay,
+			[&] { return m_revision != revision || m_stopCompilation; }
+		))
+			revision = m_revision;
+		if (m_stopCompilation)
+			return;
+
+		m_compilationPending = false;
+		lock.unlock();
+		try
+		{
+			beginProgress(revision);
+			// The contents of the open files are only copied once the compilation starts.
+			Snapshot snapshot;
+			{
+				lock_guard documentsLock(m_documentsMutex);
+				snapshot = this->snapshot();
+			}
+			compileAndUpdateDiagnostics(snapshot, [this, revision] { return compilationCancelled(revision); });
+		}
+		catch (...)
+		{
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+		endProgress();
+		// The state of the previous compilation was freed when this one started.
+		releaseFreedMemory();
+		lock.lock();
+	}
+}
+
+bool LanguageServer::compilationCancelled(uint64_t _revision)
+{
+	lock_guard lock(m_compilationMutex);
+	return m_revision != _revision || m_stopCompilation || (m_progress && m_progress->cancelled);
+}
+
+void LanguageServer::stopCompilationThread()
+{
+	if (!m_compilationThread.joinable())
+		return;
+
+	{
+		lock_guard lock(m_compilationMutex);
+		m_stopCompilation = true;
+	}
+	m_compilationRequested.notify_one();
+	m_compilationThread.join();
+}
+
+void LanguageServer::beginProgress(uint64_t _revision)
+{
+	if (!m_workDoneProgressSupported)
+		return;
+
+	string const token = "solc/compilation/" + to_string(_revision);
+	{
+		lock_guard lock(m_compilationMutex);
+		m_progress = Progress{token};
+	}
+	Json::Value params;
+	params["token"] = token;
+	m_client.request(token, "window/workDoneProgress/create", move(params));
+}
+
+void LanguageServer::reportProgress(string const& _step)
+{
+	Json::Value params;
+	{
+		lock_guard lock(m_compilationMutex);
+		// The indicator must not be used before the client created it.
+		if (!m_progress || !m_progress->created)
+			return;
+		params["token"] = m_progress->token;
+		if (!m_progress->begun)
+		{
+			params["value"]["kind"] = "begin";
+			params["value"]["title"] = "Compiling";
+			params["value"]["cancellable"] = true;
+			m_progress->begun = true;
+		}
+		else
+			params["value"]["kind"] = "report";
+	}
+	params["value"]["message"] = _step;
+	m_client.notify("$/progress", move(params));
+}
+
+void LanguageServer::endProgress()
+{
+	optional<Progress> progress;
+	{
+		lock_guard lock(m_compilationMutex);
+		swap(progress, m_progress);
+	}
+	if (!progress || !progress->begun)
+		return;
+
+	Json::Value params;
+	params["token"] = progress->token;
+	params["value"]["kind"] = "end";
+	if (progress->cancelled)
+		params["value"]["message"] = "Cancelled";
+	m_client.notify("$/progress", move(params));
+}
+
+void LanguageServer::handleResponse(Json::Value const& _message)
+{
+	// Only the responses to the requests creating progress indicators are relevant.
+	lock_guard lock(m_compilationMutex);
+	if (m_progress && _message["id"] == m_progress->token && !_message.isMember("error"))
+		m_progress->created = true;
+}
+
+void LanguageServer::handleWorkDoneProgressCancel(Json::Value const& _args)
+{
+	lock_guard lock(m_compilationMutex);
+	if (m_progress && _args["token"] == m_progress->token)
+		m_progress->cancelled = true;
+}
+
+bool LanguageServer::compile(Snapshot const& _snapshot, function<bool()> const& _cancelled)
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
 
-	FileRepository oldRepository(m_fileRepository.basePath());
-	swap(oldRepository, m_fileRepository);
+	FileRepository files(_snapshot.basePath);
+	files.setFileReadCache(m_fileReadCache);
+	swap(files, m_compilationFiles);
 
-	for (string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByClientPath(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.clientPathToSourceUnitName(fileName))
-		);
+	for (auto const& [fileName, content]: _snapshot.openFiles)
+		m_compilationFiles.setSourceByClientPath(fileName, content);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	if (m_compilerStack.state() >= CompilerStack::State::ParsedAndImported && changedSources().empty())
+		return true;
 
 	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	// Diagnostics do not depend on the number of threads, and the model checker
+	// is too slow to run on every change.
+	m_compilerStack.setParallelism(max(1u, thread::hardware_concurrency()));
+	m_compilerStack.setModelCheckingEnabled(false);
+	// The callback is kept by the compiler stack after this compilation, so it must not
+	// refer to the arguments.
+	m_compilerStack.setProgressCallback([this, cancelled = _cancelled](string const& _step) {
+		if (cancelled && cancelled())
+			return false;
+		reportProgress(_step);
+		return true;
+	});
+	m_yulStrings = make_unique<yul::YulStringRepository>();
+	yul::YulStringRepository::Scope yulStringScope(*m_yulStrings);
+	m_compilerStack.setSources(m_compilationFiles.sourceUnits());
+	try
+	{
+		if (m_compilerStack.parseAndAnalyze(CompilerStack::State::ParsedAndImported))
+		{
+			for (string const& sourceUnitName: m_compilerStack.sourceNames())
+				m_symbolIndex.update(m_compilerStack.charStream(sourceUnitName), m_compilerStack.ast(sourceUnitName));
+			m_compilerStack.analyze();
+		}
+	}
+	catch (CompilationCancelled const&)
+	{
+		// Make sure the next compilation does not reuse the incomplete results.
+		m_compilerStack.reset(false);
+		return false;
+	}
+	if (m_compilerStack.state() >= CompilerStack::State::AnalysisPerformed)
+	{
+		auto positionIndex = make_shared<PositionIndex const>(m_compilerStack);
+		auto semanticTokens = make_shared<SemanticTokens const>(m_compilerStack);
+		{
+			lock_guard lock(m_positionIndexMutex);
+			m_positionIndex = move(positionIndex);
+			m_semanticTokens = move(semanticTokens);
+		}
+		if (m_semanticTokensRefreshSupported)
+			m_client.request(
+				"solc/semanticTokensRefresh/" + to_string(++m_semanticTokensRefreshCount),
+				"workspace/semanticTokens/refresh",
+				Json::nullValue
+			);
+	}
+	return true;
+}
+
+set<string> LanguageServer::changedSources()
+{
+	set<string> changed;
+	vector<string> const previousSourceNames = m_compilerStack.sourceNames();
+	set<string> const previousSources(previousSourceNames.begin(), previousSourceNames.end());
+	for (string const& sourceUnitName: previousSources)
+	{
+		if (!m_compilationFiles.sourceUnits().count(sourceUnitName))
+		{
+			// Not open in the editor (any more), so it has to be re-read from disk.
+			ReadCallback::Result result = m_compilationFiles.reader()(
+				ReadCallback::kindString(ReadCallback::Kind::ReadFile),
+				sourceUnitName
+			);
+			if (!result.success)
+			{
+				changed.insert(sourceUnitName);
+				continue;
+			}
+		}
+		if (m_compilationFiles.sourceUnits().at(sourceUnitName) != m_compilerStack.charStream(sourceUnitName).source())
+			changed.insert(sourceUnitName);
+	}
+	for (string const& sourceUnitName: m_compilationFiles.sourceUnits() | ranges::views::keys)
+		if (!previousSources.count(sourceUnitName))
+			changed.insert(sourceUnitName);
+	// Files that were missing might have been created in the meantime.
+	changed += m_compilerStack.unresolvedImports();
+	return changed;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
-	compile();
+	compileAndUpdateDiagnostics(snapshot(), {});
+}
+
+void LanguageServer::compileAndUpdateDiagnostics(Snapshot const& _snapshot, function<bool()> const& _cancelled)
+{
+	if (!compile(_snapshot, _cancelled) || (_cancelled && _cancelled()))
+		return;
 
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	map<string, Json::Value> diagnosticsBySourceUnit;
-	for (string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (string const& sourceUnitName: m_compilationFiles.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
 	for (string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
@@ -226,19 +464,24 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	}
 
 	m_nonemptyDiagnostics.clear();
+	vector<Json::Value> notifications;
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json::Value params;
-		params["uri"] = m_fileRepository.sourceUnitNameToClientPath(sourceUnitName);
+		params["uri"] = m_compilationFiles.sourceUnitNameToClientPath(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = move(diagnostics);
-		m_client.notify("textDocument/publishDiagnostics", move(params));
+		notifications.emplace_back(move(params));
 	}
+	m_client.notifyAll("textDocument/publishDiagnostics", move(notifications));
 }
 
 bool LanguageServer::run()
 {
+	m_stopCompilation = false;
+	m_compilationThread = thread([this] { compilationLoop(); });
+
 	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
 	{
 		MessageID id;
@@ -258,6 +501,8 @@ bool LanguageServer::run()
 				else
 					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 			}
+			else if (jsonMessage->isMember("result") || jsonMessage->isMember("error"))
+				handleResponse(*jsonMessage);
 			else
 				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
 		}
@@ -270,6 +515,8 @@ bool LanguageServer::run()
 			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
 	}
+	stopIndexingThread();
+	stopCompilationThread();
 	return m_state == State::ExitRequested;
 }
 
@@ -309,17 +556,95 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	else if (Json::Value rootPath = _args["rootPath"])
 		rootPath = rootPath.asString();
 
-	m_fileRepository = FileRepository(boost::filesystem::path(rootPath));
+	{
+		lock_guard lock(m_documentsMutex);
+		m_fileRepository = FileRepository(boost::filesystem::path(rootPath));
+	}
 	if (_args["initializationOptions"].isObject())
 		changeConfiguration(_args["initializationOptions"]);
+	m_workDoneProgressSupported = _args["capabilities"]["window"]["workDoneProgress"].asBool();
+	m_watchedFilesRegistrationSupported = _args["capabilities"]["workspace"]["didChangeWatchedFiles"]["dynamicRegistration"].asBool();
+	m_semanticTokensRefreshSupported = _args["capabilities"]["workspace"]["semanticTokens"]["refreshSupport"].asBool();
 
 	Json::Value replyArgs;
 	replyArgs["serverInfo"]["name"] = "solc";
 	replyArgs["serverInfo"]["version"] = string(VersionNumber);
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
+	replyArgs["capabilities"]["definitionProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
+	replyArgs["capabilities"]["workspaceSymbolProvider"] = true;
+	replyArgs["capabilities"]["documentSymbolProvider"] = true;
+	for (string const& tokenType: SemanticTokens::tokenTypes())
+		replyArgs["capabilities"]["semanticTokensProvider"]["legend"]["tokenTypes"].append(tokenType);
+	for (string const& tokenModifier: SemanticTokens::tokenModifiers())
+		replyArgs["capabilities"]["semanticTokensProvider"]["legend"]["tokenModifiers"].append(tokenModifier);
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
 
 	m_client.reply(_id, move(replyArgs));
+
+	// Without a root, the base path is the file system root, which is not worth indexing.
+	if (rootPath != "/")
+		m_indexingThread = thread([this, rootPath] { indexWorkspace(rootPath); });
+}
+
+void LanguageServer::handleInitialized()
+{
+	if (!m_watchedFilesRegistrationSupported)
+		return;
+
+	// Ask the client to report changes to files on disk, which invalidate the cached file contents.
+	Json::Value registration;
+	registration["id"] = "solc/watchedFiles";
+	registration["method"] = "workspace/didChangeWatchedFiles";
+	registration["registerOptions"]["watchers"][0]["globPattern"] = "**/*.sol";
+	Json::Value params;
+	params["registrations"].append(move(registration));
+	m_client.request("solc/registerWatchedFiles", "client/registerCapability", move(params));
+}
+
+void LanguageServer::indexWorkspace(boost::filesystem::path const& _rootPath)
+{
+	namespace fs = boost::filesystem;
+
+	// The file repository of the server is replaced on the message thread, so the
+	// source unit names are computed by a repository with the same base path.
+	FileRepository const files(_rootPath);
+	boost::system::error_code error;
+	fs::recursive_directory_iterator it(_rootPath, error);
+	for (; !error && !m_stopIndexing && it != fs::recursive_directory_iterator(); it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (boost::starts_with(path.filename().string(), "."))
+		{
+			// Skip hidden files and directories like ".git".
+			if (fs::is_directory(path, error))
+				it.no_push();
+			continue;
+		}
+		if (path.extension() != ".sol" || !fs::is_regular_file(path, error))
+			continue;
+
+		try
+		{
+			string const content = util::readFileAsString(path);
+			// Sources compiled in the meantime are already indexed with their contents in the editor.
+			m_symbolIndex.update(files.clientPathToSourceUnitName("file://" + path.generic_string()), content, false);
+		}
+		catch (...)
+		{
+			continue;
+		}
+	}
+}
+
+void LanguageServer::stopIndexingThread()
+{
+	if (!m_indexingThread.joinable())
+		return;
+
+	m_stopIndexing = true;
+	m_indexingThread.join();
 }
 
 void LanguageServer::handleWorkspaceDidChangeConfiguration(Json::Value const& _args)
@@ -342,9 +667,12 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 
 	string text = _args["textDocument"]["text"].asString();
 	string uri = _args["textDocument"]["uri"].asString();
-	m_openFiles.insert(uri);
-	m_fileRepository.setSourceByClientPath(uri, move(text));
-	compileAndUpdateDiagnostics();
+	{
+		lock_guard lock(m_documentsMutex);
+		m_openFiles.insert(uri);
+		m_fileRepository.setSourceByClientPath(uri, move(text));
+	}
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -369,23 +697,44 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 		);
 
 		string text = jsonContentChange["text"].asString();
+		lock_guard lock(m_documentsMutex);
 		if (jsonContentChange["range"].isObject()) // otherwise full content update
 		{
-			optional<SourceLocation> change = parseRange(sourceUnitName, jsonContentChange["range"]);
+			Json::Value const& range = jsonContentChange["range"];
+			optional<LineColumn> start = parseLineColumn(range["start"]);
+			optional<LineColumn> end = parseLineColumn(range["end"]);
 			lspAssert(
-				change && change->hasText(),
+				start && end && m_fileRepository.applyChange(uri, *start, *end, text),
 				ErrorCode::RequestFailed,
-				"Invalid source range: " + jsonCompactPrint(jsonContentChange["range"])
+				"Invalid source range: " + jsonCompactPrint(range)
 			);
-
-			string buffer = m_fileRepository.sourceUnits().at(sourceUnitName);
-			buffer.replace(static_cast<size_t>(change->start), static_cast<size_t>(change->end - change->start), move(text));
-			text = move(buffer);
 		}
-		m_fileRepository.setSourceByClientPath(uri, move(text));
+		else
+			m_fileRepository.setSourceByClientPath(uri, move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	scheduleCompilation();
+}
+
+void LanguageServer::handleWorkspaceDidChangeWatchedFiles(Json::Value const& _args)
+{
+	requireServerInitialized();
+
+	// FileChangeType
+	int constexpr fileDeleted = 3;
+
+	for (Json::Value const& change: _args["changes"])
+	{
+		string path = change["uri"].asString();
+		if (change["type"].asInt() == fileDeleted)
+			m_symbolIndex.remove(m_fileRepository.clientPathToSourceUnitName(path));
+		if (path.find("file://") == 0)
+			path.erase(0, 7);
+		m_fileReadCache->invalidate(FileReader::normalizeCLIPathForVFS(path, FileReader::SymlinkResolution::Enabled));
+	}
+
+	// Files that are not open are read from disk, so the diagnostics might change.
+	scheduleCompilation();
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -399,7 +748,163 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	);
 
 	string uri = _args["textDocument"]["uri"].asString();
-	m_openFiles.erase(uri);
+	m_semanticTokensResults.erase(uri);
+	{
+		lock_guard lock(m_documentsMutex);
+		m_openFiles.erase(uri);
+
+		// Only keep the contents of the files that are still open.
+		Snapshot const openFiles = snapshot();
+		m_fileRepository = FileRepository(openFiles.basePath);
+		for (auto const& [fileName, content]: openFiles.openFiles)
+			m_fileRepository.setSourceByClientPath(fileName, content);
+	}
+
+	scheduleCompilation();
+}
+
+pair<shared_ptr<PositionIndex const>, optional<int64_t>> LanguageServer::declarationAt(Json::Value const& _args)
+{
+	requireServerInitialized();
+
+	optional<LineColumn> position = parseLineColumn(_args["position"]);
+	lspAssert(
+		_args["textDocument"]["uri"].isString() && position,
+		ErrorCode::InvalidParams,
+		"Text document position expected."
+	);
+
+	shared_ptr<PositionIndex const> positionIndex;
+	{
+		lock_guard lock(m_positionIndexMutex);
+		positionIndex = m_positionIndex;
+	}
+	if (!positionIndex)
+		return {nullptr, nullopt};
+
+	string const sourceUnitName = m_fileRepository.clientPathToSourceUnitName(_args["textDocument"]["uri"].asString());
+	return {positionIndex, positionIndex->declarationAt(sourceUnitName, *position)};
+}
+
+Json::Value LanguageServer::toJson(PositionIndex::Range const& _range) const
+{
+	Json::Value item = Json::objectValue;
+	item["uri"] = m_fileRepository.sourceUnitNameToClientPath(_range.sourceUnitName);
+	item["range"] = toJsonRange(_range.start, _range.end);
+	return item;
+}
+
+void LanguageServer::handleTextDocumentDefinition(MessageID _id, Json::Value const& _args)
+{
+	auto [positionIndex, declaration] = declarationAt(_args);
+
+	Json::Value reply = Json::arrayValue;
+	if (declaration)
+		if (PositionIndex::Range const* definition = positionIndex->definition(*declaration))
+			reply.append(toJson(*definition));
+	m_client.reply(_id, move(reply));
+}
+
+void LanguageServer::handleTextDocumentReferences(MessageID _id, Json::Value const& _args)
+{
+	auto [positionIndex, declaration] = declarationAt(_args);
+
+	Json::Value reply = Json::arrayValue;
+	if (declaration)
+	{
+		if (_args["context"]["includeDeclaration"].asBool())
+			if (PositionIndex::Range const* definition = positionIndex->definition(*declaration))
+				reply.append(toJson(*definition));
+		for (PositionIndex::Range const& reference: positionIndex->references(*declaration))
+			reply.append(toJson(reference));
+	}
+	m_client.reply(_id, move(reply));
+}
+
+void LanguageServer::handleWorkspaceSymbol(MessageID _id, Json::Value const& _args)
+{
+	requireServerInitialized();
+
+	Json::Value reply = Json::arrayValue;
+	for (auto const& [sourceUnitName, symbol]: m_symbolIndex.find(_args["query"].asString()))
+	{
+		Json::Value item;
+		item["name"] = symbol.name;
+		item["kind"] = symbol.kind;
+		item["location"]["uri"] = m_fileRepository.sourceUnitNameToClientPath(sourceUnitName);
+		item["location"]["range"] = toJsonRange(symbol.start, symbol.end);
+		if (!symbol.containerName.empty())
+			item["containerName"] = symbol.containerName;
+		reply.append(move(item));
+	}
+	m_client.reply(_id, move(reply));
+}
+
+void LanguageServer::handleTextDocumentDocumentSymbol(MessageID _id, Json::Value const& _args)
+{
+	requireServerInitialized();
+	lspAssert(_args["textDocument"]["uri"].isString(), ErrorCode::InvalidParams, "Text document expected.");
+
+	string const uri = _args["textDocument"]["uri"].asString();
+	Json::Value reply = Json::arrayValue;
+	for (SymbolIndex::Symbol const& symbol: m_symbolIndex.symbols(m_fileRepository.clientPathToSourceUnitName(uri)))
+	{
+		Json::Value item;
+		item["name"] = symbol.name;
+		item["kind"] = symbol.kind;
+		item["location"]["uri"] = uri;
+		item["location"]["range"] = toJsonRange(symbol.start, symbol.end);
+		if (!symbol.containerName.empty())
+			item["containerName"] = symbol.containerName;
+		reply.append(move(item));
+	}
+	m_client.reply(_id, move(reply));
+}
+
+void LanguageServer::handleTextDocumentSemanticTokens(MessageID _id, Json::Value const& _args, bool _delta)
+{
+	requireServerInitialized();
+	lspAssert(_args["textDocument"]["uri"].isString(), ErrorCode::InvalidParams, "Text document expected.");
+
+	string const uri = _args["textDocument"]["uri"].asString();
+	shared_ptr<SemanticTokens const> semanticTokens;
+	{
+		lock_guard lock(m_positionIndexMutex);
+		semanticTokens = m_semanticTokens;
+	}
+	vector<uint32_t> tokens;
+	if (semanticTokens)
+		tokens = semanticTokens->tokens(m_fileRepository.clientPathToSourceUnitName(uri));
+
+	Json::Value reply;
+	if (
+		_delta &&
+		_args["previousResultId"].isString() &&
+		m_semanticTokensResults.count(uri) &&
+		m_semanticTokensResults.at(uri).first == _args["previousResultId"].asString()
+	)
+	{
+		reply["edits"] = Json::arrayValue;
+		for (SemanticTokens::Edit const& edit: SemanticTokens::edits(m_semanticTokensResults.at(uri).second, tokens))
+		{
+			Json::Value jsonEdit;
+			jsonEdit["start"] = Json::UInt64{edit.start};
+			jsonEdit["deleteCount"] = Json::UInt64{edit.deleteCount};
+			jsonEdit["data"] = Json::arrayValue;
+			for (uint32_t value: edit.data)
+				jsonEdit["data"].append(value);
+			reply["edits"].append(move(jsonEdit));
+		}
+	}
+	else
+	{
+		reply["data"] = Json::arrayValue;
+		for (uint32_t value: tokens)
+			reply["data"].append(value);
+	}
 
-	compileAndUpdateDiagnostics();
+	string const resultId = to_string(++m_semanticTokensResultCount);
+	reply["resultId"] = resultId;
+	m_semanticTokensResults[uri] = {resultId, move(tokens)};
+	m_client.reply(_id, move(reply));
 }
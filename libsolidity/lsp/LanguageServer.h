@@ -19,15 +19,26 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/lsp/PositionIndex.h>
+#include <libsolidity/lsp/SemanticTokens.h>
+#include <libsolidity/lsp/SymbolIndex.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
+#include <libyul/YulString.h>
+
 #include <json/value.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace solidity::lsp
@@ -39,14 +50,29 @@ enum class ErrorCode;
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * While the server runs, the project is compiled on a separate thread, so that messages
+ * are handled while a compilation is in progress. Changes arriving within the debounce
+ * delay of each other are compiled together and a compilation that is outdated by a newer
+ * change or cancelled by the user is abandoned between its phases. If the client supports it,
+ * the progress of the compilation is reported.
  */
 class LanguageServer
 {
 public:
 	/// @param _transport Customizable transport layer.
-	explicit LanguageServer(Transport& _transport);
+	/// @param _debounceDelay Time to wait for further changes before compiling.
+	explicit LanguageServer(
+		Transport& _transport,
+		std::chrono::milliseconds _debounceDelay = std::chrono::milliseconds{50}
+	);
+	~LanguageServer();
+
+	/// Sets the directory in which the symbols of the workspace are persisted across sessions.
+	void setCacheDirectory(boost::filesystem::path _directory) { m_symbolIndex.setCacheDirectory(std::move(_directory)); }
 
 	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Must not be called while the server is running.
 	void compileAndUpdateDiagnostics();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
@@ -58,31 +84,84 @@ public:
 	bool run();
 
 private:
+	/// Contents of the files open in the editor, by client path, at the time of a change.
+	struct Snapshot
+	{
+		boost::filesystem::path basePath;
+		std::map<std::string, std::string> openFiles;
+	};
+
+	/// @returns the current contents of the files open in the editor.
+	/// Requires m_documentsMutex to be locked, unless called on the thread handling the messages.
+	Snapshot snapshot() const;
+	/// Requests the compilation of the current contents of the open files, which happens
+	/// on the compilation thread if the server is running.
+	void scheduleCompilation();
+	/// Body of the compilation thread: Waits for snapshots and compiles the most recent one.
+	void compilationLoop();
+	/// @returns true if the compilation of @a _revision is outdated or was cancelled by the user
+	/// or the server stops.
+	bool compilationCancelled(uint64_t _revision);
+	/// Stops the compilation thread and waits for it to finish.
+	void stopCompilationThread();
+
+	/// Asks the client to create a progress indicator for the compilation of @a _revision,
+	/// if the client supports it.
+	void beginProgress(uint64_t _revision);
+	/// Reports that the compilation reached @a _step, once the client created the progress indicator.
+	void reportProgress(std::string const& _step);
+	/// Removes the progress indicator of the current compilation.
+	void endProgress();
+	/// Handles a response of the client to a request sent by the server.
+	void handleResponse(Json::Value const& _message);
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
 	void handleInitialize(MessageID _id, Json::Value const& _args);
+	void handleInitialized();
 	void handleWorkspaceDidChangeConfiguration(Json::Value const& _args);
 	void handleTextDocumentDidOpen(Json::Value const& _args);
 	void handleTextDocumentDidChange(Json::Value const& _args);
 	void handleTextDocumentDidClose(Json::Value const& _args);
+	void handleTextDocumentDefinition(MessageID _id, Json::Value const& _args);
+	void handleTextDocumentReferences(MessageID _id, Json::Value const& _args);
+	void handleWorkspaceSymbol(MessageID _id, Json::Value const& _args);
+	void handleTextDocumentDocumentSymbol(MessageID _id, Json::Value const& _args);
+	/// Handles the requests for all semantic tokens of a document and, if @a _delta is true,
+	/// for the changes since a previous result.
+	void handleTextDocumentSemanticTokens(MessageID _id, Json::Value const& _args, bool _delta);
+	void handleWorkDoneProgressCancel(Json::Value const& _args);
+	void handleWorkspaceDidChangeWatchedFiles(Json::Value const& _args);
+
+	/// Adds the symbols of all Solidity files below @a _rootPath to the symbol index.
+	/// Runs on the indexing thread and keeps the symbols of sources that were compiled meanwhile.
+	void indexWorkspace(boost::filesystem::path const& _rootPath);
+	/// Stops the indexing thread and waits for it to finish.
+	void stopIndexingThread();
+
+	/// @returns the position index of the most recent compilation that performed the analysis
+	/// and the ID of the declaration at the text document position given by @a _args.
+	std::pair<std::shared_ptr<PositionIndex const>, std::optional<int64_t>> declarationAt(Json::Value const& _args);
+	/// @returns an LSP Location object for @a _range.
+	Json::Value toJson(PositionIndex::Range const& _range) const;
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
+	/// Compiles @a _snapshot until after analysis phase and publishes the diagnostics, unless
+	/// @a _cancelled returns true at a boundary between phases.
+	void compileAndUpdateDiagnostics(Snapshot const& _snapshot, std::function<bool()> const& _cancelled);
+
 	/// Compile everything until after analysis phase.
-	void compile();
-
-	std::optional<langutil::SourceLocation> parsePosition(
-		std::string const& _sourceUnitName,
-		Json::Value const& _position
-	) const;
-	/// @returns the source location given a source unit name and an LSP Range object,
-	/// or nullopt on failure.
-	std::optional<langutil::SourceLocation> parseRange(
-		std::string const& _sourceUnitName,
-		Json::Value const& _range
-	) const;
+	/// Keeps the previous results if no source changed since the last compilation.
+	/// @returns false if the compilation was cancelled.
+	bool compile(Snapshot const& _snapshot, std::function<bool()> const& _cancelled);
+
+	/// @returns the names of the sources that were added, removed or modified (in the editor
+	/// or on disk) since the last compilation.
+	std::set<std::string> changedSources();
+
 	Json::Value toRange(langutil::SourceLocation const& _location) const;
 	Json::Value toJson(langutil::SourceLocation const& _location) const;
 
@@ -95,13 +174,75 @@ private:
 	Transport& m_client;
 	std::map<std::string, MessageHandler> m_handlers;
 
+	/// Protects the files below against modification while the compilation thread reads them.
+	std::mutex m_documentsMutex;
 	/// Set of files known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
+	/// Contents of the files as changed by the client.
 	FileRepository m_fileRepository;
 
+	// Members only used for compiling and publishing diagnostics, i.e. on the compilation
+	// thread while the server is running.
+
+	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	std::set<std::string> m_nonemptyDiagnostics;
+	/// Files of the most recent compilation, including the files read from disk.
+	FileRepository m_compilationFiles;
+	/// Number of requests sent to the client to refresh the semantic tokens.
+	uint64_t m_semanticTokensRefreshCount = 0;
+	/// Files read from disk by the compilations, invalidated on changes reported by the client.
+	/// Its size is limited, because files that are no longer imported are never removed otherwise.
+	std::shared_ptr<frontend::FileReadCache> m_fileReadCache = std::make_shared<frontend::FileReadCache>(64 * 1024 * 1024);
 	frontend::CompilerStack m_compilerStack;
+	/// Owns the Yul strings of the most recent compilation, so that they are freed with it.
+	std::unique_ptr<yul::YulStringRepository> m_yulStrings;
+
+	std::chrono::milliseconds m_debounceDelay;
+	std::thread m_compilationThread;
+	/// Protects the members below, which notify the compilation thread.
+	std::mutex m_compilationMutex;
+	std::condition_variable m_compilationRequested;
+	/// Whether the open files changed since the last compilation started.
+	bool m_compilationPending = false;
+	/// Number of compilations requested so far.
+	uint64_t m_revision = 0;
+	bool m_stopCompilation = false;
+	/// Progress indicator of the running compilation.
+	struct Progress
+	{
+		std::string token;
+		/// Whether the client responded to the request that creates the indicator.
+		bool created = false;
+		bool begun = false;
+		bool cancelled = false;
+	};
+	std::optional<Progress> m_progress;
+
+	/// Whether the client supports progress indicators created by the server.
+	std::atomic<bool> m_workDoneProgressSupported{false};
+	/// Whether the client supports registering for notifications about changed files.
+	bool m_watchedFilesRegistrationSupported = false;
+
+	/// Symbols of the files in the workspace and of the compiled files.
+	SymbolIndex m_symbolIndex;
+	/// Adds the files of the workspace to the symbol index after the initialization,
+	/// so that messages are handled while it reads and parses them.
+	std::thread m_indexingThread;
+	std::atomic<bool> m_stopIndexing{false};
+
+	/// Protects the indices below, which are replaced by the compilation thread.
+	std::mutex m_positionIndexMutex;
+	/// Position index of the most recent compilation that performed the analysis.
+	std::shared_ptr<PositionIndex const> m_positionIndex;
+	/// Semantic tokens of the most recent compilation that performed the analysis.
+	std::shared_ptr<SemanticTokens const> m_semanticTokens;
+
+	/// Whether the client can be asked to request the semantic tokens again.
+	std::atomic<bool> m_semanticTokensRefreshSupported{false};
+	/// ID and data of the semantic tokens last sent for each file, by client path,
+	/// so that only the changes can be sent for the next request.
+	std::map<std::string, std::pair<std::string, std::vector<uint32_t>>> m_semanticTokensResults;
+	uint64_t m_semanticTokensResultCount = 0;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
@@ -0,0 +1,174 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/PositionIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+namespace
+{
+
+bool before(LineColumn const& _a, LineColumn const& _b)
+{
+	return tie(_a.line, _a.column) < tie(_b.line, _b.column);
+}
+
+}
+
+namespace solidity::lsp
+{
+
+/// Collects the spans, definitions and references of one source unit.
+class PositionIndexBuilder: public ASTConstVisitor
+{
+public:
+	PositionIndexBuilder(PositionIndex& _index, string const& _sourceUnitName, CharStream const& _charStream):
+		m_index(_index), m_sourceUnitName(_sourceUnitName), m_charStream(_charStream)
+	{}
+
+	void build(SourceUnit const& _sourceUnit)
+	{
+		_sourceUnit.accept(*this);
+
+		vector<PositionIndex::Span>& spans = m_index.m_spans[m_sourceUnitName];
+		// Nodes are visited before their children, so a stable sort keeps the outer
+		// of two nodes with the same range first.
+		stable_sort(spans.begin(), spans.end(), [](PositionIndex::Span const& _a, PositionIndex::Span const& _b) {
+			return before(_a.start, _b.start) || (!before(_b.start, _a.start) && before(_b.end, _a.end));
+		});
+		vector<size_t> enclosing;
+		for (size_t i = 0; i < spans.size(); ++i)
+		{
+			while (!enclosing.empty() && before(spans[enclosing.back()].end, spans[i].end))
+				enclosing.pop_back();
+			spans[i].parent = enclosing.empty() ? PositionIndex::npos : enclosing.back();
+			enclosing.push_back(i);
+		}
+	}
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (!_node.location().hasText())
+			return true;
+
+		optional<int64_t> declaration;
+		if (auto const* declarationNode = dynamic_cast<Declaration const*>(&_node))
+		{
+			declaration = declarationNode->id();
+			if (declarationNode->nameLocation().hasText())
+				m_index.m_definitions[declarationNode->id()] = range(declarationNode->nameLocation());
+		}
+		else if (Declaration const* referenced = referencedDeclaration(_node))
+		{
+			declaration = referenced->id();
+			m_index.m_references[referenced->id()].emplace_back(range(_node.location()));
+		}
+
+		PositionIndex::Range nodeRange = range(_node.location());
+		m_index.m_spans[m_sourceUnitName].push_back({nodeRange.start, nodeRange.end, PositionIndex::npos, declaration});
+		return true;
+	}
+
+	static Declaration const* referencedDeclaration(ASTNode const& _node)
+	{
+		if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+			return identifier->annotation().referencedDeclaration;
+		else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+			return memberAccess->annotation().referencedDeclaration;
+		else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_node))
+			return identifierPath->annotation().referencedDeclaration;
+		return nullptr;
+	}
+
+	PositionIndex::Range range(SourceLocation const& _location) const
+	{
+		return {
+			m_sourceUnitName,
+			m_charStream.translatePositionToLineColumn(_location.start),
+			m_charStream.translatePositionToLineColumn(_location.end)
+		};
+	}
+
+	PositionIndex& m_index;
+	string const& m_sourceUnitName;
+	CharStream const& m_charStream;
+};
+
+}
+
+PositionIndex::PositionIndex(CompilerStack const& _compilerStack)
+{
+	for (string const& sourceUnitName: _compilerStack.sourceNames())
+		PositionIndexBuilder{*this, sourceUnitName, _compilerStack.charStream(sourceUnitName)}.build(
+			_compilerStack.ast(sourceUnitName)
+		);
+
+	for (auto& [declaration, references]: m_references)
+		stable_sort(references.begin(), references.end(), [](Range const& _a, Range const& _b) {
+			return tie(_a.sourceUnitName, _a.start.line, _a.start.column) < tie(_b.sourceUnitName, _b.start.line, _b.start.column);
+		});
+}
+
+optional<int64_t> PositionIndex::declarationAt(string const& _sourceUnitName, LineColumn _position) const
+{
+	auto spans = m_spans.find(_sourceUnitName);
+	if (spans == m_spans.end())
+		return nullopt;
+
+	// Only the span starting last before the position or one of the spans containing it
+	// can be the innermost span containing the position.
+	auto it = upper_bound(spans->second.begin(), spans->second.end(), _position, [](LineColumn const& _a, Span const& _b) {
+		return before(_a, _b.start);
+	});
+	if (it == spans->second.begin())
+		return nullopt;
+	size_t index = static_cast<size_t>(it - spans->second.begin()) - 1;
+	while (index != npos && before(spans->second[index].end, _position))
+		index = spans->second[index].parent;
+
+	if (index == npos)
+		return nullopt;
+	return spans->second[index].declaration;
+}
+
+PositionIndex::Range const* PositionIndex::definition(int64_t _declaration) const
+{
+	auto it = m_definitions.find(_declaration);
+	return it == m_definitions.end() ? nullptr : &it->second;
+}
+
+vector<PositionIndex::Range> const& PositionIndex::references(int64_t _declaration) const
+{
+	static vector<Range> const noReferences;
+	auto it = m_references.find(_declaration);
+	return it == m_references.end() ? noReferences : it->second;
+}
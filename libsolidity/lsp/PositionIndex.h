@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Index of the AST nodes of an analysed compilation by their source ranges and of the
+ * references to each declaration, used to answer navigation requests.
+ *
+ * Nodes and declarations are identified by their AST IDs and ranges are stored as line and
+ * column ranges, so that the index stays usable after the compiler stack was reset or
+ * moved on to the next compilation.
+ */
+class PositionIndex
+{
+public:
+	struct Range
+	{
+		std::string sourceUnitName;
+		langutil::LineColumn start;
+		langutil::LineColumn end;
+	};
+
+	/// Indexes the sources of @a _compilerStack, which has to have performed the analysis.
+	explicit PositionIndex(frontend::CompilerStack const& _compilerStack);
+
+	/// @returns the ID of the declaration that the innermost node containing @a _position
+	/// declares or refers to, or nullopt if that node neither declares nor refers to one.
+	std::optional<int64_t> declarationAt(std::string const& _sourceUnitName, langutil::LineColumn _position) const;
+	/// @returns the range of the name of the declaration with ID @a _declaration, or nullptr,
+	/// if the declaration is not part of the indexed sources.
+	Range const* definition(int64_t _declaration) const;
+	/// @returns the ranges of the identifiers, member accesses and identifier paths
+	/// referring to the declaration with ID @a _declaration, in source order.
+	std::vector<Range> const& references(int64_t _declaration) const;
+
+private:
+	struct Span
+	{
+		langutil::LineColumn start;
+		langutil::LineColumn end;
+		/// Index of the innermost span containing this one, or npos if there is none.
+		size_t parent;
+		/// ID of the declaration declared or referred to by the node.
+		std::optional<int64_t> declaration;
+	};
+	static size_t constexpr npos = static_cast<size_t>(-1);
+
+	/// Spans of all nodes by source unit name, sorted by their start and, for equal starts,
+	/// from the outermost to the innermost span.
+	std::map<std::string, std::vector<Span>> m_spans;
+	std::map<int64_t, Range> m_definitions;
+	std::map<int64_t, std::vector<Range>> m_references;
+
+	friend class PositionIndexBuilder;
+};
+
+}
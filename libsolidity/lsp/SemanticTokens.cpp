@@ -0,0 +1,294 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/SemanticTokens.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/Types.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <algorithm>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+namespace
+{
+
+/// Token types in the order of tokenTypes().
+enum class TokenType: uint32_t
+{
+	Keyword,
+	Type,
+	Number,
+	String,
+	Namespace,
+	Class,
+	Interface,
+	Struct,
+	Enum,
+	EnumMember,
+	Function,
+	Modifier,
+	Event,
+	Variable,
+	Parameter,
+	Property
+};
+
+/// Token modifiers as bits in the order of tokenModifiers().
+enum TokenModifier: uint32_t
+{
+	Declaration = 1,
+	Readonly = 2,
+	DefaultLibrary = 4
+};
+
+struct Classification
+{
+	TokenType type;
+	uint32_t modifiers;
+};
+
+optional<Classification> classify(frontend::Declaration const& _declaration)
+{
+	if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_declaration))
+		return Classification{contract->isInterface() ? TokenType::Interface : TokenType::Class, 0};
+	else if (dynamic_cast<StructDefinition const*>(&_declaration))
+		return Classification{TokenType::Struct, 0};
+	else if (dynamic_cast<EnumDefinition const*>(&_declaration))
+		return Classification{TokenType::Enum, 0};
+	else if (dynamic_cast<EnumValue const*>(&_declaration))
+		return Classification{TokenType::EnumMember, Readonly};
+	else if (
+		dynamic_cast<UserDefinedValueTypeDefinition const*>(&_declaration) ||
+		dynamic_cast<ErrorDefinition const*>(&_declaration)
+	)
+		return Classification{TokenType::Type, 0};
+	else if (dynamic_cast<FunctionDefinition const*>(&_declaration))
+		return Classification{TokenType::Function, 0};
+	else if (dynamic_cast<ModifierDefinition const*>(&_declaration))
+		return Classification{TokenType::Modifier, 0};
+	else if (dynamic_cast<EventDefinition const*>(&_declaration))
+		return Classification{TokenType::Event, 0};
+	else if (dynamic_cast<ImportDirective const*>(&_declaration))
+		return Classification{TokenType::Namespace, 0};
+	else if (auto const* variable = dynamic_cast<VariableDeclaration const*>(&_declaration))
+	{
+		uint32_t modifiers = variable->isConstant() || variable->immutable() ? static_cast<uint32_t>(Readonly) : 0u;
+		if (variable->isStateVariable())
+			return Classification{TokenType::Property, modifiers};
+		else if (variable->isCallableOrCatchParameter())
+			return Classification{TokenType::Parameter, modifiers};
+		else
+			return Classification{TokenType::Variable, modifiers};
+	}
+	else if (auto const* magicVariable = dynamic_cast<MagicVariableDeclaration const*>(&_declaration))
+		return Classification{
+			dynamic_cast<FunctionType const*>(magicVariable->type()) ? TokenType::Function : TokenType::Variable,
+			DefaultLibrary
+		};
+	return nullopt;
+}
+
+optional<Classification> classify(Token _token)
+{
+	if (
+		(Token::Abstract <= _token && _token <= Token::SubYear) ||
+		TokenTraits::isReservedKeyword(_token) ||
+		_token == Token::Delete ||
+		_token == Token::TrueLiteral ||
+		_token == Token::FalseLiteral
+	)
+		return Classification{TokenType::Keyword, 0};
+	else if (TokenTraits::isElementaryTypeName(_token))
+		return Classification{TokenType::Type, DefaultLibrary};
+	else if (_token == Token::Number)
+		return Classification{TokenType::Number, 0};
+	else if (_token == Token::StringLiteral || _token == Token::UnicodeStringLiteral || _token == Token::HexStringLiteral)
+		return Classification{TokenType::String, 0};
+	return nullopt;
+}
+
+/// Collects the classifications of the identifiers that declare or refer to a declaration,
+/// by the end of their location. Identifiers in paths and member accesses are the last part
+/// of the location of the node.
+class IdentifierCollector: public ASTConstVisitor
+{
+public:
+	map<int, Classification> collect(SourceUnit const& _sourceUnit)
+	{
+		_sourceUnit.accept(*this);
+		return move(m_identifiers);
+	}
+
+private:
+	bool visit(Identifier const& _identifier) override
+	{
+		addReference(_identifier.location(), _identifier.annotation().referencedDeclaration);
+		return true;
+	}
+
+	bool visit(MemberAccess const& _memberAccess) override
+	{
+		addReference(_memberAccess.location(), _memberAccess.annotation().referencedDeclaration);
+		return true;
+	}
+
+	bool visit(IdentifierPath const& _identifierPath) override
+	{
+		addReference(_identifierPath.location(), _identifierPath.annotation().referencedDeclaration);
+		return true;
+	}
+
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (auto const* declaration = dynamic_cast<frontend::Declaration const*>(&_node))
+			if (declaration->nameLocation().hasText())
+				if (optional<Classification> classification = classify(*declaration))
+				{
+					classification->modifiers |= TokenModifier::Declaration;
+					m_identifiers[declaration->nameLocation().end] = *classification;
+				}
+		return true;
+	}
+
+	void addReference(SourceLocation const& _location, frontend::Declaration const* _declaration)
+	{
+		if (_declaration && _location.hasText())
+			if (optional<Classification> classification = classify(*_declaration))
+				m_identifiers[_location.end] = *classification;
+	}
+
+	map<int, Classification> m_identifiers;
+};
+
+vector<uint32_t> encode(CharStream const& _charStream, map<int, Classification> const& _identifiers)
+{
+	CharStream stream(_charStream.source(), _charStream.name());
+	Scanner scanner(stream);
+
+	vector<uint32_t> data;
+	LineColumn previous{0, 0};
+	for (Token token = scanner.currentToken(); token != Token::EOS; token = scanner.next())
+	{
+		SourceLocation const location = scanner.currentLocation();
+		optional<Classification> classification;
+		if (token == Token::Identifier)
+		{
+			if (auto it = _identifiers.find(location.end); it != _identifiers.end())
+				classification = it->second;
+		}
+		else
+			classification = classify(token);
+		if (!classification)
+			continue;
+
+		LineColumn const start = _charStream.translatePositionToLineColumn(location.start);
+		LineColumn const end = _charStream.translatePositionToLineColumn(location.end);
+		// Only tokens on a single line can be encoded.
+		if (start.line != end.line)
+			continue;
+
+		data.push_back(static_cast<uint32_t>(start.line - previous.line));
+		data.push_back(static_cast<uint32_t>(start.line == previous.line ? start.column - previous.column : start.column));
+		data.push_back(static_cast<uint32_t>(end.column - start.column));
+		data.push_back(static_cast<uint32_t>(classification->type));
+		data.push_back(classification->modifiers);
+		previous = start;
+	}
+	return data;
+}
+
+}
+
+SemanticTokens::SemanticTokens(CompilerStack const& _compilerStack)
+{
+	for (string const& sourceUnitName: _compilerStack.sourceNames())
+		m_tokens[sourceUnitName] = encode(
+			_compilerStack.charStream(sourceUnitName),
+			IdentifierCollector{}.collect(_compilerStack.ast(sourceUnitName))
+		);
+}
+
+vector<string> const& SemanticTokens::tokenTypes()
+{
+	static vector<string> const tokenTypes{
+		"keyword",
+		"type",
+		"number",
+		"string",
+		"namespace",
+		"class",
+		"interface",
+		"struct",
+		"enum",
+		"enumMember",
+		"function",
+		"modifier",
+		"event",
+		"variable",
+		"parameter",
+		"property"
+	};
+	return tokenTypes;
+}
+
+vector<string> const& SemanticTokens::tokenModifiers()
+{
+	static vector<string> const tokenModifiers{"declaration", "readonly", "defaultLibrary"};
+	return tokenModifiers;
+}
+
+vector<uint32_t> const& SemanticTokens::tokens(string const& _sourceUnitName) const
+{
+	static vector<uint32_t> const noTokens;
+	auto it = m_tokens.find(_sourceUnitName);
+	return it == m_tokens.end() ? noTokens : it->second;
+}
+
+vector<SemanticTokens::Edit> SemanticTokens::edits(vector<uint32_t> const& _previous, vector<uint32_t> const& _current)
+{
+	if (_previous == _current)
+		return {};
+
+	size_t prefix = static_cast<size_t>(
+		mismatch(_previous.begin(), _previous.end(), _current.begin(), _current.end()).first - _previous.begin()
+	);
+	size_t suffix = 0;
+	while (
+		suffix < _previous.size() - prefix &&
+		suffix < _current.size() - prefix &&
+		_previous[_previous.size() - 1 - suffix] == _current[_current.size() - 1 - suffix]
+	)
+		++suffix;
+
+	return {Edit{
+		prefix,
+		_previous.size() - prefix - suffix,
+		vector<uint32_t>(_current.begin() + static_cast<ptrdiff_t>(prefix), _current.end() - static_cast<ptrdiff_t>(suffix))
+	}};
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Semantic tokens of the sources of an analysed compilation, in the relative encoding of LSP.
+ *
+ * Keywords, elementary type names and literals are taken from the token stream of the scanner,
+ * identifiers are classified by the declarations they declare or refer to. Identifiers whose
+ * declaration is not known (e.g. members of built-in types or Yul identifiers) are left to the
+ * syntactic highlighting of the client.
+ */
+class SemanticTokens
+{
+public:
+	/// Indexes the sources of @a _compilerStack, which has to have performed the analysis.
+	explicit SemanticTokens(frontend::CompilerStack const& _compilerStack);
+
+	/// Names of the token types, in the order of their indices in the encoded tokens.
+	static std::vector<std::string> const& tokenTypes();
+	/// Names of the token modifiers, in the order of their bits in the encoded tokens.
+	static std::vector<std::string> const& tokenModifiers();
+
+	/// @returns the encoded tokens of @a _sourceUnitName, which are empty if the source
+	/// is not part of the compilation.
+	std::vector<uint32_t> const& tokens(std::string const& _sourceUnitName) const;
+
+	/// Replacement of a range of the encoded tokens.
+	struct Edit
+	{
+		size_t start;
+		size_t deleteCount;
+		std::vector<uint32_t> data;
+	};
+
+	/// @returns the edits that turn the encoded tokens @a _previous into @a _current, i.e.
+	/// nothing if they are equal and otherwise a single edit replacing everything between
+	/// their common prefix and their common suffix.
+	static std::vector<Edit> edits(std::vector<uint32_t> const& _previous, std::vector<uint32_t> const& _current);
+
+private:
+	std::map<std::string, std::vector<uint32_t>> m_tokens;
+};
+
+}
@@ -0,0 +1,260 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/SymbolIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <libyul/YulString.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+namespace
+{
+
+// LSP SymbolKind values
+int constexpr symbolKindModule = 2;
+int constexpr symbolKindClass = 5;
+int constexpr symbolKindMethod = 6;
+int constexpr symbolKindConstructor = 9;
+int constexpr symbolKindInterface = 11;
+int constexpr symbolKindFunction = 12;
+int constexpr symbolKindObject = 19;
+int constexpr symbolKindEvent = 24;
+
+/// Collects the contracts, functions, events and errors of a source unit.
+class SymbolCollector: public ASTConstVisitor
+{
+public:
+	explicit SymbolCollector(CharStream const& _charStream): m_charStream(_charStream) {}
+
+	vector<SymbolIndex::Symbol> collect(SourceUnit const& _sourceUnit)
+	{
+		_sourceUnit.accept(*this);
+		return move(m_symbols);
+	}
+
+private:
+	bool visit(ContractDefinition const& _contract) override
+	{
+		int kind = symbolKindClass;
+		if (_contract.isInterface())
+			kind = symbolKindInterface;
+		else if (_contract.isLibrary())
+			kind = symbolKindModule;
+		add(_contract, _contract.name(), kind);
+		m_contractName = _contract.name();
+		return true;
+	}
+	void endVisit(ContractDefinition const&) override { m_contractName.clear(); }
+
+	bool visit(FunctionDefinition const& _function) override
+	{
+		int kind = m_contractName.empty() ? symbolKindFunction : symbolKindMethod;
+		if (_function.isConstructor())
+			kind = symbolKindConstructor;
+		add(_function, _function.name().empty() ? TokenTraits::toString(_function.kind()) : _function.name(), kind);
+		return false;
+	}
+	bool visit(EventDefinition const& _event) override
+	{
+		add(_event, _event.name(), symbolKindEvent);
+		return false;
+	}
+	bool visit(ErrorDefinition const& _error) override
+	{
+		add(_error, _error.name(), symbolKindObject);
+		return false;
+	}
+	bool visit(ModifierDefinition const&) override { return false; }
+	bool visit(VariableDeclaration const&) override { return false; }
+
+	void add(Declaration const& _declaration, string _name, int _kind)
+	{
+		SourceLocation const& location = _declaration.nameLocation().hasText() ?
+			_declaration.nameLocation() :
+			_declaration.location();
+		if (!location.hasText())
+			return;
+		m_symbols.push_back({
+			move(_name),
+			m_contractName,
+			_kind,
+			m_charStream.translatePositionToLineColumn(location.start),
+			m_charStream.translatePositionToLineColumn(location.end)
+		});
+	}
+
+	CharStream const& m_charStream;
+	string m_contractName;
+	vector<SymbolIndex::Symbol> m_symbols;
+};
+
+util::h256 contentHash(string const& _content)
+{
+	// The version is part of the hash, since the parser and the extraction of the symbols
+	// can change with it.
+	return util::keccak256("lsp-symbols\n" + string(frontend::VersionString) + "\n" + _content);
+}
+
+string toJson(vector<SymbolIndex::Symbol> const& _symbols)
+{
+	Json::Value json = Json::arrayValue;
+	for (SymbolIndex::Symbol const& symbol: _symbols)
+	{
+		Json::Value item = Json::arrayValue;
+		item.append(symbol.name);
+		item.append(symbol.containerName);
+		item.append(symbol.kind);
+		item.append(symbol.start.line);
+		item.append(symbol.start.column);
+		item.append(symbol.end.line);
+		item.append(symbol.end.column);
+		json.append(move(item));
+	}
+	return util::jsonCompactPrint(json);
+}
+
+optional<vector<SymbolIndex::Symbol>> fromJson(string const& _content)
+{
+	Json::Value json;
+	if (!util::jsonParseStrict(_content, json) || !json.isArray())
+		return nullopt;
+
+	vector<SymbolIndex::Symbol> symbols;
+	for (Json::Value const& item: json)
+	{
+		if (!item.isArray() || item.size() != 7 || !item[0].isString() || !item[1].isString())
+			return nullopt;
+		for (Json::ArrayIndex i = 2; i < 7; ++i)
+			if (!item[i].isInt())
+				return nullopt;
+		symbols.push_back({
+			item[0].asString(),
+			item[1].asString(),
+			item[2].asInt(),
+			LineColumn{item[3].asInt(), item[4].asInt()},
+			LineColumn{item[5].asInt(), item[6].asInt()}
+		});
+	}
+	return symbols;
+}
+
+}
+
+void SymbolIndex::setCacheDirectory(boost::filesystem::path _directory)
+{
+	lock_guard lock(m_mutex);
+	m_cache.emplace(move(_directory));
+}
+
+void SymbolIndex::update(string const& _sourceUnitName, string const& _content, bool _replace)
+{
+	util::h256 hash = contentHash(_content);
+	if (lookup(_sourceUnitName, hash, _replace))
+		return;
+
+	yul::YulStringRepository yulStrings;
+	yul::YulStringRepository::Scope yulStringScope(yulStrings);
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(_content, _sourceUnitName);
+	ASTPointer<SourceUnit> ast = Parser{errorReporter, EVMVersion{}}.parse(charStream);
+	store(_sourceUnitName, hash, ast ? SymbolCollector{charStream}.collect(*ast) : vector<Symbol>{}, _replace);
+}
+
+void SymbolIndex::update(CharStream const& _charStream, SourceUnit const& _ast)
+{
+	util::h256 hash = contentHash(_charStream.source());
+	if (!lookup(_charStream.name(), hash))
+		store(_charStream.name(), hash, SymbolCollector{_charStream}.collect(_ast));
+}
+
+void SymbolIndex::remove(string const& _sourceUnitName)
+{
+	string const directory = boost::ends_with(_sourceUnitName, "/") ? _sourceUnitName : _sourceUnitName + "/";
+	lock_guard lock(m_mutex);
+	m_entries.erase(_sourceUnitName);
+	for (auto it = m_entries.lower_bound(directory); it != m_entries.end() && boost::starts_with(it->first, directory);)
+		it = m_entries.erase(it);
+}
+
+vector<pair<string, SymbolIndex::Symbol>> SymbolIndex::find(string const& _query) const
+{
+	string const query = boost::to_lower_copy(_query);
+	vector<pair<string, Symbol>> result;
+	lock_guard lock(m_mutex);
+	for (auto const& [sourceUnitName, entry]: m_entries)
+		for (Symbol const& symbol: entry.symbols)
+			if (boost::to_lower_copy(symbol.name).find(query) != string::npos)
+				result.emplace_back(sourceUnitName, symbol);
+	return result;
+}
+
+vector<SymbolIndex::Symbol> SymbolIndex::symbols(string const& _sourceUnitName) const
+{
+	lock_guard lock(m_mutex);
+	auto it = m_entries.find(_sourceUnitName);
+	return it == m_entries.end() ? vector<Symbol>{} : it->second.symbols;
+}
+
+bool SymbolIndex::lookup(string const& _sourceUnitName, util::h256 const& _contentHash, bool _replace)
+{
+	lock_guard lock(m_mutex);
+	auto it = m_entries.find(_sourceUnitName);
+	if (it != m_entries.end() && (it->second.contentHash == _contentHash || !_replace))
+		return true;
+	if (!m_cache)
+		return false;
+
+	optional<vector<Symbol>> symbols;
+	m_cache->lookup(_contentHash, [&](string const& _content) {
+		symbols = fromJson(_content);
+		return symbols.has_value();
+	});
+	if (!symbols)
+		return false;
+	m_entries[_sourceUnitName] = {_contentHash, move(*symbols)};
+	return true;
+}
+
+void SymbolIndex::store(string const& _sourceUnitName, util::h256 const& _contentHash, vector<Symbol> _symbols, bool _replace)
+{
+	lock_guard lock(m_mutex);
+	if (m_cache)
+		m_cache->store(_contentHash, toJson(_symbols));
+	if (_replace || !m_entries.count(_sourceUnitName))
+		m_entries[_sourceUnitName] = {_contentHash, move(_symbols)};
+}
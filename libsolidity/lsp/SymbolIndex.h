@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::langutil
+{
+class CharStream;
+}
+
+namespace solidity::frontend
+{
+class SourceUnit;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Index of the contracts, functions, events and errors declared in the sources of a
+ * workspace, used to answer workspace/symbol requests.
+ *
+ * The symbols of a source only depend on its content, so they are extracted from the AST
+ * of the source parsed on its own and, if a cache directory is set, persisted keyed by the
+ * hash of the content. This makes the symbols of unchanged sources available right after
+ * the server starts without compiling the workspace.
+ *
+ * The index can be used from multiple threads.
+ */
+class SymbolIndex
+{
+public:
+	struct Symbol
+	{
+		std::string name;
+		/// Name of the contract containing the symbol, empty for symbols at file level.
+		std::string containerName;
+		/// LSP SymbolKind
+		int kind;
+		langutil::LineColumn start;
+		langutil::LineColumn end;
+	};
+
+	/// Sets the directory in which the symbols of sources are persisted.
+	void setCacheDirectory(boost::filesystem::path _directory);
+
+	/// Updates the symbols of @a _sourceUnitName to those declared in @a _content,
+	/// which is parsed unless its symbols are known.
+	/// If @a _replace is false, symbols that are already known for the source are kept,
+	/// even if they were updated while @a _content was parsed.
+	void update(std::string const& _sourceUnitName, std::string const& _content, bool _replace = true);
+	/// Updates the symbols of @a _charStream from its already parsed AST @a _ast.
+	void update(langutil::CharStream const& _charStream, frontend::SourceUnit const& _ast);
+	/// Removes the symbols of @a _sourceUnitName and, if it names a directory, of all sources below it.
+	void remove(std::string const& _sourceUnitName);
+
+	/// @returns the symbols whose names contain @a _query, ignoring case, together
+	/// with the names of their source units.
+	std::vector<std::pair<std::string, Symbol>> find(std::string const& _query) const;
+	/// @returns the symbols declared in @a _sourceUnitName, in source order.
+	std::vector<Symbol> symbols(std::string const& _sourceUnitName) const;
+
+private:
+	struct Entry
+	{
+		util::h256 contentHash;
+		std::vector<Symbol> symbols;
+	};
+
+	/// @returns true if the symbols of @a _sourceUnitName are already those of @a _contentHash
+	/// (or are known at all, if @a _replace is false), or could be restored from the cache.
+	bool lookup(std::string const& _sourceUnitName, util::h256 const& _contentHash, bool _replace = true);
+	void store(std::string const& _sourceUnitName, util::h256 const& _contentHash, std::vector<Symbol> _symbols, bool _replace = true);
+
+	mutable std::mutex m_mutex;
+	std::optional<frontend::CompilationCache> m_cache;
+	std::map<std::string, Entry> m_entries;
+};
+
+}
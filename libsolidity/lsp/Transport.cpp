@@ -23,13 +23,46 @@
 #include <liblangutil/Exceptions.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <limits>
 #include <iostream>
 #include <sstream>
 
 using namespace std;
 using namespace solidity::lsp;
 
+namespace
+{
+
+/// @returns the queue a received message is put into, lower numbers are handled first.
+/// Document changes must not overtake the initialization or each other, so they share
+/// their priority with all other notifications, the lifecycle requests and the responses
+/// to requests of the server.
+size_t priority(Json::Value const& _message)
+{
+	string const method = _message["method"].isString() ? _message["method"].asString() : "";
+	if (method == "$/cancelRequest" || method == "cancelRequest")
+		return 0;
+	else if (_message["id"].isNull() || method.empty() || method == "initialize" || method == "shutdown")
+		return 1;
+	else
+		return 2;
+}
+
+/// @returns true if no message may be handled across @a _message, in either direction.
+/// The requests that arrived before the shutdown still have to be answered by the server and
+/// the ones that arrive after it have to be rejected.
+bool isLifecycleMessage(Json::Value const& _message)
+{
+	return _message["method"] == "shutdown" || _message["method"] == "exit";
+}
+
+}
+
 IOStreamTransport::IOStreamTransport(istream& _in, ostream& _out):
 	m_input{_in},
 	m_output{_out}
@@ -83,6 +116,31 @@ void IOStreamTransport::notify(string _method, Json::Value _message)
 	send(move(json));
 }
 
+void IOStreamTransport::notifyAll(string _method, vector<Json::Value> _params)
+{
+	string output;
+	for (Json::Value& params: _params)
+	{
+		Json::Value json;
+		json["method"] = _method;
+		json["params"] = move(params);
+		output += encode(move(json), Json::nullValue);
+	}
+
+	lock_guard lock(m_outputMutex);
+	m_output << output;
+	m_output.flush();
+}
+
+void IOStreamTransport::request(MessageID _id, string _method, Json::Value _params)
+{
+	Json::Value json;
+	json["method"] = move(_method);
+	if (!_params.isNull())
+		json["params"] = move(_params);
+	send(move(json), _id);
+}
+
 void IOStreamTransport::reply(MessageID _id, Json::Value _message)
 {
 	Json::Value json;
@@ -99,6 +157,15 @@ void IOStreamTransport::error(MessageID _id, ErrorCode _code, string _message)
 }
 
 void IOStreamTransport::send(Json::Value _json, MessageID _id)
+{
+	string const output = encode(move(_json), _id);
+
+	lock_guard lock(m_outputMutex);
+	m_output << output;
+	m_output.flush();
+}
+
+string IOStreamTransport::encode(Json::Value _json, MessageID const& _id)
 {
 	solAssert(_json.isObject());
 	_json["jsonrpc"] = "2.0";
@@ -106,12 +173,7 @@ void IOStreamTransport::send(Json::Value _json, MessageID _id)
 		_json["id"] = _id;
 
 	string const jsonString = solidity::util::jsonCompactPrint(_json);
-
-	m_output << "Content-Length: " << jsonString.size() << "\r\n";
-	m_output << "\r\n";
-	m_output << jsonString;
-
-	m_output.flush();
+	return "Content-Length: " + to_string(jsonString.size()) + "\r\n\r\n" + jsonString;
 }
 
 optional<map<string, string>> IOStreamTransport::parseHeaders()
@@ -139,3 +201,155 @@ optional<map<string, string>> IOStreamTransport::parseHeaders()
 	}
 	return {move(headers)};
 }
+
+struct ThreadedTransport::State
+{
+	State(unique_ptr<Transport> _transport, size_t _capacity):
+		transport(move(_transport)),
+		capacity(_capacity)
+	{}
+
+	unique_ptr<Transport> const transport;
+	size_t const capacity;
+
+	mutex queueMutex;
+	condition_variable queueChanged;
+	/// Received messages by priority, together with their position in the order of arrival.
+	array<deque<pair<uint64_t, Json::Value>>, 3> queues;
+	size_t size = 0;
+	uint64_t received = 0;
+	/// Positions of the received lifecycle messages that were not handled yet, in the order of arrival.
+	deque<uint64_t> lifecycleMessages;
+	/// Set by the reader thread once the underlying transport is closed.
+	bool finished = false;
+	/// Set on destruction of the ThreadedTransport.
+	bool stopped = false;
+};
+
+ThreadedTransport::ThreadedTransport(unique_ptr<Transport> _transport, size_t _capacity):
+	m_state(make_shared<State>(move(_transport), _capacity))
+{
+	solAssert(m_state->transport);
+	solAssert(_capacity > 0);
+	m_reader = thread(&ThreadedTransport::read, m_state);
+}
+
+ThreadedTransport::~ThreadedTransport()
+{
+	bool finished = false;
+	{
+		lock_guard lock(m_state->queueMutex);
+		m_state->stopped = true;
+		finished = m_state->finished;
+	}
+	m_state->queueChanged.notify_all();
+	// The reader thread cannot be interrupted while it is waiting for input.
+	if (finished)
+		m_reader.join();
+	else
+		m_reader.detach();
+}
+
+bool ThreadedTransport::closed() const noexcept
+{
+	lock_guard lock(m_state->queueMutex);
+	return m_state->finished && m_state->size == 0;
+}
+
+optional<Json::Value> ThreadedTransport::receive()
+{
+	unique_lock lock(m_state->queueMutex);
+	m_state->queueChanged.wait(lock, [&] { return m_state->size > 0 || m_state->finished; });
+	if (m_state->size == 0)
+		return nullopt;
+
+	// Messages are only reordered between two lifecycle messages. A lifecycle message itself
+	// is handled once all messages that arrived before it were handled, at which point it is
+	// the first message of its queue.
+	uint64_t const nextLifecycleMessage = m_state->lifecycleMessages.empty() ?
+		numeric_limits<uint64_t>::max() :
+		m_state->lifecycleMessages.front();
+	deque<pair<uint64_t, Json::Value>>* next = nullptr;
+	for (deque<pair<uint64_t, Json::Value>>& queue: m_state->queues)
+		if (!queue.empty() && queue.front().first < nextLifecycleMessage)
+		{
+			next = &queue;
+			break;
+		}
+	if (!next)
+	{
+		next = &m_state->queues[1];
+		solAssert(!next->empty() && next->front().first == nextLifecycleMessage);
+		m_state->lifecycleMessages.pop_front();
+	}
+
+	Json::Value message = move(next->front().second);
+	next->pop_front();
+	--m_state->size;
+	lock.unlock();
+	m_state->queueChanged.notify_all();
+	return {move(message)};
+}
+
+void ThreadedTransport::notify(string _method, Json::Value _params)
+{
+	m_state->transport->notify(move(_method), move(_params));
+}
+
+void ThreadedTransport::notifyAll(string _method, vector<Json::Value> _params)
+{
+	m_state->transport->notifyAll(move(_method), move(_params));
+}
+
+void ThreadedTransport::request(MessageID _id, string _method, Json::Value _params)
+{
+	m_state->transport->request(move(_id), move(_method), move(_params));
+}
+
+void ThreadedTransport::reply(MessageID _id, Json::Value _result)
+{
+	m_state->transport->reply(move(_id), move(_result));
+}
+
+void ThreadedTransport::error(MessageID _id, ErrorCode _code, string _message)
+{
+	m_state->transport->error(move(_id), _code, move(_message));
+}
+
+void ThreadedTransport::read(shared_ptr<State> _state)
+{
+	Transport& transport = *_state->transport;
+	while (!transport.closed())
+	{
+		optional<Json::Value> message;
+		try
+		{
+			message = transport.receive();
+		}
+		catch (...)
+		{
+			transport.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+
+		unique_lock lock(_state->queueMutex);
+		_state->queueChanged.wait(lock, [&] { return _state->size < _state->capacity || _state->stopped; });
+		if (_state->stopped)
+			return;
+		if (message)
+		{
+			uint64_t const position = _state->received++;
+			if (isLifecycleMessage(*message))
+				_state->lifecycleMessages.push_back(position);
+			_state->queues[priority(*message)].emplace_back(position, move(*message));
+			++_state->size;
+			lock.unlock();
+			_state->queueChanged.notify_all();
+		}
+	}
+
+	{
+		lock_guard lock(_state->queueMutex);
+		_state->finished = true;
+	}
+	_state->queueChanged.notify_all();
+}
@@ -24,10 +24,14 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <variant>
+#include <vector>
 
 namespace solidity::lsp
 {
@@ -87,6 +91,16 @@ public:
 	virtual bool closed() const noexcept = 0;
 	virtual std::optional<Json::Value> receive() = 0;
 	virtual void notify(std::string _method, Json::Value _params) = 0;
+	/// Sends one notification per element of @a _params. Transports can override this
+	/// to send all of them at once.
+	virtual void notifyAll(std::string _method, std::vector<Json::Value> _params)
+	{
+		for (Json::Value& params: _params)
+			notify(_method, std::move(params));
+	}
+	/// Sends a request to the client, without parameters if @a _params is null.
+	/// Its response is received like any other message.
+	virtual void request(MessageID _id, std::string _method, Json::Value _params) = 0;
 	virtual void reply(MessageID _id, Json::Value _result) = 0;
 	virtual void error(MessageID _id, ErrorCode _code, std::string _message) = 0;
 };
@@ -109,11 +123,15 @@ public:
 	bool closed() const noexcept override;
 	std::optional<Json::Value> receive() override;
 	void notify(std::string _method, Json::Value _params) override;
+	/// Writes all notifications with a single write to and flush of the output stream.
+	void notifyAll(std::string _method, std::vector<Json::Value> _params) override;
+	void request(MessageID _id, std::string _method, Json::Value _params) override;
 	void reply(MessageID _id, Json::Value _result) override;
 	void error(MessageID _id, ErrorCode _code, std::string _message) override;
 
 protected:
 	/// Sends an arbitrary raw message to the client.
+	/// Messages sent from different threads are not interleaved.
 	///
 	/// Used by the notify/reply/error function family.
 	virtual void send(Json::Value _message, MessageID _id = Json::nullValue);
@@ -122,8 +140,50 @@ protected:
 	std::optional<std::map<std::string, std::string>> parseHeaders();
 
 private:
+	/// @returns the message including its header, as it is written to the output stream.
+	static std::string encode(Json::Value _message, MessageID const& _id);
+
 	std::istream& m_input;
 	std::ostream& m_output;
+	std::mutex m_outputMutex;
+};
+
+/**
+ * Transport that receives the messages of another transport on a separate thread.
+ *
+ * Messages are read ahead while the server is busy, up to a fixed number of messages.
+ * Cancellations are handled first and notifications (e.g. changes to documents) are handled
+ * before the remaining requests, which are queries that only depend on the last compilation.
+ * Messages of the same priority are handled in the order in which they were received,
+ * and no message is moved across a shutdown request or an exit notification.
+ * Sending is forwarded to the underlying transport, which has to support being called
+ * from multiple threads.
+ */
+class ThreadedTransport: public Transport
+{
+public:
+	/// @param _capacity the maximum number of messages that are read ahead
+	explicit ThreadedTransport(std::unique_ptr<Transport> _transport, size_t _capacity = 1024);
+	/// Stops reading. If the reader thread is still waiting for input, it is detached
+	/// and ends after receiving the next message.
+	~ThreadedTransport() override;
+
+	bool closed() const noexcept override;
+	std::optional<Json::Value> receive() override;
+	void notify(std::string _method, Json::Value _params) override;
+	void notifyAll(std::string _method, std::vector<Json::Value> _params) override;
+	void request(MessageID _id, std::string _method, Json::Value _params) override;
+	void reply(MessageID _id, Json::Value _result) override;
+	void error(MessageID _id, ErrorCode _code, std::string _message) override;
+
+private:
+	/// State shared with the reader thread, which can outlive this object.
+	struct State;
+
+	static void read(std::shared_ptr<State> _state);
+
+	std::shared_ptr<State> m_state;
+	std::thread m_reader;
 };
 
 }
@@ -89,10 +89,10 @@ multimap<string, DocTag> DocStringParser::parse()
 
 	while (currPos != end)
 	{
-		iter tagPos = find(currPos, end, '@');
 		iter nlPos = find(currPos, end, '\n');
+		iter tagPos = find(currPos, nlPos, '@');
 
-		if (tagPos != end && tagPos < nlPos)
+		if (tagPos != nlPos)
 		{
 			// we found a tag
 			iter tagNameEndPos = firstWhitespaceOrNewline(tagPos, end);
@@ -72,7 +72,12 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.registerNode(allocate_shared<NodeType>(
+			util::ArenaAllocator<NodeType>(m_parser.m_nodeArena),
+			m_parser.nextID(),
+			m_location,
+			std::forward<Args>(_args)...
+		));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -82,6 +87,15 @@ private:
 	SourceLocation m_location;
 };
 
+vector<ASTNode*> Parser::trackedNodes() const
+{
+	vector<ASTNode*> nodes;
+	for (weak_ptr<ASTNode> const& node: m_trackedNodes)
+		if (ASTPointer<ASTNode> lockedNode = node.lock())
+			nodes.push_back(lockedNode.get());
+	return nodes;
+}
+
 ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 {
 	solAssert(!m_insideModifier, "");
@@ -89,6 +103,7 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	{
 		m_recursionDepth = 0;
 		m_scanner = make_shared<Scanner>(_charStream);
+		m_nodeArena = make_shared<util::Arena>();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -1327,7 +1342,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	return registerNode(make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
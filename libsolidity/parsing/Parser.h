@@ -26,6 +26,7 @@
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Arena.h>
 
 namespace solidity::langutil
 {
@@ -49,6 +50,15 @@ public:
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// Makes the parser remember all AST nodes it creates, so that they can be retrieved
+	/// using trackedNodes().
+	void trackNodes() { m_trackNodes = true; }
+	/// @returns all AST nodes created by this parser since trackNodes() was called
+	/// which are still in use.
+	std::vector<ASTNode*> trackedNodes() const;
+	/// @returns the number of AST node IDs used so far.
+	int64_t nodeIDCount() const { return m_currentNodeID; }
+
 private:
 	class ASTNodeFactory;
 
@@ -188,6 +198,14 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Remembers @a _node if node tracking is enabled.
+	template <class NodeType>
+	ASTPointer<NodeType> registerNode(ASTPointer<NodeType> _node)
+	{
+		if (m_trackNodes)
+			m_trackedNodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -217,6 +235,12 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_trackNodes = false;
+	std::vector<std::weak_ptr<ASTNode>> m_trackedNodes;
+	/// Memory for the nodes of the current source unit, which is released once all of them are destroyed.
+	/// Holding on to any node of a source unit, even after the source unit itself is released,
+	/// keeps the memory of all of its nodes alive.
+	std::shared_ptr<util::Arena> m_nodeArena;
 };
 
 }
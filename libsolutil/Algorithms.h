@@ -18,9 +18,13 @@
 #pragma once
 
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <list>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace solidity::util
 {
@@ -125,4 +129,73 @@ struct BreadthFirstSearch
 	std::set<V> visited{};
 };
 
+/**
+ * Computes the strongly connected components of a directed graph using an iterative
+ * version of Tarjan's algorithm, which runs in time linear in the size of the graph.
+ *
+ * The vertices are the integers from zero to ``_successors.size() - 1`` and ``_successors[v]``
+ * lists the successors of the vertex ``v``.
+ *
+ * @returns the components in reverse topological order, i.e. each component comes after all
+ * components that are reachable from it.
+ */
+inline std::vector<std::vector<size_t>> stronglyConnectedComponents(
+	std::vector<std::vector<size_t>> const& _successors
+)
+{
+	size_t constexpr unvisited = std::numeric_limits<size_t>::max();
+	std::vector<size_t> index(_successors.size(), unvisited);
+	std::vector<size_t> lowLink(_successors.size(), 0);
+	std::vector<bool> onStack(_successors.size(), false);
+	std::vector<size_t> stack;
+	/// Vertices whose successors are being visited, together with the position of the next successor.
+	std::vector<std::pair<size_t, size_t>> pending;
+	std::vector<std::vector<size_t>> components;
+	size_t nextIndex = 0;
+
+	auto enter = [&](size_t _vertex) {
+		index[_vertex] = lowLink[_vertex] = nextIndex++;
+		stack.emplace_back(_vertex);
+		onStack[_vertex] = true;
+		pending.emplace_back(_vertex, 0);
+	};
+
+	for (size_t root = 0; root < _successors.size(); ++root)
+	{
+		if (index[root] != unvisited)
+			continue;
+		enter(root);
+		while (!pending.empty())
+		{
+			size_t vertex = pending.back().first;
+			if (pending.back().second < _successors[vertex].size())
+			{
+				size_t successor = _successors[vertex][pending.back().second++];
+				if (index[successor] == unvisited)
+					enter(successor);
+				else if (onStack[successor])
+					lowLink[vertex] = std::min(lowLink[vertex], index[successor]);
+				continue;
+			}
+
+			pending.pop_back();
+			if (!pending.empty())
+				lowLink[pending.back().first] = std::min(lowLink[pending.back().first], lowLink[vertex]);
+			if (lowLink[vertex] == index[vertex])
+			{
+				std::vector<size_t>& component = components.emplace_back();
+				size_t member = unvisited;
+				while (member != vertex)
+				{
+					member = stack.back();
+					stack.pop_back();
+					onStack[member] = false;
+					component.emplace_back(member);
+				}
+			}
+		}
+	}
+	return components;
+}
+
 }
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <cstdint>
+
+using namespace std;
+using namespace solidity::util;
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+	assertThrow(
+		_alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && (_alignment & (_alignment - 1)) == 0,
+		Exception,
+		"Unsupported alignment."
+	);
+
+	// Large requests get a block of their own, so that the rest of the current block is not wasted.
+	if (_size > c_blockSize / 4)
+		return m_blocks.emplace_back(new byte[_size]).get();
+
+	size_t padding = (_alignment - reinterpret_cast<uintptr_t>(m_next) % _alignment) % _alignment;
+	if (padding + _size > m_remaining)
+	{
+		m_next = m_blocks.emplace_back(new byte[c_blockSize]).get();
+		m_remaining = c_blockSize;
+		padding = 0;
+	}
+
+	void* result = m_next + padding;
+	m_next += padding + _size;
+	m_remaining -= padding + _size;
+	return result;
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory arena for objects that are allocated together and released together.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Hands out memory from large blocks. Memory is never returned to the arena individually,
+/// all of it is freed at once when the arena is destroyed.
+/// Not synchronized, so an arena may only be allocated from by one thread at a time.
+class Arena
+{
+public:
+	Arena() = default;
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns uninitialized memory of @a _size bytes with the given alignment, which may not be
+	/// larger than the alignment guaranteed by operator new.
+	void* allocate(size_t _size, size_t _alignment);
+
+private:
+	static size_t constexpr c_blockSize = 0x10000;
+
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	std::byte* m_next = nullptr;
+	size_t m_remaining = 0;
+};
+
+/// Allocator that takes memory from a shared arena, for use with std::allocate_shared.
+/// Every copy of the allocator (the ones stored alongside the shared objects included) keeps
+/// the arena alive, so its memory is released as soon as the last object allocated from it
+/// is destroyed and never before.
+/// In particular, a single object that outlives the others keeps all blocks of the arena
+/// allocated, and the memory of destroyed objects is not reused in the meantime.
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <typename U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.m_arena) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	template <typename U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.m_arena; }
+	template <typename U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.m_arena; }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+
+	template <typename U>
+	friend class ArenaAllocator;
+};
+
+}
@@ -28,6 +28,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -38,6 +40,40 @@ namespace
 static char const* upperHexChars = "0123456789ABCDEF";
 static char const* lowerHexChars = "0123456789abcdef";
 
+/// The two hex characters of every byte value, so that bytes are converted with a single lookup.
+struct HexPairs
+{
+	constexpr explicit HexPairs(char const* _chars): pairs{}
+	{
+		for (size_t i = 0; i < 256; ++i)
+		{
+			pairs[i][0] = _chars[i >> 4];
+			pairs[i][1] = _chars[i & 0xf];
+		}
+	}
+	char pairs[256][2];
+};
+
+constexpr HexPairs upperHexPairs("0123456789ABCDEF");
+constexpr HexPairs lowerHexPairs("0123456789abcdef");
+
+/// The value of every hex character and -1 for all other characters.
+struct HexValues
+{
+	constexpr HexValues(): values{}
+	{
+		for (size_t i = 0; i < 256; ++i)
+			values[i] = -1;
+		for (int i = 0; i < 10; ++i)
+			values['0' + i] = static_cast<int8_t>(i);
+		for (int i = 0; i < 6; ++i)
+			values['a' + i] = values['A' + i] = static_cast<int8_t>(10 + i);
+	}
+	int8_t values[256];
+};
+
+constexpr HexValues hexValues;
+
 }
 
 string solidity::util::toHex(uint8_t _data, HexCase _case)
@@ -63,17 +99,25 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 		ret[i++] = 'x';
 	}
 
-	// Mixed case will be handled inside the loop.
-	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
-	size_t rix = _data.size() - 1;
-	for (uint8_t c: _data)
+	if (_case == HexCase::Mixed)
 	{
-		// switch hex case every four hexchars
-		if (_case == HexCase::Mixed)
-			chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
-
-		ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
-		ret[i++] = chars[c & 0xfu];
+		size_t rix = _data.size() - 1;
+		for (uint8_t c: _data)
+		{
+			// switch hex case every four hexchars
+			char const* chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
+			ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
+			ret[i++] = chars[c & 0xfu];
+		}
+	}
+	else
+	{
+		auto const& pairs = (_case == HexCase::Upper ? upperHexPairs : lowerHexPairs).pairs;
+		for (uint8_t c: _data)
+		{
+			memcpy(&ret[i], pairs[c], 2);
+			i += 2;
+		}
 	}
 	assertThrow(i == ret.size(), Exception, "");
 
@@ -100,25 +144,33 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 		return {};
 
 	unsigned s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
-	std::vector<uint8_t> ret;
-	ret.reserve((_s.size() - s + 1) / 2);
+	std::vector<uint8_t> ret((_s.size() - s + 1) / 2);
+	auto value = [](char _c) { return hexValues.values[static_cast<uint8_t>(_c)]; };
 
+	size_t o = 0;
 	if (_s.size() % 2)
 	{
-		int h = fromHex(_s[s++], _throw);
-		if (h != -1)
-			ret.push_back(static_cast<uint8_t>(h));
-		else
+		int h = value(_s[s]);
+		if (h == -1)
+		{
+			fromHex(_s[s], _throw);
 			return bytes();
+		}
+		ret[o++] = static_cast<uint8_t>(h);
+		s++;
 	}
-	for (unsigned i = s; i < _s.size(); i += 2)
+	for (size_t i = s; i < _s.size(); i += 2)
 	{
-		int h = fromHex(_s[i], _throw);
-		int l = fromHex(_s[i + 1], _throw);
-		if (h != -1 && l != -1)
-			ret.push_back(static_cast<uint8_t>(h * 16 + l));
-		else
+		int h = value(_s[i]);
+		int l = value(_s[i + 1]);
+		if (h == -1 || l == -1)
+		{
+			// Throws for the first invalid character if requested.
+			fromHex(_s[i], _throw);
+			fromHex(_s[i + 1], _throw);
 			return bytes();
+		}
+		ret[o++] = static_cast<uint8_t>(h * 16 + l);
 	}
 	return ret;
 }
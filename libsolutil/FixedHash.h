@@ -178,4 +178,14 @@ inline std::ostream& operator<<(std::ostream& _out, FixedHash<N> const& _h)
 using h256 = FixedHash<32>;
 using h160 = FixedHash<20>;
 
+/// @returns the big-endian representation of @a _value with as few bytes as possible, but at
+/// least @a _min, as a reference into @a _buffer. Same as toCompactBigEndian, but without
+/// allocating memory.
+inline bytesConstRef compactBigEndian(u256 const& _value, h256& _buffer, unsigned _min = 0)
+{
+	_buffer = h256(_value);
+	size_t size = std::min<size_t>(32, std::max(_min, numberEncodingSize(_value)));
+	return bytesConstRef(_buffer.data() + 32 - size, size);
+}
+
 }
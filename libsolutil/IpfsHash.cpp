@@ -153,7 +153,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +163,50 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
+		size_t const chunkStart = chunkIndex * maxChunkSize;
+		size_t const chunkSize = min(maxChunkSize, _data.length() - chunkStart);
+		bytes lengthAsVarint = varintEncoding(chunkSize);
 
-		bytes protobufEncodedData;
+		// The protobuf encoded data is the chunk surrounded by a header and a trailer.
+		bytes header;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
+		header += bytes{0x08, 0x02};
+		if (chunkSize > 0)
 		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			header += bytes{0x12};
+			header += lengthAsVarint;
 		}
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes trailer = bytes{0x18} + lengthAsVarint;
+		size_t const protobufSize = header.size() + chunkSize + trailer.size();
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		bytes blockHeader = bytes{0x0a} + varintEncoding(protobufSize) + header;
 
 		// Multihash: sha2-256, 256 bits
+		// The block is hashed in pieces, so that the chunk is not copied into it.
+		picosha2::hash256_one_by_one hasher;
+		hasher.process(blockHeader.begin(), blockHeader.end());
+		hasher.process(_data.begin() + static_cast<ptrdiff_t>(chunkStart), _data.begin() + static_cast<ptrdiff_t>(chunkStart + chunkSize));
+		hasher.process(trailer.begin(), trailer.end());
+		hasher.finish();
+		bytes hash{0x12, 0x20};
+		hash.resize(2 + picosha2::k_digest_size);
+		hasher.get_hash_bytes(hash.begin() + 2, hash.end());
+
 		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
+			std::move(hash),
+			chunkSize,
+			blockHeader.size() + chunkSize + trailer.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
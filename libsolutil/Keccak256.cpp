@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <map>
 
 using namespace std;
 
@@ -108,6 +109,113 @@ static inline void keccakf(void* state) {
 	}
 }
 
+/// The lanes of @a N independent states, on which all operations are performed element-wise.
+/// Compilers turn the loops over the elements into vector instructions where available.
+template<size_t N>
+struct Lanes
+{
+	uint64_t words[N];
+};
+
+template<size_t N>
+inline Lanes<N> operator^(Lanes<N> _a, Lanes<N> const& _b)
+{
+	for (size_t k = 0; k < N; k++)
+		_a.words[k] ^= _b.words[k];
+	return _a;
+}
+
+template<size_t N>
+inline Lanes<N> operator&(Lanes<N> _a, Lanes<N> const& _b)
+{
+	for (size_t k = 0; k < N; k++)
+		_a.words[k] &= _b.words[k];
+	return _a;
+}
+
+template<size_t N>
+inline Lanes<N> operator~(Lanes<N> _a)
+{
+	for (size_t k = 0; k < N; k++)
+		_a.words[k] = ~_a.words[k];
+	return _a;
+}
+
+template<size_t N>
+inline Lanes<N> operator^(Lanes<N> _a, uint64_t _b)
+{
+	for (size_t k = 0; k < N; k++)
+		_a.words[k] ^= _b;
+	return _a;
+}
+
+template<size_t N>
+inline Lanes<N> rotateLeft(Lanes<N> _a, unsigned _s)
+{
+	for (size_t k = 0; k < N; k++)
+		_a.words[k] = (_a.words[k] << _s) | (_a.words[k] >> (64 - _s));
+	return _a;
+}
+
+/// Keccak-f[1600] on the lanes of several states, with rho and pi unrolled, so that all
+/// rotations are by constants.
+template<size_t N>
+inline void keccakfLanes(Lanes<N> (&_a)[25])
+{
+	for (size_t round = 0; round < 24; round++)
+	{
+		// Theta
+		Lanes<N> c[5];
+		for (size_t x = 0; x < 5; x++)
+			c[x] = _a[x] ^ _a[x + 5] ^ _a[x + 10] ^ _a[x + 15] ^ _a[x + 20];
+		Lanes<N> d[5] = {
+			c[4] ^ rotateLeft(c[1], 1),
+			c[0] ^ rotateLeft(c[2], 1),
+			c[1] ^ rotateLeft(c[3], 1),
+			c[2] ^ rotateLeft(c[4], 1),
+			c[3] ^ rotateLeft(c[0], 1)
+		};
+		// Rho and pi
+		Lanes<N> b[25];
+		b[0] = _a[0] ^ d[0];
+		b[1] = rotateLeft(_a[6] ^ d[1], 44);
+		b[2] = rotateLeft(_a[12] ^ d[2], 43);
+		b[3] = rotateLeft(_a[18] ^ d[3], 21);
+		b[4] = rotateLeft(_a[24] ^ d[4], 14);
+		b[5] = rotateLeft(_a[3] ^ d[3], 28);
+		b[6] = rotateLeft(_a[9] ^ d[4], 20);
+		b[7] = rotateLeft(_a[10] ^ d[0], 3);
+		b[8] = rotateLeft(_a[16] ^ d[1], 45);
+		b[9] = rotateLeft(_a[22] ^ d[2], 61);
+		b[10] = rotateLeft(_a[1] ^ d[1], 1);
+		b[11] = rotateLeft(_a[7] ^ d[2], 6);
+		b[12] = rotateLeft(_a[13] ^ d[3], 25);
+		b[13] = rotateLeft(_a[19] ^ d[4], 8);
+		b[14] = rotateLeft(_a[20] ^ d[0], 18);
+		b[15] = rotateLeft(_a[4] ^ d[4], 27);
+		b[16] = rotateLeft(_a[5] ^ d[0], 36);
+		b[17] = rotateLeft(_a[11] ^ d[1], 10);
+		b[18] = rotateLeft(_a[17] ^ d[2], 15);
+		b[19] = rotateLeft(_a[23] ^ d[3], 56);
+		b[20] = rotateLeft(_a[2] ^ d[2], 62);
+		b[21] = rotateLeft(_a[8] ^ d[3], 55);
+		b[22] = rotateLeft(_a[14] ^ d[4], 39);
+		b[23] = rotateLeft(_a[15] ^ d[0], 41);
+		b[24] = rotateLeft(_a[21] ^ d[1], 2);
+		// Chi
+		for (size_t y = 0; y < 25; y += 5)
+		{
+			_a[y] = b[y] ^ (~b[y + 1] & b[y + 2]);
+			_a[y + 1] = b[y + 1] ^ (~b[y + 2] & b[y + 3]);
+			_a[y + 2] = b[y + 2] ^ (~b[y + 3] & b[y + 4]);
+			_a[y + 3] = b[y + 3] ^ (~b[y + 4] & b[y]);
+			_a[y + 4] = b[y + 4] ^ (~b[y] & b[y + 1]);
+		}
+		// Iota
+		_a[0] = _a[0] ^ RC[round];
+	}
+}
+
 /******** The FIPS202-defined functions. ********/
 
 /*** Some helper macros. ***/
@@ -169,6 +277,44 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+/// Computes the Keccak-256 hashes of the @a N inputs @a _inputs, which all consist of
+/// @a _blocks full blocks followed by a partial block, into @a _outputs.
+/// Produces the same results as @a hash, which also treats the state as native 64-bit words.
+template<size_t N>
+void keccak256Interleaved(bytesConstRef const* const (&_inputs)[N], size_t _blocks, h256* const (&_outputs)[N])
+{
+	size_t const rate = 200 - (256 / 4);
+	Lanes<N> a[25] = {};
+	for (size_t block = 0; block <= _blocks; block++)
+	{
+		for (size_t k = 0; k < N; k++)
+		{
+			uint8_t padded[rate] = {0};
+			uint8_t const* data = padded;
+			if (block < _blocks)
+				data = _inputs[k]->data() + block * rate;
+			else
+			{
+				size_t remaining = _inputs[k]->size() - block * rate;
+				if (remaining)
+					memcpy(padded, _inputs[k]->data() + block * rate, remaining);
+				padded[remaining] ^= 0x01;
+				padded[rate - 1] ^= 0x80;
+			}
+			for (size_t lane = 0; lane < rate / 8; lane++)
+			{
+				uint64_t word;
+				memcpy(&word, data + 8 * lane, 8);
+				a[lane].words[k] ^= word;
+			}
+		}
+		keccakfLanes(a);
+	}
+	for (size_t k = 0; k < N; k++)
+		for (size_t lane = 0; lane < 4; lane++)
+			memcpy(_outputs[k]->data() + 8 * lane, &a[lane].words[k], 8);
+}
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -182,4 +328,33 @@ h256 keccak256(bytesConstRef _input)
 	return output;
 }
 
+vector<h256> keccak256(vector<bytesConstRef> const& _inputs)
+{
+	size_t const rate = 200 - (256 / 4);
+	size_t const width = 4;
+	vector<h256> outputs(_inputs.size());
+	// Only inputs with the same number of blocks can share the permutations.
+	map<size_t, vector<size_t>> inputsByBlocks;
+	for (size_t i = 0; i < _inputs.size(); i++)
+		inputsByBlocks[_inputs[i].size() / rate].push_back(i);
+	for (auto const& [blocks, indices]: inputsByBlocks)
+	{
+		size_t i = 0;
+		for (; i + width <= indices.size(); i += width)
+		{
+			bytesConstRef const* inputs[width];
+			h256* outputPointers[width];
+			for (size_t k = 0; k < width; k++)
+			{
+				inputs[k] = &_inputs[indices[i + k]];
+				outputPointers[k] = &outputs[indices[i + k]];
+			}
+			keccak256Interleaved<width>(inputs, blocks, outputPointers);
+		}
+		for (; i < indices.size(); i++)
+			outputs[indices[i]] = keccak256(_inputs[indices[i]]);
+	}
+	return outputs;
+}
+
 }
@@ -40,13 +40,16 @@ namespace solidity
 using bigint = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<>>;
 using u256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 using s256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>>;
+/// Fixed-width type for intermediate results of operations on u256 that do not fit into 256 bits,
+/// like the products of MULMOD. Unlike bigint, it does not allocate memory.
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 
 /// Interprets @a _u as a two's complement signed number and returns the resulting s256.
 inline s256 u2s(u256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
+	// The magnitude of a negative number is its two's complement, computed in fixed width.
 	if (boost::multiprecision::bit_test(_u, 255))
-		return s256(-(c_end - _u));
+		return -s256(~_u + 1);
 	else
 		return s256(_u);
 }
@@ -54,11 +57,10 @@ inline s256 u2s(u256 _u)
 /// @returns the two's complement signed representation of the signed number _u.
 inline u256 s2u(s256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
 	if (_u >= 0)
 		return u256(_u);
 	else
-		return u256(c_end + _u);
+		return ~u256(-_u) + 1;
 }
 
 inline u256 exp256(u256 _base, u256 _exponent)
@@ -0,0 +1,127 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+thread_local bool isInsideJob = false;
+
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_workAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool(max<size_t>(thread::hardware_concurrency(), 1) - 1);
+	return pool;
+}
+
+bool ThreadPool::insideJob()
+{
+	return isInsideJob;
+}
+
+void ThreadPool::forEach(size_t _count, size_t _maxThreads, function<void(size_t)> const& _job)
+{
+	size_t const maxHelpers = min({_maxThreads, _count, m_maxWorkers + 1}) - 1;
+	if (_maxThreads <= 1 || _count <= 1 || maxHelpers == 0 || isInsideJob)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_job(i);
+		return;
+	}
+
+	Run run(_job, _count, maxHelpers);
+	{
+		lock_guard lock(m_mutex);
+		while (m_workers.size() < maxHelpers)
+			m_workers.emplace_back([this]() { work(); });
+		m_runs.push_back(&run);
+	}
+	m_workAvailable.notify_all();
+
+	runJobs(run);
+
+	{
+		unique_lock lock(m_mutex);
+		// All jobs are taken, so no further workers must join the run.
+		m_runs.erase(find(m_runs.begin(), m_runs.end(), &run));
+		run.finished.wait(lock, [&]() { return run.helpers == 0; });
+	}
+
+	for (exception_ptr const& exception: run.exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+void ThreadPool::runJobs(Run& _run)
+{
+	bool const wasInsideJob = isInsideJob;
+	isInsideJob = true;
+	for (size_t i = _run.next++; i < _run.count; i = _run.next++)
+		try
+		{
+			_run.job(i);
+		}
+		catch (...)
+		{
+			_run.exceptions[i] = current_exception();
+		}
+	isInsideJob = wasInsideJob;
+}
+
+ThreadPool::Run* ThreadPool::runNeedingHelp() const
+{
+	for (Run* run: m_runs)
+		if (run->helpers < run->maxHelpers && run->next < run->count)
+			return run;
+	return nullptr;
+}
+
+void ThreadPool::work()
+{
+	unique_lock lock(m_mutex);
+	while (true)
+	{
+		Run* run = nullptr;
+		m_workAvailable.wait(lock, [&]() { return m_stopping || (run = runNeedingHelp()); });
+		if (m_stopping)
+			return;
+
+		++run->helpers;
+		lock.unlock();
+		runJobs(*run);
+		lock.lock();
+		if (--run->helpers == 0)
+			run->finished.notify_all();
+	}
+}
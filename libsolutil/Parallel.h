@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent jobs on a fixed number of worker threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Calls @a _job(i) for every i in [0, _count), using at most @a _maxThreads threads
+/// (the calling thread included). Jobs are handed out in increasing order of their index.
+/// If one or more jobs throw, all remaining jobs are still run and the exception of the job
+/// with the lowest index is rethrown, so that the observable behaviour does not depend on
+/// scheduling. With @a _maxThreads <= 1 no threads are created and the jobs are run in order
+/// on the calling thread.
+template <typename Job>
+void parallelForEach(size_t _count, size_t _maxThreads, Job&& _job)
+{
+	if (_maxThreads <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_job(i);
+		return;
+	}
+
+	std::vector<std::exception_ptr> exceptions(_count);
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		for (size_t i = next++; i < _count; i = next++)
+			try
+			{
+				_job(i);
+			}
+			catch (...)
+			{
+				exceptions[i] = std::current_exception();
+			}
+	};
+
+	std::vector<std::thread> threads;
+	size_t threadCount = std::min(_maxThreads, _count);
+	for (size_t i = 1; i < threadCount; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (std::exception_ptr const& exception: exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
+
+/// A fixed set of worker threads that are reused for many short parallel runs, e.g. for
+/// every optimiser step, where starting threads for each run would cost more than the run.
+/// Runs started concurrently from several threads share the workers, so the number of threads
+/// does not multiply if the callers themselves run in parallel. The calling thread takes part
+/// in its run, so a run makes progress even if all workers are busy.
+/// Jobs run on the workers must not rely on thread-local state left by earlier jobs.
+class ThreadPool
+{
+public:
+	/// Creates a pool that starts at most @a _maxWorkers worker threads on demand.
+	explicit ThreadPool(size_t _maxWorkers): m_maxWorkers(_maxWorkers) {}
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the pool shared by the whole process, with one worker less than the number
+	/// of hardware threads.
+	static ThreadPool& shared();
+
+	/// Same as parallelForEach, but runs the jobs on the workers of the pool and the calling
+	/// thread. If called from a job of a pool, the jobs are run sequentially on the calling
+	/// thread, so that parallel runs are not nested.
+	void forEach(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _job);
+
+	/// @returns true if the calling thread is running a job of a pool.
+	static bool insideJob();
+
+private:
+	struct Run
+	{
+		Run(std::function<void(size_t)> const& _job, size_t _count, size_t _maxHelpers):
+			job(_job), count(_count), maxHelpers(_maxHelpers), exceptions(_count)
+		{}
+
+		std::function<void(size_t)> const& job;
+		size_t count;
+		/// The maximum number of workers that help with this run.
+		size_t maxHelpers;
+		std::atomic<size_t> next{0};
+		/// The number of workers that currently help with this run.
+		size_t helpers = 0;
+		std::vector<std::exception_ptr> exceptions;
+		std::condition_variable finished;
+	};
+
+	/// Runs the jobs of @a _run that are not taken yet.
+	static void runJobs(Run& _run);
+	/// @returns a run that needs help, or nullptr. Requires the mutex to be held.
+	Run* runNeedingHelp() const;
+	void work();
+
+	size_t const m_maxWorkers;
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::deque<Run*> m_runs;
+	std::vector<std::thread> m_workers;
+	bool m_stopping = false;
+};
+
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+using namespace std;
+using namespace solidity::util;
+
+Profiler::Scope::Scope(Profiler* _profiler, string _context):
+	m_previous(currentScope()),
+	m_profiler(_profiler),
+	m_context(move(_context))
+{
+	currentScope() = this;
+}
+
+Profiler::Scope::~Scope()
+{
+	currentScope() = m_previous;
+}
+
+void Profiler::Timer::start(string_view _phase, string_view _subPhase)
+{
+	Scope const* scope = currentScope();
+	if (!scope || !scope->m_profiler)
+		return;
+
+	m_scope = scope;
+	m_phase = string(_phase);
+	if (!_subPhase.empty())
+		m_phase += "/" + string(_subPhase);
+	m_start = chrono::steady_clock::now();
+}
+
+void Profiler::Timer::stop()
+{
+	if (!m_scope)
+		return;
+
+	m_scope->m_profiler->record(m_scope->m_context, m_phase, chrono::steady_clock::now() - m_start);
+	m_scope = nullptr;
+}
+
+void Profiler::record(string const& _context, string const& _phase, chrono::nanoseconds _time, size_t _count)
+{
+	lock_guard lock(m_mutex);
+	Entry& entry = m_entries[_context][_phase];
+	entry.time += _time;
+	entry.count += _count;
+}
+
+void Profiler::count(string_view _event, size_t _times)
+{
+	Scope const* scope = currentScope();
+	if (scope && scope->m_profiler)
+		scope->m_profiler->record(scope->m_context, string(_event), chrono::nanoseconds{0}, _times);
+}
+
+pair<Profiler*, string> Profiler::current()
+{
+	Scope const* scope = currentScope();
+	if (!scope)
+		return {nullptr, {}};
+	return {scope->m_profiler, scope->m_context};
+}
+
+Profiler::Entries Profiler::entries() const
+{
+	lock_guard lock(m_mutex);
+	return m_entries;
+}
+
+Profiler::Scope*& Profiler::currentScope()
+{
+	thread_local Scope* scope = nullptr;
+	return scope;
+}
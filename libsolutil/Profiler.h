@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of the wall-clock time spent in the phases of a compilation.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace solidity::util
+{
+
+/// Accumulates the wall-clock time spent in and the number of executions of named phases,
+/// grouped by context (the contract being compiled or the empty string for phases that do not
+/// belong to a single contract).
+/// Measurements are taken by Timer objects, which report to the profiler and context made
+/// current on their thread by a Scope. Without an active Scope, timers do nothing, so code
+/// can be instrumented unconditionally.
+/// Phases can be nested, in which case the time of the inner phase is also included in the outer one.
+/// Recording is synchronized, so a profiler can be used from multiple threads.
+class Profiler
+{
+public:
+	struct Entry
+	{
+		std::chrono::nanoseconds time{0};
+		size_t count = 0;
+	};
+	/// Entries by context and phase.
+	using Entries = std::map<std::string, std::map<std::string, Entry>>;
+
+	/// Makes the given profiler (which can be null) and context the current ones
+	/// on the current thread for the lifetime of the Scope object.
+	class Scope
+	{
+	public:
+		explicit Scope(Profiler* _profiler, std::string _context = {});
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		Scope* m_previous;
+		Profiler* m_profiler;
+		std::string m_context;
+
+		friend class Profiler;
+	};
+
+	/// Measures the time from its construction to its destruction (or the next call to
+	/// restart()) and records it for @a _phase (followed by a slash and @a _subPhase if given)
+	/// in the current profiler, if there is one.
+	class Timer
+	{
+	public:
+		explicit Timer(std::string_view _phase, std::string_view _subPhase = {}) { start(_phase, _subPhase); }
+		~Timer() { stop(); }
+		Timer(Timer const&) = delete;
+		Timer& operator=(Timer const&) = delete;
+
+		/// Records the current phase and starts measuring @a _phase.
+		void restart(std::string_view _phase, std::string_view _subPhase = {})
+		{
+			stop();
+			start(_phase, _subPhase);
+		}
+
+	private:
+		void start(std::string_view _phase, std::string_view _subPhase);
+		void stop();
+
+		Scope const* m_scope = nullptr;
+		std::string m_phase;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	void record(
+		std::string const& _context,
+		std::string const& _phase,
+		std::chrono::nanoseconds _time,
+		size_t _count = 1
+	);
+
+	/// Records @a _times occurrences of @a _event, which take no time, in the current profiler,
+	/// if there is one.
+	static void count(std::string_view _event, size_t _times = 1);
+
+	/// @returns the profiler (or null) and the context that are current on the current thread,
+	/// so that they can be made current on worker threads by a Scope.
+	static std::pair<Profiler*, std::string> current();
+
+	Entries entries() const;
+
+private:
+	static Scope*& currentScope();
+
+	mutable std::mutex m_mutex;
+	Entries m_entries;
+};
+
+}
+
+/// Records occurrences of an event (see Profiler::count) if the compiler is built with
+/// the CMake option OPTIMIZER_COUNTERS, and does nothing (not even evaluate the arguments)
+/// otherwise. Used for the transformations of the optimizers, which are too frequent to
+/// be counted unconditionally.
+#ifdef SOL_OPTIMIZER_COUNTERS
+#define SOL_OPTIMIZER_COUNT(...) ::solidity::util::Profiler::count(__VA_ARGS__)
+#else
+#define SOL_OPTIMIZER_COUNT(...) do {} while (false)
+#endif
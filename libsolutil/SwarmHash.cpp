@@ -22,6 +22,8 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -63,25 +65,38 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 	return swarmHashSimple(ref, _length);
 }
 
-h256 bmtHash(bytesConstRef _data)
+/// @returns the binary merkle tree hash of the 0x1000 bytes @a _chunk.
+/// The tree is hashed level by level from the 64-byte leaves upwards. All nodes of a level
+/// are hashed at once and the hashes replace the level in @a _chunk.
+h256 bmtHash(bytes& _chunk)
+{
+	vector<bytesConstRef> nodes;
+	for (size_t size = _chunk.size(); size > 32; size /= 2)
+	{
+		nodes.clear();
+		for (size_t i = 0; i < size; i += 64)
+			nodes.emplace_back(_chunk.data() + i, 64);
+		vector<h256> hashes = keccak256(nodes);
+		for (size_t i = 0; i < hashes.size(); ++i)
+			memcpy(_chunk.data() + 32 * i, hashes[i].data(), 32);
+	}
+	return h256(bytesConstRef(_chunk.data(), 32));
+}
+
+/// @returns the hash of a chunk whose binary merkle tree hash is @a _bmtHash and that
+/// represents @a _size bytes of the input.
+h256 spanHash(uint64_t _size, h256 const& _bmtHash)
 {
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	bytes data = toLittleEndian(_size);
+	data += _bmtHash.asBytes();
+	return keccak256(data);
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
 {
-	bytes dataToHash;
-	if (_data.size() < 0x1000)
-		dataToHash = _data.toBytes();
-	else if (_data.size() == 0x1000 && !_forceHigherLevel)
-		dataToHash = _data.toBytes();
+	bytes dataToHash(0x1000, 0);
+	if (_data.size() < 0x1000 || (_data.size() == 0x1000 && !_forceHigherLevel))
+		memcpy(dataToHash.data(), _data.data(), _data.size());
 	else
 	{
 		size_t maxRepresentedSize = 0x1000;
@@ -90,15 +105,14 @@ h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
 		// If remaining size is 0x1000, but maxRepresentedSize is not,
 		// we have to still do one level of the chunk hashes.
 		bool forceHigher = maxRepresentedSize > 0x1000;
-		for (size_t i = 0; i < _data.size(); i += maxRepresentedSize)
+		for (size_t i = 0, child = 0; i < _data.size(); i += maxRepresentedSize, ++child)
 		{
 			size_t size = std::min(maxRepresentedSize, _data.size() - i);
-			dataToHash += chunkHash(_data.cropped(i, size), forceHigher).asBytes();
+			memcpy(dataToHash.data() + 32 * child, chunkHash(_data.cropped(i, size), forceHigher).data(), 32);
 		}
 	}
 
-	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+	return spanHash(_data.size(), bmtHash(dataToHash));
 }
 
 
@@ -110,9 +124,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input);
 }
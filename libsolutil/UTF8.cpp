@@ -24,6 +24,9 @@
 
 #include <libsolutil/UTF8.h>
 
+#include <cstdint>
+#include <cstring>
+
 namespace solidity::util
 {
 namespace
@@ -85,7 +88,16 @@ bool validateUTF8(unsigned char const* _input, size_t _length, size_t& _invalidP
 	{
 		// Check for Unicode Chapter 3 Table 3-6 conformity.
 		if (_input[i] < 0x80)
+		{
+			// Skip the following ASCII characters eight at a time.
+			for (uint64_t word; i + 9 <= _length; i += 8)
+			{
+				memcpy(&word, _input + i + 1, 8);
+				if (word & 0x8080808080808080ULL)
+					break;
+			}
 			continue;
+		}
 
 		size_t count = 0;
 		if (_input[i] >= 0xc0 && _input[i] <= 0xdf)
@@ -26,13 +26,168 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <set>
+#include <string_view>
 
 using namespace std;
 using namespace solidity::util;
 
+/// A tag, list or condition of a template, or the text between them.
+struct Whiskers::Node
+{
+	enum class Kind { Text, Parameter, List, Condition };
+	Kind kind;
+	/// The text, or the name of the parameter, list or condition, including the "+" of conditions
+	/// on values.
+	string value;
+	/// The body of a list or the part of a condition that is used if it is true.
+	vector<Node> body;
+	/// The part of a condition that is used if it is false.
+	vector<Node> elseBody;
+};
+
+struct Whiskers::Template
+{
+	vector<Node> nodes;
+	/// All tags of the form <name>, <?name>, <#name> and </name> in the text, also those that
+	/// are not part of a complete list or condition.
+	set<string, less<>> tags;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos or @a _pos if there is none.
+size_t parameterEnd(string_view _text, size_t _pos)
+{
+	while (_pos < _text.size() && isParameterCharacter(_text[_pos]))
+		++_pos;
+	return _pos;
+}
+
+}
+
+shared_ptr<Whiskers::Template const> Whiskers::parse(string const& _template)
+{
+	// Most templates are string literals in the code generators, so the cache is small, but
+	// it is bounded in case templates are constructed at run time.
+	static size_t const maxCacheSize = 4096;
+	static mutex cacheMutex;
+	static map<string, shared_ptr<Template const>, less<>> cache;
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+
+	auto result = make_shared<Template>();
+	string_view text(_template);
+	for (size_t pos = text.find('<'); pos != string_view::npos; pos = text.find('<', pos + 1))
+	{
+		size_t nameStart = pos + 1;
+		if (nameStart < text.size() && (text[nameStart] == '?' || text[nameStart] == '#' || text[nameStart] == '/'))
+			++nameStart;
+		size_t nameEnd = parameterEnd(text, nameStart);
+		if (nameEnd > nameStart && nameEnd < text.size() && text[nameEnd] == '>')
+			result->tags.emplace(text.substr(pos, nameEnd + 1 - pos));
+	}
+
+	// Matches the elements like the non-greedy regular expressions used before: Lists and conditions
+	// end at the first closing tag with the same name, and conditions can not be nested in conditions
+	// with the same name. Incomplete tags are copied as text.
+	function<vector<Node>(string_view)> parseNodes = [&](string_view _text) {
+		vector<Node> nodes;
+		auto appendText = [&](string_view _part) {
+			if (_part.empty())
+				return;
+			if (nodes.empty() || nodes.back().kind != Node::Kind::Text)
+				nodes.push_back(Node{Node::Kind::Text, {}, {}, {}});
+			nodes.back().value.append(_part);
+		};
+
+		size_t textStart = 0;
+		for (size_t pos = _text.find('<'); pos != string_view::npos; pos = _text.find('<', pos))
+		{
+			size_t nameStart = pos + 1;
+			char kind = nameStart < _text.size() ? _text[nameStart] : '\0';
+			if (kind == '#' || kind == '?')
+				++nameStart;
+			if (kind == '?' && nameStart < _text.size() && _text[nameStart] == '+')
+				++nameStart;
+			size_t nameEnd = parameterEnd(_text, nameStart);
+			if (nameEnd == nameStart || nameEnd == _text.size() || _text[nameEnd] != '>')
+			{
+				++pos;
+				continue;
+			}
+			string_view name = _text.substr(nameStart, nameEnd - nameStart);
+			if (kind == '?')
+				name = _text.substr(pos + 2, nameEnd - pos - 2);
+			size_t bodyStart = nameEnd + 1;
+
+			size_t end = string_view::npos;
+			Node node{Node::Kind::Parameter, string(name), {}, {}};
+			if (kind == '#' || kind == '?')
+			{
+				string closingTag = "</" + string(name) + ">";
+				size_t closing = _text.find(closingTag, bodyStart);
+				if (closing == string_view::npos)
+				{
+					++pos;
+					continue;
+				}
+				end = closing + closingTag.size();
+				if (kind == '#')
+				{
+					node.kind = Node::Kind::List;
+					node.body = parseNodes(_text.substr(bodyStart, closing - bodyStart));
+				}
+				else
+				{
+					node.kind = Node::Kind::Condition;
+					string elseTag = "<!" + string(name) + ">";
+					size_t elsePos = _text.find(elseTag, bodyStart);
+					if (elsePos < closing)
+					{
+						node.body = parseNodes(_text.substr(bodyStart, elsePos - bodyStart));
+						size_t elseStart = elsePos + elseTag.size();
+						node.elseBody = parseNodes(_text.substr(elseStart, closing - elseStart));
+					}
+					else
+						node.body = parseNodes(_text.substr(bodyStart, closing - bodyStart));
+				}
+			}
+			else
+				end = bodyStart;
+
+			appendText(_text.substr(textStart, pos - textStart));
+			nodes.push_back(move(node));
+			pos = textStart = end;
+		}
+		appendText(_text.substr(textStart));
+		return nodes;
+	};
+	result->nodes = parseNodes(text);
+
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() < maxCacheSize)
+		cache.emplace(_template, result);
+	return result;
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(move(_template)),
+	m_parsed(parse(m_template))
 {
 }
 
@@ -71,14 +226,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	render(m_parsed->nodes, nullptr, &m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -109,124 +266,87 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_parsed->tags.count(tag),
 			WhiskersError,
 			"Tag '" + tag + "' not found in template:\n" + m_template
 		);
 	}
 }
 
-namespace
+string const* Whiskers::parameter(string const& _name, StringMap const* _listElement) const
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+	if (_listElement)
+		if (auto it = _listElement->find(_name); it != _listElement->end())
+			return &it->second;
+	if (auto it = m_parameters.find(_name); it != m_parameters.end())
+		return &it->second;
+	return nullptr;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+void Whiskers::render(
+	vector<Node> const& _nodes,
+	StringMap const* _listElement,
+	StringListMap const* _listParameters,
+	string& _output
+) const
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	for (Node const& node: _nodes)
+		switch (node.kind)
 		{
+		case Node::Kind::Text:
+			_output += node.value;
+			break;
+		case Node::Kind::Parameter:
+		{
+			string const* value = parameter(node.value, _listElement);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + node.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				m_template
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Node::Kind::List:
 		{
-			string templ(_match[3]);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && _listParameters->count(node.value),
+				WhiskersError, "List parameter " + node.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (auto const& element: _listParameters->at(node.value))
+			{
+				for (auto const& value: element)
+					assertThrow(!m_parameters.count(value.first), WhiskersError, "Parameter collision");
+				render(node.body, &element, nullptr, _output);
+			}
+			break;
 		}
-		else
+		case Node::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (node.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = node.value.substr(1);
 
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+				if (string const* value = parameter(tag, _listElement))
+					conditionValue = !value->empty();
+				else if (_listParameters && _listParameters->count(tag))
+					conditionValue = !_listParameters->at(tag).empty();
 				else
 					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
 			}
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					m_conditions.count(node.value),
+					WhiskersError, "Condition parameter " + node.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = m_conditions.at(node.value);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			render(conditionValue ? node.body : node.elseBody, _listElement, _listParameters, _output);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
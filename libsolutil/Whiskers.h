@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -90,6 +91,9 @@ public:
 	std::string render() const;
 
 private:
+	struct Node;
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
@@ -101,19 +105,24 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
+	/// Appends the rendered nodes @a _nodes of the template to @a _output. Inside of lists,
+	/// @a _listElement are the parameters of the current element and @a _listParameters is null.
+	void render(
+		std::vector<Node> const& _nodes,
+		StringMap const* _listElement,
+		StringListMap const* _listParameters,
+		std::string& _output
+	) const;
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
+	/// @returns the value of the regular parameter @a _name, or null if it is not set.
+	std::string const* parameter(std::string const& _name, StringMap const* _listElement) const;
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed template for the text @a _template, which is parsed only once
+	/// for all instances with the same text.
+	static std::shared_ptr<Template const> parse(std::string const& _template);
 
 	std::string m_template;
+	std::shared_ptr<Template const> m_parsed;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -48,12 +48,20 @@ struct DebugData
 		astID(std::move(_astID))
 	{}
 
+	/// Creates a new DebugData object. All calls without arguments return the same
+	/// shared object, so that nodes without debug information do not need an allocation each.
 	static std::shared_ptr<DebugData const> create(
 		langutil::SourceLocation _nativeLocation = {},
 		langutil::SourceLocation _originLocation = {},
 		std::optional<int64_t> _astID = {}
 	)
 	{
+		if (
+			_nativeLocation == langutil::SourceLocation{} &&
+			_originLocation == langutil::SourceLocation{} &&
+			!_astID.has_value()
+		)
+			return empty();
 		return std::make_shared<DebugData const>(
 			std::move(_nativeLocation),
 			std::move(_originLocation),
@@ -61,6 +69,22 @@ struct DebugData
 		);
 	}
 
+	static std::shared_ptr<DebugData const> const& empty()
+	{
+		static std::shared_ptr<DebugData const> const emptyDebugData =
+			std::make_shared<DebugData const>(langutil::SourceLocation{});
+		return emptyDebugData;
+	}
+
+	bool operator==(DebugData const& _other) const
+	{
+		return
+			nativeLocation == _other.nativeLocation &&
+			originLocation == _other.originLocation &&
+			astID == _other.astID;
+	}
+	bool operator!=(DebugData const& _other) const { return !operator==(_other); }
+
 	/// Location in the Yul code.
 	langutil::SourceLocation nativeLocation;
 	/// Location in the original source that the Yul code was produced from.
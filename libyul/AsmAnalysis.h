@@ -113,7 +113,7 @@ private:
 	void expectType(YulString _expectedType, YulString _givenType, langutil::SourceLocation const& _location);
 
 	bool validateInstructions(evmasm::Instruction _instr, langutil::SourceLocation const& _location);
-	bool validateInstructions(std::string const& _instrIdentifier, langutil::SourceLocation const& _location);
+	bool validateInstructions(YulString _instrIdentifier, langutil::SourceLocation const& _location);
 	bool validateInstructions(FunctionCall const& _functionCall);
 
 	yul::ExternalIdentifierAccess::Resolver m_resolver;
@@ -125,6 +125,8 @@ private:
 	langutil::ErrorReporter& m_errorReporter;
 	langutil::EVMVersion m_evmVersion;
 	Dialect const& m_dialect;
+	/// Dialect of the default EVM version, which provides all instructions, looked up on first use.
+	EVMDialect const* m_instructionDialect = nullptr;
 	/// Names of data objects to be referenced by builtin functions with literal arguments.
 	std::set<YulString> m_dataNames;
 	ForLoop const* m_currentForLoop = nullptr;
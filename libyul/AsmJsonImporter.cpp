@@ -29,9 +29,7 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
 
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string.hpp>
-
+#include <string_view>
 #include <vector>
 
 using namespace std;
@@ -42,11 +40,26 @@ namespace solidity::yul
 
 using SourceLocation = langutil::SourceLocation;
 
+namespace
+{
+
+/// @returns a view of the string value @a _value without copying it.
+string_view asStringView(Json::Value const& _value)
+{
+	char const* begin = nullptr;
+	char const* end = nullptr;
+	yulAssert(_value.getString(&begin, &end), "Expected string.");
+	return {begin, static_cast<size_t>(end - begin)};
+}
+
+}
+
 SourceLocation const AsmJsonImporter::createSourceLocation(Json::Value const& _node)
 {
-	yulAssert(member(_node, "src").isString(), "'src' must be a string");
+	Json::Value const& src = member(_node, "src");
+	yulAssert(src.isString(), "'src' must be a string");
 
-	return solidity::langutil::parseSourceLocation(_node["src"].asString(), m_sourceNames);
+	return solidity::langutil::parseSourceLocation(asStringView(src), m_sourceNames);
 }
 
 template <class T>
@@ -62,10 +75,10 @@ T AsmJsonImporter::createAsmNode(Json::Value const& _node)
 	return r;
 }
 
-Json::Value AsmJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& AsmJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
@@ -79,12 +92,12 @@ TypedName AsmJsonImporter::createTypedName(Json::Value const& _node)
 
 Statement AsmJsonImporter::createStatement(Json::Value const& _node)
 {
-	Json::Value jsonNodeType = member(_node, "nodeType");
+	Json::Value const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.isString(), "Expected \"nodeType\" to be of type string!");
-	string nodeType = jsonNodeType.asString();
+	string_view nodeType = asStringView(jsonNodeType);
 
 	yulAssert(nodeType.substr(0, 3) == "Yul", "Invalid nodeType prefix");
-	nodeType = nodeType.substr(3);
+	nodeType.remove_prefix(3);
 
 	if (nodeType == "ExpressionStatement")
 		return createExpressionStatement(_node);
@@ -114,12 +127,12 @@ Statement AsmJsonImporter::createStatement(Json::Value const& _node)
 
 Expression AsmJsonImporter::createExpression(Json::Value const& _node)
 {
-	Json::Value jsonNodeType = member(_node, "nodeType");
+	Json::Value const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.isString(), "Expected \"nodeType\" to be of type string!");
-	string nodeType = jsonNodeType.asString();
+	string_view nodeType = asStringView(jsonNodeType);
 
 	yulAssert(nodeType.substr(0, 3) == "Yul", "Invalid nodeType prefix");
-	nodeType = nodeType.substr(3);
+	nodeType.remove_prefix(3);
 
 	if (nodeType == "FunctionCall")
 		return createFunctionCall(_node);
@@ -38,7 +38,8 @@ namespace solidity::yul
 class AsmJsonImporter
 {
 public:
-	explicit AsmJsonImporter(std::vector<std::shared_ptr<std::string const>> const& _sourceNames):
+	/// @param _sourceNames the names of the sources by index, obtained from langutil::internSourceName.
+	explicit AsmJsonImporter(std::vector<std::string const*> const& _sourceNames):
 		m_sourceNames(_sourceNames)
 	{}
 	yul::Block createBlock(Json::Value const& _node);
@@ -48,8 +49,8 @@ private:
 	template <class T>
 	T createAsmNode(Json::Value const& _node);
 	/// helper function to access member functions of the JSON
-	/// and throw an error if it does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	/// @returns the member or a null value if it does not exist
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
 
 	yul::Statement createStatement(Json::Value const& _node);
 	yul::Expression createExpression(Json::Value const& _node);
@@ -72,7 +73,7 @@ private:
 	yul::Break createBreak(Json::Value const& _node);
 	yul::Continue createContinue(Json::Value const& _node);
 
-	std::vector<std::shared_ptr<std::string const>> const& m_sourceNames;
+	std::vector<std::string const*> const& m_sourceNames;
 };
 
 }
@@ -65,15 +65,22 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 	switch (m_useSourceLocationFrom)
 	{
 		case UseSourceLocationFrom::Scanner:
-			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
+			return shareDebugData(DebugData{ParserBase::currentLocation(), ParserBase::currentLocation()});
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return shareDebugData(DebugData{m_locationOverride, m_locationOverride});
 		case UseSourceLocationFrom::Comments:
-			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
+			return shareDebugData(DebugData{ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment});
 	}
 	solAssert(false, "");
 }
 
+shared_ptr<DebugData const> const& Parser::shareDebugData(DebugData _debugData) const
+{
+	if (!m_lastDebugData || *m_lastDebugData != _debugData)
+		m_lastDebugData = make_shared<DebugData const>(move(_debugData));
+	return m_lastDebugData;
+}
+
 void Parser::updateLocationEndFrom(
 	shared_ptr<DebugData const>& _debugData,
 	SourceLocation const& _location
@@ -88,7 +95,7 @@ void Parser::updateLocationEndFrom(
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
 			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			_debugData = shareDebugData(move(updatedDebugData));
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -98,12 +105,24 @@ void Parser::updateLocationEndFrom(
 		{
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			_debugData = shareDebugData(move(updatedDebugData));
 			break;
 		}
 	}
 }
 
+optional<map<unsigned, string const*>> Parser::internSourceNames(
+	optional<map<unsigned, shared_ptr<string const>>> const& _sourceNames
+)
+{
+	if (!_sourceNames)
+		return nullopt;
+	map<unsigned, string const*> result;
+	for (auto const& [index, name]: *_sourceNames)
+		result[index] = name ? internSourceName(*name) : nullptr;
+	return result;
+}
+
 unique_ptr<Block> Parser::parse(CharStream& _charStream)
 {
 	m_scanner = make_shared<Scanner>(_charStream);
@@ -244,9 +263,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		);
 	else
 	{
-		shared_ptr<string const> sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
+		string const* sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
 		solAssert(sourceName, "");
-		return {{tail, SourceLocation{start.value(), end.value(), move(sourceName)}}};
+		return {{tail, SourceLocation{start.value(), end.value(), sourceName}}};
 	}
 	return {{tail, SourceLocation{}}};
 }
@@ -77,7 +77,7 @@ public:
 	):
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
-		m_sourceNames{std::move(_sourceNames)},
+		m_sourceNames{internSourceNames(_sourceNames)},
 		m_useSourceLocationFrom{
 			m_sourceNames.has_value() ?
 			UseSourceLocationFrom::Comments :
@@ -125,6 +125,10 @@ protected:
 		langutil::SourceLocation const& _location
 	) const;
 
+	/// @returns a DebugData object equal to @a _debugData. Reuses the object returned by the
+	/// previous call if it is equal, which is the case e.g. for nested nodes starting at the same token.
+	std::shared_ptr<DebugData const> const& shareDebugData(DebugData _debugData) const;
+
 	/// Creates an inline assembly node with the current source location.
 	template <class T> T createWithLocation() const
 	{
@@ -154,12 +158,18 @@ protected:
 	static bool isValidNumberLiteral(std::string const& _literal);
 
 private:
+	static std::optional<std::map<unsigned, std::string const*>> internSourceNames(
+		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> const& _sourceNames
+	);
+
 	Dialect const& m_dialect;
 
-	std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> m_sourceNames;
+	std::optional<std::map<unsigned, std::string const*>> m_sourceNames;
 	langutil::SourceLocation m_locationOverride;
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
+	/// Most recently created debug data, shared between nodes having identical debug data.
+	mutable std::shared_ptr<DebugData const> m_lastDebugData;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
@@ -33,6 +33,10 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -91,19 +95,63 @@ public:
 	);
 
 private:
-	std::string formatTypedName(TypedName _variable);
+	/// Prints @a _node into a new output buffer and returns it.
+	template <class T>
+	std::string format(T const& _node)
+	{
+		m_out.clear();
+		m_indentation = 0;
+		m_lineBreaks = 0;
+		print(_node);
+		return std::move(m_out);
+	}
+
+	/// Functions that append the code of a node to @a m_out, indented by @a m_indentation.
+	void print(Literal const& _literal);
+	void print(Identifier const& _identifier);
+	void print(ExpressionStatement const& _expr);
+	void print(Assignment const& _assignment);
+	void print(VariableDeclaration const& _variableDeclaration);
+	void print(FunctionDefinition const& _functionDefinition);
+	void print(FunctionCall const& _functionCall);
+	void print(If const& _if);
+	void print(Switch const& _switch);
+	void print(ForLoop const& _forLoop);
+	void print(Break const& _break);
+	void print(Continue const& _continue);
+	void print(Leave const& _leave);
+	void print(Block const& _block);
+	void print(Expression const& _expression);
+	void print(Statement const& _statement);
+	void printTypedNames(std::vector<TypedName> const& _variables);
+
+	/// Starts a new line at the current indentation.
+	void newLine();
+	/// Moves the parts of the output given by their begin and end, all after @a _position, to
+	/// @a _position, replacing the line break in front of each part that does not start there by
+	/// a space. Only used for short parts, so that the layout can be decided after printing them.
+	void joinLines(size_t _position, std::vector<std::pair<size_t, size_t>> const& _parts);
+
 	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
-	std::string formatDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
+	void printDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
 	template <class T>
-	std::string formatDebugData(T const& _node)
+	void printDebugData(T const& _node)
 	{
 		bool isExpression = std::is_constructible<Expression, T>::value;
-		return formatDebugData(_node.debugData, !isExpression);
+		printDebugData(_node.debugData, !isExpression);
 	}
 
 	Dialect const* const m_dialect = nullptr;
+	std::string m_out;
+	size_t m_indentation = 0;
+	/// Number of line breaks in @a m_out.
+	size_t m_lineBreaks = 0;
 	std::map<std::string, unsigned> m_nameToSourceIndex;
 	langutil::SourceLocation m_lastLocation = {};
+	/// Formatted source locations by source name, start and end. The code often alternates
+	/// between a few locations, which would otherwise be formatted again (including their
+	/// code snippets) at every change.
+	std::map<std::tuple<std::string const*, int, int>, std::string> m_formattedLocations;
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
 };
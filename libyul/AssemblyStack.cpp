@@ -34,10 +34,14 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/FunctionPreoptimiser.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+#include <list>
 #include <optional>
 
 using namespace std;
@@ -71,15 +75,20 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 )
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false,  false, false, false, false, false, false, false, _evmVersion, 0, 0};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
+	asmSettings.runInlinerWithSideEffects = _settings.runInlinerWithSideEffects;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
+	asmSettings.runSuperoptimiser = _settings.runSuperoptimiser;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runCSEAcrossBlocks = _settings.runCSEAcrossBlocks;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.cseMaxBlockLength = _settings.cseMaxBlockLength;
+	asmSettings.constantOptimiserNegation = _settings.constantOptimiserNegation;
 	asmSettings.evmVersion = _evmVersion;
 
 	return asmSettings;
@@ -96,6 +105,11 @@ CharStream const& AssemblyStack::charStream(string const& _sourceName) const
 }
 
 bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
+{
+	return parse(_sourceName, _source) && analyzeParsed();
+}
+
+shared_ptr<Object> AssemblyStack::parse(string const& _sourceName, string const& _source)
 {
 	m_errors.clear();
 	m_analysisSuccessful = false;
@@ -103,13 +117,30 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	shared_ptr<Scanner> scanner = make_shared<Scanner>(*m_charStream);
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(scanner, false);
 	if (!m_errorReporter.errors().empty())
-		return false;
+		return nullptr;
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
+	return m_parserResult;
+}
 
+bool AssemblyStack::analyze()
+{
+	yulAssert(m_parserResult, "");
+	yulAssert(!m_analysisSuccessful, "");
 	return analyzeParsed();
 }
 
+void AssemblyStack::setParserResult(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "");
+	m_errors.clear();
+	m_charStream.reset();
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -119,8 +150,10 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	vector<string> guardTrips = optimize(*m_parserResult, true);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	for (string const& message: guardTrips)
+		m_errorReporter.warning(4391_error, message);
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -135,7 +168,9 @@ void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 
 	*m_parserResult = EVMToEwasmTranslator(
 		languageToDialect(m_language, m_evmVersion),
-		*this
+		*this,
+		m_optimiserSettings.narrowEwasmValues,
+		m_optimiserSettings.pruneUnusedFunctions
 	).run(*parserResult());
 
 	m_language = _targetLanguage;
@@ -144,27 +179,53 @@ void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 bool AssemblyStack::analyzeParsed()
 {
 	yulAssert(m_parserResult, "");
-	m_analysisSuccessful = analyzeParsed(*m_parserResult);
+	m_analysisSuccessful = analyzeParsed(*m_parserResult, m_errorReporter);
 	return m_analysisSuccessful;
 }
 
-bool AssemblyStack::analyzeParsed(Object& _object)
+bool AssemblyStack::analyzeParsed(Object& _object, ErrorReporter& _errorReporter)
 {
 	yulAssert(_object.code, "");
 	_object.analysisInfo = make_shared<AsmAnalysisInfo>();
 
 	AsmAnalyzer analyzer(
 		*_object.analysisInfo,
-		m_errorReporter,
+		_errorReporter,
 		languageToDialect(m_language, m_evmVersion),
 		{},
 		_object.qualifiedDataNames()
 	);
 	bool success = analyzer.analyze(*_object.code);
+
+	vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			if (!analyzeParsed(*subObject))
+			subObjects.emplace_back(subObject);
+
+	if (m_optimizerParallelism <= 1)
+	{
+		for (Object* subObject: subObjects)
+			if (!analyzeParsed(*subObject, _errorReporter))
 				success = false;
+		return success;
+	}
+
+	// Sub-objects are analyzed independently, their errors are reported
+	// in the same order as in a sequential run.
+	vector<ErrorList> errors(subObjects.size());
+	vector<char> subObjectSuccess(subObjects.size(), false);
+	YulStringRepository& yulStrings = YulStringRepository::instance();
+	util::parallelForEach(subObjects.size(), m_optimizerParallelism, [&](size_t _index) {
+		YulStringRepository::Scope yulStringScope(yulStrings);
+		ErrorReporter errorReporter(errors[_index]);
+		subObjectSuccess[_index] = analyzeParsed(*subObjects[_index], errorReporter);
+	});
+	for (size_t i = 0; i < subObjects.size(); ++i)
+	{
+		_errorReporter.append(errors[i]);
+		if (!subObjectSuccess[i])
+			success = false;
+	}
 	return success;
 }
 
@@ -185,30 +246,133 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) cons
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_optimizerParallelism,
+		m_optimiserSettings.stackLayoutSearchBudget
+	);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+vector<string> AssemblyStack::optimize(Object& _object, bool _isCreation)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	// Describes all settings the optimised object depends on.
+	string context =
+		to_string(static_cast<int>(m_language)) + ":" +
+		m_evmVersion.name() + ":" +
+		(_isCreation ? "creation" : "runtime") + ":" +
+		(m_optimiserSettings.optimizeStackAllocation ? "stackAllocation" : "") + ":" +
+		to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + ":" +
+		to_string(m_optimiserSettings.inlinerGrowthBudget) + ":" +
+		(m_optimiserSettings.reuseMemorySlots ? "reuseMemorySlots" : "") + ":" +
+		(m_optimiserSettings.rematerialiserGasCosts ? "rematerialiserGasCosts" : "") + ":" +
+		(m_optimiserSettings.storeKnowledgeAcrossCalls ? "storeKnowledgeAcrossCalls" : "") + ":" +
+		(m_optimiserSettings.storeKnowledgeInLoops ? "storeKnowledgeInLoops" : "") + ":" +
+		to_string(m_optimiserSettings.yulOptimiserMaxCodeGrowth) + ":" +
+		to_string(m_optimiserSettings.yulOptimiserMaxSteps) + ":" +
+		to_string(m_optimiserSettings.stackLayoutSearchBudget) + ":" +
+		m_optimiserSettings.yulOptimiserSteps;
+	for (auto const& [function, executions]: m_optimiserSettings.functionExecutionsPerDeployment)
+		context += ":" + function + "=" + to_string(executions);
+
+	// The functions pre-optimised in isolation only depend on the settings, while the object
+	// also depends on which of its functions are pre-optimised.
+	set<YulString> preoptimizedFunctions;
+	string objectContext = context;
+	for (Statement const& statement: _object.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			if (m_preoptimizedFunctions.count(function->name.str()))
+			{
+				preoptimizedFunctions.insert(function->name);
+				objectContext += ":preoptimized=" + function->name.str();
+			}
+
+	optional<util::h256> cacheKey;
+	if (m_optimizedObjectCache)
+	{
+		cacheKey = OptimizedObjectCache::key(_object, dialect, objectContext);
+		vector<string> cachedGuardTrips;
+		if (shared_ptr<Object> cached = m_optimizedObjectCache->lookup(*cacheKey, dialect, &cachedGuardTrips))
+		{
+			size_t subId = _object.subId;
+			_object = move(*cached);
+			_object.subId = subId;
+			return cachedGuardTrips;
+		}
+	}
+
+	vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+			subObjects.emplace_back(subObject);
+	// The messages are collected per sub-object to report them in a stable order.
+	vector<vector<string>> subObjectGuardTrips(subObjects.size());
+	YulStringRepository& yulStrings = YulStringRepository::instance();
+	util::parallelForEach(subObjects.size(), m_optimizerParallelism, [&](size_t _index) {
+		YulStringRepository::Scope yulStringScope(yulStrings);
+		subObjectGuardTrips[_index] = optimize(*subObjects[_index], false);
+	});
 
-	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
+	// Creation code is only run once, so the execution profile only applies to runtime code.
+	list<GasMeter> functionMeters;
+	map<YulString, GasMeter const*> functionMeterByName;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
+	{
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
+		if (!_isCreation)
+			for (auto const& [function, executions]: m_optimiserSettings.functionExecutionsPerDeployment)
+				functionMeterByName[YulString{function}] = &functionMeters.emplace_back(*evmDialect, false, executions);
+	}
+	if (!preoptimizedFunctions.empty())
+		FunctionPreoptimiser::run(
+			dialect,
+			_object,
+			preoptimizedFunctions,
+			_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
+			m_optimizedObjectCache.get(),
+			context
+		);
+
+	optional<string> guardTrip = OptimiserSuite::run(
 		dialect,
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
 		m_optimiserSettings.yulOptimiserSteps,
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		m_optimizerParallelism,
+		functionMeterByName,
+		m_optimiserSettings.inlinerGrowthBudget,
+		m_optimiserSettings.reuseMemorySlots,
+		m_optimiserSettings.rematerialiserGasCosts,
+		m_optimiserSettings.storeKnowledgeAcrossCalls,
+		m_optimiserSettings.storeKnowledgeInLoops,
+		m_optimiserSettings.yulOptimiserMaxCodeGrowth,
+		m_optimiserSettings.yulOptimiserMaxSteps,
+		m_optimiserSettings.stackLayoutSearchBudget
 	);
+
+	vector<string> guardTrips;
+	if (guardTrip)
+		guardTrips.emplace_back(
+			"The Yul optimizer stopped the optimization sequence of object \"" + _object.name.str() + "\" because " +
+			*guardTrip + " and only ran a reduced set of steps on it."
+		);
+	for (vector<string>& messages: subObjectGuardTrips)
+		guardTrips += move(messages);
+
+	// The messages are stored with the object, so that they are reported for every use of it.
+	if (cacheKey)
+		m_optimizedObjectCache->store(*cacheKey, _object, guardTrips);
+	return guardTrips;
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -228,7 +392,7 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 		Dialect const& dialect = languageToDialect(m_language, EVMVersion{});
 
 		MachineAssemblyObject object;
-		auto result = WasmObjectCompiler::compile(*m_parserResult, dialect);
+		auto result = WasmObjectCompiler::compile(*m_parserResult, dialect, m_optimizerParallelism);
 		object.assembly = std::move(result.first);
 		object.bytecode = make_shared<evmasm::LinkerObject>();
 		object.bytecode->bytecode = std::move(result.second);
@@ -285,7 +449,7 @@ AssemblyStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
 
-	assembly.optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion));
+	assembly.optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion), m_optimizerParallelism);
 
 	optional<size_t> subIndex;
 
@@ -29,12 +29,14 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/OptimizedObjectCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
 #include <memory>
+#include <set>
 #include <string>
 
 namespace solidity::evmasm
@@ -98,10 +100,39 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the parsing step only, so that the parsed object can be completed (e.g. by adding
+	/// sub-objects) before it is analyzed via @a analyze.
+	/// @returns the parsed object or nullptr if the input cannot be parsed.
+	/// Multiple calls overwrite the previous state.
+	std::shared_ptr<Object> parse(std::string const& _sourceName, std::string const& _source);
+
+	/// Runs the analysis step on the result of @a parse, returns false if it cannot be assembled.
+	bool analyze();
+
+	/// Uses the object @a _object instead of parsing and analyzing source code, which has to be
+	/// the result of another stack with the same language and EVM version.
+	/// The object is modified by the following steps. Multiple calls overwrite the previous state.
+	void setParserResult(std::shared_ptr<Object> _object);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
+	/// Reports a warning for each object whose optimisation sequence was stopped because
+	/// it exceeded the limits of the settings.
 	void optimize();
 
+	/// Sets a cache of optimised objects that can be shared with other assembly stacks.
+	/// Objects found in the cache are not optimised again.
+	void setOptimizedObjectCache(std::shared_ptr<OptimizedObjectCache> _cache) { m_optimizedObjectCache = std::move(_cache); }
+
+	/// Sets the maximum number of threads the analysis, the optimizer and the EVM and Ewasm code
+	/// generators use to process independent functions and sub-objects of an object.
+	/// Does not influence the result.
+	void setOptimizerParallelism(size_t _parallelism) { m_optimizerParallelism = _parallelism; }
+
+	/// Sets the names of top-level functions that are optimised in isolation before the objects
+	/// containing them, so that the results can be shared between objects (see FunctionPreoptimiser).
+	void setPreoptimizedFunctions(std::set<std::string> _functions) { m_preoptimizedFunctions = std::move(_functions); }
+
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
 
@@ -138,11 +169,13 @@ public:
 
 private:
 	bool analyzeParsed();
-	bool analyzeParsed(yul::Object& _object);
+	bool analyzeParsed(yul::Object& _object, langutil::ErrorReporter& _errorReporter);
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// @returns the messages of the warnings about the objects among @a _object and its
+	/// sub-objects whose optimisation sequence was stopped.
+	std::vector<std::string> optimize(yul::Object& _object, bool _isCreation);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
@@ -153,6 +186,9 @@ private:
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
+	std::shared_ptr<OptimizedObjectCache> m_optimizedObjectCache;
+	size_t m_optimizerParallelism = 1;
+	std::set<std::string> m_preoptimizedFunctions;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
 
@@ -22,15 +22,160 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <libsolutil/Visitor.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/**
+ * Computes an upper bound for the stack height of the legacy code transform in the outermost
+ * block and in every function, as the sum of the slots for the return label, the parameters
+ * and the return variables, the variables in scope and the values needed to evaluate expressions.
+ * If the bound does not exceed 16, every variable can be reached by DUP16 and SWAP16.
+ */
+class StackHeightBound: public ASTWalker
+{
+public:
+	/// @returns the maximal bound over all functions or nullopt if a called function was not found.
+	static optional<size_t> run(Dialect const& _dialect, Block const& _ast)
+	{
+		StackHeightBound bound{_dialect};
+		bound.collectFunctions(_ast);
+		bound(_ast);
+		if (!bound.m_complete)
+			return nullopt;
+		return bound.m_maxHeight;
+	}
+
+	using ASTWalker::operator();
+
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		require(m_height + depth(_statement.expression));
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		require(m_height + depth(*_assignment.value));
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		require(m_height + (_varDecl.value ? depth(*_varDecl.value) : _varDecl.variables.size()));
+		m_height += _varDecl.variables.size();
+		require(m_height);
+	}
+	void operator()(If const& _if) override
+	{
+		require(m_height + depth(*_if.condition));
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		require(m_height + depth(*_switch.expression));
+		// The value of the expression stays on the stack and is compared with each case.
+		++m_height;
+		require(m_height + 2);
+		for (Case const& switchCase: _switch.cases)
+			(*this)(switchCase.body);
+		--m_height;
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		// The variables declared in the initialisation part stay in scope for the whole loop.
+		size_t heightBefore = m_height;
+		walkVector(_forLoop.pre.statements);
+		require(m_height + depth(*_forLoop.condition));
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+		m_height = heightBefore;
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		size_t heightBefore = m_height;
+		m_height = 1 + _function.parameters.size() + _function.returnVariables.size();
+		require(m_height);
+		(*this)(_function.body);
+		m_height = heightBefore;
+	}
+	void operator()(Block const& _block) override
+	{
+		size_t heightBefore = m_height;
+		walkVector(_block.statements);
+		m_height = heightBefore;
+	}
+
+private:
+	explicit StackHeightBound(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	void collectFunctions(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			std::visit(GenericVisitor{
+				[&](FunctionDefinition const& _function) {
+					size_t& returns = m_functionReturns[_function.name];
+					returns = max(returns, _function.returnVariables.size());
+					collectFunctions(_function.body);
+				},
+				[&](If const& _if) { collectFunctions(_if.body); },
+				[&](Switch const& _switch) {
+					for (Case const& switchCase: _switch.cases)
+						collectFunctions(switchCase.body);
+				},
+				[&](ForLoop const& _forLoop) {
+					collectFunctions(_forLoop.pre);
+					collectFunctions(_forLoop.body);
+					collectFunctions(_forLoop.post);
+				},
+				[&](Block const& _nested) { collectFunctions(_nested); },
+				[](auto const&) {}
+			}, statement);
+	}
+
+	/// @returns an upper bound for the number of slots used to evaluate @a _expression.
+	size_t depth(Expression const& _expression)
+	{
+		FunctionCall const* call = get_if<FunctionCall>(&_expression);
+		if (!call)
+			return 1;
+
+		size_t returns = 0;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(call->functionName.name))
+			returns = builtin->returns.size();
+		else if (auto it = m_functionReturns.find(call->functionName.name); it != m_functionReturns.end())
+			returns = it->second;
+		else
+			m_complete = false;
+
+		// The return label and the already evaluated arguments stay on the stack
+		// while an argument is evaluated.
+		size_t result = max<size_t>(1, returns);
+		for (Expression const& argument: call->arguments)
+			result = max(result, call->arguments.size() + depth(argument));
+		return result;
+	}
+
+	void require(size_t _height) { m_maxHeight = max(m_maxHeight, _height); }
+
+	Dialect const& m_dialect;
+	map<YulString, size_t> m_functionReturns;
+	size_t m_height = 0;
+	size_t m_maxHeight = 0;
+	bool m_complete = true;
+};
+
+}
+
 CompilabilityChecker::CompilabilityChecker(
 	Dialect const& _dialect,
 	Object const& _object,
@@ -39,6 +184,10 @@ CompilabilityChecker::CompilabilityChecker(
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
+		// Avoid the code transform if the stack cannot grow deep enough for any error.
+		if (optional<size_t> maxHeight = StackHeightBound::run(_dialect, *_object.code); maxHeight && *maxHeight <= 16)
+			return;
+
 		NoOutputEVMDialect noOutputDialect(*evmDialect);
 
 		yul::AsmAnalysisInfo analysisInfo =
@@ -41,6 +41,9 @@ namespace solidity::yul
  * functions are not nested. Otherwise, it might miss reporting some functions.
  *
  * Only checks the code of the object itself, does not descend into sub-objects.
+ *
+ * The code is only transformed if a simple upper bound of the stack height exceeds
+ * the reach of DUP16 and SWAP16 in at least one function.
  */
 struct CompilabilityChecker
 {
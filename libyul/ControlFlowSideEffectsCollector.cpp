@@ -26,7 +26,6 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Algorithms.h>
 
-#include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/algorithm/find_if.hpp>
 
@@ -179,15 +178,30 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 		m_functionCalls[function] = {};
 	}
 
-	// Process functions while we have progress. For now, we are only interested
-	// in `canContinue`.
-	bool progress = true;
-	while (progress)
+	// Process the functions in reverse topological order of the calls in their control-flow
+	// graphs, such that `canContinue` is already final for all called functions outside of
+	// the current strongly connected component. Only recursive functions have to be processed
+	// repeatedly while we have progress. For now, we are only interested in `canContinue`.
+	map<FunctionDefinition const*, set<FunctionCall const*>> allFunctionCalls;
+	for (auto&& [function, flow]: m_cfgBuilder.functionFlows())
+		util::BreadthFirstSearch<ControlFlowNode const*>{{flow.entry}}.run(
+			[&, function = function](ControlFlowNode const* _node, auto&& _addChild) {
+				if (_node->functionCall)
+					allFunctionCalls[function].insert(_node->functionCall);
+				for (ControlFlowNode const* successor: _node->successors)
+					_addChild(successor);
+			}
+		);
+	for (vector<FunctionDefinition const*> const& component: stronglyConnectedComponents(allFunctionCalls))
 	{
-		progress = false;
-		for (FunctionDefinition const* function: m_pendingNodes | ranges::views::keys)
-			if (processFunction(*function))
-				progress = true;
+		bool progress = true;
+		while (progress)
+		{
+			progress = false;
+			for (FunctionDefinition const* function: component)
+				if (processFunction(*function))
+					progress = true;
+		}
 	}
 
 	// No progress anymore: All remaining nodes are calls
@@ -197,31 +211,54 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 
 	// Now it is sufficient to handle the reachable function calls (`m_functionCalls`),
 	// we do not have to consider the control-flow graph anymore.
-	for (auto&& [function, calls]: m_functionCalls)
+	// All functions in a strongly connected component reach the same calls and
+	// the side-effects of the components they call are already final.
+	for (vector<FunctionDefinition const*> const& component: stronglyConnectedComponents(m_functionCalls))
 	{
-		yulAssert(function);
-		ControlFlowSideEffects& functionSideEffects = m_functionSideEffects[function];
-		auto _visit = [&, visited = std::set<FunctionDefinition const*>{}](FunctionDefinition const& _function, auto&& _recurse) mutable {
-			// Worst side-effects already, stop searching.
-			if (functionSideEffects.canTerminate && functionSideEffects.canRevert)
-				return;
-			if (!visited.insert(&_function).second)
-				return;
-
-			for (FunctionCall const* call: m_functionCalls.at(&_function))
+		bool canTerminate = false;
+		bool canRevert = false;
+		for (FunctionDefinition const* function: component)
+			for (FunctionCall const* call: m_functionCalls.at(function))
 			{
 				ControlFlowSideEffects const& calledSideEffects = sideEffects(*call);
-				if (calledSideEffects.canTerminate)
-					functionSideEffects.canTerminate = true;
-				if (calledSideEffects.canRevert)
-					functionSideEffects.canRevert = true;
-
-				if (m_functionReferences.count(call))
-					_recurse(*m_functionReferences.at(call), _recurse);
+				canTerminate = canTerminate || calledSideEffects.canTerminate;
+				canRevert = canRevert || calledSideEffects.canRevert;
 			}
-		};
-		_visit(*function, _visit);
+		for (FunctionDefinition const* function: component)
+		{
+			m_functionSideEffects[function].canTerminate = m_functionSideEffects[function].canTerminate || canTerminate;
+			m_functionSideEffects[function].canRevert = m_functionSideEffects[function].canRevert || canRevert;
+		}
+	}
+}
+
+vector<vector<FunctionDefinition const*>> ControlFlowSideEffectsCollector::stronglyConnectedComponents(
+	map<FunctionDefinition const*, set<FunctionCall const*>> const& _calls
+) const
+{
+	// Dense integer IDs of the functions.
+	vector<FunctionDefinition const*> functions;
+	map<FunctionDefinition const*, size_t> functionIDs;
+	for (auto&& [function, flow]: m_cfgBuilder.functionFlows())
+	{
+		functionIDs[function] = functions.size();
+		functions.emplace_back(function);
+	}
+
+	vector<vector<size_t>> successors(functions.size());
+	for (auto&& [function, calls]: _calls)
+		for (FunctionCall const* call: calls)
+			if (FunctionDefinition const* const* callee = util::valueOrNullptr(m_functionReferences, call))
+				successors[functionIDs.at(function)].emplace_back(functionIDs.at(*callee));
+
+	vector<vector<FunctionDefinition const*>> components;
+	for (vector<size_t> const& component: util::stronglyConnectedComponents(successors))
+	{
+		components.emplace_back();
+		for (size_t id: component)
+			components.back().emplace_back(functions[id]);
 	}
+	return components;
 }
 
 map<YulString, ControlFlowSideEffects> ControlFlowSideEffectsCollector::functionSideEffectsNamed() const
@@ -25,6 +25,8 @@
 #include <stack>
 #include <optional>
 #include <list>
+#include <map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -104,6 +106,13 @@ public:
 	std::map<YulString, ControlFlowSideEffects> functionSideEffectsNamed() const;
 private:
 
+	/// @returns the strongly connected components of the graph of the given calls between
+	/// user-defined functions in reverse topological order, i.e. each component comes after
+	/// the components of all functions it calls.
+	std::vector<std::vector<FunctionDefinition const*>> stronglyConnectedComponents(
+		std::map<FunctionDefinition const*, std::set<FunctionCall const*>> const& _calls
+	) const;
+
 	/// @returns false if nothing could be processed.
 	bool processFunction(FunctionDefinition const& _function);
 
@@ -52,13 +52,9 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type)
 
 Dialect const& Dialect::yulDeprecated()
 {
-	static unique_ptr<Dialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
-
-	if (!dialect)
-	{
+	return YulStringRepository::instance().cached<Dialect>("yulDeprecated", []() {
 		// TODO will probably change, especially the list of types.
-		dialect = make_unique<Dialect>();
+		auto dialect = make_unique<Dialect>();
 		dialect->defaultType = "u256"_yulstring;
 		dialect->boolType = "bool"_yulstring;
 		dialect->types = {
@@ -74,7 +70,6 @@ Dialect const& Dialect::yulDeprecated()
 			"u256"_yulstring,
 			"s256"_yulstring
 		};
-	};
-
-	return *dialect;
+		return dialect;
+	});
 }
@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/OptimizedObjectCache.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Exceptions.h>
+#include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+using namespace solidity::langutil;
+
+h256 OptimizedObjectCache::key(Object const& _object, Dialect const& _dialect, string const& _context)
+{
+	return keccak256(_context + '\0' + _object.toString(&_dialect, DebugInfoSelection::All()));
+}
+
+shared_ptr<Object> OptimizedObjectCache::lookup(
+	h256 const& _key,
+	Dialect const& _dialect,
+	vector<string>* _messages
+)
+{
+	shared_ptr<Object const> cached;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_objects.find(_key);
+		if (it != m_objects.end())
+		{
+			cached = it->second.object;
+			if (_messages)
+				*_messages = it->second.messages;
+		}
+	}
+	if (!cached)
+	{
+		if (!m_persistentStore.load)
+			return nullptr;
+		optional<string> source = m_persistentStore.load(_key);
+		if (!source)
+			return nullptr;
+		shared_ptr<Object> loaded = parse(*source, _dialect);
+		if (!loaded)
+			return nullptr;
+		shared_ptr<Object const> object = copy(*loaded);
+		lock_guard<mutex> lock(m_mutex);
+		// Only objects without messages are persisted.
+		m_objects.emplace(_key, Entry{move(object), {}});
+		if (_messages)
+			_messages->clear();
+		return loaded;
+	}
+	shared_ptr<Object> result = copy(*cached);
+	analyze(*result, _dialect);
+	return result;
+}
+
+void OptimizedObjectCache::store(h256 const& _key, Object const& _optimizedObject, vector<string> _messages)
+{
+	shared_ptr<Object const> object = copy(_optimizedObject);
+	// The persistent store only holds the code, so objects with messages are not persisted.
+	bool const persist = _messages.empty();
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_objects.emplace(_key, Entry{object, move(_messages)}).second)
+			return;
+	}
+	if (persist && m_persistentStore.store && locationsInComments(*object))
+		// The types are printed explicitly, so that the object can be parsed in any dialect.
+		m_persistentStore.store(_key, object->toString(nullptr, DebugInfoSelection::All()));
+}
+
+size_t OptimizedObjectCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_objects.size();
+}
+
+shared_ptr<Object> OptimizedObjectCache::copy(Object const& _object)
+{
+	yulAssert(_object.code, "");
+	auto result = make_shared<Object>();
+	result->name = _object.name;
+	result->subId = _object.subId;
+	result->code = make_shared<Block>(std::get<Block>(ASTCopier{}(*_object.code)));
+	result->subIndexByName = _object.subIndexByName;
+	result->debugData = _object.debugData;
+	for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			result->subObjects.emplace_back(copy(*subObject));
+		else
+			// Data objects are never modified.
+			result->subObjects.emplace_back(subNode);
+	return result;
+}
+
+bool OptimizedObjectCache::locationsInComments(Object const& _object)
+{
+	if (!_object.debugData || !_object.debugData->sourceNames)
+		return false;
+	for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			if (!locationsInComments(*subObject))
+				return false;
+	return true;
+}
+
+shared_ptr<Object> OptimizedObjectCache::parse(string const& _source, Dialect const& _dialect)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(_source, "");
+	shared_ptr<Object> object = ObjectParser(errorReporter, _dialect).parse(make_shared<Scanner>(charStream), false);
+	if (!object || errorReporter.hasErrors())
+		return nullptr;
+
+	auto const analyzeLoaded = [&](Object& _loaded, auto&& _recurse) -> bool {
+		_loaded.analysisInfo = make_shared<AsmAnalysisInfo>();
+		if (!AsmAnalyzer(
+			*_loaded.analysisInfo,
+			errorReporter,
+			_dialect,
+			{},
+			_loaded.qualifiedDataNames()
+		).analyze(*_loaded.code))
+			return false;
+		for (shared_ptr<ObjectNode> const& subNode: _loaded.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				if (!_recurse(*subObject, _recurse))
+					return false;
+		return true;
+	};
+	if (!analyzeLoaded(*object, analyzeLoaded) || errorReporter.hasErrors())
+		return nullptr;
+	return object;
+}
+
+void OptimizedObjectCache::analyze(Object& _object, Dialect const& _dialect)
+{
+	_object.analysisInfo = make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object));
+	for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			analyze(*subObject, _dialect);
+}
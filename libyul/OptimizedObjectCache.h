@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of optimised Yul objects that can be shared between several assembly stacks.
+ */
+
+#pragma once
+
+#include <libyul/Object.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Stores the optimised versions of Yul objects, so that objects which occur several times
+ * (e.g. the creation code of a contract that is deployed by several other contracts) are only
+ * optimised once.
+ *
+ * The key of an object is the hash of its full textual representation including all
+ * sub-objects and debug information, together with a description of everything else the
+ * optimiser depends on (dialect, settings). The cache only holds copies, so the stored objects
+ * are never modified by the caller. It can be used by several threads at the same time, but all
+ * users have to share the same YulStringRepository.
+ *
+ * Optionally, the objects are also kept in a persistent store (e.g. a directory) in their
+ * textual representation, so that unchanged objects are not optimised again in later
+ * compilations.
+ */
+class OptimizedObjectCache
+{
+public:
+	/// Functions to load and store printed optimised objects from and to a persistent store.
+	/// They are called concurrently if the cache is used by several threads.
+	struct PersistentStore
+	{
+		std::function<std::optional<std::string>(util::h256 const&)> load;
+		std::function<void(util::h256 const&, std::string const&)> store;
+	};
+
+	OptimizedObjectCache() = default;
+	explicit OptimizedObjectCache(PersistentStore _persistentStore):
+		m_persistentStore(std::move(_persistentStore))
+	{}
+
+	/// @returns the key under which the optimised version of @a _object is stored.
+	/// @param _context has to describe all settings the optimiser is run with.
+	static util::h256 key(Object const& _object, Dialect const& _dialect, std::string const& _context);
+
+	/// @returns a fresh copy of the object stored under @a _key, analyzed using @a _dialect,
+	/// or nullptr if there is no such object, neither in memory nor in the persistent store.
+	/// Entries of the persistent store that cannot be parsed or analyzed are ignored.
+	/// If @a _messages is given, it is set to the messages stored with the object.
+	std::shared_ptr<Object> lookup(
+		util::h256 const& _key,
+		Dialect const& _dialect,
+		std::vector<std::string>* _messages = nullptr
+	);
+	/// Stores a copy of @a _optimizedObject under @a _key, unless there already is an entry.
+	/// @a _messages are the messages (e.g. warnings) produced while optimizing the object, so that
+	/// they can be reported again for every use of the entry.
+	/// New entries are also printed to the persistent store if they have no messages and the
+	/// source locations of the object and its sub-objects can be restored from the printed comments.
+	void store(
+		util::h256 const& _key,
+		Object const& _optimizedObject,
+		std::vector<std::string> _messages = {}
+	);
+
+	/// @returns the number of objects in memory.
+	size_t size() const;
+
+	/// @returns a copy of @a _object and its sub-objects that does not share any code with it.
+	/// The copy is not analyzed.
+	static std::shared_ptr<Object> copy(Object const& _object);
+
+private:
+	static void analyze(Object& _object, Dialect const& _dialect);
+	/// @returns true if @a _object and all its sub-objects refer to their sources via
+	/// `@use-src`, so that their source locations are printed in the `@src` comments.
+	static bool locationsInComments(Object const& _object);
+	/// @returns the object parsed from @a _source and analyzed using @a _dialect or nullptr
+	/// if it is invalid.
+	static std::shared_ptr<Object> parse(std::string const& _source, Dialect const& _dialect);
+
+	struct Entry
+	{
+		std::shared_ptr<Object const> object;
+		std::vector<std::string> messages;
+	};
+
+	PersistentStore m_persistentStore;
+	mutable std::mutex m_mutex;
+	std::map<util::h256, Entry> m_objects;
+};
+
+}
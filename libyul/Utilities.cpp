@@ -30,7 +30,10 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -38,6 +41,55 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns the value of the number literal @a _literal if it is a valid decimal or hexadecimal
+/// number literal whose value is known to fit into 64 bits by its length, and nullopt otherwise.
+/// This avoids the generic big integer parser for the most common literals.
+optional<uint64_t> smallNumberLiteralValue(string const& _literal)
+{
+	if (_literal.size() > 2 && _literal.size() <= 2 + 16 && _literal[0] == '0' && _literal[1] == 'x')
+	{
+		uint64_t value = 0;
+		for (size_t i = 2; i < _literal.size(); ++i)
+		{
+			char c = _literal[i];
+			if (c >= '0' && c <= '9')
+				value = (value << 4) | uint64_t(c - '0');
+			else if (c >= 'a' && c <= 'f')
+				value = (value << 4) | uint64_t(c - 'a' + 10);
+			else if (c >= 'A' && c <= 'F')
+				value = (value << 4) | uint64_t(c - 'A' + 10);
+			else
+				return nullopt;
+		}
+		return value;
+	}
+	else if (!_literal.empty() && _literal.size() <= 19 && (_literal[0] != '0' || _literal.size() == 1))
+	{
+		uint64_t value = 0;
+		for (char c: _literal)
+			if (c >= '0' && c <= '9')
+				value = value * 10 + uint64_t(c - '0');
+			else
+				return nullopt;
+		return value;
+	}
+	return nullopt;
+}
+
+/// Values of the number literals that are not handled by smallNumberLiteralValue, by the address
+/// of their string in the YulString repository. It is stored in the repository,
+/// so that it has the same lifetime as the strings and is shared by all copies of a literal.
+struct NumberLiteralValues
+{
+	mutable shared_mutex mutex;
+	mutable unordered_map<string const*, u256> values;
+};
+
+}
+
 string solidity::yul::reindent(string const& _code)
 {
 	int constexpr indentationWidth = 4;
@@ -92,8 +144,24 @@ u256 solidity::yul::valueOfNumberLiteral(Literal const& _literal)
 	yulAssert(_literal.kind == LiteralKind::Number, "Expected number literal!");
 
 	std::string const& literalString = _literal.value.str();
+	if (optional<uint64_t> value = smallNumberLiteralValue(literalString))
+		return *value;
+
+	NumberLiteralValues const& cache = YulStringRepository::instance().cached<NumberLiteralValues>(
+		"numberLiteralValues",
+		[]() { return make_unique<NumberLiteralValues>(); }
+	);
+	{
+		shared_lock lock(cache.mutex);
+		if (u256 const* value = valueOrNullptr(cache.values, &literalString))
+			return *value;
+	}
+
 	yulAssert(isValidDecimal(literalString) || isValidHex(literalString), "Invalid number literal!");
-	return u256(literalString);
+	u256 value(literalString);
+	unique_lock lock(cache.mutex);
+	cache.values.emplace(&literalString, value);
+	return value;
 }
 
 u256 solidity::yul::valueOfStringLiteral(Literal const& _literal)
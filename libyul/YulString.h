@@ -23,30 +23,64 @@
 
 #include <fmt/format.h>
 
-#include <unordered_map>
+#include <atomic>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
-#include <functional>
 
 namespace solidity::yul
 {
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the string data (which is unique per string and repository,
+/// but whose value is potentially non-deterministic) and a deterministic string hash.
+///
+/// By default, a single process-wide repository is used. A repository can also be owned by
+/// a single compilation and be made the current one via a Scope object. YulStrings are only
+/// valid as long as their repository exists and YulStrings from different repositories
+/// must not be mixed.
+/// Access to a repository is synchronized, so YulStrings can be created and read
+/// from multiple threads. Looking up strings that are already present does not take a lock.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::string const* string;
 		std::uint64_t hash;
 	};
 
+	/// Makes the given repository the one returned by instance() on the current thread
+	/// for the lifetime of the Scope object.
+	class Scope
+	{
+	public:
+		explicit Scope(YulStringRepository& _repository): m_previous(current())
+		{
+			current() = &_repository;
+		}
+		~Scope() { current() = m_previous; }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		YulStringRepository* m_previous;
+	};
+
+	YulStringRepository() = default;
+	YulStringRepository(YulStringRepository const&) = delete;
+	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
+
+	/// @returns the repository of the innermost active Scope of the current thread
+	/// or the process-wide repository if there is none.
 	static YulStringRepository& instance()
 	{
+		if (YulStringRepository* repository = current())
+			return *repository;
 		static YulStringRepository inst;
 		return inst;
 	}
@@ -54,19 +88,37 @@ public:
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
+			return { &emptyString(), emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		if (Entry const* entry = find(m_table.load(std::memory_order_acquire), _string, h))
+			return Handle{&entry->string, h};
+
+		std::lock_guard lock(m_mutex);
+		// Another thread might have inserted the string in the meantime.
+		Table* table = m_table.load(std::memory_order_relaxed);
+		if (Entry const* entry = find(table, _string, h))
+			return Handle{&entry->string, h};
+		Entry const& entry = m_entries.emplace_back(Entry{_string, h});
+		if (!table || 2 * m_entries.size() > table->size)
+			grow();
+		else
+			insert(*table, entry);
+
+		return Handle{&entry.string, h};
+	}
+
+	/// @returns the object stored under @a _key, creating it using @a _create if it does not
+	/// exist yet. This is meant for objects that contain YulStrings, like dialects, which
+	/// need to have the same lifetime as the repository.
+	template <typename T, typename Create>
+	T const& cached(std::string const& _key, Create&& _create)
+	{
+		std::lock_guard lock(m_cacheMutex);
+		std::shared_ptr<void const>& entry = m_cache[_key];
+		if (!entry)
+			entry = std::shared_ptr<T const>(_create());
+		return *std::static_pointer_cast<T const>(entry);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -81,45 +133,96 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// The data of the empty string, shared by all repositories.
+	static std::string const& emptyString()
+	{
+		static std::string const empty;
+		return empty;
+	}
+	/// Clear the current repository (see instance()), including all cached objects.
 	/// Use with care - there cannot be any dangling YulString references.
-	/// If references need to be cleared manually, register the callback via
-	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		YulStringRepository& repository = instance();
+		std::lock_guard cacheLock(repository.m_cacheMutex);
+		std::lock_guard lock(repository.m_mutex);
+		repository.m_cache.clear();
+		repository.m_table.store(nullptr, std::memory_order_release);
+		repository.m_tables.clear();
+		repository.m_entries.clear();
+	}
+
+private:
+	static YulStringRepository*& current()
+	{
+		thread_local YulStringRepository* repository = nullptr;
+		return repository;
 	}
-	/// Struct that registers a reset callback as a side-effect of its construction.
-	/// Useful as static local variable to register a reset callback once.
-	struct ResetCallback
+
+	struct Entry
+	{
+		std::string string;
+		std::uint64_t hash;
+	};
+
+	/// Hash table with open addressing and linear probing. Its size is a power of two and
+	/// it is at most half full. Slots are only ever filled, never changed or cleared.
+	struct Table
 	{
-		ResetCallback(std::function<void()> _fun)
+		explicit Table(size_t _size): size(_size), slots(std::make_unique<std::atomic<Entry const*>[]>(_size)) {}
+		size_t size;
+		std::unique_ptr<std::atomic<Entry const*>[]> slots;
+	};
+
+	/// @returns the stored entry for @a _string if it is present in @a _table.
+	/// Can be called without holding m_mutex.
+	static Entry const* find(Table const* _table, std::string const& _string, std::uint64_t _hash)
+	{
+		if (!_table)
+			return nullptr;
+		for (size_t i = _hash & (_table->size - 1);; i = (i + 1) & (_table->size - 1))
 		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			Entry const* entry = _table->slots[i].load(std::memory_order_acquire);
+			if (!entry)
+				return nullptr;
+			if (entry->hash == _hash && entry->string == _string)
+				return entry;
 		}
-	};
+	}
 
-private:
-	YulStringRepository() = default;
-	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
-	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+	/// Adds @a _entry to @a _table. Requires m_mutex to be held.
+	static void insert(Table& _table, Entry const& _entry)
+	{
+		size_t i = _entry.hash & (_table.size - 1);
+		while (_table.slots[i].load(std::memory_order_relaxed))
+			i = (i + 1) & (_table.size - 1);
+		_table.slots[i].store(&_entry, std::memory_order_release);
+	}
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Replaces the table by one of twice the size that contains all entries.
+	/// The old tables are kept, since other threads might still be reading them.
+	/// Requires m_mutex to be held.
+	void grow()
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
+		Table const* previous = m_table.load(std::memory_order_relaxed);
+		auto& table = m_tables.emplace_back(std::make_unique<Table>(previous ? 2 * previous->size : 1024));
+		for (Entry const& entry: m_entries)
+			insert(*table, entry);
+		m_table.store(table.get(), std::memory_order_release);
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::mutex m_mutex;
+	/// Entries of all strings. A deque is used, since it does not move its elements.
+	std::deque<Entry> m_entries;
+	std::vector<std::unique_ptr<Table>> m_tables;
+	std::atomic<Table*> m_table = nullptr;
+
+	std::recursive_mutex m_cacheMutex;
+	std::map<std::string, std::shared_ptr<void const>> m_cache;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing their handles.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -134,32 +237,30 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical handles (only identical strings have
+	/// identical handles and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.string == _other.m_handle.string) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string handle.
+	bool operator==(YulString const& _other) const { return m_handle.string == _other.m_handle.string; }
+	bool operator!=(YulString const& _other) const { return m_handle.string != _other.m_handle.string; }
 
-	bool empty() const { return m_handle.id == 0; }
-	std::string const& str() const
-	{
-		return YulStringRepository::instance().idToString(m_handle.id);
-	}
+	bool empty() const { return m_handle.string == &YulStringRepository::emptyString(); }
+	/// Does not need to access the repository.
+	std::string const& str() const { return *m_handle.string; }
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string.
+	YulStringRepository::Handle m_handle{ &YulStringRepository::emptyString(), YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
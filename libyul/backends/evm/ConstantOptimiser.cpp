@@ -90,6 +90,15 @@ struct MiniEVMInterpreter
 };
 }
 
+void ConstantOptimiser::operator()(FunctionDefinition& _function)
+{
+	GasMeter const* outerMeter = m_meter;
+	if (GasMeter const* meter = valueOrDefault(m_functionMeters, _function.name, nullptr))
+		m_meter = meter;
+	ASTModifier::operator()(_function);
+	m_meter = outerMeter;
+}
+
 void ConstantOptimiser::visit(Expression& _e)
 {
 	if (holds_alternative<Literal>(_e))
@@ -100,7 +109,7 @@ void ConstantOptimiser::visit(Expression& _e)
 
 		if (
 			Expression const* repr =
-				RepresentationFinder(m_dialect, m_meter, debugDataOf(_e), m_cache)
+				RepresentationFinder(m_dialect, *m_meter, debugDataOf(_e), m_cache[m_meter])
 				.tryFindRepresentation(valueOfLiteral(literal))
 		)
 			_e = ASTCopier{}.translate(*repr);
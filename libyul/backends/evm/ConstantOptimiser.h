@@ -43,16 +43,27 @@ class GasMeter;
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
  *
+ * Constants inside the functions listed in @a _functionMeters are optimised using the
+ * respective gas meter (e.g. one that assumes a different number of executions per
+ * deployment), all other constants using @a _meter.
+ *
  * Prerequisite: None
  */
 class ConstantOptimiser: public ASTModifier
 {
 public:
-	ConstantOptimiser(EVMDialect const& _dialect, GasMeter const& _meter):
+	ConstantOptimiser(
+		EVMDialect const& _dialect,
+		GasMeter const& _meter,
+		std::map<YulString, GasMeter const*> _functionMeters = {}
+	):
 		m_dialect(_dialect),
-		m_meter(_meter)
+		m_meter(&_meter),
+		m_functionMeters(std::move(_functionMeters))
 	{}
 
+	using ASTModifier::operator();
+	void operator()(FunctionDefinition& _function) override;
 	void visit(Expression& _e) override;
 
 	struct Representation
@@ -63,8 +74,11 @@ public:
 
 private:
 	EVMDialect const& m_dialect;
-	GasMeter const& m_meter;
-	std::map<u256, Representation> m_cache;
+	/// Gas meter for the current function.
+	GasMeter const* m_meter;
+	std::map<YulString, GasMeter const*> m_functionMeters;
+	/// Cached representations, per gas meter.
+	std::map<GasMeter const*, std::map<u256, Representation>> m_cache;
 };
 
 class RepresentationFinder
@@ -33,6 +33,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
@@ -109,7 +111,7 @@ pair<YulString, BuiltinFunctionForEVM> createFunction(
 	return {name, f};
 }
 
-set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
+unordered_set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 {
 	// TODO remove this in 0.9.0. We allow creating functions or identifiers in Yul with the name
 	// basefee for VMs before london.
@@ -118,29 +120,29 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 		return _instr == evmasm::Instruction::BASEFEE && _evmVersion < langutil::EVMVersion::london();
 	};
 
-	set<YulString> reserved;
-	for (auto const& instr: evmasm::c_instructions)
+	unordered_set<YulString> reserved;
+	for (auto const& instr: evmasm::instructions())
 	{
 		string name = instr.first;
 		transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
 		if (!baseFeeException(instr.second))
 			reserved.emplace(name);
 	}
-	reserved += vector<YulString>{
+	reserved.insert({
 		"linkersymbol"_yulstring,
 		"datasize"_yulstring,
 		"dataoffset"_yulstring,
 		"datacopy"_yulstring,
 		"setimmutable"_yulstring,
 		"loadimmutable"_yulstring,
-	};
+	});
 	return reserved;
 }
 
-map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, bool _objectAccess)
+unordered_map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, bool _objectAccess)
 {
-	map<YulString, BuiltinFunctionForEVM> builtins;
-	for (auto const& instr: evmasm::c_instructions)
+	unordered_map<YulString, BuiltinFunctionForEVM> builtins;
+	for (auto const& instr: evmasm::instructions())
 	{
 		string name = instr.first;
 		transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
@@ -298,7 +300,9 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
-	if (m_objectAccess)
+	// Only names that start with "verbatim" are matched against the pattern,
+	// since this is called for every identifier during analysis.
+	if (m_objectAccess && boost::starts_with(_name.str(), "verbatim"))
 	{
 		smatch match;
 		if (regex_match(_name.str(), match, verbatimPattern()))
@@ -314,27 +318,25 @@ BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 bool EVMDialect::reservedIdentifier(YulString _name) const
 {
 	if (m_objectAccess)
-		if (_name.str().substr(0, "verbatim"s.size()) == "verbatim")
+		if (boost::starts_with(_name.str(), "verbatim"))
 			return true;
 	return m_reserved.count(_name) != 0;
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, false);
-	return *dialects[_version];
+	return YulStringRepository::instance().cached<EVMDialect>(
+		"EVMDialect:" + _version.name(),
+		[&]() { return make_unique<EVMDialect>(_version, false); }
+	);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, true);
-	return *dialects[_version];
+	return YulStringRepository::instance().cached<EVMDialect>(
+		"EVMDialectForObjects:" + _version.name(),
+		[&]() { return make_unique<EVMDialect>(_version, true); }
+	);
 }
 
 SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instruction)
@@ -359,6 +361,7 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	pair<size_t, size_t> key{_arguments, _returnVariables};
+	lock_guard<mutex> lock(m_verbatimFunctionsMutex);
 	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -485,9 +488,8 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
-	return *dialects[_version];
+	return YulStringRepository::instance().cached<EVMDialectTyped>(
+		"EVMDialectTyped:" + _version.name(),
+		[&]() { return make_unique<EVMDialectTyped>(_version, true); }
+	);
 }
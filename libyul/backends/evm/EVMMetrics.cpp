@@ -30,6 +30,7 @@
 #include <libevmasm/GasMeter.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
 
 using namespace std;
 using namespace solidity;
@@ -89,10 +90,11 @@ void GasMeterVisitor::operator()(FunctionCall const& _funCall)
 void GasMeterVisitor::operator()(Literal const& _lit)
 {
 	m_runGas += evmasm::GasMeter::runGas(evmasm::Instruction::PUSH1);
+	h256 buffer;
 	m_dataGas +=
 		singleByteDataGas() +
 		evmasm::GasMeter::dataGas(
-			toCompactBigEndian(valueOfLiteral(_lit), 1),
+			compactBigEndian(valueOfLiteral(_lit), buffer, 1),
 			m_isCreation,
 			m_dialect.evmVersion()
 		);
@@ -31,9 +31,16 @@
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _optimize,
+	size_t _parallelism,
+	size_t _stackLayoutSearchBudget
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect);
+	EVMObjectCompiler compiler(_assembly, _dialect, _parallelism, _stackLayoutSearchBudget);
 	compiler.run(_object, _optimize);
 }
 
@@ -49,7 +56,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize);
+			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_parallelism, m_stackLayoutSearchBudget);
 		}
 		else
 		{
@@ -71,7 +78,9 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.code,
 			m_dialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			m_parallelism,
+			m_stackLayoutSearchBudget
 		);
 		if (!stackErrors.empty())
 			BOOST_THROW_EXCEPTION(stackErrors.front());
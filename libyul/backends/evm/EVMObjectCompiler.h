@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,16 +32,37 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize);
+	/// @param _parallelism maximum number of threads used for independent parts of the
+	/// code generation. Does not influence the result.
+	/// @param _stackLayoutSearchBudget search budget of the stack layout generator used
+	/// by the optimized code transform (see StackLayoutGenerator::run).
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _optimize,
+		size_t _parallelism = 1,
+		size_t _stackLayoutSearchBudget = 0
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect):
-		m_assembly(_assembly), m_dialect(_dialect)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		size_t _parallelism,
+		size_t _stackLayoutSearchBudget
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_parallelism(_parallelism),
+		m_stackLayoutSearchBudget(_stackLayoutSearchBudget)
 	{}
 
 	void run(Object& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
+	size_t m_parallelism = 1;
+	size_t m_stackLayoutSearchBudget = 0;
 };
 
 }
@@ -23,6 +23,7 @@
 
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/cxx20.h>
 
@@ -44,11 +45,16 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	size_t _parallelism,
+	size_t _stackLayoutSearchBudget
 )
 {
+	util::Profiler::Timer timer("controlFlowGraphBuilder");
 	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
+	timer.restart("stackLayoutGenerator");
+	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, _parallelism, _stackLayoutSearchBudget);
+	timer.restart("optimizedCodeTransform");
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
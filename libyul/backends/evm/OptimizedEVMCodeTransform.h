@@ -47,13 +47,19 @@ public:
 	/// 2) For none of the functions 3) for the first function of each name.
 	enum class UseNamedLabels { YesAndForceUnique, Never, ForFirstFunctionOfEachName };
 
+	/// @param _parallelism maximum number of threads used to generate the stack layouts
+	/// of the functions. Does not influence the result.
+	/// @param _stackLayoutSearchBudget search budget of the stack layout generator
+	/// (see StackLayoutGenerator::run).
 	[[nodiscard]] static std::vector<StackTooDeepError> run(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		size_t _parallelism = 1,
+		size_t _stackLayoutSearchBudget = 0
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
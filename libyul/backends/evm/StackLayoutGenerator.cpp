@@ -25,6 +25,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -46,28 +47,48 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace std;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, size_t _parallelism, size_t _searchBudget)
 {
-	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout}.processEntryPoint(*_cfg.entry);
-
+	vector<CFG::BasicBlock const*> entries{_cfg.entry};
 	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout}.processEntryPoint(*functionInfo.entry);
+		entries.emplace_back(functionInfo.entry);
 
+	// The blocks and operations of the entry points are disjoint, so their layouts
+	// can be generated independently and merged afterwards.
+	vector<StackLayout> layouts(entries.size());
+	util::parallelForEach(entries.size(), _parallelism, [&](size_t _index) {
+		StackLayoutGenerator{layouts[_index], _searchBudget}.processEntryPoint(*entries[_index]);
+	});
+
+	StackLayout stackLayout = move(layouts.front());
+	for (StackLayout& layout: layouts | ranges::views::drop(1))
+	{
+		stackLayout.blockInfos.merge(layout.blockInfos);
+		stackLayout.operationEntryLayout.merge(layout.operationEntryLayout);
+		stackLayout.maxSearchedCandidates = max(stackLayout.maxSearchedCandidates, layout.maxSearchedCandidates);
+		yulAssert(layout.blockInfos.empty() && layout.operationEntryLayout.empty(), "");
+	}
 	return stackLayout;
 }
 
-map<YulString, vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg)
+map<YulString, vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(
+	CFG const& _cfg,
+	size_t _searchBudget
+)
 {
 	map<YulString, vector<StackLayoutGenerator::StackTooDeep>> stackTooDeepErrors;
-	stackTooDeepErrors[YulString{}] = reportStackTooDeep(_cfg, YulString{});
+	stackTooDeepErrors[YulString{}] = reportStackTooDeep(_cfg, YulString{}, _searchBudget);
 	for (auto const& function: _cfg.functions)
-		if (auto errors = reportStackTooDeep(_cfg, function->name); !errors.empty())
+		if (auto errors = reportStackTooDeep(_cfg, function->name, _searchBudget); !errors.empty())
 			stackTooDeepErrors[function->name] = move(errors);
 	return stackTooDeepErrors;
 }
 
-vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, YulString _functionName)
+vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(
+	CFG const& _cfg,
+	YulString _functionName,
+	size_t _searchBudget
+)
 {
 	StackLayout stackLayout;
 	CFG::FunctionInfo const* functionInfo = nullptr;
@@ -81,13 +102,15 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 		yulAssert(functionInfo, "Function not found.");
 	}
 
-	StackLayoutGenerator generator{stackLayout};
+	StackLayoutGenerator generator{stackLayout, _searchBudget};
 	CFG::BasicBlock const* entry = functionInfo ? functionInfo->entry : _cfg.entry;
 	generator.processEntryPoint(*entry);
 	return generator.reportStackTooDeep(*entry);
 }
 
-StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout): m_layout(_layout)
+StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, size_t _searchBudget):
+	m_layout(_layout),
+	m_searchBudget(_searchBudget)
 {
 }
 
@@ -541,7 +564,7 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2) const
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
@@ -594,6 +617,7 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 
 	// See https://en.wikipedia.org/wiki/Heap's_algorithm
 	size_t n = candidate.size();
+	Stack const initialCandidate = candidate;
 	Stack bestCandidate = candidate;
 	size_t bestCost = evaluate(candidate);
 	std::vector<size_t> c(n, 0);
@@ -625,6 +649,43 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 		}
 	}
 
+	// With a search budget, additionally run the proper version of the Heap algorithm, which
+	// enumerates all permutations, until they are exhausted or the budget is used up.
+	// The best candidate is only replaced by strictly cheaper ones, so the result is never worse
+	// than without the search.
+	if (m_searchBudget > 0)
+	{
+		candidate = initialCandidate;
+		c.assign(n, 0);
+		i = 1;
+		size_t evaluated = 0;
+		while (i < n && evaluated < m_searchBudget)
+		{
+			if (c[i] < i)
+			{
+				if (i & 1)
+					std::swap(candidate.front(), candidate[i]);
+				else
+					std::swap(candidate[c[i]], candidate[i]);
+				size_t cost = evaluate(candidate);
+				++evaluated;
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestCandidate = candidate;
+				}
+				++c[i];
+				i = 1;
+			}
+			else
+			{
+				c[i] = 0;
+				++i;
+			}
+		}
+		m_layout.maxSearchedCandidates = max(m_layout.maxSearchedCandidates, evaluated);
+	}
+
 	return commonPrefix + bestCandidate;
 }
 
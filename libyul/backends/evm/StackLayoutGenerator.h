@@ -42,6 +42,9 @@ struct StackLayout
 	/// - has the slots required for the operation at the stack top.
 	/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
 	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+	/// The largest number of candidate layouts evaluated by a single search when combining the
+	/// layouts required by the targets of a conditional jump. Never exceeds the search budget.
+	size_t maxSearchedCandidates = 0;
 };
 
 class StackLayoutGenerator
@@ -55,18 +58,24 @@ public:
 		std::vector<YulString> variableChoices;
 	};
 
-	static StackLayout run(CFG const& _cfg);
+	/// @param _parallelism maximum number of threads used to process the functions of @a _cfg.
+	/// Does not influence the result.
+	/// @param _searchBudget if nonzero, the maximum number of additional candidate layouts that are
+	/// evaluated when combining the layouts required by the targets of a conditional jump.
+	static StackLayout run(CFG const& _cfg, size_t _parallelism = 1, size_t _searchBudget = 0);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
-	static std::map<YulString, std::vector<StackTooDeep>> reportStackTooDeep(CFG const& _cfg);
+	/// @a _searchBudget has to be the budget the code will be generated with (see run), since
+	/// the layouts and thereby the errors depend on it.
+	static std::map<YulString, std::vector<StackTooDeep>> reportStackTooDeep(CFG const& _cfg, size_t _searchBudget = 0);
 	/// @returns all stack too deep errors in the function named @a _functionName.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// If @a _functionName is empty, the stack too deep errors of the main entry point are reported instead.
-	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName);
+	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName, size_t _searchBudget = 0);
 
 private:
-	StackLayoutGenerator(StackLayout& _context);
+	StackLayoutGenerator(StackLayout& _context, size_t _searchBudget = 0);
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
@@ -100,7 +109,9 @@ private:
 
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
-	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// Only a heuristic subset of the permutations of the slots is tried, unless a search budget is
+	/// set, in which case all permutations are enumerated until the budget is used up.
+	Stack combineStack(Stack const& _stack1, Stack const& _stack2) const;
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -112,6 +123,7 @@ private:
 	static Stack compressStack(Stack _stack);
 
 	StackLayout& m_layout;
+	size_t m_searchBudget = 0;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/LEB128.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -135,6 +136,21 @@ bytes toBytes(Opcode _o)
 	return toBytes(uint8_t(_o));
 }
 
+void append(bytes& _output, Opcode _o)
+{
+	_output.push_back(uint8_t(_o));
+}
+
+void append(bytes& _output, ValueType _vt)
+{
+	_output.push_back(uint8_t(_vt));
+}
+
+void append(bytes& _output, Section _s)
+{
+	_output.push_back(uint8_t(_s));
+}
+
 Opcode constOpcodeFor(ValueType _type)
 {
 	if (_type == ValueType::I32)
@@ -277,7 +293,7 @@ vector<pair<size_t, ValueType>> groupLocalVariables(vector<VariableDeclaration>
 
 }
 
-bytes BinaryTransform::run(Module const& _module)
+bytes BinaryTransform::run(Module const& _module, size_t _parallelism)
 {
 	map<Type, vector<string>> const types = typeToFunctionMap(_module.imports, _module.functions);
 
@@ -304,59 +320,58 @@ bytes BinaryTransform::run(Module const& _module)
 	for (auto const& [name, module]: _module.subModules)
 	{
 		// TODO should we prefix and / or shorten the name?
-		bytes data = BinaryTransform::run(module);
-		size_t const length = data.size();
-		ret += customSection(name, move(data));
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
+		bytes data = BinaryTransform::run(module, _parallelism);
+		subModulePosAndSize[name] = {appendCustomSection(ret, name, data), data.size()};
 	}
 	for (auto const& [name, data]: _module.customSections)
-	{
-		size_t const length = data.size();
-		ret += customSection(name, data);
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
-	}
-
-	BinaryTransform bt(
-		move(globalIDs),
-		move(functionIDs),
-		move(functionTypes),
-		move(subModulePosAndSize)
+		subModulePosAndSize[name] = {appendCustomSection(ret, name, data), data.size()};
+
+	appendCodeSection(
+		ret,
+		_module.functions,
+		globalIDs,
+		functionIDs,
+		functionTypes,
+		subModulePosAndSize,
+		_parallelism
 	);
-
-	ret += bt.codeSection(_module.functions);
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			append(m_code, Opcode::I32Const);
+			m_code += lebEncodeSigned(static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			append(m_code, Opcode::I64Const);
+			m_code += lebEncodeSigned(static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	append(m_code, Opcode::LocalGet);
+	m_code += lebEncode(m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	append(m_code, Opcode::GlobalGet);
+	m_code += lebEncode(m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -365,20 +380,24 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		append(m_code, Opcode::I64Const);
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		append(m_code, Opcode::I64Const);
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_code.push_back(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -387,103 +406,101 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_code += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	append(m_code, Opcode::Call);
+	m_code += lebEncode(m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	append(m_code, Opcode::LocalSet);
+	m_code += lebEncode(m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	append(m_code, Opcode::GlobalSet);
+	m_code += lebEncode(m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	append(m_code, Opcode::If);
+	append(m_code, ValueType::Void);
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		append(m_code, Opcode::Else);
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	append(m_code, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	append(m_code, Opcode::Loop);
+	append(m_code, ValueType::Void);
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	append(m_code, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	append(m_code, Opcode::Br);
+	m_code += encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	append(m_code, Opcode::BrIf);
+	m_code += encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	append(m_code, Opcode::Return);
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	append(m_code, Opcode::Block);
+	append(m_code, ValueType::Void);
+	visit(_block.statements);
+	append(m_code, Opcode::End);
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+bytes BinaryTransform::encodeFunction(FunctionDefinition const& _function)
 {
-	bytes ret;
+	m_code.clear();
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	m_code += lebEncode(localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		m_code += lebEncode(entry.first);
+		append(m_code, entry.second);
 	}
 
 	m_locals.clear();
@@ -495,12 +512,12 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	append(m_code, Opcode::End);
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(move(ret));
+	return prefixSize(move(m_code));
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -669,34 +686,57 @@ bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
 	return makeSection(Section::EXPORT, move(result));
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+size_t BinaryTransform::appendCustomSection(bytes& _output, string const& _name, bytes const& _data)
 {
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	bytes name = encodeName(_name);
+	_output.reserve(_output.size() + 1 + 10 + name.size() + _data.size());
+	append(_output, Section::CUSTOM);
+	_output += lebEncode(name.size() + _data.size());
+	_output += name;
+	size_t const offset = _output.size();
+	_output.insert(_output.end(), _data.begin(), _data.end());
+	return offset;
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+void BinaryTransform::appendCodeSection(
+	bytes& _output,
+	vector<wasm::FunctionDefinition> const& _functions,
+	map<string, size_t> const& _globalIDs,
+	map<string, size_t> const& _functionIDs,
+	map<string, size_t> const& _functionTypes,
+	map<string, pair<size_t, size_t>> const& _subModulePosAndSize,
+	size_t _parallelism
+)
 {
-	bytes result = lebEncode(_functions.size());
-	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
+	vector<bytes> encodedFunctions(_functions.size());
+	util::parallelForEach(_functions.size(), _parallelism, [&](size_t _index) {
+		BinaryTransform transform(_globalIDs, _functionIDs, _functionTypes, _subModulePosAndSize);
+		encodedFunctions[_index] = transform.encodeFunction(_functions[_index]);
+	});
+
+	bytes functionCount = lebEncode(_functions.size());
+	size_t sectionSize = functionCount.size();
+	for (bytes const& function: encodedFunctions)
+		sectionSize += function.size();
+
+	_output.reserve(_output.size() + 1 + 10 + sectionSize);
+	append(_output, Section::CODE);
+	_output += lebEncode(sectionSize);
+	_output += functionCount;
+	for (bytes const& function: encodedFunctions)
+		_output.insert(_output.end(), function.begin(), function.end());
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | ranges::views::reverse)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
 bytes BinaryTransform::encodeLabelIdx(string const& _label) const
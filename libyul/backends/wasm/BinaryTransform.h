@@ -33,39 +33,44 @@ namespace solidity::yul::wasm
 
 /**
  * Web assembly to binary transform.
+ *
+ * The code of each function is appended to a single buffer while visiting it, so that
+ * expressions are not copied again at every level of nesting. Functions are independent
+ * of each other and can be encoded in parallel.
  */
 class BinaryTransform
 {
 public:
-	static bytes run(Module const& _module);
-
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	/// @param _parallelism maximum number of threads used to encode the function bodies.
+	///        Does not affect the result.
+	static bytes run(Module const& _module, size_t _parallelism = 1);
+
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
 
 private:
 	BinaryTransform(
-		std::map<std::string, size_t> _globalIDs,
-		std::map<std::string, size_t> _functionIDs,
-		std::map<std::string, size_t> _functionTypes,
-		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
+		std::map<std::string, size_t> const& _globalIDs,
+		std::map<std::string, size_t> const& _functionIDs,
+		std::map<std::string, size_t> const& _functionTypes,
+		std::map<std::string, std::pair<size_t, size_t>> const& _subModulePosAndSize
 	):
-		m_globalIDs(std::move(_globalIDs)),
-		m_functionIDs(std::move(_functionIDs)),
-		m_functionTypes(std::move(_functionTypes)),
-		m_subModulePosAndSize(std::move(_subModulePosAndSize))
+		m_globalIDs(_globalIDs),
+		m_functionIDs(_functionIDs),
+		m_functionTypes(_functionTypes),
+		m_subModulePosAndSize(_subModulePosAndSize)
 	{}
 
 	using Type = std::pair<std::vector<std::uint8_t>, std::vector<std::uint8_t>>;
@@ -99,25 +104,39 @@ private:
 	static bytes memorySection();
 	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
 	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	/// Appends a custom section to @a _output and returns the offset of @a _data within it.
+	static size_t appendCustomSection(bytes& _output, std::string const& _name, bytes const& _data);
+	static void appendCodeSection(
+		bytes& _output,
+		std::vector<wasm::FunctionDefinition> const& _functions,
+		std::map<std::string, size_t> const& _globalIDs,
+		std::map<std::string, size_t> const& _functionIDs,
+		std::map<std::string, size_t> const& _functionTypes,
+		std::map<std::string, std::pair<size_t, size_t>> const& _subModulePosAndSize,
+		size_t _parallelism
+	);
+
+	/// @returns the size-prefixed encoding of the function.
+	bytes encodeFunction(wasm::FunctionDefinition const& _function);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
 
 	bytes encodeLabelIdx(std::string const& _label) const;
 
 	static bytes encodeName(std::string const& _name);
 
-	std::map<std::string, size_t> const m_globalIDs;
-	std::map<std::string, size_t> const m_functionIDs;
-	std::map<std::string, size_t> const m_functionTypes;
+	std::map<std::string, size_t> const& m_globalIDs;
+	std::map<std::string, size_t> const& m_functionIDs;
+	std::map<std::string, size_t> const& m_functionTypes;
 	/// The map of submodules, where the pair refers to the [offset, length]. The offset is
 	/// an absolute offset within the resulting assembled bytecode.
-	std::map<std::string, std::pair<size_t, size_t>> const m_subModulePosAndSize;
+	std::map<std::string, std::pair<size_t, size_t>> const& m_subModulePosAndSize;
 
 	std::map<std::string, size_t> m_locals;
 	std::vector<std::string> m_labels;
+	/// Code of the function being encoded.
+	bytes m_code;
 };
 
 }
@@ -31,6 +31,7 @@
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
@@ -45,6 +46,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <range/v3/view/map.hpp>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -63,10 +66,17 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+struct EVMToEwasmTranslator::Polyfill
+{
+	Block code;
+	std::set<YulString> functions;
+	/// Polyfill functions called by each polyfill function.
+	std::map<YulString, std::set<YulString>> calls;
+};
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	Polyfill const& polyfill = EVMToEwasmTranslator::polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -84,11 +94,30 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	MainFunction::run(context, ast);
 	ForLoopConditionIntoBody::run(context, ast);
 	ExpressionSplitter::run(context, ast);
-	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
+	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser, m_narrowValues);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill.functions}(ast);
+
+	set<YulString> requiredFunctions = polyfill.functions;
+	if (m_pruneUnusedPolyfill)
+	{
+		requiredFunctions.clear();
+		vector<YulString> toVisit;
+		for (auto const& calls: CallGraphGenerator::callGraph(ast).functionCalls | ranges::views::values)
+			for (YulString callee: calls)
+				if (polyfill.functions.count(callee))
+					toVisit.push_back(callee);
+		while (!toVisit.empty())
+		{
+			YulString function = toVisit.back();
+			toVisit.pop_back();
+			if (requiredFunctions.insert(function).second)
+				toVisit += polyfill.calls.at(function);
+		}
+	}
+	for (auto const& st: polyfill.code.statements)
+		if (requiredFunctions.count(std::get<FunctionDefinition>(st).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
 	ret.name = _object.name;
@@ -122,7 +151,14 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	return ret;
 }
 
-void EVMToEwasmTranslator::parsePolyfill()
+EVMToEwasmTranslator::Polyfill const& EVMToEwasmTranslator::polyfill()
+{
+	return YulStringRepository::instance().cached<Polyfill>("ewasmPolyfill", []() {
+		return parsePolyfill();
+	});
+}
+
+unique_ptr<EVMToEwasmTranslator::Polyfill> EVMToEwasmTranslator::parsePolyfill()
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
@@ -141,7 +177,7 @@ void EVMToEwasmTranslator::parsePolyfill()
 	// Passing an empty SourceLocation() here is a workaround to prevent a crash
 	// when compiling from yul->ewasm. We're stripping nativeLocation and
 	// originLocation from the AST (but we only really need to strip nativeLocation)
-	m_polyfill = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
 	if (!errors.empty())
 	{
 		string message;
@@ -153,7 +189,16 @@ void EVMToEwasmTranslator::parsePolyfill()
 		yulAssert(false, message);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	auto polyfill = make_unique<Polyfill>();
+	polyfill->code = move(*code);
+	for (auto const& statement: polyfill->code.statements)
+		polyfill->functions.insert(std::get<FunctionDefinition>(statement).name);
+	for (auto const& [function, callees]: CallGraphGenerator::callGraph(polyfill->code).functionCalls)
+		if (polyfill->functions.count(function))
+			for (YulString callee: callees)
+				if (polyfill->functions.count(callee))
+					polyfill->calls[function].insert(callee);
+	for (YulString function: polyfill->functions)
+		polyfill->calls[function];
+	return polyfill;
 }
@@ -36,20 +36,34 @@ struct Object;
 class EVMToEwasmTranslator: public ASTModifier
 {
 public:
-	EVMToEwasmTranslator(Dialect const& _evmDialect, langutil::CharStreamProvider const& _charStreamProvider):
+	/// @param _narrowValues if true, values that provably fit into 64 bits are not split
+	///        into four words (see WordSizeTransform).
+	/// @param _pruneUnusedPolyfill if true, only the polyfill functions called by the
+	///        translated code are added to it.
+	EVMToEwasmTranslator(
+		Dialect const& _evmDialect,
+		langutil::CharStreamProvider const& _charStreamProvider,
+		bool _narrowValues = false,
+		bool _pruneUnusedPolyfill = false
+	):
 		m_dialect(_evmDialect),
-		m_charStreamProvider(_charStreamProvider)
+		m_charStreamProvider(_charStreamProvider),
+		m_narrowValues(_narrowValues),
+		m_pruneUnusedPolyfill(_pruneUnusedPolyfill)
 	{}
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	struct Polyfill;
+
+	/// @returns the parsed polyfill, which is only parsed once per YulStringRepository.
+	static Polyfill const& polyfill();
+	static std::unique_ptr<Polyfill> parsePolyfill();
 
 	Dialect const& m_dialect;
 	langutil::CharStreamProvider const& m_charStreamProvider;
-
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
+	bool m_narrowValues = false;
+	bool m_pruneUnusedPolyfill = false;
 };
 
 }
@@ -166,11 +166,9 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 
 WasmDialect const& WasmDialect::instance()
 {
-	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
-	if (!dialect)
-		dialect = make_unique<WasmDialect>();
-	return *dialect;
+	return YulStringRepository::instance().cached<WasmDialect>("WasmDialect", []() {
+		return make_unique<WasmDialect>();
+	});
 }
 
 void WasmDialect::addExternals()
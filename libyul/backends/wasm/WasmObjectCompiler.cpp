@@ -34,11 +34,11 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace std;
 
-pair<string, bytes> WasmObjectCompiler::compile(Object& _object, Dialect const& _dialect)
+pair<string, bytes> WasmObjectCompiler::compile(Object& _object, Dialect const& _dialect, size_t _parallelism)
 {
 	WasmObjectCompiler compiler(_dialect);
 	wasm::Module module = compiler.run(_object);
-	return {wasm::TextTransform().run(module), wasm::BinaryTransform::run(module)};
+	return {wasm::TextTransform().run(module), wasm::BinaryTransform::run(module, _parallelism)};
 }
 
 wasm::Module WasmObjectCompiler::run(Object& _object)
@@ -39,7 +39,8 @@ class WasmObjectCompiler
 {
 public:
 	/// Compiles the given object and returns the Wasm text and binary representation.
-	static std::pair<std::string, bytes> compile(Object& _object, Dialect const& _dialect);
+	/// @param _parallelism maximum number of threads used to encode the binary representation.
+	static std::pair<std::string, bytes> compile(Object& _object, Dialect const& _dialect, size_t _parallelism = 1);
 private:
 	WasmObjectCompiler(Dialect const& _dialect):
 		m_dialect(_dialect)
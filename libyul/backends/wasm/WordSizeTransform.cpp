@@ -24,6 +24,7 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <variant>
@@ -34,6 +35,96 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Collects the values assigned to each variable.
+class VariableDefinitions: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(FunctionDefinition const& _function) override
+	{
+		for (TypedName const& parameter: _function.parameters)
+			excluded.insert(parameter.name);
+		for (TypedName const& returnVariable: _function.returnVariables)
+			excluded.insert(returnVariable.name);
+		ASTWalker::operator()(_function);
+	}
+
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (TypedName const& variable: _varDecl.variables)
+		{
+			variables.insert(variable.name);
+			if (_varDecl.value && _varDecl.variables.size() > 1)
+				excluded.insert(variable.name);
+			else if (_varDecl.value)
+				values[variable.name].push_back(_varDecl.value.get());
+		}
+		ASTWalker::operator()(_varDecl);
+	}
+
+	void operator()(Assignment const& _assignment) override
+	{
+		for (Identifier const& variable: _assignment.variableNames)
+			if (_assignment.variableNames.size() > 1)
+				excluded.insert(variable.name);
+			else
+				values[variable.name].push_back(_assignment.value.get());
+		ASTWalker::operator()(_assignment);
+	}
+
+	std::set<YulString> variables;
+	/// Variables that are assigned values not visible here, e.g. function parameters.
+	std::set<YulString> excluded;
+	std::map<YulString, std::vector<Expression const*>> values;
+};
+
+bool fitsIntoWord(Literal const& _literal)
+{
+	return valueOfLiteral(_literal) <= std::numeric_limits<uint64_t>::max();
+}
+
+/// @returns true if the value of @a _expression is below 2**64 provided that the values of
+/// @a _narrowVariables are.
+bool isNarrowValue(Dialect const& _dialect, Expression const& _expression, set<YulString> const& _narrowVariables)
+{
+	auto isNarrowArgument = [&](Expression const& _argument) {
+		return isNarrowValue(_dialect, _argument, _narrowVariables);
+	};
+
+	if (holds_alternative<Literal>(_expression))
+		return fitsIntoWord(std::get<Literal>(_expression));
+	else if (holds_alternative<Identifier>(_expression))
+		return _narrowVariables.count(std::get<Identifier>(_expression).name);
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	if (!_dialect.builtin(call.functionName.name))
+		return false;
+
+	static set<string> const alwaysNarrow{
+		"lt", "gt", "slt", "sgt", "eq", "iszero", "byte",
+		"datasize", "dataoffset",
+		"calldatasize", "codesize", "extcodesize", "returndatasize", "msize",
+	};
+	string const& name = call.functionName.name.str();
+	if (alwaysNarrow.count(name))
+		return true;
+	else if (name == "and")
+		return any_of(call.arguments.begin(), call.arguments.end(), isNarrowArgument);
+	else if (name == "or" || name == "xor")
+		return all_of(call.arguments.begin(), call.arguments.end(), isNarrowArgument);
+	else if (name == "shr" || name == "div")
+		return isNarrowArgument(call.arguments.at(name == "shr" ? 1 : 0));
+	else if (name == "mod")
+		return isNarrowArgument(call.arguments.at(0)) || isNarrowArgument(call.arguments.at(1));
+	return false;
+}
+
+}
+
 void WordSizeTransform::operator()(FunctionDefinition& _fd)
 {
 	rewriteVarDeclList(_fd.parameters);
@@ -104,6 +195,12 @@ void WordSizeTransform::operator()(Block& _block)
 					rewriteVarDeclList(varDecl.variables);
 				else if (holds_alternative<FunctionCall>(*varDecl.value))
 				{
+					if (unique_ptr<Expression> lowWord = nativeLowWord(std::get<FunctionCall>(*varDecl.value)))
+					{
+						yulAssert(varDecl.variables.size() == 1, "");
+						return lowWordDeclaration(varDecl, std::move(lowWord));
+					}
+
 					visit(*varDecl.value);
 
 					// Special handling for datasize and dataoffset - they will only need one variable.
@@ -113,25 +210,7 @@ void WordSizeTransform::operator()(Block& _block)
 							yulAssert(f->literalArguments.size() == 1, "");
 							yulAssert(f->literalArguments.at(0) == LiteralKind::String, "");
 							yulAssert(varDecl.variables.size() == 1, "");
-							auto newLhs = generateU64IdentifierNames(varDecl.variables[0].name);
-							vector<Statement> ret;
-							for (size_t i = 0; i < 3; i++)
-								ret.emplace_back(VariableDeclaration{
-									varDecl.debugData,
-									{TypedName{varDecl.debugData, newLhs[i], m_targetDialect.defaultType}},
-									make_unique<Expression>(Literal{
-										debugDataOf(*varDecl.value),
-										LiteralKind::Number,
-										"0"_yulstring,
-										m_targetDialect.defaultType
-									})
-								});
-							ret.emplace_back(VariableDeclaration{
-								varDecl.debugData,
-								{TypedName{varDecl.debugData, newLhs[3], m_targetDialect.defaultType}},
-								std::move(varDecl.value)
-							});
-							return {std::move(ret)};
+							return lowWordDeclaration(varDecl, std::move(varDecl.value));
 						}
 
 					rewriteVarDeclList(varDecl.variables);
@@ -165,6 +244,12 @@ void WordSizeTransform::operator()(Block& _block)
 
 				if (holds_alternative<FunctionCall>(*assignment.value))
 				{
+					if (unique_ptr<Expression> lowWord = nativeLowWord(std::get<FunctionCall>(*assignment.value)))
+					{
+						yulAssert(assignment.variableNames.size() == 1, "");
+						return lowWordAssignment(assignment, std::move(lowWord));
+					}
+
 					visit(*assignment.value);
 
 					// Special handling for datasize and dataoffset - they will only need one variable.
@@ -174,25 +259,7 @@ void WordSizeTransform::operator()(Block& _block)
 							yulAssert(f->literalArguments.size() == 1, "");
 							yulAssert(f->literalArguments[0] == LiteralKind::String, "");
 							yulAssert(assignment.variableNames.size() == 1, "");
-							auto newLhs = generateU64IdentifierNames(assignment.variableNames[0].name);
-							vector<Statement> ret;
-							for (size_t i = 0; i < 3; i++)
-								ret.emplace_back(Assignment{
-									assignment.debugData,
-									{Identifier{assignment.debugData, newLhs[i]}},
-									make_unique<Expression>(Literal{
-										debugDataOf(*assignment.value),
-										LiteralKind::Number,
-										"0"_yulstring,
-										m_targetDialect.defaultType
-									})
-								});
-							ret.emplace_back(Assignment{
-								assignment.debugData,
-								{Identifier{assignment.debugData, newLhs[3]}},
-								std::move(assignment.value)
-							});
-							return {std::move(ret)};
+							return lowWordAssignment(assignment, std::move(assignment.value));
 						}
 
 					rewriteIdentifierList(assignment.variableNames);
@@ -232,22 +299,62 @@ void WordSizeTransform::run(
 	Dialect const& _inputDialect,
 	Dialect const& _targetDialect,
 	Block& _ast,
-	NameDispenser& _nameDispenser
+	NameDispenser& _nameDispenser,
+	bool _narrowValues
 )
 {
 	// Free the name `or_bool`.
 	NameDisplacer{_nameDispenser, {"or_bool"_yulstring}}(_ast);
-	WordSizeTransform{_inputDialect, _targetDialect, _nameDispenser}(_ast);
+	set<YulString> narrow = _narrowValues ? narrowVariables(_inputDialect, _ast) : set<YulString>{};
+	WordSizeTransform{_inputDialect, _targetDialect, _nameDispenser, _narrowValues, std::move(narrow)}(_ast);
+}
+
+set<YulString> WordSizeTransform::narrowVariables(Dialect const& _dialect, Block const& _ast)
+{
+	VariableDefinitions definitions;
+	definitions(_ast);
+
+	// Start with all candidates and remove variables that might be assigned a wider value until
+	// nothing changes. Since values can only become wide through one of the assignments, the
+	// remaining variables are narrow.
+	set<YulString> narrow;
+	for (YulString variable: definitions.variables)
+		if (!definitions.excluded.count(variable))
+			narrow.insert(variable);
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto it = narrow.begin(); it != narrow.end();)
+		{
+			vector<Expression const*> const& values = definitions.values[*it];
+			if (any_of(values.begin(), values.end(), [&](Expression const* _value) {
+				return !isNarrowValue(_dialect, *_value, narrow);
+			}))
+			{
+				it = narrow.erase(it);
+				changed = true;
+			}
+			else
+				++it;
+		}
+	}
+	return narrow;
 }
 
 WordSizeTransform::WordSizeTransform(
 	Dialect const& _inputDialect,
 	Dialect const& _targetDialect,
-	NameDispenser& _nameDispenser
+	NameDispenser& _nameDispenser,
+	bool _narrowValues,
+	set<YulString> _narrowVariables
 ):
 	m_inputDialect(_inputDialect),
 	m_targetDialect(_targetDialect),
-	m_nameDispenser(_nameDispenser)
+	m_nameDispenser(_nameDispenser),
+	m_narrowValues(_narrowValues),
+	m_narrowVariables(std::move(_narrowVariables))
 {
 }
 
@@ -362,9 +469,11 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 			{}
 		});
 	}
+	// The words of narrow variables are not replaced by literals here because the nested
+	// switches need an expression at every level.
 	vector<YulString> splitExpressions;
-	for (auto const& expr: expandValue(*_switch.expression))
-		splitExpressions.emplace_back(std::get<Identifier>(*expr).name);
+	for (YulString name: m_variableMapping.at(std::get<Identifier>(*_switch.expression).name))
+		splitExpressions.emplace_back(name);
 
 	ret += handleSwitchInternal(
 		_switch.debugData,
@@ -397,8 +506,14 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 	if (holds_alternative<Identifier>(_e))
 	{
 		auto const& id = std::get<Identifier>(_e);
+		bool const narrow = m_narrowVariables.count(id.name);
 		for (size_t i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.debugData, m_variableMapping.at(id.name)[i]});
+			if (narrow && i < 3)
+				ret[i] = make_unique<Expression>(
+					Literal{id.debugData, LiteralKind::Number, "0"_yulstring, m_targetDialect.defaultType}
+				);
+			else
+				ret[i] = make_unique<Expression>(Identifier{id.debugData, m_variableMapping.at(id.name)[i]});
 	}
 	else if (holds_alternative<Literal>(_e))
 	{
@@ -431,3 +546,130 @@ vector<Expression> WordSizeTransform::expandValueToVector(Expression const& _e)
 		ret.emplace_back(std::move(*val));
 	return ret;
 }
+
+unique_ptr<Expression> WordSizeTransform::nativeLowWord(FunctionCall const& _call)
+{
+	if (!m_narrowValues || !m_inputDialect.builtin(_call.functionName.name))
+		return nullptr;
+
+	struct NativeOperation
+	{
+		char const* name;
+		/// Whether the operation returns a boolean that has to be extended to a word.
+		bool comparison;
+		/// Whether a single narrow argument suffices instead of all arguments being narrow.
+		bool anyArgument;
+	};
+	// The names are kept as strings, since YulStrings are only valid for the current repository.
+	static map<string, NativeOperation> const operations{
+		// Narrow values are never negative, so signed comparisons can use unsigned ones.
+		{"lt", {"i64.lt_u", true, false}},
+		{"slt", {"i64.lt_u", true, false}},
+		{"gt", {"i64.gt_u", true, false}},
+		{"sgt", {"i64.gt_u", true, false}},
+		{"eq", {"i64.eq", true, false}},
+		{"iszero", {"i64.eqz", true, false}},
+		{"and", {"i64.and", false, true}},
+		{"or", {"i64.or", false, false}},
+		{"xor", {"i64.xor", false, false}},
+	};
+	YulString const extend{"i64.extend_i32_u"};
+
+	auto operation = operations.find(_call.functionName.name.str());
+	if (operation == operations.end())
+		return nullptr;
+	YulString const name{operation->second.name};
+	if (
+		!m_targetDialect.builtin(name) ||
+		(operation->second.comparison && !m_targetDialect.builtin(extend))
+	)
+		return nullptr;
+
+	for (Expression const& argument: _call.arguments)
+		if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+			return nullptr;
+	auto isNarrowArgument = [&](Expression const& _argument) { return isNarrow(_argument); };
+	if (operation->second.anyArgument ?
+		none_of(_call.arguments.begin(), _call.arguments.end(), isNarrowArgument) :
+		!all_of(_call.arguments.begin(), _call.arguments.end(), isNarrowArgument)
+	)
+		return nullptr;
+
+	vector<Expression> lowWords;
+	for (Expression const& argument: _call.arguments)
+		lowWords.emplace_back(std::move(*expandValue(argument)[3]));
+
+	auto result = make_unique<Expression>(FunctionCall{
+		_call.debugData,
+		Identifier{_call.debugData, name},
+		std::move(lowWords)
+	});
+	if (operation->second.comparison)
+		result = make_unique<Expression>(FunctionCall{
+			_call.debugData,
+			Identifier{_call.debugData, extend},
+			make_vector<Expression>(std::move(*result))
+		});
+	return result;
+}
+
+bool WordSizeTransform::isNarrow(Expression const& _e) const
+{
+	if (holds_alternative<Literal>(_e))
+		return fitsIntoWord(std::get<Literal>(_e));
+	else if (holds_alternative<Identifier>(_e))
+		return m_narrowVariables.count(std::get<Identifier>(_e).name);
+	return false;
+}
+
+vector<Statement> WordSizeTransform::lowWordDeclaration(
+	VariableDeclaration const& _varDecl,
+	unique_ptr<Expression> _lowWord
+)
+{
+	auto newLhs = generateU64IdentifierNames(_varDecl.variables[0].name);
+	vector<Statement> ret;
+	for (size_t i = 0; i < 3; i++)
+		ret.emplace_back(VariableDeclaration{
+			_varDecl.debugData,
+			{TypedName{_varDecl.debugData, newLhs[i], m_targetDialect.defaultType}},
+			make_unique<Expression>(Literal{
+				debugDataOf(*_lowWord),
+				LiteralKind::Number,
+				"0"_yulstring,
+				m_targetDialect.defaultType
+			})
+		});
+	ret.emplace_back(VariableDeclaration{
+		_varDecl.debugData,
+		{TypedName{_varDecl.debugData, newLhs[3], m_targetDialect.defaultType}},
+		std::move(_lowWord)
+	});
+	return ret;
+}
+
+vector<Statement> WordSizeTransform::lowWordAssignment(
+	Assignment const& _assignment,
+	unique_ptr<Expression> _lowWord
+)
+{
+	auto const& newLhs = m_variableMapping.at(_assignment.variableNames[0].name);
+	vector<Statement> ret;
+	for (size_t i = 0; i < 3; i++)
+		ret.emplace_back(Assignment{
+			_assignment.debugData,
+			{Identifier{_assignment.debugData, newLhs[i]}},
+			make_unique<Expression>(Literal{
+				debugDataOf(*_lowWord),
+				LiteralKind::Number,
+				"0"_yulstring,
+				m_targetDialect.defaultType
+			})
+		});
+	ret.emplace_back(Assignment{
+		_assignment.debugData,
+		{Identifier{_assignment.debugData, newLhs[3]}},
+		std::move(_lowWord)
+	});
+	return ret;
+}
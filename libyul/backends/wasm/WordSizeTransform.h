@@ -27,6 +27,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <array>
+#include <set>
 #include <vector>
 
 namespace solidity::yul
@@ -56,6 +57,13 @@ namespace solidity::yul
  * takes four u64 parameters and is supposed to return the logical disjunction
  * of them as a i32 value. If this name is already used somewhere, it is renamed.
  *
+ * If requested, the stage first determines which variables provably always hold values that
+ * fit into 64 bits, e.g. comparison results, lengths and variables only assigned such values.
+ * Their three most significant words are known to be zero and are replaced by literals wherever
+ * the variables are used. Comparisons and bitwise operations on such values are translated to
+ * single 64 bit operations of the target dialect (if it provides them) instead of calls to the
+ * 256 bit builtins.
+ *
  * Prerequisite: Disambiguator, ForLoopConditionIntoBody, ExpressionSplitter
  */
 class WordSizeTransform: public ASTModifier
@@ -68,18 +76,27 @@ public:
 	void operator()(ForLoop&) override;
 	void operator()(Block& _block) override;
 
+	/// @param _narrowValues if true, values that provably fit into 64 bits are treated as
+	///        single words (see above).
 	static void run(
 		Dialect const& _inputDialect,
 		Dialect const& _targetDialect,
 		Block& _ast,
-		NameDispenser& _nameDispenser
+		NameDispenser& _nameDispenser,
+		bool _narrowValues = false
 	);
 
+	/// @returns the variables of @a _ast that provably only ever hold values below 2**64.
+	/// Function parameters and return variables are never included.
+	static std::set<YulString> narrowVariables(Dialect const& _dialect, Block const& _ast);
+
 private:
 	explicit WordSizeTransform(
 		Dialect const& _inputDialect,
 		Dialect const& _targetDialect,
-		NameDispenser& _nameDispenser
+		NameDispenser& _nameDispenser,
+		bool _narrowValues,
+		std::set<YulString> _narrowVariables
 	);
 
 	void rewriteVarDeclList(std::vector<TypedName>&);
@@ -98,11 +115,21 @@ private:
 	std::array<std::unique_ptr<Expression>, 4> expandValue(Expression const& _e);
 	std::vector<Expression> expandValueToVector(Expression const& _e);
 
+	/// @returns the single 64 bit operation computing the least significant word of the result
+	/// of @a _call, whose other words are zero, or nullptr if there is none.
+	std::unique_ptr<Expression> nativeLowWord(FunctionCall const& _call);
+	bool isNarrow(Expression const& _e) const;
+	std::vector<Statement> lowWordDeclaration(VariableDeclaration const& _varDecl, std::unique_ptr<Expression> _lowWord);
+	std::vector<Statement> lowWordAssignment(Assignment const& _assignment, std::unique_ptr<Expression> _lowWord);
+
 	Dialect const& m_inputDialect;
 	Dialect const& m_targetDialect;
 	NameDispenser& m_nameDispenser;
 	/// maps original u256 variable's name to corresponding u64 variables' names
 	std::map<YulString, std::array<YulString, 4>> m_variableMapping;
+	bool const m_narrowValues;
+	/// original u256 variables whose three most significant words are always zero
+	std::set<YulString> const m_narrowVariables;
 };
 
 }
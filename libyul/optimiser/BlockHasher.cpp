@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -33,7 +35,7 @@ namespace
 {
 static constexpr uint64_t compileTimeLiteralHash(char const* _literal, size_t _n)
 {
-	return (_n == 0) ? BlockHasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * BlockHasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
+	return (_n == 0) ? HasherBase::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * HasherBase::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
 }
 
 template<size_t N>
@@ -51,6 +53,32 @@ std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 	return result;
 }
 
+uint64_t BlockHasher::functionHash(FunctionDefinition const& _function)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher hasher(blockHashes);
+	hasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hasher.hash64(_function.parameters.size());
+	hasher.hash64(_function.returnVariables.size());
+	for (auto const* variables: {&_function.parameters, &_function.returnVariables})
+		for (auto const& variable: *variables)
+		{
+			hasher.hash64(variable.type.hash());
+			hasher.m_variableReferences[variable.name] = VariableReference{
+				hasher.m_internalIdentifierCount++,
+				false
+			};
+		}
+
+	// The statements are visited directly, such that references to parameters
+	// and return variables are hashed by their position instead of the
+	// order of their first reference.
+	hasher.hash64(_function.body.statements.size());
+	for (auto const& statement: _function.body.statements)
+		hasher.visit(statement);
+	return hasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -192,3 +220,185 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ExpressionHasher::run(Expression const& _e)
+{
+	ExpressionHasher hasher;
+	hasher.visit(_e);
+	return hasher.m_hash;
+}
+
+uint64_t ExpressionHash::operator()(Expression const& _expression) const
+{
+	return ExpressionHasher::run(_expression);
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	// Number literals are compared by value, so e.g. 0x10 and 16 have to have the same hash.
+	if (_literal.kind == LiteralKind::Number)
+		for (u256 value = valueOfNumberLiteral(_literal); value != 0; value >>= 64)
+			hash64(static_cast<uint64_t>(value & u256(numeric_limits<uint64_t>::max())));
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+uint64_t ASTHasher::run(Block const& _block)
+{
+	ASTHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hashNode(compileTimeLiteralHash("Literal"), _literal.debugData);
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash64(static_cast<uint64_t>(_literal.kind));
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	hashNode(compileTimeLiteralHash("Identifier"), _identifier.debugData);
+	hash64(_identifier.name.hash());
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hashNode(compileTimeLiteralHash("FunctionCall"), _funCall.debugData);
+	(*this)(_funCall.functionName);
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hashNode(compileTimeLiteralHash("ExpressionStatement"), _statement.debugData);
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hashNode(compileTimeLiteralHash("Assignment"), _assignment.debugData);
+	hash64(_assignment.variableNames.size());
+	ASTWalker::operator()(_assignment);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hashNode(compileTimeLiteralHash("VariableDeclaration"), _varDecl.debugData);
+	hashTypedNames(_varDecl.variables);
+	hash64(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hashNode(compileTimeLiteralHash("If"), _if.debugData);
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hashNode(compileTimeLiteralHash("Switch"), _switch.debugData);
+	visit(*_switch.expression);
+	hash64(_switch.cases.size());
+	for (Case const& _case: _switch.cases)
+	{
+		hashNode(compileTimeLiteralHash("Case"), _case.debugData);
+		hash64(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hashNode(compileTimeLiteralHash("FunctionDefinition"), _funDef.debugData);
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	ASTWalker::operator()(_funDef);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hashNode(compileTimeLiteralHash("ForLoop"), _loop.debugData);
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const& _break)
+{
+	hashNode(compileTimeLiteralHash("Break"), _break.debugData);
+}
+
+void ASTHasher::operator()(Continue const& _continue)
+{
+	hashNode(compileTimeLiteralHash("Continue"), _continue.debugData);
+}
+
+void ASTHasher::operator()(Leave const& _leaveStatement)
+{
+	hashNode(compileTimeLiteralHash("Leave"), _leaveStatement.debugData);
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hashNode(compileTimeLiteralHash("Block"), _block.debugData);
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::hashNode(uint64_t _kind, shared_ptr<DebugData const> const& _debugData)
+{
+	hash64(_kind);
+	if (!_debugData)
+	{
+		hash64(0);
+		return;
+	}
+	for (langutil::SourceLocation const* location: {&_debugData->nativeLocation, &_debugData->originLocation})
+	{
+		hash64(static_cast<uint64_t>(location->start));
+		hash64(static_cast<uint64_t>(location->end));
+		if (location->sourceName)
+		{
+			hash64(location->sourceName->size() + 1);
+			for (char c: *location->sourceName)
+				hash8(static_cast<uint8_t>(c));
+		}
+		else
+			hash64(0);
+	}
+	hash64(_debugData->astID ? static_cast<uint64_t>(*_debugData->astID) + 1 : 0);
+}
+
+void ASTHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hashNode(compileTimeLiteralHash("TypedName"), name.debugData);
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
@@ -27,6 +27,40 @@
 namespace solidity::yul
 {
 
+/**
+ * Base class for the FNV-based hashers below.
+ */
+class HasherBase
+{
+public:
+	static constexpr uint64_t fnvPrime = 1099511628211u;
+	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+
+protected:
+	void hash8(uint8_t _value)
+	{
+		m_hash *= fnvPrime;
+		m_hash ^= _value;
+	}
+	void hash16(uint16_t _value)
+	{
+		hash8(static_cast<uint8_t>(_value & 0xFF));
+		hash8(static_cast<uint8_t>(_value >> 8));
+	}
+	void hash32(uint32_t _value)
+	{
+		hash16(static_cast<uint16_t>(_value & 0xFFFF));
+		hash16(static_cast<uint16_t>(_value >> 16));
+	}
+	void hash64(uint64_t _value)
+	{
+		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
+		hash32(static_cast<uint32_t>(_value >> 32));
+	}
+
+	uint64_t m_hash = fnvEmptyHash;
+};
+
 /**
  * Optimiser component that calculates hash values for blocks.
  * Syntactically equal blocks will have identical hashes and
@@ -41,7 +75,7 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
-class BlockHasher: public ASTWalker
+class BlockHasher: public ASTWalker, public HasherBase
 {
 public:
 
@@ -64,36 +98,18 @@ public:
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
 
-	static constexpr uint64_t fnvPrime = 1099511628211u;
-	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+	/// @returns a hash value for the function that is invariant under renaming of its
+	/// parameters, return variables and local variables. In contrast to the hash of its body,
+	/// parameters and return variables are identified by their position, so syntactically
+	/// equal functions have identical hashes and functions with equal hashes are very likely
+	/// syntactically equal.
+	static uint64_t functionHash(FunctionDefinition const& _function);
 
 private:
 	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
 
-	void hash8(uint8_t _value)
-	{
-		m_hash *= fnvPrime;
-		m_hash ^= _value;
-	}
-	void hash16(uint16_t _value)
-	{
-		hash8(static_cast<uint8_t>(_value & 0xFF));
-		hash8(static_cast<uint8_t>(_value >> 8));
-	}
-	void hash32(uint32_t _value)
-	{
-		hash16(static_cast<uint16_t>(_value & 0xFFFF));
-		hash16(static_cast<uint16_t>(_value >> 16));
-	}
-	void hash64(uint64_t _value)
-	{
-		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
-		hash32(static_cast<uint32_t>(_value >> 32));
-	}
-
 	std::map<Block const*, uint64_t>& m_blockHashes;
 
-	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
 	{
 		size_t id = 0;
@@ -105,5 +121,68 @@ private:
 	size_t m_internalIdentifierCount = 0;
 };
 
+/**
+ * Calculates a hash value for an expression that is consistent with SyntacticallyEqual
+ * when comparing expressions only: syntactically equal expressions have identical hashes.
+ * In contrast to the BlockHasher, the names of all identifiers are taken into account.
+ */
+class ExpressionHasher: public ASTWalker, public HasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+	static uint64_t run(Expression const& _e);
+
+private:
+	ExpressionHasher() = default;
+};
+
+/// Hash function object for expressions based on ExpressionHasher, e.g. for use in
+/// unordered containers together with SyntacticallyEqualExpression.
+struct ExpressionHash
+{
+	uint64_t operator()(Expression const& _expression) const;
+};
+
+/**
+ * Calculates a single hash value for an AST that, in contrast to the BlockHasher,
+ * takes all details into account, including names and debug information.
+ * Source names are hashed by their contents, so the hash does not depend on where they are stored.
+ * Equal ASTs will have identical hashes and ASTs with equal hashes will very likely
+ * be equal. Can be used to detect whether an AST was modified.
+ */
+class ASTHasher: public ASTWalker, public HasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	static uint64_t run(Block const& _block);
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+private:
+	ASTHasher() = default;
+
+	void hashNode(uint64_t _kind, std::shared_ptr<DebugData const> const& _debugData);
+	void hashTypedNames(std::vector<TypedName> const& _names);
+};
+
 
 }
@@ -22,52 +22,48 @@
 #include <libyul/AST.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 
-#include <stack>
+#include <libsolutil/Algorithms.h>
+#include <libsolutil/CommonData.h>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
-namespace
-{
-// TODO: This algorithm is non-optimal.
-struct CallGraphCycleFinder
+set<YulString> CallGraph::recursiveFunctions() const
 {
-	CallGraph const& callGraph;
-	set<YulString> containedInCycle{};
-	set<YulString> visited{};
-	vector<YulString> currentPath{};
-
-	void visit(YulString _function)
-	{
-		if (visited.count(_function))
-			return;
-		if (
-			auto it = find(currentPath.begin(), currentPath.end(), _function);
-			it != currentPath.end()
-		)
-			containedInCycle.insert(it, currentPath.end());
-		else
-		{
-			currentPath.emplace_back(_function);
-			if (callGraph.functionCalls.count(_function))
-				for (auto const& child: callGraph.functionCalls.at(_function))
-					visit(child);
-			currentPath.pop_back();
-			visited.insert(_function);
-		}
-	}
-};
+	set<YulString> recursiveFunctions;
+	for (vector<YulString> const& component: stronglyConnectedComponents())
+		if (component.size() > 1 || functionCalls.at(component.front()).count(component.front()))
+			recursiveFunctions.insert(component.begin(), component.end());
+	return recursiveFunctions;
 }
 
-set<YulString> CallGraph::recursiveFunctions() const
+vector<vector<YulString>> CallGraph::stronglyConnectedComponents() const
 {
-	CallGraphCycleFinder cycleFinder{*this};
-	// Visiting the root only is not enough, since there may be disconnected recursive functions.
+	// Dense integer IDs of the functions in the order of their names.
+	vector<YulString> functions;
+	map<YulString, size_t> functionIDs;
 	for (auto const& call: functionCalls)
-		cycleFinder.visit(call.first);
-	return cycleFinder.containedInCycle;
+	{
+		functionIDs[call.first] = functions.size();
+		functions.emplace_back(call.first);
+	}
+
+	vector<vector<size_t>> successors(functions.size());
+	for (auto const& [function, callees]: functionCalls)
+		for (YulString callee: callees)
+			if (auto const* id = util::valueOrNullptr(functionIDs, callee))
+				successors[functionIDs.at(function)].emplace_back(*id);
+
+	vector<vector<YulString>> components;
+	for (vector<size_t> const& component: util::stronglyConnectedComponents(successors))
+	{
+		components.emplace_back();
+		for (size_t id: component)
+			components.back().emplace_back(functions[id]);
+	}
+	return components;
 }
 
 CallGraph CallGraphGenerator::callGraph(Block const& _ast)
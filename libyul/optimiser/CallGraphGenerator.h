@@ -26,6 +26,7 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -38,6 +39,10 @@ struct CallGraph
 	/// functions that are part of a (mutual) recursion.
 	/// Note that this does not include functions that merely call recursive functions.
 	std::set<YulString> recursiveFunctions() const;
+	/// @returns the strongly connected components of the call graph between the functions
+	/// in @a functionCalls, in reverse topological order, i.e. each component comes after
+	/// all components containing functions it calls. Calls to other functions are ignored.
+	std::vector<std::vector<YulString>> stronglyConnectedComponents() const;
 };
 
 /**
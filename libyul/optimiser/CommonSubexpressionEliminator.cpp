@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
@@ -30,6 +31,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Profiler.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -37,11 +40,11 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	visitFunctionsInParallel(_context, _ast, [&]() {
+		return CommonSubexpressionEliminator{_context.dialect, functionSideEffects};
+	});
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
@@ -100,28 +103,40 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 			assertThrow(m_value.at(identifierName).value, OptimizerException, "");
 			if (Identifier const* value = get_if<Identifier>(m_value.at(identifierName).value))
 				if (inScope(value->name))
+				{
+					SOL_OPTIMIZER_COUNT("commonSubexpressionEliminator/identifier");
 					_e = Identifier{debugDataOf(_e), value->name};
+				}
 		}
 	}
-	else
-	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
+	else if (auto candidates = m_replacementCandidates.find(_e); candidates != m_replacementCandidates.end())
+		for (YulString variable: candidates->second)
 		{
-			assertThrow(value.value, OptimizerException, "");
+			auto value = m_value.find(variable);
+			if (value == m_value.end())
+				continue;
+			assertThrow(value->second.value, OptimizerException, "");
 			// Prevent using the default value of return variables
 			// instead of literal zeros.
 			if (
 				m_returnVariables.count(variable) &&
-				holds_alternative<Literal>(*value.value) &&
-				valueOfLiteral(get<Literal>(*value.value)) == 0
+				holds_alternative<Literal>(*value->second.value) &&
+				valueOfLiteral(get<Literal>(*value->second.value)) == 0
 			)
 				continue;
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+			// The value of the variable might have changed since it was added as a candidate.
+			if (SyntacticallyEqual{}(_e, *value->second.value) && inScope(variable))
 			{
+				SOL_OPTIMIZER_COUNT("commonSubexpressionEliminator/expression");
 				_e = Identifier{debugDataOf(_e), variable};
 				break;
 			}
 		}
-	}
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	if (_value)
+		m_replacementCandidates[*_value].insert(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
 }
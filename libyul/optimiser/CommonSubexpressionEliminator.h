@@ -22,10 +22,14 @@
 
 #pragma once
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 
+#include <functional>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -58,8 +62,18 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
+	void assignValue(YulString _variable, Expression const* _value) override;
+
 private:
 	std::set<YulString> m_returnVariables;
+	/// Variables by the expressions that were assigned to them. The values of the variables
+	/// may have changed since, so they still have to be checked against m_value.
+	std::unordered_map<
+		std::reference_wrapper<Expression const>,
+		std::set<YulString>,
+		ExpressionHash,
+		SyntacticallyEqualExpression
+	> m_replacementCandidates;
 };
 
 }
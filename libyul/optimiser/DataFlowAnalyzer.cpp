@@ -24,13 +24,13 @@
 
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 #include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <variant>
 
@@ -41,12 +41,175 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+void JournaledVariableMap::set(YulString _key, YulString _value)
+{
+	auto [it, inserted] = m_map.try_emplace(_key, _value);
+	if (inserted)
+		record(_key, nullopt);
+	else if (it->second != _value)
+	{
+		record(_key, it->second);
+		it->second = _value;
+	}
+}
+
+void JournaledVariableMap::erase(YulString _key)
+{
+	auto it = m_map.find(_key);
+	if (it == m_map.end())
+		return;
+	record(_key, it->second);
+	m_map.erase(it);
+}
+
+void JournaledVariableMap::clear()
+{
+	if (m_activeCheckpoints > 0)
+		for (auto const& [key, value]: m_map)
+			record(key, value);
+	m_map.clear();
+}
+
+void JournaledVariableMap::joinWithCheckpoint(size_t _checkpoint)
+{
+	yulAssert(m_activeCheckpoints > 0 && _checkpoint <= m_journal.size(), "");
+
+	// The first journal entry of a key after the checkpoint contains its value at the checkpoint.
+	unordered_map<YulString, optional<YulString>> valuesAtCheckpoint;
+	for (size_t i = _checkpoint; i < m_journal.size(); ++i)
+		valuesAtCheckpoint.try_emplace(m_journal[i].first, m_journal[i].second);
+
+	--m_activeCheckpoints;
+	for (auto const& [key, oldValue]: valuesAtCheckpoint)
+		if (auto it = m_map.find(key); it != m_map.end() && (!oldValue || *oldValue != it->second))
+		{
+			record(key, it->second);
+			m_map.erase(it);
+		}
+
+	if (m_activeCheckpoints == 0)
+		m_journal.clear();
+}
+
+namespace
+{
+
+/**
+ * Collects the keys of all stores to storage and memory inside a for loop, including the
+ * constant locations written by the user-defined functions it calls.
+ * The keys are constants or variables declared outside of the loop that are not assigned
+ * to inside of it. A value of ``nullopt`` means that the loop can write to unknown locations.
+ */
+class LoopStoreCollector: public ASTWalker
+{
+public:
+	using StoreKey = variant<u256, YulString>;
+
+	LoopStoreCollector(
+		Dialect const& _dialect,
+		map<YulString, WrittenLocations> const& _functionWrittenLocations,
+		ForLoop const& _loop
+	):
+		m_dialect(_dialect),
+		m_functionWrittenLocations(_functionWrittenLocations),
+		m_variablesChangedInLoop(assignedVariableNames(_loop.body) + assignedVariableNames(_loop.post))
+	{
+		for (Block const* block: {&_loop.body, &_loop.post})
+			forEach<VariableDeclaration const>(*block, [&](VariableDeclaration const& _varDecl) {
+				for (auto const& var: _varDecl.variables)
+					m_variablesChangedInLoop.insert(var.name);
+			});
+		m_ssaValues(_loop);
+		(*this)(_loop);
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+		{
+			if (builtin->sideEffects.storage == SideEffects::Write)
+				addStore(
+					storage,
+					builtin == m_dialect.storageStoreFunction({}) ? &_functionCall.arguments.front() : nullptr
+				);
+			if (builtin->sideEffects.memory == SideEffects::Write)
+				addStore(
+					memory,
+					builtin == m_dialect.memoryStoreFunction({}) ? &_functionCall.arguments.front() : nullptr
+				);
+		}
+		else if (auto const* written = util::valueOrNullptr(m_functionWrittenLocations, _functionCall.functionName.name))
+		{
+			addConstants(storage, written->storage);
+			addConstants(memory, written->memory);
+		}
+		else
+		{
+			storage.reset();
+			memory.reset();
+		}
+	}
+
+	optional<vector<StoreKey>> storage = vector<StoreKey>{};
+	optional<vector<StoreKey>> memory = vector<StoreKey>{};
+
+private:
+	/// Records a store to the given key, which is unknown if @a _key is null.
+	void addStore(optional<vector<StoreKey>>& _keys, Expression const* _key) const
+	{
+		if (!_keys)
+			return;
+		if (optional<StoreKey> key = _key ? storeKey(*_key) : nullopt)
+			_keys->emplace_back(move(*key));
+		else
+			_keys.reset();
+	}
+
+	static void addConstants(optional<vector<StoreKey>>& _keys, optional<set<u256>> const& _constants)
+	{
+		if (_keys && _constants)
+			_keys->insert(_keys->end(), _constants->begin(), _constants->end());
+		else
+			_keys.reset();
+	}
+
+	optional<StoreKey> storeKey(Expression const& _key) const
+	{
+		if (Literal const* literal = get_if<Literal>(&_key))
+			return valueOfLiteral(*literal);
+		if (Identifier const* identifier = get_if<Identifier>(&_key))
+		{
+			if (Expression const* const* value = util::valueOrNullptr(m_ssaValues.values(), identifier->name))
+				if (Literal const* literal = get_if<Literal>(*value))
+					return valueOfLiteral(*literal);
+			if (!m_variablesChangedInLoop.count(identifier->name))
+				return identifier->name;
+		}
+		return nullopt;
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, WrittenLocations> const& m_functionWrittenLocations;
+	SSAValueTracker m_ssaValues;
+	/// Variables declared or assigned to inside the loop.
+	set<YulString> m_variablesChangedInLoop;
+};
+
+}
+
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
-	map<YulString, SideEffects> _functionSideEffects
+	map<YulString, SideEffects> _functionSideEffects,
+	map<YulString, WrittenLocations> _functionWrittenLocations,
+	bool _keepKnowledgeInLoops
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_functionWrittenLocations(std::move(_functionWrittenLocations)),
+	m_keepKnowledgeInLoops(_keepKnowledgeInLoops),
 	m_knowledgeBase(_dialect, m_value)
 {
 	if (auto const* builtin = _dialect.memoryStoreFunction(YulString{}))
@@ -64,20 +227,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		m_storage.eraseIf(mapTuple([&](auto&& key, auto&& value) {
 			return
 				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
 				!m_knowledgeBase.knownToBeEqual(vars->second, value);
 		}));
-		m_storage[vars->first] = vars->second;
+		m_storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
+		m_memory.eraseIf(mapTuple([&](auto&& key, auto&& /* value */) {
 			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
 		}));
-		m_memory[vars->first] = vars->second;
+		m_memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -116,12 +279,12 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	size_t storageCheckpoint = m_storage.checkpoint();
+	size_t memoryCheckpoint = m_memory.checkpoint();
 
 	ASTModifier::operator()(_if);
 
-	joinKnowledge(storage, memory);
+	joinKnowledge(storageCheckpoint, memoryCheckpoint);
 
 	clearValues(assignedVariableNames(_if.body));
 }
@@ -133,10 +296,10 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		size_t storageCheckpoint = m_storage.checkpoint();
+		size_t memoryCheckpoint = m_memory.checkpoint();
 		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		joinKnowledge(storageCheckpoint, memoryCheckpoint);
 
 		set<YulString> variables = assignedVariableNames(_case.body);
 		assignedVariables += variables;
@@ -158,6 +321,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	ScopedSaveAndRestore referencesResetter(m_references, {});
 	ScopedSaveAndRestore storageResetter(m_storage, {});
 	ScopedSaveAndRestore memoryResetter(m_memory, {});
+	m_knowledgeBase.invalidateCache();
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -174,6 +338,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	// statement.
 
 	popScope();
+	m_knowledgeBase.invalidateCache();
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -191,6 +356,36 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 		assignedVariableNames(_for.body) + assignedVariableNames(_for.post);
 	clearValues(assignedVariables);
 
+	if (m_keepKnowledgeInLoops)
+	{
+		// Knowledge about locations that are not written to anywhere in the loop
+		// stays valid in all iterations, at ``continue`` and ``break`` and after the loop.
+		// The keys of the stores are invariant, so it is enough to determine them once.
+		LoopStoreCollector loopStores{m_dialect, m_functionWrittenLocations, _for};
+		auto clearKnowledgeWrittenInLoop = [&]() {
+			if (loopStores.storage)
+				clearKnowledgeAbout(StoreLoadLocation::Storage, *loopStores.storage);
+			else
+				m_storage.clear();
+			if (loopStores.memory)
+				clearKnowledgeAbout(StoreLoadLocation::Memory, *loopStores.memory);
+			else
+				m_memory.clear();
+		};
+
+		clearKnowledgeWrittenInLoop();
+		visit(*_for.condition);
+		(*this)(_for.body);
+		clearValues(assignmentsSinceCont.names());
+		clearKnowledgeWrittenInLoop();
+		(*this)(_for.post);
+		clearValues(assignedVariables);
+		clearKnowledgeWrittenInLoop();
+
+		--m_loopDepth;
+		return;
+	}
+
 	// break/continue are tricky for storage and thus we almost always clear here.
 	clearKnowledgeIfInvalidated(*_for.condition);
 	clearKnowledgeIfInvalidated(_for.post);
@@ -248,11 +443,11 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// assignment to slot denoted by "name"
 			m_storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_storage.eraseIf(mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 			// assignment to slot denoted by "name"
 			m_memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_memory.eraseIf(mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
 		}
 	}
 
@@ -265,9 +460,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				m_memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				m_storage.set(*key, variable);
 		}
 	}
 }
@@ -279,11 +474,14 @@ void DataFlowAnalyzer::pushScope(bool _functionScope)
 
 void DataFlowAnalyzer::popScope()
 {
+	bool removedValues = false;
 	for (auto const& name: m_variableScopes.back().variables)
 	{
-		m_value.erase(name);
+		removedValues = m_value.erase(name) || removedValues;
 		m_references.erase(name);
 	}
+	if (removedValues)
+		m_knowledgeBase.invalidateCache();
 	m_variableScopes.pop_back();
 }
 
@@ -308,8 +506,8 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
 		return _variables.count(key) || _variables.count(value);
 	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	m_storage.eraseIf(eraseCondition);
+	m_memory.eraseIf(eraseCondition);
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
@@ -323,11 +521,21 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 		m_value.erase(name);
 		m_references.erase(name);
 	}
+
+	// Cached answers might involve the cleared variables, also if they did not have a value,
+	// since they might receive one right after this.
+	if (!_variables.empty())
+		m_knowledgeBase.invalidateCache();
 }
 
 void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value)
 {
-	m_value[_variable] = {_value, m_loopDepth};
+	auto [it, inserted] = m_value.try_emplace(_variable, AssignedValue{_value, m_loopDepth});
+	if (!inserted)
+	{
+		it->second = {_value, m_loopDepth};
+		m_knowledgeBase.invalidateCache();
+	}
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
@@ -342,34 +550,40 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
+	if (!sideEffects.invalidatesStorage() && !sideEffects.invalidatesMemory())
+		return;
+
+	WrittenLocations written = writtenLocations(_expr);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+	{
+		if (written.storage)
+			clearKnowledgeAbout(
+				StoreLoadLocation::Storage,
+				vector<StoreKey>(written.storage->begin(), written.storage->end())
+			);
+		else
+			m_storage.clear();
+	}
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
-}
-
-void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
-)
-{
-	joinKnowledgeHelper(m_storage, _olderStorage);
-	joinKnowledgeHelper(m_memory, _olderMemory);
+	{
+		if (written.memory)
+			clearKnowledgeAbout(
+				StoreLoadLocation::Memory,
+				vector<StoreKey>(written.memory->begin(), written.memory->end())
+			);
+		else
+			m_memory.clear();
+	}
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge(size_t _storageCheckpoint, size_t _memoryCheckpoint)
 {
 	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// This also works for memory because the state at the checkpoint is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	m_storage.joinWithCheckpoint(_storageCheckpoint);
+	m_memory.joinWithCheckpoint(_memoryCheckpoint);
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -416,3 +630,60 @@ std::optional<YulString> DataFlowAnalyzer::isSimpleLoad(
 				return key->name;
 	return {};
 }
+
+WrittenLocations DataFlowAnalyzer::writtenLocations(Expression const& _expression) const
+{
+	FunctionCall const* functionCall = get_if<FunctionCall>(&_expression);
+	if (!functionCall)
+		return {};
+
+	WrittenLocations locations;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(functionCall->functionName.name))
+	{
+		if (builtin->sideEffects.storage == SideEffects::Write)
+			locations.storage.reset();
+		if (builtin->sideEffects.memory == SideEffects::Write)
+			locations.memory.reset();
+	}
+	else if (auto const* functionLocations = util::valueOrNullptr(m_functionWrittenLocations, functionCall->functionName.name))
+		locations = *functionLocations;
+	else
+		locations = {nullopt, nullopt};
+
+	for (Expression const& argument: functionCall->arguments)
+		locations += writtenLocations(argument);
+	return locations;
+}
+
+void DataFlowAnalyzer::clearKnowledgeAbout(StoreLoadLocation _location, vector<StoreKey> const& _writtenKeys)
+{
+	auto mayBeWritten = [&](YulString _key) {
+		for (StoreKey const& writtenKey: _writtenKeys)
+			if (u256 const* writtenConstant = get_if<u256>(&writtenKey))
+			{
+				optional<u256> key = m_knowledgeBase.valueIfKnownConstant(_key);
+				if (!key)
+					return true;
+				u256 difference = *key - *writtenConstant;
+				if (_location == StoreLoadLocation::Storage)
+				{
+					if (difference == 0)
+						return true;
+				}
+				else if (difference < 32 || difference > u256(0) - 32)
+					return true;
+			}
+			else if (_location == StoreLoadLocation::Storage)
+			{
+				if (!m_knowledgeBase.knownToBeDifferent(get<YulString>(writtenKey), _key))
+					return true;
+			}
+			else if (!m_knowledgeBase.knownToBeDifferentByAtLeast32(get<YulString>(writtenKey), _key))
+				return true;
+		return false;
+	};
+	if (_location == StoreLoadLocation::Storage)
+		m_storage.eraseIf(mapTuple([&](auto&& key, auto&& /* value */) { return mayBeWritten(key); }));
+	else
+		m_memory.eraseIf(mapTuple([&](auto&& key, auto&& /* value */) { return mayBeWritten(key); }));
+}
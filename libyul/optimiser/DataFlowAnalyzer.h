@@ -25,6 +25,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/Semantics.h>
 #include <libyul/YulString.h>
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
@@ -32,7 +33,12 @@
 #include <libsolutil/Common.h>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -47,6 +53,62 @@ struct AssignedValue
 	size_t loopDepth{0};
 };
 
+/**
+ * Map between variables, used for the knowledge about storage and memory, that keeps a
+ * journal of its changes while a checkpoint is active. This allows joining the current
+ * state with the state at a checkpoint without copying the map at the checkpoint
+ * and in time proportional to the number of changes since then.
+ */
+class JournaledVariableMap
+{
+public:
+	using Map = std::unordered_map<YulString, YulString>;
+
+	Map::const_iterator find(YulString _key) const { return m_map.find(_key); }
+	Map::const_iterator begin() const { return m_map.begin(); }
+	Map::const_iterator end() const { return m_map.end(); }
+
+	void set(YulString _key, YulString _value);
+	void erase(YulString _key);
+	template <class Predicate>
+	void eraseIf(Predicate _predicate)
+	{
+		for (auto it = m_map.begin(); it != m_map.end();)
+			if (_predicate(*it))
+			{
+				record(it->first, it->second);
+				it = m_map.erase(it);
+			}
+			else
+				++it;
+	}
+	void clear();
+
+	/// Starts recording changes.
+	/// @returns an identifier of the current state, to be passed to joinWithCheckpoint.
+	size_t checkpoint()
+	{
+		++m_activeCheckpoints;
+		return m_journal.size();
+	}
+	/// Removes all entries whose value differs from their value at the given checkpoint
+	/// or which did not exist at that point and ends the checkpoint.
+	/// Checkpoints have to be joined in reverse order of their creation.
+	void joinWithCheckpoint(size_t _checkpoint);
+
+private:
+	void record(YulString _key, std::optional<YulString> _previousValue)
+	{
+		if (m_activeCheckpoints > 0)
+			m_journal.emplace_back(_key, _previousValue);
+	}
+
+	Map m_map;
+	/// Keys and previous values (nullopt if there was none) of all changes in order.
+	std::vector<std::pair<YulString, std::optional<YulString>>> m_journal;
+	size_t m_activeCheckpoints = 0;
+};
+
 /**
  * Base class to perform data flow analysis during AST walks.
  * Tracks assignments and is used as base class for both Rematerialiser and
@@ -68,7 +130,8 @@ struct AssignedValue
  * If the keys or values are different or non-existent in one branch, the key is deleted.
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
- * at the point of assignment.
+ * at the point of assignment. The older version is not copied, but reconstructed for the
+ * changed keys from the journal of the maps.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -83,9 +146,20 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionWrittenLocations
+	///            Constant storage slots and memory offsets written by user-defined functions.
+	///            If provided, calls to these functions only clear the knowledge about
+	///            locations that are not known to be different. Otherwise, all knowledge
+	///            about storage / memory is cleared if the function can write to it.
+	/// @param _keepKnowledgeInLoops
+	///            If true, for loops only clear the knowledge about storage and memory
+	///            locations they can write to. Otherwise, all knowledge about storage / memory
+	///            is cleared if the loop can write to it.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		std::map<YulString, WrittenLocations> _functionWrittenLocations = {},
+		bool _keepKnowledgeInLoops = false
 	);
 
 	using ASTModifier::operator();
@@ -112,7 +186,7 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	virtual void assignValue(YulString _variable, Expression const* _value);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -120,18 +194,10 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
-	);
-
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// Joins knowledge about storage and memory with an older point in the control-flow,
+	/// given by checkpoints of m_storage and m_memory.
+	/// This only works if the current state is a direct successor of the older point.
+	void joinKnowledge(size_t _storageCheckpoint, size_t _memoryCheckpoint);
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -159,18 +225,34 @@ protected:
 		Expression const& _expression
 	) const;
 
+	/// @returns the storage slots and memory offsets written by the expression,
+	/// based on the written locations of the user-defined functions it calls.
+	WrittenLocations writtenLocations(Expression const& _expression) const;
+
+	/// Key of a store, which is either a constant or a variable whose value is not changed
+	/// in the code that is analyzed at once.
+	using StoreKey = std::variant<u256, YulString>;
+
+	/// Clears the knowledge about all keys of storage or memory that are not known
+	/// to be different from the given keys of stores.
+	void clearKnowledgeAbout(StoreLoadLocation _location, std::vector<StoreKey> const& _writtenKeys);
+
 	Dialect const& m_dialect;
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Constant locations written by user-defined functions.
+	std::map<YulString, WrittenLocations> m_functionWrittenLocations;
+	/// If true, for loops only clear the knowledge about the locations they can write to.
+	bool m_keepKnowledgeInLoops = false;
 
 	/// Current values of variables, always movable.
-	std::map<YulString, AssignedValue> m_value;
+	std::unordered_map<YulString, AssignedValue> m_value;
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
 	std::unordered_map<YulString, std::set<YulString>> m_references;
 
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	JournaledVariableMap m_storage;
+	JournaledVariableMap m_memory;
 
 	KnowledgeBase m_knowledgeBase;
 
@@ -36,9 +36,14 @@ using namespace solidity::yul;
 
 void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast)
 {
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		SideEffectsPropagator::sideEffects(_context.dialect, callGraph),
+		_context.storeKnowledgeAcrossCalls ?
+			WrittenLocationsPropagator::writtenLocations(_context.dialect, _ast, callGraph) :
+			map<YulString, WrittenLocations>{},
+		_context.storeKnowledgeInLoops
 	};
 	eliminator(_ast);
 
@@ -45,9 +45,16 @@ public:
 private:
 	EqualStoreEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, WrittenLocations> _functionWrittenLocations,
+		bool _keepKnowledgeInLoops
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects))
+		DataFlowAnalyzer(
+			_dialect,
+			std::move(_functionSideEffects),
+			std::move(_functionWrittenLocations),
+			_keepKnowledgeInLoops
+		)
 	{}
 
 protected:
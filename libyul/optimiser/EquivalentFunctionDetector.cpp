@@ -31,8 +31,7 @@ using namespace solidity::yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
-	auto& candidates = m_candidates[bodyHash];
+	auto& candidates = m_candidates[BlockHasher::functionHash(_fun)];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
 		{
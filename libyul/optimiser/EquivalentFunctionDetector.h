@@ -24,12 +24,19 @@
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/ASTForward.h>
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 namespace solidity::yul
 {
 
 /**
  * Optimiser component that detects syntactically equivalent functions.
  *
+ * Functions are grouped by a hash that is invariant under renaming of variables,
+ * such that only functions with equal hashes have to be compared.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
 class EquivalentFunctionDetector: public ASTWalker
@@ -37,7 +44,7 @@ class EquivalentFunctionDetector: public ASTWalker
 public:
 	static std::map<YulString, FunctionDefinition const*> run(Block& _block)
 	{
-		EquivalentFunctionDetector detector{BlockHasher::run(_block)};
+		EquivalentFunctionDetector detector;
 		detector(_block);
 		return std::move(detector.m_duplicates);
 	}
@@ -46,10 +53,9 @@ public:
 	void operator()(FunctionDefinition const& _fun) override;
 
 private:
-	EquivalentFunctionDetector(std::map<Block const*, uint64_t> _blockHashes): m_blockHashes(std::move(_blockHashes)) {}
+	EquivalentFunctionDetector() = default;
 
-	std::map<Block const*, uint64_t> m_blockHashes;
-	std::map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
+	std::unordered_map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
 
@@ -21,17 +21,22 @@
 
 #include <libyul/optimiser/ExpressionSimplifier.h>
 
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/Profiler.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	visitFunctionsInParallel(_context, _ast, [&]() {
+		return ExpressionSimplifier{_context.dialect};
+	});
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -39,5 +44,8 @@ void ExpressionSimplifier::visit(Expression& _expression)
 	ASTModifier::visit(_expression);
 
 	while (auto const* match = SimplificationRules::findFirstMatch(_expression, m_dialect, m_value))
+	{
+		SOL_OPTIMIZER_COUNT("expressionSimplifier/" + match->pattern.toString());
 		_expression = match->action().toExpression(debugDataOf(_expression));
+	}
 }
@@ -32,6 +32,7 @@
 #include <libyul/Dialect.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 
 using namespace std;
@@ -40,13 +41,18 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _context.maxCodeSize};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
-	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	optional<size_t> _maxCodeSize
+):
+	m_ast(_ast), m_maxCodeSize(_maxCodeSize), m_nameDispenser(_dispenser), m_dialect(_dialect)
 {
 	// Determine constants
 	SSAValueTracker tracker;
@@ -57,6 +63,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 
 	// Store size of global statements.
 	m_functionSizes[YulString{}] = CodeSize::codeSize(_ast);
+	m_codeSize = m_functionSizes[YulString{}];
 	map<YulString, size_t> references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
@@ -166,12 +173,18 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		return false;
 
 	if (m_noInlineFunctions.count(_funCall.functionName.name) || recursive(*calledFunction))
+	{
+		SOL_OPTIMIZER_COUNT("fullInliner/rejected/notInlinable");
 		return false;
+	}
 
 	// Inline really, really tiny functions
 	size_t size = m_functionSizes.at(calledFunction->name);
 	if (size <= 1)
+	{
+		SOL_OPTIMIZER_COUNT("fullInliner/inlined/tiny");
 		return true;
+	}
 
 	// In the first pass, only inline tiny functions.
 	if (m_pass == Pass::InlineTiny)
@@ -179,10 +192,24 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 
 	// Do not inline into already big functions.
 	if (m_functionSizes.at(_callSite) > 45)
+	{
+		SOL_OPTIMIZER_COUNT("fullInliner/rejected/callSiteTooLarge");
 		return false;
+	}
 
 	if (m_singleUse.count(calledFunction->name))
+	{
+		SOL_OPTIMIZER_COUNT("fullInliner/inlined/singleUse");
 		return true;
+	}
+
+	// Inlining functions that are called more than once grows the code, which is limited
+	// by the budget, if there is one.
+	if (m_maxCodeSize && m_codeSize + size > *m_maxCodeSize)
+	{
+		SOL_OPTIMIZER_COUNT("fullInliner/rejected/codeSizeBudget");
+		return false;
+	}
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
 	bool constantArg = false;
@@ -196,17 +223,23 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
-	return (size < 6 || (constantArg && size < 12));
+	bool smallEnough = size < 6 || (constantArg && size < 12);
+	SOL_OPTIMIZER_COUNT(smallEnough ? "fullInliner/inlined/small" : "fullInliner/rejected/tooLarge");
+	return smallEnough;
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	m_codeSize += m_functionSizes.at(_function);
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
-	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
+	size_t& size = m_functionSizes[_fun.name];
+	m_codeSize -= size;
+	size = CodeSize::codeSize(_fun.body);
+	m_codeSize += size;
 }
 
 void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
@@ -93,7 +93,12 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		Dialect const& _dialect,
+		std::optional<size_t> _maxCodeSize = std::nullopt
+	);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
@@ -116,6 +121,11 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// The sum of m_functionSizes.
+	size_t m_codeSize = 0;
+	/// If set, functions that are called more than once are not inlined if this would let
+	/// m_codeSize exceed this size.
+	std::optional<size_t> m_maxCodeSize;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -0,0 +1,244 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/FunctionPreoptimiser.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/NameDisplacer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Object.h>
+#include <libyul/OptimizedObjectCache.h>
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <range/v3/view/map.hpp>
+
+#include <map>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+using namespace solidity::langutil;
+
+namespace
+{
+
+/// @returns the function definitions at the top level of @a _block by name.
+map<YulString, FunctionDefinition const*> topLevelFunctions(Block const& _block)
+{
+	map<YulString, FunctionDefinition const*> functions;
+	for (Statement const& statement: _block.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions[function->name] = function;
+	return functions;
+}
+
+/// @returns the names of @a _function and of the functions of @a _functions it calls
+/// directly or indirectly.
+set<YulString> callClosure(YulString _function, map<YulString, FunctionDefinition const*> const& _functions)
+{
+	set<YulString> closure{_function};
+	vector<YulString> toVisit{_function};
+	while (!toVisit.empty())
+	{
+		YulString name = toVisit.back();
+		toVisit.pop_back();
+		for (auto const& reference: ReferencesCounter::countReferences(*_functions.at(name)) | ranges::views::keys)
+			if (_functions.count(reference) && closure.insert(reference).second)
+				toVisit.push_back(reference);
+	}
+	return closure;
+}
+
+/// @returns the names declared directly at the top level of @a _block. Identifiers declared
+/// anywhere inside the top-level functions must not coincide with them.
+set<YulString> topLevelNames(Block const& _block)
+{
+	set<YulString> names;
+	for (Statement const& statement: _block.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			names.insert(function->name);
+		else if (auto const* declaration = get_if<VariableDeclaration>(&statement))
+			for (TypedName const& variable: declaration->variables)
+				names.insert(variable.name);
+	return names;
+}
+
+/// @returns an analyzed object containing copies of the top-level functions of @a _object named
+/// in @a _names or nullptr if they cannot be analyzed without the rest of the object.
+shared_ptr<Object> isolate(Object const& _object, set<YulString> const& _names, Dialect const& _dialect)
+{
+	auto isolated = make_shared<Object>();
+	isolated->name = YulString{"preoptimised"};
+	isolated->debugData = _object.debugData;
+	isolated->code = make_shared<Block>();
+	isolated->code->debugData = _object.code->debugData;
+	for (Statement const& statement: _object.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement); function && _names.count(function->name))
+			isolated->code->statements.emplace_back(ASTCopier{}.translate(statement));
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	isolated->analysisInfo = make_shared<AsmAnalysisInfo>();
+	if (!AsmAnalyzer(*isolated->analysisInfo, errorReporter, _dialect).analyze(*isolated->code))
+		return nullptr;
+	return isolated;
+}
+
+/// Optimises the functions of the isolated object @a _object without removing any of them.
+void optimiseIsolated(
+	Dialect const& _dialect,
+	Object& _object,
+	optional<size_t> _expectedExecutionsPerDeployment
+)
+{
+	// The names of the functions have to stay the same, since they are referenced by the object
+	// the functions are taken from.
+	set<YulString> reservedIdentifiers = _dialect.fixedFunctionNames();
+	for (YulString function: topLevelFunctions(*_object.code) | ranges::views::keys)
+		reservedIdentifiers.insert(function);
+
+	*_object.code = std::get<Block>(Disambiguator(
+		_dialect,
+		*_object.analysisInfo,
+		reservedIdentifiers
+	)(*_object.code));
+	NameDispenser dispenser{_dialect, *_object.code, reservedIdentifiers};
+	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserSuite suite(context);
+	suite.runSequence("hgfo", *_object.code);
+	suite.runSequence(FunctionPreoptimiser::Sequence, *_object.code);
+}
+
+}
+
+void FunctionPreoptimiser::run(
+	Dialect const& _dialect,
+	Object& _object,
+	set<YulString> const& _functions,
+	optional<size_t> _expectedExecutionsPerDeployment,
+	OptimizedObjectCache* _cache,
+	string const& _context
+)
+{
+	yulAssert(_object.code, "");
+	yulAssert(_object.analysisInfo, "");
+
+	// All functions are isolated from the original code, so that the result for a function
+	// does not depend on which of its callees were replaced before.
+	map<YulString, FunctionDefinition const*> functions = topLevelFunctions(*_object.code);
+	map<YulString, shared_ptr<Object>> optimised;
+	for (YulString name: functions | ranges::views::keys)
+	{
+		if (!_functions.count(name))
+			continue;
+		shared_ptr<Object> isolated = isolate(_object, callClosure(name, functions), _dialect);
+		if (!isolated)
+			continue;
+
+		// The printed code contains the source locations, but not the list of sources of the
+		// object, which depends on the other code of the object.
+		h256 key = keccak256(
+			_context + '\0' + name.str() + '\0' +
+			AsmPrinter(
+				_dialect,
+				_object.debugData ? _object.debugData->sourceNames : nullopt,
+				DebugInfoSelection::All()
+			)(*isolated->code)
+		);
+		shared_ptr<Object> result = _cache ? _cache->lookup(key, _dialect) : nullptr;
+		if (!result)
+		{
+			optimiseIsolated(_dialect, *isolated, _expectedExecutionsPerDeployment);
+			if (_cache)
+				_cache->store(key, *isolated);
+			result = move(isolated);
+		}
+		optimised[name] = move(result);
+	}
+	if (optimised.empty())
+		return;
+
+	set<YulString> takenNames = topLevelNames(*_object.code);
+	set<YulString> allNames = NameCollector(*_object.code).names();
+	NameDispenser dispenser{_dialect, *_object.code};
+	for (auto& [name, result]: optimised)
+	{
+		map<YulString, FunctionDefinition const*> resultFunctions = topLevelFunctions(*result->code);
+		yulAssert(resultFunctions.count(name), "");
+
+		// Only the new functions (i.e. the specialisations) called by the optimised function
+		// are added to the object, the original functions are kept as they are.
+		set<YulString> added = callClosure(name, resultFunctions);
+		Block extracted{_object.code->debugData, {}};
+		for (Statement& statement: result->code->statements)
+			if (auto* function = get_if<FunctionDefinition>(&statement))
+				if (function->name == name || (added.count(function->name) && !functions.count(function->name)))
+					extracted.statements.emplace_back(move(statement));
+
+		// The new functions are visible everywhere in the object, the names declared inside the
+		// functions only have to differ from the names declared at the top level.
+		set<YulString> declaredNames = NameCollector(extracted).names();
+		set<YulString> namesToFree;
+		for (YulString declaredName: declaredNames)
+			if (declaredName != name && (
+				takenNames.count(declaredName) ||
+				(!functions.count(declaredName) && resultFunctions.count(declaredName) && allNames.count(declaredName))
+			))
+				namesToFree.insert(declaredName);
+		for (YulString declaredName: declaredNames)
+			dispenser.markUsed(declaredName);
+		NameDisplacer{dispenser, namesToFree}(extracted);
+		for (YulString addedName: topLevelFunctions(extracted) | ranges::views::keys)
+			takenNames.insert(addedName);
+		allNames += NameCollector(extracted).names();
+
+		for (auto it = _object.code->statements.begin(); it != _object.code->statements.end(); ++it)
+			if (auto const* function = get_if<FunctionDefinition>(&*it); function && function->name == name)
+			{
+				// The optimised function comes first, followed by its specialisations.
+				auto optimisedFunction = find_if(extracted.statements.begin(), extracted.statements.end(), [&](Statement const& _statement) {
+					return get<FunctionDefinition>(_statement).name == name;
+				});
+				*it = move(*optimisedFunction);
+				extracted.statements.erase(optimisedFunction);
+				_object.code->statements.insert(
+					next(it),
+					make_move_iterator(extracted.statements.begin()),
+					make_move_iterator(extracted.statements.end())
+				);
+				break;
+			}
+	}
+	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+}
@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation of selected functions in isolation, shared between objects.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct Object;
+class OptimizedObjectCache;
+
+/**
+ * Optimises each of the given top-level functions of an object (e.g. the internal functions of
+ * libraries) together with the functions it calls, but without the rest of the object, and
+ * replaces it by the result before the object itself is optimised.
+ *
+ * Since the result only depends on the code of the function and its callees, it is stored in an
+ * OptimizedObjectCache and reused for all objects that contain the same function. The steps of
+ * @a Sequence do not change the signature of any function and do not remove any function, but
+ * specialise calls with literal arguments (FunctionSpecializer), combine equivalent functions
+ * (EquivalentFunctionCombiner) and simplify the code. The functions created by specialisation
+ * are added to the object, renamed if their names are already taken there.
+ *
+ * Functions that refer to data objects are left unchanged, since their code depends on the
+ * surrounding object.
+ */
+class FunctionPreoptimiser
+{
+public:
+	static constexpr char Sequence[] = "Tx a[r scCTtfDn] F v [xa r scCTtfDn] jmV c";
+
+	/// Pre-optimises the functions of @a _object named in @a _functions and analyzes the object
+	/// again if any of them changed. @a _object has to be analyzed.
+	/// @param _context has to describe all settings the optimiser is run with. It is part of the
+	/// keys of the results in @a _cache, which can be nullptr.
+	static void run(
+		Dialect const& _dialect,
+		Object& _object,
+		std::set<YulString> const& _functions,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		OptimizedObjectCache* _cache,
+		std::string const& _context
+	);
+};
+
+}
@@ -40,14 +40,23 @@ bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
 	// current values to turn `sub(_a, _b)` into a nonzero constant.
 	// If that fails, try `eq(_a, _b)`.
 
-	if (optional<u256> difference = differenceIfKnownConstant(_a, _b))
-		return difference != 0;
-
-	Expression expr2 = simplify(FunctionCall{{}, {{}, "eq"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
-	if (holds_alternative<Literal>(expr2))
-		return valueOfLiteral(std::get<Literal>(expr2)) == 0;
+	auto [it, inserted] = m_differentCache.try_emplace({_a, _b}, false);
+	if (!inserted)
+		return it->second;
 
-	return false;
+	bool different = false;
+	if (optional<u256> difference = differenceIfKnownConstant(_a, _b))
+		different = difference != 0;
+	else
+	{
+		Expression expr2 = simplify(FunctionCall{{}, {{}, "eq"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
+		if (holds_alternative<Literal>(expr2))
+			different = valueOfLiteral(std::get<Literal>(expr2)) == 0;
+	}
+
+	// The iterator stays valid, differenceIfKnownConstant does not modify this map.
+	it->second = different;
+	return different;
 }
 
 optional<u256> KnowledgeBase::differenceIfKnownConstant(YulString _a, YulString _b)
@@ -55,11 +64,15 @@ optional<u256> KnowledgeBase::differenceIfKnownConstant(YulString _a, YulString
 	// Try to use the simplification rules together with the
 	// current values to turn `sub(_a, _b)` into a constant.
 
+	auto [it, inserted] = m_differenceCache.try_emplace({_a, _b});
+	if (!inserted)
+		return it->second;
+
 	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
 	if (Literal const* value = get_if<Literal>(&expr1))
-		return valueOfLiteral(*value);
+		it->second = valueOfLiteral(*value);
 
-	return {};
+	return it->second;
 }
 
 bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
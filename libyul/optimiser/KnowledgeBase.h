@@ -28,6 +28,9 @@
 #include <libsolutil/Numeric.h>
 
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
 namespace solidity::yul
 {
@@ -39,11 +42,15 @@ struct AssignedValue;
  * Class that can answer questions about values of variables and their relations.
  *
  * The reference to the map of values provided at construction is assumed to be updating.
+ * Answers to queries that need the simplification rules are cached. The cache has to be
+ * cleared using invalidateCache() whenever the value of a variable that could be involved
+ * in a previous query changes, i.e. the value of a variable that already has a value
+ * is changed or removed. Adding a value for a new variable does not require this.
  */
 class KnowledgeBase
 {
 public:
-	KnowledgeBase(Dialect const& _dialect, std::map<YulString, AssignedValue> const& _variableValues):
+	KnowledgeBase(Dialect const& _dialect, std::unordered_map<YulString, AssignedValue> const& _variableValues):
 		m_dialect(_dialect),
 		m_variableValues(_variableValues)
 	{}
@@ -55,13 +62,24 @@ public:
 	bool knownToBeZero(YulString _a);
 	std::optional<u256> valueIfKnownConstant(YulString _a);
 
+	/// Has to be called after the value of a variable that already had one changed or was removed.
+	void invalidateCache()
+	{
+		m_differenceCache.clear();
+		m_differentCache.clear();
+	}
+
 private:
 	Expression simplify(Expression _expression);
 	Expression simplifyRecursively(Expression _expression);
 
 	Dialect const& m_dialect;
-	std::map<YulString, AssignedValue> const& m_variableValues;
+	std::unordered_map<YulString, AssignedValue> const& m_variableValues;
 	size_t m_counter = 0;
+	/// Cached results of differenceIfKnownConstant.
+	std::map<std::pair<YulString, YulString>, std::optional<u256>> m_differenceCache;
+	/// Cached results of knownToBeDifferent.
+	std::map<std::pair<YulString, YulString>, bool> m_differentCache;
 };
 
 }
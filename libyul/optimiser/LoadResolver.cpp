@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/LoadResolver.h>
 
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/Semantics.h>
@@ -44,12 +45,22 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, callGraph);
+	map<YulString, WrittenLocations> functionWrittenLocations;
+	if (_context.storeKnowledgeAcrossCalls)
+		functionWrittenLocations = WrittenLocationsPropagator::writtenLocations(_context.dialect, _ast, callGraph);
+	visitFunctionsInParallel(_context, _ast, [&]() {
+		return LoadResolver{
+			_context.dialect,
+			functionSideEffects,
+			functionWrittenLocations,
+			_context.storeKnowledgeInLoops,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		};
+	});
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -136,12 +147,11 @@ void LoadResolver::tryEvaluateKeccak(
 		optional<u256> byteLength = valueOfIdentifier(length->name);
 		if (memoryContent && byteLength && *byteLength <= 32)
 		{
-			bytes contentAsBytes = toBigEndian(*memoryContent);
-			contentAsBytes.resize(static_cast<size_t>(*byteLength));
+			h256 contentAsBytes(*memoryContent);
 			_e = Literal{
 				debugDataOf(_e),
 				LiteralKind::Number,
-				YulString{u256(keccak256(contentAsBytes)).str()},
+				YulString{u256(keccak256(contentAsBytes.ref().cropped(0, static_cast<size_t>(*byteLength)))).str()},
 				m_dialect.defaultType
 			};
 		}
@@ -50,10 +50,17 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, WrittenLocations> _functionWrittenLocations,
+		bool _keepKnowledgeInLoops,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(
+			_dialect,
+			std::move(_functionSideEffects),
+			std::move(_functionWrittenLocations),
+			_keepKnowledgeInLoops
+		),
 		m_containsMSize(_containsMSize),
 		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
 	{}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/LoopUnswitcher.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void LoopUnswitcher::run(OptimiserStepContext& _context, Block& _ast)
+{
+	LoopUnswitcher{_context.dialect, _context.dispenser}(_ast);
+}
+
+void LoopUnswitcher::operator()(Block& _block)
+{
+	util::iterateReplacing(
+		_block.statements,
+		[&](Statement& _s) -> optional<vector<Statement>>
+		{
+			visit(_s);
+			if (holds_alternative<ForLoop>(_s))
+				return unswitchLoop(get<ForLoop>(_s));
+			else
+				return {};
+		}
+	);
+}
+
+optional<vector<Statement>> LoopUnswitcher::unswitchLoop(ForLoop& _loop)
+{
+	// The case literal has the default type, which has to be the type of the condition.
+	if (m_dialect.boolType != m_dialect.defaultType || !_loop.pre.statements.empty())
+		return {};
+	if (CodeSize::codeSize(*_loop.condition) + CodeSize::codeSize(_loop.post) + CodeSize::codeSize(_loop.body) > MaxLoopSize)
+		return {};
+
+	set<YulString> varyingNames =
+		assignedVariableNames(_loop.body) +
+		assignedVariableNames(_loop.post) +
+		NameCollector(_loop.body, NameCollector::OnlyVariables).names() +
+		NameCollector(_loop.post, NameCollector::OnlyVariables).names();
+	auto invariantIf = find_if(_loop.body.statements.begin(), _loop.body.statements.end(), [&](Statement const& _s) {
+		If const* ifStatement = get_if<If>(&_s);
+		if (!ifStatement)
+			return false;
+		Identifier const* condition = get_if<Identifier>(ifStatement->condition.get());
+		return condition && !varyingNames.count(condition->name);
+	});
+	if (invariantIf == _loop.body.statements.end())
+		return {};
+	size_t position = static_cast<size_t>(invariantIf - _loop.body.statements.begin());
+
+	Statement copy = BodyCopier{m_nameDispenser, {}}(_loop);
+	ForLoop& loopIfTrue = get<ForLoop>(copy);
+	If& ifStatement = get<If>(loopIfTrue.body.statements[position]);
+	Expression condition = move(*ifStatement.condition);
+	loopIfTrue.body.statements[position] = move(ifStatement.body);
+	_loop.body.statements.erase(_loop.body.statements.begin() + static_cast<ptrdiff_t>(position));
+
+	shared_ptr<DebugData const> debugData = _loop.debugData;
+	vector<Case> cases;
+	cases.emplace_back(Case{
+		debugData,
+		make_unique<Literal>(Literal{debugData, LiteralKind::Number, "0"_yulstring, m_dialect.defaultType}),
+		Block{debugData, util::make_vector<Statement>(move(_loop))}
+	});
+	cases.emplace_back(Case{debugData, nullptr, Block{debugData, util::make_vector<Statement>(move(loopIfTrue))}});
+	return util::make_vector<Statement>(Switch{debugData, make_unique<Expression>(move(condition)), move(cases)});
+}
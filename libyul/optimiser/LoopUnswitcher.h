@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+class NameDispenser;
+
+/**
+ * Loop unswitching.
+ *
+ * Moves an if statement at the top level of the body of a loop whose condition is a variable
+ * that the loop neither declares nor assigns to outside of the loop. The loop is replaced by
+ * a switch on the condition with a copy of the loop for each case, without the if statement
+ * in the case where its condition is false and with its body in place of the if statement
+ * in the other case:
+ *
+ * for { } lt(i, n) { i := add(i, 1) } { if c { f(i) } g(i) }
+ *
+ * is transformed to
+ *
+ * switch c
+ * case 0 { for { } lt(i, n) { i := add(i, 1) } { g(i) } }
+ * default { for { } lt(i, n) { i := add(i, 1) } { { f(i) } g(i) } }
+ *
+ * This saves the evaluation of the condition in every iteration at the cost of duplicating
+ * the loop, so only loops up to a small size are unswitched. The variables declared in the
+ * copy of the loop are renamed.
+ *
+ * Requirements:
+ * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
+ * - Expression splitter should be run upfront to obtain better results.
+ */
+class LoopUnswitcher: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnswitcher"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	/// Maximum code size of a loop that is unswitched.
+	static constexpr size_t MaxLoopSize = 24;
+
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnswitcher(Dialect const& _dialect, NameDispenser& _nameDispenser):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser)
+	{}
+
+	std::optional<std::vector<Statement>> unswitchLoop(ForLoop& _loop);
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+};
+
+}
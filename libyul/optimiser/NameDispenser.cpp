@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/NameDispenser.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
@@ -49,15 +50,37 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
-	while (illegalName(name))
+	if (illegalName(name))
 	{
-		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		string candidate = _nameHint.str() + "_";
+		size_t const prefixLength = candidate.size();
+		do
+		{
+			m_counter++;
+			candidate.resize(prefixLength);
+			candidate += to_string(m_counter);
+			name = YulString(candidate);
+		}
+		while (illegalName(name));
 	}
 	m_usedNames.emplace(name);
 	return name;
 }
 
+uint64_t NameDispenser::stateHash() const
+{
+	struct StateHasher: HasherBase
+	{
+		using HasherBase::hash64;
+		using HasherBase::m_hash;
+	} hasher;
+	hasher.hash64(m_counter);
+	hasher.hash64(m_usedNames.size());
+	for (YulString name: m_usedNames)
+		hasher.hash64(name.hash());
+	return hasher.m_hash;
+}
+
 bool NameDispenser::illegalName(YulString _name)
 {
 	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
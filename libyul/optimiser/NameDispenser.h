@@ -53,6 +53,10 @@ public:
 
 	std::set<YulString> const& usedNames() { return m_usedNames; }
 
+	/// @returns a hash of the used names and of the counter, which determine the names
+	/// returned by newName().
+	uint64_t stateHash() const;
+
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
 
@@ -39,6 +39,26 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Maximum number of threads steps may use to process independent functions.
+	size_t parallelism = 1;
+	/// If set, the full inliner only inlines functions that are called more than once
+	/// as long as the code stays below this size.
+	std::optional<size_t> maxCodeSize = std::nullopt;
+	/// If set, the stack limit evader moves variables that are never live at the same time
+	/// to the same memory slot.
+	bool reuseMemorySlots = false;
+	/// If set, the rematerialiser compares gas costs determined by the EVM gas meter
+	/// instead of using fixed thresholds for the code cost.
+	bool rematerialiserGasCosts = false;
+	/// If set, the load resolver and the equal store eliminator keep the knowledge about
+	/// storage and memory across calls to functions that only write to other constant locations.
+	bool storeKnowledgeAcrossCalls = false;
+	/// If set, the load resolver and the equal store eliminator keep the knowledge about
+	/// storage and memory at for loops for locations the loop does not write to.
+	bool storeKnowledgeInLoops = false;
+	/// The search budget of the stack layout generator the code will be generated with,
+	/// which the stack limit evader uses to determine the stack too deep errors.
+	size_t stackLayoutSearchBudget = 0;
 };
 
 
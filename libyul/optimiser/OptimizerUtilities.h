@@ -22,10 +22,14 @@
 #pragma once
 
 #include <libsolutil/Common.h>
-#include <libyul/ASTForward.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+#include <libyul/AST.h>
 #include <libyul/Dialect.h>
 #include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/OptimiserStep.h>
 
 #include <optional>
 
@@ -49,6 +53,42 @@ bool isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifie
 /// Helper function that returns the instruction, if the `_name` is a BuiltinFunction
 std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, YulString const& _name);
 
+/// Applies a visitor created by @a _createVisitor to @a _ast.
+/// If parallelism is enabled in @a _context and @a _ast is in the form produced by the
+/// FunctionGrouper, each top-level statement (the main block and each function) is processed
+/// by a fresh visitor instead and these are run in parallel on the shared thread pool, whose
+/// workers are reused for all steps and shared with the optimiser runs of other objects.
+/// This is only valid for steps where the visitor does not keep any state between functions
+/// and only reads the rest of the AST, e.g. those based on the DataFlowAnalyzer, and
+/// which do not create new names.
+template <class CreateVisitor>
+void visitFunctionsInParallel(OptimiserStepContext const& _context, Block& _ast, CreateVisitor&& _createVisitor)
+{
+	// Below this, handing the functions to other threads is more expensive than the step itself.
+	size_t constexpr minimumFunctionCount = 8;
+	if (
+		_context.parallelism <= 1 ||
+		_ast.statements.size() <= minimumFunctionCount ||
+		!FunctionGrouper::alreadyGrouped(_ast)
+	)
+	{
+		auto visitor = _createVisitor();
+		visitor(_ast);
+		return;
+	}
+
+	YulStringRepository& yulStrings = YulStringRepository::instance();
+	// Counters of the optimizer steps are recorded in the profiler of the calling thread.
+	auto const profiler = util::Profiler::current();
+	util::ThreadPool::shared().forEach(_ast.statements.size(), _context.parallelism, [&](size_t _index) {
+		YulStringRepository::Scope yulStringScope(yulStrings);
+		util::Profiler::Scope profilerScope(profiler.first, profiler.second);
+		auto visitor = _createVisitor();
+		ASTModifier& modifier = visitor;
+		modifier.visit(_ast.statements[_index]);
+	});
+}
+
 class StatementRemover: public ASTModifier
 {
 public:
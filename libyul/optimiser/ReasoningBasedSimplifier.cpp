@@ -57,47 +57,93 @@ void ReasoningBasedSimplifier::operator()(VariableDeclaration& _varDecl)
 	SMTSolver::encodeVariableDeclaration(_varDecl);
 }
 
+void ReasoningBasedSimplifier::operator()(FunctionDefinition& _funDef)
+{
+	// Functions cannot access outer variables, so nothing that is asserted
+	// inside is needed afterwards and no cached result is valid inside.
+	vector<KnownConditions> outerConditions = std::exchange(m_knownConditions, vector<KnownConditions>(1));
+	m_solver->push();
+	ASTModifier::operator()(_funDef);
+	m_solver->pop();
+	m_knownConditions = move(outerConditions);
+}
+
 void ReasoningBasedSimplifier::operator()(If& _if)
 {
 	if (!SideEffectsCollector{m_dialect, *_if.condition}.movable())
 		return;
 
-	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+	std::optional<smtutil::Expression> condition;
+	std::optional<bool> value;
+	if (std::optional<std::optional<bool>> cached = cachedValue(*_if.condition))
+		value = *cached;
+	else if (m_remainingQueries > 0)
+	{
+		condition = encodeExpression(*_if.condition);
+		value = queryValue(*condition);
+		m_knownConditions.back()[*_if.condition] = value;
+	}
+
+	if (value == true)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.debugData = debugDataOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(move(trueCondition));
 	}
-	else
+	else if (value == false)
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.debugData = debugDataOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.debugData = debugDataOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
 	m_solver->push();
-	m_solver->addAssertion(condition != constantValue(0));
+	m_knownConditions.emplace_back();
+	if (!value)
+	{
+		if (!condition)
+			condition = encodeExpression(*_if.condition);
+		m_solver->addAssertion(*condition != constantValue(0));
+	}
 
 	ASTModifier::operator()(_if.body);
 
+	m_knownConditions.pop_back();
 	m_solver->pop();
 }
 
+optional<optional<bool>> ReasoningBasedSimplifier::cachedValue(yul::Expression const& _condition) const
+{
+	for (size_t level = m_knownConditions.size(); level > 0; --level)
+	{
+		KnownConditions const& known = m_knownConditions[level - 1];
+		if (auto it = known.find(_condition); it != known.end())
+			// Non-constant conditions may become constant in nested bodies.
+			if (it->second || level == m_knownConditions.size())
+				return it->second;
+	}
+	return nullopt;
+}
+
+optional<bool> ReasoningBasedSimplifier::queryValue(smtutil::Expression const& _condition)
+{
+	for (bool assumeTrue: {false, true})
+	{
+		if (m_remainingQueries > 0)
+			--m_remainingQueries;
+		m_solver->push();
+		m_solver->addAssertion(assumeTrue ? _condition != constantValue(0) : _condition == constantValue(0));
+		CheckResult result = m_solver->check({}).first;
+		m_solver->pop();
+		if (result == CheckResult::UNSATISFIABLE)
+			return !assumeTrue;
+	}
+	return nullopt;
+}
+
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	Dialect const& _dialect,
 	set<YulString> const& _ssaVariables
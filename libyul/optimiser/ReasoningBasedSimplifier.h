@@ -19,12 +19,16 @@
 #include <libyul/optimiser/SMTSolver.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/Dialect.h>
 
 // because of instruction
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::smtutil
 {
@@ -43,6 +47,10 @@ namespace solidity::yul
  * - If `constraints AND NOT condition` is UNSAT, the condition is always true and can be replaced by `1`.
  * The simplifications above can only be applied if the condition is movable.
  *
+ * The solver is used incrementally: the body of each function and of each `if` is visited within
+ * its own solver scope. Results are cached per function for syntactically equal conditions,
+ * and the number of solver queries per run is limited by `maxSolverQueries`.
+ *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
  * Prerequisite: Disambiguator, SSATransform.
@@ -54,11 +62,25 @@ public:
 	static void run(OptimiserStepContext& _context, Block& _ast);
 	static std::optional<std::string> invalidInCurrentEnvironment();
 
+	/// Maximum number of solver queries per run. Conditions encountered after the
+	/// budget is exhausted are kept unless their value is already cached.
+	/// This is a query count instead of a time limit to keep the output deterministic.
+	static size_t constexpr maxSolverQueries = 1000;
+
 	using ASTModifier::operator();
 	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(FunctionDefinition& _funDef) override;
 	void operator()(If& _if) override;
 
 private:
+	/// Conditions with known constant value, keyed by the condition expression.
+	using KnownConditions = std::unordered_map<
+		Expression,
+		std::optional<bool>,
+		ExpressionHash,
+		SyntacticallyEqualExpression
+	>;
+
 	explicit ReasoningBasedSimplifier(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables
@@ -69,7 +91,19 @@ private:
 		std::vector<Expression> const& _arguments
 	) override;
 
+	/// @returns the cached value of @a _condition under the current path, if any.
+	/// The outer value is `nullopt` if nothing is cached and the inner one if the
+	/// condition is known not to be constant.
+	std::optional<std::optional<bool>> cachedValue(Expression const& _condition) const;
+	/// @returns the constant value of the encoded condition under the current path, if it has one.
+	std::optional<bool> queryValue(smtutil::Expression const& _condition);
+
 	Dialect const& m_dialect;
+	/// Cached condition values, one entry per nested `if` body of the current function.
+	/// If a condition is constant under a path, it is also constant inside
+	/// all nested bodies, but non-constant results are only valid at their own level.
+	std::vector<KnownConditions> m_knownConditions = std::vector<KnownConditions>(1);
+	size_t m_remainingQueries = maxSolverQueries;
 };
 
 }
@@ -23,6 +23,8 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 
@@ -32,6 +34,44 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Estimated number of iterations of a loop, used to weight the runtime costs inside of loops.
+size_t constexpr estimatedLoopIterations = 10;
+
+/// @returns true if the gas meter can determine the costs of @a _expression,
+/// i.e. if it only calls builtins that correspond to EVM instructions.
+bool hasGasCosts(EVMDialect const& _dialect, Expression const& _expression)
+{
+	if (auto const* functionCall = get_if<FunctionCall>(&_expression))
+	{
+		BuiltinFunctionForEVM const* builtin = _dialect.builtin(functionCall->functionName.name);
+		return
+			builtin &&
+			builtin->instruction &&
+			ranges::all_of(functionCall->arguments, [&](Expression const& _argument) {
+				return hasGasCosts(_dialect, _argument);
+			});
+	}
+	return true;
+}
+
+}
+
+void Rematerialiser::run(OptimiserStepContext& _context, Block& _ast)
+{
+	Rematerialiser rematerialiser{_context.dialect, _ast};
+	if (_context.rematerialiserGasCosts)
+		if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		{
+			rematerialiser.m_gasCostDialect = evmDialect;
+			rematerialiser.m_isCreation = !_context.expectedExecutionsPerDeployment.has_value();
+			rematerialiser.m_expectedExecutionsPerDeployment = _context.expectedExecutionsPerDeployment.value_or(1);
+		}
+	rematerialiser(_ast);
+}
+
 void Rematerialiser::run(Dialect const& _dialect, Block& _ast, set<YulString> _varsToAlwaysRematerialize, bool _onlySelectedVariables)
 {
 	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize), _onlySelectedVariables}(_ast);
@@ -84,16 +124,20 @@ void Rematerialiser::visit(Expression& _e)
 			assertThrow(m_value.at(name).value, OptimizerException, "");
 			AssignedValue const& value = m_value.at(name);
 			size_t refs = m_referenceCounts[name];
-			size_t cost = CodeCost::codeCost(m_dialect, *value.value);
-			if (
-				(
-					!m_onlySelectedVariables && (
-						(refs <= 1 && value.loopDepth == m_loopDepth) ||
-						cost == 0 ||
-						(refs <= 5 && cost <= 1 && m_loopDepth == 0)
-					)
-				) || m_varsToAlwaysRematerialize.count(name)
-			)
+			bool rematerialise = m_varsToAlwaysRematerialize.count(name);
+			if (!rematerialise && !m_onlySelectedVariables)
+			{
+				if (refs <= 1 && value.loopDepth == m_loopDepth)
+					rematerialise = true;
+				else if (optional<bool> cheaper = cheaperToRematerialise(*value.value, value.loopDepth, refs))
+					rematerialise = *cheaper;
+				else
+				{
+					size_t cost = CodeCost::codeCost(m_dialect, *value.value);
+					rematerialise = cost == 0 || (refs <= 5 && cost <= 1 && m_loopDepth == 0);
+				}
+			}
+			if (rematerialise)
 			{
 				assertThrow(m_referenceCounts[name] > 0, OptimizerException, "");
 				if (ranges::all_of(m_references[name], [&](auto const& ref) { return inScope(ref); }))
@@ -110,6 +154,30 @@ void Rematerialiser::visit(Expression& _e)
 	DataFlowAnalyzer::visit(_e);
 }
 
+optional<bool> Rematerialiser::cheaperToRematerialise(
+	Expression const& _value,
+	size_t _definitionLoopDepth,
+	size_t _references
+) const
+{
+	if (!m_gasCostDialect || !hasGasCosts(*m_gasCostDialect, _value))
+		return nullopt;
+
+	auto costsAtLoopDepth = [&](pair<bigint, bigint> const& _costs, size_t _loopDepth) {
+		bigint executions = m_expectedExecutionsPerDeployment;
+		for (size_t i = 0; i < _loopDepth; ++i)
+			executions *= estimatedLoopIterations;
+		return _costs.first * executions + _costs.second;
+	};
+	auto valueCosts = GasMeterVisitor::costs(_value, *m_gasCostDialect, m_isCreation);
+	auto dupCosts = GasMeterVisitor::instructionCosts(evmasm::Instruction::DUP1, *m_gasCostDialect, m_isCreation);
+	auto popCosts = GasMeterVisitor::instructionCosts(evmasm::Instruction::POP, *m_gasCostDialect, m_isCreation);
+
+	bigint additionalCosts = costsAtLoopDepth(valueCosts, m_loopDepth) - costsAtLoopDepth(dupCosts, m_loopDepth);
+	bigint definitionCosts = costsAtLoopDepth(valueCosts, _definitionLoopDepth) + costsAtLoopDepth(popCosts, _definitionLoopDepth);
+	return additionalCosts * _references < definitionCosts;
+}
+
 void LiteralRematerialiser::visit(Expression& _e)
 {
 	if (holds_alternative<Identifier>(_e))
@@ -24,9 +24,13 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <optional>
+
 namespace solidity::yul
 {
 
+struct EVMDialect;
+
 /**
  * Optimisation stage that replaces variable references by those expressions
  * that are most recently assigned to the referenced variables,
@@ -36,6 +40,14 @@ namespace solidity::yul
  *  - the variable is referenced at most 5 times and the value is rather cheap
  *    ("cost" of at most 1 like a constant up to 0xff) and we are not in a loop
  *
+ * If ``rematerialiserGasCosts`` is set in the step context and the dialect is an EVM dialect,
+ * the last two rules are replaced by a comparison of the costs determined by the gas meter
+ * for values consisting of EVM instructions only: a reference is replaced if the additional
+ * costs of evaluating the value instead of duplicating the variable are lower than the share
+ * of the reference in the costs of the definition, which can be removed once no references are left.
+ * Runtime costs are weighted by the expected number of executions per deployment and
+ * by an estimated number of loop iterations for every enclosing loop.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class Rematerialiser: public DataFlowAnalyzer
@@ -45,7 +57,7 @@ public:
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
-	) { run(_context.dialect, _ast); }
+	);
 
 	static void run(
 		Dialect const& _dialect,
@@ -79,9 +91,24 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
+	/// @returns whether replacing a reference to a variable with value @a _value at the current loop depth
+	/// is cheaper according to the gas meter, or nullopt if the gas costs are not used or cannot be
+	/// determined for @a _value.
+	/// @param _definitionLoopDepth the loop depth of the assignment of @a _value.
+	/// @param _references the number of remaining references to the variable.
+	std::optional<bool> cheaperToRematerialise(
+		Expression const& _value,
+		size_t _definitionLoopDepth,
+		size_t _references
+	) const;
+
 	std::map<YulString, size_t> m_referenceCounts;
 	std::set<YulString> m_varsToAlwaysRematerialize;
 	bool m_onlySelectedVariables = false;
+	/// The dialect used to determine gas costs, if they are used instead of the code cost.
+	EVMDialect const* m_gasCostDialect = nullptr;
+	bool m_isCreation = false;
+	size_t m_expectedExecutionsPerDeployment = 1;
 };
 
 /**
@@ -21,7 +21,10 @@
 
 #include <libyul/optimiser/Semantics.h>
 
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/Utilities.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -113,38 +116,156 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	// The same is true for any function part of a call cycle.
 	// In the future, we should refine that, because the property
 	// is actually a bit different from "not movable".
+	SideEffects loopingSideEffects;
+	loopingSideEffects.movable = false;
+	loopingSideEffects.canBeRemoved = false;
+	loopingSideEffects.canBeRemovedIfNoMSize = false;
+	loopingSideEffects.cannotLoop = false;
 
+	// The components are in reverse topological order, so the side-effects of all
+	// functions called from outside of a component are known when processing it.
+	// All functions in a component call each other and thus have the same side-effects.
 	map<YulString, SideEffects> ret;
-	for (auto const& function: _directCallGraph.functionsWithLoops + _directCallGraph.recursiveFunctions())
+	for (vector<YulString> const& component: _directCallGraph.stronglyConnectedComponents())
 	{
-		ret[function].movable = false;
-		ret[function].canBeRemoved = false;
-		ret[function].canBeRemovedIfNoMSize = false;
-		ret[function].cannotLoop = false;
+		SideEffects sideEffects;
+		if (component.size() > 1)
+			sideEffects += loopingSideEffects;
+		for (YulString function: component)
+		{
+			if (_directCallGraph.functionsWithLoops.count(function))
+				sideEffects += loopingSideEffects;
+			for (YulString callee: _directCallGraph.functionCalls.at(function))
+				if (BuiltinFunction const* f = _dialect.builtin(callee))
+					sideEffects += f->sideEffects;
+				else if (SideEffects const* calleeSideEffects = util::valueOrNullptr(ret, callee))
+					sideEffects += *calleeSideEffects;
+				else if (_directCallGraph.functionCalls.count(callee))
+					// The callee is part of the current component.
+					sideEffects += loopingSideEffects;
+				else
+					sideEffects += SideEffects::worst();
+		}
+		for (YulString function: component)
+			ret[function] = sideEffects;
 	}
+	return ret;
+}
+
+namespace
+{
 
-	for (auto const& call: _directCallGraph.functionCalls)
+/**
+ * Walks the body of a function and collects the constant keys of its stores, without
+ * entering nested functions or calls to user-defined functions.
+ */
+class DirectWrittenLocationsCollector: public ASTWalker
+{
+public:
+	DirectWrittenLocationsCollector(Dialect const& _dialect, FunctionDefinition const& _function):
+		m_dialect(_dialect)
 	{
-		YulString funName = call.first;
-		SideEffects sideEffects;
-		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
-			if (!visited.insert(_function).second)
+		m_ssaValues(_function);
+		(*this)(_function.body);
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+		if (!builtin)
+			return;
+		if (builtin->sideEffects.storage == SideEffects::Write)
+			addStore(
+				locations.storage,
+				builtin == m_dialect.storageStoreFunction({}) ? &_functionCall.arguments.front() : nullptr
+			);
+		if (builtin->sideEffects.memory == SideEffects::Write)
+			addStore(
+				locations.memory,
+				builtin == m_dialect.memoryStoreFunction({}) ? &_functionCall.arguments.front() : nullptr
+			);
+	}
+
+	WrittenLocations locations;
+
+private:
+	/// Records a store to the given key, which is unknown if @a _key is null.
+	void addStore(optional<set<u256>>& _locations, Expression const* _key)
+	{
+		if (!_locations)
+			return;
+		if (optional<u256> value = _key ? constantValue(*_key) : nullopt)
+			_locations->insert(*value);
+		else
+			_locations.reset();
+	}
+
+	optional<u256> constantValue(Expression const& _expression) const
+	{
+		if (Literal const* literal = get_if<Literal>(&_expression))
+			return valueOfLiteral(*literal);
+		if (Identifier const* identifier = get_if<Identifier>(&_expression))
+			if (Expression const* const* value = util::valueOrNullptr(m_ssaValues.values(), identifier->name))
+				if (Literal const* literal = get_if<Literal>(*value))
+					return valueOfLiteral(*literal);
+		return nullopt;
+	}
+
+	Dialect const& m_dialect;
+	SSAValueTracker m_ssaValues;
+};
+
+}
+
+WrittenLocations& WrittenLocations::operator+=(WrittenLocations const& _other)
+{
+	auto join = [](optional<set<u256>>& _locations, optional<set<u256>> const& _otherLocations) {
+		if (_locations && _otherLocations)
+			_locations->insert(_otherLocations->begin(), _otherLocations->end());
+		else
+			_locations.reset();
+	};
+	join(storage, _other.storage);
+	join(memory, _other.memory);
+	return *this;
+}
+
+map<YulString, WrittenLocations> WrittenLocationsPropagator::writtenLocations(
+	Dialect const& _dialect,
+	Block const& _ast,
+	CallGraph const& _directCallGraph
+)
+{
+	map<YulString, WrittenLocations> directLocations;
+	for (auto const& [name, function]: allFunctionDefinitions(_ast))
+		directLocations[name] = DirectWrittenLocationsCollector{_dialect, *function}.locations;
+
+	map<YulString, WrittenLocations> ret;
+	for (auto const& direct: directLocations)
+	{
+		YulString name = direct.first;
+		WrittenLocations locations;
+		set<YulString> visited;
+		auto _visit = [&](YulString _function, auto&& _recurse) -> void {
+			if (_dialect.builtin(_function) || !visited.insert(_function).second)
 				return;
-			if (sideEffects == SideEffects::worst())
+			if (!locations.storage && !locations.memory)
 				return;
-			if (BuiltinFunction const* f = _dialect.builtin(_function))
-				sideEffects += f->sideEffects;
-			else
+			if (directLocations.count(_function) && _directCallGraph.functionCalls.count(_function))
 			{
-				if (ret.count(_function))
-					sideEffects += ret[_function];
+				locations += directLocations.at(_function);
 				for (YulString callee: _directCallGraph.functionCalls.at(_function))
 					_recurse(callee, _recurse);
 			}
+			else
+				locations = WrittenLocations{nullopt, nullopt};
 		};
-		for (auto const& _v: call.second)
-			_visit(_v, _visit);
-		ret[funName] += sideEffects;
+		_visit(name, _visit);
+		ret[name] = move(locations);
 	}
 	return ret;
 }
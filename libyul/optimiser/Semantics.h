@@ -26,6 +26,10 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::yul
@@ -130,6 +134,39 @@ public:
 	);
 };
 
+/**
+ * Storage slots and memory offsets code writes to, if they are all known at compile time.
+ * A value of ``nullopt`` means that the code can write to arbitrary locations.
+ * Memory offsets denote the start of the 32-byte words written by ``mstore``.
+ */
+struct WrittenLocations
+{
+	std::optional<std::set<u256>> storage = std::set<u256>{};
+	std::optional<std::set<u256>> memory = std::set<u256>{};
+
+	/// Adds the locations written by another piece of code.
+	WrittenLocations& operator+=(WrittenLocations const& _other);
+};
+
+/**
+ * This class can be used to determine the storage slots and memory offsets that
+ * user-defined functions write to, including the writes of the functions they call.
+ *
+ * Only stores whose key is a literal or a variable that is declared with a literal
+ * and never re-assigned are recorded, any other write of a function results in ``nullopt``.
+ *
+ * Prerequisite: Disambiguator
+ */
+class WrittenLocationsPropagator
+{
+public:
+	static std::map<YulString, WrittenLocations> writtenLocations(
+		Dialect const& _dialect,
+		Block const& _ast,
+		CallGraph const& _directCallGraph
+	);
+};
+
 /**
  * Class that can be used to find out if certain code contains the MSize instruction
  * or a verbatim bytecode builtin (which is always assumed that it could contain MSize).
@@ -31,23 +31,78 @@
 
 #include <libevmasm/RuleList.h>
 
+#include <libsolutil/StringUtils.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Shapes of arguments, used to pre-select the rules that can match an expression.
+/// Operations are encoded as OperationShape plus the instruction.
+unsigned constexpr OtherShape = 0;
+unsigned constexpr ConstantShape = 1;
+unsigned constexpr OperationShape = 2;
+
+/// @returns the shape of the argument @a _argument, after resolving variables in the same way
+/// as Pattern::matches does, or nullopt if no rule can match an expression with this argument.
+optional<unsigned> argumentShape(
+	Expression const& _argument,
+	Dialect const& _dialect,
+	unordered_map<YulString, AssignedValue> const& _ssaValues
+)
+{
+	// Operation patterns reject direct function calls as arguments.
+	if (holds_alternative<FunctionCall>(_argument))
+		return nullopt;
+
+	Expression const* expr = &_argument;
+	if (Identifier const* identifier = get_if<Identifier>(&_argument))
+		if (AssignedValue const* value = util::valueOrNullptr(_ssaValues, identifier->name))
+			if (value->value)
+				expr = value->value;
+
+	if (Literal const* literal = get_if<Literal>(expr))
+		return literal->kind == LiteralKind::Number ? ConstantShape : OtherShape;
+	else if (auto instruction = SimplificationRules::instructionAndArguments(_dialect, *expr))
+		return OperationShape + uint8_t(instruction->first);
+	else
+		return OtherShape;
+}
+
+/// @returns true if @a _pattern can match an argument of the shape @a _shape.
+bool compatible(Pattern const& _pattern, unsigned _shape)
+{
+	switch (_pattern.kind())
+	{
+	case PatternKind::Any:
+		return true;
+	case PatternKind::Constant:
+		return _shape == ConstantShape;
+	case PatternKind::Operation:
+		return _shape == OperationShape + uint8_t(_pattern.instruction());
+	}
+	yulAssert(false, "");
+}
+
+}
+
 SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, AssignedValue> const& _ssaValues
+	unordered_map<YulString, AssignedValue> const& _ssaValues
 )
 {
 	auto instruction = instructionAndArguments(_dialect, _expr);
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// Matching stores state in the rules, so every thread needs its own copy.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,16 +114,44 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	vector<unsigned> argumentShapes;
+	argumentShapes.reserve(instruction->second->size());
+	for (Expression const& argument: *instruction->second)
+		if (optional<unsigned> shape = argumentShape(argument, _dialect, _ssaValues))
+			argumentShapes.push_back(*shape);
+		else
+			return nullptr;
+
+	for (Rule const* rule: rules.candidateRules(instruction->first, argumentShapes))
 	{
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 	}
 	return nullptr;
 }
 
+vector<SimplificationRules::Rule const*> const& SimplificationRules::candidateRules(
+	Instruction _instruction,
+	vector<unsigned> const& _argumentShapes
+)
+{
+	auto [it, inserted] = m_candidateRules.try_emplace({_instruction, _argumentShapes});
+	if (inserted)
+		for (Rule const& rule: m_rules[uint8_t(_instruction)])
+		{
+			vector<Pattern> const& arguments = rule.pattern.arguments();
+			assertThrow(arguments.size() == _argumentShapes.size(), OptimizerException, "");
+			bool candidate = true;
+			for (size_t i = 0; i < arguments.size() && candidate; ++i)
+				candidate = compatible(arguments[i], _argumentShapes[i]);
+			if (candidate)
+				it->second.push_back(&rule);
+		}
+	return it->second;
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -128,7 +211,7 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, evmasm::MatchGroups<Expression>& _matchGroups)
 {
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
@@ -137,7 +220,7 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, AssignedValue> const& _ssaValues
+	unordered_map<YulString, AssignedValue> const& _ssaValues
 ) const
 {
 	Expression const* expr = &_expr;
@@ -160,7 +243,7 @@ bool Pattern::matches(
 		Literal const& literal = std::get<Literal>(*expr);
 		if (literal.kind != LiteralKind::Number)
 			return false;
-		if (m_data && *m_data != u256(literal.value.str()))
+		if (m_data && *m_data != valueOfNumberLiteral(literal))
 			return false;
 		assertThrow(m_arguments.empty(), OptimizerException, "");
 	}
@@ -260,6 +343,31 @@ Expression Pattern::toExpression(shared_ptr<DebugData const> const& _debugData)
 	assertThrow(false, OptimizerException, "Pattern of kind 'any', but no match group.");
 }
 
+string Pattern::toString() const
+{
+	string result;
+	switch (m_kind)
+	{
+	case PatternKind::Operation:
+	{
+		vector<string> arguments;
+		for (Pattern const& argument: m_arguments)
+			arguments.emplace_back(argument.toString());
+		result = instructionInfo(m_instruction).name + "(" + util::joinHumanReadable(arguments) + ")";
+		break;
+	}
+	case PatternKind::Constant:
+		result = m_data ? formatNumber(*m_data) : "CONSTANT";
+		break;
+	case PatternKind::Any:
+		result = "ANY";
+		break;
+	}
+	if (m_matchGroup)
+		result += "[" + to_string(m_matchGroup) + "]";
+	return result;
+}
+
 u256 Pattern::d() const
 {
 	return valueOfNumberLiteral(std::get<Literal>(matchGroupValue()));
@@ -34,6 +34,7 @@
 
 #include <functional>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace solidity::yul
@@ -62,7 +63,7 @@ public:
 	static Rule const* findFirstMatch(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, AssignedValue> const& _ssaValues
+		std::unordered_map<YulString, AssignedValue> const& _ssaValues
 	);
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
@@ -78,8 +79,18 @@ private:
 
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	/// @returns the rules for @a _instruction, in the order of the rule list, whose argument
+	/// patterns can match arguments of the given shapes (see argumentShape in the implementation).
+	/// The result is computed once per combination of shapes and then cached.
+	std::vector<Rule const*> const& candidateRules(
+		evmasm::Instruction _instruction,
+		std::vector<unsigned> const& _argumentShapes
+	);
+
+	evmasm::MatchGroups<Expression> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	/// Cache for candidateRules, indexed by instruction and argument shapes.
+	std::map<std::pair<evmasm::Instruction, std::vector<unsigned>>, std::vector<Rule const*>> m_candidateRules;
 };
 
 enum class PatternKind
@@ -114,15 +125,16 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, evmasm::MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
+	PatternKind kind() const { return m_kind; }
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, AssignedValue> const& _ssaValues
+		std::unordered_map<YulString, AssignedValue> const& _ssaValues
 	) const;
 
-	std::vector<Pattern> arguments() const { return m_arguments; }
+	std::vector<Pattern> const& arguments() const { return m_arguments; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
@@ -133,6 +145,10 @@ public:
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(std::shared_ptr<DebugData const> const& _debugData) const;
 
+	/// @returns a readable representation of the pattern, which is used to tell rules apart
+	/// in the counters of the optimizer (see SOL_OPTIMIZER_COUNT).
+	std::string toString() const;
+
 private:
 	Expression const& matchGroupValue() const;
 
@@ -141,7 +157,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	evmasm::MatchGroups<Expression>* m_matchGroups = nullptr;
 };
 
 }
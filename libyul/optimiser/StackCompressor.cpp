@@ -213,13 +213,75 @@ void eliminateVariables(
 	UnusedPruner::runUntilStabilised(_dialect, _block, _allowMSizeOptimization);
 }
 
+/// @returns the stack deficit of the main block (if @a _functions contains the empty name)
+/// and of the functions in @a _functions, as found by the compilability checker.
+/// The other functions are replaced by functions with the same signature and an empty
+/// body during the check. This is sufficient because the legacy code transform checks
+/// every function separately and only needs to know the signature of called functions.
+/// Requires the code to be grouped by the function grouper.
+map<YulString, int> stackDeficit(
+	Dialect const& _dialect,
+	Object& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functions
+)
+{
+	Object reducedObject;
+	reducedObject.name = _object.name;
+	reducedObject.subObjects = _object.subObjects;
+	reducedObject.subIndexByName = _object.subIndexByName;
+	reducedObject.code = make_shared<Block>(Block{_object.code->debugData, {}});
+
+	// The checked code is moved into the reduced object and moved back afterwards.
+	vector<Statement>& statements = _object.code->statements;
+	vector<Statement>& reducedStatements = reducedObject.code->statements;
+	vector<size_t> movedStatements;
+	Block& mainBlock = std::get<Block>(statements.at(0));
+	if (_functions.count(YulString{}))
+	{
+		movedStatements.emplace_back(0);
+		reducedStatements.emplace_back(std::move(mainBlock));
+	}
+	else
+		reducedStatements.emplace_back(Block{mainBlock.debugData, {}});
+	for (size_t i = 1; i < statements.size(); ++i)
+	{
+		auto& function = std::get<FunctionDefinition>(statements[i]);
+		if (_functions.count(function.name))
+		{
+			movedStatements.emplace_back(i);
+			reducedStatements.emplace_back(std::move(function));
+		}
+		else
+			reducedStatements.emplace_back(FunctionDefinition{
+				function.debugData,
+				function.name,
+				function.parameters,
+				function.returnVariables,
+				Block{function.body.debugData, {}}
+			});
+	}
+	ScopeGuard restoreStatements([&]() {
+		for (size_t i: movedStatements)
+			statements[i] = std::move(reducedStatements[i]);
+	});
+
+	map<YulString, int> deficit;
+	for (auto const& [name, functionDeficit]: CompilabilityChecker(_dialect, reducedObject, _optimizeStackAllocation).stackDeficit)
+		if (_functions.count(name))
+			deficit[name] = functionDeficit;
+	return deficit;
+}
+
 }
 
 bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	map<YulString, vector<StackLayoutGenerator::StackTooDeep>>* _remainingStackTooDeepErrors,
+	size_t _stackLayoutSearchBudget
 )
 {
 	yulAssert(
@@ -239,25 +301,56 @@ bool StackCompressor::run(
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
 		Block& mainBlock = std::get<Block>(_object.code->statements.at(0));
+		set<YulString> changedFunctions;
 		if (
-			auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, YulString{});
+			auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, YulString{}, _stackLayoutSearchBudget);
 			!stackTooDeepErrors.empty()
 		)
+		{
 			eliminateVariables(_dialect, mainBlock, stackTooDeepErrors, allowMSizeOptimzation);
+			changedFunctions.insert(YulString{});
+		}
 		for (size_t i = 1; i < _object.code->statements.size(); ++i)
 		{
 			auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
 			if (
-				auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, fun.name);
+				auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, fun.name, _stackLayoutSearchBudget);
 				!stackTooDeepErrors.empty()
 			)
+			{
 				eliminateVariables(_dialect, fun.body, stackTooDeepErrors, allowMSizeOptimzation);
+				changedFunctions.insert(fun.name);
+			}
+		}
+
+		if (_remainingStackTooDeepErrors)
+		{
+			// Functions without stack too deep errors were not changed and still have none.
+			_remainingStackTooDeepErrors->clear();
+			(*_remainingStackTooDeepErrors)[YulString{}];
+			if (!changedFunctions.empty())
+			{
+				yul::AsmAnalysisInfo changedAnalysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+				unique_ptr<CFG> changedCfg = ControlFlowGraphBuilder::build(changedAnalysisInfo, _dialect, *_object.code);
+				for (YulString function: changedFunctions)
+					if (
+						auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*changedCfg, function, _stackLayoutSearchBudget);
+						!stackTooDeepErrors.empty()
+					)
+						(*_remainingStackTooDeepErrors)[function] = move(stackTooDeepErrors);
+			}
 		}
 	}
 	else
+	{
+		// Only the code changed by eliminateVariables has to be checked again after the first iteration.
+		optional<set<YulString>> changedFunctions;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+			map<YulString, int> stackSurplus =
+				changedFunctions ?
+				stackDeficit(_dialect, _object, _optimizeStackAllocation, *changedFunctions) :
+				CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
 			if (stackSurplus.empty())
 				return true;
 
@@ -286,7 +379,9 @@ bool StackCompressor::run(
 					allowMSizeOptimzation
 				);
 			}
+			changedFunctions = util::keys(stackSurplus);
 		}
+	}
 	return false;
 }
 
@@ -23,8 +23,11 @@
 #pragma once
 
 #include <libyul/Object.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
 
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -45,12 +48,20 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// If the optimized code transform is used and @a _remainingStackTooDeepErrors is not null,
+	/// it is set to the stack too deep errors left after the compression, in the format of
+	/// StackLayoutGenerator::reportStackTooDeep. Only the functions that were changed are
+	/// analyzed again for that.
+	/// @param _stackLayoutSearchBudget the search budget of the stack layout generator the code
+	/// will be generated with, which is used to determine the stack too deep errors.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>>* _remainingStackTooDeepErrors = nullptr,
+		size_t _stackLayoutSearchBudget = 0
 	);
 };
 
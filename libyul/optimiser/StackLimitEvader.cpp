@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -31,17 +32,99 @@
 #include <libyul/Utilities.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/concat.hpp>
+#include <range/v3/view/map.hpp>
 #include <range/v3/view/take.hpp>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines conservative live ranges of the variables of a function and the positions of its function calls.
+ * Statements are numbered in the order of the code and the range of a variable spans the statements
+ * from its declaration to its last reference. The range of a variable declared outside of a loop and
+ * referenced inside of it is extended to the end of the loop. Parameters are live from the start of the
+ * function and return variables until its end. Nested function definitions are not visited.
+ */
+class VariableLiveRanges: public ASTWalker
+{
+public:
+	using Range = pair<size_t, size_t>;
+
+	/// Analyzes the body of @a _function or, if it is null, the statements of @a _code outside of functions.
+	VariableLiveRanges(FunctionDefinition const* _function, Block const& _code)
+	{
+		if (_function)
+		{
+			for (TypedName const& parameter: _function->parameters)
+				m_ranges[parameter.name] = {0, 0};
+			(*this)(_function->body);
+			for (TypedName const& returnVariable: _function->returnVariables)
+				m_ranges[returnVariable.name] = {0, numeric_limits<size_t>::max()};
+		}
+		else
+			(*this)(_code);
+
+		for (auto& [begin, end]: m_ranges | ranges::views::values)
+			for (auto const& [loopBegin, loopEnd]: m_loops)
+				if (begin < loopBegin && end >= loopBegin)
+					end = max(end, loopEnd);
+	}
+
+	/// @returns the live range of @a _variable.
+	Range const& range(YulString _variable) const { return m_ranges.at(_variable); }
+	/// @returns the positions of the calls to other functions.
+	vector<pair<size_t, YulString>> const& calls() const { return m_calls; }
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		if (Range* range = util::valueOrNullptr(m_ranges, _identifier.name))
+			range->second = max(range->second, m_position);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		for (TypedName const& variable: _varDecl.variables)
+			m_ranges[variable.name] = {m_position, m_position};
+	}
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		m_calls.emplace_back(m_position, _functionCall.functionName.name);
+		ASTWalker::operator()(_functionCall);
+	}
+	void operator()(ForLoop const& _forLoop) override
+	{
+		(*this)(_forLoop.pre);
+		size_t loopBegin = ++m_position;
+		visit(*_forLoop.condition);
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+		m_loops.emplace_back(loopBegin, m_position);
+	}
+	void operator()(FunctionDefinition const&) override {}
+	using ASTWalker::visit;
+	void visit(Statement const& _statement) override
+	{
+		++m_position;
+		ASTWalker::visit(_statement);
+	}
+
+private:
+	size_t m_position = 0;
+	map<YulString, Range> m_ranges;
+	vector<Range> m_loops;
+	vector<pair<size_t, YulString>> m_calls;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -72,7 +155,9 @@ struct MemoryOffsetAllocator
 
 		if (auto const* unreachables = util::valueOrNullptr(unreachableVariables, _function))
 		{
-			if (FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy))
+			vector<YulString> variables;
+			FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy);
+			if (functionDefinition)
 				if (
 					size_t totalArgCount = functionDefinition->returnVariables.size() + functionDefinition->parameters.size();
 					totalArgCount > 16
@@ -81,20 +166,62 @@ struct MemoryOffsetAllocator
 						functionDefinition->parameters,
 						functionDefinition->returnVariables
 					) | ranges::views::take(totalArgCount - 16))
-						slotAllocations[var.name] = requiredSlots++;
+						variables.emplace_back(var.name);
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
 			// assign a slot for them already.
 			for (YulString variable: *unreachables)
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
-				if (!variable.empty() && !slotAllocations.count(variable))
+				if (!variable.empty() && !slotAllocations.count(variable) && !util::contains(variables, variable))
+					variables.emplace_back(variable);
+
+			if (reuseSlots)
+				requiredSlots = std::max(allocateReusingSlots(VariableLiveRanges{functionDefinition, code}, variables), requiredSlots);
+			else
+				for (YulString variable: variables)
 					slotAllocations[variable] = requiredSlots++;
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
 	}
 
+	/// Assigns the lowest slot to each of @a _variables that is not used by another one of them with
+	/// an overlapping live range and, if a call to another function happens in its live range,
+	/// is not used by the called function.
+	/// Requires the slots of the called functions to be allocated already.
+	/// @returns the number of slots required by the variables.
+	uint64_t allocateReusingSlots(VariableLiveRanges const& _liveRanges, vector<YulString> _variables)
+	{
+		stable_sort(_variables.begin(), _variables.end(), [&](YulString _a, YulString _b) {
+			return _liveRanges.range(_a).first < _liveRanges.range(_b).first;
+		});
+
+		uint64_t requiredSlots = 0;
+		vector<YulString> allocated;
+		for (YulString variable: _variables)
+		{
+			auto const& [begin, end] = _liveRanges.range(variable);
+			uint64_t lowestSlot = 0;
+			for (auto const& [position, function]: _liveRanges.calls())
+				if (begin <= position && position <= end)
+					lowestSlot = std::max(lowestSlot, util::valueOrDefault(slotsRequiredForFunction, function, uint64_t(0)));
+
+			set<uint64_t> usedSlots;
+			for (YulString other: allocated)
+				if (auto const& [otherBegin, otherEnd] = _liveRanges.range(other); otherBegin <= end && begin <= otherEnd)
+					usedSlots.insert(slotAllocations.at(other));
+
+			uint64_t slot = lowestSlot;
+			while (usedSlots.count(slot))
+				++slot;
+			slotAllocations[variable] = slot;
+			allocated.emplace_back(variable);
+			requiredSlots = std::max(requiredSlots, slot + 1);
+		}
+		return requiredSlots;
+	}
+
 	/// Maps function names to the set of unreachable variables in that function.
 	/// An empty variable name means that the function has too many arguments or return variables.
 	map<YulString, set<YulString>> const& unreachableVariables;
@@ -102,6 +229,10 @@ struct MemoryOffsetAllocator
 	map<YulString, set<YulString>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	map<YulString, FunctionDefinition const*> const& functionDefinitions;
+	/// The code of the object.
+	Block const& code;
+	/// Whether variables whose live ranges do not overlap may share a memory slot.
+	bool reuseSlots = false;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	map<YulString, uint64_t> slotAllocations{};
@@ -132,7 +263,7 @@ void StackLimitEvader::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, _object);
 		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, *_object.code);
-		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg));
+		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg, _context.stackLayoutSearchBudget));
 	}
 	else
 		run(_context, _object, CompilabilityChecker{
@@ -195,11 +326,19 @@ void StackLimitEvader::run(
 
 	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_unreachableVariables,
+		callGraph.functionCalls,
+		functionDefinitions,
+		*_object.code,
+		_context.reuseMemorySlots
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
 	StackToMemoryMover::run(_context, reservedMemory, memoryOffsetAllocator.slotAllocations, requiredSlots, *_object.code);
+	SOL_OPTIMIZER_COUNT("stackLimitEvader/movedVariables", memoryOffsetAllocator.slotAllocations.size());
+	SOL_OPTIMIZER_COUNT("stackLimitEvader/memorySlots", requiredSlots);
 
 	reservedMemory += 32 * requiredSlots;
 	for (FunctionCall* memoryGuardCall: FunctionCallFinder::run(*_object.code, "memoryguard"_yulstring))
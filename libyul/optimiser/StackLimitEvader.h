@@ -41,6 +41,8 @@ struct Object;
  *
  * Offsets are assigned to the variables, s.t. on every path through the call graph each variable gets a unique offset
  * in memory. However, distinct paths through the call graph can use the same memory offsets for their variables.
+ * If ``reuseMemorySlots`` is set in the step context, variables with disjoint live ranges share offsets as well,
+ * and a variable only avoids the offsets of the functions that are called while it is live.
  *
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
@@ -24,6 +24,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
@@ -60,6 +61,7 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnswitcher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
@@ -73,6 +75,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -86,14 +89,24 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
-void OptimiserSuite::run(
+optional<string> OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string_view _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _parallelism,
+	map<YulString, GasMeter const*> const& _functionMeters,
+	size_t _inlinerGrowthBudget,
+	bool _reuseMemorySlots,
+	bool _rematerialiserGasCosts,
+	bool _storeKnowledgeAcrossCalls,
+	bool _storeKnowledgeInLoops,
+	size_t _maxCodeGrowth,
+	size_t _maxSteps,
+	size_t _stackLayoutSearchBudget
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -113,7 +126,14 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment, _parallelism};
+	if (_inlinerGrowthBudget > 0)
+		context.maxCodeSize = CodeSize::codeSizeIncludingFunctions(ast) * (100 + _inlinerGrowthBudget) / 100;
+	context.reuseMemorySlots = _reuseMemorySlots;
+	context.rematerialiserGasCosts = _rematerialiserGasCosts;
+	context.storeKnowledgeAcrossCalls = _storeKnowledgeAcrossCalls;
+	context.storeKnowledgeInLoops = _storeKnowledgeInLoops;
+	context.stackLayoutSearchBudget = _stackLayoutSearchBudget;
 
 	OptimiserSuite suite(context, Debug::None);
 
@@ -123,7 +143,15 @@ void OptimiserSuite::run(
 
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
+	suite.setGuard(
+		_maxCodeGrowth > 0 ? CodeSize::codeSizeIncludingFunctions(ast) * (100 + _maxCodeGrowth) / 100 : 0,
+		_maxSteps
+	);
 	suite.runSequence(_optimisationSequence, ast);
+	optional<string> guardTrip = suite.guardTrip();
+	suite.setGuard(0, 0);
+	if (guardTrip)
+		suite.runSequence(GuardFallbackSteps, ast);
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -143,17 +171,22 @@ void OptimiserSuite::run(
 	if (evmDialect)
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*evmDialect, *_meter}(ast);
+		ConstantOptimiser{*evmDialect, *_meter, _functionMeters}(ast);
 		if (usesOptimizedCodeGenerator)
 		{
+			// The stack limit evader uses the errors left by the stack compressor instead of
+			// generating the stack layouts of all functions again.
+			map<YulString, vector<StackLayoutGenerator::StackTooDeep>> stackTooDeepErrors;
 			StackCompressor::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
-				stackCompressorMaxIterations
+				stackCompressorMaxIterations,
+				&stackTooDeepErrors,
+				_stackLayoutSearchBudget
 			);
 			if (evmDialect->providesObjectAccess())
-				StackLimitEvader::run(suite.m_context, _object);
+				StackLimitEvader::run(suite.m_context, _object, stackTooDeepErrors);
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object);
@@ -171,6 +204,7 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, ast);
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+	return guardTrip;
 }
 
 namespace
@@ -195,42 +229,41 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopUnswitcher,
+		UnusedAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -262,6 +295,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnswitcher::name,                'W'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{Rematerialiser::name,                'm'},
@@ -329,6 +363,14 @@ void OptimiserSuite::validateSequence(string_view _stepAbbreviations)
 	assertThrow(nestingLevel == 0, OptimizerException, "Unbalanced brackets");
 }
 
+void OptimiserSuite::setGuard(size_t _maxCodeSize, size_t _maxSteps)
+{
+	m_maxCodeSize = _maxCodeSize;
+	m_maxSteps = _maxSteps;
+	m_stepsRun = 0;
+	m_guardTrip.reset();
+}
+
 void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
@@ -402,6 +444,7 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 	size_t codeSize = 0;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		uint64_t const astHashBefore = _repeatUntilStable ? ASTHasher::run(_ast) : 0;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
@@ -413,6 +456,10 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 		if (!_repeatUntilStable)
 			break;
 
+		// Nothing changed during this round, so further rounds would not change anything either.
+		if (ASTHasher::run(_ast) == astHashBefore)
+			break;
+
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
@@ -425,11 +472,42 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	uint64_t astHash = ASTHasher::run(_ast);
 	for (string const& step: _steps)
 	{
+		if (m_guardTrip)
+			return;
+		// Steps can take new names from the dispenser, so its state is part of their input.
+		pair<uint64_t, uint64_t> const state{astHash, m_context.dispenser.stateHash()};
+		auto unchangedState = m_unchangedStates.find(step);
+		if (unchangedState != m_unchangedStates.end() && unchangedState->second == state)
+		{
+			if (m_debug == Debug::PrintStep)
+				cout << "Skipping " << step << " (no changes since its last run)" << endl;
+			continue;
+		}
+
+		if (m_maxSteps > 0 && m_stepsRun == m_maxSteps)
+		{
+			m_guardTrip = "the limit of " + to_string(m_maxSteps) + " steps was reached before step \"" + step + "\"";
+			return;
+		}
+		++m_stepsRun;
+
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::Profiler::Timer timer("yulOptimizer", step);
+			allSteps().at(step)->run(m_context, _ast);
+		}
+
+		uint64_t const newASTHash = ASTHasher::run(_ast);
+		if (newASTHash == astHash)
+			m_unchangedStates[step] = state;
+		else if (m_maxCodeSize > 0 && CodeSize::codeSizeIncludingFunctions(_ast) > m_maxCodeSize)
+			m_guardTrip = "the code grew beyond the limit in step \"" + step + "\"";
+		astHash = newASTHash;
+
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -27,10 +27,12 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <string>
 #include <string_view>
 #include <memory>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -53,6 +55,10 @@ public:
 	/// Some of them (like whitespace) are ignored, others (like brackets) are a part of the syntax.
 	static constexpr char NonStepAbbreviations[] = " \n[]";
 
+	/// Cheap steps that are run instead of the rest of the user-supplied sequence once the
+	/// guard (see @a setGuard) stopped it, to clean up after the steps that did run.
+	static constexpr char GuardFallbackSteps[] = "ujmul";
+
 	enum class Debug
 	{
 		None,
@@ -62,23 +68,66 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
-	static void run(
+	/// @param _parallelism maximum number of threads used to process independent functions.
+	/// Does not influence the result.
+	/// @param _functionMeters gas meters to use instead of @a _meter for the constants
+	/// inside the given functions.
+	/// @param _inlinerGrowthBudget if nonzero, the maximum growth of the code through the full
+	/// inliner in percent of its size before optimisation.
+	/// @param _reuseMemorySlots if set, variables moved to memory by the stack limit evader
+	/// share memory slots if they are never live at the same time.
+	/// @param _rematerialiserGasCosts if set, the rematerialiser compares gas costs instead
+	/// of using fixed thresholds for the code cost.
+	/// @param _storeKnowledgeAcrossCalls if set, knowledge about storage and memory is kept
+	/// across calls to functions that only write to other constant locations.
+	/// @param _storeKnowledgeInLoops if set, knowledge about storage and memory is kept
+	/// at for loops for locations the loop does not write to.
+	/// @param _maxCodeGrowth if nonzero, the user-supplied sequence is stopped as soon as the
+	/// code grew by more than this many percent of its size before optimisation.
+	/// @param _maxSteps if nonzero, the user-supplied sequence is stopped before running
+	/// more than this many steps.
+	/// @param _stackLayoutSearchBudget the search budget of the stack layout generator the code
+	/// will be generated with, used to determine the stack too deep errors.
+	/// @returns a description of why and at which step the user-supplied sequence was stopped
+	/// and replaced by @a GuardFallbackSteps, if it was.
+	static std::optional<std::string> run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string_view _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _parallelism = 1,
+		std::map<YulString, GasMeter const*> const& _functionMeters = {},
+		size_t _inlinerGrowthBudget = 0,
+		bool _reuseMemorySlots = false,
+		bool _rematerialiserGasCosts = false,
+		bool _storeKnowledgeAcrossCalls = false,
+		bool _storeKnowledgeInLoops = false,
+		size_t _maxCodeGrowth = 0,
+		size_t _maxSteps = 0,
+		size_t _stackLayoutSearchBudget = 0
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
 	/// @throw OptimizerException if the sequence is invalid
 	static void validateSequence(std::string_view _stepAbbreviations);
 
+	/// Runs the given steps. A step is skipped if it did not change the AST the last time
+	/// it was run and the AST was not changed since then.
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs the given sequence. Bracketed subsequences are repeated until they no longer change
+	/// the AST or its code size, but at most MaxRounds times.
 	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
+	/// Lets @a runSequence stop running steps as soon as the code grows beyond @a _maxCodeSize
+	/// or before more than @a _maxSteps steps would run. Zero means no limit, so that
+	/// @a setGuard(0, 0) removes the guard. Resets the step count and the trip of the guard.
+	void setGuard(size_t _maxCodeSize, size_t _maxSteps);
+	/// @returns a description of why and at which step the guard stopped the steps, if it did.
+	std::optional<std::string> const& guardTrip() const { return m_guardTrip; }
+
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
@@ -86,6 +135,14 @@ public:
 private:
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	/// For each step, the hash (see ASTHasher) of the AST and the state hash of the name dispenser
+	/// the step was last run on without changing the AST. Steps are deterministic, so they can be
+	/// skipped if both hashes are unchanged.
+	std::map<std::string, std::pair<uint64_t, uint64_t>> m_unchangedStates;
+	size_t m_maxCodeSize = 0;
+	size_t m_maxSteps = 0;
+	size_t m_stepsRun = 0;
+	std::optional<std::string> m_guardTrip;
 };
 
 }
@@ -85,4 +85,11 @@ private:
 	std::map<YulString, std::size_t> m_identifiersRHS;
 };
 
+/// Equality function object for expressions based on SyntacticallyEqual, e.g. for use in
+/// unordered containers together with ExpressionHash.
+struct SyntacticallyEqualExpression
+{
+	bool operator()(Expression const& _lhs, Expression const& _rhs) const;
+};
+
 }
@@ -56,6 +56,8 @@ void VarNameCleaner::operator()(FunctionDefinition& _funDef)
 	m_usedNames = m_namesToKeep;
 	map<YulString, YulString> globalTranslatedNames;
 	swap(globalTranslatedNames, m_translatedNames);
+	map<YulString, size_t> globalNextSuffixes;
+	swap(globalNextSuffixes, m_nextSuffixes);
 
 	renameVariables(_funDef.parameters);
 	renameVariables(_funDef.returnVariables);
@@ -63,6 +65,7 @@ void VarNameCleaner::operator()(FunctionDefinition& _funDef)
 
 	swap(globalUsedNames, m_usedNames);
 	swap(globalTranslatedNames, m_translatedNames);
+	swap(globalNextSuffixes, m_nextSuffixes);
 
 	m_insideFunction = false;
 }
@@ -94,18 +97,28 @@ void VarNameCleaner::operator()(Identifier& _identifier)
 		_identifier.name = name->second;
 }
 
-YulString VarNameCleaner::findCleanName(YulString const& _name) const
+YulString VarNameCleaner::findCleanName(YulString const& _name)
 {
 	auto newName = stripSuffix(_name);
 	if (!isUsedName(newName))
 		return newName;
 
 	// create new name with suffix (by finding a free identifier)
-	for (size_t i = 1; i < numeric_limits<decltype(i)>::max(); ++i)
+	// Names are only ever added to m_usedNames, so the search can continue where the
+	// previous one for the same base name stopped.
+	size_t& nextSuffix = m_nextSuffixes.emplace(newName, 1).first->second;
+	string candidate = newName.str() + "_";
+	size_t const prefixLength = candidate.size();
+	for (size_t i = nextSuffix; i < numeric_limits<decltype(i)>::max(); ++i)
 	{
-		YulString newNameSuffixed = YulString{newName.str() + "_" + to_string(i)};
+		candidate.resize(prefixLength);
+		candidate += to_string(i);
+		YulString newNameSuffixed{candidate};
 		if (!isUsedName(newNameSuffixed))
+		{
+			nextSuffix = i + 1;
 			return newNameSuffixed;
+		}
 	}
 	yulAssert(false, "Exhausted by attempting to find an available suffix.");
 }
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Reports the changes of the gas costs recorded in semantic tests, per call and per setting.
+
+The gas expectations of the semantic tests (``// gas legacy: ...`` and so on) are the stored
+baseline. They are recorded for deployments (``constructor()``) and for each call, in every
+code generation and optimizer setting. This script compares the expectations in the working
+tree with the ones at a git revision and prints one row for every call whose gas cost changed.
+The contracts in ``semanticTests/externalContracts`` are a good corpus to restrict it to.
+
+Run from the root of the repository after updating the expectations with isoltest:
+
+  python3 scripts/semantic_test_gas_report.py --base origin/develop --path test/libsolidity/semanticTests/externalContracts
+
+With ``--max-increase`` the script returns with exit code 1 if any gas cost increased by more
+than the given percentage, so that it can be used to catch regressions.
+"""
+
+from argparse import ArgumentParser
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+import re
+import subprocess
+import sys
+
+GAS_EXPECTATION_REGEX = re.compile(r'^gas (?P<setting>\w+): (?P<gas>\d+)$')
+
+# The key of a call is the call as written in the test without its expected result, and the number
+# of times the same call occurred before, so that repeated calls can be told apart.
+CallKey = Tuple[str, int]
+
+
+@dataclass(frozen=True)
+class GasChange:
+    source: str
+    call: str
+    setting: str
+    old: Optional[int]
+    new: Optional[int]
+
+    @property
+    def percentage(self) -> Optional[float]:
+        if not self.old or self.new is None:
+            return None
+        return (self.new - self.old) / self.old * 100
+
+
+def parse_gas_expectations(test_source: str) -> Dict[CallKey, Dict[str, int]]:
+    """Returns the gas expectations of the calls in the expectations of a semantic test, by call and setting."""
+    expectations: Dict[CallKey, Dict[str, int]] = {}
+    occurrences: Dict[str, int] = {}
+    in_expectations = False
+    current_call: Optional[CallKey] = None
+    for line in test_source.splitlines():
+        line = line.strip()
+        if line == '// ----':
+            in_expectations = True
+            continue
+        if not in_expectations or not line.startswith('//'):
+            continue
+
+        content = line[2:].strip()
+        gas_match = GAS_EXPECTATION_REGEX.match(content)
+        if gas_match:
+            if current_call is not None:
+                expectations[current_call][gas_match.group('setting')] = int(gas_match.group('gas'))
+        elif content != '' and not content.startswith(('~', '->', '#')):
+            # Side effects, continued results and comments belong to the previous call.
+            call = content.split('->')[0].strip()
+            current_call = (call, occurrences.get(call, 0))
+            occurrences[call] = occurrences.get(call, 0) + 1
+            expectations[current_call] = {}
+    return expectations
+
+
+def compare_gas_expectations(source: str, old_test: str, new_test: str) -> List[GasChange]:
+    old_expectations = parse_gas_expectations(old_test)
+    new_expectations = parse_gas_expectations(new_test)
+    changes = []
+    for call_key in list(new_expectations) + [key for key in old_expectations if key not in new_expectations]:
+        old_costs = old_expectations.get(call_key, {})
+        new_costs = new_expectations.get(call_key, {})
+        for setting in sorted(set(old_costs) | set(new_costs)):
+            if old_costs.get(setting) != new_costs.get(setting):
+                changes.append(GasChange(source, call_key[0], setting, old_costs.get(setting), new_costs.get(setting)))
+    return changes
+
+
+def changed_test_files(base: str, path: str) -> List[str]:
+    output = subprocess.check_output(
+        ['git', 'diff', '--name-only', base, '--', path],
+        universal_newlines=True
+    )
+    return [file_name for file_name in output.splitlines() if file_name.endswith('.sol')]
+
+
+def file_at_revision(revision: str, file_name: str) -> str:
+    try:
+        return subprocess.check_output(
+            ['git', 'show', f'{revision}:{file_name}'],
+            universal_newlines=True,
+            stderr=subprocess.DEVNULL
+        )
+    except subprocess.CalledProcessError:
+        # The test did not exist at the revision.
+        return ''
+
+
+def format_table(changes: List[GasChange]) -> str:
+    def format_gas(gas: Optional[int]) -> str:
+        return '-' if gas is None else str(gas)
+
+    def format_percentage(percentage: Optional[float]) -> str:
+        return '-' if percentage is None else f'{percentage:+.2f}'
+
+    rows = [['File name', 'Call', 'Setting', 'Old', 'New', 'Change (%)']]
+    rows += [
+        [
+            change.source,
+            change.call.replace('|', '\\|'),
+            change.setting,
+            format_gas(change.old),
+            format_gas(change.new),
+            format_percentage(change.percentage),
+        ]
+        for change in changes
+    ]
+    widths = [max(len(row[column]) for row in rows) for column in range(len(rows[0]))]
+    lines = ['| ' + ' | '.join(cell.ljust(width) for cell, width in zip(row, widths)) + ' |' for row in rows]
+    lines.insert(1, '|' + '|'.join('-' * (width + 2) for width in widths) + '|')
+    return '\n'.join(lines)
+
+
+def main() -> int:
+    parser = ArgumentParser(description="Reports the changes of the gas costs recorded in semantic tests.")
+    parser.add_argument('--base', default='origin/develop', help="The git revision to compare against.")
+    parser.add_argument(
+        '--path',
+        default='test/libsolidity/semanticTests',
+        help="The directory or test file to consider."
+    )
+    parser.add_argument('--setting', action='append', help="Only report this setting, e.g. irOptimized. Can be repeated.")
+    parser.add_argument(
+        '--max-increase',
+        type=float,
+        help="Return with exit code 1 if a gas cost increased by more than this percentage."
+    )
+    options = parser.parse_args()
+
+    changes = []
+    for file_name in changed_test_files(options.base, options.path):
+        new_test = Path(file_name).read_text(encoding='utf-8') if Path(file_name).exists() else ''
+        old_test = file_at_revision(options.base, file_name)
+        changes += compare_gas_expectations(
+            file_name.split('/', 3)[-1],
+            old_test,
+            new_test
+        )
+    if options.setting:
+        changes = [change for change in changes if change.setting in options.setting]
+
+    if not changes:
+        print("No differences found.")
+        return 0
+    print(format_table(changes))
+
+    if options.max_increase is not None:
+        regressions = [
+            change for change in changes
+            if change.percentage is not None and change.percentage > options.max_increase
+        ]
+        if regressions:
+            print(f"\n{len(regressions)} gas costs increased by more than {options.max_increase}%.", file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
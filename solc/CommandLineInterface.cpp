@@ -57,10 +57,16 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <memory>
+#include <sstream>
 
 #include <range/v3/view/map.hpp>
 
@@ -422,6 +428,60 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+void CommandLineInterface::handleTimeReport()
+{
+	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
+	solAssert(m_compiler->profiler(), "");
+
+	serr() << "Time report:" << endl;
+	for (auto const& [context, entries]: m_compiler->profiler()->entries())
+	{
+		serr() << (context.empty() ? "General" : context) << ":" << endl;
+		for (auto const& [phase, entry]: entries)
+		{
+			ostringstream time;
+			time << fixed << setprecision(3) << chrono::duration<double, milli>(entry.time).count();
+			serr() <<
+				"   " << phase << ":\t" << time.str() << " ms" <<
+				" (" << entry.count << (entry.count == 1 ? " call" : " calls") << ")" << endl;
+		}
+	}
+}
+
+void CommandLineInterface::handleModelCheckerStatistics()
+{
+	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
+	solAssert(m_compiler->modelCheckerStatistics(), "");
+
+	auto formatTime = [](smt::Statistics::Duration _time) {
+		ostringstream time;
+		time << fixed << setprecision(3) << chrono::duration<double, milli>(_time).count();
+		return time.str() + " ms";
+	};
+
+	serr() << "Model checker statistics:" << endl;
+	for (smt::Statistics::Target const& target: m_compiler->modelCheckerStatistics()->targets())
+	{
+		serr() << "   " << target.engine << " " << target.type;
+		if (target.location.sourceName && target.location.start >= 0)
+		{
+			LineColumn start = m_compiler->charStream(*target.location.sourceName).translatePositionToLineColumn(target.location.start);
+			serr() << " at " << *target.location.sourceName << ":" << (start.line + 1) << ":" << (start.column + 1);
+		}
+		serr() <<
+			": " << target.outcome << (target.cached ? " (cached)" : "") <<
+			", " << target.queries << (target.queries == 1 ? " query" : " queries") <<
+			", size " << target.size <<
+			", " << formatTime(target.time) << endl;
+	}
+	for (auto const& [engine, totals]: m_compiler->modelCheckerStatistics()->totals())
+		serr() <<
+			"Total " << engine << ": " <<
+			totals.targets << (totals.targets == 1 ? " target" : " targets") << ", " <<
+			totals.queries << (totals.queries == 1 ? " query" : " queries") << ", " <<
+			formatTime(totals.time) << endl;
+}
+
 void CommandLineInterface::readInputFiles()
 {
 	solAssert(!m_standardJsonInput.has_value(), "");
@@ -519,6 +579,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		!m_options.input.standardJsonServer &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -555,18 +616,27 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+void CommandLineInterface::createFile(string const& _fileName, string _data)
 {
 	namespace fs = boost::filesystem;
 
 	solAssert(!m_options.output.dir.empty(), "");
 
+	string pathName = (m_options.output.dir / _fileName).string();
+	if (m_filesToWrite.has_value())
+	{
+		// A file collected earlier would already exist if the files were written one by one.
+		if (m_filesToWrite->count(_fileName) && !m_options.output.overwriteFiles)
+			solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
+		(*m_filesToWrite)[_fileName] = move(_data);
+		return;
+	}
+
 	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
 	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
 	// The simplest workaround is to use an absolute path.
 	fs::create_directories(fs::absolute(m_options.output.dir));
 
-	string pathName = (m_options.output.dir / _fileName).string();
 	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
@@ -576,6 +646,26 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
 }
 
+void CommandLineInterface::writeCollectedFiles()
+{
+	solAssert(m_filesToWrite.has_value(), "");
+
+	vector<pair<string, string>> files(
+		make_move_iterator(m_filesToWrite->begin()),
+		make_move_iterator(m_filesToWrite->end())
+	);
+	m_filesToWrite.reset();
+	if (files.empty())
+		return;
+
+	boost::filesystem::create_directories(boost::filesystem::absolute(m_options.output.dir));
+	// The files are independent, so they are written in parallel. If writing some of them fails,
+	// the error about the first one by name is reported.
+	parallelForEach(files.size(), m_options.output.jobs, [&](size_t _index) {
+		createFile(files[_index].first, move(files[_index].second));
+	});
+}
+
 void CommandLineInterface::createJson(string const& _fileName, string const& _json)
 {
 	createFile(boost::filesystem::basename(_fileName) + string(".json"), _json);
@@ -639,9 +729,17 @@ void CommandLineInterface::processInput()
 		break;
 	case InputMode::StandardJson:
 	{
+		if (m_options.input.standardJsonServer)
+		{
+			serveStandardJson();
+			break;
+		}
 		solAssert(m_standardJsonInput.has_value(), "");
 
 		StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
+		compiler.setReadCallbackThreadSafe(true);
+		if (m_options.output.cacheDirectory.has_value())
+			compiler.setCacheDirectory(m_options.output.cacheDirectory.value());
 		sout() << compiler.compile(move(m_standardJsonInput.value())) << endl;
 		m_standardJsonInput.reset();
 		break;
@@ -694,13 +792,17 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.experimentalViaIR);
+		m_compiler->setSuppressedWarnings(m_options.formatting.suppressedWarnings);
+		m_compiler->setParallelism(m_options.output.jobs);
+		m_compiler->setReadCallbackThreadSafe(true);
+		m_compiler->enableProfiling(m_options.output.timeReport);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
 
-		m_compiler->enableIRGeneration(m_options.compiler.outputs.ir || m_options.compiler.outputs.irOptimized);
+		m_compiler->enableIRGeneration(m_options.compiler.outputs.ir, m_options.compiler.outputs.irOptimized);
 		m_compiler->enableEwasmGeneration(m_options.compiler.outputs.ewasm);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
@@ -752,12 +854,18 @@ void CommandLineInterface::compile()
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
 
-		for (auto const& error: m_compiler->errors())
+		if (!m_compiler->errors().empty())
 		{
 			m_hasOutput = true;
-			formatter.printErrorInformation(*error);
+			formatter.printErrorInformation(m_compiler->errors(), m_options.output.jobs);
 		}
 
+		if (m_options.output.timeReport)
+			handleTimeReport();
+
+		if (m_compiler->modelCheckerStatistics())
+			handleModelCheckerStatistics();
+
 		if (!successful && !m_options.input.errorRecovery)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -790,89 +898,148 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_options.compiler.combinedJsonRequests.has_value())
 		return;
 
-	Json::Value output(Json::objectValue);
-
-	output[g_strVersion] = frontend::VersionString;
-	vector<string> contracts = m_compiler->contractNames();
-
-	if (!contracts.empty())
-		output[g_strContracts] = Json::Value(Json::objectValue);
-	for (string const& contractName: contracts)
-	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
+	auto contractJson = [&](string const& _contractName) {
+		Json::Value contractData(Json::objectValue);
 		if (m_options.compiler.combinedJsonRequests->abi)
-			contractData[g_strAbi] = m_compiler->contractABI(contractName);
+			contractData[g_strAbi] = m_compiler->contractABI(_contractName);
 		if (m_options.compiler.combinedJsonRequests->metadata)
-			contractData["metadata"] = m_compiler->metadata(contractName);
+			contractData["metadata"] = m_compiler->metadata(_contractName);
 		if (m_options.compiler.combinedJsonRequests->binary && m_compiler->compilationSuccessful())
-			contractData[g_strBinary] = m_compiler->object(contractName).toHex();
+			contractData[g_strBinary] = m_compiler->object(_contractName).toHex();
 		if (m_options.compiler.combinedJsonRequests->binaryRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
+			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(_contractName).toHex();
 		if (m_options.compiler.combinedJsonRequests->opcodes && m_compiler->compilationSuccessful())
-			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
+			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(_contractName).bytecode);
 		if (m_options.compiler.combinedJsonRequests->asm_ && m_compiler->compilationSuccessful())
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
+			contractData[g_strAsm] = m_compiler->assemblyJSON(_contractName);
 		if (m_options.compiler.combinedJsonRequests->storageLayout && m_compiler->compilationSuccessful())
-			contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
+			contractData[g_strStorageLayout] = m_compiler->storageLayout(_contractName);
 		if (m_options.compiler.combinedJsonRequests->generatedSources && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSources] = m_compiler->generatedSources(contractName, false);
+			contractData[g_strGeneratedSources] = m_compiler->generatedSources(_contractName, false);
 		if (m_options.compiler.combinedJsonRequests->generatedSourcesRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(contractName, true);
+			contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(_contractName, true);
 		if (m_options.compiler.combinedJsonRequests->srcMap && m_compiler->compilationSuccessful())
 		{
-			auto map = m_compiler->sourceMapping(contractName);
+			auto map = m_compiler->sourceMapping(_contractName);
 			contractData[g_strSrcMap] = map ? *map : "";
 		}
 		if (m_options.compiler.combinedJsonRequests->srcMapRuntime && m_compiler->compilationSuccessful())
 		{
-			auto map = m_compiler->runtimeSourceMapping(contractName);
+			auto map = m_compiler->runtimeSourceMapping(_contractName);
 			contractData[g_strSrcMapRuntime] = map ? *map : "";
 		}
 		if (m_options.compiler.combinedJsonRequests->funDebug && m_compiler->compilationSuccessful())
 			contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->object(contractName).functionDebugData
+				m_compiler->object(_contractName).functionDebugData
 			);
 		if (m_options.compiler.combinedJsonRequests->funDebugRuntime && m_compiler->compilationSuccessful())
 			contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->runtimeObject(contractName).functionDebugData
+				m_compiler->runtimeObject(_contractName).functionDebugData
 			);
 		if (m_options.compiler.combinedJsonRequests->signatureHashes)
-			contractData[g_strSignatureHashes] = m_compiler->interfaceSymbols(contractName)["methods"];
+			contractData[g_strSignatureHashes] = m_compiler->interfaceSymbols(_contractName)["methods"];
 		if (m_options.compiler.combinedJsonRequests->natspecDev)
-			contractData[g_strNatspecDev] = m_compiler->natspecDev(contractName);
+			contractData[g_strNatspecDev] = m_compiler->natspecDev(_contractName);
 		if (m_options.compiler.combinedJsonRequests->natspecUser)
-			contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
-	}
+			contractData[g_strNatspecUser] = m_compiler->natspecUser(_contractName);
+		return removeNullMembers(std::move(contractData));
+	};
+	auto sourceJson = [&](string const& _sourceName) {
+		ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
+		Json::Value sourceData(Json::objectValue);
+		sourceData["AST"] = converter.toJson(m_compiler->ast(_sourceName));
+		return removeNullMembers(std::move(sourceData));
+	};
 
+	vector<string> contracts = m_compiler->contractNames();
 	bool needsSourceList =
 		m_options.compiler.combinedJsonRequests->ast ||
 		m_options.compiler.combinedJsonRequests->srcMap ||
 		m_options.compiler.combinedJsonRequests->srcMapRuntime;
+	Json::Value sourceList(Json::arrayValue);
 	if (needsSourceList)
-	{
 		// Indices into this array are used to abbreviate source names in source locations.
-		output[g_strSourceList] = Json::Value(Json::arrayValue);
-
 		for (auto const& source: m_compiler->sourceNames())
-			output[g_strSourceList].append(source);
+			sourceList.append(source);
+
+	if (m_options.formatting.json.format != JsonFormat::Compact)
+	{
+		Json::Value output(Json::objectValue);
+		output[g_strVersion] = frontend::VersionString;
+		if (!contracts.empty())
+			output[g_strContracts] = Json::Value(Json::objectValue);
+		for (string const& contractName: contracts)
+			output[g_strContracts][contractName] = contractJson(contractName);
+		if (needsSourceList)
+			output[g_strSourceList] = std::move(sourceList);
+		if (m_options.compiler.combinedJsonRequests->ast)
+		{
+			output[g_strSources] = Json::Value(Json::objectValue);
+			for (auto const& sourceCode: m_fileReader.sourceUnits())
+				output[g_strSources][sourceCode.first] = sourceJson(sourceCode.first);
+		}
+
+		string json = jsonPrint(std::move(output), m_options.formatting.json);
+		if (!m_options.output.dir.empty())
+			createJson("combined", json);
+		else
+			sout() << json << endl;
+		return;
 	}
 
+	// The compact serialisation does not depend on the nesting depth, so the entries of the
+	// contracts and sources are printed one at a time as soon as they are complete, in the order
+	// of the members of JSON objects. On the standard output, nothing but the current entry is kept.
+	string json;
+	auto emit = [&](string const& _data) {
+		if (!m_options.output.dir.empty())
+			json += _data;
+		else
+			sout() << _data;
+	};
+	auto emitName = [&](string const& _name) { emit(jsonCompactPrint(Json::Value(_name)) + ":"); };
+
+	emit("{");
+	if (!contracts.empty())
+	{
+		emitName(g_strContracts);
+		emit("{");
+		for (size_t index = 0; index < contracts.size(); ++index)
+		{
+			if (index > 0)
+				emit(",");
+			emitName(contracts[index]);
+			emit(jsonCompactPrint(contractJson(contracts[index])));
+		}
+		emit("},");
+	}
+	if (needsSourceList)
+	{
+		emitName(g_strSourceList);
+		emit(jsonCompactPrint(sourceList) + ",");
+	}
 	if (m_options.compiler.combinedJsonRequests->ast)
 	{
-		output[g_strSources] = Json::Value(Json::objectValue);
+		emitName(g_strSources);
+		emit("{");
+		bool first = true;
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
 		{
-			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			if (!first)
+				emit(",");
+			first = false;
+			emitName(sourceCode.first);
+			emit(jsonCompactPrint(sourceJson(sourceCode.first)));
 		}
+		emit("},");
 	}
+	emitName(g_strVersion);
+	emit(jsonCompactPrint(Json::Value(frontend::VersionString)) + "}");
 
-	string json = jsonPrint(removeNullMembers(std::move(output)), m_options.formatting.json);
 	if (!m_options.output.dir.empty())
 		createJson("combined", json);
 	else
-		sout() << json << endl;
+		sout() << endl;
 }
 
 void CommandLineInterface::handleAst()
@@ -911,17 +1078,85 @@ void CommandLineInterface::handleAst()
 
 void CommandLineInterface::serveLSP()
 {
-	lsp::IOStreamTransport transport;
-	if (!lsp::LanguageServer{transport}.run())
+	lsp::ThreadedTransport transport{make_unique<lsp::IOStreamTransport>()};
+	lsp::LanguageServer languageServer{transport};
+	if (m_options.output.cacheDirectory.has_value())
+		languageServer.setCacheDirectory(m_options.output.cacheDirectory.value());
+	if (!languageServer.run())
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::StandardJson && m_options.input.standardJsonServer);
+
+	StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
+	compiler.setReadCallbackThreadSafe(true);
+	if (m_options.output.cacheDirectory.has_value())
+		compiler.setCacheDirectory(m_options.output.cacheDirectory.value());
+
+	while (true)
+	{
+		// The headers are terminated by an empty line. Only Content-Length is used.
+		optional<size_t> contentLength;
+		bool headersSeen = false;
+		string line;
+		while (getline(m_sin, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (line.empty())
+			{
+				if (headersSeen)
+					break;
+				continue;
+			}
+			headersSeen = true;
+			size_t colon = line.find(':');
+			if (colon == string::npos || !boost::iequals(boost::trim_copy(line.substr(0, colon)), "Content-Length"))
+				continue;
+			string value = boost::trim_copy(line.substr(colon + 1));
+			size_t length = 0;
+			auto [end, error] = from_chars(value.data(), value.data() + value.size(), length);
+			if (
+				value.empty() ||
+				error != errc() ||
+				end != value.data() + value.size() ||
+				length > static_cast<size_t>(numeric_limits<streamsize>::max())
+			)
+				solThrow(CommandLineExecutionError, "Invalid Content-Length header: \"" + line + "\".");
+			contentLength = length;
+		}
+		if (!headersSeen)
+			return;
+		if (!contentLength.has_value())
+			solThrow(CommandLineExecutionError, "Standard JSON input without Content-Length header.");
+
+		// The body is read in chunks, so that the memory is only allocated for data that was actually sent.
+		string input;
+		for (size_t remaining = *contentLength; remaining > 0;)
+		{
+			char buffer[0x10000];
+			size_t const chunkSize = min(remaining, sizeof(buffer));
+			if (!m_sin.read(buffer, static_cast<streamsize>(chunkSize)))
+				solThrow(CommandLineExecutionError, "Standard input closed before the end of the Standard JSON input.");
+			input.append(buffer, chunkSize);
+			remaining -= chunkSize;
+		}
+
+		// Files read by the import callback are read again for every input, since they may have changed.
+		m_fileReader.setSourceUnits({});
+		string output = compiler.compile(move(input));
+		sout() << "Content-Length: " << output.size() << "\r\n\r\n" << output << flush;
+	}
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
 
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
+	// Map from how the libraries will be named inside the bytecode to the hex representation of their addresses.
+	map<string, string> librariesReplacements;
 	int const placeholderSize = 40; // 20 bytes or 40 hex characters
 	for (auto const& library: m_options.linker.libraries)
 	{
@@ -931,54 +1166,90 @@ void CommandLineInterface::link()
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		string addressHex = toHex(library.second.asBytes());
+		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = addressHex;
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = move(addressHex);
 	}
+	vector<string> placeholderHints;
+	for (auto const& library: m_options.linker.libraries)
+		placeholderHints.emplace_back("\n" + libraryPlaceholderHint(library.first));
 
 	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
+	vector<pair<string const, string>*> sources;
 	for (auto& src: sourceCodes)
-	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		sources.push_back(&src);
+
+	// The files are linked independently of each other, possibly in parallel. The warnings
+	// and the error of each file are only reported afterwards and in the order of the files,
+	// so that the output does not depend on the number of jobs.
+	vector<string> warnings(sources.size());
+	vector<exception_ptr> errors(sources.size());
+	parallelForEach(sources.size(), m_options.output.jobs, [&](size_t _index) {
+		try
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
-			)
-				solThrow(
-					CommandLineExecutionError,
-					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
-					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
-				);
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
-			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+			linkFile(sources[_index]->first, sources[_index]->second, librariesReplacements, placeholderHints, warnings[_index]);
+		}
+		catch (...)
+		{
+			errors[_index] = current_exception();
 		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+	});
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		if (!warnings[i].empty())
+			serr() << warnings[i];
+		if (errors[i])
+			rethrow_exception(errors[i]);
 	}
 	m_fileReader.setSourceUnits(move(sourceCodes));
 }
 
+void CommandLineInterface::linkFile(
+	string const& _fileName,
+	string& _code,
+	map<string, string> const& _librariesReplacements,
+	vector<string> const& _placeholderHints,
+	string& _warnings
+)
+{
+	int const placeholderSize = 40; // 20 bytes or 40 hex characters
+	auto end = _code.end();
+	for (auto it = _code.begin(); it != end;)
+	{
+		while (it != end && *it != '_') ++it;
+		if (it == end) break;
+		if (
+			end - it < placeholderSize ||
+			*(it + 1) != '_' ||
+			*(it + placeholderSize - 2) != '_' ||
+			*(it + placeholderSize - 1) != '_'
+		)
+			solThrow(
+				CommandLineExecutionError,
+				"Error in binary object file " + _fileName + " at position " + to_string(it - _code.begin()) + "\n" +
+				'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
+			);
+
+		string foundPlaceholder(it, it + placeholderSize);
+		auto replacement = _librariesReplacements.find(foundPlaceholder);
+		if (replacement != _librariesReplacements.end())
+			copy(replacement->second.begin(), replacement->second.end(), it);
+		else
+			_warnings += "Reference \"" + foundPlaceholder + "\" in file \"" + _fileName + "\" still unresolved.\n";
+		it += placeholderSize;
+	}
+	// Remove hints for resolved libraries.
+	for (string const& hint: _placeholderHints)
+		boost::algorithm::erase_all(_code, hint);
+	while (!_code.empty() && *prev(_code.end()) == '\n')
+		_code.resize(_code.size() - 1);
+}
+
 void CommandLineInterface::writeLinkedFiles()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
@@ -1123,6 +1394,11 @@ void CommandLineInterface::outputCompilationResults()
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
 
+	// The outputs are rendered sequentially, since the compiler stack computes some of them lazily,
+	// but with more than one job the files are written at the end in parallel.
+	if (!m_options.output.dir.empty() && m_options.output.jobs > 1)
+		m_filesToWrite.emplace();
+
 	handleCombinedJSON();
 
 	// do we need AST output?
@@ -1133,6 +1409,8 @@ void CommandLineInterface::outputCompilationResults()
 		m_options.output.stopAfter == CompilerStack::State::CompilationSuccessful
 	)
 	{
+		if (m_filesToWrite.has_value())
+			writeCollectedFiles();
 		serr() << endl << "Compilation halted after AST generation due to errors." << endl;
 		return;
 	}
@@ -1146,16 +1424,25 @@ void CommandLineInterface::outputCompilationResults()
 		// do we need EVM assembly?
 		if (m_options.compiler.outputs.asm_ || m_options.compiler.outputs.asmJson)
 		{
-			string ret;
-			if (m_options.compiler.outputs.asmJson)
-				ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
-			else
-				ret = m_compiler->assemblyString(contract, m_fileReader.sourceUnits());
-
 			if (!m_options.output.dir.empty())
+			{
+				string ret;
+				if (m_options.compiler.outputs.asmJson)
+					ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
+				else
+					ret = m_compiler->assemblyString(contract, m_fileReader.sourceUnits());
 				createFile(m_compiler->filesystemFriendlyName(contract) + (m_options.compiler.outputs.asmJson ? "_evm.json" : ".evm"), ret);
+			}
 			else
-				sout() << "EVM assembly:" << endl << ret << endl;
+			{
+				// The text assembly is written directly, without building the listing in memory first.
+				sout() << "EVM assembly:" << endl;
+				if (m_options.compiler.outputs.asmJson)
+					sout() << jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
+				else
+					m_compiler->assemblyStream(sout(), contract, m_fileReader.sourceUnits());
+				sout() << endl;
+			}
 		}
 
 		if (m_options.compiler.estimateGas)
@@ -1173,6 +1460,9 @@ void CommandLineInterface::outputCompilationResults()
 		handleNatspec(false, contract);
 	} // end of contracts iteration
 
+	if (m_filesToWrite.has_value())
+		writeCollectedFiles();
+
 	if (!m_hasOutput)
 	{
 		if (!m_options.output.dir.empty())
@@ -30,7 +30,9 @@
 #include <libyul/AssemblyStack.h>
 
 #include <iostream>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -83,7 +85,19 @@ private:
 	void printLicense();
 	void compile();
 	void serveLSP();
+	/// Compiles the Standard JSON inputs read from standard input until it is closed.
+	void serveStandardJson();
 	void link();
+	/// Replaces the link references in the hex code @a _code of the file @a _fileName by the
+	/// addresses in @a _librariesReplacements and removes the given placeholder hints.
+	/// Appends a warning to @a _warnings for each reference that remains unresolved.
+	static void linkFile(
+		std::string const& _fileName,
+		std::string& _code,
+		std::map<std::string, std::string> const& _librariesReplacements,
+		std::vector<std::string> const& _placeholderHints,
+		std::string& _warnings
+	);
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
 	static std::string libraryPlaceholderHint(std::string const& _libraryName);
@@ -108,6 +122,8 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleTimeReport();
+	void handleModelCheckerStatistics();
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
@@ -118,7 +134,9 @@ private:
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	void createFile(std::string const& _fileName, std::string _data);
+	/// Writes the files collected in m_filesToWrite on up to --jobs threads.
+	void writeCollectedFiles();
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -138,6 +156,8 @@ private:
 	std::ostream& m_serr;
 	bool m_hasOutput = false;
 	FileReader m_fileReader;
+	/// If set, createFile stores the contents of the files here by name instead of writing them.
+	std::optional<std::map<std::string, std::string>> m_filesToWrite;
 	std::optional<std::string> m_standardJsonInput;
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
 	CommandLineOptions m_options;
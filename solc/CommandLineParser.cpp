@@ -30,6 +30,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <charconv>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -42,6 +44,7 @@ static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strErrorRecovery = "error-recovery";
 static string const g_strEVM = "evm";
@@ -52,6 +55,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strDebugInfo = "debug-info";
@@ -63,13 +67,23 @@ static string const g_strLSP = "lsp";
 static string const g_strMachine = "machine";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
+static string const g_strModelCheckerContractTimeBudget = "model-checker-contract-time-budget";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
+static string const g_strModelCheckerCounterexampleLimit = "model-checker-counterexample-limit";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerInvariantHints = "model-checker-invariant-hints";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerPrintStats = "model-checker-print-stats";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
+static string const g_strModelCheckerSliceHornClauses = "model-checker-slice-horn-clauses";
+static string const g_strModelCheckerSolverMemoryLimit = "model-checker-solver-memory-limit";
+static string const g_strModelCheckerSolverProcesses = "model-checker-solver-processes";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerTimeBudget = "model-checker-time-budget";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
@@ -80,6 +94,8 @@ static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
+static string const g_strStackLayoutSearchBudget = "stack-layout-search-budget";
+static string const g_strTimeReport = "time-report";
 static string const g_strStopAfter = "stop-after";
 static string const g_strParsing = "parsing";
 
@@ -93,6 +109,7 @@ static set<string> const g_revertStringsArgs
 };
 
 static string const g_strSources = "sources";
+static string const g_strServer = "server";
 static string const g_strSourceList = "sourceList";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
@@ -104,6 +121,7 @@ static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
 static string const g_strErrorIds = "error-codes";
+static string const g_strSuppressWarnings = "suppress-warnings";
 
 /// Possible arguments to for --machine
 static set<string> const g_machineArgs
@@ -221,11 +239,15 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.includePaths == _other.input.includePaths &&
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
+		input.standardJsonServer == _other.input.standardJsonServer &&
 		input.errorRecovery == _other.input.errorRecovery &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
+		output.cacheDirectory == _other.output.cacheDirectory &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.experimentalViaIR == _other.output.experimentalViaIR &&
+		output.jobs == _other.output.jobs &&
+		output.timeReport == _other.output.timeReport &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -236,6 +258,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		formatting.json == _other.formatting.json &&
 		formatting.coloredOutput == _other.formatting.coloredOutput &&
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
+		formatting.suppressedWarnings == _other.formatting.suppressedWarnings &&
 		compiler.outputs == _other.compiler.outputs &&
 		compiler.estimateGas == _other.compiler.estimateGas &&
 		compiler.combinedJsonRequests == _other.compiler.combinedJsonRequests &&
@@ -245,6 +268,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.stackLayoutSearchBudget == _other.optimizer.stackLayoutSearchBudget &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -267,6 +291,9 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.yulSteps.has_value())
 		settings.yulOptimiserSteps = optimizer.yulSteps.value();
 
+	if (optimizer.stackLayoutSearchBudget.has_value())
+		settings.stackLayoutSearchBudget = optimizer.stackLayoutSearchBudget.value();
+
 	return settings;
 }
 
@@ -316,7 +343,15 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson && m_options.input.standardJsonServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted with --" + g_strServer + ". The inputs are read from standard input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -570,6 +605,13 @@ General Information)").c_str(),
 			g_strOverwrite.c_str(),
 			"Overwrite existing files (used together with -o)."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store compilation results in the given directory and reuse them when compiling "
+			"the same input again. Only available in --" + g_strStandardJSON + " and --" + g_strLSP + " mode. "
+			"The language server stores the symbols of the workspace in it.").c_str()
+		)
 		(
 			g_strEVMVersion.c_str(),
 			po::value<string>()->value_name("version")->default_value(EVMVersion{}.name()),
@@ -580,6 +622,21 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to compile contracts. "
+			"Currently only parsing, the control flow analysis of functions, the translation of the IR into EVM bytecode, "
+			"the verification targets of the model checker, the writing of the files in the output directory "
+			"and the linking of the files given to --link are done in parallel. "
+			"The output does not depend on this setting, except that the model checker uses separate solvers "
+			"for its verification targets if it is larger than 1."
+		)
+		(
+			g_strTimeReport.c_str(),
+			"Print the time spent in the phases of the compilation (per contract and per optimizer step) "
+			"to stderr."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(joinHumanReadable(g_revertStringsArgs, ",")),
@@ -607,6 +664,13 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Together with --" + g_strStandardJSON + ": Keep running and compile a stream of Standard JSON inputs "
+			"read from standard input until it is closed, which keeps the caches of the compiler warm. "
+			"Every input and output is preceded by a \"Content-Length: <bytes>\" header and an empty line, "
+			"as in the language server protocol.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -694,6 +758,12 @@ General Information)").c_str(),
 			g_strErrorIds.c_str(),
 			"Output error codes."
 		)
+		(
+			g_strSuppressWarnings.c_str(),
+			po::value<string>()->value_name("codes"),
+			"Do not report the warnings and infos with the given comma-separated error codes, "
+			"e.g. 2072,5740. Errors cannot be suppressed."
+		)
 	;
 	desc.add(outputFormatting);
 
@@ -773,11 +843,31 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strStackLayoutSearchBudget.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Evaluate up to n additional stack layouts at each conditional jump when generating code from Yul "
+			"with the optimizer enabled. Higher values can reduce stack shuffling at the cost of compilation time."
+		)
 	;
 	desc.add(optimizerOptions);
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Cache the results of the queries of the model checker in the given directory "
+			"and reuse them in later runs."
+		)
+		(
+			g_strModelCheckerContractTimeBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Limit the wall-clock time BMC spends on the verification targets of a contract, in milliseconds. "
+			"The targets are checked in the order of the size of their queries, the time left is shared "
+			"by the remaining targets and the targets that are reached after the time is used up are skipped. "
+			"Makes the results depend on the speed of the machine."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -785,6 +875,12 @@ General Information)").c_str(),
 			"Multiple pairs <source>:<contract> can be selected at the same time, separated by a comma "
 			"and no spaces."
 		)
+		(
+			g_strModelCheckerCounterexampleLimit.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Generate counterexamples only for the first n violated verification targets of every engine. "
+			"The targets found after that are reported as violated without a counterexample."
+		)
 		(
 			g_strModelCheckerDivModNoSlacks.c_str(),
 			"Encode division and modulo operations with their precise operators"
@@ -795,6 +891,11 @@ General Information)").c_str(),
 			po::value<string>()->value_name("all,bmc,chc,none")->default_value("none"),
 			"Select model checker engine."
 		)
+		(
+			g_strModelCheckerInvariantHints.c_str(),
+			("Store the invariants found by CHC in the directory given by --" + g_strModelCheckerCacheDir + " "
+			"and try to prove the targets of later runs with them before querying the Horn solver. Requires z3.").c_str()
+		)
 		(
 			g_strModelCheckerInvariants.c_str(),
 			po::value<string>()->value_name("default,all,contract,reentrancy")->default_value("default"),
@@ -802,10 +903,38 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerPrintStats.c_str(),
+			"Print the number of queries, their size, the solver time and the outcome "
+			"of every verification target checked by the model checker."
+		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run all selected solvers of BMC in parallel and use the answer of the solver that is fastest, "
+			"instead of querying them one after the other and reporting conflicting answers. "
+			"Counterexamples may then differ from run to run."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
 		)
+		(
+			g_strModelCheckerSliceHornClauses.c_str(),
+			"Query every CHC target in a solver of its own that only contains the Horn clauses "
+			"that can lead to the error of the target. Requires z3."
+		)
+		(
+			g_strModelCheckerSolverMemoryLimit.c_str(),
+			po::value<unsigned>()->value_name("MiB"),
+			("Limit the memory of every solver process started by --" + g_strModelCheckerSolverProcesses + ", in MiB.").c_str()
+		)
+		(
+			g_strModelCheckerSolverProcesses.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Answer the queries of the model checker by a pool of n z3 processes found in the search path, "
+			"which are sent SMT-LIB2 scripts, instead of the solvers linked into the compiler. "
+			"A solver process that fails only makes its query fail."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<string>()->value_name("all,cvc4,z3,smtlib2")->default_value("all"),
@@ -818,6 +947,13 @@ General Information)").c_str(),
 			"Multiple targets can be selected at the same time, separated by a comma and no spaces."
 			" By default all targets except underflow and overflow are selected."
 		)
+		(
+			g_strModelCheckerTimeBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			("Limit the wall-clock time the model checker spends on verification targets in the whole run, "
+			"in milliseconds. Targets are scheduled and skipped as with --" + g_strModelCheckerContractTimeBudget + ". "
+			"Makes the results depend on the speed of the machine.").c_str()
+		)
 		(
 			g_strModelCheckerTimeout.c_str(),
 			po::value<unsigned>()->value_name("ms"),
@@ -906,6 +1042,11 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Linker}},
+		{g_strTimeReport, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strSuppressWarnings, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::StandardJson, InputMode::LanguageServer}},
+		{g_strServer, {InputMode::StandardJson}},
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -921,6 +1062,10 @@ void CommandLineParser::processArgs()
 			joinOptionNames(invalidOptionsForCurrentInputMode)
 		);
 
+	if (m_args.count(g_strCacheDir))
+		m_options.output.cacheDirectory = m_args.at(g_strCacheDir).as<string>();
+	m_options.input.standardJsonServer = (m_args.count(g_strServer) > 0);
+
 	if (m_options.input.mode == InputMode::LanguageServer)
 		return;
 
@@ -953,7 +1098,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strStackLayoutSearchBudget})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -974,6 +1119,19 @@ void CommandLineParser::processArgs()
 
 	m_options.formatting.withErrorIds = m_args.count(g_strErrorIds);
 
+	if (m_args.count(g_strSuppressWarnings))
+	{
+		vector<string> errorCodes;
+		for (string const& errorCode: boost::split(errorCodes, m_args[g_strSuppressWarnings].as<string>(), boost::is_any_of(",")))
+		{
+			unsigned long long id = 0;
+			auto [end, error] = from_chars(errorCode.data(), errorCode.data() + errorCode.size(), id);
+			if (errorCode.empty() || error != errc() || end != errorCode.data() + errorCode.size())
+				solThrow(CommandLineValidationError, "Invalid error code in --" + g_strSuppressWarnings + ": \"" + errorCode + "\".");
+			m_options.formatting.suppressedWarnings.insert(ErrorId{id});
+		}
+	}
+
 	if (m_args.count(g_strRevertStrings))
 	{
 		string revertStringsString = m_args[g_strRevertStrings].as<string>();
@@ -1065,6 +1223,13 @@ void CommandLineParser::processArgs()
 		for (string const& library: m_args[g_strLibraries].as<vector<string>>())
 			parseLibraryOption(library);
 
+	if (m_args.count(g_strJobs))
+	{
+		m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
+		if (m_options.output.jobs == 0)
+			solThrow(CommandLineValidationError, "Option --" + g_strJobs + " must be at least 1.");
+	}
+
 	if (m_options.input.mode == InputMode::Linker)
 		return;
 
@@ -1103,6 +1268,9 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<string>();
 	}
 
+	if (m_args.count(g_strStackLayoutSearchBudget))
+		m_options.optimizer.stackLayoutSearchBudget = m_args[g_strStackLayoutSearchBudget].as<unsigned>();
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1192,6 +1360,9 @@ void CommandLineParser::processArgs()
 			solThrow(CommandLineValidationError, "Invalid option for --" + g_strMetadataHash + ": " + hashStr);
 	}
 
+	if (m_args.count(g_strModelCheckerCacheDir))
+		m_options.modelChecker.settings.cacheDirectory = m_args[g_strModelCheckerCacheDir].as<string>();
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		string contractsStr = m_args[g_strModelCheckerContracts].as<string>();
@@ -1201,6 +1372,12 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.contracts = move(*contracts);
 	}
 
+	if (m_args.count(g_strModelCheckerContractTimeBudget))
+		m_options.modelChecker.settings.contractTimeBudget = m_args[g_strModelCheckerContractTimeBudget].as<unsigned>();
+
+	if (m_args.count(g_strModelCheckerCounterexampleLimit))
+		m_options.modelChecker.settings.counterexampleLimit = m_args[g_strModelCheckerCounterexampleLimit].as<unsigned>();
+
 	if (m_args.count(g_strModelCheckerDivModNoSlacks))
 		m_options.modelChecker.settings.divModNoSlacks = true;
 
@@ -1213,6 +1390,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.engine = *engine;
 	}
 
+	if (m_args.count(g_strModelCheckerInvariantHints))
+		m_options.modelChecker.settings.invariantHints = true;
+
 	if (m_args.count(g_strModelCheckerInvariants))
 	{
 		string invsStr = m_args[g_strModelCheckerInvariants].as<string>();
@@ -1222,9 +1402,32 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerPrintStats))
+		m_options.modelChecker.settings.printStats = true;
+
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
+	if (m_args.count(g_strModelCheckerSliceHornClauses))
+		m_options.modelChecker.settings.sliceHornClauses = true;
+
+	if (m_args.count(g_strModelCheckerSolverMemoryLimit))
+	{
+		m_options.modelChecker.settings.solverMemoryLimit = m_args[g_strModelCheckerSolverMemoryLimit].as<unsigned>();
+		if (*m_options.modelChecker.settings.solverMemoryLimit == 0)
+			solThrow(CommandLineValidationError, "Option --" + g_strModelCheckerSolverMemoryLimit + " must be at least 1.");
+	}
+
+	if (m_args.count(g_strModelCheckerSolverProcesses))
+	{
+		m_options.modelChecker.settings.solverProcesses = m_args[g_strModelCheckerSolverProcesses].as<unsigned>();
+		if (*m_options.modelChecker.settings.solverProcesses == 0)
+			solThrow(CommandLineValidationError, "Option --" + g_strModelCheckerSolverProcesses + " must be at least 1.");
+	}
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		string solversStr = m_args[g_strModelCheckerSolvers].as<string>();
@@ -1243,20 +1446,34 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.targets = *targets;
 	}
 
+	if (m_args.count(g_strModelCheckerTimeBudget))
+		m_options.modelChecker.settings.timeBudget = m_args[g_strModelCheckerTimeBudget].as<unsigned>();
+
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCacheDir) ||
+		m_args.count(g_strModelCheckerContractTimeBudget) ||
 		m_args.count(g_strModelCheckerContracts) ||
+		m_args.count(g_strModelCheckerCounterexampleLimit) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
+		m_args.count(g_strModelCheckerInvariantHints) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerPrintStats) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
+		m_args.count(g_strModelCheckerSliceHornClauses) ||
+		m_args.count(g_strModelCheckerSolverMemoryLimit) ||
+		m_args.count(g_strModelCheckerSolverProcesses) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
+		m_args.count(g_strModelCheckerTimeBudget) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.experimentalViaIR = (m_args.count(g_strExperimentalViaIR) > 0);
+	m_options.output.timeReport = (m_args.count(g_strTimeReport) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
 
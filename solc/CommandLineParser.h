@@ -175,14 +175,19 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool errorRecovery = false;
+		/// Compile a stream of Standard JSON inputs read from standard input.
+		bool standardJsonServer = false;
 	} input;
 
 	struct
 	{
 		boost::filesystem::path dir;
 		bool overwriteFiles = false;
+		std::optional<boost::filesystem::path> cacheDirectory;
 		langutil::EVMVersion evmVersion;
 		bool experimentalViaIR = false;
+		unsigned jobs = 1;
+		bool timeReport = false;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -204,6 +209,7 @@ struct CommandLineOptions
 		util::JsonFormat json;
 		std::optional<bool> coloredOutput;
 		bool withErrorIds = false;
+		std::set<langutil::ErrorId> suppressedWarnings;
 	} formatting;
 
 	struct
@@ -225,6 +231,7 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		std::optional<unsigned> stackLayoutSearchBudget;
 	} optimizer;
 
 	struct
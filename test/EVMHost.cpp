@@ -42,7 +42,8 @@ using StorageMap = std::map<evmc::bytes32, evmc::storage_value>;
 evmc::VM& EVMHost::getVM(string const& _path)
 {
 	static evmc::VM NullVM{nullptr};
-	static map<string, unique_ptr<evmc::VM>> vms;
+	// Every thread uses VM instances of its own, so that tests can be run in parallel.
+	thread_local map<string, unique_ptr<evmc::VM>> vms;
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
@@ -144,6 +145,30 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 	reset();
 }
 
+EVMHost::State EVMHost::snapshot() const
+{
+	return State{
+		accounts,
+		tx_context,
+		recorded_calls,
+		recorded_logs,
+		recorded_selfdestructs,
+		recorded_account_accesses,
+		m_currentAddress
+	};
+}
+
+void EVMHost::restore(State _state)
+{
+	accounts = move(_state.accounts);
+	tx_context = _state.txContext;
+	recorded_calls = move(_state.recordedCalls);
+	recorded_logs = move(_state.recordedLogs);
+	recorded_selfdestructs = move(_state.recordedSelfdestructs);
+	recorded_account_accesses = move(_state.recordedAccountAccesses);
+	m_currentAddress = _state.currentAddress;
+}
+
 void EVMHost::reset()
 {
 	accounts.clear();
@@ -156,7 +181,7 @@ void EVMHost::reset()
 	recorded_account_accesses.clear();
 
 	// Mark all precompiled contracts as existing. Existing here means to have a balance (as per EIP-161).
-	// NOTE: keep this in sync with `EVMHost::call` below.
+	// NOTE: keep this in sync with `EVMHost::precompiledContract` below.
 	//
 	// A lot of precompile addresses had a balance before they became valid addresses for precompiles.
 	// For example all the precompile addresses allocated in Byzantium had a 1 wei balance sent to them
@@ -208,29 +233,19 @@ void EVMHost::recordCalls(evmc_message const& _message) noexcept
 evmc::result EVMHost::call(evmc_message const& _message) noexcept
 {
 	recordCalls(_message);
-	if (_message.destination == 0x0000000000000000000000000000000000000001_address)
-		return precompileECRecover(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000002_address)
-		return precompileSha256(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000003_address)
-		return precompileRipeMD160(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000004_address)
-		return precompileIdentity(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000005_address && m_evmVersion >= langutil::EVMVersion::byzantium())
-		return precompileModExp(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000006_address && m_evmVersion >= langutil::EVMVersion::byzantium())
-		return precompileALTBN128G1Add(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000007_address && m_evmVersion >= langutil::EVMVersion::byzantium())
-		return precompileALTBN128G1Mul(_message);
-	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
-		return precompileALTBN128PairingProduct(_message);
+	if (PrecompiledContract precompiled = precompiledContract(_message.destination))
+		return precompiled(_message);
 
 	auto const stateBackup = accounts;
 
 	u256 value{convertFromEVMC(_message.value)};
 	auto& sender = accounts[_message.sender];
 
-	evmc::bytes code;
+	// For calls, the code is shared with the code cache, which keeps it alive during execution.
+	// For contract creation, it is the input data of the message.
+	shared_ptr<evmc::bytes const> deployed;
+	uint8_t const* code = nullptr;
+	size_t codeSize = 0;
 
 	evmc_message message = _message;
 	if (message.depth == 0)
@@ -256,7 +271,8 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 			asBytes(to_string(sender.nonce++))
 		));
 		message.destination = convertToEVMC(createAddress);
-		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
+		code = message.input_data;
+		codeSize = message.input_size;
 	}
 	else if (message.kind == EVMC_CREATE2)
 	{
@@ -278,15 +294,17 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 			return result;
 		}
 
-		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
+		code = message.input_data;
+		codeSize = message.input_size;
 	}
-	else if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
+	else
 	{
-		code = accounts[message.destination].code;
-		message.destination = m_currentAddress;
+		deployed = deployedCode(accounts[message.destination]);
+		code = deployed->data();
+		codeSize = deployed->size();
+		if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
+			message.destination = m_currentAddress;
 	}
-	else
-		code = accounts[message.destination].code;
 
 	auto& destination = accounts[message.destination];
 
@@ -312,7 +330,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	evmc::address currentAddress = m_currentAddress;
 	m_currentAddress = message.destination;
-	evmc::result result = m_vm.execute(*this, m_evmRevision, message, code.data(), code.size());
+	evmc::result result = m_vm.execute(*this, m_evmRevision, message, code, codeSize);
 	m_currentAddress = currentAddress;
 
 	if (message.kind == EVMC_CREATE || message.kind == EVMC_CREATE2)
@@ -329,6 +347,8 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 			result.create_address = message.destination;
 			destination.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
 			destination.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
+			if (!destination.code.empty())
+				m_codeCache.emplace(destination.codehash, make_shared<evmc::bytes const>(destination.code));
 		}
 	}
 
@@ -338,6 +358,42 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	return result;
 }
 
+EVMHost::PrecompiledContract EVMHost::precompiledContract(evmc::address const& _address) const noexcept
+{
+	// NOTE: keep this in sync with `EVMHost::reset` above.
+	for (size_t i = 0; i + 1 < sizeof(_address.bytes); ++i)
+		if (_address.bytes[i])
+			return nullptr;
+
+	bool const byzantium = m_evmVersion >= langutil::EVMVersion::byzantium();
+	switch (_address.bytes[sizeof(_address.bytes) - 1])
+	{
+	case 1: return precompileECRecover;
+	case 2: return precompileSha256;
+	case 3: return precompileRipeMD160;
+	case 4: return precompileIdentity;
+	case 5: return byzantium ? precompileModExp : nullptr;
+	case 6: return byzantium ? precompileALTBN128G1Add : nullptr;
+	case 7: return byzantium ? precompileALTBN128G1Mul : nullptr;
+	case 8: return byzantium ? precompileALTBN128PairingProduct : nullptr;
+	default: return nullptr;
+	}
+}
+
+shared_ptr<evmc::bytes const> EVMHost::deployedCode(evmc::MockedAccount const& _account) noexcept
+{
+	static shared_ptr<evmc::bytes const> const noCode = make_shared<evmc::bytes const>();
+	if (_account.code.empty())
+		return noCode;
+
+	// The host sets the code hash of every account with code to the hash of its code,
+	// but we still compare the code before sharing it, in case a test changed it.
+	shared_ptr<evmc::bytes const>& cached = m_codeCache[_account.codehash];
+	if (!cached || *cached != _account.code)
+		cached = make_shared<evmc::bytes const>(_account.code);
+	return cached;
+}
+
 evmc::bytes32 EVMHost::get_block_hash(int64_t _number) const noexcept
 {
 	return convertToEVMC(u256("0x3737373737373737373737373737373737373737373737373737373737373737") + _number);
@@ -42,7 +42,8 @@ public:
 	using MockedHost::get_code_size;
 	using MockedHost::get_balance;
 
-	/// Tries to dynamically load an evmc vm supporting evm1 or ewasm and caches the loaded VM.
+	/// Tries to dynamically load an evmc vm supporting evm1 or ewasm and caches the loaded VM
+	/// for the current thread.
 	/// @returns vmc::VM(nullptr) on failure.
 	static evmc::VM& getVM(std::string const& _path = {});
 
@@ -53,8 +54,26 @@ public:
 	///          the second being true, if an evmc vm supporting ewasm was loaded properly.
 	static std::tuple<bool, bool> checkVmPaths(std::vector<boost::filesystem::path> const& _vmPaths);
 
+	/// The accounts, the block and the records of the host, which can be saved using snapshot()
+	/// and restored using restore(), e.g. to run several calls on the state after a deployment.
+	struct State
+	{
+		std::unordered_map<evmc::address, evmc::MockedAccount> accounts;
+		evmc_tx_context txContext = {};
+		std::vector<evmc_message> recordedCalls;
+		std::vector<log_record> recordedLogs;
+		std::vector<selfdestruct_record> recordedSelfdestructs;
+		std::vector<evmc::address> recordedAccountAccesses;
+		evmc::address currentAddress = {};
+	};
+
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
 
+	/// @returns a copy of the current state.
+	State snapshot() const;
+	/// Replaces the current state by @a _state, which has to be taken from a host with the same EVM version.
+	void restore(State _state);
+
 	void reset();
 	/// Clears EIP-2929 account and storage access indicator
 	void resetWarmAccess();
@@ -99,6 +118,14 @@ private:
 	/// Records calls made via @param _message.
 	void recordCalls(evmc_message const& _message) noexcept;
 
+	using PrecompiledContract = evmc::result (*)(evmc_message const&) noexcept;
+	/// @returns the precompiled contract at @a _address for the EVM version of the host
+	/// or nullptr if there is none.
+	PrecompiledContract precompiledContract(evmc::address const& _address) const noexcept;
+	/// @returns the code of @a _account, shared with all accounts that have the same code hash.
+	/// The code stays alive even if the account is modified or removed.
+	std::shared_ptr<evmc::bytes const> deployedCode(evmc::MockedAccount const& _account) noexcept;
+
 	static evmc::result precompileECRecover(evmc_message const& _message) noexcept;
 	static evmc::result precompileSha256(evmc_message const& _message) noexcept;
 	static evmc::result precompileRipeMD160(evmc_message const& _message) noexcept;
@@ -117,6 +144,9 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	// EVM version requested from EVMC (matches the above)
 	evmc_revision m_evmRevision;
+	/// Deployed code by code hash, so that repeated calls to a contract do not copy its code.
+	/// Since it is keyed by content, it is neither part of the state nor cleared by reset().
+	std::unordered_map<evmc::bytes32, std::shared_ptr<evmc::bytes const>> m_codeCache;
 };
 
 class EVMHostPrinter
@@ -59,11 +59,11 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	// PushImmutable
 	_subAsm.appendImmutable("someImmutable");
@@ -189,8 +189,8 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				NumSubs +                  // PUSH <addr> for every sub assembly
 				1;                         // INVALID
 
-			auto assemblyName = make_shared<string>("root.asm");
-			auto subName = make_shared<string>("sub.asm");
+			auto assemblyName = internSourceName("root.asm");
+			auto subName = internSourceName("sub.asm");
 
 			map<string, unsigned> indices = {
 				{ *assemblyName, 0 },
@@ -257,11 +257,11 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
 	_subAsm.appendImmutable("someOtherImmutable");
@@ -365,6 +365,50 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_optimisation_of_subs)
+{
+	auto createSub = [](u256 const& _value) {
+		shared_ptr<Assembly> sub = make_shared<Assembly>();
+		for (unsigned i = 0; i < 3; ++i)
+		{
+			sub->append(AssemblyItem(_value));
+			sub->append(AssemblyItem(u256(1)));
+			sub->append(Instruction::ADD);
+			sub->append(Instruction::POP);
+		}
+		sub->append(Instruction::STOP);
+		return sub;
+	};
+	auto createAssembly = [&](bool _shareSub) {
+		shared_ptr<Assembly> root = make_shared<Assembly>();
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			root->appendSubroutine(createSub(u256(i) << 200));
+			root->append(Instruction::POP);
+		}
+		if (_shareSub)
+		{
+			// Reachable in two ways: as a sub-assembly of the root and of its first sub-assembly.
+			shared_ptr<Assembly> shared = createSub(u256(-1));
+			root->appendSubroutine(shared);
+			root->append(Instruction::POP);
+			root->sub(0).appendSubroutine(shared);
+		}
+		root->append(Instruction::STOP);
+		return root;
+	};
+	Assembly::OptimiserSettings settings{true, true, false, true, true, false, true, true, false, true, EVMVersion{}, 200, 0};
+
+	for (bool shareSub: {false, true})
+	{
+		shared_ptr<Assembly> serial = createAssembly(shareSub);
+		serial->optimise(settings);
+		shared_ptr<Assembly> parallel = createAssembly(shareSub);
+		parallel->optimise(settings, 4);
+		BOOST_CHECK_EQUAL(parallel->assemble().toHex(), serial->assemble().toHex());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
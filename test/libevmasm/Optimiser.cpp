@@ -25,10 +25,12 @@
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/Superoptimiser.h>
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -975,6 +977,41 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_iterated)
+{
+	// Blocks 1 and 2 only become identical after blocks 3 and 4 have been unified.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(5),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(5),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		u256(6),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 4),
+		u256(6),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+
+	set<u256> pushTags;
+	for (AssemblyItem const& item: input)
+		if (item.type() == PushTag)
+			pushTags.insert(item.data());
+	BOOST_CHECK(pushTags == (set<u256>{1, 3}));
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1310,6 +1347,55 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cse_across_conditional_jump)
+{
+	for (bool acrossBlocks: {false, true})
+	{
+		Assembly assembly;
+		AssemblyItem tag = assembly.newTag();
+		assembly.append(u256(7));
+		assembly.append(u256(0));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::CALLVALUE);
+		assembly.append(tag.pushTag());
+		assembly.append(Instruction::JUMPI);
+		// Only reachable from the conditional jump, so the value of slot 0 is known.
+		assembly.append(u256(0));
+		assembly.append(Instruction::SLOAD);
+		assembly.append(u256(1));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::STOP);
+		assembly.append(tag);
+		assembly.append(Instruction::STOP);
+
+		Assembly::OptimiserSettings settings;
+		settings.runCSE = true;
+		settings.runCSEAcrossBlocks = acrossBlocks;
+		settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+		assembly.optimise(settings);
+
+		bool containsSLoad = count(assembly.items().begin(), assembly.items().end(), AssemblyItem(Instruction::SLOAD)) > 0;
+		BOOST_CHECK_EQUAL(containsSLoad, !acrossBlocks);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cse_max_block_length)
+{
+	AssemblyItems input{
+		u256(1),
+		u256(2),
+		Instruction::ADD,
+		u256(3),
+		Instruction::MUL,
+		Instruction::POP
+	};
+	KnownState state;
+	CommonSubexpressionEliminator limited(state);
+	BOOST_CHECK(limited.feedItems(input.begin(), input.end(), false, 4) == input.begin() + 4);
+	CommonSubexpressionEliminator unlimited(state);
+	BOOST_CHECK(unlimited.feedItems(input.begin(), input.end(), false) == input.end());
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1688,6 +1774,55 @@ BOOST_AUTO_TEST_CASE(inliner)
 }
 
 
+BOOST_AUTO_TEST_CASE(inliner_with_side_effects)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems const items{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::LOG0,
+		jumpOutOf,
+	};
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::LOG0,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::LOG0,
+		jumpOutOf,
+	};
+
+	// LOG0 ends the block, so the function is not considered by default.
+	AssemblyItems withoutSideEffects = items;
+	Inliner{withoutSideEffects, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		withoutSideEffects.begin(), withoutSideEffects.end(),
+		items.begin(), items.end()
+	);
+
+	AssemblyItems withSideEffects = items;
+	Inliner{withSideEffects, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}, true}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		withSideEffects.begin(), withSideEffects.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(inliner_no_inline_type)
 {
 	// Will not inline due to jump types.
@@ -1916,6 +2051,58 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_negated_decomposition)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	if (!evmVersion.hasBitwiseShifting())
+		return;
+
+	// The negation is as long as the value itself, but it is cheaper to compute.
+	u256 value = ~(u256(0x1234ff) << 0xe5);
+	AssemblyItems expectation{u256(0x1234ff), u256(0xe5), Instruction::SHL, Instruction::NOT};
+	Assembly assembly;
+	assembly.append(value);
+	ConstantOptimisationMethod::optimiseConstants(false, 200, evmVersion, assembly, true);
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		assembly.items().begin(), assembly.items().end(),
+		expectation.begin(), expectation.end()
+	);
+
+	// The negation is only tried if requested.
+	Assembly defaultAssembly;
+	defaultAssembly.append(value);
+	ConstantOptimisationMethod::optimiseConstants(false, 200, evmVersion, defaultAssembly);
+	BOOST_CHECK(defaultAssembly.items() != expectation);
+}
+
+BOOST_AUTO_TEST_CASE(superoptimiser)
+{
+	AssemblyItems items{
+		Instruction::DUP3,
+		Instruction::SWAP1,
+		Instruction::POP,
+		u256(1),
+		Instruction::CALLVALUE,
+		Instruction::MUL,
+		u256(0),
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		Instruction::POP,
+		Instruction::DUP2,
+		Instruction::CALLVALUE,
+		u256(0),
+		Instruction::SSTORE
+	};
+	BOOST_CHECK(Superoptimiser{items}.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	// Nothing left to improve.
+	BOOST_CHECK(!Superoptimiser{items}.optimise());
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -131,6 +131,33 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
 }
 
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	CharStream const source{"ABC\nDEF\r\n\nGHI", "source"};
+	auto check = [&](int _position, int _line, int _column)
+	{
+		LineColumn lineColumn = source.translatePositionToLineColumn(_position);
+		BOOST_CHECK_EQUAL(lineColumn.line, _line);
+		BOOST_CHECK_EQUAL(lineColumn.column, _column);
+	};
+	check(0, 0, 0);
+	check(3, 0, 3);
+	check(4, 1, 0);
+	check(9, 2, 0);
+	check(10, 3, 0);
+	check(12, 3, 2);
+	// Positions past the end are clamped.
+	check(100, 3, 3);
+
+	// The line break itself belongs to the line before it.
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "ABC");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(3), "ABC");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(4), "DEF");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(8), "DEF");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(9), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(10), "GHI");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
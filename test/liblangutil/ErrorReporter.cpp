@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the ErrorReporter and UniqueErrorReporter classes.
+ */
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/UniqueErrorReporter.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::langutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(ErrorReporterTest)
+
+BOOST_AUTO_TEST_CASE(suppressed_warnings)
+{
+	ErrorList errors;
+	ErrorReporter reporter(errors);
+	reporter.setSuppressionFilter([](ErrorId _error, Error::Type) { return _error == 1234_error; });
+
+	BOOST_CHECK(!reporter.isReported(1234_error, Error::Type::Warning));
+	BOOST_CHECK(reporter.isReported(1234_error, Error::Type::TypeError));
+	BOOST_CHECK(reporter.isReported(4321_error, Error::Type::Warning));
+
+	reporter.warning(1234_error, "suppressed");
+	reporter.info(1234_error, "suppressed");
+	reporter.warning(4321_error, "reported");
+	reporter.typeError(1234_error, SourceLocation{}, "errors are never suppressed");
+
+	BOOST_REQUIRE_EQUAL(errors.size(), 2);
+	BOOST_CHECK(errors[0]->errorId() == 4321_error);
+	BOOST_CHECK(errors[1]->errorId() == 1234_error);
+	BOOST_CHECK(reporter.hasErrors());
+}
+
+BOOST_AUTO_TEST_CASE(suppressed_warnings_are_not_appended)
+{
+	ErrorList otherErrors;
+	ErrorReporter otherReporter(otherErrors);
+	otherReporter.warning(1234_error, "suppressed");
+	otherReporter.info(4321_error, "reported");
+	otherReporter.typeError(1234_error, SourceLocation{}, "errors are never suppressed");
+
+	ErrorList errors;
+	ErrorReporter reporter(errors);
+	reporter.setSuppressionFilter([](ErrorId _error, Error::Type) { return _error == 1234_error; });
+	reporter.append(otherErrors);
+
+	BOOST_REQUIRE_EQUAL(errors.size(), 2);
+	BOOST_CHECK(errors[0]->errorId() == 4321_error);
+	BOOST_CHECK(errors[1]->type() == Error::Type::TypeError);
+}
+
+BOOST_AUTO_TEST_CASE(unique_errors)
+{
+	auto const source = internSourceName("source");
+	UniqueErrorReporter reporter;
+	reporter.warning(1234_error, SourceLocation{0, 3, source}, "a");
+	reporter.warning(1234_error, SourceLocation{0, 3, source}, "a");
+	reporter.warning(1234_error, SourceLocation{0, 4, source}, "b");
+	reporter.warning(4321_error, SourceLocation{0, 3, source}, "c");
+	BOOST_CHECK_EQUAL(reporter.errors().size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // end namespaces
@@ -34,9 +34,9 @@ BOOST_AUTO_TEST_SUITE(SourceLocationTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
 {
-	auto const source = std::make_shared<std::string>("source");
-	auto const sourceA = std::make_shared<std::string>("sourceA");
-	auto const sourceB = std::make_shared<std::string>("sourceB");
+	auto const source = internSourceName("source");
+	auto const sourceA = internSourceName("sourceA");
+	auto const sourceB = internSourceName("sourceB");
 
 	BOOST_CHECK(SourceLocation{} == SourceLocation{});
 	BOOST_CHECK((SourceLocation{0, 3, sourceA} != SourceLocation{0, 3, sourceB}));
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsmtutil/SolverProcessPool.h
+
+#include <libsmtutil/SolverProcessPool.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+string const satisfiableQuery = "(declare-fun x () Int)\n(assert (> x 0))\n(check-sat)\n";
+string const unsatisfiableQuery = "(declare-fun x () Int)\n(assert (> x 0))\n(assert (< x 0))\n(check-sat)\n";
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolverProcessPoolTest)
+
+BOOST_AUTO_TEST_CASE(missing_executable)
+{
+	SolverProcessPool pool("/nonexistent/solver", {}, 1);
+	BOOST_TEST(boost::starts_with(pool.query(satisfiableQuery), "(error"));
+	// The pool stays usable after a failed start.
+	BOOST_TEST(boost::starts_with(pool.query(satisfiableQuery), "(error"));
+}
+
+BOOST_AUTO_TEST_CASE(process_exits_before_reading)
+{
+	// Writing to a process that has exited must neither raise SIGPIPE nor throw.
+	boost::filesystem::path const executable = "/bin/true";
+	if (!boost::filesystem::exists(executable))
+	{
+		BOOST_TEST_MESSAGE("/bin/true not found, skipping.");
+		return;
+	}
+	SolverProcessPool pool(executable, {}, 1);
+	string const query(1 << 20, ' ');
+	for (size_t i = 0; i < 3; ++i)
+		BOOST_TEST(boost::starts_with(pool.query(query), "(error"));
+}
+
+BOOST_AUTO_TEST_CASE(answers_queries)
+{
+	auto pool = SolverProcessPool::z3(1, nullopt);
+	if (!pool)
+	{
+		BOOST_TEST_MESSAGE("z3 executable not found, skipping.");
+		return;
+	}
+	BOOST_TEST(pool->query(satisfiableQuery) == "sat\n");
+	// The declaration of the previous query was reset.
+	BOOST_TEST(pool->query(unsatisfiableQuery) == "unsat\n");
+}
+
+BOOST_AUTO_TEST_CASE(callback)
+{
+	auto pool = SolverProcessPool::z3(1, nullopt);
+	if (!pool)
+	{
+		BOOST_TEST_MESSAGE("z3 executable not found, skipping.");
+		return;
+	}
+	auto callback = pool->callback();
+	ReadCallback::Result result = callback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), satisfiableQuery);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "sat\n");
+	result = callback(ReadCallback::kindString(ReadCallback::Kind::ReadFile), "a.sol");
+	BOOST_TEST(!result.success);
+}
+
+BOOST_AUTO_TEST_CASE(restarts_exited_process)
+{
+	auto pool = SolverProcessPool::z3(1, nullopt);
+	if (!pool)
+	{
+		BOOST_TEST_MESSAGE("z3 executable not found, skipping.");
+		return;
+	}
+	BOOST_TEST(boost::starts_with(pool->query("(exit)"), "(error"));
+	BOOST_TEST(pool->query(satisfiableQuery) == "sat\n");
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_queries)
+{
+	auto pool = SolverProcessPool::z3(2, nullopt);
+	if (!pool)
+	{
+		BOOST_TEST_MESSAGE("z3 executable not found, skipping.");
+		return;
+	}
+	vector<future<string>> responses;
+	for (size_t i = 0; i < 8; ++i)
+		responses.emplace_back(async(launch::async, [&pool, i]() {
+			return pool->query(i % 2 == 0 ? satisfiableQuery : unsatisfiableQuery);
+		}));
+	for (size_t i = 0; i < responses.size(); ++i)
+		BOOST_TEST(responses[i].get() == (i % 2 == 0 ? "sat\n" : "unsat\n"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -171,5 +171,7 @@ FunctionTypePointer AnalysisFramework::retrieveFunctionBySignature(
 )
 {
 	FixedHash<4> hash(util::keccak256(_signature));
-	return _contract.interfaceFunctions()[hash];
+	auto const& interfaceFunctions = _contract.interfaceFunctions();
+	auto it = interfaceFunctions.find(hash);
+	return it != interfaceFunctions.end() ? it->second : nullptr;
 }
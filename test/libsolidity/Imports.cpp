@@ -113,6 +113,18 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(unresolved_imports)
+{
+	CompilerStack c;
+	c.setSources({
+		{"a.sol", "import \"b.sol\"; import \"x/c.sol\"; contract A {} pragma solidity >=0.0;"},
+		{"b.sol", "contract B {} pragma solidity >=0.0;"}
+	});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(!c.parse());
+	BOOST_CHECK(c.unresolvedImports() == (set<string>{"x/c.sol"}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -21,6 +21,8 @@
  */
 
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -179,6 +181,62 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_contexts)
+{
+	auto input = [](size_t _index) {
+		return R"({
+			"language": "Solidity",
+			"sources": {
+				"fileA": {
+					"content": "import \"lib.sol\"; contract A)" + to_string(_index) + R"( is L { function f() public pure returns (uint) { return )" + to_string(_index) + R"(; } }"
+				}
+			},
+			"settings": {
+				"outputSelection": { "*": { "*": [ "evm.bytecode.object", "ir" ] } }
+			}
+		})";
+	};
+	// The callback allocates its result on the thread of the compilation.
+	CStyleReadFileCallback callback{
+		[](void*, char const*, char const*, char** o_contents, char** o_error)
+		{
+			string content = "abstract contract L { uint x; }";
+			*o_contents = solidity_alloc(content.size());
+			copy(content.begin(), content.end(), *o_contents);
+			*o_error = nullptr;
+		}
+	};
+
+	size_t const count = 4;
+	vector<string> expectations;
+	for (size_t i = 0; i < count; ++i)
+	{
+		char* output = solidity_compile(input(i).c_str(), callback, nullptr);
+		expectations.emplace_back(output);
+		solidity_free(output);
+	}
+	solidity_reset();
+
+	vector<string> outputs(count);
+	vector<thread> threads;
+	for (size_t i = 0; i < count; ++i)
+		threads.emplace_back([&, i]() {
+			solidity_context* context = solidity_context_create();
+			outputs[i] = solidity_compile_ctx(context, input(i).c_str(), callback, nullptr);
+			solidity_context_free(context);
+		});
+	for (thread& thread: threads)
+		thread.join();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(outputs[i], result));
+		BOOST_CHECK(result["contracts"]["fileA"]["A" + to_string(i)]["ir"].isString());
+		BOOST_CHECK_EQUAL(outputs[i], expectations[i]);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
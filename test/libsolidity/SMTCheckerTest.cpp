@@ -37,6 +37,14 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	else
 		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT \"show unproved\" choice."));
 
+	auto const& sliceHornClauses = m_reader.stringSetting("SMTSliceHornClauses", "no");
+	if (sliceHornClauses == "no")
+		m_modelCheckerSettings.sliceHornClauses = false;
+	else if (sliceHornClauses == "yes")
+		m_modelCheckerSettings.sliceHornClauses = true;
+	else
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT Horn clause slicing choice."));
+
 	m_modelCheckerSettings.solvers = smtutil::SMTSolverChoice::None();
 	auto const& choice = m_reader.stringSetting("SMTSolvers", "any");
 	if (choice == "any")
@@ -58,6 +66,14 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	else
 		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT engine choice."));
 
+	auto const& timeBudget = m_reader.stringSetting("SMTTimeBudget", "none");
+	if (timeBudget != "none")
+		m_modelCheckerSettings.timeBudget = static_cast<unsigned>(stoul(timeBudget));
+
+	auto const& contractTimeBudget = m_reader.stringSetting("SMTContractTimeBudget", "none");
+	if (contractTimeBudget != "none")
+		m_modelCheckerSettings.contractTimeBudget = static_cast<unsigned>(stoul(contractTimeBudget));
+
 	if (m_modelCheckerSettings.solvers.none() || m_modelCheckerSettings.engine.none())
 		m_shouldRun = false;
 
@@ -115,6 +115,27 @@ SemanticTest::SemanticTest(
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
 
+	// Code generation options that are off by default and only affect the IR output.
+	static map<string, bool OptimiserSettings::*> const codegenOptions{
+		{"coalesceStorageWrites", &OptimiserSettings::coalesceStorageWrites},
+		{"copyCalldataInABIDecoder", &OptimiserSettings::copyCalldataInABIDecoder},
+		{"hashInputInScratchMemory", &OptimiserSettings::hashInputInScratchMemory},
+		{"precomputeMappingSlots", &OptimiserSettings::precomputeMappingSlots},
+		{"pruneUnusedFunctions", &OptimiserSettings::pruneUnusedFunctions},
+	};
+	string enabledOptions = m_reader.stringSetting("codegenOptions", "");
+	vector<string> optionNames;
+	split(optionNames, enabledOptions, is_any_of(","));
+	for (string& optionName: optionNames)
+	{
+		trim(optionName);
+		if (optionName.empty())
+			continue;
+		if (!codegenOptions.count(optionName))
+			BOOST_THROW_EXCEPTION(runtime_error("Invalid codegenOptions value: " + optionName + "."));
+		m_optimiserSettings.*codegenOptions.at(optionName) = true;
+	}
+
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
 
@@ -25,6 +25,7 @@
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
+using namespace solidity::langutil;
 
 namespace solidity::frontend::test
 {
@@ -51,6 +52,21 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(smtchecker_pragma_warning_without_model_checking)
+{
+	CompilerStack c;
+	c.setModelCheckingEnabled(false);
+	c.setSources({{"a.sol", R"(
+		pragma experimental SMTChecker;
+		pragma solidity >=0.0;
+		contract C { function f(uint x) public pure { assert(x > 0); } }
+	)"}});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_REQUIRE(c.errors().size() == 1);
+	BOOST_CHECK(c.errors().front()->errorId() == 5523_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
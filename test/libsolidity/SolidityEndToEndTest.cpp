@@ -4092,6 +4092,31 @@ BOOST_AUTO_TEST_CASE(strip_reason_strings)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(evm_host_snapshot_restore)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint x;
+			event E(uint);
+			function set(uint _x) public { x = _x; emit E(_x); }
+			function get() public view returns (uint) { return x; }
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("set(uint256)", 1), encodeArgs());
+	EVMHost::State state = m_evmcHost->snapshot();
+	u256 block = blockNumber();
+
+	ABI_CHECK(callContractFunction("set(uint256)", 2), encodeArgs());
+	ABI_CHECK(callContractFunction("get()"), encodeArgs(2));
+	BOOST_CHECK(blockNumber() != block);
+
+	m_evmcHost->restore(state);
+	BOOST_CHECK_EQUAL(blockNumber(), block);
+	BOOST_CHECK_EQUAL(numLogs(), 1);
+	ABI_CHECK(callContractFunction("get()"), encodeArgs(1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -279,6 +279,49 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(type_provider_scope)
+{
+	IntegerType const* outer = TypeProvider::uint256();
+	{
+		TypeProvider typeProvider;
+		TypeProvider::Scope scope(typeProvider);
+		IntegerType const* inner = TypeProvider::uint256();
+		BOOST_CHECK(inner != outer);
+		BOOST_CHECK(*inner == *outer);
+		BOOST_CHECK(TypeProvider::uint256() == inner);
+		{
+			TypeProvider nestedTypeProvider;
+			TypeProvider::Scope nestedScope(nestedTypeProvider);
+			BOOST_CHECK(TypeProvider::uint256() != inner);
+		}
+		BOOST_CHECK(TypeProvider::uint256() == inner);
+		BOOST_CHECK(TypeProvider::bytesMemory()->baseType() == TypeProvider::byte());
+	}
+	BOOST_CHECK(TypeProvider::uint256() == outer);
+}
+
+BOOST_AUTO_TEST_CASE(type_provider_interning)
+{
+	TypeProvider typeProvider;
+	TypeProvider::Scope scope(typeProvider);
+
+	Type const* uint256 = TypeProvider::uint256();
+	BOOST_CHECK(TypeProvider::mapping(uint256, uint256) == TypeProvider::mapping(uint256, uint256));
+	BOOST_CHECK(TypeProvider::mapping(uint256, uint256) != TypeProvider::mapping(uint256, TypeProvider::boolean()));
+
+	ArrayType const* dynamicArray = TypeProvider::array(DataLocation::Memory, uint256);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256) == dynamicArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 2) == TypeProvider::array(DataLocation::Memory, uint256, 2));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 2) != TypeProvider::array(DataLocation::Memory, uint256, 3));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 2) != dynamicArray);
+	BOOST_CHECK(*TypeProvider::withLocation(dynamicArray, DataLocation::Storage, true) == *TypeProvider::array(DataLocation::Storage, uint256));
+	BOOST_CHECK(TypeProvider::withLocation(dynamicArray, DataLocation::Storage, false) == TypeProvider::withLocation(dynamicArray, DataLocation::Storage, false));
+
+	BOOST_CHECK(TypeProvider::tuple({uint256, dynamicArray}) == TypeProvider::tuple({uint256, dynamicArray}));
+	BOOST_CHECK(TypeProvider::tuple({uint256, dynamicArray}) != TypeProvider::tuple({dynamicArray, uint256}));
+	BOOST_CHECK(TypeProvider::typeType(dynamicArray) == TypeProvider::typeType(dynamicArray));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
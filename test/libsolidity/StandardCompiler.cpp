@@ -30,6 +30,7 @@
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <mutex>
 #include <set>
 
 using namespace std;
@@ -1252,6 +1253,904 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_stack_layout_search_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "stackLayoutSearchBudget": 1000 }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x, uint y) public pure returns (uint) { return x > y ? x - y : y - x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails.isObject());
+	BOOST_CHECK_EQUAL(yulDetails["stackLayoutSearchBudget"].asUInt(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_stack_layout_search_budget_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "optimizer": { "enabled": true, "details": {
+			"yulDetails": { "stackLayoutSearchBudget": -1 }
+		} } }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.stackLayoutSearchBudget\" must be an unsigned number."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_inliner_growth_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "inlinerGrowthBudget": 10 }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x, uint y) public pure returns (uint) { return x * y + y * x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails.isObject());
+	BOOST_CHECK_EQUAL(yulDetails["inlinerGrowthBudget"].asUInt(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_inliner_growth_budget_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "optimizer": { "enabled": true, "details": {
+			"yulDetails": { "inlinerGrowthBudget": "10" }
+		} } }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.inlinerGrowthBudget\" must be an unsigned number."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_max_steps)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "maxSteps": 1 }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x, uint y) public pure returns (uint) { return x * y + y * x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	bool stopped = false;
+	for (Json::Value const& error: result["errors"])
+		if (error["errorCode"].asString() == "4391")
+		{
+			BOOST_CHECK_EQUAL(error["severity"].asString(), "warning");
+			stopped = true;
+		}
+	BOOST_CHECK(stopped);
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["details"]["yulDetails"]["maxSteps"].asUInt(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_max_code_growth_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "optimizer": { "enabled": true, "details": {
+			"yulDetails": { "maxCodeGrowth": -1 }
+		} } }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.maxCodeGrowth\" must be an unsigned number."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_prune_unused_functions)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "pruneUnusedFunctions": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x, uint y) public pure returns (uint) { return x ** y; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(contract["ir"].asString().find("function fun_f_") != string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails.isObject());
+	BOOST_CHECK(yulDetails["pruneUnusedFunctions"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_narrow_ewasm_values)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "ewasm.wast", "ewasm.wasm" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "narrowEwasmValues": true }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint[] calldata x) external pure returns (uint s) { for (uint i = 0; i < x.length; i++) s ^= x[i]; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["ewasm"]["wast"].isString());
+	BOOST_CHECK(!contract["ewasm"]["wasm"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_prune_unused_functions_ewasm)
+{
+	auto compileEwasm = [&](bool _prune) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"outputSelection": {
+					"fileA": { "A": [ "ewasm.wasm" ] }
+				},
+				"optimizer": { "enabled": true, "details": {
+					"yul": true,
+					"yulDetails": { "pruneUnusedFunctions": )" + string(_prune ? "true" : "false") + R"( }
+				} }
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { function f(uint x) external pure returns (uint) { return x + 1; } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return getContractResult(result, "fileA", "A")["ewasm"]["wasm"].asString();
+	};
+
+	BOOST_CHECK(!compileEwasm(true).empty());
+	BOOST_CHECK(!compileEwasm(false).empty());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_narrow_ewasm_values_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "narrowEwasmValues": 1 }
+			} }
+		},
+		"sources": {
+			"fileA": { "content": "contract A { }" }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.narrowEwasmValues\" must be Boolean"
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_reuse_memory_slots)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "reuseMemorySlots": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x + 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails.isObject());
+	BOOST_CHECK(yulDetails["reuseMemorySlots"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_reuse_memory_slots_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "reuseMemorySlots": "yes" }
+			} }
+		},
+		"sources": {
+			"fileA": { "content": "contract A { }" }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.reuseMemorySlots\" must be Boolean"
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_rematerialiser_gas_costs)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "rematerialiserGasCosts": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint s) { for (uint i = 0; i < x; i++) s += i * 7; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["rematerialiserGasCosts"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_store_knowledge_across_calls)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "storeKnowledgeAcrossCalls": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint a; uint b; function g() internal { b = 2; } function f() public returns (uint) { a = 1; g(); return a; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["storeKnowledgeAcrossCalls"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_store_knowledge_in_loops)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "storeKnowledgeInLoops": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint a; uint b; function f(uint n) public { for (uint i = 0; i < n; i++) b += a; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["storeKnowledgeInLoops"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_preoptimize_library_functions)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "*": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "preoptimizeLibraryFunctions": true }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "library L { function scale(uint x, uint f) internal pure returns (uint) { return x * f + helper(x, 7); } function helper(uint x, uint y) private pure returns (uint) { return x / y; } } contract A { function f(uint x) public pure returns (uint) { return L.scale(x, 3); } } contract B { function g(uint x) public pure returns (uint) { return L.scale(x, 5) + L.scale(x, 3); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	for (char const* name: {"A", "B"})
+	{
+		Json::Value contract = getContractResult(result, "fileA", name);
+		BOOST_REQUIRE(contract.isObject());
+		BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+		Json::Value metadata;
+		BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+		BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["preoptimizeLibraryFunctions"].asBool());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_constant_optimizer_negation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "constantOptimizerNegation": true } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return ~(uint(0x1234ff) << 0xe5); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["constantOptimizerNegation"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_abi_decoder_calldata_copy)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "abiDecoderCalldataCopy": true } },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { struct S { uint a; bytes32 b; } function f(uint[] memory x, S memory s) public pure returns (uint) { return x[0] + s.a; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	string ir = contract["ir"].asString();
+	BOOST_CHECK(ir.find("calldatacopy(dst, offset, size)") != string::npos);
+	BOOST_CHECK(ir.find("calldatacopy(value, headStart, 0x40)") != string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["abiDecoderCalldataCopy"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_storage_write_coalescing)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "storageWriteCoalescing": true } },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { struct S { uint8 a; uint16 b; uint c; } S s; function f(uint8 x) public { s.a = x; s.b = 7; s.c = 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	string ir = contract["ir"].asString();
+	BOOST_CHECK(ir.find("update_storage_values_offset_0_t_uint8_offset_1_t_uint16(") != string::npos);
+	BOOST_CHECK(ir.find("update_storage_value_offset_0t_uint8_to_t_uint8(") == string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["storageWriteCoalescing"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_hash_input_scratch_memory)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "hashInputScratchMemory": true } },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint a, bytes32 b) public pure returns (bytes32) { return keccak256(abi.encode(a, b)); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	string ir = contract["ir"].asString();
+	BOOST_CHECK(ir.find("keccak256(") != string::npos);
+	BOOST_CHECK(ir.find("finalize_allocation") == string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["hashInputScratchMemory"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_constant_mapping_slots)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "ir" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "constantMappingSlots": true } },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { mapping(uint => mapping(uint => uint)) m; function f() public view returns (uint) { return m[1][2]; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	string ir = contract["ir"].asString();
+	BOOST_CHECK(ir.find("mapping_index_access") == string::npos);
+	// keccak256(2 . keccak256(1 . 0))
+	BOOST_CHECK(ir.find("0xb37150ceb7e138645bfe4dfcef9a75073e1d7aa14c524dfdd20d3f751fad1084") != string::npos);
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["constantMappingSlots"].asBool());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_binary_search_dispatch)
+{
+	auto compileWith = [&](bool _binarySearch) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"outputSelection": {
+					"fileA": { "A": [ "metadata", "ir", "evm.bytecode.object" ] }
+				},
+				"optimizer": { "enabled": true, "details": { "binarySearchDispatch": )" + string(_binarySearch ? "true" : "false") + R"( } },
+				"viaIR": true
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { function a() public {} function b() public {} function c() public {} function d() public {} function e() public {} function f() public {} }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return getContractResult(result, "fileA", "A");
+	};
+	Json::Value contract = compileWith(true);
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(contract["ir"].asString().find("switch lt(selector, ") != string::npos);
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["binarySearchDispatch"].asBool());
+
+	contract = compileWith(false);
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(contract["ir"].asString().find("switch lt(selector, ") == string::npos);
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(!metadata["settings"]["optimizer"]["details"].isMember("binarySearchDispatch"));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_variants)
+{
+	auto compileWith = [&](string const& _optimizer, string const& _variants) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"outputSelection": {
+					"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+				},
+				"optimizer": )" + _optimizer + R"(,
+				"optimizerVariants": )" + _variants + R"(
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { uint x; function f(uint a) public { x = a * 2 + 3 * 4; } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return result;
+	};
+	Json::Value optimized = compileWith(R"({ "enabled": true, "runs": 300 })", "[]");
+	BOOST_CHECK(!optimized.isMember("optimizerVariants"));
+	Json::Value result = compileWith(R"({ "enabled": false })", R"([{ "enabled": true, "runs": 300 }, { "enabled": false }])");
+	BOOST_REQUIRE(result["optimizerVariants"].isArray());
+	BOOST_REQUIRE_EQUAL(result["optimizerVariants"].size(), 2);
+
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	Json::Value variant = result["optimizerVariants"][0]["contracts"]["fileA"]["A"];
+	Json::Value unoptimizedVariant = result["optimizerVariants"][1]["contracts"]["fileA"]["A"];
+	BOOST_REQUIRE(contract.isObject() && variant.isObject() && unoptimizedVariant.isObject());
+	Json::Value optimizedContract = getContractResult(optimized, "fileA", "A");
+	BOOST_CHECK_EQUAL(variant["evm"]["bytecode"]["object"].asString(), optimizedContract["evm"]["bytecode"]["object"].asString());
+	BOOST_CHECK_EQUAL(variant["metadata"].asString(), optimizedContract["metadata"].asString());
+	BOOST_CHECK_EQUAL(unoptimizedVariant["evm"]["bytecode"]["object"].asString(), contract["evm"]["bytecode"]["object"].asString());
+	BOOST_CHECK(variant["evm"]["bytecode"]["object"].asString() != contract["evm"]["bytecode"]["object"].asString());
+}
+
+BOOST_AUTO_TEST_CASE(legacy_optimizer_identical_inline_assembly)
+{
+	string const source =
+		"contract A { uint x; "
+		"function f() public { x = 1; assembly { sstore(5, 1) } } "
+		"function g() public { x = 2; assembly { sstore(5, 1) } } }";
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"fileA": { "A": [ "evm.deployedBytecode.sourceMap" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": ")" + source + R"("
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+
+	// Both assembly blocks are optimized to the same code, but have to keep their own locations.
+	string const sourceMap = contract["evm"]["deployedBytecode"]["sourceMap"].asString();
+	set<string> starts;
+	string start;
+	for (size_t position = 0; position <= sourceMap.size();)
+	{
+		size_t const end = min(sourceMap.find(';', position), sourceMap.size());
+		string const field = sourceMap.substr(position, min(sourceMap.find(':', position), end) - position);
+		if (!field.empty())
+			start = field;
+		starts.insert(start);
+		position = end + 1;
+	}
+	BOOST_CHECK(starts.count(to_string(source.find("sstore(5, 1)"))));
+	BOOST_CHECK(starts.count(to_string(source.rfind("sstore(5, 1)"))));
+}
+
+BOOST_AUTO_TEST_CASE(binary_source_map)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": {
+					"A": [ "evm.bytecode.object", "evm.bytecode.sourceMap", "evm.bytecode.sourceMapBinary" ],
+					"B": [ "evm.bytecode" ]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; function f(uint a) public { x = a; } } contract B {}"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	// Selecting the whole bytecode does not include the binary source mapping.
+	BOOST_CHECK(!result["contracts"]["fileA"]["B"]["evm"]["bytecode"].isMember("sourceMapBinary"));
+
+	Json::Value bytecode = result["contracts"]["fileA"]["A"]["evm"]["bytecode"];
+	BOOST_REQUIRE(bytecode["sourceMapBinary"].isString());
+	bytes const binary = fromHex(bytecode["sourceMapBinary"].asString());
+	auto readNumber = [&](size_t _offset, size_t _width) {
+		BOOST_REQUIRE(_offset + _width <= binary.size());
+		uint32_t value = 0;
+		for (size_t i = 0; i < _width; ++i)
+			value = (value << 8) | binary[_offset + i];
+		return value;
+	};
+
+	string const sourceMap = bytecode["sourceMap"].asString();
+	size_t const instructions = readNumber(0, 4);
+	BOOST_CHECK_EQUAL(instructions, static_cast<size_t>(count(sourceMap.begin(), sourceMap.end(), ';')) + 1);
+	// The first entry is fully given in the text format.
+	string const firstEntry = sourceMap.substr(0, sourceMap.find(';'));
+	vector<string> fields(1);
+	for (char c: firstEntry)
+		if (c == ':')
+			fields.emplace_back();
+		else
+			fields.back() += c;
+	BOOST_REQUIRE_EQUAL(fields.size(), 5);
+	BOOST_CHECK_EQUAL(to_string(static_cast<int32_t>(readNumber(4, 4))), fields[0]);
+	BOOST_CHECK_EQUAL(to_string(static_cast<int32_t>(readNumber(8, 4))), fields[1]);
+	BOOST_CHECK_EQUAL(to_string(static_cast<int32_t>(readNumber(12, 4))), fields[2]);
+	BOOST_CHECK_EQUAL(to_string(readNumber(16, 2)), fields[4]);
+	BOOST_CHECK_EQUAL(string(1, static_cast<char>(binary[18])), fields[3]);
+
+	size_t const indexOffset = 4 + 16 * instructions;
+	size_t const coveredBytes = readNumber(indexOffset, 4);
+	BOOST_CHECK_EQUAL(binary.size(), indexOffset + 4 + 4 * coveredBytes);
+	BOOST_CHECK(coveredBytes <= bytecode["object"].asString().size() / 2);
+	// The instruction at the start of the code is a push with one byte of data.
+	BOOST_CHECK_EQUAL(readNumber(indexOffset + 4, 4), 0);
+	BOOST_CHECK_EQUAL(readNumber(indexOffset + 8, 4), 0);
+	BOOST_CHECK_EQUAL(readNumber(indexOffset + 12, 4), 1);
+	BOOST_CHECK_EQUAL(readNumber(indexOffset + 4 * coveredBytes, 4), instructions - 1);
+}
+
+BOOST_AUTO_TEST_CASE(low_memory)
+{
+	auto compileWith = [&](bool _lowMemory, bool _viaIR, string const& _parallelism) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"settings": {
+				"outputSelection": {
+					"*": { "*": [ "abi", "metadata", "ir", "evm.assembly", "evm.bytecode", "evm.deployedBytecode.object" ] }
+				},
+				"lowMemory": )" + string(_lowMemory ? "true" : "false") + R"(,
+				"viaIR": )" + string(_viaIR ? "true" : "false") + R"(,
+				"parallelism": )" + _parallelism + R"(
+			},
+			"sources": {
+				"fileA": {
+					"content": "contract A { uint public x; } contract B { function f() public returns (address) { return address(new A()); } } contract C { function g() public returns (address) { return address(new B()); } }"
+				}
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		return result;
+	};
+	for (bool viaIR: {false, true})
+		for (string parallelism: {"1", "2"})
+		{
+			Json::Value expected = compileWith(false, viaIR, parallelism)["contracts"];
+			Json::Value lowMemory = compileWith(true, viaIR, parallelism)["contracts"];
+			BOOST_REQUIRE(expected["fileA"]["C"]["evm"]["bytecode"]["object"].isString());
+			BOOST_CHECK_EQUAL(util::jsonCompactPrint(lowMemory), util::jsonCompactPrint(expected));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_function_runs)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yulDetails": { "functionRuns": { "fun_f": 100000, "fun_g": 1 } }
+			} },
+			"viaIR": true
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return type(uint).max - 1; } function g() public pure returns (uint) { return type(uint).max - 2; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& functionRuns = metadata["settings"]["optimizer"]["details"]["yulDetails"]["functionRuns"];
+	BOOST_CHECK(functionRuns.isObject());
+	BOOST_CHECK_EQUAL(functionRuns.size(), 2);
+	BOOST_CHECK_EQUAL(functionRuns["fun_f"].asUInt(), 100000);
+	BOOST_CHECK_EQUAL(functionRuns["fun_g"].asUInt(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_function_runs_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "optimizer": { "enabled": true, "details": {
+			"yulDetails": { "functionRuns": { "fun_f": "hot" } }
+		} } }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.functionRuns.fun_f\" must be an unsigned number."
+	));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1810,6 +2709,268 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_does_not_change_output)
+{
+	auto const compileWith = [](unsigned _parallelism) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { function f() public pure returns (uint) { return 1; } } contract B { function g() public returns (address) { return address(new A()); } } contract C is B { uint x; function h(uint y) public { x = y; } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"outputSelection": {
+					"*": { "*": ["evm.bytecode.object", "evm.deployedBytecode.object", "evm.bytecode.sourceMap"] }
+				}
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value serialResult = compileWith(1);
+	Json::Value parallelResult = compileWith(4);
+	BOOST_CHECK(containsAtMostWarnings(serialResult));
+	BOOST_CHECK(containsAtMostWarnings(parallelResult));
+	BOOST_REQUIRE(serialResult["contracts"]["A.sol"].size() == 3);
+	BOOST_CHECK(serialResult["contracts"] == parallelResult["contracts"]);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_does_not_change_ast)
+{
+	auto const compileWith = [](unsigned _parallelism) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "import \"B.sol\"; contract A is B { /// @notice x\n uint x; function f() public { assembly { sstore(0, 1) } } }" },
+				"B.sol": { "content": "import \"C.sol\"; contract B { event E(uint indexed a); }" },
+				"C.sol": { "content": "struct S { uint a; } enum E { X, Y } function g(S memory _s) pure returns (uint) { return _s.a; }" }
+			},
+			"settings": {
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		solidity::frontend::StandardCompiler compiler;
+		return compiler.compile(parsedInput);
+	};
+
+	Json::Value serialResult = compileWith(1);
+	Json::Value parallelResult = compileWith(3);
+	BOOST_CHECK(containsAtMostWarnings(serialResult));
+	BOOST_CHECK(containsAtMostWarnings(parallelResult));
+	BOOST_REQUIRE(serialResult["sources"].size() == 3);
+	BOOST_CHECK(serialResult["sources"] == parallelResult["sources"]);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_import_reads)
+{
+	map<string, string> const files{
+		{"B.sol", "import \"D.sol\"; contract B {}"},
+		{"C.sol", "import \"D.sol\"; import \"missing.sol\"; contract C {}"},
+		{"D.sol", "contract D {}"}
+	};
+	auto const compileWith = [&](unsigned _parallelism, bool _threadSafe, size_t& _reads) {
+		string input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "import \"B.sol\"; import \"C.sol\"; contract A {}" }
+			},
+			"settings": {
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "": ["ast"] } }
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		mutex readsMutex;
+		solidity::frontend::StandardCompiler compiler([&](string const&, string const& _path) {
+			lock_guard<mutex> lock(readsMutex);
+			++_reads;
+			if (files.count(_path))
+				return ReadCallback::Result{true, files.at(_path)};
+			return ReadCallback::Result{false, "not found"};
+		});
+		compiler.setReadCallbackThreadSafe(_threadSafe);
+		return compiler.compile(parsedInput);
+	};
+
+	size_t serialReads = 0;
+	size_t concurrentReads = 0;
+	Json::Value serialResult = compileWith(1, false, serialReads);
+	Json::Value concurrentResult = compileWith(4, true, concurrentReads);
+	BOOST_CHECK(containsError(serialResult, "ParserError", "Source \"missing.sol\" not found: not found"));
+	BOOST_CHECK(serialResult["errors"] == concurrentResult["errors"]);
+	BOOST_CHECK(serialResult["sources"] == concurrentResult["sources"]);
+	// B.sol, C.sol, D.sol and missing.sol are each read once.
+	BOOST_CHECK_EQUAL(serialReads, 4);
+	BOOST_CHECK_EQUAL(concurrentReads, 4);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "parallelism": 0 }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A { function f() public pure returns (uint) { return 1; } }" } },
+		"settings": {
+			"profile": true,
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profile"].isObject());
+	Json::Value const& phases = result["profile"]["phases"];
+	BOOST_REQUIRE(phases["parsing"].isObject());
+	BOOST_CHECK_EQUAL(phases["parsing"]["calls"].asUInt(), 1);
+	BOOST_CHECK(phases["parsing"]["time"].asDouble() >= 0);
+	BOOST_CHECK(phases["analysis/typeChecking"].isObject());
+	Json::Value const& contract = result["profile"]["contracts"]["A.sol:A"];
+	BOOST_CHECK(contract["irGeneration"].isObject());
+	BOOST_CHECK(contract["yulOptimization"].isObject());
+	BOOST_CHECK(contract["stackLayoutGenerator"].isObject());
+	BOOST_CHECK(contract["yulOptimizer/CommonSubexpressionEliminator"]["calls"].asUInt() > 0);
+
+	BOOST_CHECK(!compile(R"({"language": "Solidity", "sources": {"A.sol": {"content": "contract A {}"}}})").isMember("profile"));
+}
+
+BOOST_AUTO_TEST_CASE(profile_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "profile": 1 }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profile\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(suppressed_warnings)
+{
+	auto errorCodes = [&](string const& _suppressedWarnings) {
+		Json::Value result = compile(R"(
+		{
+			"language": "Solidity",
+			"sources": { "A.sol": { "content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract A { uint x; function f() public pure returns (uint) { uint x; return 1; uint y = 2; } }" } },
+			"settings": { "suppressedWarnings": )" + _suppressedWarnings + R"( }
+		}
+		)");
+		multiset<string> codes;
+		for (Json::Value const& error: result["errors"])
+			codes.insert(error["errorCode"].asString());
+		return codes;
+	};
+	BOOST_CHECK((errorCodes("[]") == multiset<string>{"2072", "2072", "2519", "5740"}));
+	BOOST_CHECK((errorCodes("[2072, 5740]") == multiset<string>{"2519"}));
+	BOOST_CHECK((errorCodes("[2519, 5740, 2072]").empty()));
+}
+
+BOOST_AUTO_TEST_CASE(suppressed_warnings_invalid)
+{
+	for (string suppressedWarnings: {"2072", "[\"2072\"]", "[-1]"})
+	{
+		Json::Value result = compile(R"(
+		{
+			"language": "Solidity",
+			"sources": { "A.sol": { "content": "contract A {}" } },
+			"settings": { "suppressedWarnings": )" + suppressedWarnings + R"( }
+		}
+		)");
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.suppressedWarnings\" must be an array of error codes."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(serialized_output)
+{
+	// The artifacts are serialised separately, which must not change the output.
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public {} } contract B {}" },
+			"B.sol": { "content": "import \"A.sol\"; contract C is A {} interface D {}" },
+			"C.sol": { "content": "pragma solidity >=0.0; contract E { uint x; }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["abi", "evm.methodIdentifiers"], "": ["ast"] }, "C.sol": { "E": ["storageLayout"] } }
+		}
+	}
+	)";
+	frontend::StandardCompiler compiler;
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	string output = compiler.compile(input);
+	BOOST_CHECK_EQUAL(output, util::jsonCompactPrint(compiler.compile(parsedInput)));
+	Json::Value parsedOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(output, parsedOutput));
+	BOOST_CHECK(parsedOutput["contracts"]["B.sol"]["D"]["abi"].isArray());
+	BOOST_CHECK(parsedOutput["sources"]["C.sol"]["ast"].isObject());
+	BOOST_CHECK(parsedOutput["errors"].isArray());
+}
+
+BOOST_AUTO_TEST_CASE(batch_compilation)
+{
+	string unitA = R"({
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A { function f() public {} }" } },
+		"settings": { "outputSelection": { "*": { "*": ["abi"] } } }
+	})";
+	string unitB = R"({
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract B {}" } },
+		"settings": { "outputSelection": { "*": { "*": ["evm.bytecode.object"] } } }
+	})";
+	frontend::StandardCompiler compiler;
+	string output = compiler.compile("[" + unitA + "," + unitB + ", 1]");
+	BOOST_CHECK_EQUAL(
+		output,
+		"[" + compiler.compile(unitA) + "," + compiler.compile(unitB) + "," + compiler.compile(string("1")) + "]"
+	);
+	Json::Value parsedOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(output, parsedOutput));
+	BOOST_REQUIRE(parsedOutput.isArray());
+	BOOST_REQUIRE_EQUAL(parsedOutput.size(), 3);
+	BOOST_CHECK(parsedOutput[0]["contracts"]["A.sol"]["A"]["abi"].isArray());
+	BOOST_CHECK(!parsedOutput[0]["contracts"]["A.sol"].isMember("B"));
+	BOOST_CHECK(parsedOutput[1]["contracts"]["A.sol"]["B"]["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(containsError(parsedOutput[2], "JSONError", "Input is not a JSON object."));
+
+	BOOST_CHECK_EQUAL(compiler.compile(string("[]")), "[]");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/formal/InvariantHints.h
+
+#include <libsolidity/formal/InvariantHints.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::smt::test
+{
+
+namespace
+{
+
+Expression relation(string const& _name, vector<SortPointer> _domain)
+{
+	return Expression(_name, {}, make_shared<FunctionSort>(move(_domain), SortProvider::boolSort));
+}
+
+Expression apply(Expression const& _relation, vector<Expression> _arguments)
+{
+	return Expression(_relation.name, move(_arguments), SortProvider::boolSort);
+}
+
+/// The answer of the Horn solver that interprets @a _invariant by x >= 0 and @a _error by false.
+Expression answer(Expression const& _invariant, Expression const& _error)
+{
+	Expression var("(:var 0)", {}, SortProvider::sintSort);
+	return Expression::mkAnd({
+		Expression("forall", {apply(_invariant, {var}) == (var >= 0)}, SortProvider::boolSort),
+		apply(_error, {}) == Expression(false)
+	});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(InvariantHintsTest)
+
+BOOST_AUTO_TEST_CASE(strip_ids)
+{
+	BOOST_CHECK_EQUAL(InvariantHints::stripIds("interface_0_C_14_0"), "interface_C");
+	BOOST_CHECK_EQUAL(InvariantHints::stripIds("block_3_function_f__13_27_0"), "block_function_f_");
+	BOOST_CHECK_EQUAL(InvariantHints::stripIds("error_target_5"), "error_target");
+}
+
+BOOST_AUTO_TEST_CASE(learn)
+{
+	Expression invariant = relation("interface_0_C_14_0", {SortProvider::uintSort});
+	Expression error = relation("error_target_3", {});
+	InvariantHints hints;
+	hints.reset({});
+	hints.registerRelation(invariant);
+	hints.registerRelation(error);
+	hints.learn(answer(invariant, error));
+	hints.learn(answer(invariant, error));
+
+	auto const& learned = hints.learned();
+	BOOST_REQUIRE_EQUAL(learned.size(), 2);
+	BOOST_REQUIRE(learned.count("interface_C/0"));
+	BOOST_REQUIRE(learned.count("error_target/0"));
+	Expression const& formula = learned.at("interface_C/0").second;
+	BOOST_CHECK_EQUAL(formula.name, ">=");
+	BOOST_CHECK_EQUAL(formula.arguments.at(0).name, "#0");
+	BOOST_CHECK_EQUAL(formula.arguments.at(1).name, "0");
+	BOOST_CHECK_EQUAL(learned.at("error_target/0").second.name, "false");
+}
+
+BOOST_AUTO_TEST_CASE(proof_obligation)
+{
+	InvariantHints previousRun;
+	previousRun.reset({});
+	Expression previousInvariant = relation("interface_0_C_14_0", {SortProvider::uintSort});
+	Expression previousError = relation("error_target_3", {});
+	previousRun.registerRelation(previousInvariant);
+	previousRun.registerRelation(previousError);
+	previousRun.learn(answer(previousInvariant, previousError));
+
+	// The ids in the names of the relations have changed.
+	InvariantHints hints;
+	hints.reset(previousRun.learned());
+	Expression invariant = relation("interface_0_C_15_0", {SortProvider::uintSort});
+	Expression error = relation("error_target_4", {});
+	hints.registerRelation(invariant);
+	hints.registerRelation(error);
+
+	Expression x("x", {}, SortProvider::uintSort);
+	Expression init = Expression::implies(x == 0, apply(invariant, {x}));
+	Expression step = Expression::implies(apply(invariant, {x}), apply(invariant, {x + 1}));
+	Expression violation = Expression::implies(apply(invariant, {x}) && x < 0, apply(error, {}));
+	auto proof = hints.proofObligation(
+		{{&invariant, false}, {&error, false}, {&init, true}, {&step, true}, {&violation, true}},
+		apply(error, {})
+	);
+	BOOST_REQUIRE(proof.has_value());
+	BOOST_CHECK_EQUAL(proof->violation.name, "or");
+	BOOST_CHECK_EQUAL(proof->invariant.name, "and");
+	BOOST_CHECK_EQUAL(proof->invariant.arguments.size(), 2);
+
+	// Hints for relations with other sorts are not used.
+	InvariantHints otherHints;
+	otherHints.reset(previousRun.learned());
+	Expression otherInvariant = relation("interface_0_C_15_0", {SortProvider::uintSort, SortProvider::uintSort});
+	otherHints.registerRelation(otherInvariant);
+	BOOST_CHECK(!otherHints.proofObligation({{&otherInvariant, false}}, apply(otherInvariant, {x, x})).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
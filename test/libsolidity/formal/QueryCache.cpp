@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/formal/QueryCache.h
+
+#include <libsolidity/formal/QueryCache.h>
+
+#include <test/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::smtutil;
+using namespace solidity::test;
+
+namespace solidity::frontend::smt::test
+{
+
+namespace
+{
+
+bool equal(Expression const& _a, Expression const& _b)
+{
+	if (_a.name != _b.name || !(*_a.sort == *_b.sort) || _a.arguments.size() != _b.arguments.size())
+		return false;
+	for (size_t i = 0; i < _a.arguments.size(); ++i)
+		if (!equal(_a.arguments[i], _b.arguments[i]))
+			return false;
+	return true;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(QueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(bmc)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	ModelCheckerSettings settings;
+	Expression x("x", {}, SortProvider::uintSort);
+	vector<pair<string, SortPointer>> declarations{{"x", x.sort}};
+
+	util::h256 key = QueryCache::bmcKey(settings, declarations, x > 5, {x});
+	BOOST_CHECK(key == QueryCache::bmcKey(settings, declarations, x > 5, {x}));
+	BOOST_CHECK(key != QueryCache::bmcKey(settings, declarations, x > 6, {x}));
+	BOOST_CHECK(key != QueryCache::bmcKey(settings, declarations, x > 5, {}));
+	ModelCheckerSettings otherSettings;
+	otherSettings.solvers.cvc4 = !settings.solvers.cvc4;
+	BOOST_CHECK(key != QueryCache::bmcKey(otherSettings, declarations, x > 5, {x}));
+
+	{
+		QueryCache cache(tempDir.path());
+		BOOST_CHECK(!cache.lookupBMC(key).has_value());
+		cache.storeBMC(settings, key, {CheckResult::SATISFIABLE, {"6"}});
+		BOOST_CHECK(cache.lookupBMC(key).has_value());
+		cache.flush();
+	}
+
+	QueryCache cache(tempDir.path());
+	auto result = cache.lookupBMC(key);
+	BOOST_REQUIRE(result.has_value());
+	BOOST_CHECK(result->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(result->second == vector<string>{"6"});
+
+	util::h256 otherKey = QueryCache::bmcKey(settings, declarations, x > 6, {x});
+	cache.storeBMC(settings, otherKey, {CheckResult::ERROR, {}});
+	BOOST_CHECK(!cache.lookupBMC(otherKey).has_value());
+	settings.timeout = 1000;
+	cache.storeBMC(settings, otherKey, {CheckResult::UNKNOWN, {}});
+	BOOST_CHECK(!cache.lookupBMC(otherKey).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(chc)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	ModelCheckerSettings settings;
+	auto tupleSort = make_shared<TupleSort>(
+		"state_type",
+		vector<string>{"balances", "owner"},
+		vector<SortPointer>{make_shared<ArraySort>(SortProvider::uintSort, SortProvider::uintSort), make_shared<BitVectorSort>(160)}
+	);
+	auto relationSort = make_shared<FunctionSort>(vector<SortPointer>{tupleSort, SortProvider::sintSort}, SortProvider::boolSort);
+	Expression state("state", {}, tupleSort);
+	Expression error("error", {}, SortProvider::sintSort);
+	Expression summary("summary", {state, error}, SortProvider::boolSort);
+	Expression query("error_target", {}, relationSort);
+
+	util::h256 clauses = QueryCache::hashHornClause(util::h256(), query, nullopt);
+	util::h256 rule = QueryCache::hashHornClause(clauses, Expression::implies(summary, error > 0), "summary");
+	BOOST_CHECK(rule != QueryCache::hashHornClause(clauses, Expression::implies(summary, error > 0), "other"));
+	BOOST_CHECK(rule != QueryCache::hashHornClause(util::h256(), Expression::implies(summary, error > 0), "summary"));
+
+	util::h256 key = QueryCache::chcKey(settings, rule, query);
+	BOOST_CHECK(key != QueryCache::chcKey(settings, clauses, query));
+
+	CHCSolverInterface::CexGraph counterexample;
+	counterexample.nodes.emplace(0, summary);
+	counterexample.nodes.emplace(1, Expression("interface", {Expression(size_t(1))}, SortProvider::boolSort));
+	counterexample.edges[0] = {1};
+	{
+		QueryCache cache(tempDir.path());
+		cache.storeCHC(settings, key, {CheckResult::SATISFIABLE, Expression(true), counterexample});
+		cache.flush();
+	}
+
+	auto result = QueryCache(tempDir.path()).lookupCHC(key);
+	BOOST_REQUIRE(result.has_value());
+	auto const& [checkResult, invariant, cachedCounterexample] = *result;
+	BOOST_CHECK(checkResult == CheckResult::SATISFIABLE);
+	BOOST_CHECK(equal(invariant, Expression(true)));
+	BOOST_REQUIRE_EQUAL(cachedCounterexample.nodes.size(), 2);
+	BOOST_CHECK(equal(cachedCounterexample.nodes.at(0), summary));
+	BOOST_CHECK(equal(cachedCounterexample.nodes.at(1), counterexample.nodes.at(1)));
+	BOOST_CHECK(cachedCounterexample.edges == counterexample.edges);
+	auto const& cachedSort = dynamic_cast<TupleSort const&>(*cachedCounterexample.nodes.at(0).arguments.at(0).sort);
+	BOOST_CHECK(cachedSort.members == tupleSort->members);
+	BOOST_CHECK(*cachedSort.components.at(0) == *tupleSort->components.at(0));
+	BOOST_CHECK(*cachedSort.components.at(1) == *tupleSort->components.at(1));
+}
+
+BOOST_AUTO_TEST_CASE(invariants)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto relationSort = make_shared<FunctionSort>(vector<SortPointer>{SortProvider::uintSort}, SortProvider::boolSort);
+	Expression argument("#0", {}, SortProvider::uintSort);
+	QueryCache::Invariants invariants{{"interface_C/0", {relationSort, argument >= 1}}};
+
+	util::h256 key = QueryCache::invariantsKey("a.sol");
+	BOOST_CHECK(key != QueryCache::invariantsKey("b.sol"));
+	{
+		QueryCache cache(tempDir.path());
+		BOOST_CHECK(!cache.lookupInvariants(key).has_value());
+		cache.storeInvariants(key, invariants);
+		cache.flush();
+	}
+
+	auto cached = QueryCache(tempDir.path()).lookupInvariants(key);
+	BOOST_REQUIRE(cached.has_value());
+	BOOST_REQUIRE_EQUAL(cached->size(), 1);
+	auto const& [sort, formula] = cached->at("interface_C/0");
+	BOOST_CHECK(*sort == *relationSort);
+	BOOST_CHECK(equal(formula, argument >= 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
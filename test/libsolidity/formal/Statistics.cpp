@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/formal/Statistics.h
+
+#include <libsolidity/formal/Statistics.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+using namespace std;
+using namespace solidity::smtutil;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::smt::test
+{
+
+BOOST_AUTO_TEST_SUITE(StatisticsTest)
+
+BOOST_AUTO_TEST_CASE(target)
+{
+	auto target = Statistics::target("bmc", VerificationTargetType::DivByZero, SourceLocation{1, 5, {}}, 42);
+	BOOST_CHECK_EQUAL(target.engine, "bmc");
+	BOOST_CHECK_EQUAL(target.type, "divByZero");
+	BOOST_CHECK_EQUAL(target.location.start, 1);
+	BOOST_CHECK_EQUAL(target.size, 42);
+	BOOST_CHECK_EQUAL(target.queries, 0);
+}
+
+BOOST_AUTO_TEST_CASE(measure)
+{
+	auto target = Statistics::target("chc", VerificationTargetType::Assert, {}, 0);
+	BOOST_CHECK_EQUAL(Statistics::measure(&target, []() { return 1; }), 1);
+	BOOST_CHECK_EQUAL(Statistics::measure(&target, []() { return 2; }), 2);
+	BOOST_CHECK_EQUAL(Statistics::measure(nullptr, []() { return 3; }), 3);
+	BOOST_CHECK_EQUAL(target.queries, 2);
+}
+
+BOOST_AUTO_TEST_CASE(outcome)
+{
+	using namespace std::chrono_literals;
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::UNSATISFIABLE, 10, 0ms), "safe");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::SATISFIABLE, 10, 0ms), "unsafe");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::UNKNOWN, 10, 9ms), "unknown");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::UNKNOWN, 10, 10ms), "timeout");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::UNKNOWN, 0, 10ms), "unknown");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::UNKNOWN, nullopt, 10ms), "unknown");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::CONFLICTING, 10, 0ms), "conflicting");
+	BOOST_CHECK_EQUAL(Statistics::outcome(CheckResult::ERROR, 10, 0ms), "error");
+}
+
+BOOST_AUTO_TEST_CASE(totals)
+{
+	Statistics statistics;
+	auto solved = Statistics::target("bmc", VerificationTargetType::Assert, {}, 10);
+	Statistics::measure(&solved, []() { return 0; });
+	statistics.add(solved, CheckResult::UNSATISFIABLE, nullopt);
+	statistics.add(Statistics::target("bmc", VerificationTargetType::Overflow, {}, 10), CheckResult::SATISFIABLE, nullopt);
+	statistics.addSkipped(Statistics::target("chc", VerificationTargetType::Assert, {}, 10));
+
+	auto const& targets = statistics.targets();
+	BOOST_REQUIRE_EQUAL(targets.size(), 3);
+	BOOST_CHECK(!targets[0].cached);
+	BOOST_CHECK(targets[1].cached);
+	BOOST_CHECK_EQUAL(targets[2].outcome, "skipped");
+	BOOST_CHECK(!targets[2].cached);
+
+	auto totals = statistics.totals();
+	BOOST_REQUIRE_EQUAL(totals.size(), 2);
+	BOOST_CHECK_EQUAL(totals.at("bmc").targets, 2);
+	BOOST_CHECK_EQUAL(totals.at("bmc").queries, 1);
+	BOOST_CHECK_EQUAL(totals.at("chc").targets, 1);
+	BOOST_CHECK_EQUAL(totals.at("chc").queries, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
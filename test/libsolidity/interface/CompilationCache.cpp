@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/CompilationCache.h
+
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <test/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::test;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(store_and_lookup)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	CompilationCache cache(tempDir.path() / "cache");
+
+	util::h256 key = util::keccak256("a");
+	BOOST_CHECK(!cache.lookup(key).has_value());
+	cache.store(key, "content");
+	BOOST_CHECK(cache.lookup(key) == "content");
+	BOOST_CHECK(!cache.lookup(key, [](string const&) { return false; }).has_value());
+	BOOST_CHECK(!cache.lookup(util::keccak256("b")).has_value());
+
+	CompilationCache::Statistics statistics = CompilationCache(tempDir.path() / "cache").statistics();
+	BOOST_CHECK_EQUAL(statistics.hits, 1);
+	BOOST_CHECK_EQUAL(statistics.misses, 3);
+	BOOST_CHECK_EQUAL(statistics.stores, 1);
+	BOOST_CHECK_EQUAL(statistics.evictions, 0);
+}
+
+BOOST_AUTO_TEST_CASE(eviction)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	CompilationCache cache(tempDir.path(), 2);
+
+	for (string name: {"a", "b", "c"})
+		cache.store(util::keccak256(name), name);
+
+	size_t remaining = 0;
+	for (string name: {"a", "b", "c"})
+		if (cache.lookup(util::keccak256(name)) == name)
+			++remaining;
+	BOOST_CHECK_EQUAL(remaining, 2);
+	BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	size_t reads = 0;
+	string importedSource = "contract B {}";
+	ReadCallback::Callback reader = [&](string const& _kind, string const& _path) {
+		BOOST_REQUIRE(_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+		BOOST_REQUIRE(_path == "B.sol");
+		++reads;
+		return ReadCallback::Result{true, importedSource};
+	};
+
+	string input = R"({
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "import \"B.sol\"; contract A is B {}" } },
+		"settings": {
+			"cacheDirectory": ")" + tempDir.path().string() + R"(",
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	})";
+
+	StandardCompiler compiler(reader);
+	string output = compiler.compile(input);
+	Json::Value parsedOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(output, parsedOutput));
+	BOOST_REQUIRE(parsedOutput["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK_EQUAL(CompilationCache(tempDir.path()).statistics().stores, 1);
+
+	BOOST_CHECK_EQUAL(compiler.compile(input), output);
+	BOOST_CHECK_EQUAL(CompilationCache(tempDir.path()).statistics().hits, 1);
+
+	// A changed import must not be served from the cache.
+	importedSource = "contract B { uint x; }";
+	BOOST_CHECK(compiler.compile(input) != output);
+	BOOST_CHECK_EQUAL(CompilationCache(tempDir.path()).statistics().hits, 1);
+	BOOST_CHECK_EQUAL(CompilationCache(tempDir.path()).statistics().stores, 2);
+	BOOST_CHECK(reads > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace solidity::frontend::test
@@ -535,6 +535,76 @@ BOOST_AUTO_TEST_CASE(isUNCPath)
 	BOOST_TEST(!FileReader::isUNCPath("contract.sol"));
 }
 
+BOOST_AUTO_TEST_CASE(readFile_cache)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	boost::filesystem::path const filePath = tempDir.path() / "a.sol";
+	createFileWithContent(filePath, "contract A {}");
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+
+	auto cache = make_shared<FileReadCache>();
+	auto readWithCache = [&]() {
+		FileReader reader(tempDir.path());
+		reader.setCache(cache);
+		return reader.readFile(kind, "a.sol");
+	};
+
+	ReadCallback::Result result = readWithCache();
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "contract A {}");
+	BOOST_TEST(cache->size() == 1);
+
+	// A change that keeps the size and happens within the same second is not missed,
+	// unless the file system only stores the modification time in seconds.
+	optional<FileReadCache::FileVersion> const version = FileReadCache::fileVersion(filePath);
+	BOOST_REQUIRE(version);
+	BOOST_TEST(version->size == 13);
+	time_t const modificationTime = boost::filesystem::last_write_time(filePath);
+	boost::filesystem::remove(filePath);
+	createFileWithContent(filePath, "contract B {}");
+	// Only sets the time in whole seconds.
+	boost::filesystem::last_write_time(filePath, modificationTime);
+	if (FileReadCache::fileVersion(filePath) != version)
+	{
+		result = readWithCache();
+		BOOST_TEST(result.success);
+		BOOST_TEST(result.responseOrErrorMessage == "contract B {}");
+	}
+
+	boost::filesystem::remove(filePath);
+	createFileWithContent(filePath, "contract BC {}");
+	result = readWithCache();
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "contract BC {}");
+
+	boost::filesystem::remove(filePath);
+	cache->invalidate(FileReader::normalizeCLIPathForVFS(filePath, SymlinkResolution::Enabled));
+	BOOST_TEST(cache->size() == 0);
+	BOOST_TEST(!readWithCache().success);
+}
+
+BOOST_AUTO_TEST_CASE(readFile_cache_size_limit)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(tempDir.path() / "a.sol", "contract A {}");
+	createFileWithContent(tempDir.path() / "b.sol", "contract B {}");
+	createFileWithContent(tempDir.path() / "c.sol", "contract C is A, B {}");
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+
+	auto cache = make_shared<FileReadCache>(30);
+	FileReader reader(tempDir.path());
+	reader.setCache(cache);
+	BOOST_TEST(reader.readFile(kind, "a.sol").success);
+	BOOST_TEST(reader.readFile(kind, "b.sol").success);
+	BOOST_TEST(cache->size() == 2);
+	BOOST_TEST(cache->contentSize() == 26);
+
+	// The least recently used file is evicted.
+	BOOST_TEST(reader.readFile(kind, "c.sol").success);
+	BOOST_TEST(cache->size() == 1);
+	BOOST_TEST(cache->contentSize() == 21);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
@@ -0,0 +1,29 @@
+type Word is uint256;
+
+contract C {
+    struct S { uint a; bytes32 b; int c; }
+
+    function f(uint[] memory x) public pure returns (uint, uint, uint) {
+        x[0] = 7;
+        return (x.length, x[0], x[1]);
+    }
+    function g(bytes32[3] memory x, uint y) public pure returns (bytes32, bytes32, uint) {
+        return (x[0], x[2], y);
+    }
+    function h(S memory s) public pure returns (uint, bytes32, int) {
+        return (s.a, s.b, s.c);
+    }
+    function i(Word[] memory x, uint8[] memory y) public pure returns (uint, uint8) {
+        return (Word.unwrap(x[1]), y[0]);
+    }
+}
+// ====
+// codegenOptions: copyCalldataInABIDecoder
+// compileViaYul: true
+// ----
+// f(uint256[]): 0x20, 2, 1, 2 -> 2, 7, 2
+// f(uint256[]): 0x20, 3, 1, 2 -> FAILURE
+// g(bytes32[3],uint256): "a", "b", "c", 4 -> "a", "c", 4
+// h((uint256,bytes32,int256)): 1, "x", -2 -> 1, "x", -2
+// i(uint256[],uint8[]): 0x40, 0xa0, 2, 3, 4, 1, 5 -> 4, 5
+// i(uint256[],uint8[]): 0x40, 0xa0, 2, 3, 4, 1, 0x0100 -> FAILURE
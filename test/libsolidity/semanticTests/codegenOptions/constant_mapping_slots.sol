@@ -0,0 +1,38 @@
+contract Base {
+    uint x;
+    mapping(uint => uint) internal m;
+}
+
+contract C is Base {
+    mapping(int8 => mapping(uint64 => uint)) n;
+    mapping(uint => mapping(uint => uint[])) a;
+
+    function f() public returns (uint, uint, uint, uint) {
+        m[1] = 10;
+        n[-1][2] = 20;
+        n[3][0xffffffffffffffff] = 30;
+        a[4][5].push(40);
+        uint k1 = 1;
+        int8 k2 = -1;
+        uint64 k3 = 2;
+        uint k4 = 4;
+        uint k5 = 5;
+        return (m[k1], n[k2][k3], n[3][type(uint64).max], a[k4][k5][0]);
+    }
+    function g(uint key) public returns (uint, uint) {
+        m[key] = key + 1;
+        n[int8(int(key))][uint64(key)] = key + 2;
+        return (m[7], n[7][7]);
+    }
+    function slot() public view returns (uint r) {
+        assembly { r := m.slot }
+    }
+}
+// ====
+// codegenOptions: precomputeMappingSlots
+// compileViaYul: true
+// ----
+// f() -> 10, 20, 30, 40
+// g(uint256): 7 -> 8, 9
+// g(uint256): 8 -> 8, 9
+// slot() -> 1
@@ -0,0 +1,35 @@
+contract C {
+    function freeMemoryPointer() internal pure returns (uint r) {
+        assembly { r := mload(0x40) }
+    }
+    function f(uint x, string memory s) public pure returns (bool, bool, bool) {
+        bytes memory encoded = abi.encode(x, s);
+        bytes memory encodedPacked = abi.encodePacked(x, s);
+        uint before = freeMemoryPointer();
+        bytes32 h1 = keccak256(abi.encode(x, s));
+        bytes32 h2 = keccak256(abi.encodePacked(x, s));
+        bool unchanged = freeMemoryPointer() == before;
+        return (h1 == keccak256(encoded), h2 == keccak256(encodedPacked), unchanged);
+    }
+    function g(uint[] memory a) public pure returns (bytes32, uint[] memory) {
+        bytes memory encoded = abi.encode(keccak256(abi.encode(a)), a.length);
+        bytes32 hash = keccak256(abi.encode(keccak256(abi.encode(a)), a.length));
+        uint[] memory b = new uint[](2);
+        b[0] = a[0];
+        b[1] = 7;
+        return (hash ^ keccak256(encoded), b);
+    }
+    function h(uint x) public view returns (bool) {
+        bytes memory expected = abi.encodeWithSelector(this.f.selector, x);
+        return keccak256(abi.encodeWithSelector(this.f.selector, x)) == keccak256(expected)
+            && keccak256(abi.encodeWithSignature("f(uint256,string)", x)) == keccak256(expected)
+            && keccak256(abi.encodeCall(this.h, (x))) == keccak256(abi.encodeWithSelector(this.h.selector, x));
+    }
+}
+// ====
+// codegenOptions: hashInputInScratchMemory
+// compileViaYul: true
+// ----
+// f(uint256,string): 3, 0x40, 3, "abc" -> true, true, true
+// g(uint256[]): 0x20, 2, 5, 6 -> 0, 0x40, 2, 5, 7
+// h(uint256): 9 -> true
@@ -0,0 +1,34 @@
+contract C {
+    struct S { uint128 a; uint128 b; }
+    S s;
+    uint[] arr;
+
+    function unused(uint x) internal pure returns (uint) {
+        return x * 3;
+    }
+    function f(uint x, uint y) public pure returns (uint) {
+        return x + y;
+    }
+    function g(uint[] calldata x, bytes memory y) public pure returns (uint, uint, bytes1) {
+        return (x.length, x[1], y[0]);
+    }
+    function h(uint128 a, uint128 b) public returns (uint128, uint128) {
+        s = S(a, b);
+        arr.push(a);
+        arr.push(b);
+        return (s.a, s.b);
+    }
+    function i(uint x) public view returns (uint) {
+        return arr[x];
+    }
+}
+// ====
+// codegenOptions: pruneUnusedFunctions
+// compileViaYul: true
+// ----
+// f(uint256,uint256): 1, 2 -> 3
+// f(uint256,uint256): -1, 1 -> FAILURE, hex"4e487b71", 0x11
+// g(uint256[],bytes): 0x40, 0xa0, 2, 7, 8, 1, "a" -> 2, 8, "a"
+// h(uint128,uint128): 5, 6 -> 5, 6
+// i(uint256): 1 -> 6
+// i(uint256): 2 -> FAILURE, hex"4e487b71", 0x32
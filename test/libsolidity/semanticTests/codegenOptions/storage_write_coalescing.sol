@@ -0,0 +1,42 @@
+contract C {
+    struct S { uint64 a; int64 b; uint120 c; bool d; uint e; uint8 f; }
+    S s;
+    S t;
+
+    function f(uint64 x, int64 y, uint120 z) public returns (uint64, int64, uint120, bool, uint, uint8) {
+        s.e = 9;
+        s.a = x;
+        s.b = y;
+        s.c = z + 1;
+        s.d = true;
+        s.f = 3;
+        return (s.a, s.b, s.c, s.d, s.e, s.f);
+    }
+    function g(uint64 x) public returns (uint64, int64) {
+        S storage p = t;
+        p.a = x;
+        p.a = x + 1;
+        p.b = -1;
+        return (t.a, t.b);
+    }
+    function h(uint64 x, int64 y) public returns (uint64, int64, bool) {
+        s.a = x;
+        s.b = y * 2;
+        s.d = false;
+        return (s.a, s.b, s.d);
+    }
+    function slot() public view returns (bytes32 r) {
+        assembly { r := sload(s.slot) }
+    }
+}
+// ====
+// codegenOptions: coalesceStorageWrites
+// compileViaYul: true
+// ----
+// f(uint64,int64,uint120): 1, -2, 1 -> 1, -2, 2, true, 9, 3
+// slot() -> 0x01000000000000000000000000000002fffffffffffffffe0000000000000001
+// g(uint64): 4 -> 5, -1
+// h(uint64,int64): 1, 0x4000000000000000 -> FAILURE, hex"4e487b71", 0x11
+// slot() -> 0x01000000000000000000000000000002fffffffffffffffe0000000000000001
+// h(uint64,int64): 3, 3 -> 3, 6, false
+// slot() -> 0x0000000000000000000000000000000200000000000000060000000000000003
@@ -0,0 +1,10 @@
+contract C {
+    function f(uint x) public pure {
+        assert(x > 0);
+    }
+}
+// ====
+// SMTEngine: bmc
+// SMTContractTimeBudget: 0
+// ----
+// Warning 2515: (58-71): BMC: Assertion violation was not checked because the time budget of the model checker was used up.
@@ -0,0 +1,30 @@
+contract C {
+    uint x;
+    uint y;
+
+    function setX(uint _x) public {
+        x = _x;
+    }
+
+    function setY(uint _y) public {
+        require(_y > 1);
+        y = _y;
+    }
+
+    function f() public view {
+        // Only depends on the rules that assign y.
+        assert(y != 2);
+    }
+
+    function g() public view {
+        assert(y != 1);
+    }
+}
+// ====
+// SMTEngine: chc
+// SMTIgnoreCex: yes
+// SMTIgnoreInv: yes
+// SMTSliceHornClauses: yes
+// SMTSolvers: z3
+// ----
+// Warning 6328: (272-286): CHC: Assertion violation happens here.
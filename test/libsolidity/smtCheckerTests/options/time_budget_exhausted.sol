@@ -0,0 +1,11 @@
+contract C {
+    function f(uint x) public pure {
+        assert(x > 0);
+    }
+}
+// ====
+// SMTEngine: all
+// SMTTimeBudget: 0
+// ----
+// Warning 1897: (58-71): CHC: Assertion violation was not checked because the time budget of the model checker was used up.
+// Warning 2515: (58-71): BMC: Assertion violation was not checked because the time budget of the model checker was used up.
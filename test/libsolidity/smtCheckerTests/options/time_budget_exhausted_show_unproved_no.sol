@@ -0,0 +1,12 @@
+contract C {
+    function f(uint x) public pure {
+        assert(x > 0);
+    }
+}
+// ====
+// SMTEngine: all
+// SMTShowUnproved: no
+// SMTTimeBudget: 0
+// ----
+// Warning 6029: CHC: 1 verification condition(s) were not checked because the time budget of the model checker was used up. Enable the model checker option "show unproved" to see all of them.
+// Warning 6153: BMC: 1 verification condition(s) were not checked because the time budget of the model checker was used up. Enable the model checker option "show unproved" to see all of them.
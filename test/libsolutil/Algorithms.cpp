@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the graph algorithms in libsolutil/Algorithms.h.
+ */
+
+#include <libsolutil/Algorithms.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns the components with sorted members, keeping the order of the components.
+vector<vector<size_t>> sortedComponents(vector<vector<size_t>> const& _successors)
+{
+	vector<vector<size_t>> components = stronglyConnectedComponents(_successors);
+	for (vector<size_t>& component: components)
+		sort(component.begin(), component.end());
+	return components;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Algorithms, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(strongly_connected_components_empty)
+{
+	BOOST_CHECK(stronglyConnectedComponents({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(strongly_connected_components_chain)
+{
+	// 0 -> 1 -> 2, callees come before their callers.
+	vector<vector<size_t>> expectation{{2}, {1}, {0}};
+	BOOST_CHECK(sortedComponents({{1}, {2}, {}}) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(strongly_connected_components_cycles)
+{
+	// 0 -> 1 -> 2 -> 1, 2 -> 3 -> 3, 4 -> 0, 4 -> 3
+	vector<vector<size_t>> expectation{{3}, {1, 2}, {0}, {4}};
+	BOOST_CHECK(sortedComponents({{1}, {2}, {1, 3}, {3}, {0, 3}}) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(strongly_connected_components_cycle_through_visited_vertex)
+{
+	// 0 -> 1 -> 2 -> 3 and 0 -> 3 -> 1, so 1, 2 and 3 form a cycle even though 3
+	// is reached before 1 is finished.
+	vector<vector<size_t>> expectation{{1, 2, 3}, {0}};
+	BOOST_CHECK(sortedComponents({{3, 1}, {2}, {3}, {1}}) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(strongly_connected_components_deep_chain)
+{
+	// Long chains must not exhaust the call stack.
+	size_t const length = 100000;
+	vector<vector<size_t>> successors(length);
+	for (size_t i = 0; i + 1 < length; ++i)
+		successors[i].emplace_back(i + 1);
+	successors.back().emplace_back(0);
+	vector<vector<size_t>> components = stronglyConnectedComponents(successors);
+	BOOST_REQUIRE(components.size() == 1);
+	BOOST_CHECK(components.front().size() == length);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
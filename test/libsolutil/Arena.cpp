@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolutil/Arena.h
+
+#include <libsolutil/Arena.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+struct Tracked
+{
+	Tracked(size_t& _liveCount, string _value): liveCount(_liveCount), value(move(_value)) { ++liveCount; }
+	~Tracked() { --liveCount; }
+
+	size_t& liveCount;
+	string value;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(aligned_allocations)
+{
+	Arena arena;
+	for (size_t alignment: {1u, 2u, 4u, 8u, 16u})
+		for (size_t size: {1u, 3u, 8u, 17u})
+		{
+			void* memory = arena.allocate(size, alignment);
+			BOOST_TEST(reinterpret_cast<uintptr_t>(memory) % alignment == 0);
+			memset(memory, 0xff, size);
+		}
+	BOOST_CHECK_THROW(arena.allocate(8, 3), Exception);
+	BOOST_CHECK_THROW(arena.allocate(8, __STDCPP_DEFAULT_NEW_ALIGNMENT__ * 2), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(allocations_do_not_overlap)
+{
+	Arena arena;
+	vector<pair<unsigned char*, size_t>> allocations;
+	// Large enough to need several blocks and to contain requests that get blocks of their own.
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		size_t size = i % 100 == 0 ? 0x8000 : 1 + i % 65;
+		auto* memory = static_cast<unsigned char*>(arena.allocate(size, 8));
+		memset(memory, static_cast<int>(i % 256), size);
+		allocations.emplace_back(memory, size);
+	}
+	for (size_t i = 0; i < allocations.size(); ++i)
+		for (size_t j = 0; j < allocations[i].second; ++j)
+			BOOST_REQUIRE(allocations[i].first[j] == i % 256);
+}
+
+BOOST_AUTO_TEST_CASE(allocator_equality)
+{
+	auto arena = make_shared<Arena>();
+	ArenaAllocator<int> allocator(arena);
+	ArenaAllocator<string> copy(allocator);
+	BOOST_TEST((allocator == copy));
+	BOOST_TEST((allocator != ArenaAllocator<int>(make_shared<Arena>())));
+}
+
+BOOST_AUTO_TEST_CASE(last_object_keeps_arena_alive)
+{
+	size_t liveCount = 0;
+	weak_ptr<Arena> weakArena;
+	shared_ptr<Tracked> survivor;
+	{
+		auto arena = make_shared<Arena>();
+		weakArena = arena;
+		vector<shared_ptr<Tracked>> objects;
+		for (size_t i = 0; i < 100; ++i)
+			objects.emplace_back(allocate_shared<Tracked>(ArenaAllocator<Tracked>(arena), liveCount, to_string(i)));
+		survivor = objects[42];
+		BOOST_TEST(liveCount == 100);
+	}
+	// The destructors of all other objects ran, but their memory is still held.
+	BOOST_TEST(liveCount == 1);
+	BOOST_TEST(!weakArena.expired());
+	BOOST_TEST(survivor->value == "42");
+
+	survivor.reset();
+	BOOST_TEST(liveCount == 0);
+	BOOST_TEST(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -70,6 +70,10 @@ BOOST_AUTO_TEST_CASE(fromhex_string)
 	BOOST_CHECK_EQUAL(fromHex("0x00112233445566778899aabbccddeeff0", WhenError::Throw), expectation_odd);
 	BOOST_CHECK_THROW(fromHex("gg", WhenError::Throw), BadHexCharacter);
 	BOOST_CHECK_THROW(fromHex("0xgg", WhenError::Throw), BadHexCharacter);
+	BOOST_CHECK_THROW(fromHex("0x0g", WhenError::Throw), BadHexCharacter);
+	BOOST_CHECK_THROW(fromHex("0x00g", WhenError::Throw), BadHexCharacter);
+	BOOST_CHECK_EQUAL(fromHex("0x00g"), bytes());
+	BOOST_CHECK_EQUAL(fromHex("0x001122337"), bytes({0x00, 0x01, 0x12, 0x23, 0x37}));
 }
 
 BOOST_AUTO_TEST_CASE(tohex_uint8)
@@ -97,6 +101,20 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(signed_conversion)
+{
+	u256 const minSigned = u256(1) << 255;
+	BOOST_CHECK_EQUAL(u2s(0), s256(0));
+	BOOST_CHECK_EQUAL(u2s(1), s256(1));
+	BOOST_CHECK_EQUAL(u2s(u256(-1)), s256(-1));
+	BOOST_CHECK_EQUAL(u2s(minSigned - 1), s256(minSigned - 1));
+	BOOST_CHECK_EQUAL(u2s(minSigned), -s256(minSigned));
+	for (u256 value: {u256(0), u256(1), u256(-1), u256(-2), minSigned - 1, minSigned, minSigned + 1})
+		BOOST_CHECK_EQUAL(s2u(u2s(value)), value);
+	BOOST_CHECK_EQUAL(s2u(s256(-1)), u256(-1));
+	BOOST_CHECK_EQUAL(s2u(-s256(u256(-1))), u256(1));
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
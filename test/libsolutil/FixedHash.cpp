@@ -258,6 +258,14 @@ BOOST_AUTO_TEST_CASE(tostream)
 	BOOST_CHECK_EQUAL(out.str(), "441144110000000000000000000000000000000000000000000000000000000000000000f77f01");
 }
 
+BOOST_AUTO_TEST_CASE(compact_big_endian)
+{
+	h256 buffer;
+	for (u256 value: {u256(0), u256(1), u256(0xff), u256(0x100), u256(0x1234567), u256(-1)})
+		for (unsigned minSize: {0u, 1u, 5u, 32u})
+			BOOST_CHECK(compactBigEndian(value, buffer, minSize).toBytes() == toCompactBigEndian(value, minSize));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -69,6 +69,24 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	// Several inputs of each length, so that some of them are hashed together.
+	vector<bytes> inputs;
+	for (size_t length: vector<size_t>{0, 1, 31, 32, 135, 136, 137, 271, 300})
+		for (uint8_t i = 0; i < 5; i++)
+			inputs.emplace_back(length, i);
+	vector<bytesConstRef> references;
+	for (bytes const& input: inputs)
+		references.emplace_back(&input);
+
+	vector<h256> hashes = keccak256(references);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); i++)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	BOOST_CHECK(keccak256(vector<bytesConstRef>{}).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
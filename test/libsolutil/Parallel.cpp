@@ -0,0 +1,136 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the thread pool in libsolutil/Parallel.h
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(runs_every_job_once)
+{
+	ThreadPool pool(3);
+	for (size_t run = 0; run < 20; ++run)
+	{
+		vector<atomic<size_t>> calls(100);
+		pool.forEach(calls.size(), 4, [&](size_t _index) { ++calls[_index]; });
+		for (atomic<size_t> const& count: calls)
+			BOOST_TEST(count == 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(respects_thread_limit)
+{
+	ThreadPool pool(7);
+	atomic<size_t> active{0};
+	atomic<size_t> maxActive{0};
+	pool.forEach(64, 3, [&](size_t) {
+		size_t const nowActive = ++active;
+		for (size_t seen = maxActive; nowActive > seen && !maxActive.compare_exchange_weak(seen, nowActive);)
+			;
+		this_thread::sleep_for(chrono::milliseconds(1));
+		--active;
+	});
+	BOOST_TEST(maxActive <= 3);
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_lowest_index)
+{
+	ThreadPool pool(3);
+	atomic<size_t> calls{0};
+	try
+	{
+		pool.forEach(20, 4, [&](size_t _index) {
+			++calls;
+			if (_index == 7 || _index == 13)
+				throw runtime_error(to_string(_index));
+		});
+		BOOST_FAIL("No exception thrown.");
+	}
+	catch (runtime_error const& _error)
+	{
+		BOOST_TEST(string(_error.what()) == "7");
+	}
+	BOOST_TEST(calls == 20);
+}
+
+BOOST_AUTO_TEST_CASE(nested_runs_are_sequential)
+{
+	ThreadPool pool(3);
+	// Boost.Test is not thread-safe, so the results are only checked on the main thread.
+	atomic<size_t> outsideJob{0};
+	atomic<size_t> nestedOnOtherThread{0};
+	atomic<size_t> nestedCalls{0};
+	pool.forEach(8, 4, [&](size_t) {
+		if (!ThreadPool::insideJob())
+			++outsideJob;
+		auto const id = this_thread::get_id();
+		pool.forEach(8, 4, [&](size_t) {
+			++nestedCalls;
+			if (this_thread::get_id() != id)
+				++nestedOnOtherThread;
+		});
+	});
+	BOOST_TEST(!ThreadPool::insideJob());
+	BOOST_TEST(outsideJob == 0);
+	BOOST_TEST(nestedCalls == 64);
+	BOOST_TEST(nestedOnOtherThread == 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_runs)
+{
+	ThreadPool pool(2);
+	vector<atomic<size_t>> calls(4 * 50);
+	vector<thread> callers;
+	for (size_t caller = 0; caller < 4; ++caller)
+		callers.emplace_back([&, caller]() {
+			pool.forEach(50, 3, [&](size_t _index) { ++calls[caller * 50 + _index]; });
+		});
+	for (thread& caller: callers)
+		caller.join();
+	for (atomic<size_t> const& count: calls)
+		BOOST_TEST(count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(sequential_without_workers)
+{
+	ThreadPool pool(0);
+	auto const id = this_thread::get_id();
+	size_t calls = 0;
+	pool.forEach(10, 4, [&](size_t _index) {
+		BOOST_TEST(this_thread::get_id() == id);
+		BOOST_TEST(_index == calls);
+		++calls;
+	});
+	BOOST_TEST(calls == 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -82,6 +82,7 @@ BOOST_AUTO_TEST_CASE(bzz_hash_short)
 	BOOST_CHECK_EQUAL(bzzr1HashHex(bytes(64, 0)), "24090f674316c306ea2a98bdd08f042d6f776d0ae1c23b27fca52750a9c7d4e5");
 	BOOST_CHECK_EQUAL(bzzr1HashHex(bytes(65, 0)), "6ab1eaa91095215e30cacf47131d06ce5e9fc01611e406409705e190ee4440c6");
 	BOOST_CHECK_EQUAL(bzzr1HashHex(bytes(4096, 0)), "09ae927d0f3aaa37324df178928d3826820f3dd3388ce4aaebfc3af410bde23a");
+	BOOST_CHECK_EQUAL(bzzr1Hash(string("hello world")), bzzr1Hash(asBytes("hello world")));
 }
 
 BOOST_AUTO_TEST_CASE(bzz_hash_large)
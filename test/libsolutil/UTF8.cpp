@@ -92,6 +92,19 @@ BOOST_AUTO_TEST_CASE(invalid)
 	BOOST_CHECK(isInvalidUTF8("f9", 0)); // invalid per table 3.7
 }
 
+BOOST_AUTO_TEST_CASE(ascii_runs)
+{
+	// Runs of ASCII characters are skipped in blocks, which must not hide invalid bytes
+	// or change the reported position.
+	string ascii = "41424344454647484950515253545556575859";
+	BOOST_CHECK(isValidUTF8(ascii + ascii));
+	BOOST_CHECK(isValidUTF8(ascii + "c281" + ascii));
+	BOOST_CHECK(isInvalidUTF8(ascii + "80", 19));
+	BOOST_CHECK(isInvalidUTF8(ascii + ascii + "e08081" + ascii, 40));
+	for (size_t i = 0; i < 19; i++)
+		BOOST_CHECK(isInvalidUTF8(ascii.substr(0, 2 * i) + "ff" + ascii, i));
+}
+
 BOOST_AUTO_TEST_CASE(corpus)
 {
 	string source = R"(
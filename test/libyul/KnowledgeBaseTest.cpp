@@ -65,7 +65,7 @@ protected:
 	EVMDialect m_dialect{EVMVersion{}, true};
 	shared_ptr<Object> m_object;
 	SSAValueTracker m_ssaValues;
-	map<YulString, AssignedValue> m_values;
+	unordered_map<YulString, AssignedValue> m_values;
 };
 
 BOOST_FIXTURE_TEST_SUITE(KnowledgeBase, KnowledgeBaseTest)
@@ -126,6 +126,29 @@ BOOST_AUTO_TEST_CASE(difference)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cache_invalidation)
+{
+	yul::KnowledgeBase kb = constructKnowledgeBase(R"({
+		let a := calldataload(0)
+		let b := add(a, 200)
+		let c := calldataload(1)
+	})");
+
+	BOOST_CHECK(kb.knownToBeDifferent("a"_yulstring, "b"_yulstring));
+	BOOST_CHECK(!kb.differenceIfKnownConstant("a"_yulstring, "c"_yulstring));
+
+	// Results are cached until the cache is invalidated.
+	m_values.at("c"_yulstring) = m_values.at("b"_yulstring);
+	BOOST_CHECK(!kb.differenceIfKnownConstant("a"_yulstring, "c"_yulstring));
+	kb.invalidateCache();
+	BOOST_CHECK(kb.differenceIfKnownConstant("a"_yulstring, "c"_yulstring) == u256(-200));
+
+	m_values.erase("b"_yulstring);
+	BOOST_CHECK(kb.knownToBeDifferent("a"_yulstring, "b"_yulstring));
+	kb.invalidateCache();
+	BOOST_CHECK(!kb.knownToBeDifferent("a"_yulstring, "b"_yulstring));
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of optimised Yul objects.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/OptimizedObjectCache.h>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string const childObject = R"(
+	object "Child" {
+		code { sstore(0, add(calldataload(0), 1)) }
+		object "Child_deployed" {
+			code { mstore(0, add(2, 3)) return(0, 0x20) }
+		}
+	}
+)";
+
+string optimize(string const& _source, shared_ptr<OptimizedObjectCache> _cache)
+{
+	AssemblyStack stack(
+		EVMVersion{},
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	stack.setOptimizedObjectCache(move(_cache));
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(OptimizedObjectCacheTest)
+
+BOOST_AUTO_TEST_CASE(shared_sub_objects)
+{
+	string factoryA = "object \"A\" { code { sstore(0, datasize(\"Child\")) }" + childObject + "}";
+	string factoryB = "object \"B\" { code { sstore(1, dataoffset(\"Child\")) }" + childObject + "}";
+
+	auto cache = make_shared<OptimizedObjectCache>();
+	string optimizedA = optimize(factoryA, cache);
+	// A, Child and Child_deployed
+	BOOST_CHECK_EQUAL(cache->size(), 3);
+	string optimizedB = optimize(factoryB, cache);
+	// Only B is new.
+	BOOST_CHECK_EQUAL(cache->size(), 4);
+
+	BOOST_CHECK_EQUAL(optimizedA, optimize(factoryA, nullptr));
+	BOOST_CHECK_EQUAL(optimizedB, optimize(factoryB, nullptr));
+	BOOST_CHECK_EQUAL(optimize(factoryA, cache), optimizedA);
+	BOOST_CHECK_EQUAL(cache->size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(persistent_store)
+{
+	// Only objects whose source locations are printed in comments are persisted.
+	string child = boost::replace_all_copy(childObject, "object", "/// @use-src 0:\"a.sol\"\nobject");
+	string factory = "/// @use-src 0:\"a.sol\"\nobject \"A\" { code { sstore(0, datasize(\"Child\")) }" + child + "}";
+
+	map<util::h256, string> entries;
+	size_t loads = 0;
+	auto const createCache = [&]() {
+		return make_shared<OptimizedObjectCache>(OptimizedObjectCache::PersistentStore{
+			[&](util::h256 const& _key) -> optional<string> {
+				++loads;
+				if (entries.count(_key))
+					return entries.at(_key);
+				return nullopt;
+			},
+			[&](util::h256 const& _key, string const& _object) { entries[_key] = _object; }
+		});
+	};
+
+	string optimized = optimize(factory, createCache());
+	BOOST_CHECK_EQUAL(entries.size(), 3);
+	BOOST_CHECK_EQUAL(loads, 3);
+
+	// The top-level object is found in the store, so the sub-objects are not looked up.
+	loads = 0;
+	auto cache = createCache();
+	BOOST_CHECK_EQUAL(optimize(factory, cache), optimized);
+	BOOST_CHECK_EQUAL(loads, 1);
+	BOOST_CHECK_EQUAL(cache->size(), 1);
+
+	// Invalid entries are ignored.
+	for (auto& entry: entries)
+		entry.second = "object \"A\" { code { undefined() } }";
+	BOOST_CHECK_EQUAL(optimize(factory, createCache()), optimized);
+
+	entries.clear();
+	optimize("object \"A\" { code { sstore(0, datasize(\"Child\")) }" + childObject + "}", createCache());
+	BOOST_CHECK(entries.empty());
+}
+
+BOOST_AUTO_TEST_CASE(replayed_warnings)
+{
+	string factory = "object \"A\" { code { sstore(0, datasize(\"Child\")) }" + childObject + "}";
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.yulOptimiserMaxSteps = 1;
+	auto const countStopWarnings = [&](shared_ptr<OptimizedObjectCache> _cache) {
+		AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly, settings, DebugInfoSelection::All());
+		stack.setOptimizedObjectCache(move(_cache));
+		BOOST_REQUIRE(stack.parseAndAnalyze("", factory));
+		stack.optimize();
+		size_t warnings = 0;
+		for (auto const& error: stack.errors())
+			if (error->errorId() == 4391_error)
+				++warnings;
+		return warnings;
+	};
+
+	size_t const expectedWarnings = countStopWarnings(nullptr);
+	BOOST_CHECK(expectedWarnings > 0);
+	auto cache = make_shared<OptimizedObjectCache>();
+	BOOST_CHECK_EQUAL(countStopWarnings(cache), expectedWarnings);
+	// The objects are taken from the cache, which also has to report the warnings.
+	BOOST_CHECK_EQUAL(countStopWarnings(cache), expectedWarnings);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
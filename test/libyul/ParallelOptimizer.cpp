@@ -0,0 +1,145 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for optimising the functions of a Yul object in parallel.
+ */
+
+#include <libyul/AssemblyStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string optimize(string const& _source, size_t _parallelism, bool _assemble = false)
+{
+	AssemblyStack stack(
+		EVMVersion{},
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	stack.setOptimizerParallelism(_parallelism);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	stack.optimize();
+	if (_assemble)
+		return stack.assemble(AssemblyStack::Machine::EVM).bytecode->toHex();
+	return stack.print();
+}
+
+string sourceWithFunctions()
+{
+	string functions;
+	string calls;
+	for (size_t i = 0; i < 20; ++i)
+	{
+		string index = to_string(i);
+		functions +=
+			"function f" + index + "(a, b) -> r {\n"
+			"  let x := add(mul(a, 1), 0)\n"
+			"  sstore(a, x)\n"
+			"  let y := sload(a)\n"
+			"  if gt(b, " + index + ") { r := add(y, keccak256(0, 0x20)) }\n"
+			"  mstore(0, add(r, f" + to_string((i + 1) % 20) + "(b, sub(b, 1))))\n"
+			"}\n";
+		calls += "sstore(" + index + ", f" + index + "(calldataload(" + index + "), calldataload(0x20)))\n";
+	}
+	return "{\n" + calls + functions + "}\n";
+}
+
+string objectWithSubObjects(string const& _code)
+{
+	string subObjects;
+	for (size_t i = 0; i < 6; ++i)
+	{
+		string index = to_string(i);
+		subObjects +=
+			"object \"sub" + index + "\" {\n"
+			"  code { " + _code + " datacopy(0, dataoffset(\"inner\"), datasize(\"inner\")) }\n"
+			"  object \"inner\" { code { " + _code + " } }\n"
+			"}\n";
+	}
+	return "object \"root\" {\n code { " + _code + " }\n" + subObjects + "}\n";
+}
+
+vector<string> analysisErrors(string const& _source, size_t _parallelism)
+{
+	AssemblyStack stack(
+		EVMVersion{},
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	stack.setOptimizerParallelism(_parallelism);
+	BOOST_REQUIRE(!stack.parseAndAnalyze("", _source));
+	vector<string> errors;
+	for (auto const& error: stack.errors())
+	{
+		SourceLocation const* location = error->sourceLocation();
+		BOOST_REQUIRE(location);
+		errors.emplace_back(to_string(location->start) + ": " + error->what());
+	}
+	return errors;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParallelOptimizer)
+
+BOOST_AUTO_TEST_CASE(same_result)
+{
+	string source = sourceWithFunctions();
+	string serial = optimize(source, 1);
+	BOOST_CHECK_EQUAL(optimize(source, 4), serial);
+	BOOST_CHECK_EQUAL(optimize(source, 16), serial);
+}
+
+BOOST_AUTO_TEST_CASE(same_bytecode)
+{
+	string source = sourceWithFunctions();
+	string serial = optimize(source, 1, true);
+	BOOST_CHECK_EQUAL(optimize(source, 4, true), serial);
+	BOOST_CHECK_EQUAL(optimize(source, 16, true), serial);
+}
+
+BOOST_AUTO_TEST_CASE(same_result_sub_objects)
+{
+	string source = objectWithSubObjects(sourceWithFunctions());
+	string serial = optimize(source, 1);
+	BOOST_CHECK_EQUAL(optimize(source, 4), serial);
+	BOOST_CHECK_EQUAL(optimize(source, 16, true), optimize(source, 1, true));
+}
+
+BOOST_AUTO_TEST_CASE(same_errors_sub_objects)
+{
+	string source = objectWithSubObjects("{ let x := y }");
+	vector<string> serial = analysisErrors(source, 1);
+	BOOST_CHECK_EQUAL(serial.size(), 13);
+	BOOST_CHECK(analysisErrors(source, 4) == serial);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
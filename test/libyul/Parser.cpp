@@ -951,6 +951,32 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(debugData_shared_between_nodes)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	auto stream = CharStream("{ let x := 1 sstore(x, 2) }", "");
+	SourceLocation const location{10, 20, internSourceName("source0")};
+	EVMDialectTyped const& dialect = EVMDialectTyped::instance(EVMVersion{});
+	shared_ptr<Block> result = yul::Parser(reporter, dialect, location).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 2);
+
+	// All nodes have identical debug data, so they share a single object.
+	VariableDeclaration const& varX = get<VariableDeclaration>(result->statements.at(0));
+	ExpressionStatement const& statement = get<ExpressionStatement>(result->statements.at(1));
+	FunctionCall const& call = get<FunctionCall>(statement.expression);
+	BOOST_CHECK(varX.debugData == result->debugData);
+	BOOST_CHECK(varX.variables.front().debugData == result->debugData);
+	BOOST_CHECK(get<Literal>(*varX.value).debugData == result->debugData);
+	BOOST_CHECK(call.debugData == result->debugData);
+	BOOST_CHECK(get<Literal>(call.arguments.at(1)).debugData == result->debugData);
+	CHECK_LOCATION(result->debugData->originLocation, "source0", 10, 20);
+
+	BOOST_CHECK(DebugData::create() == DebugData::create());
+	BOOST_CHECK(DebugData::create() != DebugData::create(SourceLocation{0, 1, {}}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the search budget of the stack layout generator.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/Common.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// The targets of the conditional jump of the if statement use the variables in different orders.
+string const conditionalJump = R"(
+	{
+		let a := calldataload(0)
+		let b := calldataload(0x20)
+		let c := calldataload(0x40)
+		let d := calldataload(0x60)
+		let e := calldataload(0x80)
+		if calldataload(0xa0) {
+			sstore(e, d)
+			sstore(c, b)
+			sstore(a, e)
+		}
+		sstore(a, b)
+		sstore(c, d)
+		sstore(e, a)
+	}
+)";
+
+struct ParsedCFG
+{
+	shared_ptr<Object> object;
+	shared_ptr<AsmAnalysisInfo> analysisInfo;
+	unique_ptr<CFG> cfg;
+};
+
+ParsedCFG buildCFG(string const& _source)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	ErrorList errors;
+	ParsedCFG result;
+	tie(result.object, result.analysisInfo) = parse(_source, dialect, errors);
+	BOOST_REQUIRE(result.object && result.analysisInfo && !Error::containsErrors(errors));
+	result.cfg = ControlFlowGraphBuilder::build(*result.analysisInfo, dialect, *result.object->code);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulStackLayoutSearch)
+
+BOOST_AUTO_TEST_CASE(no_search_without_budget)
+{
+	ParsedCFG parsed = buildCFG(conditionalJump);
+	BOOST_TEST(StackLayoutGenerator::run(*parsed.cfg).maxSearchedCandidates == 0);
+}
+
+BOOST_AUTO_TEST_CASE(budget_is_respected)
+{
+	ParsedCFG parsed = buildCFG(conditionalJump);
+	for (size_t budget: {1u, 2u, 5u, 20u})
+	{
+		StackLayout layout = StackLayoutGenerator::run(*parsed.cfg, 1, budget);
+		BOOST_TEST(layout.maxSearchedCandidates > 0);
+		BOOST_TEST(layout.maxSearchedCandidates <= budget);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(search_ends_when_permutations_are_exhausted)
+{
+	ParsedCFG parsed = buildCFG(conditionalJump);
+	size_t const budget = 1000000;
+	size_t const searched = StackLayoutGenerator::run(*parsed.cfg, 1, budget).maxSearchedCandidates;
+	BOOST_TEST(searched > 0);
+	BOOST_TEST(searched < budget);
+	// The search does not depend on the parallelism.
+	BOOST_TEST(StackLayoutGenerator::run(*parsed.cfg, 4, budget).maxSearchedCandidates == searched);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Yul utilities.
+ */
+
+#include <libyul/Utilities.h>
+
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+u256 numberLiteralValue(string const& _value)
+{
+	return valueOfNumberLiteral(Literal{{}, LiteralKind::Number, YulString{_value}, {}});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulUtilities)
+
+BOOST_AUTO_TEST_CASE(number_literal_values)
+{
+	for (char const* literal: {
+		"0",
+		"7",
+		"9999999999999999999",
+		"10000000000000000000",
+		"18446744073709551615",
+		"18446744073709551616",
+		"0x0",
+		"0x00",
+		"0xabcDEF",
+		"0xffffffffffffffff",
+		"0x10000000000000000",
+		"0x0000000000000000000000000000000000000000000000000000000000000001",
+		"115792089237316195423570985008687907853269984665640564039457584007913129639935"
+	})
+		BOOST_CHECK_EQUAL(numberLiteralValue(literal), u256(literal));
+}
+
+BOOST_AUTO_TEST_CASE(number_literal_values_cached_per_repository)
+{
+	string const large = "0x" + string(64, 'f');
+	string const otherLarge = "0x" + string(63, 'f') + "e";
+	for (string const& literal: {large, otherLarge})
+	{
+		// Strings of a new repository can reuse the addresses of the strings of a destroyed one.
+		YulStringRepository repository;
+		YulStringRepository::Scope scope{repository};
+		BOOST_CHECK_EQUAL(numberLiteralValue(literal), u256(literal));
+		BOOST_CHECK_EQUAL(numberLiteralValue(literal), u256(literal));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(invalid_number_literals)
+{
+	for (char const* literal: {"", "01", "1a", "0xg", "0X1", "-1"})
+		BOOST_CHECK_THROW(numberLiteralValue(literal), YulAssertion);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -40,6 +40,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnswitcher.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -180,6 +181,13 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			Rematerialiser::run(*m_context, *m_ast);
 		}},
+		{"gasCostRematerialiser", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			m_context->rematerialiserGasCosts = true;
+			Rematerialiser::run(*m_context, *m_ast);
+		}},
 		{"expressionSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -263,12 +271,26 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ExpressionJoiner::run(*m_context, *m_ast);
 			ExpressionJoiner::run(*m_context, *m_ast);
 		}},
+		{"loadResolverAcrossCalls", [&]() {
+			m_context->storeKnowledgeAcrossCalls = true;
+			m_namedSteps.at("loadResolver")();
+		}},
+		{"loadResolverInLoops", [&]() {
+			m_context->storeKnowledgeInLoops = true;
+			m_namedSteps.at("loadResolver")();
+		}},
 		{"loopInvariantCodeMotion", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopUnswitcher", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			LoopUnswitcher::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -321,6 +343,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ExpressionSplitter::run(*m_context, *m_ast);
 			WordSizeTransform::run(*m_dialect, *m_dialect, *m_ast, *m_nameDispenser);
 		}},
+		{"narrowingWordSizeTransform", [&]() {
+			disambiguate();
+			ExpressionSplitter::run(*m_context, *m_ast);
+			WordSizeTransform::run(*m_dialect, *m_dialect, *m_ast, *m_nameDispenser, true);
+		}},
 		{"fullSuite", [&]() {
 			GasMeter meter(dynamic_cast<EVMDialect const&>(*m_dialect), false, 200);
 			OptimiserSuite::run(
@@ -379,6 +406,10 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FakeUnreachableGenerator fakeUnreachableGenerator;
 			fakeUnreachableGenerator(*m_ast);
 			StackLimitEvader::run(*m_context, *m_object, fakeUnreachableGenerator.fakeUnreachables);
+		}},
+		{"fakeStackLimitEvaderReusingSlots", [&]() {
+			m_context->reuseMemorySlots = true;
+			m_namedSteps.at("fakeStackLimitEvader")();
 		}}
 	};
 }
@@ -413,13 +444,14 @@ string YulOptimizerTestCommon::randomOptimiserStep(unsigned _seed)
 		if (count == idx)
 		{
 			string optimiserStep = step.first;
-			// Do not fuzz mainFunction and wordSizeTransform
+			// Do not fuzz mainFunction and the word size transforms
 			// because they do not preserve yul code semantics.
 			// Do not fuzz reasoning based simplifier because
 			// it can sometimes drain memory.
 			if (
 				optimiserStep == "mainFunction"	||
 				optimiserStep == "wordSizeTransform" ||
+				optimiserStep == "narrowingWordSizeTransform" ||
 				optimiserStep == "reasoningBasedSimplifier"
 			)
 				// "Fullsuite" is fuzzed roughly four times more frequently than
@@ -433,6 +465,14 @@ string YulOptimizerTestCommon::randomOptimiserStep(unsigned _seed)
 	yulAssert(false, "Optimiser step selection failed.");
 }
 
+vector<string> YulOptimizerTestCommon::optimiserSteps() const
+{
+	vector<string> steps;
+	for (auto const& step: m_namedSteps)
+		steps.emplace_back(step.first);
+	return steps;
+}
+
 shared_ptr<Block> YulOptimizerTestCommon::run()
 {
 	return runStep() ? m_ast : nullptr;
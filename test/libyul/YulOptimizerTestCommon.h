@@ -25,6 +25,7 @@
 
 #include <set>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -56,6 +57,8 @@ public:
 	/// @param _seed is an unsigned integer that
 	/// seeds the random selection.
 	std::string randomOptimiserStep(unsigned _seed);
+	/// @returns the names of all optimiser steps that can be chosen using setStep().
+	std::vector<std::string> optimiserSteps() const;
 private:
 	void disambiguate();
 	void updateContext();
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for YulString and YulStringRepository.
+ */
+
+#include <libyul/YulString.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	YulString c{"abd"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK(&a.str() == &b.str());
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK(!a.empty());
+	BOOST_CHECK_EQUAL(YulString{}.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(scoped_repository)
+{
+	YulString global{"x"};
+	YulStringRepository repository;
+	{
+		YulStringRepository::Scope scope(repository);
+		BOOST_CHECK(&YulStringRepository::instance() == &repository);
+		YulString local{"x"};
+		BOOST_CHECK_EQUAL(local.str(), "x");
+		BOOST_CHECK(&local.str() != &global.str());
+		BOOST_CHECK(YulString{"x"} == local);
+		{
+			YulStringRepository inner;
+			YulStringRepository::Scope innerScope(inner);
+			BOOST_CHECK(&YulStringRepository::instance() == &inner);
+		}
+		BOOST_CHECK(&YulStringRepository::instance() == &repository);
+	}
+	BOOST_CHECK(&YulStringRepository::instance() != &repository);
+	BOOST_CHECK(YulString{"x"} == global);
+}
+
+BOOST_AUTO_TEST_CASE(dialects_per_repository)
+{
+	EVMDialect const& globalDialect = EVMDialect::strictAssemblyForEVMObjects({});
+	BOOST_CHECK(&EVMDialect::strictAssemblyForEVMObjects({}) == &globalDialect);
+
+	YulStringRepository repository;
+	YulStringRepository::Scope scope(repository);
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects({});
+	BOOST_CHECK(&dialect != &globalDialect);
+	BOOST_CHECK(&EVMDialect::strictAssemblyForEVMObjects({}) == &dialect);
+	BOOST_CHECK(dialect.builtin(YulString{"add"}));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	YulStringRepository repository;
+	vector<vector<YulString>> strings(8);
+	util::parallelForEach(strings.size(), 4, [&](size_t _index) {
+		YulStringRepository::Scope scope(repository);
+		// Enough strings for the table to grow several times while other threads read it.
+		for (size_t i = 0; i < 20000; ++i)
+			strings[_index].emplace_back("s" + to_string(i));
+	});
+	for (auto const& threadStrings: strings)
+		BOOST_CHECK(threadStrings == strings.front());
+	BOOST_CHECK_EQUAL(strings.front()[42].str(), "s42");
+	BOOST_CHECK_EQUAL(strings.front()[12345].hash(), YulStringRepository::hash("s12345"));
+	BOOST_CHECK(strings.front()[1] != strings.front()[2]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -6,6 +6,7 @@ import json
 import os
 import subprocess
 import sys
+import time
 import traceback
 
 from typing import Any, List, Optional, Tuple, Union
@@ -56,7 +57,7 @@ class JsonRpcProcess:
         while True:
             # read header
             line = self.process.stdout.readline()
-            if line == '':
+            if line == b'':
                 # server quit
                 return None
             line = line.decode("utf-8")
@@ -83,17 +84,28 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
-        if self.process.stdin is None:
-            return
+    def send_message(self, method_name: str, params: Optional[dict], message_id: Optional[Any] = None) -> None:
         message = {
             'jsonrpc': '2.0',
             'method': method_name,
             'params': params
         }
+        if message_id is not None:
+            message['id'] = message_id
+        self.send_raw_message(message, f'send_message ({method_name})')
+
+    def send_response(self, message_id: Any, result: Any) -> None:
+        """
+        Responds to a request that was sent by the server.
+        """
+        self.send_raw_message({'jsonrpc': '2.0', 'id': message_id, 'result': result}, 'send_response')
+
+    def send_raw_message(self, message: dict, topic: str) -> None:
+        if self.process.stdin is None:
+            return
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
-        self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
+        self.trace(topic, json.dumps(message, indent=4, sort_keys=True))
         self.process.stdin.write(rpc_message.encode("utf-8"))
         self.process.stdin.flush()
 
@@ -174,6 +186,7 @@ class SolidityLSPTestSuite: # {{{
     print_assertions: bool = False
     trace_io: bool = False
     test_pattern: str
+    request_counter: int = 0
 
     def __init__(self):
         colorama.init()
@@ -223,7 +236,7 @@ class SolidityLSPTestSuite: # {{{
 
         return min(max(self.test_counter.failed, self.assertion_counter.failed), 127)
 
-    def setup_lsp(self, lsp: JsonRpcProcess, expose_project_root=True):
+    def setup_lsp(self, lsp: JsonRpcProcess, expose_project_root=True, window_capabilities: Optional[dict] = None):
         """
         Prepares the solc LSP server by calling `initialize`,
         and `initialized` methods.
@@ -248,6 +261,8 @@ class SolidityLSPTestSuite: # {{{
         }
         if not expose_project_root:
             params['rootUri'] = None
+        if window_capabilities is not None:
+            params['capabilities']['window'] = window_capabilities
         lsp.call_method('initialize', params)
         lsp.send_notification('initialized')
 
@@ -324,6 +339,85 @@ class SolidityLSPTestSuite: # {{{
         )
         return self.wait_for_diagnostics(solc_process, max_diagnostic_reports)
 
+    def send_request(self, solc: JsonRpcProcess, method_name: str, params: dict) -> int:
+        """
+        Sends a request with a new ID and returns the ID.
+        """
+        self.request_counter += 1
+        solc.send_message(method_name, params, self.request_counter)
+        return self.request_counter
+
+    def wait_for_response(self, solc: JsonRpcProcess, message_id: int) -> Any:
+        """
+        Returns the result of the response to the request with the given ID.
+        Messages received before it (e.g. published diagnostics) are skipped.
+        """
+        while True:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' in message or message.get('id') != message_id:
+                continue
+            if 'error' in message:
+                raise RuntimeError(f"Error {message['error']['code']} received. {message['error']['message']}")
+            return message['result']
+
+    def call_request(self, solc: JsonRpcProcess, method_name: str, params: dict) -> Any:
+        return self.wait_for_response(solc, self.send_request(solc, method_name, params))
+
+    def wait_for_workspace_symbols(self, solc: JsonRpcProcess, query: str, count: int) -> List[dict]:
+        """
+        Queries the workspace symbols until there are `count` of them, since the workspace
+        is indexed in the background after the initialization.
+        """
+        symbols: List[dict] = []
+        for _ in range(0, 100):
+            symbols = self.call_request(solc, 'workspace/symbol', {'query': query})
+            if len(symbols) == count:
+                return symbols
+            time.sleep(0.05)
+        return symbols
+
+    @staticmethod
+    def text_document_position(uri: str, line: int, character: int) -> dict:
+        return {
+            'textDocument': {'uri': uri},
+            'position': {'line': line, 'character': character}
+        }
+
+    @staticmethod
+    def location(uri: str, line: int, start_character: int, end_character: int) -> dict:
+        return {
+            'uri': uri,
+            'range': {
+                'start': {'line': line, 'character': start_character},
+                'end': {'line': line, 'character': end_character}
+            }
+        }
+
+    @staticmethod
+    def decode_semantic_tokens(data: List[int]) -> List[Tuple[int, int, int, int, int]]:
+        """
+        Converts the relative positions of the semantic tokens into absolute
+        (line, character, length, type, modifiers) tuples.
+        """
+        assert len(data) % 5 == 0
+        tokens = []
+        line = 0
+        character = 0
+        for i in range(0, len(data), 5):
+            [delta_line, delta_character, length, token_type, modifiers] = data[i:i + 5]
+            line += delta_line
+            character = delta_character if delta_line > 0 else character + delta_character
+            tokens.append((line, character, length, token_type, modifiers))
+        return tokens
+
+    @staticmethod
+    def apply_semantic_tokens_edits(data: List[int], edits: List[dict]) -> List[int]:
+        result = list(data)
+        for edit in sorted(edits, key=lambda e: e['start'], reverse=True):
+            result[edit['start']:edit['start'] + edit['deleteCount']] = edit.get('data', [])
+        return result
+
     def expect_equal(self, actual, expected, description="Equality") -> None:
         self.assertion_counter.total += 1
         prefix = f"[{self.assertion_counter.total}] {SGR_ASSERT_BEGIN}{description}: "
@@ -866,6 +960,216 @@ class SolidityLSPTestSuite: # {{{
             "diagnostic: check range"
         )
 
+    def test_textDocument_definition_and_references(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'didOpen_with_import'
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, 2)
+        MAIN_URI = self.get_test_file_uri(TEST_NAME)
+        LIB_URI = self.get_test_file_uri('lib')
+
+        # `add` in `Lib.add(2 * a, b)` is defined in lib.sol.
+        definition = self.call_request(solc, 'textDocument/definition', self.text_document_position(MAIN_URI, 9, 20))
+        self.expect_equal(definition, [self.location(LIB_URI, 5, 13, 16)], "definition of Lib.add")
+
+        # The parameter `a` is used once.
+        params = self.text_document_position(MAIN_URI, 9, 27)
+        params['context'] = {'includeDeclaration': True}
+        references = self.call_request(solc, 'textDocument/references', params)
+        self.expect_equal(
+            references,
+            [self.location(MAIN_URI, 7, 20, 21), self.location(MAIN_URI, 9, 27, 28)],
+            "references of parameter a including its declaration"
+        )
+        params['context'] = {'includeDeclaration': False}
+        references = self.call_request(solc, 'textDocument/references', params)
+        self.expect_equal(references, [self.location(MAIN_URI, 9, 27, 28)], "references of parameter a")
+
+        # A position without a declaration.
+        definition = self.call_request(solc, 'textDocument/definition', self.text_document_position(MAIN_URI, 2, 0))
+        self.expect_equal(definition, [], "no definition")
+
+    def test_workspace_symbol(self, solc: JsonRpcProcess) -> None:
+        TEMPORARY_FILE_NAME = 'workspace_symbol_temporary'
+        TEMPORARY_FILE_URI = self.get_test_file_uri(TEMPORARY_FILE_NAME)
+        with open(self.get_test_file_path(TEMPORARY_FILE_NAME), mode="w", encoding="utf-8") as f:
+            f.write('// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\ncontract TemporarySymbolTest {}\n')
+        try:
+            self.setup_lsp(solc)
+
+            # Files that are not open are indexed after the initialization.
+            symbols = self.wait_for_workspace_symbols(solc, 'makesomeerror', 1)
+            self.expect_equal(
+                symbols,
+                [{
+                    'name': 'makeSomeError',
+                    'kind': 6, # Method
+                    'containerName': 'C',
+                    'location': self.location(self.get_test_file_uri('publish_diagnostics_2'), 5, 13, 26)
+                }],
+                "symbol of a file that is not open"
+            )
+            symbols = self.wait_for_workspace_symbols(solc, 'TemporarySymbolTest', 1)
+            self.expect_equal(
+                symbols,
+                [{'name': 'TemporarySymbolTest', 'kind': 5, 'location': self.location(TEMPORARY_FILE_URI, 2, 9, 28)}],
+                "symbol of the temporary file"
+            )
+        finally:
+            os.remove(self.get_test_file_path(TEMPORARY_FILE_NAME))
+
+        # The symbols of deleted files are removed from the index.
+        solc.send_notification('workspace/didChangeWatchedFiles', {
+            'changes': [{'uri': TEMPORARY_FILE_URI, 'type': 3}]
+        })
+        symbols = self.call_request(solc, 'workspace/symbol', {'query': 'TemporarySymbolTest'})
+        self.expect_equal(symbols, [], "no symbols of the deleted file")
+
+        # Symbols of open files are taken from the editor.
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': TEMPORARY_FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\ninterface TemporarySymbolTest {}\n'
+            }
+        })
+        self.wait_for_diagnostics(solc, 1)
+        symbols = self.call_request(solc, 'workspace/symbol', {'query': 'TemporarySymbolTest'})
+        self.expect_equal(
+            symbols,
+            [{'name': 'TemporarySymbolTest', 'kind': 11, 'location': self.location(TEMPORARY_FILE_URI, 2, 10, 29)}],
+            "symbol of the open file"
+        )
+
+    def test_threaded_transport_answers_requests_before_shutdown(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'didOpen_with_import'
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, 2)
+        MAIN_URI = self.get_test_file_uri(TEST_NAME)
+
+        # The messages are sent without waiting for the responses, so that they are queued
+        # while the server is busy. The notifications overtake the requests, but the shutdown
+        # and exit must not.
+        definition_id = self.send_request(solc, 'textDocument/definition', self.text_document_position(MAIN_URI, 9, 20))
+        symbol_id = self.send_request(solc, 'textDocument/documentSymbol', {'textDocument': {'uri': MAIN_URI}})
+        self.send_request(solc, 'shutdown', None)
+        solc.send_notification('exit')
+
+        responses = {}
+        while True:
+            message = solc.receive_message()
+            if message is None:
+                break
+            if 'method' not in message:
+                responses[message['id']] = message
+        self.expect_equal(definition_id in responses, True, "definition answered before the server stopped")
+        self.expect_equal(symbol_id in responses, True, "document symbols answered before the server stopped")
+        self.expect_equal(solc.process.wait(timeout=5.0), 0, "normal termination after shutdown and exit")
+
+    def test_progress(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc, window_capabilities={'workDoneProgress': True})
+        TEST_NAME = 'publish_diagnostics_1'
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': self.get_test_file_uri(TEST_NAME),
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': self.get_test_file_contents(TEST_NAME)
+            }
+        })
+
+        # The server asks for a progress indicator for the compilation.
+        message = solc.receive_message()
+        assert message is not None
+        self.expect_equal(message['method'], 'window/workDoneProgress/create', "progress indicator requested")
+        token = message['params']['token']
+        self.expect_equal(message['id'], token, "request ID is the token")
+        solc.send_response(token, None)
+
+        # The progress is only reported once the indicator was created, which depends on
+        # how fast the compilation is. If it is reported, it is begun and reported before
+        # the diagnostics are published and ended afterwards.
+        kinds = []
+        while True:
+            message = solc.receive_message()
+            assert message is not None
+            if message['method'] == 'textDocument/publishDiagnostics':
+                break
+            self.expect_equal(message['method'], '$/progress', "progress notification")
+            self.expect_equal(message['params']['token'], token, "progress token")
+            kinds.append(message['params']['value']['kind'])
+        if len(kinds) > 0:
+            message = solc.receive_message()
+            assert message is not None
+            self.expect_equal(message['method'], '$/progress', "progress notification")
+            self.expect_equal(message['params']['token'], token, "progress token")
+            kinds.append(message['params']['value']['kind'])
+            self.expect_equal(kinds[0], 'begin', "progress begins")
+            self.expect_equal(kinds[-1], 'end', "progress ends")
+            self.expect_equal(set(kinds[1:-1]) <= {'report'}, True, "progress reported in between")
+
+    def test_textDocument_documentSymbol(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'lib'
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME)
+        URI = self.get_test_file_uri(TEST_NAME)
+
+        symbols = self.call_request(solc, 'textDocument/documentSymbol', {'textDocument': {'uri': URI}})
+        self.expect_equal(
+            symbols,
+            [
+                {'name': 'Lib', 'kind': 2, 'location': self.location(URI, 3, 8, 11)},
+                {'name': 'add', 'kind': 6, 'containerName': 'Lib', 'location': self.location(URI, 5, 13, 16)},
+                {'name': 'warningWithUnused', 'kind': 6, 'containerName': 'Lib', 'location': self.location(URI, 10, 13, 30)},
+            ],
+            "document symbols"
+        )
+
+    def test_textDocument_semanticTokens(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'lib'
+        self.open_file_and_wait_for_diagnostics(solc, TEST_NAME)
+        URI = self.get_test_file_uri(TEST_NAME)
+
+        # Types and modifiers as in the legend of the server.
+        CLASS, FUNCTION, VARIABLE = 5, 10, 13
+        DECLARATION = 1
+        full = self.call_request(solc, 'textDocument/semanticTokens/full', {'textDocument': {'uri': URI}})
+        tokens = self.decode_semantic_tokens(full['data'])
+        self.expect_equal((3, 8, 3, CLASS, DECLARATION) in tokens, True, "token of library Lib")
+        self.expect_equal((5, 13, 3, FUNCTION, DECLARATION) in tokens, True, "token of function add")
+        self.expect_equal((12, 13, 6, VARIABLE, DECLARATION) in tokens, True, "token of variable unused")
+
+        # Without changes, the delta is empty.
+        delta = self.call_request(solc, 'textDocument/semanticTokens/full/delta', {
+            'textDocument': {'uri': URI},
+            'previousResultId': full['resultId']
+        })
+        self.expect_equal(delta['edits'], [], "no edits without changes")
+
+        # Rename the variable `unused` to `u`.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': URI},
+            'contentChanges': [{
+                'range': {
+                    'start': {'line': 12, 'character': 14},
+                    'end': {'line': 12, 'character': 19}
+                },
+                'text': ''
+            }]
+        })
+        self.wait_for_diagnostics(solc, 1)
+        delta = self.call_request(solc, 'textDocument/semanticTokens/full/delta', {
+            'textDocument': {'uri': URI},
+            'previousResultId': delta['resultId']
+        })
+        self.expect_equal(len(delta['edits']) > 0, True, "edits after a change")
+        updated = self.apply_semantic_tokens_edits(full['data'], delta['edits'])
+        tokens = self.decode_semantic_tokens(updated)
+        self.expect_equal((12, 13, 1, VARIABLE, DECLARATION) in tokens, True, "token of renamed variable")
+        full = self.call_request(solc, 'textDocument/semanticTokens/full', {'textDocument': {'uri': URI}})
+        self.expect_equal(updated, full['data'], "edits lead to the full tokens")
+
     # }}}
     # }}}
 
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+import unittest
+
+from textwrap import dedent
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from semantic_test_gas_report import compare_gas_expectations, format_table, GasChange, parse_gas_expectations
+# pragma pylint: enable=import-error
+
+OLD_TEST = dedent("""
+    contract C {
+        function f(uint x) public returns (uint) { return x; }
+    }
+    // ----
+    // constructor()
+    // gas irOptimized: 100000
+    // gas legacy: 120000
+    // f(uint256): 1 -> 1
+    // gas legacy: 200000
+    // f(uint256): 1 -> 1
+    // ~ emit E()
+    // gas legacy: 300000
+    // g() ->
+    // # comment #
+    // gas legacy: 400000
+""")
+
+NEW_TEST = dedent("""
+    contract C {
+        function f(uint x) public returns (uint) { return x; }
+    }
+    // ----
+    // constructor()
+    // gas irOptimized: 90000
+    // gas legacy: 120000
+    // f(uint256): 1 -> 1
+    // gas legacy: 200000
+    // f(uint256): 1 -> 1
+    // ~ emit E()
+    // gas legacy: 330000
+    // h() -> 2
+    // gas legacy: 10000
+""")
+
+
+class TestSemanticTestGasReport(unittest.TestCase):
+    def setUp(self):
+        self.maxDiff = 10000
+
+    def test_parse_gas_expectations(self):
+        self.assertEqual(parse_gas_expectations(OLD_TEST), {
+            ('constructor()', 0): {'irOptimized': 100000, 'legacy': 120000},
+            ('f(uint256): 1', 0): {'legacy': 200000},
+            ('f(uint256): 1', 1): {'legacy': 300000},
+            ('g()', 0): {'legacy': 400000},
+        })
+
+    def test_parse_gas_expectations_ignores_source(self):
+        self.assertEqual(parse_gas_expectations("contract C {}\n// gas legacy: 2\n"), {})
+
+    def test_compare_gas_expectations(self):
+        self.assertEqual(compare_gas_expectations('c.sol', OLD_TEST, NEW_TEST), [
+            GasChange('c.sol', 'constructor()', 'irOptimized', 100000, 90000),
+            GasChange('c.sol', 'f(uint256): 1', 'legacy', 300000, 330000),
+            GasChange('c.sol', 'h()', 'legacy', None, 10000),
+            GasChange('c.sol', 'g()', 'legacy', 400000, None),
+        ])
+        self.assertEqual(compare_gas_expectations('c.sol', OLD_TEST, NEW_TEST)[0].percentage, -10)
+        self.assertIsNone(compare_gas_expectations('c.sol', OLD_TEST, NEW_TEST)[2].percentage)
+
+    def test_format_table(self):
+        self.assertEqual(
+            format_table([GasChange('c.sol', 'f(uint256): 1', 'legacy', 300000, 330000)]),
+            dedent("""\
+                | File name | Call          | Setting | Old    | New    | Change (%) |
+                |-----------|---------------|---------|--------|--------|------------|
+                | c.sol     | f(uint256): 1 | legacy  | 300000 | 330000 | +10.00     |"""
+            )
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
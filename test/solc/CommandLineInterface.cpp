@@ -28,6 +28,7 @@
 #include <test/FilesystemUtils.h>
 #include <test/TemporaryDirectory.h>
 
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
 
 #include <boost/algorithm/string.hpp>
@@ -395,6 +396,177 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_server)
+{
+	auto frame = [](string const& _content) {
+		return "Content-Length: " + to_string(_content.size()) + "\r\n\r\n" + _content;
+	};
+	string input = R"({"language": "Solidity", "sources": {"A": {"content": "contract C {}"}}})";
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--standard-json", "--server"},
+		frame(input) + frame("{") + frame(input)
+	);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.options.input.standardJsonServer);
+
+	vector<Json::Value> outputs;
+	string_view remaining = result.stdoutContent;
+	while (!remaining.empty())
+	{
+		size_t headerEnd = remaining.find("\r\n\r\n");
+		BOOST_REQUIRE(boost::starts_with(remaining, "Content-Length: ") && headerEnd != string::npos);
+		size_t length = stoul(string(remaining.substr(16, headerEnd - 16)));
+		Json::Value output;
+		BOOST_REQUIRE(util::jsonParseStrict(string(remaining.substr(headerEnd + 4, length)), output));
+		outputs.emplace_back(move(output));
+		remaining.remove_prefix(headerEnd + 4 + length);
+	}
+	BOOST_REQUIRE_EQUAL(outputs.size(), 3);
+	BOOST_TEST(!outputs[0].isMember("errors"));
+	BOOST_TEST(outputs[1]["errors"][0]["type"].asString() == "JSONError");
+	BOOST_TEST(outputs[2] == outputs[0]);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server_invalid_content_length)
+{
+	for (string length: {"99999999999999999999999", "9223372036854775808", "12x", "-1"})
+	{
+		OptionsReaderAndMessages result = runCLI(
+			{"solc", "--standard-json", "--server"},
+			"Content-Length: " + length + "\r\n\r\n{}"
+		);
+		BOOST_TEST(!result.success);
+		BOOST_TEST(result.stderrContent == "Invalid Content-Length header: \"Content-Length: " + length + "\".\n");
+	}
+
+	// A length that is larger than the input is not allocated up front.
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--standard-json", "--server"},
+		"Content-Length: 9223372036854775807\r\n\r\n{}"
+	);
+	BOOST_TEST(!result.success);
+	BOOST_TEST(result.stderrContent == "Standard input closed before the end of the Standard JSON input.\n");
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server_input_file)
+{
+	string expectedMessage = "Input files are not accepted with --server. The inputs are read from standard input.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--standard-json", "--server", "input.json"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cli_output_dir_jobs)
+{
+	TemporaryDirectory tempDir({"sequential/", "parallel/"}, TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "input.sol",
+		"// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n"
+		"contract A { function f() public {} } contract B is A {} interface I { function g() external; }\n"
+	);
+	vector<string> commandLine = {
+		"solc",
+		(tempDir.path() / "input.sol").string(),
+		"--bin",
+		"--abi",
+		"--hashes",
+		"--metadata",
+		"--combined-json",
+		"abi",
+		"--output-dir",
+	};
+	auto run = [&](string const& _dir, string const& _jobs) {
+		vector<string> arguments = commandLine;
+		arguments.insert(arguments.end(), {(tempDir.path() / _dir).string(), "--jobs", _jobs});
+		return runCLI(arguments, "");
+	};
+	BOOST_REQUIRE(run("sequential", "1").success);
+	BOOST_REQUIRE(run("parallel", "4").success);
+
+	// The files written in parallel are the same.
+	map<string, string> sequentialFiles;
+	for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path() / "sequential"))
+		sequentialFiles[entry.path().filename().string()] = util::readFileAsString(entry.path());
+	map<string, string> parallelFiles;
+	for (auto const& entry: boost::filesystem::directory_iterator(tempDir.path() / "parallel"))
+		parallelFiles[entry.path().filename().string()] = util::readFileAsString(entry.path());
+	BOOST_CHECK(sequentialFiles.count("B.abi") && sequentialFiles.count("combined.json"));
+	BOOST_CHECK_EQUAL(parallelFiles, sequentialFiles);
+
+	OptionsReaderAndMessages result = run("parallel", "4");
+	BOOST_TEST(!result.success);
+	BOOST_TEST(result.stderrContent.find("Refusing to overwrite existing file") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(cli_link_jobs)
+{
+	TemporaryDirectory tempDir({"sequential/", "parallel/"}, TEST_CASE_NAME);
+	string const resolvedPlaceholder = "__L" + string(35, '_') + "__";
+	string const unresolvedPlaceholder = "__M" + string(35, '_') + "__";
+	vector<string> fileNames;
+	for (size_t i = 0; i < 6; ++i)
+	{
+		string code = "6080" + resolvedPlaceholder + "00" + (i % 2 ? unresolvedPlaceholder : "") + resolvedPlaceholder;
+		fileNames.push_back("object" + to_string(i) + ".bin");
+		createFileWithContent(tempDir.path() / "sequential" / fileNames.back(), code);
+		createFileWithContent(tempDir.path() / "parallel" / fileNames.back(), code);
+	}
+	auto run = [&](string const& _dir, string const& _jobs) {
+		vector<string> commandLine = {"solc", "--link", "--libraries", "L=0x1234567890123456789012345678901234567890"};
+		for (string const& fileName: fileNames)
+			commandLine.push_back((tempDir.path() / _dir / fileName).string());
+		commandLine.insert(commandLine.end(), {"--jobs", _jobs});
+		return runCLI(commandLine, "");
+	};
+	OptionsReaderAndMessages sequentialResult = run("sequential", "1");
+	OptionsReaderAndMessages parallelResult = run("parallel", "4");
+	BOOST_REQUIRE(sequentialResult.success);
+	BOOST_REQUIRE(parallelResult.success);
+
+	// The warnings about unresolved references are reported in the order of the files.
+	BOOST_TEST(
+		boost::replace_all_copy(parallelResult.stderrContent, "parallel", "sequential") ==
+		sequentialResult.stderrContent
+	);
+	BOOST_TEST(sequentialResult.stderrContent.find("object1.bin") < sequentialResult.stderrContent.find("object3.bin"));
+	for (string const& fileName: fileNames)
+	{
+		string linkedCode = util::readFileAsString(tempDir.path() / "parallel" / fileName);
+		BOOST_TEST(linkedCode == util::readFileAsString(tempDir.path() / "sequential" / fileName));
+		BOOST_TEST(linkedCode.find(resolvedPlaceholder) == string::npos);
+		BOOST_TEST(linkedCode.find("1234567890123456789012345678901234567890") == 4);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cli_combined_json_compact)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(tempDir.path() / "a.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B {} contract A is B { function f() public {} }\n");
+	createFileWithContent(tempDir.path() / "b.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"./a.sol\"; contract C is A {}\n");
+	vector<string> commandLine = {
+		"solc",
+		(tempDir.path() / "a.sol").string(),
+		(tempDir.path() / "b.sol").string(),
+		"--combined-json",
+		"abi,ast,bin,hashes,srcmap",
+	};
+
+	// The compact output, which is printed one entry at a time, is the compact serialisation of the output.
+	OptionsReaderAndMessages result = runCLI(commandLine, "");
+	BOOST_REQUIRE(result.success);
+	commandLine.push_back("--pretty-json");
+	OptionsReaderAndMessages prettyResult = runCLI(commandLine, "");
+	BOOST_REQUIRE(prettyResult.success);
+	Json::Value output;
+	BOOST_REQUIRE(util::jsonParseStrict(prettyResult.stdoutContent, output));
+	BOOST_CHECK(output["contracts"].isObject() && output["contracts"].size() == 3);
+	BOOST_CHECK(output["sources"].isObject() && output["sources"].size() == 2);
+	BOOST_CHECK_EQUAL(result.stdoutContent, util::jsonCompactPrint(output) + "\n");
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
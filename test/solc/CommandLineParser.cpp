@@ -121,12 +121,15 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--overwrite",
 			"--evm-version=spuriousDragon",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--time-report",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
 			"--error-codes",
+			"--suppress-warnings=2072,5740",
 			"--libraries="
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
@@ -141,13 +144,24 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--stack-layout-search-budget=100",
+			"--model-checker-cache-dir=/tmp/smt-cache",
+			"--model-checker-contract-time-budget=2000",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
+			"--model-checker-counterexample-limit=3",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
+			"--model-checker-invariant-hints",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-print-stats",
+			"--model-checker-race-solvers",
 			"--model-checker-show-unproved",
+			"--model-checker-slice-horn-clauses",
+			"--model-checker-solver-memory-limit=1024",
+			"--model-checker-solver-processes=4",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
+			"--model-checker-time-budget=60000",
 			"--model-checker-timeout=5",
 		};
 
@@ -176,6 +190,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.experimentalViaIR = true;
+		expectedOptions.output.jobs = 4;
+		expectedOptions.output.timeReport = true;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -185,6 +201,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		};
 		expectedOptions.formatting.coloredOutput = false;
 		expectedOptions.formatting.withErrorIds = true;
+		expectedOptions.formatting.suppressedWarnings = {langutil::ErrorId{2072}, langutil::ErrorId{5740}};
 		expectedOptions.compiler.outputs = {
 			true, true, true, true, true,
 			true, true, true, true, true,
@@ -204,17 +221,28 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.enabled = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.stackLayoutSearchBudget = 100;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
+			"/tmp/smt-cache",
+			2000,
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
+			3,
 			true,
 			{true, false},
+			true,
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
 			true,
+			true,
+			true,
+			1024,
+			4,
 			{false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
+			60000,
 			5,
+			true,
 		};
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
@@ -275,17 +303,27 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--metadata-hash=swarm",       // Ignored in assembly mode
 			"--metadata-literal",          // Ignored in assembly mode
+			"--model-checker-cache-dir=/tmp/smt-cache", // Ignored in assembly mode
+			"--model-checker-contract-time-budget=2000", // Ignored in assembly mode
 			"--model-checker-contracts="   // Ignored in assembly mode
 				"contract1.yul:A,"
 				"contract2.yul:B",
+			"--model-checker-counterexample-limit=3", // Ignored in assembly mode
 			"--model-checker-div-mod-no-slacks", // Ignored in assembly mode
 			"--model-checker-engine=bmc",  // Ignored in assembly mode
+			"--model-checker-invariant-hints", // Ignored in assembly mode
 			"--model-checker-invariants=contract,reentrancy",  // Ignored in assembly mode
+			"--model-checker-print-stats", // Ignored in assembly mode
+			"--model-checker-race-solvers", // Ignored in assembly mode
 			"--model-checker-show-unproved", // Ignored in assembly mode
+			"--model-checker-slice-horn-clauses", // Ignored in assembly mode
+			"--model-checker-solver-memory-limit=1024", // Ignored in assembly mode
+			"--model-checker-solver-processes=4", // Ignored in assembly mode
 			"--model-checker-solvers=z3,smtlib2", // Ignored in assembly mode
 			"--model-checker-targets="     // Ignored in assembly mode
 				"underflow,"
 				"divByZero",
+			"--model-checker-time-budget=60000", // Ignored in assembly mode
 			"--model-checker-timeout=5",   // Ignored in assembly mode
 			"--asm",
 			"--bin",
@@ -359,6 +397,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--ignore-missing",
 		"--output-dir=/tmp/out",           // Accepted but has no effect in Standard JSON mode
 		"--overwrite",                     // Accepted but has no effect in Standard JSON mode
+		"--cache-dir=/tmp/cache",
 		"--evm-version=spuriousDragon",    // Ignored in Standard JSON mode
 		"--revert-strings=strip",          // Accepted but has no effect in Standard JSON mode
 		"--pretty-json",
@@ -372,17 +411,27 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--combined-json=abi,bin",         // Accepted but has no effect in Standard JSON mode
 		"--metadata-hash=swarm",           // Ignored in Standard JSON mode
 		"--metadata-literal",              // Ignored in Standard JSON mode
+		"--model-checker-cache-dir=/tmp/smt-cache", // Ignored in Standard JSON mode
+		"--model-checker-contract-time-budget=2000", // Ignored in Standard JSON mode
 		"--model-checker-contracts="       // Ignored in Standard JSON mode
 			"contract1.yul:A,"
 			"contract2.yul:B",
+		"--model-checker-counterexample-limit=3", // Ignored in Standard JSON mode
 		"--model-checker-div-mod-no-slacks", // Ignored in Standard JSON mode
 		"--model-checker-engine=bmc",      // Ignored in Standard JSON mode
+		"--model-checker-invariant-hints",    // Ignored in Standard JSON mode
 		"--model-checker-invariants=contract,reentrancy",      // Ignored in Standard JSON mode
+		"--model-checker-print-stats",        // Ignored in Standard JSON mode
+		"--model-checker-race-solvers",       // Ignored in Standard JSON mode
 		"--model-checker-show-unproved",      // Ignored in Standard JSON mode
+		"--model-checker-slice-horn-clauses", // Ignored in Standard JSON mode
+		"--model-checker-solver-memory-limit=1024", // Ignored in Standard JSON mode
+		"--model-checker-solver-processes=4", // Ignored in Standard JSON mode
 		"--model-checker-solvers=z3,smtlib2", // Ignored in Standard JSON mode
 		"--model-checker-targets="         // Ignored in Standard JSON mode
 			"underflow,"
 			"divByZero",
+		"--model-checker-time-budget=60000", // Ignored in Standard JSON mode
 		"--model-checker-timeout=5",       // Ignored in Standard JSON mode
 	};
 
@@ -396,6 +445,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.input.ignoreMissingFiles = true;
 	expectedOptions.output.dir = "/tmp/out";
 	expectedOptions.output.overwriteFiles = true;
+	expectedOptions.output.cacheDirectory = "/tmp/cache";
 	expectedOptions.output.revertStrings = RevertStrings::Strip;
 	expectedOptions.formatting.json = JsonFormat {JsonFormat::Pretty, 1};
 	expectedOptions.formatting.coloredOutput = false;
@@ -431,6 +481,19 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		}
 }
 
+BOOST_AUTO_TEST_CASE(invalid_suppressed_warnings)
+{
+	for (string errorCode: {"abc", "-1", "2072x", ""})
+	{
+		vector<string> commandLine = {"solc", "file", "--suppress-warnings=2072," + errorCode};
+
+		string expectedMessage = "Invalid error code in --suppress-warnings: \"" + errorCode + "\".";
+		auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+
+		BOOST_CHECK_EXCEPTION(parseCommandLine(commandLine), CommandLineValidationError, hasCorrectMessage);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
@@ -32,6 +32,9 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	bool acceptUpdates = false;
+	/// Number of test cases that are run in parallel. If larger than one, failing test cases
+	/// are not handled interactively.
+	size_t jobs = 1;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
 
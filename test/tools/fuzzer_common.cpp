@@ -103,14 +103,24 @@ void FuzzerUtil::testCompiler(
 	{
 		forceSMT(_input);
 		compiler.setModelCheckerSettings({
+			/*cacheDirectory=*/{},
+			/*contractTimeBudget=*/{},
 			frontend::ModelCheckerContracts::Default(),
+			/*counterexampleLimit=*/{},
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
+			/*invariantHints=*/false,
 			frontend::ModelCheckerInvariants::All(),
+			/*printStats=*/false,
 			/*showUnproved=*/false,
+			/*sliceHornClauses=*/false,
+			/*solverMemoryLimit=*/{},
+			/*solverProcesses=*/{},
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
-			/*timeout=*/1
+			/*timeBudget=*/{},
+			/*timeout=*/1,
+			/*raceSolvers=*/false
 		});
 	}
 	compiler.setSources(_input);
@@ -18,6 +18,10 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/Parallel.h>
+
+#include <libsolidity/ast/TypeProvider.h>
+#include <libyul/YulString.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -30,6 +34,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <queue>
 #include <regex>
 #include <utility>
@@ -113,7 +118,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and prints its name and result to @a _stream.
+	Result process(ostream& _stream = cout);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -122,6 +128,17 @@ public:
 		fs::path const& _path,
 		solidity::test::Batcher& _batcher
 	);
+
+	/// Runs the test cases in @a _path on @a _options.jobs threads without interaction.
+	/// Failing test cases are updated if @a _options.acceptUpdates is set.
+	/// The output is printed in the order in which processPath() runs the test cases.
+	static TestStats processPathInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path,
+		solidity::test::Batcher& _batcher
+	);
 private:
 	enum class Request
 	{
@@ -146,7 +163,7 @@ private:
 
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 
@@ -154,7 +171,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -171,22 +188,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -195,19 +212,19 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test: " << boost::current_exception_diagnostic_information() << endl;
 		return Result::Exception;
 	}
@@ -352,6 +369,87 @@ TestStats TestTool::processPath(
 
 }
 
+TestStats TestTool::processPathInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	solidity::test::Batcher& _batcher
+)
+{
+	// Collect the test cases in the order in which processPath() visits them.
+	vector<fs::path> testPaths;
+	int skippedCount = 0;
+	std::queue<fs::path> paths;
+	paths.push(_path);
+	while (!paths.empty())
+	{
+		fs::path currentPath = paths.front();
+		paths.pop();
+		fs::path fullpath = _basepath / currentPath;
+		if (fs::is_directory(fullpath))
+		{
+			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
+				fs::directory_iterator(fullpath),
+				fs::directory_iterator()
+			))
+				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
+					paths.push(currentPath / entry.path().filename());
+		}
+		else if (_batcher.checkAndAdvance())
+			testPaths.emplace_back(move(currentPath));
+		else
+			++skippedCount;
+	}
+
+	vector<Result> results(testPaths.size(), Result::Skipped);
+	vector<optional<string>> outputs(testPaths.size());
+	size_t nextOutput = 0;
+	mutex outputMutex;
+	util::parallelForEach(testPaths.size(), _options.jobs, [&](size_t _index) {
+		ostringstream output;
+		{
+			// Every test case gets its own types and Yul strings, which are not thread-safe
+			// to share and are reset by some of the test cases.
+			TypeProvider typeProvider;
+			TypeProvider::Scope typeProviderScope(typeProvider);
+			yul::YulStringRepository yulStrings;
+			yul::YulStringRepository::Scope yulStringScope(yulStrings);
+
+			TestTool testTool(
+				_testCaseCreator,
+				_options,
+				_basepath / testPaths[_index],
+				testPaths[_index].generic_path().string()
+			);
+			results[_index] = testTool.process(output);
+			if (results[_index] == Result::Failure && _options.acceptUpdates)
+			{
+				testTool.updateTestCase();
+				output << "Re-running test case..." << endl;
+				results[_index] = testTool.process(output);
+			}
+		}
+
+		lock_guard<mutex> lock(outputMutex);
+		outputs[_index] = output.str();
+		for (; nextOutput < outputs.size() && outputs[nextOutput].has_value(); ++nextOutput)
+		{
+			cout << *outputs[nextOutput];
+			outputs[nextOutput].reset();
+		}
+		cout.flush();
+	});
+
+	int successCount = 0;
+	for (Result result: results)
+		if (result == Result::Success)
+			++successCount;
+		else if (result == Result::Skipped)
+			++skippedCount;
+	return {successCount, static_cast<int>(testPaths.size()), skippedCount};
+}
+
 namespace
 {
 
@@ -393,7 +491,7 @@ std::optional<TestStats> runTestSuite(
 		return std::nullopt;
 	}
 
-	TestStats stats = TestTool::processPath(
+	TestStats stats = (_options.jobs > 1 ? TestTool::processPathInParallel : TestTool::processPath)(
 		_testCaseCreator,
 		_options,
 		_basePath,
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/Metrics.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <chrono>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+using namespace std;
+
+namespace
+{
+
+/// The optimizer may take this long for any input, to account for its fixed costs.
+chrono::milliseconds const BaseTimeBudget{1000};
+/// Additional time the optimizer may take per unit of code size of the input. Inputs that take
+/// longer reveal optimizer steps whose running time grows superlinearly with the size of the code.
+chrono::milliseconds const TimeBudgetPerSizeUnit{20};
+/// The optimized code may be this many times larger than the input, plus the code size below.
+size_t const MaxGrowthFactor = 10;
+size_t const GrowthAllowance = 200;
+
+/// @returns the code size of the code of @a _object and all its sub-objects.
+size_t codeSize(Object const& _object)
+{
+	size_t size = _object.code ? CodeSize::codeSizeIncludingFunctions(*_object.code) : 0;
+	for (auto const& subObject: _object.subObjects)
+		if (auto const* object = dynamic_cast<Object const*>(subObject.get()))
+			size += codeSize(*object);
+	return size;
+}
+
+}
+
+// Prototype as we can't use the FuzzerInterface.h header.
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size);
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
+{
+	if (_size > 2000)
+		return 0;
+
+	YulStringRepository::reset();
+
+	string input(reinterpret_cast<char const*>(_data), _size);
+	AssemblyStack stack(
+		langutil::EVMVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+
+	if (!stack.parseAndAnalyze("source", input))
+		return 0;
+
+	size_t inputSize = codeSize(*stack.parserResult());
+	auto start = chrono::steady_clock::now();
+	stack.optimize();
+	auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+	size_t outputSize = codeSize(*stack.parserResult());
+
+	yulAssert(
+		duration <= BaseTimeBudget + TimeBudgetPerSizeUnit * inputSize,
+		"Optimizing code of size " + to_string(inputSize) + " took " + to_string(duration.count()) + " ms."
+	);
+	yulAssert(
+		outputSize <= MaxGrowthFactor * inputSize + GrowthAllowance,
+		"Optimizing code of size " + to_string(inputSize) + " resulted in code of size " + to_string(outputSize) + "."
+	);
+	return 0;
+}
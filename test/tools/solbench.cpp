@@ -0,0 +1,379 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the compilation speed and memory usage of the compiler.
+ */
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define SOLBENCH_ISOLATE_RUNS
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Benchmark
+{
+	string name;
+	/// Contents of the sources by source unit name.
+	map<string, string> sources;
+};
+
+/// @returns a contract with @a _functions functions that contain loops, arithmetic,
+/// storage accesses and internal calls, to stress the analysis, the code generators
+/// and the optimizers.
+string stressContract(size_t _functions)
+{
+	string code =
+		"// SPDX-License-Identifier: GPL-3.0\n"
+		"pragma solidity >=0.0;\n"
+		"contract Stress {\n"
+		"\tstruct S { uint a; uint b; }\n"
+		"\tmapping(uint => uint) m;\n"
+		"\tS[] s;\n"
+		"\tevent E(uint indexed, uint);\n";
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string index = to_string(i);
+		code +=
+			"\tfunction f" + index + "(uint x, uint[] calldata a) public returns (uint r) {\n"
+			"\t\tfor (uint i = 0; i < a.length; i++)\n"
+			"\t\t\tr += a[i] * (x + " + index + ") / (i + 1) + m[i];\n"
+			"\t\tm[x] = r ^ " + index + ";\n"
+			"\t\ts.push(S(r, x));\n"
+			"\t\temit E(x, r);\n";
+		if (i > 0)
+			code += "\t\tif (r > " + index + ") r = f" + to_string(i - 1) + "(r % 7, a);\n";
+		code += "\t}\n";
+	}
+	return code + "}\n";
+}
+
+Benchmark loadBenchmark(fs::path const& _path)
+{
+	Benchmark benchmark{_path.filename().string(), {}};
+	if (fs::is_directory(_path))
+	{
+		for (fs::recursive_directory_iterator it(_path), end; it != end; ++it)
+			if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+				benchmark.sources[fs::relative(it->path(), _path).generic_string()] = readFileAsString(it->path());
+	}
+	else
+		benchmark.sources[_path.filename().string()] = readFileAsString(_path);
+	if (benchmark.sources.empty())
+		BOOST_THROW_EXCEPTION(FileNotFound() << errinfo_comment(_path.string() + " does not contain Solidity sources."));
+	return benchmark;
+}
+
+Json::Value standardJsonInput(Benchmark const& _benchmark, string const& _mode, bool _optimize)
+{
+	Json::Value input{Json::objectValue};
+	input["language"] = "Solidity";
+	for (auto const& [name, content]: _benchmark.sources)
+		input["sources"][name]["content"] = content;
+
+	Json::Value& settings = input["settings"];
+	settings["optimizer"]["enabled"] = _optimize;
+	settings["profile"] = true;
+	if (_mode == "smt")
+	{
+		settings["modelChecker"]["engine"] = "all";
+		settings["outputSelection"]["*"]["*"].append("abi");
+	}
+	else
+	{
+		settings["viaIR"] = (_mode == "via-ir");
+		settings["outputSelection"]["*"]["*"].append("evm.bytecode.object");
+		settings["outputSelection"]["*"]["*"].append("evm.deployedBytecode.object");
+	}
+	return input;
+}
+
+/// Compiles the benchmark once and @returns the wall time and the phases reported by the
+/// compiler together with the number of errors.
+Json::Value runOnce(Benchmark const& _benchmark, string const& _mode, bool _optimize)
+{
+	Json::Value input = standardJsonInput(_benchmark, _mode, _optimize);
+	StandardCompiler compiler;
+	auto start = chrono::steady_clock::now();
+	Json::Value output = compiler.compile(input);
+	auto end = chrono::steady_clock::now();
+
+	Json::Value result{Json::objectValue};
+	result["wallTime"] = chrono::duration<double, milli>(end - start).count();
+	result["phases"] = output["profile"]["phases"];
+	unsigned errors = 0;
+	for (Json::Value const& error: output["errors"])
+		if (error["severity"].asString() == "error")
+			++errors;
+	result["errors"] = errors;
+	return result;
+}
+
+/// Runs runOnce() in a process of its own, if possible, so that runs do not share caches
+/// and the peak memory usage of the run can be determined. It is reported in kibibytes.
+Json::Value run(Benchmark const& _benchmark, string const& _mode, bool _optimize)
+{
+#ifdef SOLBENCH_ISOLATE_RUNS
+	cout.flush();
+	cerr.flush();
+	int fds[2];
+	if (pipe(fds) != 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Could not create pipe."));
+	pid_t pid = fork();
+	if (pid < 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Could not fork."));
+	if (pid == 0)
+	{
+		close(fds[0]);
+		string result = jsonCompactPrint(runOnce(_benchmark, _mode, _optimize));
+		for (size_t written = 0; written < result.size();)
+		{
+			ssize_t count = write(fds[1], result.data() + written, result.size() - written);
+			if (count <= 0)
+				_exit(1);
+			written += static_cast<size_t>(count);
+		}
+		_exit(0);
+	}
+	close(fds[1]);
+	string serialized;
+	char buffer[4096];
+	for (ssize_t count; (count = read(fds[0], buffer, sizeof(buffer))) > 0;)
+		serialized.append(buffer, static_cast<size_t>(count));
+	close(fds[0]);
+	int status = 0;
+	struct rusage usage{};
+	wait4(pid, &status, 0, &usage);
+
+	Json::Value result;
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !jsonParseStrict(serialized, result))
+		BOOST_THROW_EXCEPTION(runtime_error("Compiling " + _benchmark.name + " in mode " + _mode + " failed."));
+#if defined(__APPLE__)
+	result["maxRSS"] = Json::Int64(usage.ru_maxrss / 1024);
+#else
+	result["maxRSS"] = Json::Int64(usage.ru_maxrss);
+#endif
+	return result;
+#else
+	return runOnce(_benchmark, _mode, _optimize);
+#endif
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		string modes;
+		size_t repetitions = 0;
+		size_t stressFunctions = 0;
+		bool noOptimize = false;
+		po::options_description options(
+			R"(solbench, benchmark of the compilation speed and memory usage of the compiler.
+	Usage: solbench [Options] <path>...
+	Compiles every <path>, which is a Solidity file or a directory whose Solidity files
+	are compiled together, in each of the given modes and prints the fastest wall time,
+	the time spent in the phases of the compilation in that run and the peak memory usage
+	in kibibytes as JSON.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-paths",
+				po::value<vector<string>>()->multitoken(),
+				"input files or directories"
+			)
+			(
+				"modes",
+				po::value<string>(&modes)->default_value("legacy,via-ir"),
+				"comma-separated list of compilation modes: legacy, via-ir and smt"
+			)
+			(
+				"repetitions",
+				po::value<size_t>(&repetitions)->default_value(3),
+				"number of times every benchmark is compiled"
+			)
+			(
+				"stress",
+				po::value<size_t>(&stressFunctions)->default_value(0),
+				"also compile a generated contract with this many functions"
+			)
+			(
+				"no-optimize",
+				po::bool_switch(&noOptimize)->default_value(false),
+				"compile without the optimizer"
+			)
+			(
+				"baseline",
+				po::value<string>(),
+				"output of an earlier run to compare with"
+			)
+			(
+				"max-regression",
+				po::value<double>(),
+				"exit with status 2 if a wall time exceeds the one of the baseline by more than this many percent"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-paths", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || (!arguments.count("input-paths") && stressFunctions == 0) || repetitions == 0)
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		vector<string> modeList;
+		boost::split(modeList, modes, boost::is_any_of(","));
+		for (string const& mode: modeList)
+			if (mode != "legacy" && mode != "via-ir" && mode != "smt")
+			{
+				cerr << "Invalid mode: " << mode << endl;
+				return 1;
+			}
+
+		vector<Benchmark> benchmarks;
+		if (arguments.count("input-paths"))
+			for (string const& path: arguments["input-paths"].as<vector<string>>())
+				benchmarks.emplace_back(loadBenchmark(path));
+		if (stressFunctions > 0)
+			benchmarks.emplace_back(Benchmark{"stress" + to_string(stressFunctions), {{"stress.sol", stressContract(stressFunctions)}}});
+
+		map<string, Json::Value> baseline;
+		if (arguments.count("baseline"))
+		{
+			Json::Value baselineOutput;
+			if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baselineOutput))
+			{
+				cerr << "Invalid baseline." << endl;
+				return 1;
+			}
+			for (Json::Value const& entry: baselineOutput["benchmarks"])
+				baseline[entry["name"].asString() + "/" + entry["mode"].asString()] = entry;
+		}
+		optional<double> maxRegression;
+		if (arguments.count("max-regression"))
+			maxRegression = arguments["max-regression"].as<double>();
+
+		bool regressed = false;
+		Json::Value output{Json::objectValue};
+		output["benchmarks"] = Json::arrayValue;
+		for (Benchmark const& benchmark: benchmarks)
+			for (string const& mode: modeList)
+			{
+				Json::Value entry{Json::objectValue};
+				entry["name"] = benchmark.name;
+				entry["mode"] = mode;
+				entry["wallTimes"] = Json::arrayValue;
+				Json::Value fastest;
+				for (size_t i = 0; i < repetitions; ++i)
+				{
+					Json::Value result = run(benchmark, mode, !noOptimize);
+					entry["wallTimes"].append(result["wallTime"]);
+					if (result.isMember("maxRSS"))
+						entry["maxRSS"] = max(entry["maxRSS"].asInt64(), result["maxRSS"].asInt64());
+					if (fastest.isNull() || result["wallTime"].asDouble() < fastest["wallTime"].asDouble())
+						fastest = move(result);
+				}
+				entry["wallTime"] = fastest["wallTime"];
+				entry["phases"] = fastest["phases"];
+				entry["errors"] = fastest["errors"];
+
+				if (auto previous = baseline.find(benchmark.name + "/" + mode); previous != baseline.end())
+				{
+					double previousTime = previous->second["wallTime"].asDouble();
+					entry["baseline"]["wallTime"] = previousTime;
+					if (previous->second.isMember("maxRSS"))
+						entry["baseline"]["maxRSS"] = previous->second["maxRSS"];
+					if (previousTime > 0)
+					{
+						double change = (entry["wallTime"].asDouble() / previousTime - 1.0) * 100.0;
+						entry["wallTimeChange"] = change;
+						if (maxRegression && change > *maxRegression)
+							regressed = true;
+					}
+				}
+				cerr << benchmark.name << " (" << mode << "): " << entry["wallTime"].asDouble() << " ms" << endl;
+				output["benchmarks"].append(move(entry));
+			}
+
+		cout << jsonPrettyPrint(output) << endl;
+		return regressed ? 2 : 0;
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (FileNotFound const& _exception)
+	{
+		cerr << "File not found: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (NotAFile const& _exception)
+	{
+		cerr << "Not a file: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+}
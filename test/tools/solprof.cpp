@@ -0,0 +1,405 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Gas profiler that attributes the steps of an execution trace to source lines
+ * and Yul utility functions using the source maps of the compiler.
+ */
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// One entry of a decompressed source map.
+struct SourceMapEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jump = '-';
+};
+
+/// A source file, either given as input or generated by the compiler.
+struct Source
+{
+	string name;
+	string content;
+	/// Offsets of the first characters of the lines.
+	vector<size_t> lineStarts;
+	/// Start, end and name of the Yul functions of a generated source.
+	vector<tuple<int, int, string>> functions;
+};
+
+struct Step
+{
+	size_t pc = 0;
+	unsigned depth = 0;
+	/// Gas left before the step.
+	u256 gas;
+	/// Gas cost of the step as reported in the trace, if any.
+	optional<u256> gasCost;
+};
+
+vector<SourceMapEntry> decompressSourceMap(string const& _sourceMap)
+{
+	vector<SourceMapEntry> entries;
+	SourceMapEntry current;
+	vector<string> items;
+	boost::split(items, _sourceMap, boost::is_any_of(";"));
+	for (string const& item: items)
+	{
+		vector<string> fields;
+		boost::split(fields, item, boost::is_any_of(":"));
+		if (fields.size() > 0 && !fields[0].empty())
+			current.start = stoi(fields[0]);
+		if (fields.size() > 1 && !fields[1].empty())
+			current.length = stoi(fields[1]);
+		if (fields.size() > 2 && !fields[2].empty())
+			current.sourceIndex = stoi(fields[2]);
+		if (fields.size() > 3 && !fields[3].empty())
+			current.jump = fields[3][0];
+		entries.push_back(current);
+	}
+	return entries;
+}
+
+/// @returns for every byte of @a _bytecode the index of the instruction starting there, or
+/// nullopt for push data.
+vector<optional<size_t>> instructionIndices(bytes const& _bytecode)
+{
+	vector<optional<size_t>> indices(_bytecode.size());
+	size_t index = 0;
+	for (size_t pc = 0; pc < _bytecode.size(); ++index)
+	{
+		indices[pc] = index;
+		uint8_t opcode = _bytecode[pc];
+		// PUSH1 to PUSH32
+		size_t immediates = (opcode >= 0x60 && opcode <= 0x7f) ? opcode - 0x5f : 0;
+		pc += 1 + immediates;
+	}
+	return indices;
+}
+
+Source makeSource(string _name, string _content)
+{
+	Source source{move(_name), move(_content), {0}, {}};
+	for (size_t i = 0; i < source.content.size(); ++i)
+		if (source.content[i] == '\n')
+			source.lineStarts.push_back(i + 1);
+	return source;
+}
+
+/// Adds the Yul functions defined in the Yul AST @a _node to @a _source.
+void collectFunctions(Json::Value const& _node, Source& _source)
+{
+	if (_node.isObject())
+	{
+		if (_node["nodeType"].asString() == "YulFunctionDefinition")
+		{
+			vector<string> location;
+			boost::split(location, _node["src"].asString(), boost::is_any_of(":"));
+			if (location.size() >= 2)
+				_source.functions.emplace_back(stoi(location[0]), stoi(location[0]) + stoi(location[1]), _node["name"].asString());
+		}
+		for (auto const& member: _node.getMemberNames())
+			collectFunctions(_node[member], _source);
+	}
+	else if (_node.isArray())
+		for (Json::Value const& element: _node)
+			collectFunctions(element, _source);
+}
+
+u256 parseGas(Json::Value const& _value)
+{
+	if (_value.isString())
+		return u256(_value.asString());
+	return u256(_value.asUInt64());
+}
+
+/// @returns the name of the location of @a _entry: The source line for input sources and the
+/// innermost Yul function for generated sources.
+string locationName(SourceMapEntry const& _entry, map<int, Source> const& _sources)
+{
+	auto source = _sources.find(_entry.sourceIndex);
+	if (source == _sources.end() || _entry.start < 0)
+		return "<unknown>";
+	if (!source->second.functions.empty())
+	{
+		optional<tuple<int, int, string>> innermost;
+		for (auto const& function: source->second.functions)
+			if (get<0>(function) <= _entry.start && _entry.start < get<1>(function))
+				if (!innermost || get<1>(function) - get<0>(function) < get<1>(*innermost) - get<0>(*innermost))
+					innermost = function;
+		if (innermost)
+			return source->second.name + ":" + get<2>(*innermost);
+	}
+	auto const& lineStarts = source->second.lineStarts;
+	size_t line = static_cast<size_t>(upper_bound(lineStarts.begin(), lineStarts.end(), static_cast<size_t>(_entry.start)) - lineStarts.begin());
+	return source->second.name + ":" + to_string(line);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		string inputFile;
+		string contract;
+		string traceFile;
+		string format;
+		bool creation = false;
+		optional<unsigned> depth;
+		po::options_description options(
+			R"(solprof, gas profiler for execution traces of Solidity contracts.
+	Usage: solprof [Options] --standard-json <input.json> --contract <source>:<name> --trace <trace>
+	Compiles the Standard JSON input, which has to contain the content of all sources, and
+	attributes the gas used by the steps of the trace to the source lines and, for code generated
+	by the compiler, the Yul utility functions. The trace has one JSON object per line and step with
+	at least "pc", "gas" and "depth", as defined by EIP-3155 and produced e.g. by the trace option of
+	evmone. Internal function calls are reconstructed from the jump types in the source map.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			("standard-json", po::value<string>(&inputFile), "Standard JSON input to compile")
+			("contract", po::value<string>(&contract), "contract the trace executes, as <source>:<name>")
+			("trace", po::value<string>(&traceFile), "file with the execution trace")
+			("creation", po::bool_switch(&creation)->default_value(false), "the trace executes the creation code")
+			("depth", po::value<unsigned>(), "call depth of the steps to profile, by default the depth of the first step")
+			(
+				"format",
+				po::value<string>(&format)->default_value("folded"),
+				"output format: folded for folded stacks as used by flamegraph.pl, or lines for gas and steps by location as JSON"
+			)
+			("help,h", "Show this help screen.");
+
+		po::variables_map arguments;
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || inputFile.empty() || contract.empty() || traceFile.empty())
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+		if (format != "folded" && format != "lines")
+		{
+			cerr << "Invalid format: " << format << endl;
+			return 1;
+		}
+		if (arguments.count("depth"))
+			depth = arguments["depth"].as<unsigned>();
+		size_t separator = contract.rfind(':');
+		if (separator == string::npos)
+		{
+			cerr << "The contract has to be given as <source>:<name>." << endl;
+			return 1;
+		}
+		string sourceName = contract.substr(0, separator);
+		string contractName = contract.substr(separator + 1);
+
+		Json::Value input;
+		if (!jsonParseStrict(readFileAsString(inputFile), input))
+		{
+			cerr << "Invalid Standard JSON input." << endl;
+			return 1;
+		}
+		string const bytecodeKind = creation ? "bytecode" : "deployedBytecode";
+		Json::Value& selection = input["settings"]["outputSelection"];
+		selection = Json::objectValue;
+		selection[sourceName][contractName].append("evm." + bytecodeKind + ".object");
+		selection[sourceName][contractName].append("evm." + bytecodeKind + ".sourceMap");
+		selection[sourceName][contractName].append("evm." + bytecodeKind + ".generatedSources");
+		Json::Value output = StandardCompiler{}.compile(input);
+		bool failed = false;
+		for (Json::Value const& error: output["errors"])
+			if (error["severity"].asString() == "error")
+			{
+				cerr << error["formattedMessage"].asString() << endl;
+				failed = true;
+			}
+		Json::Value const& bytecode = output["contracts"][sourceName][contractName]["evm"][bytecodeKind];
+		if (failed || !bytecode.isObject())
+		{
+			cerr << "Could not compile " << contract << "." << endl;
+			return 1;
+		}
+
+		map<int, Source> sources;
+		for (auto const& name: output["sources"].getMemberNames())
+			sources[output["sources"][name]["id"].asInt()] = makeSource(name, input["sources"][name]["content"].asString());
+		for (Json::Value const& generated: bytecode["generatedSources"])
+		{
+			Source source = makeSource(generated["name"].asString(), generated["contents"].asString());
+			collectFunctions(generated["ast"], source);
+			sources[generated["id"].asInt()] = move(source);
+		}
+
+		// Placeholders of unlinked libraries do not affect the instruction boundaries.
+		string object = bytecode["object"].asString();
+		for (char& character: object)
+			if (!isxdigit(static_cast<unsigned char>(character)))
+				character = '0';
+		vector<optional<size_t>> indices = instructionIndices(fromHex(object));
+		vector<SourceMapEntry> sourceMap = decompressSourceMap(bytecode["sourceMap"].asString());
+
+		vector<Step> steps;
+		ifstream trace(traceFile);
+		if (!trace)
+		{
+			cerr << "Could not open " << traceFile << "." << endl;
+			return 1;
+		}
+		for (string line; getline(trace, line);)
+		{
+			Json::Value step;
+			if (line.empty() || !jsonParseStrict(line, step) || !step.isObject() || !step.isMember("pc"))
+				continue;
+			steps.push_back({
+				step["pc"].asUInt64(),
+				step["depth"].asUInt(),
+				parseGas(step["gas"]),
+				step.isMember("gasCost") ? optional<u256>(parseGas(step["gasCost"])) : nullopt
+			});
+		}
+		if (steps.empty())
+		{
+			cerr << "The trace does not contain any steps." << endl;
+			return 1;
+		}
+		if (!depth)
+			depth = steps.front().depth;
+
+		// Gas and step counts by stack of locations and by location.
+		map<string, u256> stacks;
+		map<string, pair<u256, size_t>> locations;
+		vector<string> callStack{contractName};
+		bool enteringFunction = false;
+		u256 totalGas;
+		for (size_t i = 0; i < steps.size(); ++i)
+		{
+			Step const& step = steps[i];
+			if (step.depth != *depth)
+				continue;
+
+			// The cost of a step is the difference to the gas left at the next step of the same
+			// frame, which includes the gas used by the calls the step makes.
+			optional<u256> cost;
+			for (size_t next = i + 1; next < steps.size() && steps[next].depth >= *depth; ++next)
+				if (steps[next].depth == *depth)
+				{
+					if (steps[next].gas <= step.gas)
+						cost = step.gas - steps[next].gas;
+					break;
+				}
+			if (!cost)
+				cost = step.gasCost.value_or(0);
+
+			SourceMapEntry entry;
+			if (step.pc < indices.size() && indices[step.pc] && *indices[step.pc] < sourceMap.size())
+				entry = sourceMap[*indices[step.pc]];
+			string location = locationName(entry, sources);
+
+			if (enteringFunction)
+			{
+				callStack.push_back(location);
+				enteringFunction = false;
+			}
+
+			stacks[joinHumanReadable(callStack, ";") + ";" + location] += *cost;
+			locations[location].first += *cost;
+			locations[location].second++;
+			totalGas += *cost;
+
+			if (entry.jump == 'i')
+				enteringFunction = true;
+			else if (entry.jump == 'o' && callStack.size() > 1)
+				callStack.pop_back();
+		}
+
+		if (format == "folded")
+			for (auto const& [stack, gas]: stacks)
+				cout << stack << " " << gas << endl;
+		else
+		{
+			vector<pair<string, pair<u256, size_t>>> sorted(locations.begin(), locations.end());
+			stable_sort(sorted.begin(), sorted.end(), [](auto const& _a, auto const& _b) {
+				return _a.second.first > _b.second.first;
+			});
+			Json::Value result{Json::objectValue};
+			result["totalGas"] = totalGas.str();
+			result["locations"] = Json::arrayValue;
+			for (auto const& [location, usage]: sorted)
+			{
+				Json::Value entry{Json::objectValue};
+				entry["location"] = location;
+				entry["gas"] = usage.first.str();
+				entry["steps"] = Json::UInt64(usage.second);
+				result["locations"].append(move(entry));
+			}
+			cout << jsonPrettyPrint(result) << endl;
+		}
+		return 0;
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (FileNotFound const& _exception)
+	{
+		cerr << "File not found: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (NotAFile const& _exception)
+	{
+		cerr << "Not a file: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+}
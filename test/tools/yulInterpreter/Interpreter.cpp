@@ -48,6 +48,44 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t& Memory::operator[](u256 const& _offset)
+{
+	return m_pages[_offset / PageSize][size_t(_offset % PageSize)];
+}
+
+uint8_t Memory::at(u256 const& _offset) const
+{
+	auto page = m_pages.find(_offset / PageSize);
+	return page == m_pages.end() ? 0 : page->second[size_t(_offset % PageSize)];
+}
+
+bytes Memory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, uint8_t(0));
+	u256 pageIndex = _offset / PageSize;
+	size_t position = size_t(_offset % PageSize);
+	for (size_t i = 0; i < _size; ++pageIndex, position = 0)
+	{
+		size_t chunk = min(PageSize - position, _size - i);
+		if (auto page = m_pages.find(pageIndex); page != m_pages.end())
+			copy_n(page->second.begin() + static_cast<ptrdiff_t>(position), chunk, data.begin() + static_cast<ptrdiff_t>(i));
+		i += chunk;
+	}
+	return data;
+}
+
+void Memory::write(u256 _offset, bytes const& _data)
+{
+	u256 pageIndex = _offset / PageSize;
+	size_t position = size_t(_offset % PageSize);
+	for (size_t i = 0; i < _data.size(); ++pageIndex, position = 0)
+	{
+		size_t chunk = min(PageSize - position, _data.size() - i);
+		copy_n(_data.begin() + static_cast<ptrdiff_t>(i), chunk, m_pages[pageIndex].begin() + static_cast<ptrdiff_t>(position));
+		i += chunk;
+	}
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
 	for (auto const& slot: storage)
@@ -63,12 +101,13 @@ void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+		for (auto const& [pageIndex, page]: memory.pages())
+			for (size_t word = 0; word < Memory::PageSize; word += 0x20)
+			{
+				h256 value(bytesConstRef(page.data() + word, 0x20));
+				if (value != h256{})
+					_out << "  " << std::uppercase << std::hex << std::setw(4) << pageIndex * Memory::PageSize + word << ": " << value.hex() << endl;
+			}
 	}
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
@@ -97,9 +136,9 @@ void Interpreter::operator()(Assignment const& _assignment)
 	solAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
 	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
+		auto variable = m_variables.find(_assignment.variableNames.at(i).name);
+		solAssert(variable != m_variables.end(), "");
+		variable->second = values.at(i);
 	}
 }
 
@@ -262,54 +301,55 @@ void Interpreter::incrementStep()
 void ExpressionEvaluator::operator()(Literal const& _literal)
 {
 	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
 	setValue(valueOfLiteral(_literal));
 }
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	solAssert(m_variables.count(_identifier.name), "");
+	auto variable = m_variables.find(_identifier.name);
+	solAssert(variable != m_variables.end(), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	setValue(variable->second);
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
-
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	// The builtin is only looked up once. The builtins of EVM dialects are always BuiltinFunctionForEVM.
+	BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name);
+	evaluateArgs(
+		_funCall.arguments,
+		builtin && !builtin->literalArguments.empty() ? &builtin->literalArguments : nullptr
+	);
+
+	if (builtin)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
+		if (dynamic_cast<EVMDialect const*>(&m_dialect))
 		{
 			EVMInstructionInterpreter interpreter(m_state, m_disableMemoryTrace);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
+			setValue(interpreter.evalBuiltin(static_cast<BuiltinFunctionForEVM const&>(*builtin), _funCall.arguments, values()));
 			return;
 		}
-	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
+		if (dynamic_cast<WasmDialect const*>(&m_dialect))
 		{
 			EwasmBuiltinInterpreter interpreter(m_state);
 			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
 			return;
 		}
+	}
 
+	FunctionDefinition const* fun = nullptr;
 	Scope* scope = &m_scope;
 	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
+		if (auto name = scope->names.find(_funCall.functionName.name); name != scope->names.end())
+		{
+			fun = name->second;
 			break;
+		}
 	yulAssert(scope, "");
 
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
 	yulAssert(fun, "Function not found.");
 	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
+	unordered_map<YulString, u256> variables;
 	for (size_t i = 0; i < fun->parameters.size(); ++i)
 		variables[fun->parameters.at(i).name] = m_values.at(i);
 	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
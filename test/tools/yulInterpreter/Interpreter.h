@@ -24,12 +24,16 @@
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
+#include <libevmasm/Instruction.h>
+
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/CommonData.h>
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,12 +71,39 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressable memory of the interpreter. Consecutive bytes are stored together in
+ * pages, so that reads and writes of whole words or ranges only need one lookup per page.
+ * Bytes that have never been written are zero.
+ */
+class Memory
+{
+public:
+	static constexpr size_t PageSize = 0x100;
+	using Page = std::array<uint8_t, PageSize>;
+
+	/// @returns a reference to the byte at @a _offset, allocating its page if needed.
+	uint8_t& operator[](u256 const& _offset);
+	/// @returns the byte at @a _offset without allocating its page.
+	uint8_t at(u256 const& _offset) const;
+	/// @returns @a _size bytes starting at @a _offset. Offsets wrap around at 2**256.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _data starting at @a _offset. Offsets wrap around at 2**256.
+	void write(u256 _offset, bytes const& _data);
+
+	/// @returns the allocated pages, indexed by the offset of their first byte divided by the page size.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	std::map<u256, Page> m_pages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	Memory memory;
+	/// This is different than the size of the written memory because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
@@ -99,6 +130,9 @@ struct InterpreterState
 	size_t maxSteps = 0;
 	size_t numSteps = 0;
 	size_t maxExprNesting = 0;
+	/// Number of times each EVM instruction was executed. Can be used to estimate the gas cost
+	/// of the execution.
+	std::map<evmasm::Instruction, size_t> instructionCounts;
 	ControlFlowState controlFlowState = ControlFlowState::Default;
 
 	/// Prints execution trace and non-zero storage to @param _out.
@@ -116,7 +150,7 @@ struct InterpreterState
 struct Scope
 {
 	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
+	std::unordered_map<YulString, FunctionDefinition const*> names;
 	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
 	Scope* parent = nullptr;
 };
@@ -143,7 +177,7 @@ public:
 		Dialect const& _dialect,
 		Scope& _scope,
 		bool _disableMemoryTracing,
-		std::map<YulString, u256> _variables = {}
+		std::unordered_map<YulString, u256> _variables = {}
 	):
 		m_dialect(_dialect),
 		m_state(_state),
@@ -185,7 +219,7 @@ private:
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
 	/// Values of variables.
-	std::map<YulString, u256> m_variables;
+	std::unordered_map<YulString, u256> m_variables;
 	Scope* m_scope;
 	bool m_disableMemoryTrace;
 };
@@ -200,7 +234,7 @@ public:
 		InterpreterState& _state,
 		Dialect const& _dialect,
 		Scope& _scope,
-		std::map<YulString, u256> const& _variables,
+		std::unordered_map<YulString, u256> const& _variables,
 		bool _disableMemoryTrace
 	):
 		m_state(_state),
@@ -237,7 +271,7 @@ private:
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
 	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
+	std::unordered_map<YulString, u256> const& m_variables;
 	Scope& m_scope;
 	/// Current value of the expression
 	std::vector<u256> m_values;
@@ -0,0 +1,454 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the individual steps of the Yul optimizer.
+ */
+
+#include <test/libyul/YulOptimizerTestCommon.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/wasm/WasmDialect.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Number of allocations done through the global operator new since the start of the program.
+atomic<size_t> allocationCount{0};
+
+}
+
+// The global allocation functions are replaced to count the allocations done by a step.
+void* operator new(size_t _size)
+{
+	++allocationCount;
+	if (void* memory = malloc(_size ? _size : 1))
+		return memory;
+	throw bad_alloc();
+}
+
+void operator delete(void* _memory) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	free(_memory);
+}
+
+namespace
+{
+
+struct Benchmark
+{
+	string name;
+	string source;
+	/// The language the source is parsed in, which depends on the dialect of the test.
+	AssemblyStack::Language language = AssemblyStack::Language::StrictAssembly;
+	/// Step the benchmark is run with if no steps are selected explicitly.
+	string defaultStep;
+};
+
+/// Steps that are left out if all steps are selected: The word size transform needs the Ewasm
+/// dialect and the reasoning based simplifier needs an SMT solver.
+set<string> const stepsNotRunByDefault{"wordSizeTransform", "reasoningBasedSimplifier"};
+
+/// @returns the dialect the assembly stack uses for @a _language.
+Dialect const& languageDialect(AssemblyStack::Language _language, EVMVersion _evmVersion)
+{
+	switch (_language)
+	{
+	case AssemblyStack::Language::Yul:
+		return EVMDialectTyped::instance(_evmVersion);
+	case AssemblyStack::Language::Ewasm:
+		return WasmDialect::instance();
+	default:
+		return EVMDialect::strictAssemblyForEVMObjects(_evmVersion);
+	}
+}
+
+/// Counts the statements and expressions in a block.
+class NodeCounter: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void visit(Statement const& _statement) override
+	{
+		++m_count;
+		ASTWalker::visit(_statement);
+	}
+	void visit(Expression const& _expression) override
+	{
+		++m_count;
+		ASTWalker::visit(_expression);
+	}
+	size_t count() const { return m_count; }
+
+private:
+	size_t m_count = 0;
+};
+
+/// @returns Yul code with @a _functions functions that contain loops, arithmetic, memory and
+/// storage accesses and calls of each other, as input for all steps of the optimizer.
+string stressCode(size_t _functions)
+{
+	string code = "{\n\tsstore(0, f" + to_string(_functions - 1) + "(calldataload(0), calldataload(32)))\n";
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string index = to_string(i);
+		code +=
+			"\tfunction f" + index + "(x, y) -> r {\n"
+			"\t\tfor { let i := 0 } lt(i, y) { i := add(i, 1) } {\n"
+			"\t\t\tlet t := div(mul(x, add(i, " + index + ")), add(i, 1))\n"
+			"\t\t\tr := add(r, add(t, sload(i)))\n"
+			"\t\t\tmstore(mul(i, 0x20), r)\n"
+			"\t\t}\n"
+			"\t\tif gt(r, " + index + ") { sstore(x, xor(r, mload(0))) }\n";
+		if (i > 0)
+			code += "\t\tr := add(r, f" + to_string(i - 1) + "(mod(r, 7), y))\n";
+		code += "\t}\n";
+	}
+	return code + "}\n";
+}
+
+/// @returns the benchmark for the Yul file @a _path. Files in the directory of an optimizer
+/// step, as in test/libyul/yulOptimizerTests, are run with that step by default.
+optional<Benchmark> loadBenchmark(fs::path const& _path, string const& _name, set<string> const& _steps)
+{
+	Benchmark benchmark{_name, readFileAsString(_path), AssemblyStack::Language::StrictAssembly, "fullSuite"};
+	string step = _path.parent_path().filename().string();
+	if (_steps.count(step))
+		benchmark.defaultStep = step;
+
+	// The settings of the test are comments and the source can be parsed as is.
+	string dialect = "evm";
+	istringstream lines(benchmark.source);
+	for (string line; getline(lines, line);)
+		if (boost::starts_with(line, "// dialect:"))
+			dialect = boost::trim_copy(line.substr(string("// dialect:").size()));
+	if (dialect == "evmTyped")
+		benchmark.language = AssemblyStack::Language::Yul;
+	else if (dialect == "ewasm")
+		benchmark.language = AssemblyStack::Language::Ewasm;
+	else if (dialect != "evm")
+	{
+		cerr << "Skipping " << _name << " because of the unsupported dialect " << dialect << "." << endl;
+		return nullopt;
+	}
+	return benchmark;
+}
+
+/// Adds the benchmarks for the Yul file or the Yul files in the directory @a _path to @a _benchmarks.
+void loadBenchmarks(fs::path const& _path, set<string> const& _steps, vector<Benchmark>& _benchmarks)
+{
+	vector<pair<fs::path, string>> files;
+	if (fs::is_directory(_path))
+	{
+		for (fs::recursive_directory_iterator it(_path), end; it != end; ++it)
+			if (fs::is_regular_file(it->path()) && it->path().extension() == ".yul")
+				files.emplace_back(it->path(), fs::relative(it->path(), _path).generic_string());
+		sort(files.begin(), files.end());
+	}
+	else
+		files.emplace_back(_path, _path.filename().string());
+	for (auto const& [file, name]: files)
+		if (auto benchmark = loadBenchmark(file, name, _steps))
+			_benchmarks.emplace_back(move(*benchmark));
+}
+
+/// Runs @a _step on a freshly parsed copy of @a _benchmark and stores the number of AST nodes
+/// before the step, the time taken in nanoseconds and the number of allocations in @a _result.
+/// Parsing and analysis are not included, but the steps the test harness runs before the step,
+/// e.g. the disambiguator, are.
+void runOnce(Benchmark const& _benchmark, string const& _step, EVMVersion _evmVersion, Json::Value& _result)
+{
+	AssemblyStack stack(
+		_evmVersion,
+		_benchmark.language,
+		frontend::OptimiserSettings::none(),
+		DebugInfoSelection::None()
+	);
+	if (
+		!stack.parseAndAnalyze(_benchmark.name, _benchmark.source) ||
+		!stack.parserResult()->code ||
+		!stack.parserResult()->analysisInfo
+	)
+		BOOST_THROW_EXCEPTION(runtime_error("Could not parse " + _benchmark.name + "."));
+
+	NodeCounter counter;
+	counter(*stack.parserResult()->code);
+
+	YulOptimizerTestCommon tester(stack.parserResult(), languageDialect(_benchmark.language, _evmVersion));
+	tester.setStep(_step);
+
+	size_t allocationsBefore = allocationCount;
+	auto start = chrono::steady_clock::now();
+	if (!tester.runStep())
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid optimizer step: " + _step));
+	auto end = chrono::steady_clock::now();
+
+	_result["nodes"] = Json::UInt64(counter.count());
+	_result["time"] = Json::Int64(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+	_result["allocations"] = Json::UInt64(allocationCount - allocationsBefore);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		string steps;
+		size_t repetitions = 0;
+		size_t stressFunctions = 0;
+		po::options_description options(
+			R"(yuloptbench, benchmark of the steps of the Yul optimizer.
+	Usage: yuloptbench [Options] <path>...
+	Runs optimizer steps on every Yul file in <path>, which is a file or a directory,
+	and prints the fastest time of each step, the time per AST node and the number of
+	allocations as JSON. Files in the directory of a step, as in yulOptimizerTests,
+	are run with that step unless the steps are selected explicitly.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-paths",
+				po::value<vector<string>>()->multitoken(),
+				"input files or directories"
+			)
+			(
+				"steps",
+				po::value<string>(&steps),
+				"comma-separated list of steps to run on every input, e.g. fullSuite, or \"all\""
+			)
+			(
+				"repetitions",
+				po::value<size_t>(&repetitions)->default_value(10),
+				"number of times every step is run"
+			)
+			(
+				"stress",
+				po::value<size_t>(&stressFunctions)->default_value(0),
+				"also run on generated code with this many functions"
+			)
+			(
+				"baseline",
+				po::value<string>(),
+				"output of an earlier run to compare with"
+			)
+			(
+				"max-regression",
+				po::value<double>(),
+				"exit with status 2 if the time per node of a step exceeds the one of the baseline by more than this many percent"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-paths", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || (!arguments.count("input-paths") && stressFunctions == 0) || repetitions == 0)
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		EVMVersion evmVersion;
+		vector<string> allSteps;
+		{
+			AssemblyStack stack(evmVersion, AssemblyStack::Language::StrictAssembly, frontend::OptimiserSettings::none(), DebugInfoSelection::None());
+			stack.parseAndAnalyze("", "{}");
+			allSteps = YulOptimizerTestCommon(stack.parserResult(), EVMDialect::strictAssemblyForEVMObjects(evmVersion)).optimiserSteps();
+		}
+		set<string> knownSteps(allSteps.begin(), allSteps.end());
+
+		vector<string> stepList;
+		if (steps == "all")
+			copy_if(allSteps.begin(), allSteps.end(), back_inserter(stepList), [](string const& _step) {
+				return !stepsNotRunByDefault.count(_step);
+			});
+		else if (!steps.empty())
+			boost::split(stepList, steps, boost::is_any_of(","));
+		for (string const& step: stepList)
+			if (!knownSteps.count(step))
+			{
+				cerr << "Invalid optimizer step: " << step << endl;
+				return 1;
+			}
+
+		vector<Benchmark> benchmarks;
+		if (arguments.count("input-paths"))
+			for (string const& path: arguments["input-paths"].as<vector<string>>())
+				loadBenchmarks(path, knownSteps, benchmarks);
+		if (stressFunctions > 0)
+			benchmarks.emplace_back(Benchmark{
+				"stress" + to_string(stressFunctions),
+				stressCode(stressFunctions),
+				AssemblyStack::Language::StrictAssembly,
+				"fullSuite"
+			});
+
+		map<string, Json::Value> baseline;
+		if (arguments.count("baseline"))
+		{
+			Json::Value baselineOutput;
+			if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baselineOutput))
+			{
+				cerr << "Invalid baseline." << endl;
+				return 1;
+			}
+			for (Json::Value const& entry: baselineOutput["steps"])
+				baseline[entry["step"].asString()] = entry;
+		}
+		optional<double> maxRegression;
+		if (arguments.count("max-regression"))
+			maxRegression = arguments["max-regression"].as<double>();
+
+		Json::Value output{Json::objectValue};
+		output["benchmarks"] = Json::arrayValue;
+		// Sums of the nodes, the fastest times and the allocations of all inputs, by step.
+		map<string, Json::Value> totals;
+		for (Benchmark const& benchmark: benchmarks)
+			for (string const& step: stepList.empty() ? vector<string>{benchmark.defaultStep} : stepList)
+			{
+				Json::Value entry{Json::objectValue};
+				entry["name"] = benchmark.name;
+				entry["step"] = step;
+				entry["times"] = Json::arrayValue;
+				try
+				{
+					for (size_t i = 0; i < repetitions; ++i)
+					{
+						Json::Value result;
+						runOnce(benchmark, step, evmVersion, result);
+						entry["times"].append(result["time"]);
+						if (!entry.isMember("time") || result["time"].asInt64() < entry["time"].asInt64())
+							entry["time"] = result["time"];
+						entry["nodes"] = result["nodes"];
+						entry["allocations"] = result["allocations"];
+					}
+				}
+				catch (std::exception const& _exception)
+				{
+					cerr << "Running " << step << " on " << benchmark.name << " failed: " << _exception.what() << endl;
+					continue;
+				}
+				if (entry["nodes"].asUInt64() > 0)
+					entry["nsPerNode"] = entry["time"].asDouble() / entry["nodes"].asDouble();
+
+				Json::Value& total = totals[step];
+				total["step"] = step;
+				total["nodes"] = total["nodes"].asUInt64() + entry["nodes"].asUInt64();
+				total["time"] = total["time"].asInt64() + entry["time"].asInt64();
+				total["allocations"] = total["allocations"].asUInt64() + entry["allocations"].asUInt64();
+				output["benchmarks"].append(move(entry));
+			}
+
+		bool regressed = false;
+		output["steps"] = Json::arrayValue;
+		for (auto& [step, total]: totals)
+		{
+			if (total["nodes"].asUInt64() > 0)
+				total["nsPerNode"] = total["time"].asDouble() / total["nodes"].asDouble();
+			if (auto previous = baseline.find(step); previous != baseline.end() && total.isMember("nsPerNode"))
+			{
+				double previousNsPerNode = previous->second["nsPerNode"].asDouble();
+				total["baseline"]["nsPerNode"] = previousNsPerNode;
+				total["baseline"]["allocations"] = previous->second["allocations"];
+				if (previousNsPerNode > 0)
+				{
+					double change = (total["nsPerNode"].asDouble() / previousNsPerNode - 1.0) * 100.0;
+					total["nsPerNodeChange"] = change;
+					if (maxRegression && change > *maxRegression)
+						regressed = true;
+				}
+			}
+			cerr << step << ": " << total["nsPerNode"].asDouble() << " ns per node, " << total["allocations"].asUInt64() << " allocations" << endl;
+			output["steps"].append(total);
+		}
+
+		cout << jsonPrettyPrint(output) << endl;
+		return regressed ? 2 : 0;
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (FileNotFound const& _exception)
+	{
+		cerr << "File not found: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (NotAFile const& _exception)
+	{
+		cerr << "Not a file: " << _exception.comment() << endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+}
@@ -26,6 +26,7 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
@@ -121,6 +122,7 @@ public:
 protected:
 	TemporaryDirectory m_tempDir;
 	string const m_autosavePath = (m_tempDir.path() / "population-autosave.txt").string();
+	string const m_bestChromosomePath = (m_tempDir.path() / "best-chromosome.json").string();
 	RandomisingAlgorithm m_algorithm;
 };
 
@@ -447,6 +449,39 @@ BOOST_FIXTURE_TEST_CASE(run_should_not_save_population_to_file_if_autosave_file_
 	BOOST_TEST(!fs::exists(m_autosavePath));
 }
 
+BOOST_FIXTURE_TEST_CASE(run_should_save_best_chromosome_as_standard_json_settings_if_file_specified, AlgorithmRunnerAutosaveFixture)
+{
+	m_options.maxRounds = 0;
+	m_options.bestChromosomeFile = m_bestChromosomePath;
+	AlgorithmRunner runner(m_population, {}, m_options, m_output);
+	assert(!fs::exists(m_bestChromosomePath));
+
+	runner.run(m_algorithm);
+
+	Json::Value settings;
+	BOOST_REQUIRE(jsonParseStrict(readFileAsString(m_bestChromosomePath), settings));
+	BOOST_TEST(
+		settings["optimizer"]["details"]["yulDetails"]["optimizerSteps"].asString() ==
+		toString(m_population.individuals()[0].chromosome)
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_only_replace_saved_best_chromosome_with_better_ones, AlgorithmRunnerAutosaveFixture)
+{
+	m_options.maxRounds = 5;
+	m_options.bestChromosomeFile = m_bestChromosomePath;
+	AlgorithmRunner runner(m_population, {}, m_options, m_output);
+
+	runner.run(m_algorithm);
+
+	Json::Value settings;
+	BOOST_REQUIRE(jsonParseStrict(readFileAsString(m_bestChromosomePath), settings));
+	string savedGenes = settings["optimizer"]["details"]["yulDetails"]["optimizerSteps"].asString();
+	// ChromosomeLengthMetric prefers shorter chromosomes.
+	BOOST_TEST(savedGenes.size() <= m_population.individuals()[0].chromosome.length());
+	BOOST_TEST(savedGenes.size() <= runner.population().individuals()[0].chromosome.length());
+}
+
 BOOST_FIXTURE_TEST_CASE(run_should_randomise_duplicate_chromosomes_if_requested, AlgorithmRunnerFixture)
 {
 	Chromosome duplicate("afc");
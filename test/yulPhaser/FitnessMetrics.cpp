@@ -21,6 +21,8 @@
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/UnusedPruner.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
@@ -30,6 +32,7 @@
 #include <cmath>
 
 using namespace std;
+using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
@@ -81,6 +84,16 @@ protected:
 	static constexpr CodeWeights m_weights{};
 };
 
+class ExecutionCostFixture
+{
+protected:
+	static Program load(string const& _sourceCode)
+	{
+		CharStream sourceStream(_sourceCode, "");
+		return get<Program>(Program::load(sourceStream));
+	}
+};
+
 class FitnessMetricCombinationFixture: public ProgramBasedMetricFixture
 {
 protected:
@@ -134,6 +147,36 @@ BOOST_FIXTURE_TEST_CASE(optimisedProgramNoCache_should_not_use_cache_even_if_ava
 	BOOST_TEST(m_programCache->size() == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimisationEffort_should_add_up_program_sizes_before_each_step, ProgramBasedMetricFixture)
+{
+	Program programAfterFirstStep = m_program;
+	programAfterFirstStep.optimise({m_chromosome.optimisationSteps()[0]});
+
+	BOOST_TEST(
+		DummyProgramBasedMetric(m_program, nullptr, m_weights).optimisationEffort(m_chromosome) ==
+		m_program.codeSize(m_weights) + programAfterFirstStep.codeSize(m_weights)
+	);
+	BOOST_TEST(DummyProgramBasedMetric(m_program, nullptr, m_weights).optimisationEffort(Chromosome("")) == 0);
+	BOOST_TEST(DummyProgramBasedMetric(m_program, nullptr, m_weights, 0).optimisationEffort(m_chromosome) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimisationEffort_should_use_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t effort = DummyProgramBasedMetric(m_program, nullptr, m_weights, 2).optimisationEffort(m_chromosome);
+
+	BOOST_TEST(DummyProgramBasedMetric(nullopt, m_programCache, m_weights, 2).optimisationEffort(m_chromosome) == effort);
+	BOOST_TEST(m_programCache->size() == 2 * m_chromosome.length());
+}
+
+BOOST_FIXTURE_TEST_CASE(optimisationEffort_should_not_depend_on_evicted_cache_entries, ProgramBasedMetricFixture)
+{
+	size_t effort = DummyProgramBasedMetric(m_program, nullptr, m_weights, 2).optimisationEffort(m_chromosome);
+	auto limitedCache = make_shared<ProgramCache>(m_program, 0);
+
+	BOOST_TEST(DummyProgramBasedMetric(nullopt, limitedCache, m_weights, 2).optimisationEffort(m_chromosome) == effort);
+	BOOST_TEST(limitedCache->size() == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(ProgramSizeTest)
 
@@ -238,6 +281,152 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(RelativeProgramSizeAndEffortTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_add_weighted_relative_effort_to_relative_size, ProgramBasedMetricFixture)
+{
+	size_t relativeSize = RelativeProgramSize(m_program, nullptr, 3, m_weights).evaluate(m_chromosome);
+	size_t effort = DummyProgramBasedMetric(m_program, nullptr, m_weights).optimisationEffort(m_chromosome);
+
+	BOOST_TEST(
+		RelativeProgramSizeAndEffort(m_program, nullptr, 3, 0.5, m_weights).evaluate(m_chromosome) ==
+		relativeSize + round(0.5 * 1000.0 * double(effort) / double(m_program.codeSize(m_weights)))
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	BOOST_TEST(
+		RelativeProgramSizeAndEffort(nullopt, m_programCache, 3, 0.5, m_weights).evaluate(m_chromosome) ==
+		RelativeProgramSizeAndEffort(m_program, nullptr, 3, 0.5, m_weights).evaluate(m_chromosome)
+	);
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_ignore_effort_if_weight_is_zero, ProgramBasedMetricFixture)
+{
+	BOOST_TEST(
+		RelativeProgramSizeAndEffort(m_program, nullptr, 3, 0.0, m_weights).evaluate(m_chromosome) ==
+		RelativeProgramSize(m_program, nullptr, 3, m_weights).evaluate(m_chromosome)
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ExecutionCostTest)
+
+BOOST_FIXTURE_TEST_CASE(executionCost_should_add_up_gas_costs_of_executed_instructions, ExecutionCostFixture)
+{
+	Program program = load("{ sstore(0, calldataload(0)) }");
+
+	BOOST_TEST(
+		ExecutionCost::executionCost(program, {}, 1000) ==
+		GasCosts::tier2Gas + GasCosts::totalSstoreResetGas(EVMVersion{})
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(executionCost_should_include_memory_expansion, ExecutionCostFixture)
+{
+	Program program = load("{ mstore(0x40, 1) }");
+
+	BOOST_TEST(ExecutionCost::executionCost(program, {}, 1000) == GasCosts::tier2Gas + 3 * GasCosts::memoryGas);
+}
+
+BOOST_FIXTURE_TEST_CASE(executionCost_should_depend_on_calldata, ExecutionCostFixture)
+{
+	Program program = load("{ if calldataload(0) { sstore(0, 1) } }");
+
+	size_t costWithoutStore = ExecutionCost::executionCost(program, {}, 1000);
+	size_t costWithStore = ExecutionCost::executionCost(program, bytes(32, 0xff), 1000);
+
+	BOOST_TEST(costWithStore == costWithoutStore + GasCosts::totalSstoreResetGas(EVMVersion{}));
+}
+
+BOOST_FIXTURE_TEST_CASE(executionCost_should_stop_at_step_limit, ExecutionCostFixture)
+{
+	Program program = load("{ for {} 1 {} { mstore(0, 1) } }");
+
+	size_t shortCost = ExecutionCost::executionCost(program, {}, 100);
+	size_t longCost = ExecutionCost::executionCost(program, {}, 1000);
+
+	BOOST_TEST(shortCost > 0);
+	BOOST_TEST(longCost > shortCost);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_add_up_costs_for_all_calldata_values, ExecutionCostFixture)
+{
+	Program program = load("{ if calldataload(0) { sstore(0, 1) } }");
+	vector<bytes> calldata = {{}, bytes(32, 0xff), bytes(32, 0xff)};
+
+	BOOST_TEST(
+		ExecutionCost(program, nullptr, calldata, 1000).evaluate(Chromosome("")) ==
+		ExecutionCost::executionCost(program, calldata[0], 1000) +
+		2 * ExecutionCost::executionCost(program, calldata[1], 1000)
+	);
+	BOOST_TEST(
+		ExecutionCost(program, nullptr, {}, 1000).evaluate(Chromosome("")) ==
+		ExecutionCost::executionCost(program, {}, 1000)
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_cost_of_the_optimised_program, ExecutionCostFixture)
+{
+	Program program = load("{ let x := calldataload(0) sstore(0, x) sstore(0, x) }");
+	Chromosome chromosome("xascLM");
+	Program optimisedProgram = program;
+	optimisedProgram.optimise(chromosome.optimisationSteps());
+
+	size_t unoptimisedCost = ExecutionCost(program, nullptr, {}, 1000).evaluate(Chromosome(""));
+	size_t optimisedCost = ExecutionCost(program, nullptr, {}, 1000).evaluate(chromosome);
+
+	BOOST_TEST(unoptimisedCost == ExecutionCost::executionCost(program, {}, 1000));
+	BOOST_TEST(optimisedCost == ExecutionCost::executionCost(optimisedProgram, {}, 1000));
+	BOOST_TEST(
+		ExecutionCost(nullopt, make_shared<ProgramCache>(program), {}, 1000).evaluate(chromosome) ==
+		optimisedCost
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(EvaluateAllTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_as_evaluate, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome("xaccdfhjLmnopqrstuSvTUOIcCDEFg"),
+		Chromosome(""),
+		Chromosome("fLumcxrEj"),
+		m_chromosome,
+	};
+	ProgramSize metric(m_program, nullptr, m_weights);
+
+	vector<size_t> expectedFitness;
+	for (auto const& chromosome: chromosomes)
+		expectedFitness.push_back(metric.evaluate(chromosome));
+
+	BOOST_TEST(metric.parallelism() == 1);
+	BOOST_TEST(metric.evaluateAll(chromosomes) == expectedFitness);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_not_depend_on_parallelism, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome("xaccdfhjLmnopqrstuSvTUOIcCDEFg"),
+		Chromosome(""),
+		Chromosome("fLumcxrEj"),
+		Chromosome("fLumcxrEjT"),
+		m_chromosome,
+	};
+	RelativeProgramSize sequentialMetric(m_program, nullptr, 3, m_weights);
+	RelativeProgramSize parallelMetric(m_program, m_programCache, 3, m_weights);
+	parallelMetric.setParallelism(4);
+
+	BOOST_TEST(parallelMetric.parallelism() == 4);
+	BOOST_TEST(parallelMetric.evaluateAll(chromosomes) == sequentialMetric.evaluateAll(chromosomes));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
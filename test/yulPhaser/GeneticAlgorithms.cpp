@@ -27,6 +27,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <sstream>
 #include <vector>
 
 using namespace std;
@@ -57,6 +59,25 @@ protected:
 	};
 };
 
+class InverseChromosomeLengthMetric: public FitnessMetric
+{
+public:
+	size_t evaluate(Chromosome const& _chromosome) override { return 100 - _chromosome.length(); }
+};
+
+class NSGA2AlgorithmFixture: public GeneticAlgorithmFixture
+{
+protected:
+	NSGA2Algorithm::Options m_options = {
+		/* crossoverChance = */ 0.0,
+		/* mutationChance = */ 0.0,
+		/* deletionChance = */ 0.0,
+		/* additionChance = */ 0.0,
+		/* CrossoverChoice = */ CrossoverChoice::SinglePoint,
+		/* uniformCrossoverSwapChance= */ 0.5,
+	};
+};
+
 BOOST_AUTO_TEST_SUITE(Phaser, *boost::unit_test::label("nooptions"))
 BOOST_AUTO_TEST_SUITE(GeneticAlgorithmsTest)
 BOOST_AUTO_TEST_SUITE(RandomAlgorithmTest)
@@ -404,6 +425,93 @@ BOOST_FIXTURE_TEST_CASE(runNextRound_should_preserve_elite, ClassicGeneticAlgori
 	BOOST_TEST((chromosomeLengths(newPopulation) == vector<size_t>{0, 0, 0, 0, 0, 3, 3, 3, 3, 5}));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(NSGA2AlgorithmTest)
+
+BOOST_AUTO_TEST_CASE(dominates_should_require_being_better_in_at_least_one_objective)
+{
+	BOOST_TEST(NSGA2Algorithm::dominates({1, 2}, {2, 2}));
+	BOOST_TEST(NSGA2Algorithm::dominates({1, 1}, {2, 2}));
+	BOOST_TEST(!NSGA2Algorithm::dominates({2, 2}, {2, 2}));
+	BOOST_TEST(!NSGA2Algorithm::dominates({1, 3}, {2, 2}));
+	BOOST_TEST(!NSGA2Algorithm::dominates({3, 3}, {2, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(nonDominatedFronts_should_sort_points_into_fronts)
+{
+	vector<vector<size_t>> points = {{1, 5}, {2, 2}, {5, 1}, {3, 3}, {4, 4}, {2, 2}, {5, 5}, {6, 1}};
+
+	BOOST_TEST((NSGA2Algorithm::nonDominatedFronts(points) == vector<vector<size_t>>{
+		{0, 1, 2, 5},
+		{3, 7},
+		{4},
+		{6},
+	}));
+	BOOST_TEST(NSGA2Algorithm::nonDominatedFronts({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(crowdingDistances_should_add_up_normalised_distances_between_neighbours)
+{
+	vector<vector<size_t>> points = {{1, 5}, {9, 9}, {4, 1}, {2, 3}, {3, 2}};
+	vector<double> distances = NSGA2Algorithm::crowdingDistances(points, {0, 2, 3, 4});
+
+	BOOST_REQUIRE(distances.size() == 4);
+	BOOST_TEST(distances[0] == numeric_limits<double>::infinity());
+	BOOST_TEST(distances[1] == numeric_limits<double>::infinity());
+	BOOST_TEST(distances[2] == (3.0 - 1.0) / 3.0 + (5.0 - 2.0) / 4.0);
+	BOOST_TEST(distances[3] == (4.0 - 2.0) / 3.0 + (3.0 - 1.0) / 4.0);
+}
+
+BOOST_FIXTURE_TEST_CASE(runNextRound_should_keep_the_best_individuals_if_objectives_agree, NSGA2AlgorithmFixture)
+{
+	auto population = Population::makeRandom(m_fitnessMetric, 4, 3, 3) + Population::makeRandom(m_fitnessMetric, 4, 5, 5);
+	assert((chromosomeLengths(population) == vector<size_t>{3, 3, 3, 3, 5, 5, 5, 5}));
+	NSGA2Algorithm algorithm(m_options, {m_fitnessMetric});
+
+	Population newPopulation = algorithm.runNextRound(population);
+
+	BOOST_TEST(newPopulation.individuals().size() == population.individuals().size());
+	for (size_t i = 0; i < 4; ++i)
+		BOOST_TEST(newPopulation.individuals()[i].chromosome.length() == 3);
+
+	BOOST_TEST(!algorithm.paretoFront().empty());
+	for (auto const& member: algorithm.paretoFront())
+		BOOST_TEST((member.objectiveValues == vector<size_t>{3}));
+}
+
+BOOST_FIXTURE_TEST_CASE(runNextRound_should_keep_the_extremes_of_the_front, NSGA2AlgorithmFixture)
+{
+	Population population(m_fitnessMetric);
+	for (size_t length = 1; length <= 8; ++length)
+		population = population + Population::makeRandom(m_fitnessMetric, 1, length, length);
+	assert((chromosomeLengths(population) == vector<size_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+	NSGA2Algorithm algorithm(m_options, {m_fitnessMetric, make_shared<InverseChromosomeLengthMetric>()});
+
+	Population newPopulation = algorithm.runNextRound(population);
+
+	vector<size_t> lengths = chromosomeLengths(newPopulation);
+	BOOST_TEST(lengths.size() == 8);
+	BOOST_TEST(lengths.front() == 1);
+	BOOST_TEST(lengths.back() == 8);
+
+	// None of the points dominates any other so all of them belong to the first front.
+	BOOST_TEST(algorithm.paretoFront().size() >= 2);
+	for (auto const& member: algorithm.paretoFront())
+		BOOST_TEST((member.objectiveValues == vector<size_t>{member.chromosome.length(), 100 - member.chromosome.length()}));
+}
+
+BOOST_FIXTURE_TEST_CASE(printReport_should_print_the_front_with_objective_values, NSGA2AlgorithmFixture)
+{
+	Population population(m_fitnessMetric, vector<Chromosome>{Chromosome("fcL"), Chromosome("fcL")});
+	NSGA2Algorithm algorithm(m_options, {m_fitnessMetric, make_shared<InverseChromosomeLengthMetric>()});
+	algorithm.runNextRound(population);
+
+	stringstream output;
+	algorithm.printReport(output);
+
+	BOOST_TEST(output.str() == "---------- PARETO FRONT ----------\n3 97 fcL\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
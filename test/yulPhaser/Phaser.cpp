@@ -63,6 +63,10 @@ protected:
 		/* classicMutationChance = */ 0.2,
 		/* classicDeletionChance = */ 0.2,
 		/* classicAdditionChance = */ 0.2,
+		/* nsga2CrossoverChance = */ 0.75,
+		/* nsga2MutationChance = */ 0.2,
+		/* nsga2DeletionChance = */ 0.2,
+		/* nsga2AdditionChance = */ 0.2,
 	};
 };
 
@@ -151,6 +155,21 @@ BOOST_FIXTURE_TEST_CASE(build_should_select_the_right_algorithm_and_pass_the_opt
 	BOOST_TEST(classicAlgorithm->options().mutationChance == m_options.classicMutationChance);
 	BOOST_TEST(classicAlgorithm->options().deletionChance == m_options.classicDeletionChance);
 	BOOST_TEST(classicAlgorithm->options().additionChance == m_options.classicAdditionChance);
+
+	m_options.algorithm = Algorithm::NSGA2;
+	unique_ptr<GeneticAlgorithm> algorithm4 = GeneticAlgorithmFactory::build(m_options, 100, {make_shared<ChromosomeLengthMetric>()});
+	BOOST_REQUIRE(algorithm4 != nullptr);
+
+	auto nsga2Algorithm = dynamic_cast<NSGA2Algorithm*>(algorithm4.get());
+	BOOST_REQUIRE(nsga2Algorithm != nullptr);
+	BOOST_TEST(nsga2Algorithm->objectives().size() == 1);
+	BOOST_TEST(nsga2Algorithm->options().crossover == m_options.crossover);
+	BOOST_TEST(nsga2Algorithm->options().uniformCrossoverSwapChance.has_value());
+	BOOST_TEST(nsga2Algorithm->options().uniformCrossoverSwapChance.value() == m_options.uniformCrossoverSwapChance);
+	BOOST_TEST(nsga2Algorithm->options().crossoverChance == m_options.nsga2CrossoverChance);
+	BOOST_TEST(nsga2Algorithm->options().mutationChance == m_options.nsga2MutationChance);
+	BOOST_TEST(nsga2Algorithm->options().deletionChance == m_options.nsga2DeletionChance);
+	BOOST_TEST(nsga2Algorithm->options().additionChance == m_options.nsga2AdditionChance);
 }
 
 BOOST_FIXTURE_TEST_CASE(build_should_set_random_algorithm_elite_pool_size_based_on_population_size_if_not_specified, GeneticAlgorithmFactoryFixture)
@@ -237,6 +256,74 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_effort_weight, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::RelativeCodeSizeAndEffort;
+	m_options.metricAggregator = MetricAggregatorChoice::Average;
+	m_options.effortWeight = 0.25;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+	BOOST_REQUIRE(averageMetric->metrics()[0] != nullptr);
+
+	auto sizeAndEffortMetric = dynamic_cast<RelativeProgramSizeAndEffort*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(sizeAndEffortMetric != nullptr);
+	BOOST_TEST(sizeAndEffortMetric->effortWeight() == m_options.effortWeight);
+	BOOST_TEST(sizeAndEffortMetric->fixedPointPrecision() == m_options.relativeMetricScale);
+}
+
+BOOST_FIXTURE_TEST_CASE(build_should_pass_execution_options_to_execution_cost_metric, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::ExecutionCost;
+	m_options.executionCalldata = {{0x12, 0x34}, {}};
+	m_options.executionStepLimit = 500;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+
+	auto executionCostMetric = dynamic_cast<ExecutionCost*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(executionCostMetric != nullptr);
+	BOOST_TEST((executionCostMetric->calldata() == m_options.executionCalldata));
+	BOOST_TEST(executionCostMetric->maxSteps() == 500);
+}
+
+BOOST_FIXTURE_TEST_CASE(build_should_set_parallelism, FitnessMetricFactoryFixture)
+{
+	m_options.parallelism = 3;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	BOOST_TEST(metric->parallelism() == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(buildObjectives_should_create_metric_for_each_objective, FitnessMetricFactoryFixture)
+{
+	m_options.objectives = {MetricChoice::CodeSize, MetricChoice::OptimisationEffort};
+	vector<shared_ptr<FitnessMetric>> objectives = FitnessMetricFactory::buildObjectives(
+		m_options,
+		{m_programs[0]},
+		{nullptr},
+		m_weights
+	);
+	BOOST_REQUIRE(objectives.size() == 2);
+
+	auto averageMetric1 = dynamic_cast<FitnessMetricAverage*>(objectives[0].get());
+	BOOST_REQUIRE(averageMetric1 != nullptr);
+	BOOST_REQUIRE(averageMetric1->metrics().size() == 1);
+	BOOST_TEST(dynamic_cast<ProgramSize*>(averageMetric1->metrics()[0].get()) != nullptr);
+
+	auto averageMetric2 = dynamic_cast<FitnessMetricAverage*>(objectives[1].get());
+	BOOST_REQUIRE(averageMetric2 != nullptr);
+	BOOST_REQUIRE(averageMetric2->metrics().size() == 1);
+	BOOST_TEST(dynamic_cast<OptimisationEffort*>(averageMetric2->metrics()[0].get()) != nullptr);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -357,6 +444,38 @@ BOOST_FIXTURE_TEST_CASE(build_should_throw_FileOpenError_if_population_file_does
 	BOOST_CHECK_THROW(PopulationFactory::build(m_options, m_fitnessMetric), FileOpenError);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_include_chromosome_from_best_chromosome_file_if_it_exists, PoulationFactoryFixture)
+{
+	TemporaryDirectory tempDir;
+	m_options.population = {"a"};
+	m_options.bestChromosomeFile = (tempDir.path() / "best.json").string();
+	BOOST_TEST(
+		PopulationFactory::build(m_options, m_fitnessMetric) ==
+		Population(m_fitnessMetric, {Chromosome("a")})
+	);
+
+	{
+		ofstream tmpFile(m_options.bestChromosomeFile.value());
+		tmpFile << R"({"optimizer": {"details": {"yulDetails": {"optimizerSteps": "fcLT"}}}})" << endl;
+	}
+	BOOST_TEST(
+		PopulationFactory::build(m_options, m_fitnessMetric) ==
+		Population(m_fitnessMetric, {Chromosome("a"), Chromosome("fcLT")})
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(build_should_throw_InvalidBestChromosomeFile_if_best_chromosome_file_is_invalid, PoulationFactoryFixture)
+{
+	TemporaryDirectory tempDir;
+	m_options.bestChromosomeFile = (tempDir.path() / "best.json").string();
+	{
+		ofstream tmpFile(m_options.bestChromosomeFile.value());
+		tmpFile << R"({"optimizer": {"details": {"yulDetails": {"optimizerSteps": "f[c]"}}}})" << endl;
+	}
+
+	BOOST_CHECK_THROW(PopulationFactory::build(m_options, m_fitnessMetric), InvalidBestChromosomeFile);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_combine_populations_from_all_sources, PoulationFactoryFixture)
 {
 	TemporaryDirectory tempDir;
@@ -399,6 +518,19 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_size_limit_to_caches, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 1000};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+
+	BOOST_TEST(caches.size() == m_programs.size());
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		BOOST_REQUIRE(caches[i] != nullptr);
+		BOOST_TEST(caches[i]->maxTotalCodeSize().value() == 1000);
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
 	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
@@ -24,6 +24,7 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -163,6 +164,22 @@ BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_the_longest_prefix_and_move
 	BOOST_TEST(m_programCache.entries().find("IuOI")->second.roundNumber == 1);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_be_safe_to_call_from_multiple_threads, ProgramCacheFixture)
+{
+	vector<string> sequences = {"Iu", "IuO", "Ia", "IuOI", "af", "Iu", "acf", "IuOa"};
+	vector<string> results(sequences.size());
+
+	parallelForEach(sequences.size(), 4, [&](size_t _index) {
+		results[_index] = toString(m_programCache.optimiseProgram(sequences[_index]));
+	});
+
+	for (size_t i = 0; i < sequences.size(); ++i)
+		BOOST_TEST(results[i] == toString(optimisedProgram(m_program, sequences[i])));
+	BOOST_TEST((cachedKeys(m_programCache) == set<string>{
+		"I", "Iu", "IuO", "Ia", "IuOI", "a", "af", "ac", "acf", "IuOa",
+	}));
+}
+
 BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds, ProgramCacheFixture)
 {
 	BOOST_TEST(m_programCache.currentRound() == 0);
@@ -252,6 +269,59 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_oldest_entries_to_stay_within_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	size_t sizeLT = optimisedProgram(m_program, "LT").codeSize(CacheStats::StorageWeights);
+	ProgramCache programCache(m_program, max(sizeI, sizeIu) + sizeL + sizeLT);
+	assert(min(sizeI, sizeIu) <= sizeLT && "Only the last insertion should exceed the limit");
+	BOOST_TEST(programCache.maxTotalCodeSize().value() == max(sizeI, sizeIu) + sizeL + sizeLT);
+
+	programCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "Iu"}));
+
+	programCache.startRound(1);
+	Program cachedProgram = programCache.optimiseProgram("LT");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "LT")));
+	BOOST_TEST(programCache.contains("L"));
+	BOOST_TEST(programCache.contains("LT"));
+	BOOST_TEST(programCache.size() == 3);
+	BOOST_TEST(programCache.gatherStats().totalCodeSize <= programCache.maxTotalCodeSize().value());
+	// Among entries from the same round the larger ones go first.
+	BOOST_TEST(programCache.contains(sizeI < sizeIu ? "I" : "Iu"));
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_entries_whose_prefixes_were_evicted, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	ProgramCache programCache(m_program, sizeI);
+	assert(sizeI > sizeIu && "The prefix must be the first candidate for eviction");
+
+	programCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"Iu"}));
+
+	Program cachedProgram = programCache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(programCache.gatherStats().hits == 1);
+	BOOST_TEST(programCache.gatherStats().misses == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_store_anything_if_limit_is_zero, ProgramCacheFixture)
+{
+	ProgramCache programCache(m_program, 0);
+
+	Program cachedProgram = programCache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(programCache.size() == 0);
+	BOOST_TEST(programCache.gatherStats().totalCodeSize == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -26,6 +26,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <range/v3/view/reverse.hpp>
+
 #ifdef _WIN32 // windows
 	#include <io.h>
 	#define isatty _isatty
@@ -55,6 +57,7 @@ static string const g_argUnsafe = "unsafe";
 static string const g_argVerbose = "verbose";
 static string const g_argIgnoreMissingFiles = "ignore-missing";
 static string const g_argAllowPaths = "allow-paths";
+static string const g_argJobs = "jobs";
 
 namespace
 {
@@ -127,6 +130,11 @@ Allowed options)",
 			"with a comma."
 		)
 		(g_argIgnoreMissingFiles.c_str(), "Ignore missing files.")
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to parse the sources."
+		)
 		(
 			g_argModules.c_str(),
 			po::value<string>()->value_name("module(s)"),
@@ -322,12 +330,7 @@ void SourceUpgrade::runUpgrade()
 
 	while (recompile && !m_compiler->errors().empty())
 	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+		recompile = analyzeAndUpgrade();
 
 		if (recompile)
 		{
@@ -338,60 +341,75 @@ void SourceUpgrade::runUpgrade()
 	}
 }
 
-bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
+bool SourceUpgrade::analyzeAndUpgrade()
 {
 	bool applyUnsafe = m_args.count(g_argUnsafe);
 	bool verbose = m_args.count(g_argVerbose);
 
-	if (verbose)
-		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
-
-	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
+	if (m_compiler->state() < CompilerStack::State::AnalysisPerformed)
+		return false;
 
-	if (!m_suite.changes().empty())
+	// All sources are analysed before any of them is changed, since the changes
+	// refer to the sources that were compiled.
+	for (auto const& sourceCode: m_sourceCodes)
 	{
-		auto& change = m_suite.changes().front();
-
 		if (verbose)
-			change.log(*m_compiler, true);
+			log() << "Analyzing " << sourceCode.first << "." << endl;
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
-		}
+		m_suite.analyze(*m_compiler, m_compiler->ast(sourceCode.first));
 	}
 
-	return false;
+	map<string, vector<UpgradeChange const*>> changesBySource;
+	for (UpgradeChange const& change: m_suite.changes())
+		if (change.level() == UpgradeChange::Level::Safe || applyUnsafe)
+			if (change.location().sourceName && m_sourceCodes.count(*change.location().sourceName))
+				changesBySource[*change.location().sourceName].push_back(&change);
+
+	bool changed = false;
+	for (auto& [sourceName, changes]: changesBySource)
+		if (applyChanges(sourceName, move(changes)))
+			changed = true;
+
+	return changed;
 }
 
-void SourceUpgrade::applyChange(
-	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
-)
+bool SourceUpgrade::applyChanges(string const& _sourceName, vector<UpgradeChange const*> _changes)
 {
 	bool dryRun = m_args.count(g_argDryRun);
 	bool verbose = m_args.count(g_argVerbose);
 
+	// Of overlapping changes, only the first one in the source is applied in this pass.
+	// The others are found again after the next compilation.
+	stable_sort(_changes.begin(), _changes.end(), [](UpgradeChange const* _a, UpgradeChange const* _b) {
+		return _a->location().start < _b->location().start;
+	});
+	vector<UpgradeChange const*> applicable;
+	for (UpgradeChange const* change: _changes)
+		if (applicable.empty() || applicable.back()->location().end <= change->location().start)
+			applicable.push_back(change);
+	if (applicable.empty())
+		return false;
+
 	if (verbose)
+		log() << "Upgrading " << _sourceName << "." << endl;
+
+	// The changes are applied from the end, so that the locations of the others stay valid.
+	string& source = m_sourceCodes.at(_sourceName);
+	for (UpgradeChange const* change: applicable | ranges::views::reverse)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
+		if (verbose)
+		{
+			change->log(*m_compiler, true);
+			log() << "Applying change to " << _sourceName << endl << endl;
+			log() << change->patch();
+		}
+		source = change->apply(move(source));
 	}
 
-	m_sourceCodes[_sourceCode.first] = _change.apply(_sourceCode.second);
-
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, m_sourceCodes[_sourceCode.first]);
+		writeInputFile(_sourceName, source);
+
+	return true;
 }
 
 void SourceUpgrade::printErrors() const
@@ -529,6 +547,8 @@ void SourceUpgrade::resetCompiler()
 	m_compiler->reset();
 	m_compiler->setSources(m_sourceCodes);
 	m_compiler->setParserErrorRecovery(true);
+	if (m_args.count(g_argJobs))
+		m_compiler->setParallelism(max(1u, m_args[g_argJobs].as<unsigned>()));
 }
 
 void SourceUpgrade::resetCompiler(ReadCallback::Callback const& _callback)
@@ -536,4 +556,6 @@ void SourceUpgrade::resetCompiler(ReadCallback::Callback const& _callback)
 	m_compiler = std::make_unique<CompilerStack>(_callback);
 	m_compiler->setSources(m_sourceCodes);
 	m_compiler->setParserErrorRecovery(true);
+	if (m_args.count(g_argJobs))
+		m_compiler->setParallelism(max(1u, m_args[g_argJobs].as<unsigned>()));
 }
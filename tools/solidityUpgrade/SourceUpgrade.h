@@ -118,24 +118,23 @@ private:
 	/// Parses the current sources and runs analyses as well as compilation on
 	/// them if parsing was successful.
 	void tryCompile() const;
-	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// Analyses and upgrades the sources given. The upgrade happens in passes,
+	/// which are run until no applicable changes are found any more. In each pass,
+	/// the changes found in all sources are applied together and the sources are
+	/// compiled again only once afterwards.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
-	bool analyzeAndUpgrade(
-		std::pair<std::string, std::string> const& _sourceCode
-	);
-
-	/// Applies the change given to its source code. If no `--dry-run` was
-	/// passed via the commandline, the upgraded source code is written back
-	/// to its file.
-	void applyChange(
-		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
+	/// Runs upgrade analysis on all sources and applies the upgrade changes to them.
+	/// Returns `true` if at least one change was applied, `false` otherwise.
+	bool analyzeAndUpgrade();
+
+	/// Applies the given changes to the source code of @a _sourceName. Changes that
+	/// overlap with one that is applied are left for the next pass, since the
+	/// modules compute them from the current source. If no `--dry-run` was passed
+	/// via the commandline, the upgraded source code is written back to its file.
+	/// Returns `true` if at least one change was applied, `false` otherwise.
+	bool applyChanges(
+		std::string const& _sourceName,
+		std::vector<UpgradeChange const*> _changes
 	);
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
@@ -21,6 +21,7 @@
 #include <tools/yulPhaser/Exceptions.h>
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/JSON.h>
 
 #include <cerrno>
 #include <cstring>
@@ -32,6 +33,8 @@ using namespace solidity::phaser;
 void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 {
 	populationAutosave();
+	m_savedFitness = nullopt;
+	bestChromosomeSave();
 	printInitialPopulation();
 	cacheClear();
 
@@ -45,8 +48,11 @@ void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 		randomiseDuplicates();
 
 		printRoundSummary(round, roundTimeStart, totalTimeStart);
+		if (!m_options.showOnlyTopChromosome)
+			_algorithm.printReport(m_outputStream);
 		printCacheStats();
 		populationAutosave();
+		bestChromosomeSave();
 	}
 }
 
@@ -150,6 +156,35 @@ void AlgorithmRunner::populationAutosave() const
 	);
 }
 
+void AlgorithmRunner::bestChromosomeSave()
+{
+	if (!m_options.bestChromosomeFile.has_value() || m_population.individuals().empty())
+		return;
+
+	Individual const& best = m_population.individuals()[0];
+	if (m_savedFitness.has_value() && best.fitness >= m_savedFitness.value())
+		return;
+
+	Json::Value settings{Json::objectValue};
+	settings["optimizer"]["details"]["yulDetails"]["optimizerSteps"] = best.chromosome.genes();
+
+	ofstream outputStream(m_options.bestChromosomeFile.value(), ios::out | ios::trunc);
+	assertThrow(
+		outputStream.is_open(),
+		FileOpenError,
+		"Could not open file '" + m_options.bestChromosomeFile.value() + "': " + strerror(errno)
+	);
+
+	outputStream << solidity::util::jsonPrettyPrint(settings) << endl;
+
+	assertThrow(
+		!outputStream.bad(),
+		FileWriteError,
+		"Error while writing to file '" + m_options.bestChromosomeFile.value() + "': " + strerror(errno)
+	);
+	m_savedFitness = best.fitness;
+}
+
 void AlgorithmRunner::cacheClear()
 {
 	for (auto& cache: m_programCaches)
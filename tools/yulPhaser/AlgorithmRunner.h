@@ -47,6 +47,7 @@ public:
 	{
 		std::optional<size_t> maxRounds = std::nullopt;
 		std::optional<std::string> populationAutosaveFile = std::nullopt;
+		std::optional<std::string> bestChromosomeFile = std::nullopt;
 		bool randomiseDuplicates = false;
 		std::optional<size_t> minChromosomeLength = std::nullopt;
 		std::optional<size_t> maxChromosomeLength = std::nullopt;
@@ -81,6 +82,9 @@ private:
 	void printInitialPopulation() const;
 	void printCacheStats() const;
 	void populationAutosave() const;
+	/// Saves the top chromosome of the population as Standard JSON settings that select it as
+	/// the sequence of the Yul optimiser, unless it is not better than the one saved last.
+	void bestChromosomeSave();
 	void randomiseDuplicates();
 	void cacheClear();
 	void cacheStartRound(size_t _roundNumber);
@@ -95,6 +99,7 @@ private:
 	std::vector<std::shared_ptr<ProgramCache>> m_programCaches;
 	Options m_options;
 	std::ostream& m_outputStream;
+	std::optional<size_t> m_savedFitness;
 };
 
 }
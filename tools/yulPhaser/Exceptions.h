@@ -27,6 +27,8 @@ struct BadInput: virtual util::Exception {};
 struct InvalidProgram: virtual BadInput {};
 struct NoInputFiles: virtual BadInput {};
 struct MissingFile: virtual BadInput {};
+struct InvalidBestChromosomeFile: virtual BadInput {};
+struct InvalidCalldata: virtual BadInput {};
 
 struct FileOpenError: virtual util::Exception {};
 struct FileReadError: virtual util::Exception {};
@@ -18,14 +18,75 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libevmasm/GasMeter.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Parallel.h>
 
 #include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
+using namespace solidity::evmasm;
+using solidity::langutil::EVMVersion;
+
+namespace
+{
+
+/// @returns the gas cost of a single execution of the instruction, ignoring the parts that depend
+/// on its arguments. For instructions with variable costs a typical value is used.
+unsigned instructionGas(Instruction _instruction, EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::EXP: return GasCosts::expGas + GasCosts::expByteGas(_evmVersion);
+	case Instruction::KECCAK256: return GasCosts::keccak256Gas + 2 * GasCosts::keccak256WordGas;
+	case Instruction::SLOAD: return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE: return GasCosts::totalSstoreResetGas(_evmVersion);
+	case Instruction::BALANCE: return GasCosts::balanceGas(_evmVersion);
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+	case Instruction::EXTCODEHASH:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return GasCosts::logGas + GasCosts::logTopicGas * getLogNumber(_instruction);
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::SELFDESTRUCT: return GasCosts::selfdestructGas(_evmVersion);
+	default:
+		if (instructionInfo(_instruction).gasPriceTier == Tier::Special)
+			return 0;
+		return GasMeter::runGas(_instruction);
+	}
+}
+
+}
+
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> fitness(_chromosomes.size());
+	parallelForEach(_chromosomes.size(), m_parallelism, [&](size_t _index) {
+		fitness[_index] = evaluate(_chromosomes[_index]);
+	});
+	return fitness;
+}
 
 Program const& ProgramBasedMetric::program() const
 {
@@ -55,6 +116,43 @@ Program ProgramBasedMetric::optimisedProgramNoCache(Chromosome const& _chromosom
 	return programCopy;
 }
 
+size_t ProgramBasedMetric::optimisationEffort(Chromosome const& _chromosome)
+{
+	if (m_programCache != nullptr)
+	{
+		// The cache stores the programs for all prefixes of the sequence it optimised unless
+		// it had to evict some of them to stay within its size limit.
+		optimisedProgram(_chromosome);
+		string steps;
+		for (size_t i = 0; i < m_repetitionCount; ++i)
+			steps += toString(_chromosome);
+
+		size_t effort = (steps.empty() ? 0 : program().codeSize(m_codeWeights));
+		bool allPrefixesCached = true;
+		for (size_t i = 1; i < steps.size() && allPrefixesCached; ++i)
+		{
+			shared_ptr<Program const> intermediateProgram = m_programCache->find(steps.substr(0, i));
+			if (intermediateProgram != nullptr)
+				effort += intermediateProgram->codeSize(m_codeWeights);
+			else
+				allPrefixesCached = false;
+		}
+
+		if (allPrefixesCached)
+			return effort;
+	}
+
+	size_t effort = 0;
+	Program programCopy = program();
+	for (size_t i = 0; i < m_repetitionCount; ++i)
+		for (string const& step: _chromosome.optimisationSteps())
+		{
+			effort += programCopy.codeSize(m_codeWeights);
+			programCopy.optimise({step});
+		}
+	return effort;
+}
+
 size_t ProgramSize::evaluate(Chromosome const& _chromosome)
 {
 	return optimisedProgram(_chromosome).codeSize(codeWeights());
@@ -75,6 +173,67 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t OptimisationEffort::evaluate(Chromosome const& _chromosome)
+{
+	return optimisationEffort(_chromosome);
+}
+
+size_t RelativeProgramSizeAndEffort::evaluate(Chromosome const& _chromosome)
+{
+	size_t relativeSize = RelativeProgramSize::evaluate(_chromosome);
+
+	size_t unoptimisedSize = optimisedProgram(Chromosome("")).codeSize(codeWeights());
+	if (unoptimisedSize == 0)
+		return relativeSize;
+
+	double const scalingFactor = pow(10, fixedPointPrecision());
+	return relativeSize + static_cast<size_t>(round(
+		m_effortWeight * double(optimisationEffort(_chromosome)) / double(unoptimisedSize) * scalingFactor
+	));
+}
+
+size_t ExecutionCost::evaluate(Chromosome const& _chromosome)
+{
+	Program optimised = optimisedProgram(_chromosome);
+
+	if (m_calldata.empty())
+		return executionCost(optimised, {}, m_maxSteps);
+
+	size_t cost = 0;
+	for (bytes const& calldata: m_calldata)
+	{
+		size_t callCost = executionCost(optimised, calldata, m_maxSteps);
+		cost = (callCost > numeric_limits<size_t>::max() - cost ? numeric_limits<size_t>::max() : cost + callCost);
+	}
+	return cost;
+}
+
+size_t ExecutionCost::executionCost(Program const& _program, bytes const& _calldata, size_t _maxSteps)
+{
+	yul::test::InterpreterState state;
+	state.calldata = _calldata;
+	state.maxSteps = _maxSteps;
+	try
+	{
+		yul::test::Interpreter::run(state, _program.dialect(), _program.ast(), /* disableMemoryTracing = */ false);
+	}
+	catch (yul::test::InterpreterTerminatedGeneric const&)
+	{
+	}
+
+	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_program.dialect());
+	EVMVersion evmVersion = (evmDialect != nullptr ? evmDialect->evmVersion() : EVMVersion{});
+
+	bigint cost = 0;
+	for (auto const& [instruction, count]: state.instructionCounts)
+		cost += bigint(instructionGas(instruction, evmVersion)) * count;
+
+	bigint memoryWords = state.msize / 32;
+	cost += GasCosts::memoryGas * memoryWords + memoryWords * memoryWords / GasCosts::quadCoeffDiv;
+
+	return cost > numeric_limits<size_t>::max() ? numeric_limits<size_t>::max() : static_cast<size_t>(cost);
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -27,8 +27,11 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/Common.h>
+
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -49,6 +52,16 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all the chromosomes, using up to @a parallelism() threads. Metrics used with
+	/// a parallelism above one must support concurrent calls to @a evaluate().
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t parallelism() const { return m_parallelism; }
+	void setParallelism(size_t _parallelism) { m_parallelism = _parallelism; }
+
+private:
+	size_t m_parallelism = 1;
 };
 
 /**
@@ -86,6 +99,11 @@ public:
 	Program optimisedProgram(Chromosome const& _chromosome);
 	Program optimisedProgramNoCache(Chromosome const& _chromosome) const;
 
+	/// @returns the sum of the sizes of the program before each of the optimisation steps from
+	/// the chromosome (including repetitions). Most steps take time proportional to the size of
+	/// the program, so this is a deterministic estimate of the time needed to apply them.
+	size_t optimisationEffort(Chromosome const& _chromosome);
+
 private:
 	std::optional<Program> m_program;
 	std::shared_ptr<ProgramCache> m_programCache;
@@ -132,6 +150,85 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the effort needed to apply the optimisations from the chromosome to
+ * a specific program (see @a ProgramBasedMetric::optimisationEffort()).
+ */
+class OptimisationEffort: public ProgramBasedMetric
+{
+public:
+	using ProgramBasedMetric::ProgramBasedMetric;
+	size_t evaluate(Chromosome const& _chromosome) override;
+};
+
+/**
+ * Fitness metric that adds the effort needed to apply the optimisations from the chromosome
+ * (see @a ProgramBasedMetric::optimisationEffort()) to @a RelativeProgramSize, so that sequences
+ * that take less time to optimise a program just as well are preferred.
+ *
+ * The effort is measured relative to the size of the original program, i.e. as the number of
+ * passes over a program of that size, and is scaled like the size. It is multiplied by
+ * @a _effortWeight before adding it.
+ */
+class RelativeProgramSizeAndEffort: public RelativeProgramSize
+{
+public:
+	explicit RelativeProgramSizeAndEffort(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _fixedPointPrecision,
+		double _effortWeight,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		RelativeProgramSize(std::move(_program), std::move(_programCache), _fixedPointPrecision, _weights, _repetitionCount),
+		m_effortWeight(_effortWeight) {}
+
+	double effortWeight() const { return m_effortWeight; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	double m_effortWeight;
+};
+
+/**
+ * Fitness metric based on the cost of executing a specific program in the Yul interpreter after
+ * applying the optimisations from the chromosome to it.
+ *
+ * The program is executed once for each of the calldata values (or once with empty calldata if
+ * there are none) and the value of the metric is the total estimated gas used. The estimate
+ * includes the costs of the executed instructions and of memory expansion but not the stack
+ * manipulation and jumps added by the code generator, nor any refunds or warm/cold distinctions.
+ * Each execution is stopped after @a _maxSteps interpreter steps.
+ */
+class ExecutionCost: public ProgramBasedMetric
+{
+public:
+	explicit ExecutionCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		std::vector<bytes> _calldata,
+		size_t _maxSteps,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), yul::CodeWeights{}, _repetitionCount),
+		m_calldata(std::move(_calldata)),
+		m_maxSteps(_maxSteps) {}
+
+	std::vector<bytes> const& calldata() const { return m_calldata; }
+	size_t maxSteps() const { return m_maxSteps; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+	/// @returns the estimated amount of gas used by executing @a _program with @a _calldata.
+	static size_t executionCost(Program const& _program, bytes const& _calldata, size_t _maxSteps);
+
+private:
+	std::vector<bytes> m_calldata;
+	size_t m_maxSteps;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
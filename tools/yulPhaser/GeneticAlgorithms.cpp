@@ -21,6 +21,9 @@
 #include <tools/yulPhaser/Selections.h>
 #include <tools/yulPhaser/PairSelections.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::phaser;
@@ -174,3 +177,211 @@ Population ClassicGeneticAlgorithm::select(Population _population, size_t _selec
 	assert(selectedIndividuals.size() == _selectionSize);
 	return Population(_population.fitnessMetric(), selectedIndividuals);
 }
+
+Population NSGA2Algorithm::runNextRound(Population _population)
+{
+	vector<Chromosome> parents;
+	for (auto const& individual: _population.individuals())
+		parents.push_back(individual.chromosome);
+	if (parents.empty())
+		return _population;
+
+	vector<vector<size_t>> points = evaluateObjectives(parents);
+
+	vector<size_t> ranks(parents.size());
+	vector<double> distances(parents.size());
+	vector<vector<size_t>> parentFronts = nonDominatedFronts(points);
+	for (size_t rank = 0; rank < parentFronts.size(); ++rank)
+	{
+		vector<double> frontDistances = crowdingDistances(points, parentFronts[rank]);
+		for (size_t i = 0; i < parentFronts[rank].size(); ++i)
+		{
+			ranks[parentFronts[rank][i]] = rank;
+			distances[parentFronts[rank][i]] = frontDistances[i];
+		}
+	}
+
+	auto tournament = [&]() {
+		size_t a = SimulationRNG::uniformInt(0, parents.size() - 1);
+		size_t b = SimulationRNG::uniformInt(0, parents.size() - 1);
+		if (ranks[a] != ranks[b])
+			return ranks[a] < ranks[b] ? a : b;
+		if (distances[a] != distances[b])
+			return distances[a] > distances[b] ? a : b;
+		return min(a, b);
+	};
+
+	vector<Chromosome> offspring;
+	for (size_t i = 0; i < parents.size(); ++i)
+		offspring.push_back(parents[tournament()]);
+
+	function<SymmetricCrossover> crossoverOperator = buildSymmetricCrossoverOperator(
+		m_options.crossover,
+		m_options.uniformCrossoverSwapChance
+	);
+	for (size_t i = 0; i + 1 < offspring.size(); i += 2)
+		if (SimulationRNG::bernoulliTrial(m_options.crossoverChance))
+			tie(offspring[i], offspring[i + 1]) = crossoverOperator(offspring[i], offspring[i + 1]);
+
+	function<Mutation> mutationOperator = mutationSequence({
+		geneRandomisation(m_options.mutationChance),
+		geneDeletion(m_options.deletionChance),
+		geneAddition(m_options.additionChance),
+	});
+	for (Chromosome& chromosome: offspring)
+		chromosome = mutationOperator(chromosome);
+
+	vector<Chromosome> candidates = parents;
+	candidates.insert(candidates.end(), offspring.begin(), offspring.end());
+	vector<vector<size_t>> offspringPoints = evaluateObjectives(offspring);
+	points.insert(points.end(), offspringPoints.begin(), offspringPoints.end());
+
+	vector<size_t> selected;
+	vector<vector<size_t>> fronts = nonDominatedFronts(points);
+	for (vector<size_t> const& front: fronts)
+	{
+		if (selected.size() + front.size() <= parents.size())
+			selected.insert(selected.end(), front.begin(), front.end());
+		else
+		{
+			vector<double> frontDistances = crowdingDistances(points, front);
+			vector<size_t> order(front.size());
+			for (size_t i = 0; i < order.size(); ++i)
+				order[i] = i;
+			stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+				return frontDistances[_a] > frontDistances[_b];
+			});
+			for (size_t i = 0; selected.size() < parents.size(); ++i)
+				selected.push_back(front[order[i]]);
+		}
+
+		if (selected.size() == parents.size())
+			break;
+	}
+
+	m_paretoFront.clear();
+	for (size_t index: selected)
+		if (find(fronts[0].begin(), fronts[0].end(), index) != fronts[0].end())
+		{
+			bool duplicate = any_of(m_paretoFront.begin(), m_paretoFront.end(), [&](FrontMember const& _member) {
+				return _member.chromosome == candidates[index];
+			});
+			if (!duplicate)
+				m_paretoFront.push_back({candidates[index], points[index]});
+		}
+	sort(m_paretoFront.begin(), m_paretoFront.end(), [](FrontMember const& _a, FrontMember const& _b) {
+		return _a.objectiveValues < _b.objectiveValues;
+	});
+
+	vector<Chromosome> selectedChromosomes;
+	for (size_t index: selected)
+		selectedChromosomes.push_back(move(candidates[index]));
+
+	return Population(_population.fitnessMetric(), move(selectedChromosomes));
+}
+
+void NSGA2Algorithm::printReport(ostream& _stream) const
+{
+	_stream << "---------- PARETO FRONT ----------" << endl;
+	for (FrontMember const& member: m_paretoFront)
+	{
+		for (size_t value: member.objectiveValues)
+			_stream << value << " ";
+		_stream << member.chromosome << endl;
+	}
+}
+
+bool NSGA2Algorithm::dominates(vector<size_t> const& _a, vector<size_t> const& _b)
+{
+	assert(_a.size() == _b.size());
+
+	bool better = false;
+	for (size_t i = 0; i < _a.size(); ++i)
+	{
+		if (_a[i] > _b[i])
+			return false;
+		if (_a[i] < _b[i])
+			better = true;
+	}
+	return better;
+}
+
+vector<vector<size_t>> NSGA2Algorithm::nonDominatedFronts(vector<vector<size_t>> const& _points)
+{
+	vector<vector<size_t>> dominatedPoints(_points.size());
+	vector<size_t> dominationCounts(_points.size(), 0);
+	for (size_t i = 0; i < _points.size(); ++i)
+		for (size_t j = 0; j < _points.size(); ++j)
+			if (dominates(_points[i], _points[j]))
+				dominatedPoints[i].push_back(j);
+			else if (dominates(_points[j], _points[i]))
+				++dominationCounts[i];
+
+	vector<vector<size_t>> fronts;
+	vector<size_t> currentFront;
+	for (size_t i = 0; i < _points.size(); ++i)
+		if (dominationCounts[i] == 0)
+			currentFront.push_back(i);
+
+	while (!currentFront.empty())
+	{
+		vector<size_t> nextFront;
+		for (size_t i: currentFront)
+			for (size_t j: dominatedPoints[i])
+				if (--dominationCounts[j] == 0)
+					nextFront.push_back(j);
+
+		sort(nextFront.begin(), nextFront.end());
+		fronts.push_back(move(currentFront));
+		currentFront = move(nextFront);
+	}
+
+	return fronts;
+}
+
+vector<double> NSGA2Algorithm::crowdingDistances(
+	vector<vector<size_t>> const& _points,
+	vector<size_t> const& _front
+)
+{
+	vector<double> distances(_front.size(), 0.0);
+	if (_front.empty())
+		return distances;
+
+	for (size_t objective = 0; objective < _points[_front[0]].size(); ++objective)
+	{
+		vector<size_t> order(_front.size());
+		for (size_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+			return _points[_front[_a]][objective] < _points[_front[_b]][objective];
+		});
+
+		size_t minValue = _points[_front[order.front()]][objective];
+		size_t maxValue = _points[_front[order.back()]][objective];
+		distances[order.front()] = numeric_limits<double>::infinity();
+		distances[order.back()] = numeric_limits<double>::infinity();
+		if (minValue == maxValue)
+			continue;
+
+		for (size_t i = 1; i + 1 < order.size(); ++i)
+			distances[order[i]] +=
+				double(_points[_front[order[i + 1]]][objective] - _points[_front[order[i - 1]]][objective]) /
+				double(maxValue - minValue);
+	}
+
+	return distances;
+}
+
+vector<vector<size_t>> NSGA2Algorithm::evaluateObjectives(vector<Chromosome> const& _chromosomes) const
+{
+	vector<vector<size_t>> points(_chromosomes.size(), vector<size_t>(m_objectives.size()));
+	for (size_t objective = 0; objective < m_objectives.size(); ++objective)
+	{
+		vector<size_t> values = m_objectives[objective]->evaluateAll(_chromosomes);
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			points[i][objective] = values[i];
+	}
+
+	return points;
+}
@@ -25,7 +25,10 @@
 #include <tools/yulPhaser/Population.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <ostream>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -63,6 +66,10 @@ public:
 	/// The method that actually implements the algorithm. Should accept the current population in
 	/// @a _population and return the updated one after the round.
 	virtual Population runNextRound(Population _population) = 0;
+
+	/// Prints information about the state of the algorithm that is not visible in the population.
+	/// Called after each round. Most algorithms have nothing to add.
+	virtual void printReport(std::ostream&) const {}
 };
 
 /**
@@ -222,4 +229,92 @@ private:
 	Options m_options;
 };
 
+/**
+ * A multi-objective genetic algorithm based on NSGA-II (Deb et al., 2002).
+ *
+ * Instead of the fitness of the population it uses a separate metric for each objective (e.g. code
+ * size, execution cost and optimisation effort) and searches for chromosomes that are not dominated
+ * by any other, i.e. such that no other chromosome is at least as good in every objective and
+ * better in at least one. Lower metric values are better.
+ *
+ * In each round offspring as numerous as the population is created using binary tournament
+ * selection (lower front first, then higher crowding distance), crossover and mutation. Parents and
+ * offspring are then sorted into non-dominated fronts and the new population is filled with whole
+ * fronts, the last one truncated by crowding distance so that the chromosomes stay spread out.
+ *
+ * The fitness of the returned individuals is still computed with the metric of the population but
+ * it plays no role in the algorithm. The first front of the population is available via
+ * @a paretoFront() and printed by @a printReport().
+ */
+class NSGA2Algorithm: public GeneticAlgorithm
+{
+public:
+	struct Options
+	{
+		double crossoverChance;    ///< The chance of a pair of offspring being crossed over.
+		double mutationChance;     ///< The chance of a particular gene being randomised in @a geneRandomisation mutation.
+		double deletionChance;     ///< The chance of a particular gene being deleted in @a geneDeletion mutation.
+		double additionChance;     ///< The chance of a particular gene being added in @a geneAddition mutation.
+		CrossoverChoice crossover; ///< The crossover operator to use
+		std::optional<double> uniformCrossoverSwapChance; ///< Chance of a pair of genes being swapped in uniform crossover.
+
+		bool isValid() const
+		{
+			return (
+				0 <= crossoverChance && crossoverChance <= 1.0 &&
+				0 <= mutationChance && mutationChance <= 1.0 &&
+				0 <= deletionChance && deletionChance <= 1.0 &&
+				0 <= additionChance && additionChance <= 1.0 &&
+				0 <= uniformCrossoverSwapChance && uniformCrossoverSwapChance <= 1.0
+			);
+		}
+	};
+
+	/// A chromosome from the first front together with its values of the objectives.
+	struct FrontMember
+	{
+		Chromosome chromosome;
+		std::vector<size_t> objectiveValues;
+	};
+
+	NSGA2Algorithm(Options const& _options, std::vector<std::shared_ptr<FitnessMetric>> _objectives):
+		m_options(_options),
+		m_objectives(std::move(_objectives))
+	{
+		assert(_options.isValid());
+		assert(m_objectives.size() > 0);
+	}
+
+	Options const& options() const { return m_options; }
+	std::vector<std::shared_ptr<FitnessMetric>> const& objectives() const { return m_objectives; }
+	std::vector<FrontMember> const& paretoFront() const { return m_paretoFront; }
+
+	Population runNextRound(Population _population) override;
+	void printReport(std::ostream& _stream) const override;
+
+	/// @returns true if @a _a is not worse than @a _b in any objective and better in at least one.
+	static bool dominates(std::vector<size_t> const& _a, std::vector<size_t> const& _b);
+
+	/// Sorts points in the objective space into non-dominated fronts. The first front consists of
+	/// the points not dominated by any other point, the second one of those dominated only by the
+	/// points from the first front, and so on.
+	/// @returns indices of the points in each front, in increasing order.
+	static std::vector<std::vector<size_t>> nonDominatedFronts(std::vector<std::vector<size_t>> const& _points);
+
+	/// @returns the crowding distance of each point of @a _front (in the same order), i.e. the sum
+	/// over all objectives of the distance between its neighbours in the front, normalised by the
+	/// range of the values in the front. The extreme points get an infinite distance.
+	static std::vector<double> crowdingDistances(
+		std::vector<std::vector<size_t>> const& _points,
+		std::vector<size_t> const& _front
+	);
+
+private:
+	std::vector<std::vector<size_t>> evaluateObjectives(std::vector<Chromosome> const& _chromosomes) const;
+
+	Options m_options;
+	std::vector<std::shared_ptr<FitnessMetric>> m_objectives;
+	std::vector<FrontMember> m_paretoFront;
+};
+
 }
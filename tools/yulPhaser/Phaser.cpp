@@ -31,10 +31,14 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <liblangutil/Scanner.h>
 
+#include <libyul/optimiser/Suite.h>
+
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -62,6 +66,7 @@ map<Algorithm, string> const AlgorithmToStringMap =
 	{Algorithm::Random, "random"},
 	{Algorithm::GEWEP, "GEWEP"},
 	{Algorithm::Classic, "classic"},
+	{Algorithm::NSGA2, "NSGA-II"},
 };
 map<string, Algorithm> const StringToAlgorithmMap = invertMap(AlgorithmToStringMap);
 
@@ -69,6 +74,9 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::RelativeCodeSizeAndEffort, "relative-code-size-and-effort"},
+	{MetricChoice::ExecutionCost, "execution-cost"},
+	{MetricChoice::OptimisationEffort, "optimisation-effort"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -128,12 +136,17 @@ GeneticAlgorithmFactory::Options GeneticAlgorithmFactory::Options::fromCommandLi
 		_arguments["classic-mutation-chance"].as<double>(),
 		_arguments["classic-deletion-chance"].as<double>(),
 		_arguments["classic-addition-chance"].as<double>(),
+		_arguments["nsga2-crossover-chance"].as<double>(),
+		_arguments["nsga2-mutation-chance"].as<double>(),
+		_arguments["nsga2-deletion-chance"].as<double>(),
+		_arguments["nsga2-addition-chance"].as<double>(),
 	};
 }
 
 unique_ptr<GeneticAlgorithm> GeneticAlgorithmFactory::build(
 	Options const& _options,
-	size_t _populationSize
+	size_t _populationSize,
+	vector<shared_ptr<FitnessMetric>> _objectives
 )
 {
 	assert(_populationSize > 0);
@@ -186,6 +199,20 @@ unique_ptr<GeneticAlgorithm> GeneticAlgorithmFactory::build(
 				/* uniformCrossoverSwapChance = */ _options.uniformCrossoverSwapChance,
 			});
 		}
+		case Algorithm::NSGA2:
+		{
+			return make_unique<NSGA2Algorithm>(
+				NSGA2Algorithm::Options{
+					/* crossoverChance = */ _options.nsga2CrossoverChance,
+					/* mutationChance = */ _options.nsga2MutationChance,
+					/* deletionChance = */ _options.nsga2DeletionChance,
+					/* additionChance = */ _options.nsga2AdditionChance,
+					/* crossover = */ _options.crossover,
+					/* uniformCrossoverSwapChance = */ _options.uniformCrossoverSwapChance,
+				},
+				move(_objectives)
+			);
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid Algorithm value.");
 	}
@@ -214,11 +241,26 @@ CodeWeights CodeWeightFactory::buildFromCommandLine(po::variables_map const& _ar
 
 FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po::variables_map const& _arguments)
 {
+	vector<bytes> executionCalldata;
+	if (_arguments.count("execution-calldata") > 0)
+		for (string const& calldata: _arguments["execution-calldata"].as<vector<string>>())
+		{
+			assertThrow(isValidHex(calldata), InvalidCalldata, "Calldata is not a 0x-prefixed hex string: " + calldata);
+			executionCalldata.push_back(fromHex(calldata));
+		}
+
 	return {
 		_arguments["metric"].as<MetricChoice>(),
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["effort-weight"].as<double>(),
+		_arguments["threads"].as<size_t>(),
+		move(executionCalldata),
+		_arguments["execution-step-limit"].as<size_t>(),
+		_arguments.count("objective") > 0 ?
+			_arguments["objective"].as<vector<MetricChoice>>() :
+			vector<MetricChoice>{MetricChoice::RelativeCodeSize, MetricChoice::ExecutionCost, MetricChoice::OptimisationEffort},
 	};
 }
 
@@ -259,23 +301,85 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::RelativeCodeSizeAndEffort:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<RelativeProgramSizeAndEffort>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.relativeMetricScale,
+					_options.effortWeight,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
+		case MetricChoice::OptimisationEffort:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<OptimisationEffort>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
+		case MetricChoice::ExecutionCost:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<ExecutionCost>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.executionCalldata,
+					_options.executionStepLimit,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	metric->setParallelism(_options.parallelism);
+	return metric;
+}
+
+vector<shared_ptr<FitnessMetric>> FitnessMetricFactory::buildObjectives(
+	Options const& _options,
+	vector<Program> const& _programs,
+	vector<shared_ptr<ProgramCache>> const& _programCaches,
+	CodeWeights const& _weights
+)
+{
+	vector<shared_ptr<FitnessMetric>> objectives;
+	for (MetricChoice objective: _options.objectives)
+	{
+		Options objectiveOptions = _options;
+		objectiveOptions.metric = objective;
+		objectives.push_back(build(objectiveOptions, _programs, _programCaches, _weights));
+	}
+
+	return objectives;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -292,6 +396,9 @@ PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::varia
 		_arguments.count("population-from-file") > 0 ?
 			_arguments["population-from-file"].as<vector<string>>() :
 			vector<string>{},
+		_arguments.count("best-chromosome-file") > 0 ?
+			_arguments["best-chromosome-file"].as<string>() :
+			optional<string>{},
 	};
 }
 
@@ -316,6 +423,9 @@ Population PopulationFactory::build(
 	for (string const& populationFilePath: _options.populationFromFile)
 		population = move(population) + buildFromFile(populationFilePath, _fitnessMetric);
 
+	if (_options.bestChromosomeFile.has_value())
+		population = move(population) + buildFromBestChromosomeFile(_options.bestChromosomeFile.value(), _fitnessMetric);
+
 	return population;
 }
 
@@ -354,10 +464,39 @@ Population PopulationFactory::buildFromFile(
 	return buildFromStrings(readLinesFromFile(_filePath), move(_fitnessMetric));
 }
 
+Population PopulationFactory::buildFromBestChromosomeFile(
+	string const& _filePath,
+	shared_ptr<FitnessMetric> _fitnessMetric
+)
+{
+	if (!boost::filesystem::exists(_filePath))
+		return Population(move(_fitnessMetric));
+
+	Json::Value settings;
+	string errors;
+	assertThrow(
+		jsonParseStrict(readFileAsString(_filePath), settings, &errors),
+		InvalidBestChromosomeFile,
+		"Could not parse '" + _filePath + "': " + errors
+	);
+	Json::Value const& steps = settings["optimizer"]["details"]["yulDetails"]["optimizerSteps"];
+	assertThrow(
+		steps.isString() && all_of(steps.asString().begin(), steps.asString().end(), [](char _abbreviation) {
+			return OptimiserSuite::stepAbbreviationToNameMap().count(_abbreviation) > 0;
+		}),
+		InvalidBestChromosomeFile,
+		"'" + _filePath + "' does not contain a valid sequence in optimizer.details.yulDetails.optimizerSteps."
+	);
+	return buildFromStrings({steps.asString()}, move(_fitnessMetric));
+}
+
 ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::variables_map const& _arguments)
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-limit") > 0 ?
+			_arguments["program-cache-limit"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -368,7 +507,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.maxTotalCodeSize) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -458,6 +601,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"or removed using this option. The value given here is applied after it."
 		)
 		("seed", po::value<uint32_t>()->value_name("<NUM>"), "Seed for the random number generator.")
+		(
+			"threads",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"Number of threads used to evaluate the fitness of the chromosomes of a population. "
+			"The results do not depend on the number of threads."
+		)
 		(
 			"rounds",
 			po::value<size_t>()->value_name("<NUM>"),
@@ -490,7 +639,8 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"AVAILABLE ALGORITHMS:\n"
 				"* " + toString(Algorithm::GEWEP) + "\n" +
 				"* " + toString(Algorithm::Classic) + "\n" +
-				"* " + toString(Algorithm::Random)
+				"* " + toString(Algorithm::Random) + "\n" +
+				"* " + toString(Algorithm::NSGA2)
 			).c_str()
 		)
 		(
@@ -597,6 +747,42 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 	;
 	keywordDescription.add(classicGeneticAlgorithmDescription);
 
+	po::options_description nsga2AlgorithmDescription("NSGA-II ALGORITHM", lineLength, minDescriptionLength);
+	nsga2AlgorithmDescription.add_options()
+		(
+			"objective",
+			po::value<vector<MetricChoice>>()->value_name("<NAME>"),
+			(
+				"Metric to use as one of the objectives of the multi-objective search. "
+				"Can be specified multiple times. Accepts the same values as --metric and is combined over "
+				"programs using --metric-aggregator. "
+				"(default=" + toString(MetricChoice::RelativeCodeSize) + ", " +
+				toString(MetricChoice::ExecutionCost) + ", " + toString(MetricChoice::OptimisationEffort) + ")"
+			).c_str()
+		)
+		(
+			"nsga2-crossover-chance",
+			po::value<double>()->value_name("<PROBABILITY>")->default_value(0.75),
+			"Chance of a pair of new chromosomes being crossed over."
+		)
+		(
+			"nsga2-mutation-chance",
+			po::value<double>()->value_name("<PROBABILITY>")->default_value(0.01),
+			"Chance of a gene being mutated."
+		)
+		(
+			"nsga2-deletion-chance",
+			po::value<double>()->value_name("<PROBABILITY>")->default_value(0.01),
+			"Chance of a gene being deleted."
+		)
+		(
+			"nsga2-addition-chance",
+			po::value<double>()->value_name("<PROBABILITY>")->default_value(0.01),
+			"Chance of a random gene being added."
+		)
+	;
+	keywordDescription.add(nsga2AlgorithmDescription);
+
 	po::options_description randomAlgorithmDescription("RANDOM ALGORITHM", lineLength, minDescriptionLength);
 	randomAlgorithmDescription.add_options()
 		(
@@ -632,6 +818,14 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<string>()->value_name("<FILE>"),
 			"If specified, the population is saved in the specified file after each round. (default=autosave disabled)"
 		)
+		(
+			"best-chromosome-file",
+			po::value<string>()->value_name("<FILE>"),
+			"If specified, the best chromosome found so far is saved in the specified file after each round "
+			"as Standard JSON settings, i.e. as the value of optimizer.details.yulDetails.optimizerSteps, "
+			"so that builds can use it directly. If the file already exists, the chromosome stored in it is "
+			"included in the initial population and the file is only overwritten with better chromosomes."
+		)
 	;
 	keywordDescription.add(populationDescription);
 
@@ -645,7 +839,10 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::RelativeCodeSizeAndEffort) + "\n" +
+				"* " + toString(MetricChoice::ExecutionCost) + "\n" +
+				"* " + toString(MetricChoice::OptimisationEffort)
 			).c_str()
 		)
 		(
@@ -679,6 +876,33 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"effort-weight",
+			po::value<double>()->value_name("<WEIGHT>")->default_value(0.01),
+			(
+				"Weight of the optimisation effort in the " + toString(MetricChoice::RelativeCodeSizeAndEffort) + " metric. "
+				"The effort is the sum of the sizes of the program before each optimisation step, relative to "
+				"the size of the original program, and estimates the time the optimiser needs for the sequence. "
+				"With the default, applying 100 steps to a program whose size does not change weighs as much "
+				"as the size of the original program."
+			).c_str()
+		)
+		(
+			"execution-calldata",
+			po::value<vector<string>>()->value_name("<HEX>"),
+			(
+				"Calldata, as 0x-prefixed hex strings, used to execute the programs in the interpreter "
+				"with the " + toString(MetricChoice::ExecutionCost) + " metric. Can be specified multiple times. "
+				"Each program is executed once for each value and the estimated gas costs are added up. "
+				"By default the programs are executed once with empty calldata."
+			).c_str()
+		)
+		(
+			"execution-step-limit",
+			po::value<size_t>()->value_name("<NUM>")->default_value(100000),
+			"Maximum number of interpreter steps for a single execution of a program. "
+			"Makes sure that the evaluation terminates for programs with infinite loops."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -711,8 +935,16 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended if your computer has enough RAM or "
+			"if used together with --program-cache-limit."
+		)
+		(
+			"program-cache-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Upper limit on the total size of the programs stored in the cache of each input program. "
+			"The size is the number of AST nodes, as shown by --show-cache-stats. "
+			"Entries unused for the longest time and the largest ones are evicted first. "
+			"Unlimited by default."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -794,6 +1026,7 @@ AlgorithmRunner::Options Phaser::buildAlgorithmRunnerOptions(po::variables_map c
 	return {
 		_arguments.count("rounds") > 0 ? static_cast<optional<size_t>>(_arguments["rounds"].as<size_t>()) : nullopt,
 		_arguments.count("population-autosave") > 0 ? static_cast<optional<string>>(_arguments["population-autosave"].as<string>()) : nullopt,
+		_arguments.count("best-chromosome-file") > 0 ? static_cast<optional<string>>(_arguments["best-chromosome-file"].as<string>()) : nullopt,
 		!_arguments["no-randomise-duplicates"].as<bool>(),
 		_arguments["min-chromosome-length"].as<size_t>(),
 		_arguments["max-chromosome-length"].as<size_t>(),
@@ -822,8 +1055,12 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 	);
 	Population population = PopulationFactory::build(populationOptions, move(fitnessMetric));
 
+	vector<shared_ptr<FitnessMetric>> objectives;
+	if (_arguments["algorithm"].as<Algorithm>() == Algorithm::NSGA2)
+		objectives = FitnessMetricFactory::buildObjectives(metricOptions, programs, programCaches, codeWeights);
+
 	if (_arguments["mode"].as<PhaserMode>() == PhaserMode::RunAlgorithm)
-		runAlgorithm(_arguments, move(population), move(programCaches));
+		runAlgorithm(_arguments, move(population), move(programCaches), move(objectives));
 	else
 		printOptimisedProgramsOrASTs(_arguments, population, move(programs), _arguments["mode"].as<PhaserMode>());
 }
@@ -831,14 +1068,16 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 void Phaser::runAlgorithm(
 	po::variables_map const& _arguments,
 	Population _population,
-	vector<shared_ptr<ProgramCache>> _programCaches
+	vector<shared_ptr<ProgramCache>> _programCaches,
+	vector<shared_ptr<FitnessMetric>> _objectives
 )
 {
 	auto algorithmOptions = GeneticAlgorithmFactory::Options::fromCommandLine(_arguments);
 
 	unique_ptr<GeneticAlgorithm> geneticAlgorithm = GeneticAlgorithmFactory::build(
 		algorithmOptions,
-		_population.individuals().size()
+		_population.individuals().size(),
+		move(_objectives)
 	);
 
 	AlgorithmRunner algorithmRunner(move(_population), move(_programCaches), buildAlgorithmRunnerOptions(_arguments), cout);
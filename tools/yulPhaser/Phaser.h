@@ -25,6 +25,8 @@
 #include <tools/yulPhaser/AlgorithmRunner.h>
 #include <tools/yulPhaser/GeneticAlgorithms.h>
 
+#include <libsolutil/Common.h>
+
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
@@ -70,12 +72,16 @@ enum class Algorithm
 	Random,
 	GEWEP,
 	Classic,
+	NSGA2,
 };
 
 enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	RelativeCodeSizeAndEffort,
+	ExecutionCost,
+	OptimisationEffort,
 };
 
 enum class MetricAggregatorChoice
@@ -126,12 +132,19 @@ public:
 		double classicDeletionChance;
 		double classicAdditionChance;
 
+		double nsga2CrossoverChance;
+		double nsga2MutationChance;
+		double nsga2DeletionChance;
+		double nsga2AdditionChance;
+
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
 
+	/// @param _objectives Metrics used by multi-objective algorithms. Ignored by the others.
 	static std::unique_ptr<GeneticAlgorithm> build(
 		Options const& _options,
-		size_t _populationSize
+		size_t _populationSize,
+		std::vector<std::shared_ptr<FitnessMetric>> _objectives = {}
 	);
 };
 
@@ -158,6 +171,11 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		double effortWeight = 0.0;
+		size_t parallelism = 1;
+		std::vector<bytes> executionCalldata = {};
+		size_t executionStepLimit = 0;
+		std::vector<MetricChoice> objectives = {};
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -168,6 +186,15 @@ public:
 		std::vector<std::shared_ptr<ProgramCache>> _programCaches,
 		yul::CodeWeights const& _weights
 	);
+
+	/// Builds a metric for each of the objectives, combined over programs in the same way as the
+	/// metric returned by @a build().
+	static std::vector<std::shared_ptr<FitnessMetric>> buildObjectives(
+		Options const& _options,
+		std::vector<Program> const& _programs,
+		std::vector<std::shared_ptr<ProgramCache>> const& _programCaches,
+		yul::CodeWeights const& _weights
+	);
 };
 
 /**
@@ -183,6 +210,7 @@ public:
 		std::vector<std::string> population;
 		std::vector<size_t> randomPopulation;
 		std::vector<std::string> populationFromFile;
+		std::optional<std::string> bestChromosomeFile = std::nullopt;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -205,6 +233,12 @@ public:
 		std::string const& _filePath,
 		std::shared_ptr<FitnessMetric> _fitnessMetric
 	);
+	/// Builds a population consisting of the chromosome stored in a file written by
+	/// @a AlgorithmRunner::bestChromosomeSave() or an empty one if the file does not exist.
+	static Population buildFromBestChromosomeFile(
+		std::string const& _filePath,
+		std::shared_ptr<FitnessMetric> _fitnessMetric
+	);
 };
 
 /**
@@ -216,6 +250,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxTotalCodeSize = std::nullopt;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -272,7 +307,8 @@ private:
 	static void runAlgorithm(
 		boost::program_options::variables_map const& _arguments,
 		Population _population,
-		std::vector<std::shared_ptr<ProgramCache>> _programCaches
+		std::vector<std::shared_ptr<ProgramCache>> _programCaches,
+		std::vector<std::shared_ptr<FitnessMetric>> _objectives
 	);
 	static void printOptimisedProgramsOrASTs(
 		boost::program_options::variables_map const& _arguments,
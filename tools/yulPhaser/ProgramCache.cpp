@@ -22,6 +22,8 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -60,31 +62,41 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	shared_ptr<Program const> prefixProgram;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		lock_guard lock(m_mutex);
+		// Some of the shorter prefixes might have been evicted so keep looking past the gaps.
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				prefixProgram = pair->second.program;
+				prefixSize = i;
+				++m_hits;
+			}
 		}
-		else
-			break;
 	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+	Program intermediateProgram = (prefixProgram != nullptr ? *prefixProgram : m_program);
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		CacheEntry entry(intermediateProgram, m_currentRound);
+
+		lock_guard lock(m_mutex);
+		// Another thread might have stored the same prefix in the meantime, which is fine
+		// because the results are equal.
+		auto [position, inserted] = m_entries.insert({targetOptimisations.substr(0, i), move(entry)});
+		if (inserted)
+		{
+			m_totalCodeSize += position->second.codeSize;
+			evictEntries();
+		}
 		++m_misses;
 	}
 
@@ -101,7 +113,10 @@ void ProgramCache::startRound(size_t _roundNumber)
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
+		{
+			m_totalCodeSize -= pair->second.codeSize;
 			m_entries.erase(pair++);
+		}
 		else
 			++pair;
 	}
@@ -110,16 +125,18 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
-Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
+shared_ptr<Program const> ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
 {
+	lock_guard lock(m_mutex);
 	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
 	if (pair == m_entries.end())
 		return nullptr;
 
-	return &(pair->second.program);
+	return pair->second.program;
 }
 
 CacheStats ProgramCache::gatherStats() const
@@ -127,18 +144,35 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+void ProgramCache::evictEntries()
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	if (!m_maxTotalCodeSize.has_value() || m_totalCodeSize <= m_maxTotalCodeSize.value())
+		return;
+
+	vector<map<string, CacheEntry>::iterator> candidates;
+	for (auto pair = m_entries.begin(); pair != m_entries.end(); ++pair)
+		candidates.push_back(pair);
 
-	return size;
+	// Stable sorting keeps the order of eviction deterministic when entries are equally good.
+	stable_sort(candidates.begin(), candidates.end(), [](auto const& _a, auto const& _b) {
+		if (_a->second.roundNumber != _b->second.roundNumber)
+			return _a->second.roundNumber < _b->second.roundNumber;
+		return _a->second.codeSize > _b->second.codeSize;
+	});
+
+	for (auto const& pair: candidates)
+	{
+		if (m_totalCodeSize <= m_maxTotalCodeSize.value())
+			break;
+
+		m_totalCodeSize -= pair->second.codeSize;
+		m_entries.erase(pair);
+	}
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
@@ -24,25 +24,14 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
 namespace solidity::phaser
 {
 
-/**
- * Structure used by @a ProgramCache to store intermediate programs and metadata associated
- * with them.
- */
-struct CacheEntry
-{
-	Program program;
-	size_t roundNumber;
-
-	CacheEntry(Program _program, size_t _roundNumber):
-		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
-};
-
 /**
  * Stores statistics about current cache usage.
  */
@@ -83,6 +72,27 @@ struct CacheStats
 	bool operator!=(CacheStats const& _other) const { return !(*this == _other); }
 };
 
+/**
+ * Structure used by @a ProgramCache to store intermediate programs and metadata associated
+ * with them.
+ *
+ * The program is immutable and shared so that it can be handed out by @a ProgramCache::find()
+ * without copying and stays valid even if the entry gets evicted in the meantime.
+ */
+struct CacheEntry
+{
+	std::shared_ptr<Program const> program;
+	/// Size of the program measured with @a CacheStats::StorageWeights.
+	size_t codeSize;
+	/// The last round in which the entry was created or used.
+	size_t roundNumber;
+
+	CacheEntry(Program _program, size_t _roundNumber):
+		program(std::make_shared<Program const>(std::move(_program))),
+		codeSize(program->codeSize(CacheStats::StorageWeights)),
+		roundNumber(_roundNumber) {}
+};
+
 /**
  * Class that optimises programs one step at a time which allows it to store and later reuse the
  * results of the intermediate steps.
@@ -95,19 +105,26 @@ struct CacheStats
  *
  * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
+ * @a optimiseProgram() and @a find() can be called concurrently, which allows evaluating the
+ * chromosomes of a population in parallel. The steps are applied outside of the lock.
+ *
  * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * Since the programs take a lot of memory, the cache may eat up all the available RAM if sequences
+ * are long and programs large. To prevent that it can be given an upper limit on the total size of
+ * the stored programs (measured with @a CacheStats::StorageWeights). Whenever an insertion exceeds
+ * the limit, entries are evicted until the cache fits again, starting with the ones that were not
+ * used for the longest time and, among those, with the largest programs. Evicting a prefix does not
+ * make the longer entries unreachable - the lookup always uses the longest prefix still present.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -117,7 +134,7 @@ public:
 	void clear();
 
 	size_t size() const { return m_entries.size(); }
-	Program const* find(std::string const& _abbreviatedOptimisationSteps) const;
+	std::shared_ptr<Program const> find(std::string const& _abbreviatedOptimisationSteps) const;
 	bool contains(std::string const& _abbreviatedOptimisationSteps) const { return find(_abbreviatedOptimisationSteps) != nullptr; }
 
 	CacheStats gatherStats() const;
@@ -125,17 +142,25 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Removes entries until their total size does not exceed @a m_maxTotalCodeSize.
+	/// Must be called with @a m_mutex locked.
+	void evictEntries();
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
 	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
+	/// Protects the entries and the statistics, so that programs can be optimised from multiple
+	/// threads. The other members must not be used concurrently with optimiseProgram().
+	mutable std::mutex m_mutex;
 
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	size_t m_totalCodeSize = 0;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;